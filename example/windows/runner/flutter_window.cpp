@@ -3,6 +3,7 @@
 #include <optional>
 
 #include "flutter/generated_plugin_registrant.h"
+#include "window_decoration_windows/window_decoration_windows_plugin.h"
 
 FlutterWindow::FlutterWindow(const flutter::DartProject& project)
     : project_(project) {}
@@ -14,6 +15,22 @@ bool FlutterWindow::OnCreate() {
     return false;
   }
 
+  // Decorate the window the way the app starts (normal frame, black
+  // background, centered) before the view is created at its client size,
+  // so the first frame doesn't have to be reframed or moved.
+  RECT window_rect;
+  ::GetWindowRect(GetHandle(), &window_rect);
+  window_decoration::InitialDecoration decoration = {};
+  decoration.flags = window_decoration::INITIAL_DECORATION_HAS_BOUNDS |
+                     window_decoration::INITIAL_DECORATION_CENTERED |
+                     window_decoration::INITIAL_DECORATION_HAS_BACKGROUND;
+  decoration.frameMode =
+      static_cast<int32_t>(window_decoration::FrameMode::Normal);
+  decoration.backgroundColor = 0xFF000000;
+  decoration.bounds = {window_rect.left, window_rect.top, window_rect.right,
+                       window_rect.bottom};
+  ApplyInitialDecoration(GetHandle(), &decoration);
+
   RECT frame = GetClientArea();
 
   // The size here must match the window dimensions to avoid unnecessary surface
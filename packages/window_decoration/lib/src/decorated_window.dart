@@ -11,6 +11,11 @@ import 'package:window_decoration_platform_interface/window_decoration_platform_
 /// This widget wraps [RegularWindow] and applies custom decorations
 /// based on the provided [WindowDecorationConfig].
 ///
+/// If the app's runner already decorated the window natively before it was
+/// shown (`ApplyInitialDecoration`), the parts of the config the runner set
+/// to the same values (frame and caption height, centering, background,
+/// always-on-top) aren't applied again; the rest of the config is.
+///
 /// Example:
 /// ```dart
 /// final controller = RegularWindowController(...);
@@ -75,41 +80,12 @@ class _DecoratedWindowState extends State<DecoratedWindow> {
     final config = widget.config ?? WindowDecorationConfig.defaultConfig;
 
     try {
-      // Apply window positioning
-      if (config.centered) {
-        await _service.center();
-      }
-
-      // Apply window behavior
-      if (config.alwaysOnTop) {
-        await _service.setAlwaysOnTop(alwaysOnTop: true);
-      }
-
-      if (config.skipTaskbar) {
-        await _service.setSkipTaskbar(skip: true);
-      }
-
-      // Apply appearance
-      if (config.backgroundColor != null) {
-        await _service.setBackgroundColor(config.backgroundColor!);
-      }
-
-      if (config.opacity != null) {
-        await _service.setOpacity(config.opacity!);
+      final initial = await _service.getInitialDecoration();
+      if (initial == null) {
+        await _service.applyConfig(config);
+      } else {
+        await _applyOverInitialDecoration(config, initial);
       }
-
-      // Apply title bar style
-      await _service.setTitleBarStyle(
-        config.titleBarStyle,
-        captionHeight: config.captionHeight,
-      );
-
-      // Apply visibility
-      await _service.setVisible(visible: config.visible);
-
-      // Apply platform-specific effects
-      // TODO(enhancement): Implement effects application
-
       _configurationApplied = true;
     } on Exception catch (e, stackTrace) {
       debugPrint('Error applying window decoration configuration: $e');
@@ -117,6 +93,55 @@ class _DecoratedWindowState extends State<DecoratedWindow> {
     }
   }
 
+  /// Applies [config] to a window the runner already decorated, leaving out
+  /// what the runner set to the same values: applying those again would
+  /// reframe or move the window after its first frame. Whatever differs is
+  /// applied as usual.
+  Future<void> _applyOverInitialDecoration(
+    WindowDecorationConfig config,
+    InitialDecoration initial,
+  ) async {
+    // The config's flags only ever turn always-on-top on; the runner may
+    // have turned it on for a config that wants it off
+    if (initial.alwaysOnTop != config.alwaysOnTop) {
+      await _service.setAlwaysOnTop(alwaysOnTop: config.alwaysOnTop);
+    }
+
+    final remaining = WindowDecorationConfig(
+      centered: config.centered && !initial.centered,
+      skipTaskbar: config.skipTaskbar,
+      frameless: config.frameless,
+      visible: config.visible,
+      backgroundColor: initial.hasBackgroundOf(config)
+          ? null
+          : config.backgroundColor,
+      opacity: config.opacity,
+      titleBarStyle: config.titleBarStyle,
+      captionHeight: config.captionHeight,
+      effects: config.effects,
+    );
+
+    if (!initial.hasFrameOf(config)) {
+      // A different frame: everything else goes with it in one call
+      await _service.applyConfig(remaining);
+      return;
+    }
+
+    if (remaining.centered) {
+      await _service.center();
+    }
+    if (remaining.skipTaskbar) {
+      await _service.setSkipTaskbar(skip: true);
+    }
+    if (remaining.backgroundColor != null) {
+      await _service.setBackgroundColor(remaining.backgroundColor!);
+    }
+    if (remaining.opacity != null) {
+      await _service.setOpacity(remaining.opacity!);
+    }
+    await _service.setVisible(visible: remaining.visible);
+  }
+
   @override
   Widget build(BuildContext context) =>
       // Simply wrap the child with RegularWindow
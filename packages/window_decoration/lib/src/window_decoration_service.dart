@@ -97,6 +97,57 @@ class WindowDecorationService {
   /// Sets the window bounds (position and size)
   Future<void> setBounds(WindowBounds bounds) => _platform.setBounds(bounds);
 
+  /// Gets bounds, monitor, DPI, frame mode and show state in one call
+  ///
+  /// Cheap enough to poll on Windows and Linux (one native call, no
+  /// allocations).
+  Future<WindowStateInfo> getWindowState() => _platform.getWindowState();
+
+  /// Window events (move, resize, maximize/minimize/restore, DPI, focus,
+  /// theme, close request) pushed by the native side, coalesced per frame
+  ///
+  /// Implemented on Linux.
+  Stream<WindowEvent> get windowEvents => _platform.windowEvents;
+
+  /// Animates the window to [bounds] and/or [opacity] over [duration],
+  /// stepped natively on every display frame
+  ///
+  /// Completes with true once the target is reached, false if the
+  /// animation was replaced or cancelled. Implemented on Windows and Linux.
+  Future<bool> animateWindow({
+    WindowBounds? bounds,
+    double? opacity,
+    required Duration duration,
+    WindowAnimationCurve curve = WindowAnimationCurve.easeInOut,
+  }) =>
+      _platform.animateWindow(bounds: bounds, opacity: opacity, duration: duration, curve: curve);
+
+  /// Stops a running [animateWindow] animation where it is
+  Future<void> cancelWindowAnimation() => _platform.cancelWindowAnimation();
+
+  /// Opens the layout file at [path] that [restoreWindowLayout] reads and
+  /// tracked windows save to
+  ///
+  /// Returns false if the file isn't a readable layout file; it is then
+  /// replaced on the next save. Implemented on Windows and Linux.
+  Future<bool> openWindowLayoutStore(String path) => _platform.openWindowLayoutStore(path);
+
+  /// Places the window as the layout saved under [id] left it, before it is
+  /// first shown, and keeps that layout saved from now on
+  ///
+  /// Windows whose monitor is gone or changed are moved onto another one.
+  /// Implemented on Windows and Linux.
+  Future<WindowLayoutRestore> restoreWindowLayout(String id) => _platform.restoreWindowLayout(id);
+
+  /// Saves pending window layout changes now, e.g. before the app exits
+  Future<bool> flushWindowLayouts() => _platform.flushWindowLayouts();
+
+  /// What the runner applied to the window natively before it was first
+  /// shown; `DecoratedWindow` doesn't apply those parts of its config again
+  ///
+  /// Implemented on Windows and Linux; null elsewhere.
+  Future<InitialDecoration?> getInitialDecoration() => _platform.getInitialDecoration();
+
   // ==========================================================================
   // Appearance
   // ==========================================================================
@@ -152,4 +203,11 @@ class WindowDecorationService {
 
   /// Hides the window (convenience method for setVisible(visible: false))
   Future<void> hide() => setVisible(visible: false);
+
+  /// Applies a whole [WindowDecorationConfig]
+  ///
+  /// Backends with native support apply it in one call and one frame
+  /// change; elsewhere the individual setters run one by one.
+  Future<void> applyConfig(WindowDecorationConfig config) =>
+      _platform.applyConfig(config);
 }
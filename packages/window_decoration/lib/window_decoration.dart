@@ -1,6 +1,16 @@
 export 'package:window_decoration_macos/src/effects/ns_visual_effect_material.dart';
 export 'package:window_decoration_platform_interface/window_decoration_platform_interface.dart'
-    show TitleBarStyle, WindowBounds, WindowDecorationConfig, WindowEffect;
+    show
+        InitialDecoration,
+        TitleBarStyle,
+        WindowAnimationCurve,
+        WindowBounds,
+        WindowDecorationConfig,
+        WindowEffect,
+        WindowEvent,
+        WindowEventType,
+        WindowLayoutRestore,
+        WindowStateInfo;
 export 'package:window_decoration_windows/src/effects/dwm_effects.dart';
 
 export 'src/decorated_window.dart';
@@ -0,0 +1,114 @@
+// Window Decoration Core - Batch hit test benchmark
+// Compares per-point hit testing with HitTestBatch at each instruction set
+// level (ns per point). That every level agrees with the per-point results
+// is checked by test/batch_hit_test_test.cpp.
+
+#include <vector>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/batch_hit_test.h"
+#include "window_decoration_core/caption_mask.h"
+#include "window_decoration_core/caption_regions.h"
+#include "window_decoration_core/hit_test.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+static const char* SimdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar: return "scalar";
+        case SimdLevel::Sse2: return "sse2";
+        case SimdLevel::Avx2: return "avx2";
+    }
+    return "?";
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    const size_t points = 4096;
+    const uint64_t rounds = 5000;
+
+    FrameGeometry geometry = {};
+    geometry.windowWidth = 1280;
+    geometry.windowHeight = 800;
+    geometry.borderWidth = 8;
+    geometry.borderHeight = 8;
+    geometry.clientLeft = 8;
+    geometry.clientTop = 0;
+    geometry.dpi = 144;
+    geometry.isMaximized = false;
+
+    CaptionLayout caption = {};
+    caption.captionHeight = 32;
+    caption.minimizeButton = { 1134, 0, 1180, 48 };
+    caption.maximizeButton = { 1180, 0, 1226, 48 };
+    caption.closeButton = { 1226, 0, 1272, 48 };
+    caption.hasCaptionButtons = true;
+
+    CaptionRegionIndex regions;
+    regions.Set("tabs", { { 80, 0, 600, 48 }, HitCode::Client, 6 });
+    regions.Set("search", { { 700, 8, 1000, 40 }, HitCode::Client, 16 });
+
+    // Interactive strip between the search box and the caption buttons
+    std::vector<uint16_t> maskRuns;
+    for (int row = 0; row < 40; row++) {
+        uint16_t rowRuns[] = { 3, 700, 40, 100 };
+        maskRuns.insert(maskRuns.end(), rowRuns, rowRuns + 4);
+    }
+    CaptionMask mask;
+    mask.Set(840, 40, maskRuns.data(), maskRuns.size());
+
+    // Odd count so every level also runs the scalar tail
+    Random random;
+    std::vector<int32_t> xs(points + 3);
+    std::vector<int32_t> ys(points + 3);
+    for (size_t i = 0; i < xs.size(); i++) {
+        xs[i] = random.Range(-4, geometry.windowWidth + 4);
+        ys[i] = (i % 2 == 0) ? random.Range(0, 64) : random.Range(-4, geometry.windowHeight + 4);
+    }
+    const size_t count = xs.size();
+
+    std::vector<HitCode> results(count);
+
+    const FrameMode modes[] = { FrameMode::CustomFrame, FrameMode::Hidden };
+    const char* modeNames[] = { "custom", "hidden" };
+    const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2 };
+    SimdLevel supported = SupportedSimdLevel();
+    std::printf("Supported SIMD level: %s\n", SimdLevelName(supported));
+
+    bool ok = true;
+    char name[64];
+
+    for (int m = 0; m < 2; m++) {
+        FrameMode mode = modes[m];
+        const CaptionRegionIndex* modeRegions = mode == FrameMode::CustomFrame ? &regions : nullptr;
+        const CaptionMask* modeMask = mode == FrameMode::CustomFrame ? &mask : nullptr;
+
+        double perPointNs = MeasureNsPerOp(rounds, [&](uint64_t) {
+            for (size_t i = 0; i < count; i++) {
+                results[i] = mode == FrameMode::CustomFrame
+                    ? HitTestCustomFrame(xs[i], ys[i], geometry, caption, modeRegions, modeMask)
+                    : HitTestHiddenFrame(xs[i], ys[i], geometry);
+            }
+            DoNotOptimize(static_cast<int>(results[count - 1]));
+        }) / count;
+        std::snprintf(name, sizeof(name), "%s: per-point", modeNames[m]);
+        ok &= Report(name, perPointNs, maxNs);
+
+        for (SimdLevel level : levels) {
+            if (level > supported) {
+                continue;
+            }
+
+            double batchNs = MeasureNsPerOp(rounds, [&](uint64_t) {
+                HitTestBatch(xs.data(), ys.data(), count, geometry, mode, caption, modeRegions, modeMask,
+                             results.data(), level);
+                DoNotOptimize(static_cast<int>(results[count - 1]));
+            }) / count;
+            std::snprintf(name, sizeof(name), "%s: HitTestBatch (%s)", modeNames[m], SimdLevelName(level));
+            ok &= Report(name, batchNs, maxNs);
+        }
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,78 @@
+// Window Decoration Core - Benchmark helpers
+// Minimal timing harness so the benchmarks have no external dependencies
+
+#ifndef WINDOW_DECORATION_CORE_BENCHMARK_UTIL_H_
+#define WINDOW_DECORATION_CORE_BENCHMARK_UTIL_H_
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace window_decoration {
+namespace benchmark {
+
+// Sink that keeps the optimizer from discarding benchmarked work
+inline volatile uint64_t g_sink = 0;
+
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+    g_sink = g_sink + static_cast<uint64_t>(value);
+}
+
+// Run fn(i) for i in [0, iterations) and return the mean ns per call
+template <typename Fn>
+double MeasureNsPerOp(uint64_t iterations, Fn&& fn) {
+    // Warm up caches and branch predictors
+    for (uint64_t i = 0; i < iterations / 10; i++) {
+        fn(i);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; i++) {
+        fn(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double elapsed = std::chrono::duration<double, std::nano>(end - start).count();
+    return elapsed / static_cast<double>(iterations);
+}
+
+// Deterministic xorshift generator so runs are comparable
+struct Random {
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+
+    uint32_t Next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<uint32_t>(state >> 32);
+    }
+
+    int Range(int min, int max) {
+        return min + static_cast<int>(Next() % static_cast<uint32_t>(max - min));
+    }
+};
+
+// Parse --max-ns=<n> (0 when not given)
+inline double ParseMaxNs(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--max-ns=", 9) == 0) {
+            return std::atof(argv[i] + 9);
+        }
+    }
+    return 0.0;
+}
+
+// Print a result line and check it against the budget
+inline bool Report(const char* name, double nsPerOp, double maxNs) {
+    bool withinBudget = maxNs <= 0.0 || nsPerOp <= maxNs;
+    std::printf("%-40s %10.2f ns/op%s\n", name, nsPerOp, withinBudget ? "" : "  (over budget)");
+    return withinBudget;
+}
+
+}  // namespace benchmark
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_BENCHMARK_UTIL_H_
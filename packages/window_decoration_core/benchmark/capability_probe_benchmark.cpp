@@ -0,0 +1,96 @@
+// Window Decoration Core - Capability probe benchmark
+// Checks that a CapabilityProbe runs its probe exactly once while many
+// threads ask for the capabilities at the same time, and that every thread
+// sees the probed result, then times Get() once the probe ran (the cost
+// left on paths that used to re-check an API or the OS version on every
+// message). Also checks ParseOsVersion on kernel and Windows style
+// versions. Any mismatch exits with status 1.
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/platform_capabilities.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+static std::atomic<int> g_probes(0);
+
+// Stand-in for a backend probe: slow enough that the racing threads all
+// arrive while it runs
+static void SlowProbe(PlatformCapabilities* capabilities) {
+    g_probes.fetch_add(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    capabilities->flags = CAPABILITY_WINDOW_DPI | CAPABILITY_COMPOSITOR;
+    capabilities->netWmAtoms = NET_WM_STATE | NET_WM_STATE_ABOVE;
+    capabilities->osMajor = 10;
+    capabilities->osBuild = 22631;
+}
+
+static bool Parses(const char* release, bool valid, uint32_t major, uint32_t minor, uint32_t build) {
+    uint32_t parsedMajor = 1;
+    uint32_t parsedMinor = 1;
+    uint32_t parsedBuild = 1;
+    bool parsed = ParseOsVersion(release, &parsedMajor, &parsedMinor, &parsedBuild);
+    return parsed == valid && parsedMajor == major && parsedMinor == minor && parsedBuild == build;
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    uint64_t errors = 0;
+
+    errors += Parses("6.8.0-45-generic", true, 6, 8, 0) ? 0 : 1;
+    errors += Parses("6.18.44-fc-v130", true, 6, 18, 44) ? 0 : 1;
+    errors += Parses("10.0.22631", true, 10, 0, 22631) ? 0 : 1;
+    errors += Parses("5.15", true, 5, 15, 0) ? 0 : 1;
+    errors += Parses("4.", true, 4, 0, 0) ? 0 : 1;
+    errors += Parses("1.2.3.4", true, 1, 2, 3) ? 0 : 1;
+    errors += Parses("99999999999.1", true, UINT32_MAX, 1, 0) ? 0 : 1;
+    errors += Parses("", false, 0, 0, 0) ? 0 : 1;
+    errors += Parses("v6.1", false, 0, 0, 0) ? 0 : 1;
+    errors += Parses(nullptr, false, 0, 0, 0) ? 0 : 1;
+
+    // NET_WM_* bits follow the atom name table
+    errors += NET_WM_ATOM_COUNT == 12 && (NET_WM_ACTIVE_WINDOW >> (NET_WM_ATOM_COUNT - 1)) == 1 ? 0 : 1;
+
+    // Many first callers at once: one probe, one result
+    CapabilityProbe probe;
+    const int kThreads = 16;
+    std::atomic<bool> go(false);
+    std::atomic<int> mismatches(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; t++) {
+        threads.emplace_back([&]() {
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+            const PlatformCapabilities& capabilities = probe.Get(SlowProbe);
+            if (capabilities.flags != (CAPABILITY_WINDOW_DPI | CAPABILITY_COMPOSITOR) ||
+                capabilities.osBuild != 22631 || &capabilities != &probe.Get(SlowProbe)) {
+                mismatches.fetch_add(1);
+            }
+        });
+    }
+    go.store(true);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    errors += g_probes.load() == 1 ? 0 : 1;
+    errors += mismatches.load() == 0 ? 0 : 1;
+
+    // After the probe: what WM_NCCALCSIZE or a DPI lookup now pays
+    double getNs = MeasureNsPerOp(20000000, [&](uint64_t) {
+        DoNotOptimize(probe.Get(SlowProbe).flags & CAPABILITY_WINDOWS_11);
+    });
+    bool ok = Report("CapabilityProbe::Get (probed)", getNs, maxNs);
+    errors += g_probes.load() == 1 ? 0 : 1;
+
+    if (errors != 0) {
+        std::printf("Capability probe mismatches: %llu\n", static_cast<unsigned long long>(errors));
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+// Window Decoration Core - Caption mask benchmark
+// Builds a title bar mask with pill-shaped tabs and round buttons, checks the
+// run-length lookup against a dense bitmap, and measures lookups and dirty
+// row updates
+
+#include <vector>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/caption_mask.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+// Encode one row of a dense bitmap (1 = interactive) into `out`
+static void EncodeRow(const std::vector<uint8_t>& bits, int width, int row, std::vector<uint16_t>* out) {
+    size_t countIndex = out->size();
+    out->push_back(0);
+
+    uint8_t state = 0;
+    int runStart = 0;
+    for (int x = 0; x <= width; x++) {
+        uint8_t bit = x < width ? bits[row * width + x] : static_cast<uint8_t>(state ^ 1);
+        if (bit != state) {
+            out->push_back(static_cast<uint16_t>(x - runStart));
+            (*out)[countIndex]++;
+            runStart = x;
+            state = bit;
+        }
+    }
+}
+
+// Paint a rounded rect into the bitmap
+static void PaintPill(std::vector<uint8_t>* bits, int width, int height,
+                      int left, int top, int right, int bottom, int radius) {
+    for (int y = top; y < bottom && y < height; y++) {
+        for (int x = left; x < right && x < width; x++) {
+            int cx = x < left + radius ? left + radius : (x >= right - radius ? right - radius - 1 : x);
+            int cy = y < top + radius ? top + radius : (y >= bottom - radius ? bottom - radius - 1 : y);
+            int dx = x - cx;
+            int dy = y - cy;
+            if (dx * dx + dy * dy <= radius * radius) {
+                (*bits)[y * width + x] = 1;
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    const uint64_t iterations = 20000000;
+    const int width = 1920;
+    const int height = 48;
+
+    std::vector<uint8_t> bits(width * height, 0);
+    for (int tab = 0; tab < 24; tab++) {
+        PaintPill(&bits, width, height, 80 + tab * 56, 8, 80 + tab * 56 + 52, 40, 16);
+    }
+    for (int button = 0; button < 8; button++) {
+        PaintPill(&bits, width, height, 1500 + button * 40, 10, 1500 + button * 40 + 28, 38, 14);
+    }
+
+    std::vector<uint16_t> runs;
+    for (int row = 0; row < height; row++) {
+        EncodeRow(bits, width, row, &runs);
+    }
+
+    CaptionMask mask;
+    if (!mask.Set(width, height, runs.data(), runs.size())) {
+        std::printf("Set() rejected the mask\n");
+        return 1;
+    }
+    std::printf("%-40s %10zu bytes encoded, %zu transitions\n", "Mask size",
+                runs.size() * sizeof(uint16_t), mask.transitions());
+
+    // Lookup must agree with the bitmap at every pixel (96 dpi = 1:1)
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            HitCode hit;
+            HitCode expected = bits[y * width + x] ? HitCode::Client : HitCode::Caption;
+            if (!mask.Lookup(x, y, 96, &hit) || hit != expected) {
+                std::printf("Lookup mismatch at (%d, %d)\n", x, y);
+                return 1;
+            }
+        }
+    }
+
+    Random random;
+    std::vector<int> xs(4096);
+    std::vector<int> ys(4096);
+    for (size_t i = 0; i < xs.size(); i++) {
+        xs[i] = random.Range(0, width * 3 / 2);
+        ys[i] = random.Range(0, height * 3 / 2);
+    }
+    const size_t mask4k = xs.size() - 1;
+
+    bool ok = true;
+
+    double lookupNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+        HitCode hit = HitCode::Nowhere;
+        mask.Lookup(xs[i & mask4k], ys[i & mask4k], 144, &hit);
+        DoNotOptimize(static_cast<int>(hit));
+    });
+    ok &= Report("CaptionMask::Lookup", lookupNs, maxNs);
+
+    // Re-upload an 8 row band, as when a tab animates
+    std::vector<uint16_t> band;
+    for (int row = 16; row < 24; row++) {
+        EncodeRow(bits, width, row, &band);
+    }
+    double updateNs = MeasureNsPerOp(200000, [&](uint64_t) {
+        DoNotOptimize(mask.UpdateRows(16, 8, band.data(), band.size()) ? 1 : 0);
+    });
+    Report("CaptionMask::UpdateRows (8 rows)", updateNs, 0);
+
+    double setNs = MeasureNsPerOp(200000, [&](uint64_t) {
+        DoNotOptimize(mask.Set(width, height, runs.data(), runs.size()) ? 1 : 0);
+    });
+    Report("CaptionMask::Set (48 rows)", setNs, 0);
+
+    return ok ? 0 : 1;
+}
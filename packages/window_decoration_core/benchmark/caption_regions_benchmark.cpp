@@ -0,0 +1,73 @@
+// Window Decoration Core - Caption regions benchmark
+// Compares the grid lookup against a linear scan as the title bar grows
+
+#include <string>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/caption_regions.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+// Lay out a title bar with `count` tab-like regions across a 1920px caption
+static std::vector<CaptionRegion> MakeTitleBar(int count) {
+    std::vector<CaptionRegion> regions;
+    int width = 1920 / count;
+    for (int i = 0; i < count; i++) {
+        CaptionRegion region;
+        region.bounds = { i * width + 2, 4, (i + 1) * width - 2, 44 };
+        region.hit = HitCode::Client;
+        region.cornerRadius = i % 2 == 0 ? 6 : 0;
+        regions.push_back(region);
+    }
+    return regions;
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    const uint64_t iterations = 10000000;
+    bool ok = true;
+
+    Random random;
+    std::vector<int> xs(4096);
+    std::vector<int> ys(4096);
+    for (size_t i = 0; i < xs.size(); i++) {
+        xs[i] = random.Range(0, 1920);
+        ys[i] = random.Range(0, 48);
+    }
+    const size_t mask = xs.size() - 1;
+
+    for (int count : { 4, 16, 64, 256 }) {
+        std::vector<CaptionRegion> regions = MakeTitleBar(count);
+
+        CaptionRegionIndex index;
+        for (int i = 0; i < count; i++) {
+            index.Set("region" + std::to_string(i), regions[i]);
+        }
+
+        double indexNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+            HitCode hit = HitCode::Nowhere;
+            index.Lookup(xs[i & mask], ys[i & mask], &hit);
+            DoNotOptimize(static_cast<int>(hit));
+        });
+
+        double linearNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+            HitCode hit = HitCode::Nowhere;
+            for (size_t r = regions.size(); r-- > 0;) {
+                if (PointInCaptionRegion(xs[i & mask], ys[i & mask], regions[r])) {
+                    hit = regions[r].hit;
+                    break;
+                }
+            }
+            DoNotOptimize(static_cast<int>(hit));
+        });
+
+        std::string name = "CaptionRegionIndex (" + std::to_string(count) + " regions)";
+        ok &= Report(name.c_str(), indexNs, maxNs);
+        name = "Linear scan (" + std::to_string(count) + " regions)";
+        Report(name.c_str(), linearNs, 0.0);
+    }
+
+    return ok ? 0 : 1;
+}
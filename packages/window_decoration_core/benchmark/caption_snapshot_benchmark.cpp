@@ -0,0 +1,164 @@
+// Window Decoration Core - Caption snapshot benchmark
+// Measures the read-side cost of pinning a caption snapshot, then runs a
+// stress test: reader threads hit test continuously while a writer keeps
+// publishing new layouts. Every snapshot a reader sees must be internally
+// consistent (all fields derived from its generation); a torn read exits
+// with status 1.
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/caption_snapshot.h"
+#include "window_decoration_core/hit_test.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+// Layout published for generation `g`. Every field depends on g so a reader
+// can tell if it sees parts of two different layouts.
+static bool PublishLayout(CaptionPublisher* publisher) {
+    return publisher->Update([](CaptionSnapshot& snapshot) {
+        int g = static_cast<int>(snapshot.generation + 1);
+        int left = 1000 + g % 100;
+        snapshot.caption.captionHeight = 32 + g % 16;
+        snapshot.caption.minimizeButton = { left, 0, left + 46, 32 };
+        snapshot.caption.maximizeButton = { left + 46, 0, left + 92, 32 };
+        snapshot.caption.closeButton = { left + 92, 0, left + 138, 32 };
+        snapshot.caption.hasCaptionButtons = true;
+
+        CaptionRegion region = { { g % 100, 0, g % 100 + 200, 32 }, HitCode::Client, 8 };
+        snapshot.regions.Set("tabs", region);
+        return true;
+    });
+}
+
+static bool IsConsistent(const CaptionSnapshot& snapshot) {
+    if (snapshot.generation == 0) {
+        return true;
+    }
+    int g = static_cast<int>(snapshot.generation);
+    int left = 1000 + g % 100;
+    const CaptionLayout& caption = snapshot.caption;
+    if (caption.captionHeight != 32 + g % 16 ||
+        caption.minimizeButton.left != left ||
+        caption.maximizeButton.left != left + 46 ||
+        caption.closeButton.right != left + 138) {
+        return false;
+    }
+
+    // The region must sit exactly where this generation put it
+    HitCode hit;
+    return snapshot.regions.size() == 1 &&
+           snapshot.regions.Lookup(g % 100 + 100, 16, &hit) &&
+           !snapshot.regions.Lookup(g % 100 + 200, 16, &hit);
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    const uint64_t iterations = 20000000;
+
+    FrameGeometry geometry = {};
+    geometry.windowWidth = 1280;
+    geometry.windowHeight = 800;
+    geometry.borderWidth = 8;
+    geometry.borderHeight = 8;
+    geometry.clientLeft = 8;
+    geometry.dpi = 96;
+
+    CaptionPublisher publisher;
+    PublishLayout(&publisher);
+
+    Random random;
+    std::vector<int> xs(4096);
+    std::vector<int> ys(4096);
+    for (size_t i = 0; i < xs.size(); i++) {
+        xs[i] = random.Range(0, geometry.windowWidth);
+        ys[i] = random.Range(0, 64);
+    }
+    const size_t mask = xs.size() - 1;
+
+    bool ok = true;
+
+    double readNs = MeasureNsPerOp(iterations, [&](uint64_t) {
+        DoNotOptimize(static_cast<int>(publisher.Read()->generation));
+    });
+    ok &= Report("CaptionPublisher::Read (uncontended)", readNs, maxNs);
+
+    double hitTestNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+        CaptionPublisher::ReadGuard snapshot = publisher.Read();
+        DoNotOptimize(static_cast<int>(HitTestCustomFrame(xs[i & mask], ys[i & mask], geometry,
+                                                          snapshot->caption, &snapshot->regions)));
+    });
+    ok &= Report("Read + HitTestCustomFrame", hitTestNs, maxNs);
+
+    double publishNs = MeasureNsPerOp(200000, [&](uint64_t) {
+        DoNotOptimize(PublishLayout(&publisher) ? 1 : 0);
+    });
+    Report("CaptionPublisher::Update (no readers)", publishNs, 0);
+
+    // Stress: readers hit test while a writer publishes as fast as it can
+    unsigned int readerCount = std::thread::hardware_concurrency();
+    readerCount = readerCount > 2 ? readerCount - 1 : 2;
+    if (readerCount > 15) {
+        readerCount = 15;
+    }
+
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> reads(0);
+    std::atomic<uint64_t> torn(0);
+    std::atomic<uint64_t> publishes(0);
+    std::atomic<uint64_t> checksum(0);
+
+    std::vector<std::thread> readers;
+    for (unsigned int t = 0; t < readerCount; t++) {
+        readers.emplace_back([&, t]() {
+            uint64_t localReads = 0;
+            uint64_t localTorn = 0;
+            uint64_t localChecksum = 0;
+            size_t i = t * 97;
+            while (!stop.load(std::memory_order_relaxed)) {
+                CaptionPublisher::ReadGuard snapshot = publisher.Read();
+                if (!IsConsistent(*snapshot)) {
+                    localTorn++;
+                }
+                localChecksum += static_cast<uint64_t>(HitTestCustomFrame(xs[i & mask], ys[i & mask], geometry,
+                                                                          snapshot->caption, &snapshot->regions));
+                i++;
+                localReads++;
+            }
+            reads += localReads;
+            torn += localTorn;
+            checksum += localChecksum;
+        });
+    }
+
+    std::thread writer([&]() {
+        while (!stop.load(std::memory_order_relaxed)) {
+            PublishLayout(&publisher);
+            publishes++;
+        }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    stop = true;
+    writer.join();
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    DoNotOptimize(checksum.load());
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%-40s %10u readers, 1 writer\n", "Stress", readerCount);
+    std::printf("%-40s %10.2f M/s\n", "Reads + hit tests", reads.load() / seconds / 1e6);
+    std::printf("%-40s %10.2f K/s\n", "Publishes", publishes.load() / seconds / 1e3);
+    std::printf("%-40s %10llu\n", "Torn reads", static_cast<unsigned long long>(torn.load()));
+
+    if (torn.load() != 0 || publishes.load() == 0) {
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
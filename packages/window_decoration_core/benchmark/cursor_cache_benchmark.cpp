@@ -0,0 +1,130 @@
+// Window Decoration Core - Cursor cache benchmark
+// Cost of getting a resize cursor from the cache versus loading it every
+// time (the loader stands in for LoadCursor / gdk_cursor_new_from_name),
+// then a simulated mouse path over a window on two displays at different
+// scales. The cursor may only be loaded once per shape, display and scale,
+// and only set when the resolved hit changes; anything else exits with
+// status 1.
+
+#include <vector>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/cursor_cache.h"
+#include "window_decoration_core/hit_test_policy.h"
+#include "window_decoration_core/hover_memo.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+typedef const void* CursorHandle;
+
+static int g_cursorStorage[5 * 4];
+static uint64_t g_loads = 0;
+
+// Stand-in for a platform cursor load: walks a "theme" before returning a
+// handle unique to the shape and scale
+static CursorHandle LoadThemeCursor(CursorShape shape, uint32_t scale) {
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < 2000; i++) {
+        hash = (hash ^ static_cast<uint32_t>(i + static_cast<int>(shape))) * 16777619u;
+    }
+    DoNotOptimize(hash);
+    g_loads++;
+    return &g_cursorStorage[static_cast<int>(shape) * 4 + (scale / 48) % 4];
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    const uint64_t iterations = 5000000;
+    bool ok = true;
+
+    static const HitCode kResizeHits[] = {
+        HitCode::Left, HitCode::Top, HitCode::TopLeft, HitCode::BottomRight,
+        HitCode::Right, HitCode::TopRight, HitCode::Bottom, HitCode::BottomLeft,
+    };
+
+    uint64_t unmapped = 0;
+    double uncachedNs = MeasureNsPerOp(iterations / 50, [&](uint64_t i) {
+        CursorShape shape{};
+        unmapped += CursorShapeForHit(kResizeHits[i & 7], &shape) ? 0 : 1;
+        DoNotOptimize(reinterpret_cast<uintptr_t>(LoadThemeCursor(shape, 96)));
+    });
+    Report("load every time", uncachedNs, 0);
+
+    CursorCache<CursorHandle> cache;
+    double cachedNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+        CursorShape shape{};
+        unmapped += CursorShapeForHit(kResizeHits[i & 7], &shape) ? 0 : 1;
+        DoNotOptimize(reinterpret_cast<uintptr_t>(cache.Get(shape, 0, 96, [](CursorShape s) {
+            return LoadThemeCursor(s, 96);
+        })));
+    });
+    ok &= Report("CursorCache::Get", cachedNs, maxNs);
+
+    // Mouse path: a pointer wandering over the bottom-right corner of one
+    // window per display (96 and 192 DPI), through the memo and
+    // transition-only cursor updates like the backends do
+    CursorCache<CursorHandle> pathCache;
+    g_loads = 0;
+    uint64_t moves = 0;
+    uint64_t transitions = 0;
+    uint64_t cursorSets = 0;
+
+    for (uint32_t display = 1; display <= 2; display++) {
+        uint32_t scale = display == 1 ? 96 : 192;
+        FrameGeometry geometry = {};
+        geometry.windowWidth = 800;
+        geometry.windowHeight = 600;
+        geometry.borderWidth = 8 * scale / 96;
+        geometry.borderHeight = 8 * scale / 96;
+        geometry.dpi = scale;
+
+        HoverMemo hover;
+        CursorHandle shown = nullptr;
+        Random random;
+        int x = 700;
+        int y = 500;
+        for (int step = 0; step < 200000; step++) {
+            x += random.Range(-3, 4);
+            y += random.Range(-3, 4);
+            x = x < 0 ? 0 : (x >= 800 ? 799 : x);
+            y = y < 0 ? 0 : (y >= 600 ? 599 : y);
+            moves++;
+
+            HitCode hit = hover.Resolve(x, y, 1, [&geometry](int px, int py, Rect* cell) {
+                return ResolveResizeCellFor<CustomFramePolicy>(px, py, geometry, cell);
+            });
+            if (!hover.Transition(hit)) {
+                continue;
+            }
+            transitions++;
+
+            CursorShape shape = CursorShape::Arrow;
+            CursorShapeForHit(hit, &shape);
+            CursorHandle cursor = pathCache.Get(shape, display, scale, [scale](CursorShape s) {
+                return LoadThemeCursor(s, scale);
+            });
+            if (cursor != shown) {
+                shown = cursor;
+                cursorSets++;
+                hover.RecordCursorChange();
+            }
+        }
+    }
+
+    CursorCacheStats stats = pathCache.stats();
+    std::printf("%-40s %10llu\n", "Mouse moves", static_cast<unsigned long long>(moves));
+    std::printf("%-40s %10llu\n", "Hit transitions", static_cast<unsigned long long>(transitions));
+    std::printf("%-40s %10llu\n", "Cursor changes", static_cast<unsigned long long>(cursorSets));
+    std::printf("%-40s %10llu hits, %llu loads\n", "Cursor cache",
+                static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.loads));
+
+    // Every resize hit has a cursor shape, and at most 5 shapes on each of
+    // the 2 displays are each loaded exactly once
+    if (unmapped != 0 || stats.loads != g_loads || stats.loads > 10 || stats.loads + stats.hits != transitions ||
+        cursorSets > transitions || transitions == 0) {
+        std::printf("Cursor cache mismatch\n");
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
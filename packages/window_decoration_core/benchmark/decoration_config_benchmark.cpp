@@ -0,0 +1,103 @@
+// Window Decoration Core - Decoration config benchmark
+// Cost of decoding a config blob (what ApplyDecorationConfig pays before
+// touching the window), plus encoding round trips for random configs,
+// forward compatibility with a longer fixed part, and rejection of
+// truncated, wrong-version and out-of-range blobs. Any mismatch exits with
+// status 1.
+
+#include <cstring>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/decoration_config.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+static DecorationConfig RandomConfig(Random& random) {
+    DecorationConfig config = {};
+    config.flags = static_cast<uint16_t>(random.Range(0, 128));
+    config.backgroundColor = static_cast<uint32_t>(random.Next());
+    config.opacity = static_cast<float>(random.Range(0, 101)) / 100.0f;
+    config.captionHeight = static_cast<uint16_t>(random.Range(0, 200));
+    config.titleBarStyle = static_cast<TitleBarStyle>(random.Range(0, 5));
+    config.effectCount = static_cast<uint8_t>(random.Range(0, 4));
+    for (uint8_t i = 0; i < config.effectCount; i++) {
+        config.effects[i] = static_cast<WindowEffect>(random.Range(0, 6));
+    }
+    return config;
+}
+
+static bool SameConfig(const DecorationConfig& a, const DecorationConfig& b) {
+    if (a.flags != b.flags || a.backgroundColor != b.backgroundColor || a.opacity != b.opacity ||
+        a.captionHeight != b.captionHeight || a.titleBarStyle != b.titleBarStyle ||
+        a.effectCount != b.effectCount) {
+        return false;
+    }
+    return std::memcmp(a.effects, b.effects, a.effectCount) == 0;
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    const uint64_t iterations = 20000000;
+    bool ok = true;
+
+    Random random;
+    DecorationConfig config = RandomConfig(random);
+    config.effectCount = 2;
+    uint8_t blob[MAX_DECORATION_CONFIG_BYTES];
+    size_t length = EncodeDecorationConfig(config, blob, sizeof(blob));
+
+    double decodeNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+        DecorationConfig decoded;
+        blob[4] = static_cast<uint8_t>(i);
+        DoNotOptimize(DecodeDecorationConfig(blob, length, &decoded) ? decoded.backgroundColor : 0);
+    });
+    ok &= Report("DecodeDecorationConfig", decodeNs, maxNs);
+
+    uint64_t errors = 0;
+    for (int i = 0; i < 100000; i++) {
+        DecorationConfig original = RandomConfig(random);
+        DecorationConfig decoded;
+        size_t size = EncodeDecorationConfig(original, blob, sizeof(blob));
+        if (size != static_cast<size_t>(DECORATION_CONFIG_FIXED_BYTES + original.effectCount) ||
+            !DecodeDecorationConfig(blob, size, &decoded) || !SameConfig(original, decoded)) {
+            errors++;
+        }
+
+        // Every truncation must be rejected
+        if (DecodeDecorationConfig(blob, size - 1 - static_cast<size_t>(random.Range(0, static_cast<int>(size))), &decoded)) {
+            errors++;
+        }
+    }
+
+    // A future minor version with 4 more fixed bytes and unknown flags
+    DecorationConfig original = RandomConfig(random);
+    size_t size = EncodeDecorationConfig(original, blob, sizeof(blob));
+    uint8_t extended[MAX_DECORATION_CONFIG_BYTES + 4] = {};
+    std::memcpy(extended, blob, DECORATION_CONFIG_FIXED_BYTES);
+    std::memcpy(extended + DECORATION_CONFIG_FIXED_BYTES + 4, blob + DECORATION_CONFIG_FIXED_BYTES,
+                size - DECORATION_CONFIG_FIXED_BYTES);
+    extended[1] = DECORATION_CONFIG_FIXED_BYTES + 4;
+    extended[3] |= 0x80;
+    DecorationConfig decoded;
+    if (!DecodeDecorationConfig(extended, size + 4, &decoded) || !SameConfig(original, decoded)) {
+        errors++;
+    }
+
+    // Another major version, a bad title bar style, too many effects
+    blob[0] = DECORATION_CONFIG_VERSION + 1;
+    errors += DecodeDecorationConfig(blob, size, &decoded) ? 1 : 0;
+    blob[0] = DECORATION_CONFIG_VERSION;
+    blob[14] = 9;
+    errors += DecodeDecorationConfig(blob, size, &decoded) ? 1 : 0;
+    blob[14] = 0;
+    blob[15] = MAX_DECORATION_EFFECTS + 1;
+    errors += DecodeDecorationConfig(blob, sizeof(blob), &decoded) ? 1 : 0;
+
+    std::printf("%-40s %10zu bytes\n", "Blob with 2 effects", length);
+    if (errors != 0) {
+        std::printf("Config encoding mismatches: %llu\n", static_cast<unsigned long long>(errors));
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
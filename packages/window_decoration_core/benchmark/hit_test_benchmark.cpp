@@ -0,0 +1,93 @@
+// Window Decoration Core - Hit test benchmark
+// Measures ns per call of the frame hit testers over random pointer positions
+
+#include <vector>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/frame_geometry_cache.h"
+#include "window_decoration_core/hit_test.h"
+#include "window_decoration_core/hit_test_policy.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    const uint64_t iterations = 20000000;
+
+    FrameGeometry geometry = {};
+    geometry.windowWidth = 1280;
+    geometry.windowHeight = 800;
+    geometry.borderWidth = 8;
+    geometry.borderHeight = 8;
+    geometry.clientLeft = 8;
+    geometry.clientTop = 0;
+    geometry.dpi = 144;
+    geometry.isMaximized = false;
+
+    CaptionLayout caption = {};
+    caption.captionHeight = 32;
+    caption.minimizeButton = { 1134, 0, 1180, 48 };
+    caption.maximizeButton = { 1180, 0, 1226, 48 };
+    caption.closeButton = { 1226, 0, 1272, 48 };
+    caption.hasCaptionButtons = true;
+
+    // Bias points toward the borders and caption, where the hot path branches
+    Random random;
+    std::vector<int> xs(4096);
+    std::vector<int> ys(4096);
+    for (size_t i = 0; i < xs.size(); i++) {
+        xs[i] = random.Range(-4, geometry.windowWidth + 4);
+        ys[i] = (i % 2 == 0) ? random.Range(0, 64) : random.Range(0, geometry.windowHeight);
+    }
+    const size_t mask = xs.size() - 1;
+
+    bool ok = true;
+
+    double customNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+        DoNotOptimize(static_cast<int>(HitTestCustomFrame(xs[i & mask], ys[i & mask], geometry, caption)));
+    });
+    ok &= Report("HitTestCustomFrame", customNs, maxNs);
+
+    double hiddenNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+        DoNotOptimize(static_cast<int>(HitTestHiddenFrame(xs[i & mask], ys[i & mask], geometry)));
+    });
+    ok &= Report("HitTestHiddenFrame", hiddenNs, maxNs);
+
+    // Per-mode cost through the function pointer the backends select once
+    // per mode change
+    const FrameMode modes[] = { FrameMode::CustomFrame, FrameMode::Hidden, FrameMode::Normal };
+    const char* modeNames[] = { "SelectHitTest(CustomFrame)", "SelectHitTest(Hidden)", "SelectHitTest(Normal)" };
+    for (int m = 0; m < 3; m++) {
+        HitTestFn hitTest = SelectHitTest(modes[m]);
+        double modeNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+            DoNotOptimize(static_cast<int>(hitTest(xs[i & mask], ys[i & mask], geometry, caption, nullptr, nullptr)));
+        });
+        ok &= Report(modeNames[m], modeNs, maxNs);
+    }
+
+    // Full hot path as the backends run it: cached geometry + hit test.
+    // The fake OS queries count how often the cache goes back to the OS.
+    FrameGeometryCache cache;
+    uint64_t osQueries = 0;
+    auto queryMetrics = [&]() {
+        osQueries++;
+        return FrameMetrics{ geometry.dpi, 4, 4, 4 };
+    };
+    auto queryPlacement = [&]() {
+        osQueries++;
+        return FramePlacement{ { 100, 100, 100 + geometry.windowWidth, 100 + geometry.windowHeight },
+                               geometry.clientLeft, geometry.clientTop, false };
+    };
+
+    double cachedNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+        const FrameGeometry& cached = cache.Get(queryMetrics, queryPlacement);
+        DoNotOptimize(static_cast<int>(HitTestCustomFrame(xs[i & mask], ys[i & mask], cached, caption)));
+    });
+    ok &= Report("FrameGeometryCache + HitTestCustomFrame", cachedNs, maxNs);
+    std::printf("%-40s %10llu of %llu lookups\n", "OS queries on the hot path",
+                static_cast<unsigned long long>(osQueries),
+                static_cast<unsigned long long>(cache.stats().lookups));
+
+    return ok ? 0 : 1;
+}
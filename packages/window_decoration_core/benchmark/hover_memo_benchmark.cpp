@@ -0,0 +1,70 @@
+// Window Decoration Core - Hover memo benchmark
+// Replays a high-polling-rate mouse trace (1px steps, like a 1000 Hz mouse)
+// through the memoized resize hit test and the full per-move evaluation
+
+#include <vector>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/frame_geometry_cache.h"
+#include "window_decoration_core/hover_memo.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    const uint64_t iterations = 20000000;
+    bool ok = true;
+
+    FrameGeometry geometry = {};
+    geometry.windowWidth = 1280;
+    geometry.windowHeight = 800;
+    geometry.borderWidth = 8;
+    geometry.borderHeight = 8;
+    geometry.clientLeft = 8;
+    geometry.dpi = 96;
+
+    // Random walk with small steps, the way a fast mouse reports motion
+    Random random;
+    std::vector<int> xs(1 << 16);
+    std::vector<int> ys(1 << 16);
+    int x = 640;
+    int y = 400;
+    for (size_t i = 0; i < xs.size(); i++) {
+        x += random.Range(-2, 3);
+        y += random.Range(-2, 3);
+        if (x < 0 || x >= geometry.windowWidth) x = random.Range(0, geometry.windowWidth);
+        if (y < 0 || y >= geometry.windowHeight) y = random.Range(0, geometry.windowHeight);
+        xs[i] = x;
+        ys[i] = y;
+    }
+    const size_t mask = xs.size() - 1;
+
+    for (FrameMode mode : { FrameMode::CustomFrame, FrameMode::Hidden }) {
+        const char* suffix = mode == FrameMode::CustomFrame ? "custom" : "hidden";
+
+        double fullNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+            Rect cell;
+            DoNotOptimize(static_cast<int>(ResolveResizeCell(xs[i & mask], ys[i & mask], geometry, mode, &cell)));
+        });
+
+        HoverMemo memo;
+        double memoNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+            HitCode hit = memo.Resolve(xs[i & mask], ys[i & mask], 1,
+                [&](int px, int py, Rect* cell) { return ResolveResizeCell(px, py, geometry, mode, cell); });
+            DoNotOptimize(static_cast<int>(memo.Transition(hit)));
+        });
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "Full evaluation (%s)", suffix);
+        Report(name, fullNs, 0.0);
+        std::snprintf(name, sizeof(name), "HoverMemo (%s)", suffix);
+        ok &= Report(name, memoNs, maxNs);
+
+        const HoverStats& stats = memo.stats();
+        std::printf("%-40s %10.3f %%\n", "  memo hit rate",
+                    100.0 * stats.memoHits / (stats.memoHits + stats.evaluations));
+    }
+
+    return ok ? 0 : 1;
+}
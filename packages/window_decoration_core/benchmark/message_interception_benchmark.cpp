@@ -0,0 +1,229 @@
+// Window Decoration Core - Message interception benchmark
+// Per-message overhead of the ways a backend can intercept the messages of a
+// managed window, over a simulated UI thread message stream: timers, paints,
+// application messages and input for unrelated windows (tooltips, IME,
+// other top-levels) mixed with pointer input for the managed window and its
+// content view.
+//
+//   hook (lookup first)  the original thread hook: window lookup plus a
+//                        parent lookup (GetParent) for every message
+//   hook (filtered)      the thread hook classifying the message id first
+//   subclass             only the managed window and its view are
+//                        intercepted; other windows never reach the filter
+//
+// Reported numbers are on top of plain dispatch. All modes must hand the
+// same messages to the border logic; a mismatch exits with status 1.
+
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/message_filter.h"
+#include "window_decoration_core/window_registry.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+typedef void* Handle;
+
+// Win32 message ids (the filter is keyed by the backend's own ids)
+enum : uint32_t {
+    kPaint = 0x000F,
+    kSetCursor = 0x0020,
+    kNcMouseMove = 0x00A0,
+    kTimer = 0x0113,
+    kMouseMove = 0x0200,
+    kLButtonDown = 0x0201,
+    kLButtonUp = 0x0202,
+    kUser = 0x0400,
+    kRegistered = 0xC100
+};
+
+struct HotState {
+    bool customFrame;
+    uint64_t hoverMoves;
+    uint64_t buttonDowns;
+};
+
+struct ColdState {
+    Handle view;
+};
+
+struct Message {
+    Handle window;
+    uint32_t message;
+};
+
+static const int kUnrelatedWindows = 32;
+static const size_t kStreamLength = 1 << 16;
+
+// Stand-in for the work the border logic does per relevant message
+static void HandleBorderMessage(HotState& state, MessageAction action) {
+    if (action == MessageAction::HoverMove) {
+        state.hoverMoves++;
+    } else {
+        state.buttonDowns++;
+    }
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    const uint64_t iterations = 20000000;
+
+    MessageFilter filter;
+    filter.Set(kMouseMove, MessageAction::HoverMove);
+    filter.Set(kNcMouseMove, MessageAction::HoverMove);
+    filter.Set(kLButtonDown, MessageAction::ButtonDown);
+
+    // One managed top-level with a content view, plus unrelated windows of
+    // the same thread; parents stands in for GetParent
+    Handle managed = reinterpret_cast<Handle>(0x10000);
+    Handle view = reinterpret_cast<Handle>(0x10002);
+    std::vector<Handle> unrelated;
+    std::unordered_map<Handle, Handle> parents;
+    parents[view] = managed;
+    for (int i = 0; i < kUnrelatedWindows; i++) {
+        Handle window = reinterpret_cast<Handle>(0x20000 + 2 * static_cast<uintptr_t>(i));
+        unrelated.push_back(window);
+        parents[window] = i % 4 == 0 ? unrelated[0] : nullptr;
+    }
+
+    WindowRegistry<Handle, HotState, ColdState> windows;
+    uint32_t managedSlot = windows.Insert(managed);
+    windows.hot(managedSlot) = { true, 0, 0 };
+    windows.cold(managedSlot).view = view;
+
+    // Stream: mostly messages the border logic never cares about
+    Random random;
+    std::vector<Message> stream(kStreamLength);
+    uint64_t expectedRelevant = 0;
+    for (Message& message : stream) {
+        int kind = random.Range(0, 100);
+        Handle target = unrelated[static_cast<size_t>(random.Range(0, kUnrelatedWindows))];
+        if (kind < 25) {
+            message = { random.Range(0, 2) == 0 ? view : target, kTimer };
+        } else if (kind < 40) {
+            message = { random.Range(0, 4) == 0 ? view : target, kPaint };
+        } else if (kind < 55) {
+            message = { random.Range(0, 2) == 0 ? view : target,
+                        random.Range(0, 2) == 0 ? kUser + 5 : kRegistered };
+        } else if (kind < 70) {
+            message = { target, random.Range(0, 2) == 0 ? kMouseMove : kSetCursor };
+        } else if (kind < 92) {
+            message = { view, kMouseMove };
+        } else if (kind < 95) {
+            message = { managed, kNcMouseMove };
+        } else if (kind < 97) {
+            message = { view, kLButtonDown };
+        } else {
+            message = { view, kLButtonUp };
+        }
+        if ((message.window == view || message.window == managed) &&
+            filter.Classify(message.message) != MessageAction::Ignore) {
+            expectedRelevant++;
+        }
+    }
+
+    auto findManaged = [&](Handle window) -> HotState* {
+        HotState* state = windows.FindHot(window);
+        if (state != nullptr && state->customFrame) {
+            return state;
+        }
+        auto parent = parents.find(window);
+        if (parent != parents.end() && parent->second != nullptr) {
+            state = windows.FindHot(parent->second);
+            if (state != nullptr && state->customFrame) {
+                return state;
+            }
+        }
+        return nullptr;
+    };
+
+    // Plain dispatch: what every message costs with no interception at all
+    double dispatchNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+        const Message& message = stream[i & (kStreamLength - 1)];
+        DoNotOptimize(reinterpret_cast<uintptr_t>(message.window) + message.message);
+    });
+    Report("dispatch only", dispatchNs, 0);
+
+    // The three interception modes, per dispatched message
+    auto lookupFirst = [&](const Message& message) {
+        HotState* target = findManaged(message.window);
+        if (target != nullptr) {
+            if (message.message == kMouseMove || message.message == kNcMouseMove) {
+                HandleBorderMessage(*target, MessageAction::HoverMove);
+            }
+            if (message.message == kLButtonDown) {
+                HandleBorderMessage(*target, MessageAction::ButtonDown);
+            }
+        }
+    };
+    auto filtered = [&](const Message& message) {
+        MessageAction action = filter.Classify(message.message);
+        if (action != MessageAction::Ignore) {
+            HotState* target = findManaged(message.window);
+            if (target != nullptr) {
+                HandleBorderMessage(*target, action);
+            }
+        }
+    };
+    auto subclass = [&](const Message& message) {
+        // Window procedure dispatch: only the subclassed windows get here
+        if (message.window == view || message.window == managed) {
+            MessageAction action = filter.Classify(message.message);
+            if (action != MessageAction::Ignore) {
+                HotState* target = windows.FindHot(managed);
+                if (target != nullptr && target->customFrame) {
+                    HandleBorderMessage(*target, action);
+                }
+            }
+        }
+    };
+
+    bool ok = true;
+    double lookupFirstNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+        lookupFirst(stream[i & (kStreamLength - 1)]);
+    });
+    Report("hook (lookup first)", lookupFirstNs - dispatchNs, 0);
+
+    double filteredNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+        filtered(stream[i & (kStreamLength - 1)]);
+    });
+    ok &= Report("hook (filtered)", filteredNs - dispatchNs, maxNs);
+
+    double subclassNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+        subclass(stream[i & (kStreamLength - 1)]);
+    });
+    ok &= Report("subclass", subclassNs - dispatchNs, maxNs);
+
+    // One pass of the stream through each mode must reach the border logic
+    // for exactly the relevant messages
+    HotState& state = windows.hot(managedSlot);
+    uint64_t handled[3];
+    for (int mode = 0; mode < 3; mode++) {
+        state.hoverMoves = state.buttonDowns = 0;
+        for (const Message& message : stream) {
+            if (mode == 0) {
+                lookupFirst(message);
+            } else if (mode == 1) {
+                filtered(message);
+            } else {
+                subclass(message);
+            }
+        }
+        handled[mode] = state.hoverMoves + state.buttonDowns;
+    }
+
+    std::printf("%-40s %10llu of %zu\n", "Relevant messages per pass",
+                static_cast<unsigned long long>(expectedRelevant), kStreamLength);
+
+    if (handled[0] != expectedRelevant || handled[1] != expectedRelevant || handled[2] != expectedRelevant) {
+        std::printf("Interception modes disagree: %llu / %llu / %llu, expected %llu\n",
+                    static_cast<unsigned long long>(handled[0]),
+                    static_cast<unsigned long long>(handled[1]),
+                    static_cast<unsigned long long>(handled[2]),
+                    static_cast<unsigned long long>(expectedRelevant));
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
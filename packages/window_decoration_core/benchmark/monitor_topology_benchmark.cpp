@@ -0,0 +1,307 @@
+// Window Decoration Core - Monitor topology benchmark
+// Fixture monitor layouts (a single laptop panel, mixed DPI with negative
+// coordinates and a portrait monitor, a 4x2 wall with a mirrored primary,
+// and six staggered monitors with gaps) checked against brute-force
+// lookups, plus the placement rules on every fixture:
+//
+//   - FindAt / FindNearest / FindForRect agree with a linear scan for random
+//     points and rects, including gaps between monitors and off-screen
+//   - Center, ClampToWorkArea and Cascade keep the window's top-left in the
+//     work area of the right monitor, and inside it entirely when it fits
+//   - Update() reports only real changes and handles hotplug
+//
+// Any mismatch exits with status 1. Then the per-query cost on the wall,
+// with a linear scan ("scan") as the baseline.
+
+#include <algorithm>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/monitor_topology.h"
+#include "window_decoration_core/window_placement.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+struct Fixture {
+    const char* name;
+    std::vector<MonitorInfo> monitors;
+};
+
+static MonitorInfo Monitor(uint64_t id, int left, int top, int width, int height, uint32_t dpi,
+                           int taskbar = 0, uint32_t flags = 0) {
+    MonitorInfo monitor = {};
+    monitor.id = id;
+    monitor.bounds = { left, top, left + width, top + height };
+    monitor.workArea = { left, top, left + width, top + height - taskbar };
+    monitor.dpi = dpi;
+    monitor.flags = flags;
+    return monitor;
+}
+
+static std::vector<Fixture> MakeFixtures() {
+    std::vector<Fixture> fixtures;
+
+    fixtures.push_back({ "single", { Monitor(1, 0, 0, 1920, 1080, 120, 48, MONITOR_PRIMARY) } });
+
+    // 4K at 200% as primary, a 1080p monitor to the right and lower, an
+    // old 5:4 monitor to the left (negative x) and a portrait one on the far
+    // right, raised above the primary (negative y)
+    fixtures.push_back({ "mixed-dpi", {
+        Monitor(10, 0, 0, 3840, 2160, 192, 96, MONITOR_PRIMARY),
+        Monitor(11, 3840, 540, 1920, 1080, 96, 40),
+        Monitor(12, -1280, 0, 1280, 1024, 96),
+        Monitor(13, 5760, -400, 1080, 1920, 120),
+    } });
+
+    // 4x2 wall of 1440p monitors around the origin, plus a projector that
+    // mirrors the primary (same bounds, later in the list)
+    std::vector<MonitorInfo> wall;
+    for (int row = 0; row < 2; row++) {
+        for (int column = 0; column < 4; column++) {
+            bool primary = row == 1 && column == 2;
+            wall.push_back(Monitor(20 + row * 4 + column, -5120 + column * 2560, -1440 + row * 1440, 2560, 1440,
+                                   primary ? 144 : 96, primary ? 60 : 0, primary ? MONITOR_PRIMARY : 0));
+        }
+    }
+    wall.push_back(Monitor(30, 0, 0, 2560, 1440, 96));
+    fixtures.push_back({ "wall", wall });
+
+    // Six monitors of different sizes with gaps and vertical offsets
+    fixtures.push_back({ "staggered", {
+        Monitor(40, -4000, 200, 1600, 900, 96),
+        Monitor(41, -2300, -300, 1920, 1200, 120),
+        Monitor(42, 0, 0, 2560, 1600, 168, 56, MONITOR_PRIMARY),
+        Monitor(43, 2600, 300, 1366, 768, 96, 30),
+        Monitor(44, 4000, -1000, 1200, 1920, 96),
+        Monitor(45, 5200, 0, 3440, 1440, 120),
+    } });
+    return fixtures;
+}
+
+// Reference lookups: linear scans with the documented tie-breaks
+static int ScanAt(const std::vector<MonitorInfo>& monitors, int x, int y) {
+    for (size_t i = 0; i < monitors.size(); i++) {
+        if (PointInRect(x, y, monitors[i].bounds)) {
+            return static_cast<int>(i);
+        }
+    }
+    return MonitorTopology::kNone;
+}
+
+static int64_t ScanDistance(int x, int y, const Rect& rect) {
+    int64_t dx = x < rect.left ? rect.left - x : x >= rect.right ? x - rect.right + 1 : 0;
+    int64_t dy = y < rect.top ? rect.top - y : y >= rect.bottom ? y - rect.bottom + 1 : 0;
+    return dx * dx + dy * dy;
+}
+
+static int ScanNearest(const std::vector<MonitorInfo>& monitors, int x, int y) {
+    int best = MonitorTopology::kNone;
+    int64_t bestDistance = INT64_MAX;
+    for (size_t i = 0; i < monitors.size(); i++) {
+        int64_t distance = ScanDistance(x, y, monitors[i].bounds);
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+static int ScanForRect(const std::vector<MonitorInfo>& monitors, const Rect& rect) {
+    int best = MonitorTopology::kNone;
+    int64_t bestArea = 0;
+    for (size_t i = 0; i < monitors.size(); i++) {
+        const Rect& bounds = monitors[i].bounds;
+        int64_t width = static_cast<int64_t>(std::min(rect.right, bounds.right)) - std::max(rect.left, bounds.left);
+        int64_t height = static_cast<int64_t>(std::min(rect.bottom, bounds.bottom)) - std::max(rect.top, bounds.top);
+        int64_t area = width > 0 && height > 0 ? width * height : 0;
+        if (area > bestArea) {
+            bestArea = area;
+            best = static_cast<int>(i);
+        }
+    }
+    return best != MonitorTopology::kNone
+        ? best
+        : ScanNearest(monitors, rect.left + (rect.right - rect.left) / 2, rect.top + (rect.bottom - rect.top) / 2);
+}
+
+static bool Inside(const Rect& inner, const Rect& outer) {
+    return inner.left >= outer.left && inner.top >= outer.top && inner.right <= outer.right &&
+           inner.bottom <= outer.bottom;
+}
+
+// Random point in (or somewhat around) the fixture's bounding box
+static void RandomPoint(Random& random, const std::vector<MonitorInfo>& monitors, int* x, int* y) {
+    Rect box = monitors[0].bounds;
+    for (const MonitorInfo& monitor : monitors) {
+        box.left = std::min(box.left, monitor.bounds.left);
+        box.top = std::min(box.top, monitor.bounds.top);
+        box.right = std::max(box.right, monitor.bounds.right);
+        box.bottom = std::max(box.bottom, monitor.bounds.bottom);
+    }
+    *x = random.Range(box.left - 500, box.right + 500);
+    *y = random.Range(box.top - 500, box.bottom + 500);
+}
+
+static uint64_t CheckFixture(const Fixture& fixture) {
+    const std::vector<MonitorInfo>& monitors = fixture.monitors;
+    MonitorTopology topology;
+    topology.Update(monitors.data(), monitors.size());
+    uint64_t errors = 0;
+    Random random;
+
+    for (int i = 0; i < 200000; i++) {
+        int x = 0;
+        int y = 0;
+        RandomPoint(random, monitors, &x, &y);
+        errors += topology.FindAt(x, y) != ScanAt(monitors, x, y) ? 1 : 0;
+        errors += topology.FindNearest(x, y) != ScanNearest(monitors, x, y) ? 1 : 0;
+
+        Rect rect = { x, y, x + random.Range(1, 3000), y + random.Range(1, 2000) };
+        errors += topology.FindForRect(rect) != ScanForRect(monitors, rect) ? 1 : 0;
+    }
+
+    // Placement: the work area is the window's monitor's
+    for (int i = 0; i < 20000; i++) {
+        int x = 0;
+        int y = 0;
+        RandomPoint(random, monitors, &x, &y);
+        Rect window = { x, y, x + random.Range(200, 2400), y + random.Range(150, 1600) };
+        const MonitorInfo& monitor = monitors[static_cast<size_t>(ScanForRect(monitors, window))];
+        const Rect& work = monitor.workArea;
+        bool fits = window.right - window.left <= work.right - work.left &&
+                    window.bottom - window.top <= work.bottom - work.top;
+
+        Rect result;
+        errors += !SolvePlacement(topology, PlacementMode::Center, window, window, false, &result) ? 1 : 0;
+        errors += !PointInRect(result.left, result.top, work) || (fits && !Inside(result, work)) ? 1 : 0;
+        errors += result.right - result.left != window.right - window.left ? 1 : 0;
+
+        errors += !SolvePlacement(topology, PlacementMode::ClampToWorkArea, window, window, false, &result) ? 1 : 0;
+        errors += !Inside(result, work) ? 1 : 0;
+        errors += fits && (result.right - result.left != window.right - window.left) ? 1 : 0;
+
+        Rect anchor = CenterInWorkArea(work, 800, 600);
+        errors += !SolvePlacement(topology, PlacementMode::Cascade, window, anchor, true, &result) ? 1 : 0;
+        errors += !Inside(result, work) ? 1 : 0;
+    }
+
+    // Cascading from the work area's top-left steps diagonally by the
+    // scaled step until it would leave the work area, then starts over
+    const MonitorInfo& primary = topology.monitor(topology.primary());
+    errors += (primary.flags & MONITOR_PRIMARY) == 0 ? 1 : 0;
+    int step = ScaleForDpi(CASCADE_STEP, primary.dpi);
+    Rect window = { primary.workArea.left, primary.workArea.top, primary.workArea.left + 640,
+                    primary.workArea.top + 480 };
+    for (int i = 1; i < 200; i++) {
+        Rect next;
+        SolvePlacement(topology, PlacementMode::Cascade, window, window, true, &next);
+        bool wrapped = next.left == primary.workArea.left || next.top == primary.workArea.top;
+        errors += !Inside(next, primary.workArea) ? 1 : 0;
+        errors += !wrapped && (next.left != window.left + step || next.top != window.top + step) ? 1 : 0;
+        window = next;
+    }
+    return errors;
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    std::vector<Fixture> fixtures = MakeFixtures();
+    uint64_t errors = 0;
+    bool ok = true;
+
+    for (const Fixture& fixture : fixtures) {
+        uint64_t fixtureErrors = CheckFixture(fixture);
+        std::printf("%-40s %10zu monitors, %llu mismatches\n", fixture.name, fixture.monitors.size(),
+                    static_cast<unsigned long long>(fixtureErrors));
+        errors += fixtureErrors;
+    }
+
+    // Updates: no change, a settings change (work area, DPI) and hotplug
+    {
+        std::vector<MonitorInfo> monitors = fixtures[3].monitors;
+        MonitorTopology topology;
+        errors += !topology.Update(monitors.data(), monitors.size()) ? 1 : 0;
+        uint64_t generation = topology.generation();
+        errors += topology.Update(monitors.data(), monitors.size()) || topology.generation() != generation ? 1 : 0;
+
+        monitors[2].workArea.bottom -= 20;
+        monitors[4].dpi = 144;
+        errors += !topology.Update(monitors.data(), monitors.size()) ? 1 : 0;
+        errors += topology.monitor(2).workArea.bottom != monitors[2].workArea.bottom ? 1 : 0;
+
+        // Unplug the primary: the first monitor becomes the fallback primary
+        monitors.erase(monitors.begin() + 2);
+        errors += !topology.Update(monitors.data(), monitors.size()) ? 1 : 0;
+        errors += topology.primary() != 0 || topology.FindAt(100, 100) != MonitorTopology::kNone ? 1 : 0;
+        errors += topology.FindNearest(100, 100) != ScanNearest(monitors, 100, 100) ? 1 : 0;
+
+        // Plug a monitor into the gap
+        monitors.push_back(Monitor(46, 0, 0, 1920, 1080, 96));
+        errors += !topology.Update(monitors.data(), monitors.size()) ? 1 : 0;
+        errors += topology.FindAt(100, 100) != static_cast<int>(monitors.size() - 1) ? 1 : 0;
+
+        MonitorTopology empty;
+        Rect result;
+        errors += empty.FindNearest(0, 0) != MonitorTopology::kNone ||
+                  SolvePlacement(empty, PlacementMode::Center, { 0, 0, 10, 10 }, { 0, 0, 10, 10 }, false, &result)
+                  ? 1 : 0;
+    }
+
+    // Per-query cost on the wall
+    {
+        const std::vector<MonitorInfo>& monitors = fixtures[2].monitors;
+        MonitorTopology topology;
+        topology.Update(monitors.data(), monitors.size());
+
+        const size_t kPoints = 4096;
+        std::vector<int> xs(kPoints);
+        std::vector<int> ys(kPoints);
+        Random random;
+        for (size_t i = 0; i < kPoints; i++) {
+            RandomPoint(random, monitors, &xs[i], &ys[i]);
+        }
+        const uint64_t iterations = 20000000;
+
+        double ns = MeasureNsPerOp(iterations, [&](uint64_t i) {
+            size_t k = i & (kPoints - 1);
+            DoNotOptimize(ScanAt(monitors, xs[k], ys[k]) + 1);
+        });
+        ok &= Report("FindAt (scan, 9 monitors)", ns, maxNs);
+
+        ns = MeasureNsPerOp(iterations, [&](uint64_t i) {
+            size_t k = i & (kPoints - 1);
+            DoNotOptimize(topology.FindAt(xs[k], ys[k]) + 1);
+        });
+        ok &= Report("FindAt (9 monitors)", ns, maxNs);
+
+        ns = MeasureNsPerOp(iterations, [&](uint64_t i) {
+            size_t k = i & (kPoints - 1);
+            DoNotOptimize(topology.FindNearest(xs[k], ys[k]) + 1);
+        });
+        ok &= Report("FindNearest (9 monitors)", ns, maxNs);
+
+        ns = MeasureNsPerOp(iterations, [&](uint64_t i) {
+            size_t k = i & (kPoints - 1);
+            Rect rect = { xs[k], ys[k], xs[k] + 1280, ys[k] + 800 };
+            DoNotOptimize(topology.FindForRect(rect) + 1);
+        });
+        ok &= Report("FindForRect (9 monitors)", ns, maxNs);
+
+        ns = MeasureNsPerOp(iterations, [&](uint64_t i) {
+            size_t k = i & (kPoints - 1);
+            Rect rect = { xs[k], ys[k], xs[k] + 1280, ys[k] + 800 };
+            Rect result;
+            SolvePlacement(topology, static_cast<PlacementMode>(i % 3), rect, rect, true, &result);
+            DoNotOptimize(result.left);
+        });
+        ok &= Report("SolvePlacement (9 monitors)", ns, maxNs);
+    }
+
+    if (errors != 0) {
+        std::printf("Monitor topology mismatches: %llu\n", static_cast<unsigned long long>(errors));
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
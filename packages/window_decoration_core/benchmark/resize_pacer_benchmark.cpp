@@ -0,0 +1,174 @@
+// Window Decoration Core - Resize pacer benchmark
+// Deterministic simulation of a one second resize drag: the window manager
+// reports a new size every millisecond (1000 Hz), the display refreshes at
+// 60 Hz and every size handed to the UI costs one relayout. Time is
+// simulated, so the results are the same on every run and machine.
+//
+//   - unpaced: every size is laid out in arrival order (what happens when
+//     each configure event goes straight to the UI)
+//   - paced: ResizePacer keeps the newest size and the frame tick takes it
+//     if the UI thread is free
+//
+// For a fast (2 ms) and a slow (25 ms) relayout it prints the relayouts,
+// skipped sizes, the backlog when the drag ends and the latency from the
+// last input to the applied size. The paced run must end on the last size,
+// lay out at most once per frame, account for every request and keep its
+// latency under two frames plus a relayout; a mismatch exits with status 1.
+// The cost of Request() and Take() themselves is measured for real.
+
+#include <algorithm>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/resize_pacer.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+static const uint64_t kMs = 1000000;
+static const uint64_t kInputInterval = 1 * kMs;
+static const uint64_t kFrameInterval = 16666667;
+static const int kInputs = 1000;
+
+struct Size {
+    int32_t width;
+    int32_t height;
+};
+
+// Size reported by the window manager for input i (1-based)
+static Size InputSize(int i) {
+    return { 800 + i / 2, 600 + i / 3 };
+}
+
+static uint64_t InputTime(int i) {
+    return static_cast<uint64_t>(i) * kInputInterval;
+}
+
+struct SimResult {
+    uint64_t relayouts;
+    uint64_t skipped;
+    uint64_t backlog;  // sizes waiting when the drag ends
+    double meanLatencyNs;
+    double maxLatencyNs;
+    Size last;
+};
+
+// Every size is laid out, one after the other
+static SimResult SimulateUnpaced(uint64_t relayoutNs) {
+    SimResult result = {};
+    uint64_t busyUntil = 0;
+    double totalLatency = 0;
+    uint64_t dragEnd = InputTime(kInputs);
+
+    for (int i = 1; i <= kInputs; i++) {
+        uint64_t start = std::max(InputTime(i), busyUntil);
+        busyUntil = start + relayoutNs;
+        if (start > dragEnd) {
+            result.backlog++;
+        }
+
+        // The size is in the UI once its relayout starts
+        double latency = static_cast<double>(start - InputTime(i));
+        totalLatency += latency;
+        result.maxLatencyNs = std::max(result.maxLatencyNs, latency);
+        result.relayouts++;
+        result.last = InputSize(i);
+    }
+    result.meanLatencyNs = totalLatency / static_cast<double>(result.relayouts);
+    return result;
+}
+
+// The newest size is taken on a frame tick, if the last relayout is done
+static SimResult SimulatePaced(uint64_t relayoutNs, uint64_t* errors) {
+    SimResult result = {};
+    ResizePacer pacer;
+    uint64_t busyUntil = 0;
+    uint64_t frames = 0;
+    int next = 1;
+
+    for (uint64_t frame = kFrameInterval; next <= kInputs || pacer.pending(); frame += kFrameInterval) {
+        for (; next <= kInputs && InputTime(next) <= frame; next++) {
+            Size size = InputSize(next);
+            pacer.Request(size.width, size.height, InputTime(next));
+        }
+        if (frame >= InputTime(kInputs) && frame - kFrameInterval < InputTime(kInputs)) {
+            // First frame after the drag ended
+            result.backlog = pacer.pending() ? 1 : 0;
+        }
+
+        frames++;
+        if (busyUntil > frame) {
+            continue;
+        }
+        Size size;
+        if (pacer.Take(frame, &size.width, &size.height)) {
+            busyUntil = frame + relayoutNs;
+            result.last = size;
+        }
+    }
+
+    const ResizePacingStats& stats = pacer.stats();
+    result.relayouts = stats.applied;
+    result.skipped = stats.skipped;
+    result.meanLatencyNs = static_cast<double>(stats.totalLatencyNs) / static_cast<double>(stats.applied);
+    result.maxLatencyNs = static_cast<double>(stats.maxLatencyNs);
+
+    Size expected = InputSize(kInputs);
+    *errors += result.last.width != expected.width || result.last.height != expected.height ? 1 : 0;
+    *errors += stats.applied + stats.skipped != stats.requests || stats.requests != kInputs ? 1 : 0;
+    *errors += stats.applied > frames ? 1 : 0;
+    *errors += stats.maxLatencyNs > 2 * kFrameInterval + relayoutNs ? 1 : 0;
+    return result;
+}
+
+static void PrintResult(const char* name, const SimResult& result) {
+    std::printf("%-40s %6llu relayouts, %4llu skipped, %3llu backlog, latency mean %6.2f ms, max %7.2f ms\n",
+                name, static_cast<unsigned long long>(result.relayouts),
+                static_cast<unsigned long long>(result.skipped), static_cast<unsigned long long>(result.backlog),
+                result.meanLatencyNs / kMs, result.maxLatencyNs / kMs);
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    uint64_t errors = 0;
+    bool ok = true;
+
+    const struct {
+        const char* unpaced;
+        const char* paced;
+        uint64_t relayoutNs;
+    } machines[] = {
+        { "Unpaced (2 ms relayout)", "Paced (2 ms relayout)", 2 * kMs },
+        { "Unpaced (25 ms relayout)", "Paced (25 ms relayout)", 25 * kMs },
+    };
+
+    for (const auto& machine : machines) {
+        SimResult unpaced = SimulateUnpaced(machine.relayoutNs);
+        SimResult paced = SimulatePaced(machine.relayoutNs, &errors);
+        PrintResult(machine.unpaced, unpaced);
+        PrintResult(machine.paced, paced);
+
+        // Pacing must never lay out more, nor end further behind
+        errors += paced.relayouts > unpaced.relayouts || paced.backlog > unpaced.backlog ? 1 : 0;
+    }
+
+    // Cost of the pacer itself: a frame's worth of requests, then a take
+    {
+        ResizePacer pacer;
+        int32_t width = 0;
+        int32_t height = 0;
+        double ns = MeasureNsPerOp(10000000, [&](uint64_t i) {
+            pacer.Request(static_cast<int32_t>(i), static_cast<int32_t>(i >> 1), i);
+            if ((i & 15) == 15) {
+                pacer.Take(i, &width, &height);
+            }
+        });
+        DoNotOptimize(width + height);
+        ok &= Report("Request (+ Take every 16th)", ns, maxNs);
+    }
+
+    if (errors != 0) {
+        std::printf("Resize pacer mismatches: %llu\n", static_cast<unsigned long long>(errors));
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,224 @@
+// Window Decoration Core - Sharded window registry stress test
+// 16 UI threads churn windows (register, look up on every "message",
+// unregister) concurrently. Each thread must only ever see its own windows
+// with their own state, register/unregister must report the first/last
+// window on the thread exactly when the live count crosses zero, and every
+// surviving window must still be reachable at the end; any violation exits
+// with status 1. Throughput is compared with one registry behind a global
+// mutex.
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/sharded_window_registry.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+struct HotState {
+    uintptr_t owner;
+    uint64_t messages;
+};
+
+struct ColdState {
+    uintptr_t handle;
+};
+
+struct ThreadState {
+    bool hookInstalled;
+    int hookInstalls;
+};
+
+typedef void* Handle;
+typedef ShardedWindowRegistry<Handle, HotState, ColdState, ThreadState> Registry;
+
+static const int kThreads = 16;
+static const int kStepsPerThread = 400000;
+
+// Handles of thread t are disjoint from every other thread's
+static Handle MakeHandle(int thread, int index) {
+    return reinterpret_cast<Handle>((static_cast<uintptr_t>(thread + 1) << 24) + 2 * static_cast<uintptr_t>(index) + 2);
+}
+
+struct ChurnResult {
+    uint64_t operations;
+    uint64_t errors;
+};
+
+// One UI thread: mostly message lookups, with windows created and destroyed
+static ChurnResult ChurnSharded(Registry* registry, int thread) {
+    Registry::ThreadId self = static_cast<Registry::ThreadId>(thread + 1);
+    Random random;
+    random.state += static_cast<uint64_t>(thread) * 0x2545F4914F6CDD1Dull;
+
+    std::vector<Handle> live;
+    ChurnResult result = { 0, 0 };
+
+    for (int step = 0; step < kStepsPerThread; step++) {
+        int action = random.Range(0, 16);
+        if (live.empty() || action == 0) {
+            Handle handle = MakeHandle(thread, random.Range(0, 1 << 16));
+            Registry::Shard* shard = registry->CurrentShard(self);
+            if (shard->windows.Find(handle) != Registry::kNoSlot) {
+                continue;
+            }
+            Registry::Registration registration = registry->Register(self, handle);
+            if (registration.firstOnThread != live.empty() || registration.shard->owner != self) {
+                result.errors++;
+            }
+            if (registration.firstOnThread) {
+                registration.shard->thread.hookInstalled = true;
+                registration.shard->thread.hookInstalls++;
+            }
+            registration.shard->windows.hot(registration.slot).owner = static_cast<uintptr_t>(self);
+            registration.shard->windows.cold(registration.slot).handle = reinterpret_cast<uintptr_t>(handle);
+            live.push_back(handle);
+        } else if (action == 1) {
+            size_t index = static_cast<size_t>(random.Range(0, static_cast<int>(live.size())));
+            bool lastOnThread = registry->Unregister(self, live[index]);
+            live[index] = live.back();
+            live.pop_back();
+            if (lastOnThread != live.empty()) {
+                result.errors++;
+            }
+            if (lastOnThread) {
+                registry->CurrentShard(self)->thread.hookInstalled = false;
+            }
+        } else {
+            // A message for one of this thread's windows
+            Handle handle = live[static_cast<size_t>(random.Range(0, static_cast<int>(live.size())))];
+            Registry::Shard* shard = registry->CurrentShard(self);
+            uint32_t slot = shard->windows.Find(handle);
+            if (slot == Registry::kNoSlot ||
+                shard->windows.hot(slot).owner != static_cast<uintptr_t>(self) ||
+                shard->windows.cold(slot).handle != reinterpret_cast<uintptr_t>(handle) ||
+                !shard->thread.hookInstalled) {
+                result.errors++;
+            } else {
+                shard->windows.hot(slot).messages++;
+            }
+        }
+        result.operations++;
+    }
+
+    Registry::Shard* shard = registry->CurrentShard(self);
+    for (Handle handle : live) {
+        uint32_t slot = shard->windows.Find(handle);
+        if (slot == Registry::kNoSlot || shard->windows.cold(slot).handle != reinterpret_cast<uintptr_t>(handle)) {
+            result.errors++;
+        }
+    }
+    if (shard->windows.size() != live.size() || shard->owner != self) {
+        result.errors++;
+    }
+    return result;
+}
+
+// Same workload against one process-wide registry behind a mutex
+static ChurnResult ChurnLocked(WindowRegistry<Handle, HotState, ColdState>* registry, std::mutex* mutex, int thread) {
+    Random random;
+    random.state += static_cast<uint64_t>(thread) * 0x2545F4914F6CDD1Dull;
+
+    std::vector<Handle> live;
+    ChurnResult result = { 0, 0 };
+
+    for (int step = 0; step < kStepsPerThread; step++) {
+        int action = random.Range(0, 16);
+        std::lock_guard<std::mutex> lock(*mutex);
+        if (live.empty() || action == 0) {
+            Handle handle = MakeHandle(thread, random.Range(0, 1 << 16));
+            if (registry->Find(handle) != WindowRegistry<Handle, HotState, ColdState>::kNoSlot) {
+                continue;
+            }
+            registry->hot(registry->Insert(handle)).owner = static_cast<uintptr_t>(thread + 1);
+            live.push_back(handle);
+        } else if (action == 1) {
+            size_t index = static_cast<size_t>(random.Range(0, static_cast<int>(live.size())));
+            registry->Remove(live[index]);
+            live[index] = live.back();
+            live.pop_back();
+        } else {
+            Handle handle = live[static_cast<size_t>(random.Range(0, static_cast<int>(live.size())))];
+            HotState* state = registry->FindHot(handle);
+            if (state == nullptr || state->owner != static_cast<uintptr_t>(thread + 1)) {
+                result.errors++;
+            } else {
+                state->messages++;
+            }
+        }
+        result.operations++;
+    }
+    return result;
+}
+
+template <typename Fn>
+static double RunThreads(Fn&& churn, uint64_t* operations, uint64_t* errors) {
+    std::vector<ChurnResult> results(kThreads);
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < kThreads; t++) {
+        threads.emplace_back([&, t]() { results[t] = churn(t); });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    *operations = 0;
+    *errors = 0;
+    for (const ChurnResult& result : results) {
+        *operations += result.operations;
+        *errors += result.errors;
+    }
+    return seconds;
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    bool ok = true;
+
+    // Message path cost on one thread: cached shard, then the flat lookup
+    {
+        Registry registry;
+        std::vector<Handle> handles;
+        for (int i = 0; i < 100; i++) {
+            handles.push_back(MakeHandle(0, i * 7));
+            registry.Register(1, handles.back());
+        }
+        double lookupNs = MeasureNsPerOp(20000000, [&](uint64_t i) {
+            Registry::Shard* shard = registry.CurrentShard(1);
+            DoNotOptimize(shard->windows.FindHot(handles[i % handles.size()])->messages);
+        });
+        ok &= Report("CurrentShard + FindHot (100 windows)", lookupNs, maxNs);
+    }
+
+    Registry sharded;
+    uint64_t shardedOps;
+    uint64_t shardedErrors;
+    double shardedSeconds = RunThreads([&](int t) { return ChurnSharded(&sharded, t); },
+                                       &shardedOps, &shardedErrors);
+
+    WindowRegistry<Handle, HotState, ColdState> global;
+    std::mutex globalMutex;
+    uint64_t lockedOps;
+    uint64_t lockedErrors;
+    double lockedSeconds = RunThreads([&](int t) { return ChurnLocked(&global, &globalMutex, t); },
+                                      &lockedOps, &lockedErrors);
+
+    std::printf("%-40s %10d threads\n", "Churn", kThreads);
+    std::printf("%-40s %10.2f M ops/s\n", "sharded", shardedOps / shardedSeconds / 1e6);
+    std::printf("%-40s %10.2f M ops/s\n", "global mutex", lockedOps / lockedSeconds / 1e6);
+    std::printf("%-40s %10zu\n", "Shards", sharded.shardCount());
+    std::printf("%-40s %10llu\n", "Errors",
+                static_cast<unsigned long long>(shardedErrors + lockedErrors));
+
+    if (shardedErrors != 0 || lockedErrors != 0 || sharded.shardCount() != static_cast<size_t>(kThreads)) {
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+// Window Decoration Core - Shared window registry benchmark (Linux)
+// A registry in a memfd mapping shared by two processes: a forked writer
+// process maps the memfd itself, attaches to the registry and republishes
+// its windows as fast as it can, while this process reads them. Every
+// snapshot read must be internally consistent (all fields derived from one
+// generation); a torn read exits with status 1. Reports the cross-process
+// read cost per window.
+
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/shared_window_registry.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+static const uint32_t kSlots = 64;
+static const int kWriterWindows = 8;
+
+// Payload of `window` at generation g. Every field depends on g so a
+// reader can tell if it sees parts of two different publishes.
+static SharedWindowInfo MakeInfo(uint64_t window, uint32_t g) {
+    SharedWindowInfo info = {};
+    info.window = window;
+    info.frameMode = static_cast<int32_t>(g % 3);
+    info.bounds = { static_cast<int>(g), static_cast<int>(g) + 1, static_cast<int>(g) + 800, static_cast<int>(g) + 600 };
+    info.dpi = 96 + g % 4 * 24;
+    info.captionHeight = static_cast<int32_t>(g);
+    info.regionCount = 1 + g % MAX_SHARED_CAPTION_REGIONS;
+    for (uint32_t i = 0; i < info.regionCount; i++) {
+        info.regions[i].bounds = { static_cast<int>(g + i), 0, static_cast<int>(g + i) + 40, 32 };
+        info.regions[i].hit = static_cast<int32_t>(HitCode::Client);
+    }
+    return info;
+}
+
+static bool IsConsistent(const SharedWindowInfo& info) {
+    uint32_t g = static_cast<uint32_t>(info.captionHeight);
+    SharedWindowInfo expected = MakeInfo(info.window, g);
+    expected.processId = info.processId;
+    return std::memcmp(&expected, &info, sizeof(info)) == 0;
+}
+
+static void* MapRegistry(int fd, size_t size) {
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    return memory == MAP_FAILED ? nullptr : memory;
+}
+
+// Writer process: attach through its own mapping and publish forever
+static void RunWriter(int fd, size_t size) {
+    SharedWindowRegistry registry;
+    void* memory = MapRegistry(fd, size);
+    if (memory == nullptr || !registry.Open(memory, size, kSlots)) {
+        _exit(2);
+    }
+
+    uint32_t processId = static_cast<uint32_t>(getpid());
+    int slots[kWriterWindows];
+    for (int i = 0; i < kWriterWindows; i++) {
+        slots[i] = registry.Claim(processId, 0x1000 + i);
+        if (slots[i] < 0) {
+            _exit(3);
+        }
+    }
+    for (uint32_t g = 1;; g++) {
+        for (int i = 0; i < kWriterWindows; i++) {
+            registry.Publish(slots[i], processId, MakeInfo(0x1000 + i, g));
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+
+    size_t size = SharedWindowRegistry::RequiredBytes(kSlots);
+    int fd = memfd_create("window_decoration_registry", 0);
+    if (fd < 0 || ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        std::printf("memfd_create failed\n");
+        return 1;
+    }
+
+    SharedWindowRegistry registry;
+    void* memory = MapRegistry(fd, size);
+    if (memory == nullptr || !registry.Open(memory, size, kSlots)) {
+        std::printf("Failed to open the registry\n");
+        return 1;
+    }
+
+    // A window of this process, published once
+    uint32_t self = static_cast<uint32_t>(getpid());
+    int ownSlot = registry.Claim(self, 0x42);
+    registry.Publish(ownSlot, self, MakeInfo(0x42, 7));
+
+    pid_t writer = fork();
+    if (writer == 0) {
+        RunWriter(fd, size);
+    }
+
+    // Wait for the writer to publish all of its windows
+    SharedWindowInfo windows[kSlots];
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (registry.ReadAll(windows, kSlots) < 1 + kWriterWindows) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            std::printf("Writer never published\n");
+            kill(writer, SIGKILL);
+            return 1;
+        }
+        std::this_thread::yield();
+    }
+
+    bool ok = true;
+    uint64_t torn = 0;
+    uint64_t reads = 0;
+
+    // One window owned by the (busy) writer process
+    int remoteSlot = ownSlot == 0 ? 1 : 0;
+    double readNs = MeasureNsPerOp(2000000, [&](uint64_t) {
+        SharedWindowInfo info;
+        if (registry.Read(remoteSlot, &info)) {
+            torn += IsConsistent(info) ? 0 : 1;
+            reads++;
+        }
+    });
+    ok &= Report("Read (writer publishing)", readNs, maxNs);
+
+    double readAllNs = MeasureNsPerOp(200000, [&](uint64_t) {
+        uint32_t count = registry.ReadAll(windows, kSlots);
+        for (uint32_t i = 0; i < count; i++) {
+            torn += IsConsistent(windows[i]) ? 0 : 1;
+        }
+        reads += count;
+    });
+    Report("ReadAll (9 windows, 2 processes)", readAllNs, 0);
+
+    kill(writer, SIGKILL);
+    waitpid(writer, nullptr, 0);
+
+    // The writer died without cleaning up; reclaim its slots
+    uint32_t released = registry.ReleaseProcess(static_cast<uint32_t>(writer));
+    uint32_t remaining = registry.ReadAll(windows, kSlots);
+
+    std::printf("%-40s %10llu\n", "Reads", static_cast<unsigned long long>(reads));
+    std::printf("%-40s %10llu\n", "Torn reads", static_cast<unsigned long long>(torn));
+    std::printf("%-40s %10u\n", "Slots reclaimed from writer", released);
+
+    munmap(memory, size);
+    close(fd);
+
+    if (torn != 0 || reads == 0 || released != kWriterWindows || remaining != 1 || windows[0].window != 0x42) {
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,278 @@
+// Window Decoration Core - Window animation benchmark
+// Runs WindowAnimation against a simulated frame clock, the way the
+// backends step it from theirs, so the results are the same on every run
+// and machine:
+//
+//   - slide: a 250 ms ease-out move on a 60 Hz display
+//   - stalled slide: the same with six frames lost to a busy UI thread
+//   - fade: a 200 ms linear fade in on a 144 Hz display
+//
+// For each it prints the frames stepped, the frames dropped and the
+// geometry and opacity calls a backend makes. Every animation must end
+// exactly on its target, on time, with at most one geometry call per frame;
+// a move must never change the size, progress must never go backwards and
+// the dropped frames must match the simulated stall. The curves, parameter
+// checks and replacing a running animation are checked too. A mismatch
+// exits with status 1. The cost of Step() itself is measured for real.
+
+#include <cmath>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/window_animation.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+static const int64_t kMs = 1000000;
+static const int64_t k60Hz = 16666667;
+static const int64_t k144Hz = 6944444;
+
+struct SimResult {
+    uint64_t frames;
+    uint64_t droppedFrames;
+    uint64_t geometryCalls;
+    uint64_t opacityCalls;
+    int64_t finishedNs;  // frame time of the last frame
+};
+
+static WindowAnimationParams MakeParams(const Rect& bounds, double opacity, int64_t durationNs, AnimationCurve curve,
+                                        uint32_t properties) {
+    WindowAnimationParams params;
+    params.bounds = bounds;
+    params.opacity = opacity;
+    params.durationNs = durationNs;
+    params.curve = static_cast<int32_t>(curve);
+    params.properties = properties;
+    return params;
+}
+
+static bool SameRect(const Rect& a, const Rect& b) {
+    return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+}
+
+// Step an animation started at time 0 on every refresh, except the
+// refreshes in [stallFirst, stallLast] (1-based)
+static SimResult Simulate(WindowAnimation& animation, const WindowAnimationParams& params, int64_t intervalNs,
+                          int stallFirst, int stallLast, uint64_t* errors) {
+    SimResult result = {};
+    Rect previous = {};
+    double previousOpacity = -1.0;
+    bool first = true;
+
+    WindowAnimationFrame frame;
+    for (int refresh = 1; animation.running(); refresh++) {
+        if (refresh >= stallFirst && refresh <= stallLast) {
+            continue;
+        }
+
+        int64_t now = static_cast<int64_t>(refresh) * intervalNs;
+        *errors += animation.Step(now, intervalNs, &frame) ? 0 : 1;
+        result.geometryCalls += (frame.changed & ANIMATE_BOUNDS) ? 1 : 0;
+        result.opacityCalls += (frame.changed & ANIMATE_OPACITY) ? 1 : 0;
+        result.finishedNs = now;
+
+        if ((params.properties & ANIMATE_BOUNDS) == 0) {
+            *errors += (frame.changed & ANIMATE_BOUNDS) ? 1 : 0;
+        }
+        if ((params.properties & ANIMATE_OPACITY) == 0) {
+            *errors += (frame.changed & ANIMATE_OPACITY) ? 1 : 0;
+        }
+
+        // Moving right and down, fading in: progress never goes back
+        if (!first) {
+            *errors += frame.bounds.left < previous.left || frame.bounds.top < previous.top ? 1 : 0;
+            *errors += frame.opacity < previousOpacity ? 1 : 0;
+        }
+        previous = frame.bounds;
+        previousOpacity = frame.opacity;
+        first = false;
+    }
+
+    // Ends on the target, no later than the first refresh past the duration
+    *errors += frame.finished ? 0 : 1;
+    if (params.properties & ANIMATE_BOUNDS) {
+        *errors += SameRect(frame.bounds, params.bounds) ? 0 : 1;
+    }
+    if (params.properties & ANIMATE_OPACITY) {
+        *errors += frame.opacity == params.opacity ? 0 : 1;
+    }
+    *errors += result.finishedNs >= params.durationNs + intervalNs ? 1 : 0;
+
+    result.frames = animation.stats().frames;
+    result.droppedFrames = animation.stats().droppedFrames;
+    return result;
+}
+
+static void PrintResult(const char* name, const SimResult& result) {
+    std::printf("%-40s %4llu frames, %3llu dropped, %4llu geometry calls, %4llu opacity calls, done at %6.2f ms\n",
+                name, static_cast<unsigned long long>(result.frames),
+                static_cast<unsigned long long>(result.droppedFrames),
+                static_cast<unsigned long long>(result.geometryCalls),
+                static_cast<unsigned long long>(result.opacityCalls),
+                static_cast<double>(result.finishedNs) / kMs);
+}
+
+// Endpoints, monotonicity and symmetry of the curves
+static uint64_t CheckCurves() {
+    uint64_t errors = 0;
+    const AnimationCurve curves[] = {
+        AnimationCurve::Linear, AnimationCurve::EaseIn, AnimationCurve::EaseOut, AnimationCurve::EaseInOut,
+    };
+    for (AnimationCurve curve : curves) {
+        errors += EvaluateCurve(curve, 0.0) == 0.0 && EvaluateCurve(curve, 1.0) == 1.0 ? 0 : 1;
+        errors += EvaluateCurve(curve, -1.0) == 0.0 && EvaluateCurve(curve, 2.0) == 1.0 ? 0 : 1;
+        double previous = 0.0;
+        for (int i = 1; i <= 1000; i++) {
+            double value = EvaluateCurve(curve, i / 1000.0);
+            errors += value < previous ? 1 : 0;
+            previous = value;
+        }
+    }
+    errors += std::fabs(EvaluateCurve(AnimationCurve::EaseInOut, 0.5) - 0.5) < 1e-12 ? 0 : 1;
+    errors += EvaluateCurve(AnimationCurve::EaseIn, 0.5) < 0.5 && EvaluateCurve(AnimationCurve::EaseOut, 0.5) > 0.5
+                  ? 0
+                  : 1;
+    return errors;
+}
+
+// Parameter checks, replacement, cancellation and zero durations
+static uint64_t CheckLifecycle() {
+    uint64_t errors = 0;
+    const Rect from = { 0, 0, 800, 600 };
+    const Rect to = { 100, 100, 900, 700 };
+
+    WindowAnimation animation;
+    WindowAnimationFrame frame;
+    errors += animation.Step(0, k60Hz, &frame) || animation.Cancel() ? 1 : 0;
+
+    // Rejected without touching the running animation
+    errors += animation.Start(MakeParams(to, 1.0, 100 * kMs, AnimationCurve::Linear, ANIMATE_BOUNDS), from, 1.0)
+                  ? 0
+                  : 1;
+    errors += animation.Start(MakeParams(to, 1.0, 100 * kMs, AnimationCurve::Linear, 0), from, 1.0) ? 1 : 0;
+    errors += animation.Start(MakeParams(to, 1.0, 100 * kMs, AnimationCurve::Linear, 1 << 5), from, 1.0) ? 1 : 0;
+    errors += animation.Start(MakeParams(to, 1.0, 100 * kMs, static_cast<AnimationCurve>(9), ANIMATE_BOUNDS), from,
+                              1.0)
+                  ? 1
+                  : 0;
+    errors += animation.Start(MakeParams(to, 1.0, -1, AnimationCurve::Linear, ANIMATE_BOUNDS), from, 1.0) ? 1 : 0;
+    errors += animation.Start(MakeParams({ 10, 10, 10, 50 }, 1.0, 100 * kMs, AnimationCurve::Linear, ANIMATE_BOUNDS),
+                              from, 1.0)
+                  ? 1
+                  : 0;
+    errors += animation.running() && animation.stats().started == 1 && animation.stats().cancelled == 0 ? 0 : 1;
+
+    // A newer animation replaces the running one from where it got to
+    animation.Step(k60Hz, k60Hz, &frame);
+    Rect reached = frame.bounds;
+    errors += animation.Start(MakeParams(from, 0.5, 100 * kMs, AnimationCurve::Linear, ANIMATE_OPACITY), reached, 1.0)
+                  ? 0
+                  : 1;
+    errors += animation.stats().cancelled == 1 ? 0 : 1;
+    animation.Step(2 * k60Hz, k60Hz, &frame);
+    errors += SameRect(frame.bounds, reached) && frame.opacity < 1.0 && frame.changed == ANIMATE_OPACITY ? 0 : 1;
+
+    errors += animation.Cancel() && !animation.Cancel() && !animation.running() ? 0 : 1;
+    errors += animation.stats().cancelled == 2 && animation.stats().completed == 0 ? 0 : 1;
+
+    // Zero duration: the first frame is the target
+    errors += animation.Start(MakeParams(to, 0.25, 0, AnimationCurve::EaseInOut, ANIMATE_BOUNDS | ANIMATE_OPACITY),
+                              from, 1.0)
+                  ? 0
+                  : 1;
+    errors += animation.Step(10 * k60Hz, k60Hz, &frame) ? 0 : 1;
+    errors += frame.finished && SameRect(frame.bounds, to) && frame.opacity == 0.25 &&
+                      frame.changed == (ANIMATE_BOUNDS | ANIMATE_OPACITY) && !animation.running()
+                  ? 0
+                  : 1;
+    errors += animation.stats().completed == 1 && animation.stats().started == 3 ? 0 : 1;
+
+    // Finish jumps to the target without stepping a frame
+    errors += animation.Finish(&frame) ? 1 : 0;
+    errors += animation.Start(MakeParams(from, 1.0, 100 * kMs, AnimationCurve::EaseIn, ANIMATE_BOUNDS), to, 0.25)
+                  ? 0
+                  : 1;
+    errors += animation.Finish(&frame) && frame.finished && SameRect(frame.bounds, from) && frame.opacity == 0.25 &&
+                      frame.changed == ANIMATE_BOUNDS && !animation.running()
+                  ? 0
+                  : 1;
+    errors += animation.stats().completed == 2 && animation.stats().frames == 3 ? 0 : 1;
+    return errors;
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    uint64_t errors = 0;
+    bool ok = true;
+
+    const Rect from = { -200, 100, 600, 700 };
+    const Rect slideTo = { 400, 300, 1200, 900 };
+    WindowAnimationParams slide = MakeParams(slideTo, 1.0, 250 * kMs, AnimationCurve::EaseOut, ANIMATE_BOUNDS);
+
+    SimResult smooth;
+    {
+        WindowAnimation animation;
+        animation.Start(slide, from, 1.0);
+        smooth = Simulate(animation, slide, k60Hz, 0, -1, &errors);
+        PrintResult("Slide (60 Hz)", smooth);
+        errors += smooth.droppedFrames == 0 && smooth.geometryCalls > 0 && smooth.geometryCalls <= smooth.frames ? 0 : 1;
+    }
+
+    {
+        // Refreshes 5 to 10 are lost
+        WindowAnimation animation;
+        animation.Start(slide, from, 1.0);
+        SimResult stalled = Simulate(animation, slide, k60Hz, 5, 10, &errors);
+        PrintResult("Slide, 100 ms stall (60 Hz)", stalled);
+        errors += stalled.droppedFrames == 6 && stalled.frames + 6 == smooth.frames ? 0 : 1;
+        errors += stalled.finishedNs == smooth.finishedNs ? 0 : 1;
+    }
+
+    {
+        WindowAnimationParams fade = MakeParams({}, 1.0, 200 * kMs, AnimationCurve::Linear, ANIMATE_OPACITY);
+        WindowAnimation animation;
+        animation.Start(fade, from, 0.0);
+        SimResult faded = Simulate(animation, fade, k144Hz, 0, -1, &errors);
+        PrintResult("Fade in (144 Hz)", faded);
+        errors += faded.geometryCalls == 0 && faded.opacityCalls == faded.frames ? 0 : 1;
+    }
+
+    // A pure move keeps the size on every frame
+    {
+        WindowAnimation animation;
+        animation.Start(slide, from, 1.0);
+        WindowAnimationFrame frame;
+        for (int64_t now = 3 * kMs; animation.running(); now += 3 * kMs) {
+            animation.Step(now, 0, &frame);
+            errors += frame.bounds.right - frame.bounds.left != 800 || frame.bounds.bottom - frame.bounds.top != 600
+                          ? 1
+                          : 0;
+        }
+    }
+
+    errors += CheckCurves();
+    errors += CheckLifecycle();
+
+    // Cost of one step, restarting whenever the animation ends
+    {
+        const Rect to = { 1000, 500, 2200, 1400 };
+        WindowAnimationParams params =
+            MakeParams(to, 0.0, 500 * kMs, AnimationCurve::EaseInOut, ANIMATE_BOUNDS | ANIMATE_OPACITY);
+        WindowAnimation animation;
+        WindowAnimationFrame frame;
+        double ns = MeasureNsPerOp(10000000, [&](uint64_t i) {
+            if (!animation.running()) {
+                animation.Start(params, from, 1.0);
+            }
+            animation.Step(static_cast<int64_t>(i) * kMs, k60Hz, &frame);
+            DoNotOptimize(frame.bounds.left);
+        });
+        ok &= Report("Step (bounds + opacity)", ns, maxNs);
+    }
+
+    if (errors != 0) {
+        std::printf("Window animation mismatches: %llu\n", static_cast<unsigned long long>(errors));
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,217 @@
+// Window Decoration Core - Window event stream benchmark
+// Throughput and delivery latency of WindowEventStream, with batches
+// posted through PostWindowEvents to a stand-in for Dart_PostCObject that
+// decodes the message like the Dart side does:
+//
+//   - saturated: a producer pushes as fast as the ring accepts, without
+//     frame pacing (events/s the stream can carry)
+//   - drag: 1000 moves/s for one second at 16 ms frames, plus focus
+//     changes and close requests (coalescing ratio and latency)
+//   - idle: single events 20 ms apart (latency of the first event of a
+//     frame)
+//
+// The last delivered move must be the last one pushed, every close request
+// must arrive in order, and nothing may be dropped at realistic rates; a
+// mismatch exits with status 1.
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/dart_port.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+static const uint64_t kWindow = 0x7000;
+
+// What the Dart side sees: the decoded records of every message
+struct Receiver {
+    std::mutex mutex;
+    std::vector<WindowEvent> events;
+    uint64_t messages = 0;
+    double totalLatencyNs = 0;
+    double maxLatencyNs = 0;
+};
+
+static Receiver* g_receiver = nullptr;
+
+// Stand-in for Dart_PostCObject: check the message, copy the records out
+static bool FakePostCObject(int64_t port, DartCObject* message) {
+    if (port != 42 || message->type != DART_COBJECT_TYPED_DATA ||
+        message->value.asTypedData.type != DART_TYPED_DATA_UINT8 ||
+        message->value.asTypedData.length % sizeof(WindowEvent) != 0) {
+        return false;
+    }
+
+    uint64_t now = WindowEventClock();
+    size_t count = static_cast<size_t>(message->value.asTypedData.length) / sizeof(WindowEvent);
+    const WindowEvent* events = reinterpret_cast<const WindowEvent*>(message->value.asTypedData.values);
+
+    std::lock_guard<std::mutex> lock(g_receiver->mutex);
+    for (size_t i = 0; i < count; i++) {
+        double latency = static_cast<double>(now - events[i].timestampNs);
+        g_receiver->totalLatencyNs += latency;
+        g_receiver->maxLatencyNs = std::max(g_receiver->maxLatencyNs, latency);
+        g_receiver->events.push_back(events[i]);
+    }
+    g_receiver->messages++;
+    return true;
+}
+
+static WindowEvent MakeEvent(WindowEventType type, int32_t a, int32_t b) {
+    WindowEvent event = {};
+    event.window = kWindow;
+    event.timestampNs = WindowEventClock();
+    event.type = type;
+    event.values[0] = a;
+    event.values[1] = b;
+    return event;
+}
+
+static void Deliver(const WindowEvent* events, size_t count) {
+    PostWindowEvents(FakePostCObject, 42, events, count);
+}
+
+static void PrintStats(const char* name, const WindowEventStats& stats) {
+    std::printf("%-40s %10llu pushed, %llu delivered, %llu coalesced, %llu batches, %llu dropped\n", name,
+                static_cast<unsigned long long>(stats.pushed), static_cast<unsigned long long>(stats.delivered),
+                static_cast<unsigned long long>(stats.coalesced), static_cast<unsigned long long>(stats.batches),
+                static_cast<unsigned long long>(stats.dropped));
+}
+
+// Wait until the stream has handed everything pushed to the callback
+static void Drain(WindowEventStream& stream) {
+    for (;;) {
+        WindowEventStats stats = stream.stats();
+        if (stats.delivered + stats.coalesced == stats.pushed) return;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    typedef std::chrono::steady_clock Clock;
+    uint64_t errors = 0;
+    bool ok = true;
+
+    // Coalescing on its own: the latest move and resize per window survive,
+    // show state changes and close requests all stay, in order
+    {
+        WindowEvent events[] = {
+            MakeEvent(WindowEventType::Moved, 1, 1),
+            MakeEvent(WindowEventType::Maximized, 0, 0),
+            MakeEvent(WindowEventType::Moved, 2, 2),
+            MakeEvent(WindowEventType::Resized, 10, 10),
+            MakeEvent(WindowEventType::Restored, 0, 0),
+            MakeEvent(WindowEventType::Resized, 20, 20),
+            MakeEvent(WindowEventType::CloseRequested, 0, 0),
+            MakeEvent(WindowEventType::Moved, 3, 3),
+        };
+        events[7].window = kWindow + 1;
+        size_t kept = CoalesceWindowEvents(events, 8);
+        WindowEventType expected[] = { WindowEventType::Maximized, WindowEventType::Moved,
+                                       WindowEventType::Restored, WindowEventType::Resized,
+                                       WindowEventType::CloseRequested, WindowEventType::Moved };
+        errors += kept != 6 ? 1 : 0;
+        for (size_t i = 0; i < kept && i < 6; i++) {
+            errors += events[i].type != expected[i] ? 1 : 0;
+        }
+        errors += kept >= 4 && (events[1].values[0] != 2 || events[3].values[0] != 20) ? 1 : 0;
+    }
+
+    // Saturated: no pacing, the producer retries while the ring is full
+    {
+        Receiver receiver;
+        g_receiver = &receiver;
+        WindowEventStream stream(Deliver, std::chrono::nanoseconds(0));
+        const uint64_t count = 2000000;
+        Clock::time_point start = Clock::now();
+        double pushNs = MeasureNsPerOp(count, [&](uint64_t i) {
+            WindowEvent event = MakeEvent(i % 5 == 0 ? WindowEventType::Resized : WindowEventType::Moved,
+                                          static_cast<int32_t>(i), 0);
+            while (!stream.Push(event)) {
+                std::this_thread::yield();
+            }
+        });
+        Drain(stream);
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        WindowEventStats stats = stream.stats();
+
+        ok &= Report("Push (saturated, consumer draining)", pushNs, maxNs);
+        std::printf("%-40s %10.0f events/s\n", "Throughput (saturated)", static_cast<double>(stats.pushed) / seconds);
+        PrintStats("Saturated", stats);
+    }
+
+    // Drag at 1000 moves/s with 16 ms frames
+    {
+        Receiver receiver;
+        g_receiver = &receiver;
+        WindowEventStream stream(Deliver);
+        const int moves = 1000;
+        int closes = 0;
+        Clock::time_point next = Clock::now();
+        for (int i = 1; i <= moves; i++) {
+            stream.Push(MakeEvent(WindowEventType::Moved, i, -i));
+            if (i % 100 == 0) {
+                stream.Push(MakeEvent(WindowEventType::FocusChanged, (i / 100) & 1, 0));
+            }
+            if (i % 250 == 0) {
+                stream.Push(MakeEvent(WindowEventType::CloseRequested, ++closes, 0));
+            }
+            next += std::chrono::milliseconds(1);
+            std::this_thread::sleep_until(next);
+        }
+        Drain(stream);
+        WindowEventStats stats = stream.stats();
+
+        std::lock_guard<std::mutex> lock(receiver.mutex);
+        double meanNs = receiver.events.empty() ? 0 : receiver.totalLatencyNs / receiver.events.size();
+        std::printf("%-40s %10.0f ns\n", "Delivery latency (drag, mean)", meanNs);
+        std::printf("%-40s %10.0f ns\n", "Delivery latency (drag, max)", receiver.maxLatencyNs);
+        PrintStats("Drag", stats);
+        std::printf("%-40s %10llu\n", "Messages posted", static_cast<unsigned long long>(receiver.messages));
+
+        int lastMove = 0;
+        int closeSeen = 0;
+        for (const WindowEvent& event : receiver.events) {
+            if (event.type == WindowEventType::Moved) {
+                errors += event.values[0] <= lastMove || event.values[1] != -event.values[0] ? 1 : 0;
+                lastMove = event.values[0];
+            } else if (event.type == WindowEventType::CloseRequested) {
+                errors += event.values[0] != ++closeSeen ? 1 : 0;
+            }
+        }
+        errors += lastMove != moves || closeSeen != closes || stats.dropped != 0 ? 1 : 0;
+
+        // Far fewer messages than events: at most about one per frame
+        errors += stats.coalesced == 0 || receiver.messages > stats.pushed / 4 ? 1 : 0;
+    }
+
+    // Idle: each event starts a new frame and is delivered right away
+    {
+        Receiver receiver;
+        g_receiver = &receiver;
+        WindowEventStream stream(Deliver);
+        const int count = 50;
+        for (int i = 0; i < count; i++) {
+            stream.Push(MakeEvent(WindowEventType::DpiChanged, 96 + i, 0));
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        Drain(stream);
+
+        std::lock_guard<std::mutex> lock(receiver.mutex);
+        double meanNs = receiver.events.empty() ? 0 : receiver.totalLatencyNs / receiver.events.size();
+        std::printf("%-40s %10.0f ns\n", "Delivery latency (idle, mean)", meanNs);
+        errors += receiver.events.size() != static_cast<size_t>(count) ? 1 : 0;
+    }
+
+    if (errors != 0) {
+        std::printf("Window event stream mismatches: %llu\n", static_cast<unsigned long long>(errors));
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
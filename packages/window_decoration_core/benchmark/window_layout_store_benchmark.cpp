@@ -0,0 +1,256 @@
+// Window Decoration Core - Window layout store benchmark
+// Checks the layout file format and restore rules, then measures the
+// startup path:
+//
+//   - a store of random layouts survives Encode/Load unchanged and encodes
+//     to the same bytes again; Put() of an unchanged layout is not a change
+//   - truncated, corrupted and other-major-version images are rejected,
+//     a newer minor version (longer records) loads
+//   - ids must be 1 - MAX_WINDOW_LAYOUT_ID_BYTES bytes
+//   - ResolveWindowLayout keeps the bounds while the monitor is unchanged
+//     and falls back into a work area when it was unplugged, moved or
+//     rescaled
+//
+// Any mismatch exits with status 1. The cost of Load() plus one Find() is
+// what a backend pays before showing a window.
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/window_layout_store.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+static MonitorInfo Monitor(uint64_t id, int left, int top, int width, int height, uint32_t dpi, int taskbar = 0,
+                           uint32_t flags = 0) {
+    MonitorInfo monitor = {};
+    monitor.id = id;
+    monitor.bounds = { left, top, left + width, top + height };
+    monitor.workArea = { left, top, left + width, top + height - taskbar };
+    monitor.dpi = dpi;
+    monitor.flags = flags;
+    return monitor;
+}
+
+static bool SameRect(const Rect& a, const Rect& b) {
+    return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+}
+
+static bool SameLayout(const WindowLayout& a, const WindowLayout& b) {
+    return SameRect(a.bounds, b.bounds) && a.monitor == b.monitor && a.flags == b.flags && a.frameMode == b.frameMode;
+}
+
+static bool Inside(const Rect& rect, const Rect& area) {
+    return rect.left >= area.left && rect.top >= area.top && rect.right <= area.right && rect.bottom <= area.bottom;
+}
+
+static std::string WindowId(uint32_t i) {
+    return "window-" + std::to_string(i * 7919u % 1000u) + "-" + std::to_string(i);
+}
+
+static WindowLayout RandomLayout(Random& random) {
+    WindowLayout layout;
+    int left = random.Range(-2000, 4000);
+    int top = random.Range(-500, 2000);
+    layout.bounds = { left, top, left + random.Range(200, 2000), top + random.Range(150, 1400) };
+    layout.monitor = (static_cast<uint64_t>(random.Next()) << 32) | random.Next();
+    layout.flags = random.Next() % 4;
+    layout.frameMode = random.Range(0, 3);
+    return layout;
+}
+
+static std::vector<uint8_t> EncodeStore(const WindowLayoutStore& store) {
+    std::vector<uint8_t> image(store.EncodedSize());
+    if (store.Encode(image.data(), image.size()) != image.size()) {
+        image.clear();
+    }
+    return image;
+}
+
+// Format round trip and rejection of bad images
+static uint64_t CheckFormat() {
+    uint64_t errors = 0;
+    Random random;
+    WindowLayoutStore store;
+    std::vector<WindowLayout> layouts;
+    for (uint32_t i = 0; i < 64; i++) {
+        layouts.push_back(RandomLayout(random));
+        errors += store.Put(WindowId(i).c_str(), layouts.back()) ? 0 : 1;
+    }
+    errors += store.dirty() && store.size() == 64 ? 0 : 1;
+
+    std::vector<uint8_t> image = EncodeStore(store);
+    errors += store.Encode(image.data(), image.size() - 1) == 0 ? 0 : 1;
+    WindowLayoutStore loaded;
+    errors += loaded.Load(image.data(), image.size()) && loaded.size() == 64 && !loaded.dirty() ? 0 : 1;
+    for (uint32_t i = 0; i < 64; i++) {
+        WindowLayout layout;
+        errors += loaded.Find(WindowId(i).c_str(), &layout) && SameLayout(layout, layouts[i]) ? 0 : 1;
+    }
+    WindowLayout missing;
+    errors += loaded.Find("window-none", &missing) || loaded.Find("", &missing) ? 1 : 0;
+    errors += EncodeStore(loaded) == image ? 0 : 1;
+
+    // Unchanged layouts are not changes; a removal is
+    errors += loaded.Put(WindowId(3).c_str(), layouts[3]) && !loaded.dirty() ? 0 : 1;
+    errors += loaded.Remove(WindowId(3).c_str()) && loaded.dirty() && !loaded.Remove(WindowId(3).c_str()) ? 0 : 1;
+    errors += loaded.Find(WindowId(3).c_str(), &missing) ? 1 : 0;
+
+    // No file yet
+    errors += loaded.Load(nullptr, 0) && loaded.size() == 0 ? 0 : 1;
+
+    // Truncated, corrupted, foreign
+    std::vector<uint8_t> bad(image.begin(), image.end() - 1);
+    errors += !loaded.Load(bad.data(), bad.size()) && loaded.size() == 0 ? 0 : 1;
+    bad = image;
+    bad[bad.size() / 2] ^= 0x40;
+    errors += !loaded.Load(bad.data(), bad.size()) && loaded.size() == 0 ? 0 : 1;
+    bad = image;
+    bad[4] = static_cast<uint8_t>(WINDOW_LAYOUT_MAJOR_VERSION + 1);  // majorVersion, low byte
+    errors += !loaded.Load(bad.data(), bad.size()) ? 0 : 1;
+    bad = image;
+    bad[0] ^= 1;  // magic
+    errors += !loaded.Load(bad.data(), bad.size()) ? 0 : 1;
+
+    // A newer minor version with 8 more bytes per record
+    {
+        const size_t headerSize = 24;
+        const size_t recordSize = (image.size() - headerSize) / 64;
+        std::vector<uint8_t> newer(image.begin(), image.begin() + headerSize);
+        for (size_t i = 0; i < 64; i++) {
+            auto record = image.begin() + static_cast<std::ptrdiff_t>(headerSize + i * recordSize);
+            newer.insert(newer.end(), record, record + static_cast<std::ptrdiff_t>(recordSize));
+            newer.insert(newer.end(), 8, 0xAB);
+        }
+        uint32_t checksum = 2166136261u;
+        for (size_t i = headerSize; i < newer.size(); i++) {
+            checksum = (checksum ^ newer[i]) * 16777619u;
+        }
+        uint16_t minor = WINDOW_LAYOUT_MINOR_VERSION + 1;
+        uint32_t newerRecordSize = static_cast<uint32_t>(recordSize + 8);
+        std::memcpy(&newer[6], &minor, sizeof(minor));
+        std::memcpy(&newer[12], &newerRecordSize, sizeof(newerRecordSize));
+        std::memcpy(&newer[20], &checksum, sizeof(checksum));
+        WindowLayout layout;
+        errors += loaded.Load(newer.data(), newer.size()) && loaded.size() == 64 ? 0 : 1;
+        errors += loaded.Find(WindowId(17).c_str(), &layout) && SameLayout(layout, layouts[17]) ? 0 : 1;
+    }
+
+    // Id limits
+    WindowLayoutStore ids;
+    std::string longest(MAX_WINDOW_LAYOUT_ID_BYTES, 'x');
+    std::string tooLong(MAX_WINDOW_LAYOUT_ID_BYTES + 1, 'x');
+    errors += ids.Put(longest.c_str(), layouts[0]) ? 0 : 1;
+    errors += ids.Put(tooLong.c_str(), layouts[0]) || ids.Put("", layouts[0]) || ids.Put(nullptr, layouts[0]) ? 1 : 0;
+    errors += ids.size() == 1 ? 0 : 1;
+    return errors;
+}
+
+// Restore on the monitors the layout was saved on, and on changed ones
+static uint64_t CheckRestore() {
+    uint64_t errors = 0;
+
+    // A 1440p primary with a 1080p monitor to its right
+    const MonitorInfo primary = Monitor(1, 0, 0, 2560, 1440, 96, 48, MONITOR_PRIMARY);
+    const MonitorInfo right = Monitor(2, 2560, 0, 1920, 1080, 96, 40);
+    MonitorTopology topology;
+    const MonitorInfo both[] = { primary, right };
+    topology.Update(both, 2);
+
+    WindowLayout onRight = {};
+    onRight.bounds = { 3000, 200, 4200, 1000 };
+    onRight.monitor = MonitorFingerprint(right);
+
+    // Same monitors in another run (other handles): kept as it was
+    MonitorTopology nextRun;
+    const MonitorInfo relaunched[] = { Monitor(7, 0, 0, 2560, 1440, 96, 48, MONITOR_PRIMARY),
+                                       Monitor(8, 2560, 0, 1920, 1080, 96, 40) };
+    nextRun.Update(relaunched, 2);
+    Rect bounds = {};
+    errors += ResolveWindowLayout(nextRun, onRight, &bounds) == LayoutRestore::Exact ? 0 : 1;
+    errors += SameRect(bounds, onRight.bounds) ? 0 : 1;
+
+    // Right monitor unplugged: centered on the primary's work area
+    MonitorTopology unplugged;
+    unplugged.Update(&primary, 1);
+    errors += ResolveWindowLayout(unplugged, onRight, &bounds) == LayoutRestore::Fallback ? 0 : 1;
+    errors += Inside(bounds, primary.workArea) && bounds.right - bounds.left == 1200 &&
+                      bounds.bottom - bounds.top == 800 && bounds.left == (2560 - 1200) / 2
+                  ? 0
+                  : 1;
+
+    // Right monitor now 1280x720: still partly on it, pulled into it
+    MonitorTopology smaller;
+    const MonitorInfo resized[] = { primary, Monitor(2, 2560, 0, 1280, 720, 96, 40) };
+    smaller.Update(resized, 2);
+    errors += ResolveWindowLayout(smaller, onRight, &bounds) == LayoutRestore::Fallback ? 0 : 1;
+    errors += Inside(bounds, resized[1].workArea) ? 0 : 1;
+
+    // Same geometry at another scale is another monitor
+    MonitorTopology rescaled;
+    const MonitorInfo scaled[] = { primary, Monitor(2, 2560, 0, 1920, 1080, 144, 40) };
+    rescaled.Update(scaled, 2);
+    errors += ResolveWindowLayout(rescaled, onRight, &bounds) == LayoutRestore::Fallback ? 0 : 1;
+    errors += Inside(bounds, scaled[1].workArea) && SameRect(bounds, onRight.bounds) ? 0 : 1;
+
+    // Larger than the fallback work area: shrunk into it
+    WindowLayout huge = onRight;
+    huge.bounds = { 2600, 0, 2600 + 3000, 2000 };
+    errors += ResolveWindowLayout(unplugged, huge, &bounds) == LayoutRestore::Fallback ? 0 : 1;
+    errors += SameRect(bounds, primary.workArea) ? 0 : 1;
+
+    // No monitors
+    MonitorTopology none;
+    errors += ResolveWindowLayout(none, onRight, &bounds) == LayoutRestore::None ? 0 : 1;
+
+    // Fingerprints tell the monitors apart and ignore the handle
+    errors += MonitorFingerprint(primary) != MonitorFingerprint(right) ? 0 : 1;
+    errors += MonitorFingerprint(right) == MonitorFingerprint(relaunched[1]) ? 0 : 1;
+    return errors;
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    bool ok = true;
+
+    uint64_t errors = CheckFormat();
+    errors += CheckRestore();
+
+    // Startup: an app with 32 saved windows loads the image and looks up
+    // the one it is about to show
+    {
+        Random random;
+        WindowLayoutStore store;
+        std::vector<std::string> ids;
+        for (uint32_t i = 0; i < 32; i++) {
+            ids.push_back(WindowId(i));
+            store.Put(ids.back().c_str(), RandomLayout(random));
+        }
+        std::vector<uint8_t> image = EncodeStore(store);
+
+        WindowLayoutStore loaded;
+        double loadNs = MeasureNsPerOp(200000, [&](uint64_t i) {
+            WindowLayout layout = {};
+            loaded.Load(image.data(), image.size());
+            loaded.Find(ids[i % ids.size()].c_str(), &layout);
+            DoNotOptimize(layout.bounds.left);
+        });
+        ok &= Report("Load (32 layouts) + Find", loadNs, maxNs);
+
+        double findNs = MeasureNsPerOp(10000000, [&](uint64_t i) {
+            WindowLayout layout = {};
+            loaded.Find(ids[i % ids.size()].c_str(), &layout);
+            DoNotOptimize(layout.bounds.left);
+        });
+        ok &= Report("Find (32 layouts)", findNs, maxNs);
+    }
+
+    if (errors != 0) {
+        std::printf("Window layout store mismatches: %llu\n", static_cast<unsigned long long>(errors));
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
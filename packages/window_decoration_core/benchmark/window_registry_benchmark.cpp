@@ -0,0 +1,154 @@
+// Window Decoration Core - Window registry benchmark
+// Per-message lookup cost of the flat window registry versus
+// std::unordered_map ("map") at 1, 100 and 10k windows, for registered windows
+// (WndProc path) and for the hook's miss-then-parent pattern, plus memory
+// per window.
+
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/caption_snapshot.h"
+#include "window_decoration_core/frame_geometry_cache.h"
+#include "window_decoration_core/hit_test_policy.h"
+#include "window_decoration_core/hover_memo.h"
+#include "window_decoration_core/window_registry.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+// Same layout as the Windows plugin's per-window state
+struct HotState {
+    FrameMode frameMode;
+    HitTestFn hitTest;
+    ResizeCellFn resolveResizeCell;
+    FrameGeometryCache geometry;
+    HoverMemo hover;
+    void* hoverCursor;
+    CaptionPublisher captions;
+};
+
+struct ColdState {
+    void* originalWndProc;
+};
+
+struct MapState {
+    HotState hot;
+    ColdState cold;
+};
+
+typedef void* Handle;
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    const uint64_t iterations = 20000000;
+    const size_t counts[] = { 1, 100, 10000 };
+
+    std::printf("%-40s %10zu bytes hot, %zu bytes cold\n", "Per-window state",
+                sizeof(HotState), sizeof(ColdState));
+
+    bool ok = true;
+    char name[64];
+
+    for (size_t count : counts) {
+        // Handle values like HWNDs: small, 2-aligned, loosely sequential
+        Random random;
+        std::vector<Handle> handles(count);
+        std::vector<Handle> unmanaged(count);
+        uintptr_t next = 0x10000;
+        for (size_t i = 0; i < count; i++) {
+            next += 2 + 2 * random.Range(0, 64);
+            handles[i] = reinterpret_cast<Handle>(next);
+            next += 2 + 2 * random.Range(0, 64);
+            unmanaged[i] = reinterpret_cast<Handle>(next);
+        }
+
+        WindowRegistry<Handle, HotState, ColdState> registry;
+        std::unordered_map<Handle, MapState> map;
+        for (Handle handle : handles) {
+            uint32_t slot = registry.Insert(handle);
+            registry.hot(slot).frameMode = FrameMode::CustomFrame;
+            map[handle].hot.frameMode = FrameMode::CustomFrame;
+        }
+
+        // Random access order so large counts don't stay cache resident
+        std::vector<uint32_t> order(4096);
+        for (uint32_t& index : order) {
+            index = static_cast<uint32_t>(random.Range(0, static_cast<int>(count)));
+        }
+        const size_t mask = order.size() - 1;
+
+        double flatNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+            HotState* state = registry.FindHot(handles[order[i & mask]]);
+            DoNotOptimize(static_cast<int>(state->frameMode));
+        });
+        std::snprintf(name, sizeof(name), "flat lookup (%zu windows)", count);
+        ok &= Report(name, flatNs, maxNs);
+
+        double mapNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+            auto it = map.find(handles[order[i & mask]]);
+            DoNotOptimize(static_cast<int>(it->second.hot.frameMode));
+        });
+        std::snprintf(name, sizeof(name), "map lookup (%zu windows)", count);
+        Report(name, mapNs, 0);
+
+        // FindManagedWindow: the child window misses, its parent hits
+        double flatHookNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+            uint32_t index = order[i & mask];
+            HotState* state = registry.FindHot(unmanaged[index]);
+            if (state == nullptr) {
+                state = registry.FindHot(handles[index]);
+            }
+            DoNotOptimize(static_cast<int>(state->frameMode));
+        });
+        std::snprintf(name, sizeof(name), "flat miss + parent (%zu windows)", count);
+        ok &= Report(name, flatHookNs, maxNs);
+
+        double mapHookNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+            uint32_t index = order[i & mask];
+            auto it = map.find(unmanaged[index]);
+            if (it == map.end()) {
+                it = map.find(handles[index]);
+            }
+            DoNotOptimize(static_cast<int>(it->second.hot.frameMode));
+        });
+        std::snprintf(name, sizeof(name), "map miss + parent (%zu windows)", count);
+        Report(name, mapHookNs, 0);
+
+        std::snprintf(name, sizeof(name), "flat memory (%zu windows)", count);
+        std::printf("%-40s %10zu bytes/window\n", name, registry.MemoryBytes() / count);
+    }
+
+    // Churn: registering and unregistering must keep every other window
+    // reachable (backward-shift deletion)
+    WindowRegistry<Handle, HotState, ColdState> churn;
+    std::vector<Handle> live;
+    Random random;
+    for (int step = 0; step < 200000; step++) {
+        if (live.empty() || random.Range(0, 3) != 0) {
+            Handle handle = reinterpret_cast<Handle>(static_cast<uintptr_t>(2 + 2 * random.Range(0, 1 << 20)));
+            if (churn.Find(handle) == churn.kNoSlot) {
+                churn.cold(churn.Insert(handle)).originalWndProc = handle;
+                live.push_back(handle);
+            }
+        } else {
+            size_t index = static_cast<size_t>(random.Range(0, static_cast<int>(live.size())));
+            churn.Remove(live[index]);
+            live[index] = live.back();
+            live.pop_back();
+        }
+    }
+    for (Handle handle : live) {
+        uint32_t slot = churn.Find(handle);
+        if (slot == churn.kNoSlot || churn.cold(slot).originalWndProc != handle) {
+            std::printf("Churn lost a window\n");
+            return 1;
+        }
+    }
+    if (churn.size() != live.size()) {
+        std::printf("Churn size mismatch\n");
+        return 1;
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+// Window Decoration Core - Window state block benchmark
+// Cost of reading a window's state from its WindowStateBlock, the way Dart
+// reads it through a Pointer on every frame, with the writer idle and with
+// a writer thread republishing as fast as it can (far more often than any
+// window produces configure events). Every snapshot read must be internally
+// consistent (all fields derived from one generation); a torn read exits
+// with status 1. Also checks that released blocks read as gone and are
+// reused.
+
+#include <atomic>
+#include <thread>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/window_state_block.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+static const uint64_t kWindow = 0x5A5A0042;
+
+// State at generation g. Every field depends on g so a reader can tell if
+// it sees parts of two different publishes.
+static WindowStateInfo MakeState(uint32_t g) {
+    WindowStateInfo info = {};
+    int v = static_cast<int>(g);
+    info.bounds = { v, v + 1, v + 800, v + 600 };
+    info.monitor = { v & ~1023, 0, (v & ~1023) + 1920, 1080 };
+    info.workArea = { v & ~1023, 32, (v & ~1023) + 1920, 1080 };
+    info.dpi = 96 + g % 4 * 24;
+    info.frameMode = static_cast<int32_t>(g % 3);
+    info.flags = WINDOW_STATE_VALID | WINDOW_STATE_VISIBLE | (g & 1 ? WINDOW_STATE_FOCUSED : 0);
+    info.reserved = g;
+    return info;
+}
+
+static bool IsConsistent(uint64_t window, const WindowStateInfo& info) {
+    WindowStateInfo expected = MakeState(info.reserved);
+    return window == kWindow && std::memcmp(&expected, &info, sizeof(info)) == 0;
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+
+    WindowStateBlockPool pool;
+    WindowStateBlock* block = pool.Acquire(kWindow);
+    WindowStatePublisher publisher(block, kWindow);
+    publisher.state() = MakeState(1);
+    publisher.Publish();
+
+    bool ok = true;
+    uint64_t torn = 0;
+    uint64_t reads = 0;
+    auto read = [&](uint64_t) {
+        uint64_t window;
+        WindowStateInfo info;
+        if (ReadWindowState(*block, &window, &info)) {
+            torn += IsConsistent(window, info) ? 0 : 1;
+            reads++;
+        }
+    };
+
+    double idleNs = MeasureNsPerOp(5000000, read);
+    Report("read (writer idle)", idleNs, 0);
+
+    double publishNs = MeasureNsPerOp(5000000, [&](uint64_t i) {
+        publisher.state() = MakeState(static_cast<uint32_t>(i));
+        publisher.Publish();
+    });
+    Report("publish", publishNs, 0);
+
+    // Writer thread republishing continuously
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> published(0);
+    std::thread writer([&] {
+        WindowStatePublisher threadPublisher(block, kWindow);
+        for (uint32_t g = 2; !stop.load(std::memory_order_relaxed); g++) {
+            threadPublisher.state() = MakeState(g);
+            threadPublisher.Publish();
+            published.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    double busyNs = MeasureNsPerOp(5000000, read);
+    ok &= Report("read (writer publishing)", busyNs, maxNs);
+
+    stop.store(true);
+    writer.join();
+
+    std::printf("%-40s %10llu\n", "Reads", static_cast<unsigned long long>(reads));
+    std::printf("%-40s %10llu\n", "Publishes during reads", static_cast<unsigned long long>(published.load()));
+    std::printf("%-40s %10llu\n", "Torn reads", static_cast<unsigned long long>(torn));
+
+    // A released block reads as gone; the next window reuses it
+    uint64_t errors = 0;
+    uint64_t window;
+    WindowStateInfo info;
+    pool.Release(block);
+    errors += ReadWindowState(*block, &window, &info) ? 1 : 0;
+    WindowStateBlock* reused = pool.Acquire(kWindow + 1);
+    errors += reused != block ? 1 : 0;
+    errors += !ReadWindowState(*reused, &window, &info) || window != kWindow + 1 || info.flags != 0 ? 1 : 0;
+    errors += pool.allocated() != 16 ? 1 : 0;
+    pool.Release(reused);
+
+    if (torn != 0 || reads == 0 || errors != 0) {
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
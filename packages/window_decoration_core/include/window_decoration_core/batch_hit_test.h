@@ -0,0 +1,44 @@
+// Window Decoration Core - Batch hit testing
+// Classifies many points at once (structure-of-arrays input) with the same
+// rules as HitTestCustomFrame / HitTestHiddenFrame. Used to replay recorded
+// pointer traces, render debug heat maps of the drag/resize regions and
+// bulk-validate layouts across DPI scales.
+// Vectorized with SSE2 (4 points) and AVX2 (8 points) on x86, with a scalar
+// fallback everywhere else. The instruction set is picked at runtime.
+
+#ifndef WINDOW_DECORATION_CORE_BATCH_HIT_TEST_H_
+#define WINDOW_DECORATION_CORE_BATCH_HIT_TEST_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "window_decoration_core/hit_test.h"
+
+namespace window_decoration {
+
+class CaptionMask;
+class CaptionRegionIndex;
+
+// Instruction set used by HitTestBatch
+enum class SimdLevel : uint8_t {
+    Scalar,
+    Sse2,
+    Avx2
+};
+
+// Best instruction set supported by this build and CPU (detected once)
+SimdLevel SupportedSimdLevel();
+
+// Hit test `count` points given as separate x and y arrays (relative to the
+// window origin) and write one HitCode per point to `results`.
+// In FrameMode::Normal every point is Client. `regions` and `mask` may be
+// null.
+// `level` is clamped to SupportedSimdLevel().
+void HitTestBatch(const int32_t* xs, const int32_t* ys, size_t count,
+                  const FrameGeometry& geometry, FrameMode mode,
+                  const CaptionLayout& caption, const CaptionRegionIndex* regions,
+                  const CaptionMask* mask, HitCode* results, SimdLevel level = SimdLevel::Avx2);
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_BATCH_HIT_TEST_H_
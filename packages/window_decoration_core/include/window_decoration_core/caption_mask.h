@@ -0,0 +1,79 @@
+// Window Decoration Core - Caption mask
+// 1-bit "interactive vs. draggable" mask of the caption area, uploaded by the
+// app as per-row run lengths in logical pixels. Describes shapes rectangles
+// can't (pill tabs, rounded buttons, overlapping widgets) in a few KB, with
+// an O(log runs) lookup per hit test.
+//
+// Run-length encoding (one uint16 array):
+//   for each row: N, run_0, run_1, ..., run_N-1
+// Runs alternate draggable / interactive, starting with draggable (use a
+// zero-length first run for a row that starts interactive). Pixels past the
+// last run are draggable; runs past the mask width are clipped.
+
+#ifndef WINDOW_DECORATION_CORE_CAPTION_MASK_H_
+#define WINDOW_DECORATION_CORE_CAPTION_MASK_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "window_decoration_core/hit_test.h"
+
+namespace window_decoration {
+
+// Mask size limits (logical pixels)
+constexpr int MAX_CAPTION_MASK_WIDTH = 16384;
+constexpr int MAX_CAPTION_MASK_HEIGHT = 1024;
+
+// Limit on interactive/draggable transitions over the whole mask (128 KB)
+constexpr size_t MAX_CAPTION_MASK_TRANSITIONS = 65536;
+
+class CaptionMask {
+ public:
+    CaptionMask();
+
+    // Replace the whole mask. `runs` holds `height` encoded rows.
+    // Returns false (and keeps the previous mask) if the size is out of
+    // range or the encoding is malformed.
+    bool Set(int width, int height, const uint16_t* runs, size_t length);
+
+    // Replace rows [firstRow, firstRow + rowCount) only. `runs` holds
+    // `rowCount` encoded rows. Returns false (and leaves the mask unchanged)
+    // if there is no mask, the rows are out of range or the encoding is
+    // malformed.
+    bool UpdateRows(int firstRow, int rowCount, const uint16_t* runs, size_t length);
+
+    // Remove the mask
+    void Clear();
+
+    bool empty() const { return height_ == 0; }
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    // Number of stored transitions (memory use is about 2 bytes each)
+    size_t transitions() const { return transitions_.size(); }
+
+    // Look up a point in client coordinates (physical pixels at `dpi`).
+    // Returns false outside the mask; otherwise sets `hit` to Client for
+    // interactive pixels and Caption for draggable ones.
+    bool Lookup(int x, int y, unsigned int dpi, HitCode* hit) const;
+
+ private:
+    // Decode `rowCount` rows into transition positions and per-row counts.
+    // Returns false if the encoding is malformed.
+    bool Decode(int width, int rowCount, const uint16_t* runs, size_t length,
+                std::vector<uint16_t>* transitions, std::vector<uint32_t>* rowCounts) const;
+
+    int width_;
+    int height_;
+
+    // x positions where a row flips between draggable and interactive,
+    // ascending per row; the first flip of each row enters interactive
+    // (CSR layout, rowStart_ has height_ + 1 entries)
+    std::vector<uint32_t> rowStart_;
+    std::vector<uint16_t> transitions_;
+};
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_CAPTION_MASK_H_
@@ -0,0 +1,93 @@
+// Window Decoration Core - Caption regions
+// Arbitrary-count named regions inside the caption area (tabs, search boxes,
+// menus, caption buttons...). Each region carries the hit code to report and
+// an optional rounded-rect shape. Lookups go through a uniform grid so the
+// cost per hit test stays flat as the title bar gets more complex.
+
+#ifndef WINDOW_DECORATION_CORE_CAPTION_REGIONS_H_
+#define WINDOW_DECORATION_CORE_CAPTION_REGIONS_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "window_decoration_core/hit_test.h"
+
+namespace window_decoration {
+
+// Maximum number of caption regions per window
+constexpr size_t MAX_CAPTION_REGIONS = 1024;
+
+// A single caption region (in client coordinates)
+struct CaptionRegion {
+    Rect bounds;
+
+    // Hit code reported inside the region: Client, Caption, MinButton,
+    // MaxButton or Close
+    HitCode hit;
+
+    // Corner radius for rounded-rect regions (0 for a plain rectangle)
+    int cornerRadius;
+};
+
+// Check if a hit code may be assigned to a caption region
+inline bool IsValidCaptionRegionHit(HitCode hit) {
+    return hit >= HitCode::Client && hit <= HitCode::Close;
+}
+
+// Named caption regions backed by a uniform grid.
+// Regions registered later are on top of earlier ones where they overlap.
+class CaptionRegionIndex {
+ public:
+    CaptionRegionIndex();
+
+    // Add or replace the region with the given name.
+    // Returns false if the region is invalid (empty bounds or bad hit code)
+    // or MAX_CAPTION_REGIONS is reached.
+    bool Set(const std::string& name, const CaptionRegion& region);
+
+    // Remove the region with the given name. Returns false if not found.
+    bool Remove(const std::string& name);
+
+    // Remove all regions
+    void Clear();
+
+    size_t size() const { return regions_.size(); }
+    bool empty() const { return regions_.empty(); }
+
+    // Region `index` in registration order (bottommost first)
+    const CaptionRegion& region(size_t index) const { return regions_[index].region; }
+
+    // Find the topmost region containing (x, y).
+    // Returns false if no region contains the point.
+    bool Lookup(int x, int y, HitCode* hit) const;
+
+ private:
+    struct NamedRegion {
+        std::string name;
+        CaptionRegion region;
+    };
+
+    // Rebuild the grid after the region set changed
+    void Rebuild();
+
+    std::vector<NamedRegion> regions_;
+
+    // Grid covering the bounding box of all regions
+    int originX_;
+    int originY_;
+    int columns_;
+    int rows_;
+    int cellShift_;
+
+    // Region indices per cell, topmost first (CSR layout)
+    std::vector<uint32_t> cellStart_;
+    std::vector<uint16_t> cellRegions_;
+};
+
+// Check if a point is inside a region's shape
+bool PointInCaptionRegion(int x, int y, const CaptionRegion& region);
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_CAPTION_REGIONS_H_
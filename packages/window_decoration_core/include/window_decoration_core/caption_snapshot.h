@@ -0,0 +1,139 @@
+// Window Decoration Core - Caption snapshots
+// The caption layout, named regions and caption mask are published as one
+// immutable snapshot. Writers (app layout code) build the next snapshot off
+// to the side and swap it in atomically; readers (hit testing on the message
+// loop) never lock and never see a half-written set of rects.
+//
+// Two snapshot slots with per-slot reader counts (read-copy-update over a
+// double buffer): a reader pins the current slot, re-checks that it is still
+// current, and unpins when done. A writer copies the current snapshot into
+// the other slot once the readers pinned to it before the last swap have
+// left, edits it and publishes it with a single atomic store. Reads take a
+// handful of atomic operations and no locks; writers only ever wait for
+// in-flight hit tests, never the other way around.
+
+#ifndef WINDOW_DECORATION_CORE_CAPTION_SNAPSHOT_H_
+#define WINDOW_DECORATION_CORE_CAPTION_SNAPSHOT_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "window_decoration_core/caption_mask.h"
+#include "window_decoration_core/caption_regions.h"
+#include "window_decoration_core/hit_test.h"
+
+namespace window_decoration {
+
+// Everything hit testing reads about the caption area
+struct CaptionSnapshot {
+    CaptionLayout caption;
+    CaptionRegionIndex regions;
+    CaptionMask mask;
+
+    // Incremented on every publish; 0 for the initial empty snapshot
+    uint64_t generation;
+};
+
+class CaptionPublisher {
+ public:
+    // Pins a snapshot for reading until destroyed
+    class ReadGuard {
+     public:
+        ReadGuard(ReadGuard&& other) : readers_(other.readers_), snapshot_(other.snapshot_) {
+            other.readers_ = nullptr;
+        }
+        ~ReadGuard() {
+            if (readers_ != nullptr) {
+                readers_->fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        const CaptionSnapshot& operator*() const { return *snapshot_; }
+        const CaptionSnapshot* operator->() const { return snapshot_; }
+
+     private:
+        friend class CaptionPublisher;
+        ReadGuard(std::atomic<uint32_t>* readers, const CaptionSnapshot* snapshot)
+            : readers_(readers), snapshot_(snapshot) {}
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        std::atomic<uint32_t>* readers_;
+        const CaptionSnapshot* snapshot_;
+    };
+
+    CaptionPublisher() : current_(0) {
+        for (Slot& slot : slots_) {
+            slot.readers.store(0, std::memory_order_relaxed);
+            slot.snapshot.caption = {};
+            slot.snapshot.generation = 0;
+        }
+    }
+
+    CaptionPublisher(const CaptionPublisher&) = delete;
+    CaptionPublisher& operator=(const CaptionPublisher&) = delete;
+
+    // Pin the current snapshot. Lock-free; only retries if a publish lands
+    // between loading the slot index and pinning the slot.
+    ReadGuard Read() const {
+        for (;;) {
+            uint32_t index = current_.load();
+            Slot& slot = slots_[index];
+            slot.readers.fetch_add(1);
+            if (current_.load() == index) {
+                return ReadGuard(&slot.readers, &slot.snapshot);
+            }
+            slot.readers.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    // Copy the current snapshot, apply edit(CaptionSnapshot&) to the copy
+    // and publish it if edit returns true. Returns what edit returned.
+    // Writers are serialized among themselves; readers are never blocked.
+    template <typename EditFn>
+    bool Update(EditFn&& edit) {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+
+        uint32_t index = current_.load(std::memory_order_relaxed);
+        uint32_t next = index ^ 1;
+        Slot& target = slots_[next];
+
+        // Wait for readers still pinned to the previous snapshot. They only
+        // hold it for the duration of one hit test. Sequentially consistent
+        // like the reader's pin/re-check, so either the reader sees the
+        // swap or this sees the pin.
+        while (target.readers.load() != 0) {
+            std::this_thread::yield();
+        }
+
+        // Copy assignment reuses the slot's buffers, so steady-state edits
+        // don't allocate
+        target.snapshot = slots_[index].snapshot;
+        if (!edit(target.snapshot)) {
+            return false;
+        }
+        target.snapshot.generation = slots_[index].snapshot.generation + 1;
+
+        current_.store(next);
+        return true;
+    }
+
+    // Generation of the current snapshot
+    uint64_t generation() const { return Read()->generation; }
+
+ private:
+    struct Slot {
+        std::atomic<uint32_t> readers;
+        CaptionSnapshot snapshot;
+    };
+
+    mutable Slot slots_[2];
+    std::atomic<uint32_t> current_;
+    std::mutex writerMutex_;
+};
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_CAPTION_SNAPSHOT_H_
@@ -0,0 +1,129 @@
+// Window Decoration Core - Cursor cache
+// Resize cursors are loaded once per process instead of on every mouse
+// move. Loading is the expensive part on every platform (LoadCursor goes
+// through the kernel, gdk_cursor_new_from_name walks the cursor theme), and
+// a frame only ever needs a handful of shapes. The cache is keyed by shape,
+// display and scale so themed or scaled cursors (GTK) stay correct on
+// mixed-DPI setups; backends whose cursors are scale-independent (Win32
+// system cursors) pass 0 for both.
+
+#ifndef WINDOW_DECORATION_CORE_CURSOR_CACHE_H_
+#define WINDOW_DECORATION_CORE_CURSOR_CACHE_H_
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "window_decoration_core/hit_test.h"
+
+namespace window_decoration {
+
+// Cursor shapes shown by the frame
+enum class CursorShape : uint8_t {
+    Arrow,
+    ResizeHorizontal,  // left / right edges
+    ResizeVertical,    // top / bottom edges
+    ResizeNwse,        // top-left / bottom-right corners
+    ResizeNesw         // top-right / bottom-left corners
+};
+
+// Cursor shape for a resize hit. Returns false for hits that keep the
+// application's own cursor (client area, caption, buttons).
+inline bool CursorShapeForHit(HitCode hit, CursorShape* shape) {
+    switch (hit) {
+        case HitCode::Left:
+        case HitCode::Right:
+            *shape = CursorShape::ResizeHorizontal;
+            return true;
+        case HitCode::Top:
+        case HitCode::Bottom:
+            *shape = CursorShape::ResizeVertical;
+            return true;
+        case HitCode::TopLeft:
+        case HitCode::BottomRight:
+            *shape = CursorShape::ResizeNwse;
+            return true;
+        case HitCode::TopRight:
+        case HitCode::BottomLeft:
+            *shape = CursorShape::ResizeNesw;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Cursor cache counters
+struct CursorCacheStats {
+    // Lookups answered from the cache
+    uint64_t hits;
+
+    // Cursors actually loaded from the platform
+    uint64_t loads;
+};
+
+// Per-process cache of platform cursor handles (HCURSOR, GdkCursor*, ...).
+// Shared by all UI threads; lookups take a short uncontended lock.
+template <typename Handle>
+class CursorCache {
+ public:
+    CursorCache() : stats_() {}
+
+    CursorCache(const CursorCache&) = delete;
+    CursorCache& operator=(const CursorCache&) = delete;
+
+    // Cursor for `shape` on `display` at `scale`. load(shape) creates it on
+    // the first request for the key; later requests return the same handle.
+    // A null handle from load is not cached.
+    template <typename LoadFn>
+    Handle Get(CursorShape shape, uintptr_t display, uint32_t scale, LoadFn&& load) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const Entry& entry : entries_) {
+            if (entry.shape == shape && entry.display == display && entry.scale == scale) {
+                stats_.hits++;
+                return entry.handle;
+            }
+        }
+
+        Handle handle = load(shape);
+        stats_.loads++;
+        if (handle != Handle()) {
+            entries_.push_back({ display, scale, shape, handle });
+        }
+        return handle;
+    }
+
+    // Drop every cached cursor, passing each to release(handle) (e.g. when
+    // the cursor theme or a display goes away)
+    template <typename ReleaseFn>
+    void Clear(ReleaseFn&& release) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const Entry& entry : entries_) {
+            release(entry.handle);
+        }
+        entries_.clear();
+    }
+
+    CursorCacheStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+ private:
+    struct Entry {
+        uintptr_t display;
+        uint32_t scale;
+        CursorShape shape;
+        Handle handle;
+    };
+
+    mutable std::mutex mutex_;
+
+    // A few shapes times the displays/scales in use; a linear scan is
+    // cheaper than hashing at this size
+    std::vector<Entry> entries_;
+    CursorCacheStats stats_;
+};
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_CURSOR_CACHE_H_
@@ -0,0 +1,69 @@
+// Window Decoration Core - Dart native port posting
+// Posts window event batches and completion codes to a Dart ReceivePort
+// through the Dart_PostCObject function Dart hands over as
+// NativeApi.postCObject, so the backends need neither the Dart SDK headers
+// nor dart_api_dl initialization. Only the Dart_CObject members used here
+// are declared; the layout matches dart_native_api.h.
+
+#ifndef WINDOW_DECORATION_CORE_DART_PORT_H_
+#define WINDOW_DECORATION_CORE_DART_PORT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "window_decoration_core/window_event_stream.h"
+
+namespace window_decoration {
+
+// Dart_CObject_Type and Dart_TypedData_Type values (dart_native_api.h)
+constexpr int32_t DART_COBJECT_INT64 = 3;
+constexpr int32_t DART_COBJECT_TYPED_DATA = 7;
+constexpr int32_t DART_TYPED_DATA_UINT8 = 2;
+
+struct DartCObject {
+    int32_t type;
+    union {
+        int64_t asInt64;
+
+        struct {
+            int32_t type;
+            intptr_t length;
+            const uint8_t* values;
+        } asTypedData;
+
+        // Largest member of the real union, so the size matches
+        struct {
+            int32_t type;
+            intptr_t length;
+            uint8_t* data;
+            void* peer;
+            void* callback;
+        } asExternalTypedData;
+    } value;
+};
+
+// Dart_PostCObject: thread safe, copies the message
+typedef bool (*DartPostCObjectFn)(int64_t port, DartCObject* message);
+
+// Post events to port as one Uint8List of WindowEvent records. Returns
+// false if the port is closed.
+inline bool PostWindowEvents(DartPostCObjectFn post, int64_t port, const WindowEvent* events, size_t count) {
+    DartCObject message;
+    message.type = DART_COBJECT_TYPED_DATA;
+    message.value.asTypedData.type = DART_TYPED_DATA_UINT8;
+    message.value.asTypedData.length = static_cast<intptr_t>(count * sizeof(WindowEvent));
+    message.value.asTypedData.values = reinterpret_cast<const uint8_t*>(events);
+    return post(port, &message);
+}
+
+// Post a single int to port. Returns false if the port is closed.
+inline bool PostInt64(DartPostCObjectFn post, int64_t port, int64_t value) {
+    DartCObject message;
+    message.type = DART_COBJECT_INT64;
+    message.value.asInt64 = value;
+    return post(port, &message);
+}
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_DART_PORT_H_
@@ -0,0 +1,99 @@
+// Window Decoration Core - Decoration config encoding
+// A whole WindowDecorationConfig in one compact, versioned binary blob, so
+// a backend can apply it in a single native call (one FFI crossing, one
+// frame change) instead of one call per property.
+//
+// Layout (little-endian):
+//
+//   offset  size  field
+//   0       1     version (major)
+//   1       1     fixed size: bytes before the effect list (16 in v1)
+//   2       2     flags (DECORATION_CONFIG_*)
+//   4       4     background color, ARGB (if DECORATION_CONFIG_HAS_BACKGROUND)
+//   8       4     opacity, IEEE float (if DECORATION_CONFIG_HAS_OPACITY)
+//   12      2     caption height, logical pixels
+//   14      1     title bar style (TitleBarStyle)
+//   15      1     effect count
+//   16      n     effects, one byte each (WindowEffect)
+//
+// Newer minor revisions may grow the fixed part; decoders read the fields
+// they know and find the effect list at the recorded fixed size. The Dart
+// encoder is WindowDecorationConfig.encode().
+
+#ifndef WINDOW_DECORATION_CORE_DECORATION_CONFIG_H_
+#define WINDOW_DECORATION_CORE_DECORATION_CONFIG_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace window_decoration {
+
+constexpr uint8_t DECORATION_CONFIG_VERSION = 1;
+constexpr uint8_t DECORATION_CONFIG_FIXED_BYTES = 16;
+
+// Effects carried per config
+constexpr uint32_t MAX_DECORATION_EFFECTS = 16;
+
+// Largest blob this version encodes
+constexpr size_t MAX_DECORATION_CONFIG_BYTES = DECORATION_CONFIG_FIXED_BYTES + MAX_DECORATION_EFFECTS;
+
+// Config flags
+constexpr uint16_t DECORATION_CONFIG_CENTERED = 1 << 0;
+constexpr uint16_t DECORATION_CONFIG_ALWAYS_ON_TOP = 1 << 1;
+constexpr uint16_t DECORATION_CONFIG_SKIP_TASKBAR = 1 << 2;
+constexpr uint16_t DECORATION_CONFIG_FRAMELESS = 1 << 3;
+constexpr uint16_t DECORATION_CONFIG_VISIBLE = 1 << 4;
+constexpr uint16_t DECORATION_CONFIG_HAS_BACKGROUND = 1 << 5;
+constexpr uint16_t DECORATION_CONFIG_HAS_OPACITY = 1 << 6;
+
+// Same order as the Dart TitleBarStyle enum
+enum class TitleBarStyle : uint8_t {
+    Normal,
+    Hidden,
+    Transparent,
+    Unified,
+    CustomFrame
+};
+
+// Same order as the Dart WindowEffect enum. Backends ignore effects they
+// don't support, including ids added by newer versions.
+enum class WindowEffect : uint8_t {
+    Vibrancy,
+    Transparency,
+    Blur,
+    Shadow,
+    Acrylic,
+    Mica
+};
+
+struct DecorationConfig {
+    uint16_t flags;
+    uint32_t backgroundColor;  // ARGB
+    float opacity;             // 0.0 - 1.0
+    uint16_t captionHeight;
+    TitleBarStyle titleBarStyle;
+    uint8_t effectCount;
+    WindowEffect effects[MAX_DECORATION_EFFECTS];
+
+    bool has(uint16_t flag) const { return (flags & flag) != 0; }
+
+    // Whether the native frame (title bar and borders) is drawn
+    bool decorated() const {
+        return !has(DECORATION_CONFIG_FRAMELESS) &&
+               titleBarStyle != TitleBarStyle::Hidden &&
+               titleBarStyle != TitleBarStyle::CustomFrame;
+    }
+};
+
+// Decode `length` bytes at `blob`. Returns false for a blob of another
+// major version, a truncated blob or out-of-range values; `config` is only
+// written on success. Opacity is clamped to 0.0 - 1.0.
+bool DecodeDecorationConfig(const uint8_t* blob, size_t length, DecorationConfig* config);
+
+// Encode `config` into `blob`. Returns the encoded size, or 0 if it needs
+// more than `capacity` bytes or has too many effects.
+size_t EncodeDecorationConfig(const DecorationConfig& config, uint8_t* blob, size_t capacity);
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_DECORATION_CONFIG_H_
@@ -0,0 +1,140 @@
+// Window Decoration Core - Frame geometry cache
+// Per-window cache of the OS state the hit tester needs (DPI, frame and
+// padding thickness, window rect, client origin, maximized state).
+// The backend refreshes it only when one of the invalidating window events
+// arrives, so WM_NCHITTEST and mouse moves make no OS calls at all.
+
+#ifndef WINDOW_DECORATION_CORE_FRAME_GEOMETRY_CACHE_H_
+#define WINDOW_DECORATION_CORE_FRAME_GEOMETRY_CACHE_H_
+
+#include <cstdint>
+
+#include "window_decoration_core/hit_test.h"
+
+namespace window_decoration {
+
+// Metrics that depend on DPI and system settings
+struct FrameMetrics {
+    unsigned int dpi;
+    int frameX;
+    int frameY;
+    int padding;
+};
+
+// Window placement (changes on move, size, maximize and frame changes)
+struct FramePlacement {
+    // Window rect in screen coordinates
+    Rect windowRect;
+
+    // Client area origin relative to the window origin
+    int clientLeft;
+    int clientTop;
+
+    bool isMaximized;
+};
+
+// Window events that invalidate (part of) the cache
+enum class FrameCacheEvent : uint8_t {
+    DpiChanged,         // WM_DPICHANGED: everything
+    SettingChange,      // WM_SETTINGCHANGE: frame metrics
+    WindowPosChanging,  // WM_WINDOWPOSCHANGING: placement (WM_NCCALCSIZE follows)
+    WindowPosChanged,   // WM_WINDOWPOSCHANGED: placement
+    Size                // WM_SIZE: placement
+};
+
+// Cache counters. `lookups - metricsRefreshes - placementRefreshes` lookups
+// were served without touching the OS.
+struct FrameCacheStats {
+    uint64_t lookups;
+    uint64_t metricsRefreshes;
+    uint64_t placementRefreshes;
+};
+
+class FrameGeometryCache {
+ public:
+    FrameGeometryCache()
+        : metrics_(), placement_(), geometry_(), stats_(),
+          generation_(0), metricsValid_(false), placementValid_(false) {}
+
+    // Mark the parts of the cache affected by `event` as stale
+    void Invalidate(FrameCacheEvent event) {
+        switch (event) {
+            case FrameCacheEvent::DpiChanged:
+                metricsValid_ = false;
+                placementValid_ = false;
+                break;
+            case FrameCacheEvent::SettingChange:
+                metricsValid_ = false;
+                break;
+            case FrameCacheEvent::WindowPosChanging:
+            case FrameCacheEvent::WindowPosChanged:
+            case FrameCacheEvent::Size:
+                placementValid_ = false;
+                break;
+        }
+    }
+
+    // Mark the whole cache as stale (e.g. when the frame mode changes)
+    void InvalidateAll() {
+        metricsValid_ = false;
+        placementValid_ = false;
+    }
+
+    // Return the cached geometry, calling the backend queries only for the
+    // stale parts. queryMetrics() returns FrameMetrics and queryPlacement()
+    // returns FramePlacement.
+    template <typename MetricsQuery, typename PlacementQuery>
+    const FrameGeometry& Get(MetricsQuery&& queryMetrics, PlacementQuery&& queryPlacement) {
+        stats_.lookups++;
+
+        if (!metricsValid_ || !placementValid_) {
+            if (!metricsValid_) {
+                metrics_ = queryMetrics();
+                metricsValid_ = true;
+                stats_.metricsRefreshes++;
+            }
+            if (!placementValid_) {
+                placement_ = queryPlacement();
+                placementValid_ = true;
+                stats_.placementRefreshes++;
+            }
+            Compose();
+        }
+
+        return geometry_;
+    }
+
+    // Cached parts; only meaningful after Get()
+    const FrameMetrics& metrics() const { return metrics_; }
+    const FramePlacement& placement() const { return placement_; }
+
+    const FrameCacheStats& stats() const { return stats_; }
+
+    // Incremented every time the cached geometry changes
+    uint64_t generation() const { return generation_; }
+
+ private:
+    void Compose() {
+        geometry_.windowWidth = placement_.windowRect.right - placement_.windowRect.left;
+        geometry_.windowHeight = placement_.windowRect.bottom - placement_.windowRect.top;
+        geometry_.borderWidth = metrics_.frameX + metrics_.padding;
+        geometry_.borderHeight = metrics_.frameY + metrics_.padding;
+        geometry_.clientLeft = placement_.clientLeft;
+        geometry_.clientTop = placement_.clientTop;
+        geometry_.dpi = metrics_.dpi;
+        geometry_.isMaximized = placement_.isMaximized;
+        generation_++;
+    }
+
+    FrameMetrics metrics_;
+    FramePlacement placement_;
+    FrameGeometry geometry_;
+    FrameCacheStats stats_;
+    uint64_t generation_;
+    bool metricsValid_;
+    bool placementValid_;
+};
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_FRAME_GEOMETRY_CACHE_H_
@@ -0,0 +1,124 @@
+// Window Decoration Core - Hit testing
+// Portable frame hit testing shared by the native backends.
+// Works on plain geometry and returns a neutral HitCode, which each backend
+// maps onto its own constants (HT* values on Windows).
+
+#ifndef WINDOW_DECORATION_CORE_HIT_TEST_H_
+#define WINDOW_DECORATION_CORE_HIT_TEST_H_
+
+#include <cstdint>
+
+namespace window_decoration {
+
+class CaptionMask;
+class CaptionRegionIndex;
+
+// Resize border width in pixels (minimum for hidden frame mode)
+constexpr int RESIZE_BORDER_WIDTH = 8;
+
+// Default caption height if not specified
+constexpr int DEFAULT_CAPTION_HEIGHT = 32;
+
+// Frame mode determines how the window frame is handled
+enum class FrameMode {
+    Normal,      // Standard frame with title bar
+    Hidden,      // Legacy hidden mode (borderless popup)
+    CustomFrame  // Windows 11 style: no title bar but keeps decorations
+};
+
+// Neutral hit test result
+enum class HitCode : uint8_t {
+    Nowhere = 0,
+    Client,
+    Caption,
+    MinButton,
+    MaxButton,
+    Close,
+    Left,
+    Right,
+    Top,
+    Bottom,
+    TopLeft,
+    TopRight,
+    BottomLeft,
+    BottomRight
+};
+
+// Rectangle with exclusive right/bottom edges
+struct Rect {
+    int left;
+    int top;
+    int right;
+    int bottom;
+};
+
+// Frame geometry in physical pixels, as seen by the hit tester
+struct FrameGeometry {
+    int windowWidth;
+    int windowHeight;
+
+    // Resize frame thickness (frame + padded border)
+    int borderWidth;
+    int borderHeight;
+
+    // Client area origin relative to the window origin
+    int clientLeft;
+    int clientTop;
+
+    unsigned int dpi;
+    bool isMaximized;
+};
+
+// Caption area description for custom frame mode
+struct CaptionLayout {
+    // Caption height in logical pixels (scaled for DPI during hit testing)
+    int captionHeight;
+
+    // Caption button zones (in client coordinates)
+    Rect minimizeButton;
+    Rect maximizeButton;
+    Rect closeButton;
+
+    // Whether caption buttons are defined
+    bool hasCaptionButtons;
+};
+
+// Check if point is inside a rectangle
+inline bool PointInRect(int x, int y, const Rect& rect) {
+    return x >= rect.left && x < rect.right && y >= rect.top && y < rect.bottom;
+}
+
+// Scale a logical pixel value for DPI, rounding like MulDiv(value, dpi, 96)
+inline int ScaleForDpi(int value, unsigned int dpi) {
+    int64_t product = static_cast<int64_t>(value) * dpi;
+    return static_cast<int>(product >= 0 ? (product + 48) / 96 : (product - 48) / 96);
+}
+
+// Check if a hit code is one of the resize border codes
+inline bool IsResizeHit(HitCode hit) {
+    return hit >= HitCode::Left;
+}
+
+// Hit test for custom frame mode (Windows 11 File Explorer style).
+// (x, y) is relative to the window origin. Named caption regions, if any,
+// are consulted after the caption buttons, then the caption mask.
+HitCode HitTestCustomFrame(int x, int y, const FrameGeometry& geometry,
+                           const CaptionLayout& caption,
+                           const CaptionRegionIndex* regions = nullptr,
+                           const CaptionMask* mask = nullptr);
+
+// Hit test for legacy hidden mode (borderless).
+// (x, y) is relative to the window origin.
+HitCode HitTestHiddenFrame(int x, int y, const FrameGeometry& geometry);
+
+// Resolve only the resize border part of a hit test (Nowhere when the point
+// is not on a resize border) together with the cell around (x, y) in which
+// that result cannot change, so callers can skip re-testing while the pointer
+// stays inside it. The cell is empty when it can't be determined cheaply
+// (tiny windows, points outside the window).
+HitCode ResolveResizeCell(int x, int y, const FrameGeometry& geometry,
+                          FrameMode mode, Rect* cell);
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_HIT_TEST_H_
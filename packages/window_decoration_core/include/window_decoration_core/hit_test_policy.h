@@ -0,0 +1,222 @@
+// Window Decoration Core - Hit test policies
+// The frame modes differ only in a few rules (border model, how far corners
+// extend along the edges, whether there is a caption, what happens when
+// maximized). Each rule is a compile-time constant of a policy type, and the
+// corner/edge/caption logic is written once as a template over the policy.
+// Every mode gets its own branch-minimal instantiation; backends pick one
+// through SelectHitTest() when the mode changes instead of branching on
+// FrameMode for every message.
+
+#ifndef WINDOW_DECORATION_CORE_HIT_TEST_POLICY_H_
+#define WINDOW_DECORATION_CORE_HIT_TEST_POLICY_H_
+
+#include "window_decoration_core/caption_mask.h"
+#include "window_decoration_core/caption_regions.h"
+#include "window_decoration_core/hit_test.h"
+
+namespace window_decoration {
+
+// Windows 11 style custom frame: system border metrics, square corners,
+// a thin top resize band over the caption, caption buttons and regions
+struct CustomFramePolicy {
+    static constexpr FrameMode kMode = FrameMode::CustomFrame;
+    static constexpr bool kHasBorders = true;
+    static constexpr bool kHasCaption = true;
+
+    // Corner zones extend this many border widths along each edge
+    static constexpr int kCornerScale = 1;
+
+    // Top resize band is half the border so the caption stays draggable
+    static constexpr bool kThinTopEdge = true;
+
+    static int BorderWidth(const FrameGeometry& geometry) { return geometry.borderWidth; }
+    static int BorderHeight(const FrameGeometry& geometry) { return geometry.borderHeight; }
+};
+
+// Legacy hidden (borderless) frame: at least RESIZE_BORDER_WIDTH on all
+// sides, corners extended to twice the border, no caption
+struct HiddenFramePolicy {
+    static constexpr FrameMode kMode = FrameMode::Hidden;
+    static constexpr bool kHasBorders = true;
+    static constexpr bool kHasCaption = false;
+    static constexpr int kCornerScale = 2;
+    static constexpr bool kThinTopEdge = false;
+
+    static int BorderWidth(const FrameGeometry& geometry) {
+        return geometry.borderWidth < RESIZE_BORDER_WIDTH ? RESIZE_BORDER_WIDTH : geometry.borderWidth;
+    }
+    static int BorderHeight(const FrameGeometry& geometry) { return BorderWidth(geometry); }
+};
+
+// Standard frame: the OS does all hit testing
+struct NormalFramePolicy {
+    static constexpr FrameMode kMode = FrameMode::Normal;
+    static constexpr bool kHasBorders = false;
+    static constexpr bool kHasCaption = false;
+    static constexpr int kCornerScale = 1;
+    static constexpr bool kThinTopEdge = false;
+
+    static int BorderWidth(const FrameGeometry&) { return 0; }
+    static int BorderHeight(const FrameGeometry&) { return 0; }
+};
+
+// Resize border part of the hit test; Nowhere when not on a border
+template <typename Policy>
+inline HitCode HitTestBorder(int x, int y, const FrameGeometry& geometry) {
+    // No resize borders when maximized
+    if (!Policy::kHasBorders || geometry.isMaximized) {
+        return HitCode::Nowhere;
+    }
+
+    int bw = Policy::BorderWidth(geometry);
+    int bh = Policy::BorderHeight(geometry);
+    int cornerWidth = bw * Policy::kCornerScale;
+    int cornerHeight = bh * Policy::kCornerScale;
+    int width = geometry.windowWidth;
+    int height = geometry.windowHeight;
+
+    bool isLeft = x < bw;
+    bool isRight = x >= width - bw;
+    bool isTop = y < bh;
+    bool isBottom = y >= height - bh;
+
+    // Corners have priority; with kCornerScale == 1 the "near" tests are
+    // the edge tests themselves and fold away
+    bool isNearLeft = x < cornerWidth;
+    bool isNearRight = x >= width - cornerWidth;
+    bool isNearTop = y < cornerHeight;
+    bool isNearBottom = y >= height - cornerHeight;
+
+    if ((isTop && isNearLeft) || (isLeft && isNearTop)) return HitCode::TopLeft;
+    if ((isTop && isNearRight) || (isRight && isNearTop)) return HitCode::TopRight;
+    if ((isBottom && isNearLeft) || (isLeft && isNearBottom)) return HitCode::BottomLeft;
+    if ((isBottom && isNearRight) || (isRight && isNearBottom)) return HitCode::BottomRight;
+
+    if (isLeft) return HitCode::Left;
+    if (isRight) return HitCode::Right;
+
+    // A thin top band overlaps the caption and yields to the bottom edge
+    if (Policy::kThinTopEdge) {
+        if (isBottom) return HitCode::Bottom;
+        if (y < bh / 2) return HitCode::Top;
+    } else {
+        if (isTop) return HitCode::Top;
+        if (isBottom) return HitCode::Bottom;
+    }
+
+    return HitCode::Nowhere;
+}
+
+// Full hit test for one mode. (x, y) is relative to the window origin.
+template <typename Policy>
+inline HitCode HitTestFrame(int x, int y, const FrameGeometry& geometry,
+                            const CaptionLayout& caption,
+                            const CaptionRegionIndex* regions,
+                            const CaptionMask* mask) {
+    HitCode border = HitTestBorder<Policy>(x, y, geometry);
+    if (border != HitCode::Nowhere) {
+        return border;
+    }
+
+    if (!Policy::kHasCaption) {
+        return HitCode::Client;
+    }
+
+    // Convert to client coordinates for caption area detection
+    int clientX = x - geometry.clientLeft;
+    int clientY = y - geometry.clientTop;
+
+    // Caption buttons first; maximize is reported separately for Windows 11
+    // snap layout support
+    if (caption.hasCaptionButtons) {
+        if (PointInRect(clientX, clientY, caption.closeButton)) return HitCode::Close;
+        if (PointInRect(clientX, clientY, caption.maximizeButton)) return HitCode::MaxButton;
+        if (PointInRect(clientX, clientY, caption.minimizeButton)) return HitCode::MinButton;
+    }
+
+    // Named regions (tabs, search boxes, ...) keep the caption from dragging,
+    // then the uploaded interactive/draggable mask decides inside its bounds
+    HitCode hit;
+    if (regions != nullptr && regions->Lookup(clientX, clientY, &hit)) {
+        return hit;
+    }
+    if (mask != nullptr && mask->Lookup(clientX, clientY, geometry.dpi, &hit)) {
+        return hit;
+    }
+
+    // Caption area (custom title bar region), scaled for DPI
+    int captionHeight = caption.captionHeight > 0 ? caption.captionHeight : DEFAULT_CAPTION_HEIGHT;
+    if (clientY < ScaleForDpi(captionHeight, geometry.dpi)) {
+        return HitCode::Caption;
+    }
+
+    return HitCode::Client;
+}
+
+// Find the band [edges[i], edges[i + 1]) containing value
+inline bool FindResizeBand(int value, const int* edges, int count, int* start, int* end) {
+    for (int i = 0; i + 1 < count; i++) {
+        if (value >= edges[i] && value < edges[i + 1]) {
+            *start = edges[i];
+            *end = edges[i + 1];
+            return true;
+        }
+    }
+    return false;
+}
+
+// ResolveResizeCell() for one mode
+template <typename Policy>
+inline HitCode ResolveResizeCellFor(int x, int y, const FrameGeometry& geometry, Rect* cell) {
+    int width = geometry.windowWidth;
+    int height = geometry.windowHeight;
+    *cell = { 0, 0, 0, 0 };
+
+    if (x < 0 || y < 0 || x >= width || y >= height) {
+        return HitCode::Nowhere;
+    }
+
+    // No resize borders at all: the whole window is one cell
+    if (!Policy::kHasBorders || geometry.isMaximized) {
+        *cell = { 0, 0, width, height };
+        return HitCode::Nowhere;
+    }
+
+    HitCode hit = HitTestBorder<Policy>(x, y, geometry);
+
+    int bw = Policy::BorderWidth(geometry);
+    int bh = Policy::BorderHeight(geometry);
+    int cornerWidth = bw * Policy::kCornerScale;
+    int cornerHeight = bh * Policy::kCornerScale;
+    if (width < 2 * cornerWidth || height < 2 * cornerHeight) {
+        return hit;
+    }
+
+    // Band edges at which the corner/edge rules change. Coinciding edges
+    // (kCornerScale == 1) just make empty bands.
+    int topEdge = Policy::kThinTopEdge ? bh / 2 : bh;
+    int xEdges[] = { 0, bw, cornerWidth, width - cornerWidth, width - bw, width };
+    int yEdges[] = { 0, topEdge, bh, cornerHeight, height - cornerHeight, height - bh, height };
+
+    Rect band;
+    if (FindResizeBand(x, xEdges, 6, &band.left, &band.right) &&
+        FindResizeBand(y, yEdges, 7, &band.top, &band.bottom)) {
+        *cell = band;
+    }
+
+    return hit;
+}
+
+// Specialized entry points, selected once per frame mode change
+typedef HitCode (*HitTestFn)(int x, int y, const FrameGeometry& geometry,
+                             const CaptionLayout& caption,
+                             const CaptionRegionIndex* regions,
+                             const CaptionMask* mask);
+typedef HitCode (*ResizeCellFn)(int x, int y, const FrameGeometry& geometry, Rect* cell);
+
+HitTestFn SelectHitTest(FrameMode mode);
+ResizeCellFn SelectResizeCell(FrameMode mode);
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_HIT_TEST_POLICY_H_
@@ -0,0 +1,84 @@
+// Window Decoration Core - Hover memo
+// Remembers the last resolved resize hit and the cell it is valid for, so
+// mouse moves that stay inside the cell (and geometry that hasn't changed)
+// skip the hit test entirely. Also tracks hit transitions so the backend
+// only changes the cursor when the result actually changes.
+
+#ifndef WINDOW_DECORATION_CORE_HOVER_MEMO_H_
+#define WINDOW_DECORATION_CORE_HOVER_MEMO_H_
+
+#include <cstdint>
+
+#include "window_decoration_core/hit_test.h"
+
+namespace window_decoration {
+
+// Hover counters
+struct HoverStats {
+    // Mouse moves answered from the memo
+    uint64_t memoHits;
+
+    // Mouse moves that ran the full hit test
+    uint64_t evaluations;
+
+    // Cursor changes actually issued by the backend
+    uint64_t cursorChanges;
+};
+
+class HoverMemo {
+ public:
+    HoverMemo() : cell_(), generation_(0), cellHit_(HitCode::Nowhere),
+                  lastHit_(HitCode::Nowhere), stats_() {}
+
+    // Resolve the resize hit at (x, y) in window coordinates, reusing the
+    // memoized result while the point stays in the last cell and the
+    // geometry generation is unchanged. resolve(x, y, &cell) runs the full
+    // hit test and returns the hit (see ResolveResizeCell).
+    template <typename ResolveFn>
+    HitCode Resolve(int x, int y, uint64_t generation, ResolveFn&& resolve) {
+        if (generation == generation_ && PointInRect(x, y, cell_)) {
+            stats_.memoHits++;
+            return cellHit_;
+        }
+
+        stats_.evaluations++;
+        cellHit_ = resolve(x, y, &cell_);
+        generation_ = generation;
+        return cellHit_;
+    }
+
+    // Record the hit the cursor is now over.
+    // Returns true when it differs from the previous one (a transition).
+    bool Transition(HitCode hit) {
+        if (hit == lastHit_) {
+            return false;
+        }
+        lastHit_ = hit;
+        return true;
+    }
+
+    // Last hit passed to Transition()
+    HitCode lastHit() const { return lastHit_; }
+
+    // Count a cursor change issued by the backend
+    void RecordCursorChange() { stats_.cursorChanges++; }
+
+    // Forget the memoized cell (e.g. when the frame mode changes)
+    void Reset() {
+        cell_ = { 0, 0, 0, 0 };
+        lastHit_ = HitCode::Nowhere;
+    }
+
+    const HoverStats& stats() const { return stats_; }
+
+ private:
+    Rect cell_;
+    uint64_t generation_;
+    HitCode cellHit_;
+    HitCode lastHit_;
+    HoverStats stats_;
+};
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_HOVER_MEMO_H_
@@ -0,0 +1,58 @@
+// Window Decoration Core - Initial decoration
+// What an app's runner applies to its window before the window is first
+// shown: frame mode, caption height, background color, bounds and
+// always-on-top. Applied before the window is mapped, the first frame
+// already has the app's frame, size and position; the Dart side, which
+// only runs after the first frame, then has nothing to reframe, move or
+// restyle, so the window doesn't flash its default frame.
+//
+// Backends export ApplyInitialDecoration(handle, const InitialDecoration*)
+// and declare it for runners in the plugin's include/ directory. They keep
+// the applied decoration with the window so the Dart side can tell the
+// runner already did its work.
+
+#ifndef WINDOW_DECORATION_CORE_INITIAL_DECORATION_H_
+#define WINDOW_DECORATION_CORE_INITIAL_DECORATION_H_
+
+#include <cstdint>
+#include <type_traits>
+
+#include "window_decoration_core/hit_test.h"
+
+namespace window_decoration {
+
+// InitialDecoration.flags
+constexpr uint32_t INITIAL_DECORATION_HAS_BOUNDS = 1 << 0;
+constexpr uint32_t INITIAL_DECORATION_CENTERED = 1 << 1;  // centered in its monitor's work area
+constexpr uint32_t INITIAL_DECORATION_HAS_BACKGROUND = 1 << 2;
+constexpr uint32_t INITIAL_DECORATION_ALWAYS_ON_TOP = 1 << 3;
+
+struct InitialDecoration {
+    uint32_t flags;            // INITIAL_DECORATION_*
+    int32_t frameMode;         // FrameMode
+    uint32_t captionHeight;    // logical pixels, CustomFrame only
+    uint32_t backgroundColor;  // ARGB, with INITIAL_DECORATION_HAS_BACKGROUND
+    Rect bounds;               // window rect in the backend's screen coordinates, with
+                               // INITIAL_DECORATION_HAS_BOUNDS; only its size is used when
+                               // also centered
+};
+
+static_assert(std::is_trivially_copyable<InitialDecoration>::value, "passed by pointer from C++ runners and Dart");
+static_assert(sizeof(InitialDecoration) == 32, "layout is mirrored by the Dart bindings");
+
+// Whether a backend can apply `decoration`: a known frame mode, and
+// non-empty bounds if it has any
+inline bool IsValidInitialDecoration(const InitialDecoration& decoration) {
+    if (decoration.frameMode < static_cast<int32_t>(FrameMode::Normal) ||
+        decoration.frameMode > static_cast<int32_t>(FrameMode::CustomFrame)) {
+        return false;
+    }
+    if (decoration.flags & INITIAL_DECORATION_HAS_BOUNDS) {
+        return decoration.bounds.right > decoration.bounds.left && decoration.bounds.bottom > decoration.bounds.top;
+    }
+    return true;
+}
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_INITIAL_DECORATION_H_
@@ -0,0 +1,65 @@
+// Window Decoration Core - Message filter
+// Decides which native messages the resize border logic has to look at.
+// A thread-wide message hook sees everything the UI thread dispatches
+// (timers, paints, input for unrelated windows), so the first thing it does
+// is classify the message id with one table load and bail out for anything
+// irrelevant, before any window lookup. Per-window interception (a subclass
+// on the managed window and its view) uses the same table.
+//
+// Message ids are the backend's own (WM_* on Windows); the table covers the
+// system range, and ids beyond it (application/registered messages) are
+// never relevant.
+
+#ifndef WINDOW_DECORATION_CORE_MESSAGE_FILTER_H_
+#define WINDOW_DECORATION_CORE_MESSAGE_FILTER_H_
+
+#include <cstdint>
+
+namespace window_decoration {
+
+// What the border logic does with a message
+enum class MessageAction : uint8_t {
+    Ignore,            // not relevant: pass it on untouched
+    HoverMove,         // pointer moved: update the resize cursor
+    ButtonDown,        // primary button pressed: start a resize on a border
+                       // (or a move on the caption, where the backend drags it)
+    ButtonDoubleClick, // primary button double-clicked: toggle maximize on
+                       // the caption (backends without a native caption)
+    ButtonUp           // button released: drop a caption press that never
+                       // became a drag (backends without a native caption)
+};
+
+// How a backend intercepts the messages of a managed window
+enum class InterceptionMode : uint8_t {
+    // One hook per UI thread sees every dispatched message
+    ThreadHook,
+
+    // Only the managed window and its content view are intercepted
+    Subclass
+};
+
+class MessageFilter {
+ public:
+    // Messages at or above this id are always ignored
+    static constexpr uint32_t kTableSize = 1024;
+
+    MessageFilter() : actions_() {}
+
+    // Route `message` to `action`. Ids outside the table can't be routed.
+    void Set(uint32_t message, MessageAction action) {
+        if (message < kTableSize) {
+            actions_[message] = action;
+        }
+    }
+
+    MessageAction Classify(uint32_t message) const {
+        return message < kTableSize ? actions_[message] : MessageAction::Ignore;
+    }
+
+ private:
+    MessageAction actions_[kTableSize];
+};
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_MESSAGE_FILTER_H_
@@ -0,0 +1,91 @@
+// Window Decoration Core - Monitor topology
+// Cached layout of the monitors (bounds, work area and DPI of each) with a
+// spatial index for point and rect lookups. The backends refill it from the
+// OS only when monitors are added, removed or change (hotplug, resolution,
+// taskbar/panel and scale changes), so maximizing, placement and state
+// queries make no monitor calls of their own.
+//
+// Coordinates are the backend's screen space (physical pixels on Windows,
+// GDK's logical pixels on Linux) and may be negative: monitors left of or
+// above the primary one have negative origins.
+
+#ifndef WINDOW_DECORATION_CORE_MONITOR_TOPOLOGY_H_
+#define WINDOW_DECORATION_CORE_MONITOR_TOPOLOGY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "window_decoration_core/hit_test.h"
+
+namespace window_decoration {
+
+// MonitorInfo.flags
+constexpr uint32_t MONITOR_PRIMARY = 1 << 0;
+
+struct MonitorInfo {
+    uint64_t id;     // backend handle (HMONITOR, GdkMonitor*)
+    Rect bounds;
+    Rect workArea;   // bounds minus taskbars and panels
+    uint32_t dpi;    // 96 = 100% scale
+    uint32_t flags;  // MONITOR_*
+};
+
+class MonitorTopology {
+ public:
+    // Index returned by the lookups when there is no such monitor
+    static constexpr int kNone = -1;
+
+    MonitorTopology() : generation_(0), primary_(kNone) {}
+
+    // Replace the monitor list with `monitors`, in the backend's order
+    // (which decides between overlapping, i.e. mirrored, monitors). The
+    // spatial index is only rebuilt when a monitor was added, removed or
+    // moved; work area, DPI and flag changes just update the entry.
+    // Returns true if anything changed, and then bumps generation().
+    bool Update(const MonitorInfo* monitors, size_t count);
+
+    size_t size() const { return monitors_.size(); }
+    const MonitorInfo& monitor(int index) const { return monitors_[static_cast<size_t>(index)]; }
+
+    // Changes with every Update() that changed something, so callers can
+    // tell whether a monitor they looked up earlier may be stale
+    uint64_t generation() const { return generation_; }
+
+    // The primary monitor (the first one if none is flagged), or kNone
+    // without monitors
+    int primary() const { return primary_; }
+
+    int FindById(uint64_t id) const;
+
+    // Monitor containing the point, or kNone
+    int FindAt(int x, int y) const;
+
+    // Monitor containing the point, else the nearest one
+    // (MONITOR_DEFAULTTONEAREST)
+    int FindNearest(int x, int y) const;
+
+    // Monitor with the largest intersection with the rect, else the one
+    // nearest to its center (MonitorFromRect with MONITOR_DEFAULTTONEAREST)
+    int FindForRect(const Rect& rect) const;
+
+ private:
+    void RebuildIndex();
+
+    std::vector<MonitorInfo> monitors_;
+
+    // The x axis is cut into slabs at every monitor's left and right edge.
+    // Slab i spans [slabEdges_[i], slabEdges_[i + 1]) and lists the monitors
+    // covering it in slabMonitors_[slabStart_[i] .. slabStart_[i + 1]), so a
+    // point lookup is a binary search plus a scan of a few monitors.
+    std::vector<int> slabEdges_;
+    std::vector<uint32_t> slabStart_;
+    std::vector<int> slabMonitors_;
+
+    uint64_t generation_;
+    int primary_;
+};
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_MONITOR_TOPOLOGY_H_
@@ -0,0 +1,118 @@
+// Window Decoration Core - Platform capabilities
+// What the OS and toolkit under a backend can do, probed once per process:
+// optional DPI APIs, OS version, compositor, display server and the
+// _NET_WM hints the window manager supports. Backends used to probe these
+// piecemeal (a `static bool loaded` per API, a version check per
+// WM_NCCALCSIZE) and Dart resolved dozens of toolkit symbols itself.
+//
+// A backend fills one PlatformCapabilities from a CapabilityProbe, the
+// first time anything asks, and exports it with GetPlatformCapabilities().
+// The struct carries the feature bits and a pointer to the backend's
+// function table: the optional APIs it resolved, or the toolkit calls Dart
+// makes, so Dart looks up one symbol instead of one per function.
+
+#ifndef WINDOW_DECORATION_CORE_PLATFORM_CAPABILITIES_H_
+#define WINDOW_DECORATION_CORE_PLATFORM_CAPABILITIES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+
+namespace window_decoration {
+
+// PlatformCapabilities.flags
+constexpr uint32_t CAPABILITY_WINDOW_DPI = 1 << 0;          // per-window DPI (GetDpiForWindow)
+constexpr uint32_t CAPABILITY_DPI_SYSTEM_METRICS = 1 << 1;  // metrics for any DPI (GetSystemMetricsForDpi)
+constexpr uint32_t CAPABILITY_MONITOR_DPI = 1 << 2;         // per-monitor DPI or scale
+constexpr uint32_t CAPABILITY_WINDOWS_11 = 1 << 3;          // build 22000 or later
+constexpr uint32_t CAPABILITY_COMPOSITOR = 1 << 4;          // a compositing manager is running
+constexpr uint32_t CAPABILITY_X11 = 1 << 5;
+constexpr uint32_t CAPABILITY_WAYLAND = 1 << 6;
+
+// PlatformCapabilities.netWmAtoms: _NET_WM hints the window manager lists
+// in _NET_SUPPORTED (X11 only), in NET_WM_ATOM_NAMES order
+constexpr uint32_t NET_WM_STATE = 1 << 0;
+constexpr uint32_t NET_WM_STATE_ABOVE = 1 << 1;
+constexpr uint32_t NET_WM_STATE_SKIP_TASKBAR = 1 << 2;
+constexpr uint32_t NET_WM_STATE_FULLSCREEN = 1 << 3;
+constexpr uint32_t NET_WM_STATE_MAXIMIZED_VERT = 1 << 4;
+constexpr uint32_t NET_WM_STATE_MAXIMIZED_HORZ = 1 << 5;
+constexpr uint32_t NET_WM_STATE_HIDDEN = 1 << 6;
+constexpr uint32_t NET_WM_MOVERESIZE = 1 << 7;
+constexpr uint32_t NET_WM_WINDOW_OPACITY = 1 << 8;
+constexpr uint32_t NET_WM_FRAME_EXTENTS = 1 << 9;
+constexpr uint32_t NET_WM_WORKAREA = 1 << 10;
+constexpr uint32_t NET_WM_ACTIVE_WINDOW = 1 << 11;
+
+constexpr const char* NET_WM_ATOM_NAMES[] = {
+    "_NET_WM_STATE",
+    "_NET_WM_STATE_ABOVE",
+    "_NET_WM_STATE_SKIP_TASKBAR",
+    "_NET_WM_STATE_FULLSCREEN",
+    "_NET_WM_STATE_MAXIMIZED_VERT",
+    "_NET_WM_STATE_MAXIMIZED_HORZ",
+    "_NET_WM_STATE_HIDDEN",
+    "_NET_WM_MOVERESIZE",
+    "_NET_WM_WINDOW_OPACITY",
+    "_NET_FRAME_EXTENTS",
+    "_NET_WORKAREA",
+    "_NET_ACTIVE_WINDOW",
+};
+
+constexpr size_t NET_WM_ATOM_COUNT = sizeof(NET_WM_ATOM_NAMES) / sizeof(NET_WM_ATOM_NAMES[0]);
+
+// Probed once per process; read-only afterwards
+struct PlatformCapabilities {
+    uint32_t flags;       // CAPABILITY_*
+    uint32_t netWmAtoms;  // NET_WM_*
+
+    // OS version: Windows major.minor.build, the Linux kernel release
+    uint32_t osMajor;
+    uint32_t osMinor;
+    uint32_t osBuild;
+
+    // Toolkit version (GTK major.minor.micro); zero where there is none
+    uint32_t toolkitMajor;
+    uint32_t toolkitMinor;
+    uint32_t toolkitMicro;
+
+    // The backend's function table and its size in bytes; entries are
+    // only ever appended, so readers check the size covers what they use
+    const void* functions;
+    uint64_t functionsSize;
+};
+
+static_assert(std::is_trivially_copyable<PlatformCapabilities>::value, "read by Dart through a pointer");
+
+// Parse the leading "major.minor.build" of a version string such as a
+// kernel release ("6.8.0-45-generic"); missing parts are 0. Returns false
+// if the string doesn't start with a number.
+bool ParseOsVersion(const char* release, uint32_t* major, uint32_t* minor, uint32_t* build);
+
+// Runs a backend's probe exactly once per process, however many threads
+// ask first, and hands out the result from then on.
+class CapabilityProbe {
+ public:
+    CapabilityProbe() : capabilities_() {}
+
+    CapabilityProbe(const CapabilityProbe&) = delete;
+    CapabilityProbe& operator=(const CapabilityProbe&) = delete;
+
+    // The capabilities probe(&capabilities) filled on the first call.
+    // Concurrent first callers wait for that one probe; later calls only
+    // check the once flag.
+    template <typename ProbeFn>
+    const PlatformCapabilities& Get(ProbeFn&& probe) {
+        std::call_once(once_, [&]() { probe(&capabilities_); });
+        return capabilities_;
+    }
+
+ private:
+    std::once_flag once_;
+    PlatformCapabilities capabilities_;
+};
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_PLATFORM_CAPABILITIES_H_
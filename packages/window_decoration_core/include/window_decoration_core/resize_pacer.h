@@ -0,0 +1,102 @@
+// Window Decoration Core - Resize pacer
+// Paces interactive resizes to the display refresh. The window manager
+// reports a new size on every pointer move of a resize drag, far more often
+// than Flutter can lay out; handing each one on queues relayouts that lag
+// further behind the pointer the slower the machine. The pacer keeps only
+// the newest requested size and gives it out at most once per frame tick,
+// counting the sizes that were superseded before any frame took them.
+//
+// Time is passed in by the caller (nanoseconds on any monotonic clock), so
+// the backends drive it from the frame clock and the benchmark from a
+// simulated one.
+
+#ifndef WINDOW_DECORATION_CORE_RESIZE_PACER_H_
+#define WINDOW_DECORATION_CORE_RESIZE_PACER_H_
+
+#include <cstdint>
+
+namespace window_decoration {
+
+// Resize pacing counters
+struct ResizePacingStats {
+    // Sizes passed to Request()
+    uint64_t requests;
+
+    // Sizes given out by Take(), at most one per frame
+    uint64_t applied;
+
+    // Sizes superseded by a newer one before a frame took them
+    uint64_t skipped;
+
+    // Time from the newest input to the frame that applied it, for the
+    // latest delivery, the worst one and the sum of all of them
+    // (mean = totalLatencyNs / applied)
+    uint64_t lastLatencyNs;
+    uint64_t maxLatencyNs;
+    uint64_t totalLatencyNs;
+};
+
+class ResizePacer {
+ public:
+    ResizePacer() : width_(0), height_(0), pending_(false), inputNs_(0), stats_() {}
+
+    // Record the newest requested size at time nowNs, replacing any size
+    // still pending. Returns true if nothing was pending before, i.e. the
+    // caller has to schedule a frame.
+    bool Request(int32_t width, int32_t height, uint64_t nowNs) {
+        stats_.requests++;
+        bool schedule = !pending_;
+        if (pending_) {
+            stats_.skipped++;
+        }
+        width_ = width;
+        height_ = height;
+        inputNs_ = nowNs;
+        pending_ = true;
+        return schedule;
+    }
+
+    // Frame tick at time nowNs: give out the pending size, if any.
+    // Returns false if no size is pending.
+    bool Take(uint64_t nowNs, int32_t* width, int32_t* height) {
+        if (!pending_) {
+            return false;
+        }
+        pending_ = false;
+        *width = width_;
+        *height = height_;
+
+        uint64_t latency = nowNs > inputNs_ ? nowNs - inputNs_ : 0;
+        stats_.applied++;
+        stats_.lastLatencyNs = latency;
+        stats_.totalLatencyNs += latency;
+        if (latency > stats_.maxLatencyNs) {
+            stats_.maxLatencyNs = latency;
+        }
+        return true;
+    }
+
+    // Whether a size is waiting for a frame
+    bool pending() const { return pending_; }
+
+    // Forget the pending size without applying it (counted as skipped)
+    void Reset() {
+        if (pending_) {
+            stats_.skipped++;
+            pending_ = false;
+        }
+    }
+
+    const ResizePacingStats& stats() const { return stats_; }
+
+ private:
+    int32_t width_;
+    int32_t height_;
+    bool pending_;
+    uint64_t inputNs_;
+    ResizePacingStats stats_;
+};
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_RESIZE_PACER_H_
@@ -0,0 +1,164 @@
+// Window Decoration Core - Sharded window registry
+// Per-thread shards of WindowRegistry for apps that run several UI threads
+// (e.g. one Flutter engine per thread). A native window only ever receives
+// messages on the thread that created it, so each UI thread owns one shard:
+// its windows, their state and the thread's own backend state (message
+// hook, ...). The owning thread reads and writes its shard without locks
+// and never touches another thread's shard; windows on different UI threads
+// never contend.
+//
+// Ownership rule: only the owning thread may use a shard. Backends forward
+// calls made on other threads to the window's thread before touching its
+// state. The only shared structure is the shard directory, which is locked
+// on a thread's first lookup and cached in a thread-local afterwards.
+//
+// OS thread ids are reused once a thread exits, so a thread retires its
+// shard with its last window; a later thread with the same id then starts
+// from a fresh shard instead of inheriting the old one.
+
+#ifndef WINDOW_DECORATION_CORE_SHARDED_WINDOW_REGISTRY_H_
+#define WINDOW_DECORATION_CORE_SHARDED_WINDOW_REGISTRY_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "window_decoration_core/window_registry.h"
+
+namespace window_decoration {
+
+// Unique id per registry instance, so thread-local caches never match a
+// registry that reused a destroyed one's address
+inline uint64_t NextShardedRegistryId() {
+    static std::atomic<uint64_t> next(1);
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+// PerThread: backend state owned by a UI thread (value-initialized when the
+// thread's shard is created)
+template <typename Key, typename Hot, typename Cold, typename PerThread>
+class ShardedWindowRegistry {
+ public:
+    // OS thread id (GetCurrentThreadId(), gettid(), ...)
+    typedef uint64_t ThreadId;
+
+    struct Shard {
+        explicit Shard(ThreadId ownerThread) : owner(ownerThread), thread() {}
+
+        Shard(const Shard&) = delete;
+        Shard& operator=(const Shard&) = delete;
+
+        const ThreadId owner;
+        WindowRegistry<Key, Hot, Cold> windows;
+        PerThread thread;
+    };
+
+    // Result of Register(): the window's slot in the calling thread's shard,
+    // and whether it is the first window on that thread (install per-thread
+    // hooks now)
+    struct Registration {
+        Shard* shard;
+        uint32_t slot;
+        bool firstOnThread;
+    };
+
+    ShardedWindowRegistry() : id_(NextShardedRegistryId()) {}
+
+    ShardedWindowRegistry(const ShardedWindowRegistry&) = delete;
+    ShardedWindowRegistry& operator=(const ShardedWindowRegistry&) = delete;
+
+    // Shard of the calling thread, created on first use. `self` must be the
+    // calling thread's id; it is only read on the first call per thread.
+    // The pointer stays valid until the thread retires its shard.
+    Shard* CurrentShard(ThreadId self) {
+        CachedShard& cached = ThreadCache();
+        if (cached.registry == id_) {
+            return cached.shard;
+        }
+        Shard* shard = ShardFor(self);
+        cached.registry = id_;
+        cached.shard = shard;
+        return shard;
+    }
+
+    // Register `key` on the calling thread. Returns the existing slot if it
+    // is already registered there; slot is kNoSlot for a null key.
+    Registration Register(ThreadId self, Key key) {
+        Shard* shard = CurrentShard(self);
+        bool wasEmpty = shard->windows.empty();
+        uint32_t slot = shard->windows.Insert(key);
+        return { shard, slot, wasEmpty && slot != kNoSlot };
+    }
+
+    // Unregister `key` from the calling thread's shard. Returns true if it
+    // was the thread's last window (remove per-thread hooks now).
+    bool Unregister(ThreadId self, Key key) {
+        Shard* shard = CurrentShard(self);
+        return shard->windows.Remove(key) && shard->windows.empty();
+    }
+
+    // Drop the calling thread's shard once its last window is unregistered
+    // (remove per-thread hooks first). The shard and its per-thread state
+    // are destroyed; the thread's next lookup creates a fresh one. Returns
+    // false, keeping the shard, if it still has windows or doesn't exist.
+    bool Retire(ThreadId self) {
+        std::lock_guard<std::mutex> lock(directoryMutex_);
+        for (auto it = shards_.begin(); it != shards_.end(); ++it) {
+            if ((*it)->owner != self) {
+                continue;
+            }
+            if (!(*it)->windows.empty()) {
+                return false;
+            }
+            CachedShard& cached = ThreadCache();
+            if (cached.registry == id_) {
+                cached = { 0, nullptr };
+            }
+            shards_.erase(it);
+            return true;
+        }
+        return false;
+    }
+
+    // Number of UI threads with a live shard
+    size_t shardCount() const {
+        std::lock_guard<std::mutex> lock(directoryMutex_);
+        return shards_.size();
+    }
+
+    static constexpr uint32_t kNoSlot = WindowRegistry<Key, Hot, Cold>::kNoSlot;
+
+ private:
+    struct CachedShard {
+        uint64_t registry;
+        Shard* shard;
+    };
+
+    // The calling thread's last looked-up shard (one per thread, whichever
+    // registry it came from)
+    static CachedShard& ThreadCache() {
+        static thread_local CachedShard cached = { 0, nullptr };
+        return cached;
+    }
+
+    Shard* ShardFor(ThreadId owner) {
+        std::lock_guard<std::mutex> lock(directoryMutex_);
+        for (const std::unique_ptr<Shard>& shard : shards_) {
+            if (shard->owner == owner) {
+                return shard.get();
+            }
+        }
+        shards_.emplace_back(new Shard(owner));
+        return shards_.back().get();
+    }
+
+    const uint64_t id_;
+    mutable std::mutex directoryMutex_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_SHARDED_WINDOW_REGISTRY_H_
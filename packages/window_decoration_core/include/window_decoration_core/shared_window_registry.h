@@ -0,0 +1,129 @@
+// Window Decoration Core - Shared window registry
+// Window bounds, frame modes and caption regions published into a block of
+// shared memory, so cooperating processes can see each other's windows
+// (snapping, docking, overlap avoidance) with plain memory reads instead of
+// IPC round trips.
+//
+// The block is a fixed array of slots behind a versioned header. A process
+// claims a slot per window with a compare-and-swap on the slot owner and is
+// then its only writer. Each slot is a seqlock: the writer makes the
+// sequence odd, stores the payload and makes it even again; readers copy
+// the payload and retry if the sequence changed. Neither side ever locks or
+// waits for the other process.
+//
+// This code only interprets the memory. Backends create and map it (a named
+// file mapping on Windows, memfd or shm_open on Linux); freshly created
+// mappings are zero-filled, which is the "not initialized" state. A process
+// that dies while initializing the header doesn't block the others: the
+// next one to open the mapping takes over after a bounded wait.
+//
+// Slots of processes that exit without releasing them (crashes, kills) are
+// swept by the survivors with ReleaseDeadProcesses.
+
+#ifndef WINDOW_DECORATION_CORE_SHARED_WINDOW_REGISTRY_H_
+#define WINDOW_DECORATION_CORE_SHARED_WINDOW_REGISTRY_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "window_decoration_core/hit_test.h"
+
+namespace window_decoration {
+
+// Layout identification. Bump the major version for incompatible changes;
+// minor versions may only append fields to the slot payload.
+constexpr uint32_t SHARED_REGISTRY_MAGIC = 0x52534457;  // "WDSR"
+constexpr uint16_t SHARED_REGISTRY_MAJOR_VERSION = 1;
+constexpr uint16_t SHARED_REGISTRY_MINOR_VERSION = 0;
+
+// Caption regions published per window (the first ones registered)
+constexpr uint32_t MAX_SHARED_CAPTION_REGIONS = 16;
+
+// Upper bound on the slot count of a registry
+constexpr uint32_t MAX_SHARED_REGISTRY_SLOTS = 4096;
+
+struct SharedCaptionRegion {
+    Rect bounds;  // client coordinates
+    int32_t hit;  // HitCode
+};
+
+// What a process publishes about one of its windows
+struct SharedWindowInfo {
+    uint64_t window;     // native handle
+    uint32_t processId;  // owning process
+    int32_t frameMode;   // FrameMode
+    Rect bounds;         // screen coordinates
+    uint32_t dpi;
+    int32_t captionHeight;
+    uint32_t regionCount;
+    uint32_t reserved;
+    SharedCaptionRegion regions[MAX_SHARED_CAPTION_REGIONS];
+};
+
+class SharedWindowRegistry {
+ public:
+    // Whether the process with this id is still running
+    typedef bool (*ProcessAliveFn)(uint32_t processId);
+
+    SharedWindowRegistry();
+
+    // Bytes of shared memory needed for slotCount slots
+    static size_t RequiredBytes(uint32_t slotCount);
+
+    // Attach to a mapping of `size` bytes, initializing it if this is the
+    // first process to open it, or taking over from one that died halfway
+    // through. Returns false if the memory is too small or was initialized
+    // with an incompatible layout.
+    bool Open(void* memory, size_t size, uint32_t slotCount);
+
+    // Detach (does not release this process's slots)
+    void Close();
+
+    bool isOpen() const { return header_ != nullptr; }
+    uint32_t slotCount() const { return slotCount_; }
+
+    // Claim a free slot for `window`. Returns the slot index, or -1 if all
+    // slots are taken. The caller becomes the slot's only writer.
+    int Claim(uint32_t processId, uint64_t window);
+
+    // Publish `info` into a slot claimed by processId. Returns false if the
+    // slot is not owned by processId.
+    bool Publish(int slot, uint32_t processId, const SharedWindowInfo& info);
+
+    // Give a slot back
+    void Release(int slot, uint32_t processId);
+
+    // Release every slot of a process that exited without cleaning up.
+    // Safe to call from several processes at once. Returns the number of
+    // slots released.
+    uint32_t ReleaseProcess(uint32_t processId);
+
+    // Release the slots of every owner isAlive reports as gone. Backends
+    // call this when they open the registry and when a claim finds it full.
+    // Returns the number of slots released.
+    uint32_t ReleaseDeadProcesses(ProcessAliveFn isAlive);
+
+    // Copy a consistent snapshot of a slot. Returns false if the slot is
+    // free, has not been published yet, or stayed mid-write for too long
+    // (its writer died during an update).
+    bool Read(int slot, SharedWindowInfo* info) const;
+
+    // Read every published window into out (up to capacity) and return the
+    // number of windows read
+    uint32_t ReadAll(SharedWindowInfo* out, uint32_t capacity) const;
+
+ private:
+    struct Header;
+    struct Slot;
+
+    Slot* SlotAt(int slot) const;
+
+    Header* header_;
+    unsigned char* slots_;
+    uint32_t slotCount_;
+};
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_SHARED_WINDOW_REGISTRY_H_
@@ -0,0 +1,81 @@
+// Window Decoration Core - Single-producer single-consumer ring
+// Fixed-capacity lock-free queue between exactly one producer thread and
+// one consumer thread. Each side caches the other's index and only reloads
+// it when the ring looks full (producer) or empty (consumer), so a push or
+// pop is normally one relaxed load, one copy and one release store.
+
+#ifndef WINDOW_DECORATION_CORE_SPSC_RING_H_
+#define WINDOW_DECORATION_CORE_SPSC_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace window_decoration {
+
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "items are copied in and out");
+
+ public:
+    SpscRing() : head_(0), cachedTail_(0), tail_(0), cachedHead_(0) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    static constexpr size_t capacity() { return Capacity; }
+
+    // Producer: append value. Returns false (and drops it) if the ring is full.
+    bool TryPush(const T& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ == Capacity) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ == Capacity) {
+                return false;
+            }
+        }
+        items_[tail & (Capacity - 1)] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: move up to maxCount items into out, oldest first. Returns
+    // the number moved.
+    size_t PopAll(T* out, size_t maxCount) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (cachedTail_ == head) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+        }
+
+        size_t count = cachedTail_ - head;
+        if (count > maxCount) {
+            count = maxCount;
+        }
+        for (size_t i = 0; i < count; i++) {
+            out[i] = items_[(head + i) & (Capacity - 1)];
+        }
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // Consumer: whether nothing is queued (a push may land right after)
+    bool empty() const {
+        return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_relaxed);
+    }
+
+ private:
+    // Consumer side
+    alignas(64) std::atomic<size_t> head_;
+    size_t cachedTail_;
+
+    // Producer side
+    alignas(64) std::atomic<size_t> tail_;
+    size_t cachedHead_;
+
+    alignas(64) T items_[Capacity];
+};
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_SPSC_RING_H_
@@ -0,0 +1,123 @@
+// Window Decoration Core - Window animation
+// Bounds and opacity animations stepped natively from the display's frame
+// cadence, so an animated window costs Dart nothing per frame. Each step
+// produces one frame: the interpolated bounds and opacity, and which of the
+// two changed since the previous frame, so the backend makes at most one
+// geometry call and one opacity call per frame.
+//
+// Progress is computed from the frame time, not by counting frames: a
+// stalled frame makes the animation jump ahead instead of running long.
+// Frames that the display refreshed past without a step are counted as
+// dropped. Time is passed in by the caller (nanoseconds on any monotonic
+// clock), so the backends drive it from the frame clock and the benchmark
+// from a simulated one.
+
+#ifndef WINDOW_DECORATION_CORE_WINDOW_ANIMATION_H_
+#define WINDOW_DECORATION_CORE_WINDOW_ANIMATION_H_
+
+#include <cstdint>
+
+#include "window_decoration_core/hit_test.h"
+
+namespace window_decoration {
+
+// WindowAnimationParams.properties and WindowAnimationFrame.changed
+constexpr uint32_t ANIMATE_BOUNDS = 1 << 0;
+constexpr uint32_t ANIMATE_OPACITY = 1 << 1;
+
+enum class AnimationCurve : int32_t {
+    Linear = 0,
+    EaseIn = 1,     // cubic, starts slow
+    EaseOut = 2,    // cubic, ends slow
+    EaseInOut = 3,  // cubic, slow at both ends
+};
+
+// Target of an animation, as passed across FFI
+struct WindowAnimationParams {
+    Rect bounds;         // backend screen coordinates
+    double opacity;      // 0.0 - 1.0
+    int64_t durationNs;
+    int32_t curve;       // AnimationCurve
+    uint32_t properties; // ANIMATE_*
+};
+
+// One step of an animation
+struct WindowAnimationFrame {
+    Rect bounds;
+    double opacity;
+    uint32_t changed;  // ANIMATE_* that differ from the previous frame
+    bool finished;     // last frame: bounds and opacity are the target
+};
+
+// Animation counters of a window
+struct WindowAnimationStats {
+    // Animations started, run to their target, and stopped early (by
+    // Cancel() or a newer animation)
+    uint64_t started;
+    uint64_t completed;
+    uint64_t cancelled;
+
+    // Frames stepped, and display refreshes missed between them
+    uint64_t frames;
+    uint64_t droppedFrames;
+};
+
+// Map linear progress t in [0, 1] through a curve
+double EvaluateCurve(AnimationCurve curve, double t);
+
+class WindowAnimation {
+ public:
+    WindowAnimation();
+
+    // Animate from `bounds` and `opacity` towards params. A running
+    // animation is replaced (and counted as cancelled). Time starts with
+    // the first Step(), whose frame is already one refresh interval in, so
+    // the first frame moves. Returns false, leaving a running animation
+    // alone, for an empty or unknown property set, an unknown curve, a
+    // negative duration or empty target bounds.
+    bool Start(const WindowAnimationParams& params, const Rect& bounds, double opacity);
+
+    // Stop without reaching the target. Returns false if nothing was
+    // running.
+    bool Cancel();
+
+    bool running() const { return running_; }
+
+    // Compute the frame for a display refresh at frameTimeNs.
+    // refreshIntervalNs is the display's frame interval (0 when unknown,
+    // which disables the dropped frame count). Returns false if no
+    // animation is running.
+    bool Step(int64_t frameTimeNs, int64_t refreshIntervalNs, WindowAnimationFrame* frame);
+
+    // Jump to the target without waiting for frames, e.g. for a window that
+    // isn't shown. Returns false if no animation is running.
+    bool Finish(WindowAnimationFrame* frame);
+
+    const WindowAnimationStats& stats() const { return stats_; }
+
+ private:
+    // Fill frame with bounds and opacity and make them the last stepped
+    void Emit(const Rect& bounds, double opacity, bool finished, WindowAnimationFrame* frame);
+
+    bool running_;
+    uint32_t properties_;
+    AnimationCurve curve_;
+    int64_t durationNs_;
+
+    // -1 until the first Step()
+    int64_t startNs_;
+    int64_t lastFrameNs_;
+
+    Rect fromBounds_;
+    Rect toBounds_;
+    Rect bounds_;  // last stepped
+    double fromOpacity_;
+    double toOpacity_;
+    double opacity_;
+
+    WindowAnimationStats stats_;
+};
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_WINDOW_ANIMATION_H_
@@ -0,0 +1,128 @@
+// Window Decoration Core - Window event stream
+// Pushes window events (moves, resizes, show state, DPI, focus, theme and
+// close requests) from the UI thread to a consumer without polling. The UI
+// thread appends to a lock-free SPSC ring; a delivery thread drains it and
+// hands batches to a callback (the backends post them to a Dart native
+// port, see dart_port.h).
+//
+// Delivery is paced per frame: the first event after a quiet period is
+// delivered right away, later ones are collected until the frame interval
+// has passed and then coalesced, so a drag that configures the window on
+// every pointer move still produces at most one move per frame.
+
+#ifndef WINDOW_DECORATION_CORE_WINDOW_EVENT_STREAM_H_
+#define WINDOW_DECORATION_CORE_WINDOW_EVENT_STREAM_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "window_decoration_core/spsc_ring.h"
+
+namespace window_decoration {
+
+enum class WindowEventType : uint32_t {
+    Moved = 1,           // values: x, y (screen coordinates)
+    Resized = 2,         // values: width, height
+    Maximized = 3,
+    Minimized = 4,
+    Restored = 5,        // back from maximized or minimized
+    DpiChanged = 6,      // values: dpi (96 = 100% scale)
+    FocusChanged = 7,    // values: 1 focused, 0 not
+    ThemeChanged = 8,    // values: 1 dark, 0 light
+    CloseRequested = 9,
+};
+
+// One event as delivered. The layout is mirrored by the Dart decoder
+// (WindowEvent.decodeAll), which reads batches of these records.
+struct WindowEvent {
+    uint64_t window;       // native handle
+    uint64_t timestampNs;  // WindowEventClock() when it happened
+    WindowEventType type;
+    int32_t values[2];
+    uint32_t reserved;
+};
+
+static_assert(std::is_trivially_copyable<WindowEvent>::value, "copied through the ring");
+static_assert(sizeof(WindowEvent) == 32, "layout is mirrored by the Dart bindings");
+
+// Monotonic clock of WindowEvent.timestampNs (the steady clock, which is
+// also what Dart's Stopwatch reads)
+inline uint64_t WindowEventClock() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Whether only the latest event of this type per window matters. Show
+// state changes and close requests are all kept.
+bool IsCoalescable(WindowEventType type);
+
+// Drop every coalescable event that a later event of the same window and
+// type supersedes, keeping the order of the rest. Returns the new count.
+size_t CoalesceWindowEvents(WindowEvent* events, size_t count);
+
+struct WindowEventStats {
+    uint64_t pushed;     // accepted by Push
+    uint64_t dropped;    // rejected by Push because the ring was full
+    uint64_t delivered;  // handed to the callback
+    uint64_t coalesced;  // superseded before delivery
+    uint64_t batches;    // callback invocations
+};
+
+class WindowEventStream {
+ public:
+    static constexpr size_t kCapacity = 1024;
+
+    // Called on the delivery thread with the coalesced events of a frame
+    typedef std::function<void(const WindowEvent* events, size_t count)> DeliverFn;
+
+    explicit WindowEventStream(DeliverFn deliver,
+                               std::chrono::nanoseconds frameInterval = std::chrono::milliseconds(16));
+
+    // Stops the delivery thread; queued events are not delivered
+    ~WindowEventStream();
+
+    WindowEventStream(const WindowEventStream&) = delete;
+    WindowEventStream& operator=(const WindowEventStream&) = delete;
+
+    // Queue an event. Only one thread (the window's UI thread) may push.
+    // Never blocks; takes a lock only to wake an idle delivery thread.
+    // Returns false if the ring is full and the event was dropped.
+    bool Push(const WindowEvent& event);
+
+    WindowEventStats stats() const;
+
+ private:
+    void Run();
+
+    DeliverFn deliver_;
+    std::chrono::nanoseconds frameInterval_;
+    SpscRing<WindowEvent, kCapacity> ring_;
+
+    // Set by the delivery thread before it waits for events; the producer
+    // only takes the mutex to notify while it is set
+    std::atomic<bool> sleeping_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_;
+
+    std::atomic<uint64_t> pushed_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<uint64_t> delivered_;
+    std::atomic<uint64_t> coalesced_;
+    std::atomic<uint64_t> batches_;
+
+    std::vector<WindowEvent> batch_;
+    std::thread thread_;
+};
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_WINDOW_EVENT_STREAM_H_
@@ -0,0 +1,126 @@
+// Window Decoration Core - Window layout store
+// Where each of an app's windows was left (restored bounds, maximized and
+// fullscreen state, frame mode and a fingerprint of its monitor), kept in
+// one compact, versioned binary file keyed by an app-chosen window id. The
+// backends map the file at startup and place a window from it before the
+// window is first shown, so it opens where it was left instead of jumping
+// there once Dart runs.
+//
+// File layout (native byte order and alignment):
+//
+//   header     magic "WDLS", major and minor version, header size, record
+//              size, record count, FNV-1a checksum of the records
+//   records    one per window, sorted by id
+//
+// Newer minor versions may only append fields to a record; readers step
+// over records by the recorded size. Files are never written in place:
+// backends write a new file next to the old one and rename it over, so a
+// crash leaves either the old or the new file. The checksum catches the
+// rest (a truncated copy, a disk error).
+//
+// This code only interprets bytes. Backends map, write and rename the file.
+
+#ifndef WINDOW_DECORATION_CORE_WINDOW_LAYOUT_STORE_H_
+#define WINDOW_DECORATION_CORE_WINDOW_LAYOUT_STORE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "window_decoration_core/hit_test.h"
+#include "window_decoration_core/monitor_topology.h"
+
+namespace window_decoration {
+
+constexpr uint32_t WINDOW_LAYOUT_MAGIC = 0x534C4457;  // "WDLS"
+constexpr uint16_t WINDOW_LAYOUT_MAJOR_VERSION = 1;
+constexpr uint16_t WINDOW_LAYOUT_MINOR_VERSION = 0;
+
+// Longest window id in bytes (UTF-8, without the terminator)
+constexpr size_t MAX_WINDOW_LAYOUT_ID_BYTES = 47;
+
+// Upper bound on the windows a store holds
+constexpr uint32_t MAX_WINDOW_LAYOUTS = 1024;
+
+// WindowLayout.flags
+constexpr uint32_t WINDOW_LAYOUT_MAXIMIZED = 1 << 0;
+constexpr uint32_t WINDOW_LAYOUT_FULLSCREEN = 1 << 1;
+
+struct WindowLayout {
+    Rect bounds;         // restored (not maximized) window rect, screen coordinates
+    uint64_t monitor;    // MonitorFingerprint() of the monitor holding it
+    uint32_t flags;      // WINDOW_LAYOUT_*
+    int32_t frameMode;   // FrameMode
+};
+
+// How RestoreWindowLayout-style calls placed a window
+enum class LayoutRestore : int32_t {
+    None = 0,      // nothing saved under the id (or no monitors)
+    Exact = 1,     // its monitor is still there: placed as it was left
+    Fallback = 2,  // its monitor is gone or changed: moved onto another one
+};
+
+// Identifies a monitor across runs by what it shows (bounds and DPI); the
+// backend's monitor handle changes every run. Never 0.
+uint64_t MonitorFingerprint(const MonitorInfo& monitor);
+
+// Where to put a saved layout on the current monitors. If a monitor with
+// the saved fingerprint is still there, the bounds are used as they were
+// (Exact). Otherwise (the monitor was unplugged, or its position,
+// resolution or scale changed) the window is moved, and shrunk if needed,
+// into the work area of the monitor holding most of it, or centered on the
+// primary monitor's work area if it is on none (Fallback). Returns None,
+// leaving `bounds` alone, without monitors.
+LayoutRestore ResolveWindowLayout(const MonitorTopology& topology, const WindowLayout& layout, Rect* bounds);
+
+class WindowLayoutStore {
+ public:
+    WindowLayoutStore();
+
+    // Replace the contents with a file image. An empty image (no file yet)
+    // loads as an empty store. Returns false, leaving the store empty, for
+    // another major version, a truncated image or a checksum mismatch.
+    bool Load(const void* image, size_t size);
+
+    void Clear();
+
+    size_t size() const { return records_.size(); }
+
+    // Binary search by id. Returns false if nothing is saved under it.
+    bool Find(const char* id, WindowLayout* layout) const;
+
+    // Add or replace the layout saved under id. Returns false for an empty
+    // or too long id, or a full store.
+    bool Put(const char* id, const WindowLayout& layout);
+
+    // Returns false if nothing was saved under id
+    bool Remove(const char* id);
+
+    // Whether Put() or Remove() changed anything since the last Load() or
+    // MarkClean()
+    bool dirty() const { return dirty_; }
+    void MarkClean() { dirty_ = false; }
+
+    // Bytes Encode() writes
+    size_t EncodedSize() const;
+
+    // Write the file image. Returns the bytes written, or 0 if capacity is
+    // less than EncodedSize(). Does not mark the store clean: call
+    // MarkClean() once the image is safely on disk.
+    size_t Encode(void* image, size_t capacity) const;
+
+ private:
+    // Same layout as a record in the file
+    struct Record {
+        char id[MAX_WINDOW_LAYOUT_ID_BYTES + 1];  // NUL-padded
+        WindowLayout layout;
+    };
+
+    // Sorted by id
+    std::vector<Record> records_;
+    bool dirty_;
+};
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_WINDOW_LAYOUT_STORE_H_
@@ -0,0 +1,50 @@
+// Window Decoration Core - Window placement
+// Placement rules on top of MonitorTopology: center a window on its
+// monitor, pull it back into the work area, or cascade it from another
+// window. All rects are window rects in the topology's screen coordinates,
+// and every result keeps the window's top-left corner (and so its title
+// bar) inside the work area.
+
+#ifndef WINDOW_DECORATION_CORE_WINDOW_PLACEMENT_H_
+#define WINDOW_DECORATION_CORE_WINDOW_PLACEMENT_H_
+
+#include <cstdint>
+
+#include "window_decoration_core/hit_test.h"
+#include "window_decoration_core/monitor_topology.h"
+
+namespace window_decoration {
+
+// Offset between cascaded windows at 96 DPI
+constexpr int CASCADE_STEP = 32;
+
+enum class PlacementMode : int32_t {
+    Center = 0,           // center on the window's monitor
+    ClampToWorkArea = 1,  // move (and shrink) into the window's work area
+    Cascade = 2,          // below and right of an anchor window
+};
+
+// Center a width x height window in a work area. A window larger than the
+// work area is aligned to its top-left instead.
+Rect CenterInWorkArea(const Rect& workArea, int width, int height);
+
+// Move a window into a work area by the shortest distance, shrinking it
+// first where it is larger than the work area
+Rect ClampToWorkArea(const Rect& workArea, const Rect& window);
+
+// Place a width x height window `step` right of and below the top-left of
+// `anchor`. Where that would cross the work area's right or bottom edge,
+// the cascade starts over at the work area's top-left on that axis.
+Rect CascadeInWorkArea(const Rect& workArea, const Rect& anchor, int width, int height, int step);
+
+// Place `window` on a topology with the given mode. The work area is that
+// of the monitor holding most of the window, or of the anchor for Cascade;
+// the cascade step is CASCADE_STEP scaled to that monitor's DPI when
+// `scaleStep` is set (physical pixel backends). Returns false without
+// monitors.
+bool SolvePlacement(const MonitorTopology& topology, PlacementMode mode, const Rect& window, const Rect& anchor,
+                    bool scaleStep, Rect* result);
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_WINDOW_PLACEMENT_H_
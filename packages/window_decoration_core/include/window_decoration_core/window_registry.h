@@ -0,0 +1,242 @@
+// Window Decoration Core - Window registry
+// Flat open-addressing map from native window handle to per-window state,
+// replacing std::unordered_map on the per-message path. A lookup is one
+// multiplicative hash and a linear probe over a packed {key, slot} array;
+// there are no node pointers to chase, and the table stays at most half
+// full so probes stay short as the window count grows.
+//
+// The state is split into a hot part (read on every message) and a cold
+// part, kept in separate chunked arrays. Chunks never move, so references
+// stay valid across inserts from re-entrant window procedures.
+
+#ifndef WINDOW_DECORATION_CORE_WINDOW_REGISTRY_H_
+#define WINDOW_DECORATION_CORE_WINDOW_REGISTRY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace window_decoration {
+
+// Key: a pointer or integer handle (HWND, GtkWindow*, ...). The null/zero
+// handle is reserved as the empty marker and can't be registered.
+template <typename Key, typename Hot, typename Cold>
+class WindowRegistry {
+ public:
+    static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+    WindowRegistry() : size_(0), shift_(64 - kMinCapacityBits), table_(size_t(1) << kMinCapacityBits) {}
+
+    WindowRegistry(const WindowRegistry&) = delete;
+    WindowRegistry& operator=(const WindowRegistry&) = delete;
+
+    // Slot of `key`, or kNoSlot if not registered
+    uint32_t Find(Key key) const {
+        uintptr_t bits = KeyBits(key);
+        if (bits == 0) {
+            return kNoSlot;
+        }
+        size_t mask = table_.size() - 1;
+        for (size_t i = Home(bits);; i = (i + 1) & mask) {
+            const Bucket& bucket = table_[i];
+            if (bucket.key == bits) {
+                return bucket.slot;
+            }
+            if (bucket.key == 0) {
+                return kNoSlot;
+            }
+        }
+    }
+
+    // Hot state of `key`, or nullptr if not registered
+    Hot* FindHot(Key key) {
+        uint32_t slot = Find(key);
+        return slot != kNoSlot ? &hot(slot) : nullptr;
+    }
+
+    // Register `key` with default-constructed state and return its slot.
+    // Returns the existing slot if already registered, kNoSlot for null.
+    uint32_t Insert(Key key) {
+        uintptr_t bits = KeyBits(key);
+        if (bits == 0) {
+            return kNoSlot;
+        }
+        uint32_t existing = Find(key);
+        if (existing != kNoSlot) {
+            return existing;
+        }
+
+        // Keep the load factor at or below 1/2
+        if ((size_ + 1) * 2 > table_.size()) {
+            Rehash(table_.size() * 2);
+        }
+
+        uint32_t slot = AllocateSlot();
+        size_t mask = table_.size() - 1;
+        size_t i = Home(bits);
+        while (table_[i].key != 0) {
+            i = (i + 1) & mask;
+        }
+        table_[i].key = bits;
+        table_[i].slot = slot;
+        size_++;
+        return slot;
+    }
+
+    // Unregister `key` and destroy its state. Returns false if not found.
+    bool Remove(Key key) {
+        uintptr_t bits = KeyBits(key);
+        if (bits == 0) {
+            return false;
+        }
+        size_t mask = table_.size() - 1;
+        size_t i = Home(bits);
+        while (table_[i].key != bits) {
+            if (table_[i].key == 0) {
+                return false;
+            }
+            i = (i + 1) & mask;
+        }
+
+        ReleaseSlot(table_[i].slot);
+        size_--;
+
+        // Backward-shift deletion: pull later entries of the probe run into
+        // the hole so lookups never need tombstones
+        size_t hole = i;
+        for (size_t j = (i + 1) & mask; table_[j].key != 0; j = (j + 1) & mask) {
+            size_t home = Home(table_[j].key);
+            // Move j into the hole unless its home lies cyclically in (hole, j]
+            bool homeAfterHole = hole <= j ? (home > hole && home <= j) : (home > hole || home <= j);
+            if (!homeAfterHole) {
+                table_[hole] = table_[j];
+                hole = j;
+            }
+        }
+        table_[hole] = Bucket();
+        return true;
+    }
+
+    Hot& hot(uint32_t slot) { return hotChunks_[slot >> kChunkBits][slot & kChunkMask]; }
+    Cold& cold(uint32_t slot) { return coldChunks_[slot >> kChunkBits][slot & kChunkMask]; }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // Bytes held by the registry (table plus state chunks)
+    size_t MemoryBytes() const {
+        return table_.capacity() * sizeof(Bucket) +
+               hotChunks_.size() * kChunkSize * sizeof(Hot) +
+               coldChunks_.size() * kChunkSize * sizeof(Cold) +
+               freeSlots_.capacity() * sizeof(uint32_t);
+    }
+
+    // Call fn(key, slot) for every registered window
+    template <typename Fn>
+    void ForEach(Fn&& fn) {
+        for (const Bucket& bucket : table_) {
+            if (bucket.key != 0) {
+                fn(FromBits(bucket.key), bucket.slot);
+            }
+        }
+    }
+
+ private:
+    struct Bucket {
+        uintptr_t key = 0;
+        uint32_t slot = kNoSlot;
+    };
+
+    static constexpr int kMinCapacityBits = 4;
+    static constexpr int kChunkBits = 3;
+    static constexpr uint32_t kChunkSize = 1u << kChunkBits;
+    static constexpr uint32_t kChunkMask = kChunkSize - 1;
+
+    static uintptr_t KeyBits(Key key) {
+        if constexpr (std::is_pointer<Key>::value) {
+            return reinterpret_cast<uintptr_t>(key);
+        } else {
+            return static_cast<uintptr_t>(key);
+        }
+    }
+
+    static Key FromBits(uintptr_t bits) {
+        if constexpr (std::is_pointer<Key>::value) {
+            return reinterpret_cast<Key>(bits);
+        } else {
+            return static_cast<Key>(bits);
+        }
+    }
+
+    // Fibonacci hashing: handles are often aligned or sequential, and the
+    // multiply spreads them over the high bits
+    size_t Home(uintptr_t bits) const {
+        return static_cast<size_t>((static_cast<uint64_t>(bits) * 0x9E3779B97F4A7C15ull) >> shift_);
+    }
+
+    void Rehash(size_t capacity) {
+        std::vector<Bucket> old;
+        old.swap(table_);
+        table_.assign(capacity, Bucket());
+        int bits = 0;
+        while ((size_t(1) << bits) < capacity) {
+            bits++;
+        }
+        shift_ = 64 - bits;
+
+        size_t mask = capacity - 1;
+        for (const Bucket& bucket : old) {
+            if (bucket.key == 0) {
+                continue;
+            }
+            size_t i = Home(bucket.key);
+            while (table_[i].key != 0) {
+                i = (i + 1) & mask;
+            }
+            table_[i] = bucket;
+        }
+    }
+
+    uint32_t AllocateSlot() {
+        uint32_t slot;
+        if (!freeSlots_.empty()) {
+            slot = freeSlots_.back();
+            freeSlots_.pop_back();
+        } else {
+            // Chunks are value-initialized, so fresh slots are ready to use
+            slot = nextSlot_++;
+            if ((slot & kChunkMask) == 0) {
+                hotChunks_.emplace_back(new Hot[kChunkSize]());
+                coldChunks_.emplace_back(new Cold[kChunkSize]());
+            }
+        }
+        return slot;
+    }
+
+    void ReleaseSlot(uint32_t slot) {
+        // Reset in place (state may be neither copyable nor movable) so the
+        // slot is value-initialized again for its next window
+        Hot* hotState = &hot(slot);
+        hotState->~Hot();
+        new (hotState) Hot();
+        Cold* coldState = &cold(slot);
+        coldState->~Cold();
+        new (coldState) Cold();
+        freeSlots_.push_back(slot);
+    }
+
+    size_t size_;
+    int shift_;
+    uint32_t nextSlot_ = 0;
+    std::vector<Bucket> table_;
+    std::vector<std::unique_ptr<Hot[]>> hotChunks_;
+    std::vector<std::unique_ptr<Cold[]>> coldChunks_;
+    std::vector<uint32_t> freeSlots_;
+};
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_WINDOW_REGISTRY_H_
@@ -0,0 +1,108 @@
+// Window Decoration Core - Window state block
+// A WindowStateInfo kept in native memory and republished by the backend
+// from its window events (configure, window-state, WM_WINDOWPOSCHANGED)
+// instead of being queried from the window system on every read. The block
+// is a seqlock: one writer (the window's UI thread) and any number of
+// readers that never lock and never call back into native code, so Dart can
+// read a consistent snapshot straight through a Pointer.
+//
+// Layout (mirrored by the Dart bindings):
+//   uint32 sequence   odd while a publish is in progress
+//   uint32 reserved
+//   uint64 window     the handle the block describes; 0 once released
+//   WindowStateInfo   the last published state
+//
+// Blocks come from a WindowStateBlockPool and are never freed, so a reader
+// holding a stale pointer after the window is destroyed reads window 0
+// (or a different window, once the block is reused) instead of freed memory.
+
+#ifndef WINDOW_DECORATION_CORE_WINDOW_STATE_BLOCK_H_
+#define WINDOW_DECORATION_CORE_WINDOW_STATE_BLOCK_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "window_decoration_core/window_state_info.h"
+
+namespace window_decoration {
+
+// Payload words: the window handle followed by the WindowStateInfo
+constexpr uint32_t WINDOW_STATE_BLOCK_WORDS = (sizeof(uint64_t) + sizeof(WindowStateInfo)) / sizeof(uint32_t);
+
+struct alignas(8) WindowStateBlock {
+    std::atomic<uint32_t> sequence;
+    uint32_t reserved;
+    std::atomic<uint32_t> payload[WINDOW_STATE_BLOCK_WORDS];
+};
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "payload words are read as plain uint32");
+static_assert(offsetof(WindowStateBlock, payload) == 8, "layout is mirrored by the Dart bindings");
+static_assert(sizeof(WindowStateBlock) == 80, "layout is mirrored by the Dart bindings");
+
+// Publish a new state. Only the block's writer may call this.
+void PublishWindowState(WindowStateBlock* block, uint64_t window, const WindowStateInfo& info);
+
+// Copy a consistent snapshot. Returns false if the block was released, or
+// stayed mid-write for too long.
+bool ReadWindowState(const WindowStateBlock& block, uint64_t* window, WindowStateInfo* info);
+
+// The writer side of one block: keeps the last published state, so event
+// handlers change the fields their event carries and republish the rest
+// unchanged
+class WindowStatePublisher {
+ public:
+    WindowStatePublisher(WindowStateBlock* block, uint64_t window)
+        : block_(block), window_(window), state_() {}
+
+    WindowStateBlock* block() const { return block_; }
+    WindowStateInfo& state() { return state_; }
+    const WindowStateInfo& state() const { return state_; }
+
+    void Publish() { PublishWindowState(block_, window_, state_); }
+
+    // Set or clear WINDOW_STATE_* flags; returns true if any changed
+    bool SetFlags(uint32_t mask, uint32_t flags) {
+        uint32_t updated = (state_.flags & ~mask) | (flags & mask);
+        bool changed = updated != state_.flags;
+        state_.flags = updated;
+        return changed;
+    }
+
+ private:
+    WindowStateBlock* block_;
+    uint64_t window_;
+    WindowStateInfo state_;
+};
+
+// Process-wide pool of blocks. Acquire and Release run when windows are
+// opened and destroyed, so a mutex is fine; reads never touch the pool.
+class WindowStateBlockPool {
+ public:
+    WindowStateBlockPool() = default;
+    WindowStateBlockPool(const WindowStateBlockPool&) = delete;
+    WindowStateBlockPool& operator=(const WindowStateBlockPool&) = delete;
+
+    // A block describing `window`, published with no state (flags 0) until
+    // the writer publishes the first real snapshot
+    WindowStateBlock* Acquire(uint64_t window);
+
+    // Unpublish the block (window 0) and keep it for the next Acquire
+    void Release(WindowStateBlock* block);
+
+    size_t allocated() const;
+
+ private:
+    static constexpr size_t kChunkBlocks = 16;
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<WindowStateBlock[]>> chunks_;
+    std::vector<WindowStateBlock*> free_;
+};
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_WINDOW_STATE_BLOCK_H_
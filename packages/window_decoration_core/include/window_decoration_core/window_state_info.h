@@ -0,0 +1,41 @@
+// Window Decoration Core - Window state snapshot
+// Everything a caller usually polls about a window (bounds, the monitor it
+// is on, frame mode, maximized/fullscreen state and DPI) in one plain
+// struct that backends return by value from a single exported call. It has
+// no pointers and a fixed layout, so FFI callers can receive it without
+// allocating anything on either side and bind it as a leaf call.
+
+#ifndef WINDOW_DECORATION_CORE_WINDOW_STATE_INFO_H_
+#define WINDOW_DECORATION_CORE_WINDOW_STATE_INFO_H_
+
+#include <cstdint>
+#include <type_traits>
+
+#include "window_decoration_core/hit_test.h"
+
+namespace window_decoration {
+
+// WindowStateInfo.flags
+constexpr uint32_t WINDOW_STATE_VALID = 1 << 0;  // the handle was a live window
+constexpr uint32_t WINDOW_STATE_VISIBLE = 1 << 1;
+constexpr uint32_t WINDOW_STATE_FOCUSED = 1 << 2;
+constexpr uint32_t WINDOW_STATE_MAXIMIZED = 1 << 3;
+constexpr uint32_t WINDOW_STATE_MINIMIZED = 1 << 4;
+constexpr uint32_t WINDOW_STATE_FULLSCREEN = 1 << 5;
+
+struct WindowStateInfo {
+    Rect bounds;      // window, screen coordinates
+    Rect monitor;     // the window's monitor
+    Rect workArea;    // the monitor minus taskbars and panels
+    uint32_t dpi;     // 96 = 100% scale
+    int32_t frameMode;  // FrameMode; Normal for windows the backend doesn't manage
+    uint32_t flags;     // WINDOW_STATE_*
+    uint32_t reserved;
+};
+
+static_assert(std::is_trivially_copyable<WindowStateInfo>::value, "returned by value across FFI");
+static_assert(sizeof(WindowStateInfo) == 64, "layout is mirrored by the Dart bindings");
+
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_WINDOW_STATE_INFO_H_
@@ -0,0 +1,155 @@
+// Window Decoration Core - Batch hit testing
+// Dispatcher, SSE2 kernels and scalar fallback
+
+#include "window_decoration_core/batch_hit_test.h"
+
+#include <cstring>
+
+#include "window_decoration_core/caption_mask.h"
+#include "window_decoration_core/caption_regions.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WINDOW_DECORATION_HAVE_SSE2 1
+#include <emmintrin.h>
+#include "batch_hit_test_impl.h"
+#endif
+
+#if defined(WINDOW_DECORATION_HAVE_AVX2) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace window_decoration {
+
+#if defined(WINDOW_DECORATION_HAVE_AVX2)
+// Defined in batch_hit_test_avx2.cpp, which is compiled with AVX2 enabled
+size_t HitTestBatchAvx2(const int32_t* xs, const int32_t* ys, size_t count,
+                        const FrameGeometry& geometry, FrameMode mode,
+                        const CaptionLayout& caption, HitCode* results);
+#endif
+
+#if defined(WINDOW_DECORATION_HAVE_SSE2)
+namespace {
+
+// 4 x int32 lanes
+struct Sse2Ops {
+    using Vec = __m128i;
+    static constexpr size_t kLanes = 4;
+
+    static Vec Load(const int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static Vec Set(int value) { return _mm_set1_epi32(value); }
+    static Vec Sub(Vec a, Vec b) { return _mm_sub_epi32(a, b); }
+    static Vec Lt(Vec a, Vec b) { return _mm_cmplt_epi32(a, b); }
+    static Vec And(Vec a, Vec b) { return _mm_and_si128(a, b); }
+    static Vec Or(Vec a, Vec b) { return _mm_or_si128(a, b); }
+
+    // mask ? a : b
+    static Vec Select(Vec mask, Vec a, Vec b) {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+
+    // Narrow the 4 codes to bytes and store them
+    static void StoreCodes(HitCode* out, Vec codes) {
+        __m128i packed = _mm_packs_epi32(codes, codes);
+        packed = _mm_packus_epi16(packed, packed);
+        int32_t bytes = _mm_cvtsi128_si32(packed);
+        std::memcpy(out, &bytes, sizeof(bytes));
+    }
+};
+
+}  // namespace
+#endif
+
+static SimdLevel DetectSimdLevel() {
+#if defined(WINDOW_DECORATION_HAVE_AVX2)
+#if defined(_MSC_VER)
+    // AVX2 needs both CPU support (CPUID.7:EBX[5]) and OS support for the
+    // YMM state (OSXSAVE + XCR0 bits 1 and 2)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] >= 7) {
+        __cpuidex(info, 7, 0);
+        bool avx2 = (info[1] & (1 << 5)) != 0;
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        if (avx2 && osxsave && (_xgetbv(0) & 0x6) == 0x6) {
+            return SimdLevel::Avx2;
+        }
+    }
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::Avx2;
+    }
+#endif
+#endif
+
+#if defined(WINDOW_DECORATION_HAVE_SSE2)
+    return SimdLevel::Sse2;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+SimdLevel SupportedSimdLevel() {
+    static const SimdLevel level = DetectSimdLevel();
+    return level;
+}
+
+void HitTestBatch(const int32_t* xs, const int32_t* ys, size_t count,
+                  const FrameGeometry& geometry, FrameMode mode,
+                  const CaptionLayout& caption, const CaptionRegionIndex* regions,
+                  const CaptionMask* mask, HitCode* results, SimdLevel level) {
+    SimdLevel supported = SupportedSimdLevel();
+    if (level > supported) {
+        level = supported;
+    }
+
+    size_t done = 0;
+#if defined(WINDOW_DECORATION_HAVE_AVX2)
+    if (level == SimdLevel::Avx2) {
+        done = HitTestBatchAvx2(xs, ys, count, geometry, mode, caption, results);
+    }
+#endif
+#if defined(WINDOW_DECORATION_HAVE_SSE2)
+    if (level >= SimdLevel::Sse2) {
+        done += RunBatchKernel<Sse2Ops>(xs + done, ys + done, count - done,
+                                        geometry, mode, caption, results + done);
+    }
+#endif
+
+    // Scalar tail (and everything when no vector kernel applies)
+    for (size_t i = done; i < count; i++) {
+        switch (mode) {
+            case FrameMode::CustomFrame:
+                results[i] = HitTestCustomFrame(xs[i], ys[i], geometry, caption, regions, mask);
+                break;
+            case FrameMode::Hidden:
+                results[i] = HitTestHiddenFrame(xs[i], ys[i], geometry);
+                break;
+            case FrameMode::Normal:
+                results[i] = HitCode::Client;
+                break;
+        }
+    }
+
+    // The kernels stop before the named regions and the mask; resolve those
+    // per point
+    bool hasRegions = regions != nullptr && !regions->empty();
+    bool hasMask = mask != nullptr && !mask->empty();
+    if (mode == FrameMode::CustomFrame && (hasRegions || hasMask)) {
+        for (size_t i = 0; i < done; i++) {
+            if (results[i] != HitCode::Caption && results[i] != HitCode::Client) {
+                continue;
+            }
+            int clientX = xs[i] - geometry.clientLeft;
+            int clientY = ys[i] - geometry.clientTop;
+            HitCode hit;
+            if ((hasRegions && regions->Lookup(clientX, clientY, &hit)) ||
+                (hasMask && mask->Lookup(clientX, clientY, geometry.dpi, &hit))) {
+                results[i] = hit;
+            }
+        }
+    }
+}
+
+}  // namespace window_decoration
@@ -0,0 +1,48 @@
+// Window Decoration Core - Batch hit testing (AVX2)
+// Compiled with AVX2 enabled; only called after SupportedSimdLevel()
+// confirmed the CPU supports it
+
+#include <immintrin.h>
+
+#include "batch_hit_test_impl.h"
+
+namespace window_decoration {
+
+namespace {
+
+// 8 x int32 lanes
+struct Avx2Ops {
+    using Vec = __m256i;
+    static constexpr size_t kLanes = 8;
+
+    static Vec Load(const int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static Vec Set(int value) { return _mm256_set1_epi32(value); }
+    static Vec Sub(Vec a, Vec b) { return _mm256_sub_epi32(a, b); }
+    static Vec Lt(Vec a, Vec b) { return _mm256_cmpgt_epi32(b, a); }
+    static Vec And(Vec a, Vec b) { return _mm256_and_si256(a, b); }
+    static Vec Or(Vec a, Vec b) { return _mm256_or_si256(a, b); }
+
+    // mask ? a : b
+    static Vec Select(Vec mask, Vec a, Vec b) { return _mm256_blendv_epi8(b, a, mask); }
+
+    // Narrow the 8 codes to bytes and store them
+    static void StoreCodes(HitCode* out, Vec codes) {
+        __m128i low = _mm256_castsi256_si128(codes);
+        __m128i high = _mm256_extracti128_si256(codes, 1);
+        __m128i packed = _mm_packs_epi32(low, high);
+        packed = _mm_packus_epi16(packed, packed);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out), packed);
+    }
+};
+
+}  // namespace
+
+size_t HitTestBatchAvx2(const int32_t* xs, const int32_t* ys, size_t count,
+                        const FrameGeometry& geometry, FrameMode mode,
+                        const CaptionLayout& caption, HitCode* results) {
+    size_t done = RunBatchKernel<Avx2Ops>(xs, ys, count, geometry, mode, caption, results);
+    _mm256_zeroupper();
+    return done;
+}
+
+}  // namespace window_decoration
@@ -0,0 +1,167 @@
+// Window Decoration Core - Batch hit testing kernels
+// Shared by the SSE2 and AVX2 translation units. Each unit instantiates the
+// kernels with its own vector ops; everything here has internal linkage so
+// code compiled for AVX2 can never be picked by the linker for a caller
+// that runs on a CPU without it. That includes helpers: the kernels must
+// not call the inline functions of hit_test.h, whose out-of-line copies
+// are weak symbols the linker may take from the AVX2 unit.
+
+#ifndef WINDOW_DECORATION_CORE_BATCH_HIT_TEST_IMPL_H_
+#define WINDOW_DECORATION_CORE_BATCH_HIT_TEST_IMPL_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "window_decoration_core/hit_test.h"
+
+namespace window_decoration {
+namespace {
+
+// ScaleForDpi() of hit_test.h, with internal linkage
+int KernelScaleForDpi(int value, unsigned int dpi) {
+    int64_t product = static_cast<int64_t>(value) * dpi;
+    return static_cast<int>(product >= 0 ? (product + 48) / 96 : (product - 48) / 96);
+}
+
+// Branch-free custom frame classification for Ops::kLanes points at a time.
+// Results are composed from the lowest to the highest priority rule, so a
+// later Select() overrides an earlier one exactly where the scalar code
+// would have returned first. Returns the number of points processed.
+template <typename Ops>
+size_t CustomFrameKernel(const int32_t* xs, const int32_t* ys, size_t count,
+                         const FrameGeometry& geometry, const CaptionLayout& caption,
+                         HitCode* results) {
+    using Vec = typename Ops::Vec;
+
+    int bw = geometry.borderWidth;
+    int bh = geometry.borderHeight;
+    int captionHeight = caption.captionHeight > 0 ? caption.captionHeight : DEFAULT_CAPTION_HEIGHT;
+    captionHeight = KernelScaleForDpi(captionHeight, geometry.dpi);
+
+    const Vec borderWidth = Ops::Set(bw);
+    const Vec borderHeight = Ops::Set(bh);
+    const Vec topEdge = Ops::Set(bh / 2);
+    const Vec rightEdge = Ops::Set(geometry.windowWidth - bw - 1);
+    const Vec bottomEdge = Ops::Set(geometry.windowHeight - bh - 1);
+    const Vec clientLeft = Ops::Set(geometry.clientLeft);
+    const Vec clientTop = Ops::Set(geometry.clientTop);
+    const Vec captionBottom = Ops::Set(captionHeight);
+
+    const Rect* buttons[] = { &caption.minimizeButton, &caption.maximizeButton, &caption.closeButton };
+    const HitCode buttonHits[] = { HitCode::MinButton, HitCode::MaxButton, HitCode::Close };
+
+    size_t i = 0;
+    for (; i + Ops::kLanes <= count; i += Ops::kLanes) {
+        Vec x = Ops::Load(xs + i);
+        Vec y = Ops::Load(ys + i);
+        Vec cx = Ops::Sub(x, clientLeft);
+        Vec cy = Ops::Sub(y, clientTop);
+
+        Vec result = Ops::Select(Ops::Lt(cy, captionBottom),
+                                 Ops::Set(static_cast<int>(HitCode::Caption)),
+                                 Ops::Set(static_cast<int>(HitCode::Client)));
+
+        // Minimize, maximize, close (close has the highest priority)
+        if (caption.hasCaptionButtons) {
+            for (int b = 0; b < 3; b++) {
+                const Rect& rect = *buttons[b];
+                Vec inside = Ops::And(
+                    Ops::And(Ops::Lt(Ops::Set(rect.left - 1), cx), Ops::Lt(cx, Ops::Set(rect.right))),
+                    Ops::And(Ops::Lt(Ops::Set(rect.top - 1), cy), Ops::Lt(cy, Ops::Set(rect.bottom))));
+                result = Ops::Select(inside, Ops::Set(static_cast<int>(buttonHits[b])), result);
+            }
+        }
+
+        if (!geometry.isMaximized) {
+            Vec isLeft = Ops::Lt(x, borderWidth);
+            Vec isRight = Ops::Lt(rightEdge, x);
+            Vec isTop = Ops::Lt(y, borderHeight);
+            Vec isBottom = Ops::Lt(bottomEdge, y);
+
+            result = Ops::Select(Ops::Lt(y, topEdge), Ops::Set(static_cast<int>(HitCode::Top)), result);
+            result = Ops::Select(isBottom, Ops::Set(static_cast<int>(HitCode::Bottom)), result);
+            result = Ops::Select(isRight, Ops::Set(static_cast<int>(HitCode::Right)), result);
+            result = Ops::Select(isLeft, Ops::Set(static_cast<int>(HitCode::Left)), result);
+            result = Ops::Select(Ops::And(isBottom, isRight), Ops::Set(static_cast<int>(HitCode::BottomRight)), result);
+            result = Ops::Select(Ops::And(isBottom, isLeft), Ops::Set(static_cast<int>(HitCode::BottomLeft)), result);
+            result = Ops::Select(Ops::And(isTop, isRight), Ops::Set(static_cast<int>(HitCode::TopRight)), result);
+            result = Ops::Select(Ops::And(isTop, isLeft), Ops::Set(static_cast<int>(HitCode::TopLeft)), result);
+        }
+
+        Ops::StoreCodes(results + i, result);
+    }
+
+    return i;
+}
+
+// Branch-free hidden frame classification, see CustomFrameKernel
+template <typename Ops>
+size_t HiddenFrameKernel(const int32_t* xs, const int32_t* ys, size_t count,
+                         const FrameGeometry& geometry, HitCode* results) {
+    using Vec = typename Ops::Vec;
+
+    int bw = geometry.borderWidth < RESIZE_BORDER_WIDTH ? RESIZE_BORDER_WIDTH : geometry.borderWidth;
+    int cs = bw * 2;
+    int width = geometry.windowWidth;
+    int height = geometry.windowHeight;
+
+    const Vec border = Ops::Set(bw);
+    const Vec corner = Ops::Set(cs);
+    const Vec rightEdge = Ops::Set(width - bw - 1);
+    const Vec nearRightEdge = Ops::Set(width - cs - 1);
+    const Vec bottomEdge = Ops::Set(height - bw - 1);
+    const Vec nearBottomEdge = Ops::Set(height - cs - 1);
+
+    size_t i = 0;
+    for (; i + Ops::kLanes <= count; i += Ops::kLanes) {
+        Vec x = Ops::Load(xs + i);
+        Vec y = Ops::Load(ys + i);
+
+        Vec isLeft = Ops::Lt(x, border);
+        Vec isRight = Ops::Lt(rightEdge, x);
+        Vec isTop = Ops::Lt(y, border);
+        Vec isBottom = Ops::Lt(bottomEdge, y);
+        Vec isNearLeft = Ops::Lt(x, corner);
+        Vec isNearRight = Ops::Lt(nearRightEdge, x);
+        Vec isNearTop = Ops::Lt(y, corner);
+        Vec isNearBottom = Ops::Lt(nearBottomEdge, y);
+
+        Vec result = Ops::Set(static_cast<int>(HitCode::Client));
+        result = Ops::Select(isBottom, Ops::Set(static_cast<int>(HitCode::Bottom)), result);
+        result = Ops::Select(isTop, Ops::Set(static_cast<int>(HitCode::Top)), result);
+        result = Ops::Select(isRight, Ops::Set(static_cast<int>(HitCode::Right)), result);
+        result = Ops::Select(isLeft, Ops::Set(static_cast<int>(HitCode::Left)), result);
+        result = Ops::Select(Ops::Or(Ops::And(isBottom, isNearRight), Ops::And(isRight, isNearBottom)),
+                             Ops::Set(static_cast<int>(HitCode::BottomRight)), result);
+        result = Ops::Select(Ops::Or(Ops::And(isBottom, isNearLeft), Ops::And(isLeft, isNearBottom)),
+                             Ops::Set(static_cast<int>(HitCode::BottomLeft)), result);
+        result = Ops::Select(Ops::Or(Ops::And(isTop, isNearRight), Ops::And(isRight, isNearTop)),
+                             Ops::Set(static_cast<int>(HitCode::TopRight)), result);
+        result = Ops::Select(Ops::Or(Ops::And(isTop, isNearLeft), Ops::And(isLeft, isNearTop)),
+                             Ops::Set(static_cast<int>(HitCode::TopLeft)), result);
+
+        Ops::StoreCodes(results + i, result);
+    }
+
+    return i;
+}
+
+// Run the kernel for `mode` and return the number of points processed;
+// the caller finishes the tail with the scalar hit testers
+template <typename Ops>
+size_t RunBatchKernel(const int32_t* xs, const int32_t* ys, size_t count,
+                      const FrameGeometry& geometry, FrameMode mode,
+                      const CaptionLayout& caption, HitCode* results) {
+    if (mode == FrameMode::CustomFrame) {
+        return CustomFrameKernel<Ops>(xs, ys, count, geometry, caption, results);
+    }
+    if (mode == FrameMode::Hidden && !geometry.isMaximized) {
+        return HiddenFrameKernel<Ops>(xs, ys, count, geometry, results);
+    }
+    return 0;
+}
+
+}  // namespace
+}  // namespace window_decoration
+
+#endif  // WINDOW_DECORATION_CORE_BATCH_HIT_TEST_IMPL_H_
@@ -0,0 +1,162 @@
+// Window Decoration Core - Caption mask
+// Run-length decoding, dirty-row splicing and per-row binary search lookup
+
+#include "window_decoration_core/caption_mask.h"
+
+#include <algorithm>
+
+namespace window_decoration {
+
+CaptionMask::CaptionMask() : width_(0), height_(0) {}
+
+bool CaptionMask::Decode(int width, int rowCount, const uint16_t* runs, size_t length,
+                         std::vector<uint16_t>* transitions,
+                         std::vector<uint32_t>* rowCounts) const {
+    if (runs == nullptr && length > 0) {
+        return false;
+    }
+
+    size_t cursor = 0;
+    for (int row = 0; row < rowCount; row++) {
+        if (cursor >= length) {
+            return false;
+        }
+        size_t runCount = runs[cursor++];
+        if (runCount > length - cursor) {
+            return false;
+        }
+
+        size_t rowFirst = transitions->size();
+        int x = 0;
+        for (size_t i = 0; i < runCount; i++) {
+            x = std::min(x + static_cast<int>(runs[cursor + i]), width);
+
+            // Every run ends in a flip except a last draggable one (pixels
+            // past the last run are draggable); a flip at the mask edge
+            // changes nothing
+            if ((i + 1 == runCount && (i & 1) == 0) || x >= width) {
+                continue;
+            }
+
+            // Zero-length runs cancel the previous flip
+            if (transitions->size() > rowFirst && transitions->back() == x) {
+                transitions->pop_back();
+            } else {
+                transitions->push_back(static_cast<uint16_t>(x));
+            }
+        }
+        cursor += runCount;
+
+        rowCounts->push_back(static_cast<uint32_t>(transitions->size() - rowFirst));
+        if (transitions->size() > MAX_CAPTION_MASK_TRANSITIONS) {
+            return false;
+        }
+    }
+
+    // Trailing data means the row count and the encoding disagree
+    return cursor == length;
+}
+
+bool CaptionMask::Set(int width, int height, const uint16_t* runs, size_t length) {
+    if (width <= 0 || width > MAX_CAPTION_MASK_WIDTH ||
+        height <= 0 || height > MAX_CAPTION_MASK_HEIGHT) {
+        return false;
+    }
+
+    std::vector<uint16_t> transitions;
+    std::vector<uint32_t> rowCounts;
+    rowCounts.reserve(height);
+    if (!Decode(width, height, runs, length, &transitions, &rowCounts)) {
+        return false;
+    }
+
+    width_ = width;
+    height_ = height;
+    transitions_.swap(transitions);
+    transitions_.shrink_to_fit();
+
+    rowStart_.assign(height + 1, 0);
+    for (int row = 0; row < height; row++) {
+        rowStart_[row + 1] = rowStart_[row] + rowCounts[row];
+    }
+    return true;
+}
+
+bool CaptionMask::UpdateRows(int firstRow, int rowCount, const uint16_t* runs, size_t length) {
+    if (empty() || firstRow < 0 || rowCount <= 0 || rowCount > height_ - firstRow) {
+        return false;
+    }
+
+    std::vector<uint16_t> transitions;
+    std::vector<uint32_t> rowCounts;
+    rowCounts.reserve(rowCount);
+    if (!Decode(width_, rowCount, runs, length, &transitions, &rowCounts)) {
+        return false;
+    }
+
+    int lastRow = firstRow + rowCount;
+    size_t spliceBegin = rowStart_[firstRow];
+    size_t spliceEnd = rowStart_[lastRow];
+    if (transitions_.size() - (spliceEnd - spliceBegin) + transitions.size() > MAX_CAPTION_MASK_TRANSITIONS) {
+        return false;
+    }
+
+    // Splice the dirty rows; rows outside the range are moved, not decoded
+    transitions_.erase(transitions_.begin() + spliceBegin, transitions_.begin() + spliceEnd);
+    transitions_.insert(transitions_.begin() + spliceBegin, transitions.begin(), transitions.end());
+
+    for (int i = 0; i < rowCount; i++) {
+        rowStart_[firstRow + i + 1] = rowStart_[firstRow + i] + rowCounts[i];
+    }
+    int64_t delta = static_cast<int64_t>(rowStart_[lastRow]) - static_cast<int64_t>(spliceEnd);
+    if (delta != 0) {
+        for (int row = lastRow + 1; row <= height_; row++) {
+            rowStart_[row] = static_cast<uint32_t>(rowStart_[row] + delta);
+        }
+    }
+    return true;
+}
+
+void CaptionMask::Clear() {
+    width_ = 0;
+    height_ = 0;
+    rowStart_.clear();
+    transitions_.clear();
+}
+
+bool CaptionMask::Lookup(int x, int y, unsigned int dpi, HitCode* hit) const {
+    // The upper bound keeps the 32-bit scaling below from overflowing
+    if (empty() || x < 0 || y < 0 || x >= (1 << 24) || y >= (1 << 24)) {
+        return false;
+    }
+
+    // Physical to logical pixels
+    if (dpi == 0) {
+        dpi = 96;
+    }
+    unsigned int logicalX = static_cast<unsigned int>(x) * 96 / dpi;
+    unsigned int logicalY = static_cast<unsigned int>(y) * 96 / dpi;
+    if (logicalX >= static_cast<unsigned int>(width_) || logicalY >= static_cast<unsigned int>(height_)) {
+        return false;
+    }
+
+    // An odd number of flips at or before x means interactive. Branch-free
+    // binary search: hover positions are unpredictable, so a branchy search
+    // mispredicts on most steps.
+    const uint16_t* base = transitions_.data() + rowStart_[logicalY];
+    size_t count = rowStart_[logicalY + 1] - rowStart_[logicalY];
+    size_t flips = 0;
+    if (count > 0) {
+        const uint16_t* first = base;
+        while (count > 1) {
+            size_t half = count / 2;
+            first = first[half] <= logicalX ? first + half : first;
+            count -= half;
+        }
+        flips = static_cast<size_t>(first - base) + (*first <= logicalX ? 1 : 0);
+    }
+    *hit = (flips & 1) ? HitCode::Client : HitCode::Caption;
+    return true;
+}
+
+}  // namespace window_decoration
@@ -0,0 +1,193 @@
+// Window Decoration Core - Caption regions
+// Uniform grid index over the registered caption regions
+
+#include "window_decoration_core/caption_regions.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace window_decoration {
+
+// Smallest grid cell is 32x32 pixels (1 << 5)
+static const int MIN_CELL_SHIFT = 5;
+
+// Upper bound on grid cells; the cell size grows to stay under it
+static const int MAX_GRID_CELLS = 4096;
+
+bool PointInCaptionRegion(int x, int y, const CaptionRegion& region) {
+    const Rect& rect = region.bounds;
+    if (!PointInRect(x, y, rect)) {
+        return false;
+    }
+
+    int radius = region.cornerRadius;
+    if (radius <= 0) {
+        return true;
+    }
+
+    // Only the corner squares need the circle test
+    int cornerX;
+    int cornerY;
+    if (x < rect.left + radius) {
+        cornerX = rect.left + radius;
+    } else if (x >= rect.right - radius) {
+        cornerX = rect.right - radius - 1;
+    } else {
+        return true;
+    }
+    if (y < rect.top + radius) {
+        cornerY = rect.top + radius;
+    } else if (y >= rect.bottom - radius) {
+        cornerY = rect.bottom - radius - 1;
+    } else {
+        return true;
+    }
+
+    int64_t dx = x - cornerX;
+    int64_t dy = y - cornerY;
+    return dx * dx + dy * dy <= static_cast<int64_t>(radius) * radius;
+}
+
+CaptionRegionIndex::CaptionRegionIndex()
+    : originX_(0), originY_(0), columns_(0), rows_(0), cellShift_(MIN_CELL_SHIFT) {}
+
+bool CaptionRegionIndex::Set(const std::string& name, const CaptionRegion& region) {
+    if (region.bounds.right <= region.bounds.left ||
+        region.bounds.bottom <= region.bounds.top ||
+        !IsValidCaptionRegionHit(region.hit)) {
+        return false;
+    }
+
+    CaptionRegion stored = region;
+    int maxRadius = std::min(region.bounds.right - region.bounds.left,
+                             region.bounds.bottom - region.bounds.top) / 2;
+    stored.cornerRadius = std::max(0, std::min(region.cornerRadius, maxRadius));
+
+    // Replacing a region keeps its stacking position
+    for (NamedRegion& existing : regions_) {
+        if (existing.name == name) {
+            existing.region = stored;
+            Rebuild();
+            return true;
+        }
+    }
+
+    if (regions_.size() >= MAX_CAPTION_REGIONS) {
+        return false;
+    }
+
+    regions_.push_back({ name, stored });
+    Rebuild();
+    return true;
+}
+
+bool CaptionRegionIndex::Remove(const std::string& name) {
+    auto it = std::find_if(regions_.begin(), regions_.end(),
+                           [&name](const NamedRegion& r) { return r.name == name; });
+    if (it == regions_.end()) {
+        return false;
+    }
+
+    regions_.erase(it);
+    Rebuild();
+    return true;
+}
+
+void CaptionRegionIndex::Clear() {
+    regions_.clear();
+    Rebuild();
+}
+
+bool CaptionRegionIndex::Lookup(int x, int y, HitCode* hit) const {
+    // Outside the grid means outside every region
+    int64_t column = (static_cast<int64_t>(x) - originX_) >> cellShift_;
+    int64_t row = (static_cast<int64_t>(y) - originY_) >> cellShift_;
+    if (column < 0 || row < 0 || column >= columns_ || row >= rows_) {
+        return false;
+    }
+
+    size_t cell = static_cast<size_t>(row * columns_ + column);
+    for (uint32_t i = cellStart_[cell]; i < cellStart_[cell + 1]; i++) {
+        const CaptionRegion& region = regions_[cellRegions_[i]].region;
+        if (PointInCaptionRegion(x, y, region)) {
+            *hit = region.hit;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CaptionRegionIndex::Rebuild() {
+    cellStart_.clear();
+    cellRegions_.clear();
+    columns_ = 0;
+    rows_ = 0;
+
+    if (regions_.empty()) {
+        return;
+    }
+
+    // Bounding box of all regions
+    int left = INT_MAX;
+    int top = INT_MAX;
+    int right = INT_MIN;
+    int bottom = INT_MIN;
+    for (const NamedRegion& named : regions_) {
+        left = std::min(left, named.region.bounds.left);
+        top = std::min(top, named.region.bounds.top);
+        right = std::max(right, named.region.bounds.right);
+        bottom = std::max(bottom, named.region.bounds.bottom);
+    }
+
+    originX_ = left;
+    originY_ = top;
+    int64_t width = static_cast<int64_t>(right) - left;
+    int64_t height = static_cast<int64_t>(bottom) - top;
+
+    // Grow the cells until the grid fits the cell budget
+    cellShift_ = MIN_CELL_SHIFT;
+    for (;;) {
+        int64_t columns = ((width - 1) >> cellShift_) + 1;
+        int64_t rows = ((height - 1) >> cellShift_) + 1;
+        if (columns * rows <= MAX_GRID_CELLS) {
+            columns_ = static_cast<int>(columns);
+            rows_ = static_cast<int>(rows);
+            break;
+        }
+        cellShift_++;
+    }
+
+    // Count regions per cell, then fill topmost (last registered) first
+    size_t cellCount = static_cast<size_t>(columns_) * rows_;
+    cellStart_.assign(cellCount + 1, 0);
+
+    auto forEachCell = [this](const Rect& bounds, auto&& fn) {
+        int firstColumn = static_cast<int>((static_cast<int64_t>(bounds.left) - originX_) >> cellShift_);
+        int lastColumn = static_cast<int>((static_cast<int64_t>(bounds.right) - 1 - originX_) >> cellShift_);
+        int firstRow = static_cast<int>((static_cast<int64_t>(bounds.top) - originY_) >> cellShift_);
+        int lastRow = static_cast<int>((static_cast<int64_t>(bounds.bottom) - 1 - originY_) >> cellShift_);
+        for (int row = firstRow; row <= lastRow; row++) {
+            for (int column = firstColumn; column <= lastColumn; column++) {
+                fn(static_cast<size_t>(row) * columns_ + column);
+            }
+        }
+    };
+
+    for (const NamedRegion& named : regions_) {
+        forEachCell(named.region.bounds, [this](size_t cell) { cellStart_[cell + 1]++; });
+    }
+    for (size_t cell = 0; cell < cellCount; cell++) {
+        cellStart_[cell + 1] += cellStart_[cell];
+    }
+
+    cellRegions_.resize(cellStart_[cellCount]);
+    std::vector<uint32_t> fill(cellStart_.begin(), cellStart_.end() - 1);
+    for (size_t i = regions_.size(); i-- > 0;) {
+        forEachCell(regions_[i].region.bounds, [&](size_t cell) {
+            cellRegions_[fill[cell]++] = static_cast<uint16_t>(i);
+        });
+    }
+}
+
+}  // namespace window_decoration
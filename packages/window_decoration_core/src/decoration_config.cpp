@@ -0,0 +1,103 @@
+// Window Decoration Core - Decoration config encoding implementation
+
+#include "window_decoration_core/decoration_config.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace window_decoration {
+
+namespace {
+
+constexpr uint16_t kKnownFlags = DECORATION_CONFIG_CENTERED | DECORATION_CONFIG_ALWAYS_ON_TOP |
+                                 DECORATION_CONFIG_SKIP_TASKBAR | DECORATION_CONFIG_FRAMELESS |
+                                 DECORATION_CONFIG_VISIBLE | DECORATION_CONFIG_HAS_BACKGROUND |
+                                 DECORATION_CONFIG_HAS_OPACITY;
+
+uint16_t ReadU16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t ReadU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+void WriteU16(uint8_t* p, uint16_t value) {
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void WriteU32(uint8_t* p, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+}  // namespace
+
+bool DecodeDecorationConfig(const uint8_t* blob, size_t length, DecorationConfig* config) {
+    if (blob == nullptr || config == nullptr || length < DECORATION_CONFIG_FIXED_BYTES) {
+        return false;
+    }
+
+    uint8_t fixedBytes = blob[1];
+    uint8_t effectCount = blob[15];
+    if (blob[0] != DECORATION_CONFIG_VERSION || fixedBytes < DECORATION_CONFIG_FIXED_BYTES ||
+        effectCount > MAX_DECORATION_EFFECTS || length < static_cast<size_t>(fixedBytes) + effectCount) {
+        return false;
+    }
+
+    uint8_t titleBarStyle = blob[14];
+    if (titleBarStyle > static_cast<uint8_t>(TitleBarStyle::CustomFrame)) {
+        return false;
+    }
+
+    float opacity;
+    uint32_t opacityBits = ReadU32(blob + 8);
+    static_assert(sizeof(opacity) == sizeof(opacityBits), "opacity must be a 32-bit float");
+    std::memcpy(&opacity, &opacityBits, sizeof(opacity));
+    if (std::isnan(opacity)) {
+        return false;
+    }
+
+    DecorationConfig decoded = {};
+    // Flags added by newer minor versions are dropped, not misread
+    decoded.flags = ReadU16(blob + 2) & kKnownFlags;
+    decoded.backgroundColor = ReadU32(blob + 4);
+    decoded.opacity = opacity < 0.0f ? 0.0f : (opacity > 1.0f ? 1.0f : opacity);
+    decoded.captionHeight = ReadU16(blob + 12);
+    decoded.titleBarStyle = static_cast<TitleBarStyle>(titleBarStyle);
+    decoded.effectCount = effectCount;
+    for (uint8_t i = 0; i < effectCount; i++) {
+        decoded.effects[i] = static_cast<WindowEffect>(blob[fixedBytes + i]);
+    }
+
+    *config = decoded;
+    return true;
+}
+
+size_t EncodeDecorationConfig(const DecorationConfig& config, uint8_t* blob, size_t capacity) {
+    size_t length = DECORATION_CONFIG_FIXED_BYTES + config.effectCount;
+    if (blob == nullptr || config.effectCount > MAX_DECORATION_EFFECTS || capacity < length) {
+        return 0;
+    }
+
+    uint32_t opacityBits;
+    std::memcpy(&opacityBits, &config.opacity, sizeof(opacityBits));
+
+    blob[0] = DECORATION_CONFIG_VERSION;
+    blob[1] = DECORATION_CONFIG_FIXED_BYTES;
+    WriteU16(blob + 2, config.flags);
+    WriteU32(blob + 4, config.backgroundColor);
+    WriteU32(blob + 8, opacityBits);
+    WriteU16(blob + 12, config.captionHeight);
+    blob[14] = static_cast<uint8_t>(config.titleBarStyle);
+    blob[15] = config.effectCount;
+    for (uint8_t i = 0; i < config.effectCount; i++) {
+        blob[DECORATION_CONFIG_FIXED_BYTES + i] = static_cast<uint8_t>(config.effects[i]);
+    }
+    return length;
+}
+
+}  // namespace window_decoration
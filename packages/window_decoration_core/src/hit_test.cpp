@@ -0,0 +1,51 @@
+// Window Decoration Core - Hit testing
+// Per-mode instantiations of the hit test policies (hit_test_policy.h)
+
+#include "window_decoration_core/hit_test.h"
+
+#include "window_decoration_core/hit_test_policy.h"
+
+namespace window_decoration {
+
+HitCode HitTestCustomFrame(int x, int y, const FrameGeometry& geometry,
+                           const CaptionLayout& caption,
+                           const CaptionRegionIndex* regions,
+                           const CaptionMask* mask) {
+    return HitTestFrame<CustomFramePolicy>(x, y, geometry, caption, regions, mask);
+}
+
+HitCode HitTestHiddenFrame(int x, int y, const FrameGeometry& geometry) {
+    static const CaptionLayout kNoCaption = {};
+    return HitTestFrame<HiddenFramePolicy>(x, y, geometry, kNoCaption, nullptr, nullptr);
+}
+
+HitCode ResolveResizeCell(int x, int y, const FrameGeometry& geometry,
+                          FrameMode mode, Rect* cell) {
+    return SelectResizeCell(mode)(x, y, geometry, cell);
+}
+
+HitTestFn SelectHitTest(FrameMode mode) {
+    switch (mode) {
+        case FrameMode::CustomFrame:
+            return &HitTestFrame<CustomFramePolicy>;
+        case FrameMode::Hidden:
+            return &HitTestFrame<HiddenFramePolicy>;
+        case FrameMode::Normal:
+            break;
+    }
+    return &HitTestFrame<NormalFramePolicy>;
+}
+
+ResizeCellFn SelectResizeCell(FrameMode mode) {
+    switch (mode) {
+        case FrameMode::CustomFrame:
+            return &ResolveResizeCellFor<CustomFramePolicy>;
+        case FrameMode::Hidden:
+            return &ResolveResizeCellFor<HiddenFramePolicy>;
+        case FrameMode::Normal:
+            break;
+    }
+    return &ResolveResizeCellFor<NormalFramePolicy>;
+}
+
+}  // namespace window_decoration
@@ -0,0 +1,159 @@
+// Window Decoration Core - Monitor topology implementation
+
+#include "window_decoration_core/monitor_topology.h"
+
+#include <algorithm>
+
+namespace window_decoration {
+
+static bool SameRect(const Rect& a, const Rect& b) {
+    return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+}
+
+static bool IsEmpty(const Rect& rect) {
+    return rect.right <= rect.left || rect.bottom <= rect.top;
+}
+
+// Squared distance from a point to the nearest pixel of a rect
+static int64_t DistanceSquared(int x, int y, const Rect& rect) {
+    int64_t dx = x < rect.left ? rect.left - x : x >= rect.right ? x - rect.right + 1 : 0;
+    int64_t dy = y < rect.top ? rect.top - y : y >= rect.bottom ? y - rect.bottom + 1 : 0;
+    return dx * dx + dy * dy;
+}
+
+static int64_t IntersectionArea(const Rect& a, const Rect& b) {
+    int64_t width = static_cast<int64_t>(std::min(a.right, b.right)) - std::max(a.left, b.left);
+    int64_t height = static_cast<int64_t>(std::min(a.bottom, b.bottom)) - std::max(a.top, b.top);
+    return width > 0 && height > 0 ? width * height : 0;
+}
+
+bool MonitorTopology::Update(const MonitorInfo* monitors, size_t count) {
+    bool moved = count != monitors_.size();
+    bool changed = moved;
+    for (size_t i = 0; i < count && !moved; i++) {
+        const MonitorInfo& current = monitors_[i];
+        const MonitorInfo& next = monitors[i];
+        if (current.id != next.id || !SameRect(current.bounds, next.bounds)) {
+            moved = true;
+            changed = true;
+        } else if (!SameRect(current.workArea, next.workArea) || current.dpi != next.dpi ||
+                   current.flags != next.flags) {
+            changed = true;
+        }
+    }
+    if (!changed) {
+        return false;
+    }
+
+    monitors_.assign(monitors, monitors + count);
+    primary_ = count > 0 ? 0 : kNone;
+    for (size_t i = 0; i < count; i++) {
+        if (monitors_[i].flags & MONITOR_PRIMARY) {
+            primary_ = static_cast<int>(i);
+            break;
+        }
+    }
+    if (moved) {
+        RebuildIndex();
+    }
+    generation_++;
+    return true;
+}
+
+void MonitorTopology::RebuildIndex() {
+    slabEdges_.clear();
+    slabStart_.clear();
+    slabMonitors_.clear();
+
+    for (const MonitorInfo& monitor : monitors_) {
+        if (!IsEmpty(monitor.bounds)) {
+            slabEdges_.push_back(monitor.bounds.left);
+            slabEdges_.push_back(monitor.bounds.right);
+        }
+    }
+    std::sort(slabEdges_.begin(), slabEdges_.end());
+    slabEdges_.erase(std::unique(slabEdges_.begin(), slabEdges_.end()), slabEdges_.end());
+
+    for (size_t slab = 0; slab + 1 < slabEdges_.size(); slab++) {
+        slabStart_.push_back(static_cast<uint32_t>(slabMonitors_.size()));
+        for (size_t i = 0; i < monitors_.size(); i++) {
+            const Rect& bounds = monitors_[i].bounds;
+            if (!IsEmpty(bounds) && bounds.left <= slabEdges_[slab] && bounds.right >= slabEdges_[slab + 1]) {
+                slabMonitors_.push_back(static_cast<int>(i));
+            }
+        }
+    }
+    slabStart_.push_back(static_cast<uint32_t>(slabMonitors_.size()));
+}
+
+int MonitorTopology::FindById(uint64_t id) const {
+    for (size_t i = 0; i < monitors_.size(); i++) {
+        if (monitors_[i].id == id) {
+            return static_cast<int>(i);
+        }
+    }
+    return kNone;
+}
+
+int MonitorTopology::FindAt(int x, int y) const {
+    if (slabEdges_.empty() || x < slabEdges_.front() || x >= slabEdges_.back()) {
+        return kNone;
+    }
+
+    size_t slab = static_cast<size_t>(std::upper_bound(slabEdges_.begin(), slabEdges_.end(), x) -
+                                      slabEdges_.begin()) - 1;
+    for (uint32_t i = slabStart_[slab]; i < slabStart_[slab + 1]; i++) {
+        const Rect& bounds = monitors_[static_cast<size_t>(slabMonitors_[i])].bounds;
+        if (y >= bounds.top && y < bounds.bottom) {
+            return slabMonitors_[i];
+        }
+    }
+    return kNone;
+}
+
+int MonitorTopology::FindNearest(int x, int y) const {
+    int index = FindAt(x, y);
+    if (index != kNone) {
+        return index;
+    }
+
+    int64_t best = INT64_MAX;
+    for (size_t i = 0; i < monitors_.size(); i++) {
+        int64_t distance = DistanceSquared(x, y, monitors_[i].bounds);
+        if (distance < best) {
+            best = distance;
+            index = static_cast<int>(i);
+        }
+    }
+    return index;
+}
+
+int MonitorTopology::FindForRect(const Rect& rect) const {
+    int centerX = rect.left + (rect.right - rect.left) / 2;
+    int centerY = rect.top + (rect.bottom - rect.top) / 2;
+    if (IsEmpty(rect)) {
+        return FindNearest(rect.left, rect.top);
+    }
+
+    // Usually the window lies on one monitor entirely
+    int index = FindAt(centerX, centerY);
+    if (index != kNone) {
+        const Rect& bounds = monitors_[static_cast<size_t>(index)].bounds;
+        if (rect.left >= bounds.left && rect.top >= bounds.top && rect.right <= bounds.right &&
+            rect.bottom <= bounds.bottom) {
+            return index;
+        }
+    }
+
+    int64_t best = 0;
+    for (size_t i = 0; i < monitors_.size(); i++) {
+        int64_t area = IntersectionArea(rect, monitors_[i].bounds);
+        if (area > best) {
+            best = area;
+            index = static_cast<int>(i);
+        }
+    }
+    return best > 0 ? index : FindNearest(centerX, centerY);
+}
+
+}  // namespace window_decoration
@@ -0,0 +1,36 @@
+// Window Decoration Core - Platform capabilities implementation
+
+#include "window_decoration_core/platform_capabilities.h"
+
+namespace window_decoration {
+
+bool ParseOsVersion(const char* release, uint32_t* major, uint32_t* minor, uint32_t* build) {
+    uint32_t parts[3] = { 0, 0, 0 };
+    if (release == nullptr || *release < '0' || *release > '9') {
+        *major = *minor = *build = 0;
+        return false;
+    }
+
+    const char* p = release;
+    for (int i = 0; i < 3; i++) {
+        uint32_t value = 0;
+        while (*p >= '0' && *p <= '9') {
+            uint32_t digit = static_cast<uint32_t>(*p - '0');
+            // Saturate instead of wrapping on absurdly long numbers
+            value = value > (UINT32_MAX - digit) / 10 ? UINT32_MAX : value * 10 + digit;
+            p++;
+        }
+        parts[i] = value;
+        if (*p != '.' || p[1] < '0' || p[1] > '9') {
+            break;
+        }
+        p++;
+    }
+
+    *major = parts[0];
+    *minor = parts[1];
+    *build = parts[2];
+    return true;
+}
+
+}  // namespace window_decoration
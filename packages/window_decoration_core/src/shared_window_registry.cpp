@@ -0,0 +1,290 @@
+// Window Decoration Core - Shared window registry implementation
+
+#include "window_decoration_core/shared_window_registry.h"
+
+#include <cstring>
+#include <thread>
+
+namespace window_decoration {
+
+namespace {
+
+constexpr uint32_t kPayloadWords = sizeof(SharedWindowInfo) / sizeof(uint32_t);
+static_assert(sizeof(SharedWindowInfo) % sizeof(uint32_t) == 0, "payload must be whole words");
+static_assert(std::atomic<uint32_t>::is_always_lock_free,
+              "shared memory atomics must be lock-free to work across processes");
+
+// Header.state
+constexpr uint32_t kUninitialized = 0;
+constexpr uint32_t kInitializing = 1;
+constexpr uint32_t kReady = 2;
+
+constexpr size_t kAlignment = 64;
+
+// Give up on a slot that stays mid-write this many times in a row
+constexpr int kMaxReadRetries = 1024;
+
+// Take over a mapping whose creator never finished initializing it
+constexpr int kMaxInitWaits = 100000;
+
+// Slot.owner while another process releases a dead owner's slot: not free,
+// so Claim() can't hand it out before the payload is cleared
+constexpr uint32_t kReleasingOwner = UINT32_MAX;
+
+constexpr size_t AlignUp(size_t value) {
+    return (value + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+// The header takes one cache line; each slot (sequence and owner words plus
+// the payload) starts on its own cache line
+constexpr size_t kHeaderBytes = kAlignment;
+constexpr size_t kSlotBytes = AlignUp(sizeof(uint32_t) * 2 + sizeof(SharedWindowInfo));
+
+}  // namespace
+
+struct SharedWindowRegistry::Header {
+    std::atomic<uint32_t> state;
+    uint32_t magic;
+    uint16_t majorVersion;
+    uint16_t minorVersion;
+    uint32_t headerSize;
+    uint32_t slotSize;
+    uint32_t payloadSize;
+    uint32_t slotCount;
+};
+
+// A free slot has owner 0. A claimed slot whose payload window is 0 has not
+// been published yet (or was released); readers skip both.
+struct SharedWindowRegistry::Slot {
+    std::atomic<uint32_t> sequence;
+    std::atomic<uint32_t> owner;
+    std::atomic<uint32_t> payload[kPayloadWords];
+};
+
+SharedWindowRegistry::SharedWindowRegistry() : header_(nullptr), slots_(nullptr), slotCount_(0) {}
+
+size_t SharedWindowRegistry::RequiredBytes(uint32_t slotCount) {
+    return kHeaderBytes + static_cast<size_t>(slotCount) * kSlotBytes;
+}
+
+bool SharedWindowRegistry::Open(void* memory, size_t size, uint32_t slotCount) {
+    static_assert(sizeof(Header) <= kHeaderBytes, "header does not fit");
+    static_assert(sizeof(Slot) <= kSlotBytes, "slot does not fit");
+
+    Close();
+    if (memory == nullptr || slotCount == 0 || slotCount > MAX_SHARED_REGISTRY_SLOTS ||
+        size < RequiredBytes(slotCount)) {
+        return false;
+    }
+
+    Header* header = static_cast<Header*>(memory);
+    bool tookOver = false;
+    for (int wait = 0;; wait++) {
+        uint32_t state = header->state.load(std::memory_order_acquire);
+        if (state == kReady) {
+            break;
+        }
+        if (state == kUninitialized && header->state.compare_exchange_strong(state, kInitializing)) {
+            // First process: the mapping is zero-filled, so every slot is
+            // free. A process taking over rewrites the whole header; its
+            // predecessor died before any slot could be claimed.
+            header->magic = SHARED_REGISTRY_MAGIC;
+            header->majorVersion = SHARED_REGISTRY_MAJOR_VERSION;
+            header->minorVersion = SHARED_REGISTRY_MINOR_VERSION;
+            header->headerSize = static_cast<uint32_t>(kHeaderBytes);
+            header->slotSize = static_cast<uint32_t>(kSlotBytes);
+            header->payloadSize = static_cast<uint32_t>(sizeof(SharedWindowInfo));
+            header->slotCount = slotCount;
+            header->state.store(kReady, std::memory_order_release);
+            break;
+        }
+        if (wait == kMaxInitWaits) {
+            // Still initializing: its creator died halfway. Put the header
+            // back to uninitialized once and race for it again; another
+            // waiter may win, then this one waits for it instead.
+            if (state != kInitializing || tookOver) {
+                return false;
+            }
+            header->state.compare_exchange_strong(state, kUninitialized);
+            tookOver = true;
+            wait = 0;
+            continue;
+        }
+        std::this_thread::yield();
+    }
+
+    // A newer minor version may have grown the payload and the slots; the
+    // fields this version knows about stay at the same offsets
+    if (header->magic != SHARED_REGISTRY_MAGIC ||
+        header->majorVersion != SHARED_REGISTRY_MAJOR_VERSION ||
+        header->headerSize < kHeaderBytes ||
+        header->slotSize < kSlotBytes ||
+        header->payloadSize < sizeof(SharedWindowInfo) ||
+        header->slotCount == 0 || header->slotCount > MAX_SHARED_REGISTRY_SLOTS ||
+        size < header->headerSize + static_cast<size_t>(header->slotCount) * header->slotSize) {
+        return false;
+    }
+
+    header_ = header;
+    slots_ = static_cast<unsigned char*>(memory) + header->headerSize;
+    slotCount_ = header->slotCount;
+    return true;
+}
+
+void SharedWindowRegistry::Close() {
+    header_ = nullptr;
+    slots_ = nullptr;
+    slotCount_ = 0;
+}
+
+SharedWindowRegistry::Slot* SharedWindowRegistry::SlotAt(int slot) const {
+    if (header_ == nullptr || slot < 0 || static_cast<uint32_t>(slot) >= slotCount_) {
+        return nullptr;
+    }
+    return reinterpret_cast<Slot*>(slots_ + static_cast<size_t>(slot) * header_->slotSize);
+}
+
+int SharedWindowRegistry::Claim(uint32_t processId, uint64_t window) {
+    if (header_ == nullptr || processId == 0 || processId == kReleasingOwner || window == 0) {
+        return -1;
+    }
+    for (uint32_t i = 0; i < slotCount_; i++) {
+        Slot* slot = SlotAt(static_cast<int>(i));
+        uint32_t expected = 0;
+        if (slot->owner.load(std::memory_order_relaxed) == 0 &&
+            slot->owner.compare_exchange_strong(expected, processId)) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+// Seqlock write: odd sequence while the payload is being stored
+static void WritePayload(std::atomic<uint32_t>* sequence, std::atomic<uint32_t>* payload,
+                         const uint32_t* words) {
+    uint32_t start = sequence->load(std::memory_order_relaxed);
+    sequence->store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (uint32_t i = 0; i < kPayloadWords; i++) {
+        payload[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence->store(start + 2, std::memory_order_release);
+}
+
+bool SharedWindowRegistry::Publish(int index, uint32_t processId, const SharedWindowInfo& info) {
+    Slot* slot = SlotAt(index);
+    if (slot == nullptr || processId == 0 || info.window == 0 ||
+        slot->owner.load(std::memory_order_relaxed) != processId) {
+        return false;
+    }
+
+    SharedWindowInfo published = info;
+    published.processId = processId;
+    if (published.regionCount > MAX_SHARED_CAPTION_REGIONS) {
+        published.regionCount = MAX_SHARED_CAPTION_REGIONS;
+    }
+
+    uint32_t words[kPayloadWords];
+    std::memcpy(words, &published, sizeof(published));
+    WritePayload(&slot->sequence, slot->payload, words);
+    return true;
+}
+
+void SharedWindowRegistry::Release(int index, uint32_t processId) {
+    Slot* slot = SlotAt(index);
+    if (slot == nullptr || processId == 0 || slot->owner.load(std::memory_order_relaxed) != processId) {
+        return;
+    }
+
+    // Unpublish before freeing, so a reader never pairs the old window with
+    // the next owner's sequence
+    uint32_t words[kPayloadWords] = {};
+    WritePayload(&slot->sequence, slot->payload, words);
+    slot->owner.store(0, std::memory_order_release);
+}
+
+uint32_t SharedWindowRegistry::ReleaseProcess(uint32_t processId) {
+    if (processId == 0 || processId == kReleasingOwner) {
+        return 0;
+    }
+
+    // Several processes may sweep the same dead owner; moving the owner to
+    // kReleasingOwner first lets exactly one of them clear each slot, and
+    // keeps Claim() from handing it out until the payload is gone
+    uint32_t released = 0;
+    uint32_t words[kPayloadWords] = {};
+    for (uint32_t i = 0; i < slotCount_; i++) {
+        Slot* slot = SlotAt(static_cast<int>(i));
+        uint32_t expected = processId;
+        if (slot->owner.load(std::memory_order_relaxed) == processId &&
+            slot->owner.compare_exchange_strong(expected, kReleasingOwner)) {
+            WritePayload(&slot->sequence, slot->payload, words);
+            slot->owner.store(0, std::memory_order_release);
+            released++;
+        }
+    }
+    return released;
+}
+
+uint32_t SharedWindowRegistry::ReleaseDeadProcesses(ProcessAliveFn isAlive) {
+    if (header_ == nullptr || isAlive == nullptr) {
+        return 0;
+    }
+
+    // A process usually owns a run of slots, so remember the last owner
+    // found alive instead of asking again for each of its windows
+    uint32_t released = 0;
+    uint32_t lastAlive = 0;
+    for (uint32_t i = 0; i < slotCount_; i++) {
+        uint32_t owner = SlotAt(static_cast<int>(i))->owner.load(std::memory_order_relaxed);
+        if (owner == 0 || owner == kReleasingOwner || owner == lastAlive) {
+            continue;
+        }
+        if (isAlive(owner)) {
+            lastAlive = owner;
+        } else {
+            released += ReleaseProcess(owner);
+        }
+    }
+    return released;
+}
+
+bool SharedWindowRegistry::Read(int index, SharedWindowInfo* info) const {
+    Slot* slot = SlotAt(index);
+    if (slot == nullptr || info == nullptr) {
+        return false;
+    }
+
+    uint32_t words[kPayloadWords];
+    for (int attempt = 0; attempt < kMaxReadRetries; attempt++) {
+        if (slot->owner.load(std::memory_order_relaxed) == 0) {
+            return false;
+        }
+        uint32_t start = slot->sequence.load(std::memory_order_acquire);
+        if (start & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (uint32_t i = 0; i < kPayloadWords; i++) {
+            words[i] = slot->payload[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->sequence.load(std::memory_order_relaxed) == start) {
+            std::memcpy(info, words, sizeof(*info));
+            return info->window != 0;
+        }
+    }
+    return false;
+}
+
+uint32_t SharedWindowRegistry::ReadAll(SharedWindowInfo* out, uint32_t capacity) const {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < slotCount_ && count < capacity; i++) {
+        if (Read(static_cast<int>(i), &out[count])) {
+            count++;
+        }
+    }
+    return count;
+}
+
+}  // namespace window_decoration
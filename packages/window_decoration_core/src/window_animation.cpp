@@ -0,0 +1,164 @@
+// Window Decoration Core - Window animation implementation
+
+#include "window_decoration_core/window_animation.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace window_decoration {
+
+static bool SameRect(const Rect& a, const Rect& b) {
+    return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+}
+
+static int Lerp(int from, int to, double progress) {
+    return from + static_cast<int>(std::lround((to - from) * progress));
+}
+
+// Origin and size are interpolated separately, so a pure move never
+// changes the size through rounding
+static Rect LerpRect(const Rect& from, const Rect& to, double progress) {
+    int left = Lerp(from.left, to.left, progress);
+    int top = Lerp(from.top, to.top, progress);
+    int width = Lerp(from.right - from.left, to.right - to.left, progress);
+    int height = Lerp(from.bottom - from.top, to.bottom - to.top, progress);
+    return { left, top, left + width, top + height };
+}
+
+double EvaluateCurve(AnimationCurve curve, double t) {
+    t = std::min(1.0, std::max(0.0, t));
+    switch (curve) {
+        case AnimationCurve::Linear:
+            return t;
+        case AnimationCurve::EaseIn:
+            return t * t * t;
+        case AnimationCurve::EaseOut: {
+            double u = 1.0 - t;
+            return 1.0 - u * u * u;
+        }
+        case AnimationCurve::EaseInOut: {
+            if (t < 0.5) {
+                return 4.0 * t * t * t;
+            }
+            double u = 2.0 - 2.0 * t;
+            return 1.0 - u * u * u / 2.0;
+        }
+    }
+    return t;
+}
+
+WindowAnimation::WindowAnimation()
+    : running_(false),
+      properties_(0),
+      curve_(AnimationCurve::Linear),
+      durationNs_(0),
+      startNs_(-1),
+      lastFrameNs_(0),
+      fromBounds_(),
+      toBounds_(),
+      bounds_(),
+      fromOpacity_(1.0),
+      toOpacity_(1.0),
+      opacity_(1.0),
+      stats_() {}
+
+bool WindowAnimation::Start(const WindowAnimationParams& params, const Rect& bounds, double opacity) {
+    const uint32_t allProperties = ANIMATE_BOUNDS | ANIMATE_OPACITY;
+    if (params.properties == 0 || (params.properties & ~allProperties) != 0 ||
+        params.curve < static_cast<int32_t>(AnimationCurve::Linear) ||
+        params.curve > static_cast<int32_t>(AnimationCurve::EaseInOut) || params.durationNs < 0) {
+        return false;
+    }
+    if ((params.properties & ANIMATE_BOUNDS) &&
+        (params.bounds.right <= params.bounds.left || params.bounds.bottom <= params.bounds.top)) {
+        return false;
+    }
+
+    if (running_) {
+        stats_.cancelled++;
+    }
+    stats_.started++;
+    running_ = true;
+    properties_ = params.properties;
+    curve_ = static_cast<AnimationCurve>(params.curve);
+    durationNs_ = params.durationNs;
+    startNs_ = -1;
+
+    fromBounds_ = bounds;
+    bounds_ = bounds;
+    toBounds_ = (params.properties & ANIMATE_BOUNDS) ? params.bounds : bounds;
+    fromOpacity_ = opacity;
+    opacity_ = opacity;
+    toOpacity_ = (params.properties & ANIMATE_OPACITY) ? std::min(1.0, std::max(0.0, params.opacity)) : opacity;
+    return true;
+}
+
+bool WindowAnimation::Cancel() {
+    if (!running_) {
+        return false;
+    }
+    running_ = false;
+    stats_.cancelled++;
+    return true;
+}
+
+bool WindowAnimation::Step(int64_t frameTimeNs, int64_t refreshIntervalNs, WindowAnimationFrame* frame) {
+    if (!running_) {
+        return false;
+    }
+
+    if (startNs_ < 0) {
+        startNs_ = frameTimeNs - refreshIntervalNs;
+    } else if (refreshIntervalNs > 0) {
+        // Refreshes between this frame and the previous one, rounded
+        int64_t intervals = (frameTimeNs - lastFrameNs_ + refreshIntervalNs / 2) / refreshIntervalNs;
+        if (intervals > 1) {
+            stats_.droppedFrames += static_cast<uint64_t>(intervals - 1);
+        }
+    }
+    lastFrameNs_ = frameTimeNs;
+    stats_.frames++;
+
+    int64_t elapsed = frameTimeNs - startNs_;
+    bool finished = elapsed >= durationNs_;
+    Rect bounds = toBounds_;
+    double opacity = toOpacity_;
+    if (!finished) {
+        double progress = EvaluateCurve(curve_, static_cast<double>(elapsed) / static_cast<double>(durationNs_));
+        bounds = LerpRect(fromBounds_, toBounds_, progress);
+        opacity = fromOpacity_ + (toOpacity_ - fromOpacity_) * progress;
+    }
+
+    Emit(bounds, opacity, finished, frame);
+    return true;
+}
+
+bool WindowAnimation::Finish(WindowAnimationFrame* frame) {
+    if (!running_) {
+        return false;
+    }
+    Emit(toBounds_, toOpacity_, true, frame);
+    return true;
+}
+
+void WindowAnimation::Emit(const Rect& bounds, double opacity, bool finished, WindowAnimationFrame* frame) {
+    frame->changed = 0;
+    if ((properties_ & ANIMATE_BOUNDS) && !SameRect(bounds, bounds_)) {
+        frame->changed |= ANIMATE_BOUNDS;
+    }
+    if ((properties_ & ANIMATE_OPACITY) && opacity != opacity_) {
+        frame->changed |= ANIMATE_OPACITY;
+    }
+    frame->bounds = bounds;
+    frame->opacity = opacity;
+    frame->finished = finished;
+    bounds_ = bounds;
+    opacity_ = opacity;
+
+    if (finished) {
+        running_ = false;
+        stats_.completed++;
+    }
+}
+
+}  // namespace window_decoration
@@ -0,0 +1,150 @@
+// Window Decoration Core - Window event stream implementation
+
+#include "window_decoration_core/window_event_stream.h"
+
+#include <utility>
+
+namespace window_decoration {
+
+bool IsCoalescable(WindowEventType type) {
+    switch (type) {
+        case WindowEventType::Moved:
+        case WindowEventType::Resized:
+        case WindowEventType::DpiChanged:
+        case WindowEventType::FocusChanged:
+        case WindowEventType::ThemeChanged:
+            return true;
+        default:
+            return false;
+    }
+}
+
+size_t CoalesceWindowEvents(WindowEvent* events, size_t count) {
+    // Walk backwards so the latest event of each (window, type) is seen
+    // first; earlier ones are marked by clearing their type. A batch holds
+    // a handful of distinct keys, so a linear list beats hashing.
+    struct Key {
+        uint64_t window;
+        WindowEventType type;
+    };
+    Key seen[32];
+    size_t seenCount = 0;
+    size_t dropped = 0;
+
+    for (size_t i = count; i > 0; i--) {
+        WindowEvent& event = events[i - 1];
+        if (!IsCoalescable(event.type)) {
+            continue;
+        }
+
+        bool superseded = false;
+        for (size_t k = 0; k < seenCount; k++) {
+            if (seen[k].window == event.window && seen[k].type == event.type) {
+                superseded = true;
+                break;
+            }
+        }
+        if (superseded) {
+            event.type = static_cast<WindowEventType>(0);
+            dropped++;
+        } else if (seenCount < sizeof(seen) / sizeof(seen[0])) {
+            seen[seenCount++] = { event.window, event.type };
+        }
+    }
+
+    if (dropped == 0) {
+        return count;
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (events[i].type != static_cast<WindowEventType>(0)) {
+            events[kept++] = events[i];
+        }
+    }
+    return kept;
+}
+
+WindowEventStream::WindowEventStream(DeliverFn deliver, std::chrono::nanoseconds frameInterval)
+    : deliver_(std::move(deliver)),
+      frameInterval_(frameInterval),
+      sleeping_(false),
+      stop_(false),
+      pushed_(0),
+      dropped_(0),
+      delivered_(0),
+      coalesced_(0),
+      batches_(0),
+      batch_(kCapacity) {
+    thread_ = std::thread([this]() { Run(); });
+}
+
+WindowEventStream::~WindowEventStream() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+bool WindowEventStream::Push(const WindowEvent& event) {
+    if (!ring_.TryPush(event)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    pushed_.fetch_add(1, std::memory_order_relaxed);
+
+    // Pairs with the fence in Run(): either the delivery thread sees the
+    // new event before it waits, or this sees it sleeping and wakes it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed)) {
+        { std::lock_guard<std::mutex> lock(mutex_); }
+        wake_.notify_one();
+    }
+    return true;
+}
+
+WindowEventStats WindowEventStream::stats() const {
+    WindowEventStats stats;
+    stats.pushed = pushed_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    stats.delivered = delivered_.load(std::memory_order_relaxed);
+    stats.coalesced = coalesced_.load(std::memory_order_relaxed);
+    stats.batches = batches_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void WindowEventStream::Run() {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point nextDelivery = Clock::now();
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            sleeping_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            wake_.wait(lock, [this]() { return stop_ || !ring_.empty(); });
+            sleeping_.store(false, std::memory_order_relaxed);
+            if (stop_) return;
+
+            // Pace to one delivery per frame; the producer doesn't notify
+            // while sleeping_ is clear, so only a stop ends this early
+            if (Clock::now() < nextDelivery) {
+                wake_.wait_until(lock, nextDelivery, [this]() { return stop_; });
+                if (stop_) return;
+            }
+        }
+
+        size_t count = ring_.PopAll(batch_.data(), batch_.size());
+        size_t kept = CoalesceWindowEvents(batch_.data(), count);
+        deliver_(batch_.data(), kept);
+
+        delivered_.fetch_add(kept, std::memory_order_relaxed);
+        coalesced_.fetch_add(count - kept, std::memory_order_relaxed);
+        batches_.fetch_add(1, std::memory_order_relaxed);
+        nextDelivery = Clock::now() + frameInterval_;
+    }
+}
+
+}  // namespace window_decoration
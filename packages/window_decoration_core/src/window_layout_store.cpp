@@ -0,0 +1,204 @@
+// Window Decoration Core - Window layout store implementation
+
+#include "window_decoration_core/window_layout_store.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "window_decoration_core/window_placement.h"
+
+namespace window_decoration {
+
+namespace {
+
+struct FileHeader {
+    uint32_t magic;
+    uint16_t majorVersion;
+    uint16_t minorVersion;
+    uint32_t headerSize;
+    uint32_t recordSize;
+    uint32_t recordCount;
+    uint32_t checksum;
+};
+
+// FNV-1a, continuing from hash
+uint32_t Fnv1a(const void* data, size_t size, uint32_t hash = 2166136261u) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// First record whose id is not less than id
+template <typename Records>
+auto LowerBound(Records& records, const char* id) -> decltype(records.begin()) {
+    return std::lower_bound(records.begin(), records.end(), id,
+                            [](const auto& record, const char* key) { return std::strcmp(record.id, key) < 0; });
+}
+
+bool Intersects(const Rect& a, const Rect& b) {
+    return a.left < b.right && b.left < a.right && a.top < b.bottom && b.top < a.bottom;
+}
+
+}  // namespace
+
+uint64_t MonitorFingerprint(const MonitorInfo& monitor) {
+    const int32_t fields[] = { monitor.bounds.left, monitor.bounds.top, monitor.bounds.right, monitor.bounds.bottom,
+                               static_cast<int32_t>(monitor.dpi) };
+    // Two chained 32-bit hashes; 0 is left for "unknown"
+    uint32_t high = Fnv1a(fields, sizeof(fields));
+    uint32_t low = Fnv1a(fields, sizeof(fields), high);
+    uint64_t fingerprint = (static_cast<uint64_t>(high) << 32) | low;
+    return fingerprint != 0 ? fingerprint : 1;
+}
+
+LayoutRestore ResolveWindowLayout(const MonitorTopology& topology, const WindowLayout& layout, Rect* bounds) {
+    if (topology.size() == 0) {
+        return LayoutRestore::None;
+    }
+
+    for (size_t i = 0; i < topology.size(); i++) {
+        if (MonitorFingerprint(topology.monitor(static_cast<int>(i))) == layout.monitor) {
+            *bounds = layout.bounds;
+            return LayoutRestore::Exact;
+        }
+    }
+
+    int index = topology.FindForRect(layout.bounds);
+    if (index != MonitorTopology::kNone && Intersects(topology.monitor(index).bounds, layout.bounds)) {
+        *bounds = ClampToWorkArea(topology.monitor(index).workArea, layout.bounds);
+    } else {
+        const Rect& workArea = topology.monitor(topology.primary()).workArea;
+        Rect centered = CenterInWorkArea(workArea, layout.bounds.right - layout.bounds.left,
+                                         layout.bounds.bottom - layout.bounds.top);
+        *bounds = ClampToWorkArea(workArea, centered);
+    }
+    return LayoutRestore::Fallback;
+}
+
+WindowLayoutStore::WindowLayoutStore() : records_(), dirty_(false) {}
+
+bool WindowLayoutStore::Load(const void* image, size_t size) {
+    Clear();
+    if (size == 0) {
+        return true;
+    }
+
+    FileHeader header;
+    if (image == nullptr || size < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, image, sizeof(header));
+    if (header.magic != WINDOW_LAYOUT_MAGIC || header.majorVersion != WINDOW_LAYOUT_MAJOR_VERSION ||
+        header.headerSize < sizeof(header) || header.recordSize < sizeof(Record) ||
+        header.recordCount > MAX_WINDOW_LAYOUTS ||
+        size < header.headerSize + static_cast<size_t>(header.recordSize) * header.recordCount) {
+        return false;
+    }
+
+    const unsigned char* records = static_cast<const unsigned char*>(image) + header.headerSize;
+    size_t recordBytes = static_cast<size_t>(header.recordSize) * header.recordCount;
+    if (Fnv1a(records, recordBytes) != header.checksum) {
+        return false;
+    }
+
+    records_.resize(header.recordCount);
+    for (uint32_t i = 0; i < header.recordCount; i++) {
+        Record& record = records_[i];
+        std::memcpy(&record, records + static_cast<size_t>(i) * header.recordSize, sizeof(Record));
+        // Ids are terminated, non-empty and strictly ascending
+        if (record.id[MAX_WINDOW_LAYOUT_ID_BYTES] != '\0' || record.id[0] == '\0' ||
+            (i > 0 && std::strcmp(records_[i - 1].id, record.id) >= 0)) {
+            Clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void WindowLayoutStore::Clear() {
+    records_.clear();
+    dirty_ = false;
+}
+
+bool WindowLayoutStore::Find(const char* id, WindowLayout* layout) const {
+    if (id == nullptr) {
+        return false;
+    }
+    auto it = LowerBound(records_, id);
+    if (it == records_.end() || std::strcmp(it->id, id) != 0) {
+        return false;
+    }
+    *layout = it->layout;
+    return true;
+}
+
+bool WindowLayoutStore::Put(const char* id, const WindowLayout& layout) {
+    if (id == nullptr || id[0] == '\0' || std::strlen(id) > MAX_WINDOW_LAYOUT_ID_BYTES) {
+        return false;
+    }
+    auto it = LowerBound(records_, id);
+    if (it != records_.end() && std::strcmp(it->id, id) == 0) {
+        if (std::memcmp(&it->layout, &layout, sizeof(layout)) != 0) {
+            it->layout = layout;
+            dirty_ = true;
+        }
+        return true;
+    }
+    if (records_.size() >= MAX_WINDOW_LAYOUTS) {
+        return false;
+    }
+
+    // Zero the id padding so equal stores encode to equal files
+    Record record;
+    std::memset(&record, 0, sizeof(record));
+    std::memcpy(record.id, id, std::strlen(id));
+    record.layout = layout;
+    records_.insert(it, record);
+    dirty_ = true;
+    return true;
+}
+
+bool WindowLayoutStore::Remove(const char* id) {
+    if (id == nullptr) {
+        return false;
+    }
+    auto it = LowerBound(records_, id);
+    if (it == records_.end() || std::strcmp(it->id, id) != 0) {
+        return false;
+    }
+    records_.erase(it);
+    dirty_ = true;
+    return true;
+}
+
+size_t WindowLayoutStore::EncodedSize() const {
+    return sizeof(FileHeader) + records_.size() * sizeof(Record);
+}
+
+size_t WindowLayoutStore::Encode(void* image, size_t capacity) const {
+    size_t size = EncodedSize();
+    if (image == nullptr || capacity < size) {
+        return 0;
+    }
+
+    unsigned char* bytes = static_cast<unsigned char*>(image);
+    size_t recordBytes = records_.size() * sizeof(Record);
+    if (recordBytes != 0) {
+        std::memcpy(bytes + sizeof(FileHeader), records_.data(), recordBytes);
+    }
+
+    FileHeader header;
+    header.magic = WINDOW_LAYOUT_MAGIC;
+    header.majorVersion = WINDOW_LAYOUT_MAJOR_VERSION;
+    header.minorVersion = WINDOW_LAYOUT_MINOR_VERSION;
+    header.headerSize = sizeof(FileHeader);
+    header.recordSize = sizeof(Record);
+    header.recordCount = static_cast<uint32_t>(records_.size());
+    header.checksum = Fnv1a(bytes + sizeof(FileHeader), recordBytes);
+    std::memcpy(bytes, &header, sizeof(header));
+    return size;
+}
+
+}  // namespace window_decoration
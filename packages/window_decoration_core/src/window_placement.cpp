@@ -0,0 +1,61 @@
+// Window Decoration Core - Window placement implementation
+
+#include "window_decoration_core/window_placement.h"
+
+#include <algorithm>
+
+namespace window_decoration {
+
+Rect CenterInWorkArea(const Rect& workArea, int width, int height) {
+    int left = workArea.left + std::max(0, (workArea.right - workArea.left - width) / 2);
+    int top = workArea.top + std::max(0, (workArea.bottom - workArea.top - height) / 2);
+    return { left, top, left + width, top + height };
+}
+
+Rect ClampToWorkArea(const Rect& workArea, const Rect& window) {
+    int width = std::min(window.right - window.left, workArea.right - workArea.left);
+    int height = std::min(window.bottom - window.top, workArea.bottom - workArea.top);
+    int left = std::max(workArea.left, std::min(window.left, workArea.right - width));
+    int top = std::max(workArea.top, std::min(window.top, workArea.bottom - height));
+    return { left, top, left + width, top + height };
+}
+
+Rect CascadeInWorkArea(const Rect& workArea, const Rect& anchor, int width, int height, int step) {
+    int left = anchor.left + step;
+    int top = anchor.top + step;
+    if (left < workArea.left || left + width > workArea.right) {
+        left = workArea.left;
+    }
+    if (top < workArea.top || top + height > workArea.bottom) {
+        top = workArea.top;
+    }
+    return ClampToWorkArea(workArea, { left, top, left + width, top + height });
+}
+
+bool SolvePlacement(const MonitorTopology& topology, PlacementMode mode, const Rect& window, const Rect& anchor,
+                    bool scaleStep, Rect* result) {
+    int index = topology.FindForRect(mode == PlacementMode::Cascade ? anchor : window);
+    if (index == MonitorTopology::kNone) {
+        return false;
+    }
+
+    const MonitorInfo& monitor = topology.monitor(index);
+    int width = window.right - window.left;
+    int height = window.bottom - window.top;
+    switch (mode) {
+        case PlacementMode::Center:
+            *result = CenterInWorkArea(monitor.workArea, width, height);
+            return true;
+        case PlacementMode::ClampToWorkArea:
+            *result = ClampToWorkArea(monitor.workArea, window);
+            return true;
+        case PlacementMode::Cascade: {
+            int step = scaleStep ? ScaleForDpi(CASCADE_STEP, monitor.dpi) : CASCADE_STEP;
+            *result = CascadeInWorkArea(monitor.workArea, anchor, width, height, step);
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace window_decoration
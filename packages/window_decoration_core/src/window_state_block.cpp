@@ -0,0 +1,92 @@
+// Window Decoration Core - Window state block implementation
+
+#include "window_decoration_core/window_state_block.h"
+
+#include <cstring>
+#include <thread>
+
+namespace window_decoration {
+
+namespace {
+
+static_assert(sizeof(WindowStateInfo) % sizeof(uint32_t) == 0, "payload must be whole words");
+
+// Give up on a block that stays mid-write this many times in a row
+constexpr int kMaxReadRetries = 1024;
+
+}  // namespace
+
+void PublishWindowState(WindowStateBlock* block, uint64_t window, const WindowStateInfo& info) {
+    uint32_t words[WINDOW_STATE_BLOCK_WORDS];
+    std::memcpy(words, &window, sizeof(window));
+    std::memcpy(words + sizeof(window) / sizeof(uint32_t), &info, sizeof(info));
+
+    // Seqlock write: odd sequence while the payload is being stored
+    uint32_t start = block->sequence.load(std::memory_order_relaxed);
+    block->sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (uint32_t i = 0; i < WINDOW_STATE_BLOCK_WORDS; i++) {
+        block->payload[i].store(words[i], std::memory_order_relaxed);
+    }
+    block->sequence.store(start + 2, std::memory_order_release);
+}
+
+bool ReadWindowState(const WindowStateBlock& block, uint64_t* window, WindowStateInfo* info) {
+    uint32_t words[WINDOW_STATE_BLOCK_WORDS];
+    for (int attempt = 0; attempt < kMaxReadRetries; attempt++) {
+        uint32_t start = block.sequence.load(std::memory_order_acquire);
+        if (start & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (uint32_t i = 0; i < WINDOW_STATE_BLOCK_WORDS; i++) {
+            words[i] = block.payload[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (block.sequence.load(std::memory_order_relaxed) == start) {
+            std::memcpy(window, words, sizeof(*window));
+            std::memcpy(info, words + sizeof(*window) / sizeof(uint32_t), sizeof(*info));
+            return *window != 0;
+        }
+    }
+    return false;
+}
+
+WindowStateBlock* WindowStateBlockPool::Acquire(uint64_t window) {
+    WindowStateBlock* block;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_.empty()) {
+            // Value-initialized: sequence 0, payload all zero
+            chunks_.emplace_back(new WindowStateBlock[kChunkBlocks]());
+            for (size_t i = kChunkBlocks; i > 0; i--) {
+                free_.push_back(&chunks_.back()[i - 1]);
+            }
+        }
+        block = free_.back();
+        free_.pop_back();
+    }
+
+    PublishWindowState(block, window, WindowStateInfo());
+    return block;
+}
+
+void WindowStateBlockPool::Release(WindowStateBlock* block) {
+    if (block == nullptr) {
+        return;
+    }
+
+    // Unpublish before reuse, so a stale reader sees window 0 rather than
+    // the old window's last state
+    PublishWindowState(block, 0, WindowStateInfo());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push_back(block);
+}
+
+size_t WindowStateBlockPool::allocated() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return chunks_.size() * kChunkBlocks;
+}
+
+}  // namespace window_decoration
@@ -0,0 +1,211 @@
+// Window Decoration Core - Batch hit test test
+// Checks that HitTestBatch agrees with the per-point hit testers at every
+// instruction set level the CPU supports, in every frame mode, and for
+// counts that leave a scalar tail after the 4- and 8-lane kernels.
+
+#include "window_decoration_core/batch_hit_test.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "test_util.h"
+#include "window_decoration_core/caption_mask.h"
+#include "window_decoration_core/caption_regions.h"
+
+using namespace window_decoration;
+
+namespace {
+
+const SimdLevel kLevels[] = { SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2 };
+const FrameMode kModes[] = { FrameMode::Normal, FrameMode::Hidden, FrameMode::CustomFrame };
+
+HitCode ExpectedHit(int x, int y, const FrameGeometry& geometry, FrameMode mode,
+                    const CaptionLayout& caption, const CaptionRegionIndex* regions,
+                    const CaptionMask* mask) {
+    switch (mode) {
+        case FrameMode::CustomFrame:
+            return HitTestCustomFrame(x, y, geometry, caption, regions, mask);
+        case FrameMode::Hidden:
+            return HitTestHiddenFrame(x, y, geometry);
+        case FrameMode::Normal:
+            break;
+    }
+    return HitCode::Client;
+}
+
+FrameGeometry MakeGeometry(unsigned int dpi, bool maximized) {
+    int border = static_cast<int>(8 * dpi / 96);
+    FrameGeometry geometry = {};
+    geometry.windowWidth = 1280;
+    geometry.windowHeight = 800;
+    geometry.borderWidth = border;
+    geometry.borderHeight = border;
+    geometry.clientLeft = maximized ? 0 : border;
+    geometry.clientTop = 0;
+    geometry.dpi = dpi;
+    geometry.isMaximized = maximized;
+    return geometry;
+}
+
+CaptionLayout MakeCaption(bool buttons) {
+    CaptionLayout caption = {};
+    caption.captionHeight = 32;
+    caption.minimizeButton = { 1134, 0, 1180, 48 };
+    caption.maximizeButton = { 1180, 0, 1226, 48 };
+    caption.closeButton = { 1226, 0, 1272, 48 };
+    caption.hasCaptionButtons = buttons;
+    return caption;
+}
+
+// Batch every prefix of `xs`/`ys` up to `maxCount` points at every level and
+// compare each result with the per-point hit tester
+void ExpectBatchMatches(const std::vector<int32_t>& xs, const std::vector<int32_t>& ys,
+                        size_t maxCount, const FrameGeometry& geometry, FrameMode mode,
+                        const CaptionLayout& caption, const CaptionRegionIndex* regions,
+                        const CaptionMask* mask) {
+    std::vector<HitCode> results(xs.size());
+    for (SimdLevel level : kLevels) {
+        for (size_t count = 0; count <= maxCount; count++) {
+            // Sentinels past the end catch a kernel writing beyond `count`
+            std::fill(results.begin(), results.end(), HitCode::Nowhere);
+            HitTestBatch(xs.data(), ys.data(), count, geometry, mode, caption, regions, mask,
+                         results.data(), level);
+
+            int mismatches = 0;
+            for (size_t i = 0; i < count; i++) {
+                HitCode expected = ExpectedHit(xs[i], ys[i], geometry, mode, caption, regions, mask);
+                mismatches += results[i] != expected ? 1 : 0;
+            }
+            for (size_t i = count; i < results.size(); i++) {
+                mismatches += results[i] != HitCode::Nowhere ? 1 : 0;
+            }
+            WD_EXPECT_EQ(mismatches, 0);
+        }
+    }
+}
+
+// Points concentrated on the borders, the caption and the caption buttons
+void MakePoints(std::mt19937& random, const FrameGeometry& geometry, size_t count,
+                std::vector<int32_t>* xs, std::vector<int32_t>* ys) {
+    std::uniform_int_distribution<int> anyX(-4, geometry.windowWidth + 4);
+    std::uniform_int_distribution<int> anyY(-4, geometry.windowHeight + 4);
+    std::uniform_int_distribution<int> captionY(-2, 70);
+    std::uniform_int_distribution<int> edge(-3, 20);
+    xs->resize(count);
+    ys->resize(count);
+    for (size_t i = 0; i < count; i++) {
+        switch (i % 4) {
+            case 0:
+                (*xs)[i] = anyX(random);
+                (*ys)[i] = captionY(random);
+                break;
+            case 1:
+                (*xs)[i] = geometry.windowWidth - edge(random);
+                (*ys)[i] = anyY(random);
+                break;
+            case 2:
+                (*xs)[i] = edge(random);
+                (*ys)[i] = geometry.windowHeight - edge(random);
+                break;
+            default:
+                (*xs)[i] = anyX(random);
+                (*ys)[i] = anyY(random);
+                break;
+        }
+    }
+}
+
+void TestSupportedLevel() {
+    SimdLevel supported = SupportedSimdLevel();
+    WD_EXPECT(supported >= SimdLevel::Scalar && supported <= SimdLevel::Avx2);
+    WD_EXPECT_EQ(SupportedSimdLevel(), supported);
+}
+
+// Every mode, maximized or not, at several scales, for all counts up to
+// three full AVX2 blocks plus a tail
+void TestAllModesAndTails() {
+    std::mt19937 random(1);
+    const unsigned int dpis[] = { 96, 120, 144, 192 };
+    for (unsigned int dpi : dpis) {
+        for (int maximized = 0; maximized < 2; maximized++) {
+            FrameGeometry geometry = MakeGeometry(dpi, maximized != 0);
+            std::vector<int32_t> xs;
+            std::vector<int32_t> ys;
+            MakePoints(random, geometry, 40, &xs, &ys);
+            for (FrameMode mode : kModes) {
+                for (int buttons = 0; buttons < 2; buttons++) {
+                    ExpectBatchMatches(xs, ys, 31, geometry, mode, MakeCaption(buttons != 0),
+                                       nullptr, nullptr);
+                }
+            }
+        }
+    }
+}
+
+// Named regions and the caption mask are resolved after the kernels
+void TestRegionsAndMask() {
+    CaptionRegionIndex regions;
+    WD_EXPECT(regions.Set("tabs", { { 80, 0, 600, 48 }, HitCode::Client, 6 }));
+    WD_EXPECT(regions.Set("search", { { 700, 8, 1000, 40 }, HitCode::Client, 16 }));
+    WD_EXPECT(regions.Set("menu", { { 0, 0, 60, 48 }, HitCode::MaxButton, 0 }));
+
+    std::vector<uint16_t> runs;
+    for (int row = 0; row < 40; row++) {
+        uint16_t rowRuns[] = { 3, 700, 40, 100 };
+        runs.insert(runs.end(), rowRuns, rowRuns + 4);
+    }
+    CaptionMask mask;
+    WD_EXPECT(mask.Set(840, 40, runs.data(), runs.size()));
+
+    std::mt19937 random(2);
+    const unsigned int dpis[] = { 96, 144 };
+    for (unsigned int dpi : dpis) {
+        FrameGeometry geometry = MakeGeometry(dpi, false);
+        std::vector<int32_t> xs;
+        std::vector<int32_t> ys;
+        MakePoints(random, geometry, 4099, &xs, &ys);
+        CaptionLayout caption = MakeCaption(true);
+
+        ExpectBatchMatches(xs, ys, 19, geometry, FrameMode::CustomFrame, caption, &regions, &mask);
+        ExpectBatchMatches(xs, ys, 19, geometry, FrameMode::CustomFrame, caption, &regions, nullptr);
+        ExpectBatchMatches(xs, ys, 19, geometry, FrameMode::CustomFrame, caption, nullptr, &mask);
+
+        // One long batch, which runs almost entirely through the kernels
+        std::vector<HitCode> results(xs.size());
+        for (SimdLevel level : kLevels) {
+            HitTestBatch(xs.data(), ys.data(), xs.size(), geometry, FrameMode::CustomFrame, caption,
+                         &regions, &mask, results.data(), level);
+            int mismatches = 0;
+            for (size_t i = 0; i < xs.size(); i++) {
+                HitCode expected = HitTestCustomFrame(xs[i], ys[i], geometry, caption, &regions, &mask);
+                mismatches += results[i] != expected ? 1 : 0;
+            }
+            WD_EXPECT_EQ(mismatches, 0);
+        }
+    }
+}
+
+// Tiny windows where the borders overlap and cover the whole window
+void TestTinyWindow() {
+    std::mt19937 random(3);
+    FrameGeometry geometry = MakeGeometry(192, false);
+    geometry.windowWidth = 20;
+    geometry.windowHeight = 12;
+    std::vector<int32_t> xs;
+    std::vector<int32_t> ys;
+    MakePoints(random, geometry, 64, &xs, &ys);
+    for (FrameMode mode : kModes) {
+        ExpectBatchMatches(xs, ys, 64, geometry, mode, MakeCaption(true), nullptr, nullptr);
+    }
+}
+
+}  // namespace
+
+int main() {
+    TestSupportedLevel();
+    TestAllModesAndTails();
+    TestRegionsAndMask();
+    TestTinyWindow();
+    return test::TestExitCode();
+}
@@ -0,0 +1,157 @@
+// Window Decoration Core - Capability probe test
+// Checks that a CapabilityProbe runs its probe exactly once while many
+// threads ask for the capabilities at the same time, that every thread
+// sees the probed result through the same reference, and that separate
+// probes don't share state. Also checks ParseOsVersion on kernel and
+// Windows style versions and the NET_WM_* bits against the atom names.
+
+#include "window_decoration_core/platform_capabilities.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace window_decoration;
+
+namespace {
+
+std::atomic<int> g_probes(0);
+
+// Stand-in for a backend probe: slow enough that the racing threads all
+// arrive while it runs
+void SlowProbe(PlatformCapabilities* capabilities) {
+    g_probes.fetch_add(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    capabilities->flags = CAPABILITY_WINDOW_DPI | CAPABILITY_COMPOSITOR;
+    capabilities->netWmAtoms = NET_WM_STATE | NET_WM_STATE_ABOVE;
+    capabilities->osMajor = 10;
+    capabilities->osBuild = 22631;
+}
+
+bool Parses(const char* release, bool valid, uint32_t major, uint32_t minor, uint32_t build) {
+    uint32_t parsedMajor = 1;
+    uint32_t parsedMinor = 1;
+    uint32_t parsedBuild = 1;
+    bool parsed = ParseOsVersion(release, &parsedMajor, &parsedMinor, &parsedBuild);
+    return parsed == valid && parsedMajor == major && parsedMinor == minor && parsedBuild == build;
+}
+
+void TestParseOsVersion() {
+    WD_EXPECT(Parses("6.8.0-45-generic", true, 6, 8, 0));
+    WD_EXPECT(Parses("6.18.44-fc-v130", true, 6, 18, 44));
+    WD_EXPECT(Parses("10.0.22631", true, 10, 0, 22631));
+    WD_EXPECT(Parses("5.15", true, 5, 15, 0));
+    WD_EXPECT(Parses("7", true, 7, 0, 0));
+    WD_EXPECT(Parses("4.", true, 4, 0, 0));
+    WD_EXPECT(Parses("4..5", true, 4, 0, 0));
+    WD_EXPECT(Parses("1.2.3.4", true, 1, 2, 3));
+    WD_EXPECT(Parses("3.1-rc2", true, 3, 1, 0));
+
+    // Numbers saturate instead of wrapping
+    WD_EXPECT(Parses("4294967295.1", true, UINT32_MAX, 1, 0));
+    WD_EXPECT(Parses("4294967296.1", true, UINT32_MAX, 1, 0));
+    WD_EXPECT(Parses("99999999999.1.99999999999999999999", true, UINT32_MAX, 1, UINT32_MAX));
+
+    // Anything not starting with a digit is rejected and zeroes the output
+    WD_EXPECT(Parses("", false, 0, 0, 0));
+    WD_EXPECT(Parses("v6.1", false, 0, 0, 0));
+    WD_EXPECT(Parses(".6.1", false, 0, 0, 0));
+    WD_EXPECT(Parses(" 6.1", false, 0, 0, 0));
+    WD_EXPECT(Parses(nullptr, false, 0, 0, 0));
+}
+
+// NET_WM_* bit i stands for NET_WM_ATOM_NAMES[i]
+void TestNetWmAtoms() {
+    WD_EXPECT_EQ(NET_WM_ATOM_COUNT, 12u);
+    const struct {
+        uint32_t bit;
+        const char* name;
+    } atoms[] = {
+        { NET_WM_STATE, "_NET_WM_STATE" },
+        { NET_WM_STATE_ABOVE, "_NET_WM_STATE_ABOVE" },
+        { NET_WM_STATE_SKIP_TASKBAR, "_NET_WM_STATE_SKIP_TASKBAR" },
+        { NET_WM_STATE_FULLSCREEN, "_NET_WM_STATE_FULLSCREEN" },
+        { NET_WM_STATE_MAXIMIZED_VERT, "_NET_WM_STATE_MAXIMIZED_VERT" },
+        { NET_WM_STATE_MAXIMIZED_HORZ, "_NET_WM_STATE_MAXIMIZED_HORZ" },
+        { NET_WM_STATE_HIDDEN, "_NET_WM_STATE_HIDDEN" },
+        { NET_WM_MOVERESIZE, "_NET_WM_MOVERESIZE" },
+        { NET_WM_WINDOW_OPACITY, "_NET_WM_WINDOW_OPACITY" },
+        { NET_WM_FRAME_EXTENTS, "_NET_FRAME_EXTENTS" },
+        { NET_WM_WORKAREA, "_NET_WORKAREA" },
+        { NET_WM_ACTIVE_WINDOW, "_NET_ACTIVE_WINDOW" },
+    };
+    for (const auto& atom : atoms) {
+        size_t index = 0;
+        while ((1u << index) != atom.bit && index < 32) {
+            index++;
+        }
+        WD_EXPECT(index < NET_WM_ATOM_COUNT && std::strcmp(NET_WM_ATOM_NAMES[index], atom.name) == 0);
+    }
+}
+
+// Many first callers at once: one probe, one result
+void TestProbeRunsOnce() {
+    CapabilityProbe probe;
+    const int kThreads = 16;
+    std::atomic<bool> go(false);
+    std::atomic<int> mismatches(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; t++) {
+        threads.emplace_back([&]() {
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+            const PlatformCapabilities& capabilities = probe.Get(SlowProbe);
+            if (capabilities.flags != (CAPABILITY_WINDOW_DPI | CAPABILITY_COMPOSITOR) ||
+                capabilities.netWmAtoms != (NET_WM_STATE | NET_WM_STATE_ABOVE) ||
+                capabilities.osBuild != 22631 || &capabilities != &probe.Get(SlowProbe)) {
+                mismatches.fetch_add(1);
+            }
+        });
+    }
+    go.store(true);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    WD_EXPECT_EQ(g_probes.load(), 1);
+    WD_EXPECT_EQ(mismatches.load(), 0);
+
+    // Later calls never probe again, whatever they pass
+    int otherProbes = 0;
+    const PlatformCapabilities& capabilities = probe.Get([&](PlatformCapabilities*) { otherProbes++; });
+    WD_EXPECT_EQ(otherProbes, 0);
+    WD_EXPECT_EQ(capabilities.osMajor, 10u);
+    WD_EXPECT_EQ(g_probes.load(), 1);
+}
+
+// Each probe object runs its own probe, starting from zeroed capabilities
+void TestSeparateProbes() {
+    CapabilityProbe first;
+    CapabilityProbe second;
+    const PlatformCapabilities& a = first.Get([](PlatformCapabilities* capabilities) {
+        capabilities->flags = CAPABILITY_X11;
+    });
+    const PlatformCapabilities& b = second.Get([](PlatformCapabilities* capabilities) {
+        capabilities->toolkitMajor = 3;
+    });
+    WD_EXPECT(&a != &b);
+    WD_EXPECT_EQ(a.flags, CAPABILITY_X11);
+    WD_EXPECT_EQ(a.toolkitMajor, 0u);
+    WD_EXPECT_EQ(b.flags, 0u);
+    WD_EXPECT_EQ(b.toolkitMajor, 3u);
+    WD_EXPECT(b.functions == nullptr && b.functionsSize == 0);
+}
+
+}  // namespace
+
+int main() {
+    TestParseOsVersion();
+    TestNetWmAtoms();
+    TestProbeRunsOnce();
+    TestSeparateProbes();
+    return test::TestExitCode();
+}
@@ -0,0 +1,320 @@
+// Window Decoration Core - Caption mask test
+// Checks Set(), UpdateRows() and Lookup() against a brute-force bitmap of
+// the same run-length rows, at 96 DPI and at scales that don't divide
+// evenly, and that malformed or out-of-range input leaves the mask as it
+// was.
+
+#include "window_decoration_core/caption_mask.h"
+
+#include <random>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace window_decoration;
+
+namespace {
+
+// Reference mask: one bool per logical pixel, true for interactive
+struct Bitmap {
+    int width = 0;
+    int height = 0;
+    std::vector<bool> pixels;
+
+    bool At(int x, int y) const { return pixels[static_cast<size_t>(y) * width + x]; }
+};
+
+// Append one encoded row to `runs` and paint it into row `y` of `bitmap`
+void AddRow(std::mt19937& random, int y, std::vector<uint16_t>* runs, Bitmap* bitmap) {
+    std::uniform_int_distribution<int> runCount(0, 9);
+    std::uniform_int_distribution<int> runLength(0, bitmap->width / 4);
+    int count = runCount(random);
+    runs->push_back(static_cast<uint16_t>(count));
+
+    int x = 0;
+    for (int i = 0; i < count; i++) {
+        // Some zero-length runs, and some that run past the mask edge
+        int length = random() % 5 == 0 ? 0 : runLength(random);
+        runs->push_back(static_cast<uint16_t>(length));
+        bool interactive = (i & 1) != 0;
+        for (int px = x; px < x + length && px < bitmap->width; px++) {
+            bitmap->pixels[static_cast<size_t>(y) * bitmap->width + px] = interactive;
+        }
+        x += length;
+    }
+    for (int px = x; px < bitmap->width; px++) {
+        bitmap->pixels[static_cast<size_t>(y) * bitmap->width + px] = false;
+    }
+}
+
+// Encode `rowCount` random rows starting at `firstRow` of `bitmap`
+std::vector<uint16_t> RandomRows(std::mt19937& random, int firstRow, int rowCount, Bitmap* bitmap) {
+    std::vector<uint16_t> runs;
+    for (int row = 0; row < rowCount; row++) {
+        AddRow(random, firstRow + row, &runs, bitmap);
+    }
+    return runs;
+}
+
+// Every logical pixel at 96 DPI, plus the pixels just outside the mask
+int CountMismatches(const CaptionMask& mask, const Bitmap& bitmap) {
+    int mismatches = 0;
+    for (int y = 0; y < bitmap.height; y++) {
+        for (int x = 0; x < bitmap.width; x++) {
+            HitCode hit = HitCode::Nowhere;
+            bool found = mask.Lookup(x, y, 96, &hit);
+            HitCode expected = bitmap.At(x, y) ? HitCode::Client : HitCode::Caption;
+            mismatches += !found || hit != expected ? 1 : 0;
+        }
+        HitCode hit;
+        mismatches += mask.Lookup(bitmap.width, y, 96, &hit) ? 1 : 0;
+    }
+    HitCode hit;
+    mismatches += mask.Lookup(0, bitmap.height, 96, &hit) ? 1 : 0;
+    return mismatches;
+}
+
+// Every physical pixel at `dpi`, mapped to logical pixels the way the
+// backends' hit tests do (truncating x * 96 / dpi)
+int CountMismatchesAtDpi(const CaptionMask& mask, const Bitmap& bitmap, unsigned int dpi) {
+    int mismatches = 0;
+    int physicalWidth = static_cast<int>(bitmap.width * dpi / 96) + 2;
+    int physicalHeight = static_cast<int>(bitmap.height * dpi / 96) + 2;
+    for (int y = 0; y < physicalHeight; y++) {
+        for (int x = 0; x < physicalWidth; x++) {
+            unsigned int logicalX = static_cast<unsigned int>(x) * 96 / dpi;
+            unsigned int logicalY = static_cast<unsigned int>(y) * 96 / dpi;
+            bool inside = logicalX < static_cast<unsigned int>(bitmap.width) &&
+                          logicalY < static_cast<unsigned int>(bitmap.height);
+            HitCode hit = HitCode::Nowhere;
+            bool found = mask.Lookup(x, y, dpi, &hit);
+            if (found != inside) {
+                mismatches++;
+            } else if (inside) {
+                HitCode expected = bitmap.At(static_cast<int>(logicalX), static_cast<int>(logicalY))
+                    ? HitCode::Client : HitCode::Caption;
+                mismatches += hit != expected ? 1 : 0;
+            }
+        }
+    }
+    return mismatches;
+}
+
+Bitmap MakeBitmap(int width, int height) {
+    Bitmap bitmap;
+    bitmap.width = width;
+    bitmap.height = height;
+    bitmap.pixels.assign(static_cast<size_t>(width) * height, false);
+    return bitmap;
+}
+
+void TestEncoding() {
+    // 10 px wide rows; row 0 is draggable 0-2, interactive 3-5, draggable 6-9
+    const uint16_t runs[] = {
+        2, 3, 3,     // row 0
+        0,           // row 1: all draggable
+        1, 0,        // row 2: a single zero run, all draggable
+        2, 0, 4,     // row 3: starts interactive, 0-3
+        4, 2, 0, 0, 3,  // row 4: zero runs cancel out: interactive 2-4
+        2, 4, 50,    // row 5: last run clipped at the edge
+    };
+    CaptionMask mask;
+    WD_EXPECT(mask.Set(10, 6, runs, sizeof(runs) / sizeof(runs[0])));
+    WD_EXPECT_EQ(mask.width(), 10);
+    WD_EXPECT_EQ(mask.height(), 6);
+
+    const char* expected[] = {
+        "...###....",
+        "..........",
+        "..........",
+        "####......",
+        "..###.....",
+        "....######",
+    };
+    int mismatches = 0;
+    for (int y = 0; y < 6; y++) {
+        for (int x = 0; x < 10; x++) {
+            HitCode hit = HitCode::Nowhere;
+            WD_EXPECT(mask.Lookup(x, y, 96, &hit));
+            mismatches += hit != (expected[y][x] == '#' ? HitCode::Client : HitCode::Caption) ? 1 : 0;
+        }
+    }
+    WD_EXPECT_EQ(mismatches, 0);
+
+    // Outside the mask
+    HitCode hit;
+    WD_EXPECT(!mask.Lookup(-1, 0, 96, &hit));
+    WD_EXPECT(!mask.Lookup(0, -1, 96, &hit));
+    WD_EXPECT(!mask.Lookup(10, 0, 96, &hit));
+    WD_EXPECT(!mask.Lookup(0, 6, 96, &hit));
+    WD_EXPECT(!mask.Lookup(1 << 24, 0, 96, &hit));
+
+    // DPI 0 is treated as 96
+    WD_EXPECT(mask.Lookup(3, 0, 0, &hit));
+    WD_EXPECT_EQ(hit, HitCode::Client);
+
+    mask.Clear();
+    WD_EXPECT(mask.empty());
+    WD_EXPECT_EQ(mask.transitions(), 0u);
+    WD_EXPECT(!mask.Lookup(3, 0, 96, &hit));
+}
+
+void TestRandomMasks() {
+    std::mt19937 random(1);
+    for (int round = 0; round < 20; round++) {
+        int width = 1 + static_cast<int>(random() % 300);
+        int height = 1 + static_cast<int>(random() % 40);
+        Bitmap bitmap = MakeBitmap(width, height);
+        std::vector<uint16_t> runs = RandomRows(random, 0, height, &bitmap);
+
+        CaptionMask mask;
+        WD_EXPECT(mask.Set(width, height, runs.data(), runs.size()));
+        WD_EXPECT_EQ(CountMismatches(mask, bitmap), 0);
+
+        // Scales that don't divide 96 evenly, and downscaling
+        const unsigned int dpis[] = { 72, 120, 144, 168, 193 };
+        for (unsigned int dpi : dpis) {
+            WD_EXPECT_EQ(CountMismatchesAtDpi(mask, bitmap, dpi), 0);
+        }
+    }
+}
+
+void TestUpdateRows() {
+    std::mt19937 random(2);
+    const int width = 240;
+    const int height = 48;
+    Bitmap bitmap = MakeBitmap(width, height);
+    std::vector<uint16_t> runs = RandomRows(random, 0, height, &bitmap);
+    CaptionMask mask;
+    WD_EXPECT(mask.Set(width, height, runs.data(), runs.size()));
+
+    // The first row, the last row, the whole mask and single rows at the
+    // boundaries, then random ranges
+    struct Range {
+        int first;
+        int count;
+    };
+    std::vector<Range> ranges = {
+        { 0, 1 }, { height - 1, 1 }, { 0, height }, { 1, 1 }, { height - 2, 2 }, { 0, 3 },
+    };
+    for (int i = 0; i < 200; i++) {
+        int first = static_cast<int>(random() % height);
+        int count = 1 + static_cast<int>(random() % (height - first));
+        ranges.push_back({ first, count });
+    }
+
+    int mismatches = 0;
+    for (const Range& range : ranges) {
+        std::vector<uint16_t> rows = RandomRows(random, range.first, range.count, &bitmap);
+        WD_EXPECT(mask.UpdateRows(range.first, range.count, rows.data(), rows.size()));
+        mismatches += CountMismatches(mask, bitmap);
+    }
+    WD_EXPECT_EQ(mismatches, 0);
+    WD_EXPECT_EQ(CountMismatchesAtDpi(mask, bitmap, 144), 0);
+
+    // A fresh Set() of the same bitmap stores the same transitions
+    std::vector<uint16_t> full;
+    for (int y = 0; y < height; y++) {
+        std::vector<uint16_t> row;
+        bool interactive = false;
+        int runStart = 0;
+        for (int x = 0; x <= width; x++) {
+            bool value = x < width && bitmap.At(x, y);
+            if (x == width || value != interactive) {
+                row.push_back(static_cast<uint16_t>(x - runStart));
+                runStart = x;
+                interactive = value;
+            }
+        }
+        full.push_back(static_cast<uint16_t>(row.size()));
+        full.insert(full.end(), row.begin(), row.end());
+    }
+    CaptionMask rebuilt;
+    WD_EXPECT(rebuilt.Set(width, height, full.data(), full.size()));
+    WD_EXPECT_EQ(rebuilt.transitions(), mask.transitions());
+}
+
+void TestRejectsBadInput() {
+    std::mt19937 random(3);
+    Bitmap bitmap = MakeBitmap(64, 8);
+    std::vector<uint16_t> runs = RandomRows(random, 0, 8, &bitmap);
+    CaptionMask mask;
+    WD_EXPECT(mask.Set(64, 8, runs.data(), runs.size()));
+    size_t transitions = mask.transitions();
+
+    // Sizes out of range
+    WD_EXPECT(!mask.Set(0, 8, runs.data(), runs.size()));
+    WD_EXPECT(!mask.Set(-1, 8, runs.data(), runs.size()));
+    WD_EXPECT(!mask.Set(MAX_CAPTION_MASK_WIDTH + 1, 8, runs.data(), runs.size()));
+    WD_EXPECT(!mask.Set(64, 0, runs.data(), runs.size()));
+    WD_EXPECT(!mask.Set(64, MAX_CAPTION_MASK_HEIGHT + 1, runs.data(), runs.size()));
+
+    // Missing rows, trailing data, a run count past the end, no data
+    WD_EXPECT(!mask.Set(64, 9, runs.data(), runs.size()));
+    WD_EXPECT(!mask.Set(64, 7, runs.data(), runs.size()));
+    const uint16_t overlong[] = { 5, 1, 2 };
+    WD_EXPECT(!mask.Set(64, 1, overlong, 3));
+    WD_EXPECT(!mask.Set(64, 1, nullptr, 4));
+    WD_EXPECT(!mask.Set(64, 1, runs.data(), 0));
+
+    // Too many transitions: 5 rows alternating every pixel across 16384
+    std::vector<uint16_t> dense;
+    for (int row = 0; row < 5; row++) {
+        dense.push_back(static_cast<uint16_t>(MAX_CAPTION_MASK_WIDTH));
+        dense.insert(dense.end(), MAX_CAPTION_MASK_WIDTH, 1);
+    }
+    WD_EXPECT(!mask.Set(MAX_CAPTION_MASK_WIDTH, 5, dense.data(), dense.size()));
+
+    // None of the above touched the mask
+    WD_EXPECT_EQ(mask.width(), 64);
+    WD_EXPECT_EQ(mask.height(), 8);
+    WD_EXPECT_EQ(mask.transitions(), transitions);
+    WD_EXPECT_EQ(CountMismatches(mask, bitmap), 0);
+
+    // Row ranges out of range, and malformed rows
+    std::vector<uint16_t> row = { 2, 10, 10 };
+    WD_EXPECT(!mask.UpdateRows(-1, 1, row.data(), row.size()));
+    WD_EXPECT(!mask.UpdateRows(8, 1, row.data(), row.size()));
+    WD_EXPECT(!mask.UpdateRows(7, 2, row.data(), row.size()));
+    WD_EXPECT(!mask.UpdateRows(0, 0, row.data(), row.size()));
+    WD_EXPECT(!mask.UpdateRows(0, 1, row.data(), 2));
+    WD_EXPECT(!mask.UpdateRows(0, 2, row.data(), row.size()));
+    std::vector<uint16_t> trailing = { 2, 10, 10, 1 };
+    WD_EXPECT(!mask.UpdateRows(0, 1, trailing.data(), trailing.size()));
+    WD_EXPECT(!mask.UpdateRows(0, 1, nullptr, 3));
+    WD_EXPECT_EQ(mask.transitions(), transitions);
+    WD_EXPECT_EQ(CountMismatches(mask, bitmap), 0);
+
+    // Rows that would push the whole mask past the transition limit: four
+    // rows flipping at every pixel fit, a fifth doesn't
+    std::vector<uint16_t> denseRow;
+    denseRow.push_back(static_cast<uint16_t>(MAX_CAPTION_MASK_WIDTH));
+    denseRow.insert(denseRow.end(), MAX_CAPTION_MASK_WIDTH, 1);
+    std::vector<uint16_t> rows;
+    for (int i = 0; i < 4; i++) {
+        rows.insert(rows.end(), denseRow.begin(), denseRow.end());
+    }
+    rows.push_back(0);
+    CaptionMask wide;
+    WD_EXPECT(wide.Set(MAX_CAPTION_MASK_WIDTH, 5, rows.data(), rows.size()));
+    size_t wideTransitions = wide.transitions();
+    WD_EXPECT_EQ(wideTransitions, 4u * (MAX_CAPTION_MASK_WIDTH - 1));
+    WD_EXPECT(!wide.UpdateRows(4, 1, denseRow.data(), denseRow.size()));
+    WD_EXPECT_EQ(wide.transitions(), wideTransitions);
+    WD_EXPECT(wide.UpdateRows(0, 1, denseRow.data(), denseRow.size()));
+    WD_EXPECT_EQ(wide.transitions(), wideTransitions);
+
+    // No mask yet
+    CaptionMask none;
+    WD_EXPECT(!none.UpdateRows(0, 1, row.data(), row.size()));
+}
+
+}  // namespace
+
+int main() {
+    TestEncoding();
+    TestRandomMasks();
+    TestUpdateRows();
+    TestRejectsBadInput();
+    return test::TestExitCode();
+}
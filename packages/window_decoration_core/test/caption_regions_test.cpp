@@ -0,0 +1,281 @@
+// Window Decoration Core - Caption regions test
+// Checks CaptionRegionIndex lookups against a linear scan over the same
+// regions, topmost first, for random layouts: overlapping and rounded
+// regions, negative origins, extents large enough to grow the grid cells,
+// and replacements and removals. Also checks the region limit and the
+// rejected inputs.
+
+#include "window_decoration_core/caption_regions.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace window_decoration;
+
+namespace {
+
+// Reference shape test: inside the rect, and within the corner radius
+// (clamped like Set() does) of the nearest corner circle's center when the
+// point is in one of the corner squares
+bool InsideShape(int x, int y, const CaptionRegion& region) {
+    const Rect& r = region.bounds;
+    if (x < r.left || x >= r.right || y < r.top || y >= r.bottom) {
+        return false;
+    }
+    int radius = std::max(0, std::min(region.cornerRadius,
+                                      std::min(r.right - r.left, r.bottom - r.top) / 2));
+    int64_t cx = x;
+    if (x < r.left + radius) {
+        cx = r.left + radius;
+    } else if (x > r.right - radius - 1) {
+        cx = r.right - radius - 1;
+    }
+    int64_t cy = y;
+    if (y < r.top + radius) {
+        cy = r.top + radius;
+    } else if (y > r.bottom - radius - 1) {
+        cy = r.bottom - radius - 1;
+    }
+    int64_t dx = x - cx;
+    int64_t dy = y - cy;
+    return dx * dx + dy * dy <= static_cast<int64_t>(radius) * radius;
+}
+
+// Regions in stacking order, bottommost first, mirroring the index
+struct Model {
+    std::vector<std::pair<std::string, CaptionRegion>> regions;
+
+    void Set(const std::string& name, const CaptionRegion& region) {
+        for (auto& entry : regions) {
+            if (entry.first == name) {
+                entry.second = region;
+                return;
+            }
+        }
+        regions.push_back({ name, region });
+    }
+
+    bool Remove(const std::string& name) {
+        for (size_t i = 0; i < regions.size(); i++) {
+            if (regions[i].first == name) {
+                regions.erase(regions.begin() + static_cast<std::ptrdiff_t>(i));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool Lookup(int x, int y, HitCode* hit) const {
+        for (size_t i = regions.size(); i-- > 0;) {
+            if (InsideShape(x, y, regions[i].second)) {
+                *hit = regions[i].second.hit;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+const HitCode kHits[] = {
+    HitCode::Client, HitCode::Caption, HitCode::MinButton, HitCode::MaxButton, HitCode::Close,
+};
+
+CaptionRegion RandomRegion(std::mt19937& random, int originX, int originY, int extent, int maxSize) {
+    std::uniform_int_distribution<int> position(0, extent);
+    std::uniform_int_distribution<int> size(1, maxSize);
+    std::uniform_int_distribution<int> radius(0, 24);
+    CaptionRegion region;
+    region.bounds.left = originX + position(random);
+    region.bounds.top = originY + position(random) / 8;
+    region.bounds.right = region.bounds.left + size(random);
+    region.bounds.bottom = region.bounds.top + size(random) / 4 + 1;
+    region.hit = kHits[random() % 5];
+    region.cornerRadius = random() % 3 == 0 ? radius(random) : 0;
+    return region;
+}
+
+// Compare the index with the model at random points around the layout,
+// and at the edges and corners of every region
+int CountMismatches(const CaptionRegionIndex& index, const Model& model, std::mt19937& random,
+                    int originX, int originY, int extent) {
+    int mismatches = 0;
+    auto check = [&](int x, int y) {
+        HitCode expected = HitCode::Nowhere;
+        HitCode actual = HitCode::Nowhere;
+        bool expectedFound = model.Lookup(x, y, &expected);
+        bool actualFound = index.Lookup(x, y, &actual);
+        mismatches += expectedFound != actualFound || (expectedFound && actual != expected) ? 1 : 0;
+    };
+
+    std::uniform_int_distribution<int> xs(-64, extent + 64);
+    std::uniform_int_distribution<int> ys(-64, extent / 8 + 128);
+    for (int i = 0; i < 2000; i++) {
+        check(originX + xs(random), originY + ys(random));
+    }
+    for (const auto& entry : model.regions) {
+        const Rect& r = entry.second.bounds;
+        const int columns[] = { r.left - 1, r.left, r.left + 1, r.right - 2, r.right - 1, r.right };
+        const int rows[] = { r.top - 1, r.top, r.top + 1, r.bottom - 2, r.bottom - 1, r.bottom };
+        for (int x : columns) {
+            for (int y : rows) {
+                check(x, y);
+            }
+        }
+    }
+    return mismatches;
+}
+
+void TestRejectedRegions() {
+    CaptionRegionIndex index;
+    HitCode hit;
+    WD_EXPECT(index.empty());
+    WD_EXPECT(!index.Lookup(0, 0, &hit));
+
+    WD_EXPECT(!index.Set("empty", { { 10, 10, 10, 20 }, HitCode::Client, 0 }));
+    WD_EXPECT(!index.Set("inverted", { { 10, 20, 20, 10 }, HitCode::Client, 0 }));
+    WD_EXPECT(!index.Set("nowhere", { { 0, 0, 10, 10 }, HitCode::Nowhere, 0 }));
+    WD_EXPECT(!index.Set("border", { { 0, 0, 10, 10 }, HitCode::Left, 0 }));
+    WD_EXPECT(!index.Set("corner", { { 0, 0, 10, 10 }, HitCode::BottomRight, 0 }));
+    WD_EXPECT(index.empty());
+    WD_EXPECT(!index.Remove("missing"));
+}
+
+void TestRoundedCorners() {
+    CaptionRegionIndex index;
+    WD_EXPECT(index.Set("pill", { { 0, 0, 20, 20 }, HitCode::Client, 5 }));
+    HitCode hit;
+    WD_EXPECT(!index.Lookup(0, 0, &hit));
+    WD_EXPECT(!index.Lookup(19, 19, &hit));
+    WD_EXPECT(!index.Lookup(19, 0, &hit));
+    WD_EXPECT(!index.Lookup(0, 19, &hit));
+    WD_EXPECT(index.Lookup(5, 0, &hit));
+    WD_EXPECT(index.Lookup(0, 5, &hit));
+    WD_EXPECT(index.Lookup(14, 19, &hit));
+    WD_EXPECT(index.Lookup(10, 10, &hit));
+    WD_EXPECT(index.Lookup(2, 2, &hit));
+    WD_EXPECT(!index.Lookup(1, 1, &hit));
+
+    // Radii past half the short side are clamped to it (a full pill), and
+    // negative ones to a plain rectangle
+    WD_EXPECT(index.Set("pill", { { 0, 0, 100, 20 }, HitCode::Client, 1000 }));
+    WD_EXPECT_EQ(index.region(0).cornerRadius, 10);
+    WD_EXPECT(index.Lookup(1, 10, &hit));
+    WD_EXPECT(index.Lookup(50, 0, &hit));
+    WD_EXPECT(!index.Lookup(0, 3, &hit));
+    WD_EXPECT(index.Set("pill", { { 0, 0, 100, 20 }, HitCode::Client, -4 }));
+    WD_EXPECT_EQ(index.region(0).cornerRadius, 0);
+    WD_EXPECT(index.Lookup(0, 0, &hit));
+}
+
+void TestStackingOrder() {
+    CaptionRegionIndex index;
+    WD_EXPECT(index.Set("bottom", { { 0, 0, 100, 40 }, HitCode::Caption, 0 }));
+    WD_EXPECT(index.Set("top", { { 50, 0, 150, 40 }, HitCode::Close, 0 }));
+    HitCode hit = HitCode::Nowhere;
+    WD_EXPECT(index.Lookup(60, 10, &hit));
+    WD_EXPECT_EQ(hit, HitCode::Close);
+
+    // Replacing the bottom region keeps it below, even where it now covers
+    // the top one completely
+    WD_EXPECT(index.Set("bottom", { { 0, 0, 200, 40 }, HitCode::MinButton, 0 }));
+    WD_EXPECT_EQ(index.size(), 2u);
+    WD_EXPECT(index.Lookup(60, 10, &hit));
+    WD_EXPECT_EQ(hit, HitCode::Close);
+    WD_EXPECT(index.Lookup(180, 10, &hit));
+    WD_EXPECT_EQ(hit, HitCode::MinButton);
+
+    // Removing the top region uncovers the bottom one
+    WD_EXPECT(index.Remove("top"));
+    WD_EXPECT(index.Lookup(60, 10, &hit));
+    WD_EXPECT_EQ(hit, HitCode::MinButton);
+
+    index.Clear();
+    WD_EXPECT(index.empty());
+    WD_EXPECT(!index.Lookup(60, 10, &hit));
+}
+
+void TestRegionLimit() {
+    CaptionRegionIndex index;
+    for (size_t i = 0; i < MAX_CAPTION_REGIONS; i++) {
+        int x = static_cast<int>(i % 64) * 20;
+        int y = static_cast<int>(i / 64) * 20;
+        WD_EXPECT(index.Set("r" + std::to_string(i), { { x, y, x + 20, y + 20 }, HitCode::Client, 0 }));
+    }
+    WD_EXPECT_EQ(index.size(), MAX_CAPTION_REGIONS);
+    WD_EXPECT(!index.Set("one more", { { 0, 0, 10, 10 }, HitCode::Close, 0 }));
+    WD_EXPECT_EQ(index.size(), MAX_CAPTION_REGIONS);
+
+    // Replacing at the limit still works; so does adding after a removal
+    WD_EXPECT(index.Set("r0", { { 0, 0, 10, 10 }, HitCode::Close, 0 }));
+    WD_EXPECT(index.Remove("r1"));
+    WD_EXPECT(index.Set("one more", { { 20, 0, 40, 20 }, HitCode::MaxButton, 0 }));
+
+    // The last region registered is the topmost everywhere it overlaps
+    HitCode hit = HitCode::Nowhere;
+    WD_EXPECT(index.Lookup(5, 5, &hit));
+    WD_EXPECT_EQ(hit, HitCode::Close);
+    WD_EXPECT(index.Lookup(25, 5, &hit));
+    WD_EXPECT_EQ(hit, HitCode::MaxButton);
+    WD_EXPECT(index.Lookup(1275, 315, &hit));
+    WD_EXPECT_EQ(hit, HitCode::Client);
+    WD_EXPECT(!index.Lookup(1280, 315, &hit));
+}
+
+// Random layouts with replacements and removals, at a small extent (fine
+// grid), with negative origins, and at extents that force larger cells
+void TestRandomLayouts() {
+    struct Layout {
+        int originX;
+        int originY;
+        int extent;
+        int maxSize;
+    };
+    const Layout layouts[] = {
+        { 0, 0, 1280, 200 },
+        { -900, -40, 1600, 300 },
+        { -50000, -3000, 100000, 20000 },
+        { -1000000000, -1000000000, 2000000000, 400000000 },
+    };
+
+    std::mt19937 random(1);
+    for (const Layout& layout : layouts) {
+        for (int round = 0; round < 10; round++) {
+            CaptionRegionIndex index;
+            Model model;
+            int count = 1 + static_cast<int>(random() % 120);
+            for (int i = 0; i < count; i++) {
+                CaptionRegion region = RandomRegion(random, layout.originX, layout.originY,
+                                                    layout.extent, layout.maxSize);
+                std::string name = "r" + std::to_string(random() % 150);
+                WD_EXPECT(index.Set(name, region));
+                model.Set(name, region);
+            }
+            WD_EXPECT_EQ(index.size(), model.regions.size());
+            WD_EXPECT_EQ(CountMismatches(index, model, random, layout.originX, layout.originY,
+                                         layout.extent), 0);
+
+            for (int i = 0; i < 30; i++) {
+                std::string name = "r" + std::to_string(random() % 150);
+                WD_EXPECT_EQ(index.Remove(name), model.Remove(name));
+            }
+            WD_EXPECT_EQ(index.size(), model.regions.size());
+            WD_EXPECT_EQ(CountMismatches(index, model, random, layout.originX, layout.originY,
+                                         layout.extent), 0);
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    TestRejectedRegions();
+    TestRoundedCorners();
+    TestStackingOrder();
+    TestRegionLimit();
+    TestRandomLayouts();
+    return test::TestExitCode();
+}
@@ -0,0 +1,157 @@
+// Window Decoration Core - Caption snapshot test
+// Checks publish semantics, then runs a bounded multi-threaded stress test:
+// reader threads pin snapshots while a writer publishes a fixed number of
+// layouts. Every snapshot a reader sees must be internally consistent (all
+// fields derived from its generation), and generations never go backwards.
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "test_util.h"
+#include "window_decoration_core/caption_snapshot.h"
+
+using namespace window_decoration;
+
+namespace {
+
+// Layout published for generation `g`. Every field depends on g so a reader
+// can tell if it sees parts of two different layouts.
+bool PublishLayout(CaptionPublisher* publisher) {
+    return publisher->Update([](CaptionSnapshot& snapshot) {
+        int g = static_cast<int>(snapshot.generation + 1);
+        int left = 1000 + g % 100;
+        snapshot.caption.captionHeight = 32 + g % 16;
+        snapshot.caption.minimizeButton = { left, 0, left + 46, 32 };
+        snapshot.caption.maximizeButton = { left + 46, 0, left + 92, 32 };
+        snapshot.caption.closeButton = { left + 92, 0, left + 138, 32 };
+        snapshot.caption.hasCaptionButtons = true;
+
+        CaptionRegion region = { { g % 100, 0, g % 100 + 200, 32 }, HitCode::Client, 8 };
+        snapshot.regions.Set("tabs", region);
+        return true;
+    });
+}
+
+bool IsConsistent(const CaptionSnapshot& snapshot) {
+    if (snapshot.generation == 0) {
+        return snapshot.regions.empty() && !snapshot.caption.hasCaptionButtons;
+    }
+    int g = static_cast<int>(snapshot.generation);
+    int left = 1000 + g % 100;
+    const CaptionLayout& caption = snapshot.caption;
+    if (caption.captionHeight != 32 + g % 16 ||
+        caption.minimizeButton.left != left ||
+        caption.maximizeButton.left != left + 46 ||
+        caption.closeButton.right != left + 138) {
+        return false;
+    }
+
+    // The region must sit exactly where this generation put it
+    HitCode hit;
+    return snapshot.regions.size() == 1 &&
+           snapshot.regions.Lookup(g % 100 + 100, 16, &hit) &&
+           !snapshot.regions.Lookup(g % 100 + 200, 16, &hit);
+}
+
+void TestPublish() {
+    CaptionPublisher publisher;
+    WD_EXPECT_EQ(publisher.generation(), 0u);
+    WD_EXPECT(IsConsistent(*publisher.Read()));
+
+    WD_EXPECT(PublishLayout(&publisher));
+    WD_EXPECT_EQ(publisher.generation(), 1u);
+    WD_EXPECT(IsConsistent(*publisher.Read()));
+
+    // Edits build on the current snapshot
+    WD_EXPECT(publisher.Update([](CaptionSnapshot& snapshot) {
+        snapshot.caption.captionHeight = 48;
+        return true;
+    }));
+    CaptionPublisher::ReadGuard snapshot = publisher.Read();
+    WD_EXPECT_EQ(snapshot->generation, 2u);
+    WD_EXPECT_EQ(snapshot->caption.captionHeight, 48);
+    WD_EXPECT_EQ(snapshot->regions.size(), 1u);
+}
+
+void TestRejectedEditIsNotPublished() {
+    CaptionPublisher publisher;
+    PublishLayout(&publisher);
+
+    bool published = publisher.Update([](CaptionSnapshot& snapshot) {
+        snapshot.caption.captionHeight = 999;
+        snapshot.regions.Clear();
+        return false;
+    });
+
+    WD_EXPECT(!published);
+    CaptionPublisher::ReadGuard snapshot = publisher.Read();
+    WD_EXPECT_EQ(snapshot->generation, 1u);
+    WD_EXPECT(IsConsistent(*snapshot));
+}
+
+void TestPinnedSnapshotSurvivesPublish() {
+    CaptionPublisher publisher;
+    PublishLayout(&publisher);
+
+    CaptionPublisher::ReadGuard pinned = publisher.Read();
+    // The writer copies into the other slot, so one publish never waits for
+    // (or touches) the pinned snapshot
+    WD_EXPECT(PublishLayout(&publisher));
+    WD_EXPECT_EQ(pinned->generation, 1u);
+    WD_EXPECT(IsConsistent(*pinned));
+    WD_EXPECT_EQ(publisher.Read()->generation, 2u);
+}
+
+void TestConcurrentReadersSeeNoTornSnapshots() {
+    const uint64_t publishCount = 20000;
+    unsigned int readerCount = std::thread::hardware_concurrency();
+    readerCount = readerCount > 2 ? readerCount - 1 : 2;
+    if (readerCount > 8) {
+        readerCount = 8;
+    }
+
+    CaptionPublisher publisher;
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> torn(0);
+    std::atomic<uint64_t> backwards(0);
+
+    std::vector<std::thread> readers;
+    for (unsigned int t = 0; t < readerCount; t++) {
+        readers.emplace_back([&]() {
+            uint64_t lastGeneration = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                CaptionPublisher::ReadGuard snapshot = publisher.Read();
+                if (!IsConsistent(*snapshot)) {
+                    torn++;
+                }
+                if (snapshot->generation < lastGeneration) {
+                    backwards++;
+                }
+                lastGeneration = snapshot->generation;
+            }
+        });
+    }
+
+    for (uint64_t i = 0; i < publishCount; i++) {
+        PublishLayout(&publisher);
+    }
+    stop = true;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    WD_EXPECT_EQ(torn.load(), 0u);
+    WD_EXPECT_EQ(backwards.load(), 0u);
+    WD_EXPECT_EQ(publisher.generation(), publishCount);
+}
+
+}  // namespace
+
+int main() {
+    TestPublish();
+    TestRejectedEditIsNotPublished();
+    TestPinnedSnapshotSurvivesPublish();
+    TestConcurrentReadersSeeNoTornSnapshots();
+    return test::TestExitCode();
+}
@@ -0,0 +1,222 @@
+// Window Decoration Core - Cursor cache test
+// Checks the hit to cursor shape mapping, that each shape, display and
+// scale is loaded exactly once (also with several UI threads asking at
+// once), and that a mouse path over two displays only sets the cursor on
+// hit transitions.
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "test_util.h"
+#include "window_decoration_core/cursor_cache.h"
+#include "window_decoration_core/hit_test_policy.h"
+#include "window_decoration_core/hover_memo.h"
+
+using namespace window_decoration;
+
+namespace {
+
+typedef const void* CursorHandle;
+
+int g_cursorStorage[5 * 4];
+
+// Stand-in for a platform cursor load: a handle unique to shape and scale
+CursorHandle CursorFor(CursorShape shape, uint32_t scale) {
+    return &g_cursorStorage[static_cast<int>(shape) * 4 + (scale / 48) % 4];
+}
+
+void TestShapeForHit() {
+    struct Case {
+        HitCode hit;
+        bool resize;
+        CursorShape shape;
+    };
+    const Case cases[] = {
+        { HitCode::Left, true, CursorShape::ResizeHorizontal },
+        { HitCode::Right, true, CursorShape::ResizeHorizontal },
+        { HitCode::Top, true, CursorShape::ResizeVertical },
+        { HitCode::Bottom, true, CursorShape::ResizeVertical },
+        { HitCode::TopLeft, true, CursorShape::ResizeNwse },
+        { HitCode::BottomRight, true, CursorShape::ResizeNwse },
+        { HitCode::TopRight, true, CursorShape::ResizeNesw },
+        { HitCode::BottomLeft, true, CursorShape::ResizeNesw },
+        { HitCode::Client, false, CursorShape::Arrow },
+        { HitCode::Caption, false, CursorShape::Arrow },
+        { HitCode::Close, false, CursorShape::Arrow },
+    };
+    for (const Case& c : cases) {
+        CursorShape shape = CursorShape::Arrow;
+        WD_EXPECT_EQ(CursorShapeForHit(c.hit, &shape), c.resize);
+        WD_EXPECT(shape == c.shape);
+    }
+}
+
+void TestLoadsOncePerKey() {
+    CursorCache<CursorHandle> cache;
+    int loads = 0;
+    auto load = [&loads](CursorShape shape) {
+        loads++;
+        return CursorFor(shape, 96);
+    };
+
+    CursorHandle first = cache.Get(CursorShape::ResizeNwse, 1, 96, load);
+    WD_EXPECT_EQ(first, CursorFor(CursorShape::ResizeNwse, 96));
+    WD_EXPECT_EQ(cache.Get(CursorShape::ResizeNwse, 1, 96, load), first);
+    WD_EXPECT_EQ(loads, 1);
+
+    // Another display or scale is another cursor
+    cache.Get(CursorShape::ResizeNwse, 2, 96, load);
+    cache.Get(CursorShape::ResizeNwse, 1, 192, load);
+    cache.Get(CursorShape::ResizeNesw, 1, 96, load);
+    WD_EXPECT_EQ(loads, 4);
+
+    CursorCacheStats stats = cache.stats();
+    WD_EXPECT_EQ(stats.hits, 1u);
+    WD_EXPECT_EQ(stats.loads, 4u);
+}
+
+void TestFailedLoadIsRetried() {
+    CursorCache<CursorHandle> cache;
+    int loads = 0;
+    auto fail = [&loads](CursorShape) {
+        loads++;
+        return CursorHandle();
+    };
+
+    WD_EXPECT(cache.Get(CursorShape::ResizeVertical, 0, 0, fail) == nullptr);
+    WD_EXPECT(cache.Get(CursorShape::ResizeVertical, 0, 0, fail) == nullptr);
+    WD_EXPECT_EQ(loads, 2);
+
+    CursorHandle loaded = cache.Get(CursorShape::ResizeVertical, 0, 0, [](CursorShape shape) {
+        return CursorFor(shape, 96);
+    });
+    WD_EXPECT(loaded != nullptr);
+    WD_EXPECT_EQ(cache.Get(CursorShape::ResizeVertical, 0, 0, fail), loaded);
+    WD_EXPECT_EQ(loads, 2);
+}
+
+void TestClearReleasesEveryCursor() {
+    CursorCache<CursorHandle> cache;
+    auto load = [](CursorShape shape) { return CursorFor(shape, 96); };
+    cache.Get(CursorShape::ResizeHorizontal, 0, 96, load);
+    cache.Get(CursorShape::ResizeVertical, 0, 96, load);
+
+    std::vector<CursorHandle> released;
+    cache.Clear([&released](CursorHandle handle) { released.push_back(handle); });
+    WD_EXPECT_EQ(released.size(), 2u);
+
+    // Cleared cursors are loaded again
+    int loads = 0;
+    cache.Get(CursorShape::ResizeHorizontal, 0, 96, [&loads](CursorShape shape) {
+        loads++;
+        return CursorFor(shape, 96);
+    });
+    WD_EXPECT_EQ(loads, 1);
+}
+
+void TestSharedByThreads() {
+    CursorCache<CursorHandle> cache;
+    std::atomic<int> loads(0);
+    std::atomic<int> mismatches(0);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 10000; i++) {
+                CursorShape shape = static_cast<CursorShape>(i % 5);
+                uint32_t scale = i % 2 == 0 ? 96 : 192;
+                CursorHandle handle = cache.Get(shape, 0, scale, [&loads, scale](CursorShape s) {
+                    loads++;
+                    return CursorFor(s, scale);
+                });
+                if (handle != CursorFor(shape, scale)) {
+                    mismatches++;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    WD_EXPECT_EQ(loads.load(), 10);
+    WD_EXPECT_EQ(mismatches.load(), 0);
+}
+
+// A pointer wandering over the bottom-right corner of one window per
+// display, through the memo and transition-only cursor updates like the
+// backends do
+void TestMousePathSetsCursorOnTransitions() {
+    CursorCache<CursorHandle> cache;
+    uint64_t transitions = 0;
+    uint64_t cursorSets = 0;
+    uint64_t loads = 0;
+    uint64_t random = 0x9E3779B97F4A7C15ull;
+    auto step = [&random]() {
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        return static_cast<int>((random >> 32) % 7) - 3;
+    };
+
+    for (uint32_t display = 1; display <= 2; display++) {
+        uint32_t scale = display == 1 ? 96 : 192;
+        FrameGeometry geometry = {};
+        geometry.windowWidth = 800;
+        geometry.windowHeight = 600;
+        geometry.borderWidth = 8 * static_cast<int>(scale) / 96;
+        geometry.borderHeight = 8 * static_cast<int>(scale) / 96;
+        geometry.dpi = scale;
+
+        HoverMemo hover;
+        CursorHandle shown = nullptr;
+        int x = 700;
+        int y = 500;
+        for (int i = 0; i < 50000; i++) {
+            x += step();
+            y += step();
+            x = x < 0 ? 0 : (x >= 800 ? 799 : x);
+            y = y < 0 ? 0 : (y >= 600 ? 599 : y);
+
+            HitCode hit = hover.Resolve(x, y, 1, [&geometry](int px, int py, Rect* cell) {
+                return ResolveResizeCellFor<CustomFramePolicy>(px, py, geometry, cell);
+            });
+            if (!hover.Transition(hit)) {
+                continue;
+            }
+            transitions++;
+
+            CursorShape shape = CursorShape::Arrow;
+            CursorShapeForHit(hit, &shape);
+            CursorHandle cursor = cache.Get(shape, display, scale, [&loads, scale](CursorShape s) {
+                loads++;
+                return CursorFor(s, scale);
+            });
+            if (cursor != shown) {
+                shown = cursor;
+                cursorSets++;
+            }
+        }
+    }
+
+    // At most 5 shapes on each of the 2 displays, each loaded exactly once
+    CursorCacheStats stats = cache.stats();
+    WD_EXPECT(transitions > 0);
+    WD_EXPECT(loads <= 10);
+    WD_EXPECT_EQ(stats.loads, loads);
+    WD_EXPECT_EQ(stats.loads + stats.hits, transitions);
+    WD_EXPECT(cursorSets <= transitions);
+}
+
+}  // namespace
+
+int main() {
+    TestShapeForHit();
+    TestLoadsOncePerKey();
+    TestFailedLoadIsRetried();
+    TestClearReleasesEveryCursor();
+    TestSharedByThreads();
+    TestMousePathSetsCursorOnTransitions();
+    return test::TestExitCode();
+}
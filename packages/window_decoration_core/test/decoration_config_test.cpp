@@ -0,0 +1,233 @@
+// Window Decoration Core - Decoration config test
+// Checks the config blob: byte layout, encode/decode round trips, forward
+// compatibility with a longer fixed part and unknown flags, and rejection
+// of truncated, wrong-version, out-of-range and oversized blobs.
+
+#include "window_decoration_core/decoration_config.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace window_decoration;
+
+namespace {
+
+DecorationConfig RandomConfig(std::mt19937& random) {
+    DecorationConfig config = {};
+    config.flags = static_cast<uint16_t>(random() % 128);
+    config.backgroundColor = static_cast<uint32_t>(random());
+    config.opacity = static_cast<float>(random() % 101) / 100.0f;
+    config.captionHeight = static_cast<uint16_t>(random() % 0x10000);
+    config.titleBarStyle = static_cast<TitleBarStyle>(random() % 5);
+    config.effectCount = static_cast<uint8_t>(random() % (MAX_DECORATION_EFFECTS + 1));
+    for (uint8_t i = 0; i < config.effectCount; i++) {
+        config.effects[i] = static_cast<WindowEffect>(random() % 6);
+    }
+    return config;
+}
+
+bool SameConfig(const DecorationConfig& a, const DecorationConfig& b) {
+    return a.flags == b.flags && a.backgroundColor == b.backgroundColor && a.opacity == b.opacity &&
+           a.captionHeight == b.captionHeight && a.titleBarStyle == b.titleBarStyle &&
+           a.effectCount == b.effectCount && std::memcmp(a.effects, b.effects, a.effectCount) == 0;
+}
+
+// Encode `config` into a vector sized to the result
+std::vector<uint8_t> Encode(const DecorationConfig& config) {
+    std::vector<uint8_t> blob(MAX_DECORATION_CONFIG_BYTES);
+    blob.resize(EncodeDecorationConfig(config, blob.data(), blob.size()));
+    return blob;
+}
+
+void TestLayout() {
+    DecorationConfig config = {};
+    config.flags = DECORATION_CONFIG_CENTERED | DECORATION_CONFIG_VISIBLE | DECORATION_CONFIG_HAS_BACKGROUND;
+    config.backgroundColor = 0xFF102030;
+    config.opacity = 0.5f;
+    config.captionHeight = 0x0128;
+    config.titleBarStyle = TitleBarStyle::CustomFrame;
+    config.effectCount = 2;
+    config.effects[0] = WindowEffect::Mica;
+    config.effects[1] = WindowEffect::Shadow;
+
+    // What WindowDecorationConfig.encode() writes for the same config
+    const uint8_t expected[] = {
+        1, 16, 0x31, 0x00,
+        0x30, 0x20, 0x10, 0xFF,
+        0x00, 0x00, 0x00, 0x3F,
+        0x28, 0x01, 4, 2,
+        5, 3,
+    };
+    std::vector<uint8_t> blob = Encode(config);
+    WD_EXPECT_EQ(blob.size(), sizeof(expected));
+    WD_EXPECT(blob.size() == sizeof(expected) && std::memcmp(blob.data(), expected, sizeof(expected)) == 0);
+
+    DecorationConfig decoded;
+    WD_EXPECT(DecodeDecorationConfig(expected, sizeof(expected), &decoded));
+    WD_EXPECT(SameConfig(config, decoded));
+    WD_EXPECT(decoded.has(DECORATION_CONFIG_CENTERED));
+    WD_EXPECT(!decoded.has(DECORATION_CONFIG_FRAMELESS));
+    WD_EXPECT(!decoded.decorated());
+}
+
+void TestRoundTrips() {
+    std::mt19937 random(1);
+    int mismatches = 0;
+    for (int i = 0; i < 20000; i++) {
+        DecorationConfig original = RandomConfig(random);
+        std::vector<uint8_t> blob = Encode(original);
+        DecorationConfig decoded;
+        mismatches += blob.size() != DECORATION_CONFIG_FIXED_BYTES + static_cast<size_t>(original.effectCount) ||
+                      !DecodeDecorationConfig(blob.data(), blob.size(), &decoded) ||
+                      !SameConfig(original, decoded) ? 1 : 0;
+
+        // Trailing bytes are ignored
+        blob.push_back(0xAB);
+        mismatches += !DecodeDecorationConfig(blob.data(), blob.size(), &decoded) ||
+                      !SameConfig(original, decoded) ? 1 : 0;
+    }
+    WD_EXPECT_EQ(mismatches, 0);
+}
+
+// Every length short of the fixed part plus the effect list is rejected,
+// and the output is left untouched
+void TestTruncatedBlobs() {
+    std::mt19937 random(2);
+    int accepted = 0;
+    for (int i = 0; i < 200; i++) {
+        DecorationConfig original = RandomConfig(random);
+        std::vector<uint8_t> blob = Encode(original);
+        for (size_t length = 0; length < blob.size(); length++) {
+            DecorationConfig decoded = {};
+            decoded.captionHeight = 777;
+            accepted += DecodeDecorationConfig(blob.data(), length, &decoded) ? 1 : 0;
+            accepted += decoded.captionHeight != 777 ? 1 : 0;
+        }
+    }
+    WD_EXPECT_EQ(accepted, 0);
+
+    DecorationConfig decoded;
+    WD_EXPECT(!DecodeDecorationConfig(nullptr, MAX_DECORATION_CONFIG_BYTES, &decoded));
+    std::vector<uint8_t> blob = Encode(RandomConfig(random));
+    WD_EXPECT(!DecodeDecorationConfig(blob.data(), blob.size(), nullptr));
+}
+
+void TestRejectsOutOfRange() {
+    DecorationConfig config = {};
+    config.opacity = 1.0f;
+    config.effectCount = 1;
+    std::vector<uint8_t> blob = Encode(config);
+    DecorationConfig decoded;
+    WD_EXPECT(DecodeDecorationConfig(blob.data(), blob.size(), &decoded));
+
+    // Other major versions
+    std::vector<uint8_t> bad = blob;
+    bad[0] = DECORATION_CONFIG_VERSION + 1;
+    WD_EXPECT(!DecodeDecorationConfig(bad.data(), bad.size(), &decoded));
+    bad[0] = 0;
+    WD_EXPECT(!DecodeDecorationConfig(bad.data(), bad.size(), &decoded));
+
+    // A fixed part shorter than this version's
+    bad = blob;
+    bad[1] = DECORATION_CONFIG_FIXED_BYTES - 1;
+    WD_EXPECT(!DecodeDecorationConfig(bad.data(), bad.size(), &decoded));
+
+    // A fixed part longer than the blob
+    bad = blob;
+    bad[1] = 200;
+    WD_EXPECT(!DecodeDecorationConfig(bad.data(), bad.size(), &decoded));
+
+    // Unknown title bar styles
+    bad = blob;
+    bad[14] = static_cast<uint8_t>(TitleBarStyle::CustomFrame) + 1;
+    WD_EXPECT(!DecodeDecorationConfig(bad.data(), bad.size(), &decoded));
+
+    // More effects than a config carries, even with the bytes present
+    std::vector<uint8_t> oversized(DECORATION_CONFIG_FIXED_BYTES + 255, 0);
+    std::memcpy(oversized.data(), blob.data(), DECORATION_CONFIG_FIXED_BYTES);
+    oversized[15] = MAX_DECORATION_EFFECTS + 1;
+    WD_EXPECT(!DecodeDecorationConfig(oversized.data(), oversized.size(), &decoded));
+    oversized[15] = 255;
+    WD_EXPECT(!DecodeDecorationConfig(oversized.data(), oversized.size(), &decoded));
+    oversized[15] = MAX_DECORATION_EFFECTS;
+    WD_EXPECT(DecodeDecorationConfig(oversized.data(), oversized.size(), &decoded));
+    WD_EXPECT_EQ(decoded.effectCount, MAX_DECORATION_EFFECTS);
+
+    // An effect count whose list runs past the end
+    bad = blob;
+    bad[15] = 2;
+    WD_EXPECT(!DecodeDecorationConfig(bad.data(), bad.size(), &decoded));
+
+    // NaN opacity is rejected; out-of-range opacity is clamped
+    auto withOpacity = [&blob](float opacity) {
+        std::vector<uint8_t> copy = blob;
+        uint32_t bits;
+        std::memcpy(&bits, &opacity, sizeof(bits));
+        for (int i = 0; i < 4; i++) {
+            copy[8 + i] = static_cast<uint8_t>(bits >> (8 * i));
+        }
+        return copy;
+    };
+    bad = withOpacity(std::numeric_limits<float>::quiet_NaN());
+    WD_EXPECT(!DecodeDecorationConfig(bad.data(), bad.size(), &decoded));
+    bad = withOpacity(7.5f);
+    WD_EXPECT(DecodeDecorationConfig(bad.data(), bad.size(), &decoded));
+    WD_EXPECT_EQ(decoded.opacity, 1.0f);
+    bad = withOpacity(-std::numeric_limits<float>::infinity());
+    WD_EXPECT(DecodeDecorationConfig(bad.data(), bad.size(), &decoded));
+    WD_EXPECT_EQ(decoded.opacity, 0.0f);
+}
+
+// A future minor version: a longer fixed part and flags this one doesn't
+// know. The effect list is found at the recorded size and the unknown
+// flags are dropped.
+void TestForwardCompatibility() {
+    std::mt19937 random(3);
+    int mismatches = 0;
+    for (int i = 0; i < 1000; i++) {
+        DecorationConfig original = RandomConfig(random);
+        std::vector<uint8_t> blob = Encode(original);
+        uint8_t extra = static_cast<uint8_t>(1 + random() % 32);
+        std::vector<uint8_t> extended(blob.begin(), blob.begin() + DECORATION_CONFIG_FIXED_BYTES);
+        extended.insert(extended.end(), extra, 0xEE);
+        extended.insert(extended.end(), blob.begin() + DECORATION_CONFIG_FIXED_BYTES, blob.end());
+        extended[1] = static_cast<uint8_t>(DECORATION_CONFIG_FIXED_BYTES + extra);
+        extended[3] |= 0x80;
+
+        DecorationConfig decoded;
+        mismatches += !DecodeDecorationConfig(extended.data(), extended.size(), &decoded) ||
+                      !SameConfig(original, decoded) ? 1 : 0;
+        mismatches += DecodeDecorationConfig(extended.data(), extended.size() - 1, &decoded) ? 1 : 0;
+    }
+    WD_EXPECT_EQ(mismatches, 0);
+}
+
+void TestEncodeLimits() {
+    DecorationConfig config = {};
+    uint8_t blob[MAX_DECORATION_CONFIG_BYTES];
+
+    config.effectCount = MAX_DECORATION_EFFECTS;
+    WD_EXPECT_EQ(EncodeDecorationConfig(config, blob, sizeof(blob)), MAX_DECORATION_CONFIG_BYTES);
+    WD_EXPECT_EQ(EncodeDecorationConfig(config, blob, sizeof(blob) - 1), 0u);
+    WD_EXPECT_EQ(EncodeDecorationConfig(config, nullptr, sizeof(blob)), 0u);
+
+    config.effectCount = MAX_DECORATION_EFFECTS + 1;
+    WD_EXPECT_EQ(EncodeDecorationConfig(config, blob, sizeof(blob)), 0u);
+}
+
+}  // namespace
+
+int main() {
+    TestLayout();
+    TestRoundTrips();
+    TestTruncatedBlobs();
+    TestRejectsOutOfRange();
+    TestForwardCompatibility();
+    TestEncodeLimits();
+    return test::TestExitCode();
+}
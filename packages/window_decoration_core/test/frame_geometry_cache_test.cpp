@@ -0,0 +1,145 @@
+// Window Decoration Core - Frame geometry cache test
+// Checks that each window event refreshes exactly the parts of the cache it
+// invalidates, and that lookups between events make no backend queries.
+
+#include "window_decoration_core/frame_geometry_cache.h"
+
+#include "test_util.h"
+
+using namespace window_decoration;
+
+namespace {
+
+struct FakeBackend {
+    FrameMetrics metrics = {96, 8, 8, 0};
+    FramePlacement placement = {{100, 50, 1380, 850}, 8, 31, false};
+    int metricsQueries = 0;
+    int placementQueries = 0;
+
+    const FrameGeometry& Get(FrameGeometryCache& cache) {
+        return cache.Get(
+            [this]() {
+                metricsQueries++;
+                return metrics;
+            },
+            [this]() {
+                placementQueries++;
+                return placement;
+            });
+    }
+};
+
+void TestComposesGeometry() {
+    FrameGeometryCache cache;
+    FakeBackend backend;
+    const FrameGeometry& geometry = backend.Get(cache);
+
+    WD_EXPECT_EQ(geometry.windowWidth, 1280);
+    WD_EXPECT_EQ(geometry.windowHeight, 800);
+    WD_EXPECT_EQ(geometry.borderWidth, 8);
+    WD_EXPECT_EQ(geometry.borderHeight, 8);
+    WD_EXPECT_EQ(geometry.clientLeft, 8);
+    WD_EXPECT_EQ(geometry.clientTop, 31);
+    WD_EXPECT_EQ(geometry.dpi, 96u);
+    WD_EXPECT(!geometry.isMaximized);
+    WD_EXPECT_EQ(cache.generation(), 1u);
+}
+
+void TestLookupsBetweenEventsAreCached() {
+    FrameGeometryCache cache;
+    FakeBackend backend;
+    for (int i = 0; i < 1000; i++) {
+        backend.Get(cache);
+    }
+
+    WD_EXPECT_EQ(backend.metricsQueries, 1);
+    WD_EXPECT_EQ(backend.placementQueries, 1);
+    WD_EXPECT_EQ(cache.stats().lookups, 1000u);
+    WD_EXPECT_EQ(cache.stats().metricsRefreshes, 1u);
+    WD_EXPECT_EQ(cache.stats().placementRefreshes, 1u);
+    WD_EXPECT_EQ(cache.generation(), 1u);
+}
+
+void TestPlacementEventsKeepMetrics() {
+    const FrameCacheEvent events[] = {
+        FrameCacheEvent::WindowPosChanging,
+        FrameCacheEvent::WindowPosChanged,
+        FrameCacheEvent::Size,
+    };
+    for (FrameCacheEvent event : events) {
+        FrameGeometryCache cache;
+        FakeBackend backend;
+        backend.Get(cache);
+
+        backend.placement.windowRect = {0, 0, 640, 480};
+        backend.placement.isMaximized = true;
+        cache.Invalidate(event);
+        const FrameGeometry& geometry = backend.Get(cache);
+
+        WD_EXPECT_EQ(backend.metricsQueries, 1);
+        WD_EXPECT_EQ(backend.placementQueries, 2);
+        WD_EXPECT_EQ(geometry.windowWidth, 640);
+        WD_EXPECT_EQ(geometry.windowHeight, 480);
+        WD_EXPECT(geometry.isMaximized);
+        WD_EXPECT_EQ(cache.generation(), 2u);
+    }
+}
+
+void TestSettingChangeKeepsPlacement() {
+    FrameGeometryCache cache;
+    FakeBackend backend;
+    backend.Get(cache);
+
+    backend.metrics.padding = 4;
+    cache.Invalidate(FrameCacheEvent::SettingChange);
+    const FrameGeometry& geometry = backend.Get(cache);
+
+    WD_EXPECT_EQ(backend.metricsQueries, 2);
+    WD_EXPECT_EQ(backend.placementQueries, 1);
+    WD_EXPECT_EQ(geometry.borderWidth, 12);
+    WD_EXPECT_EQ(geometry.borderHeight, 12);
+}
+
+void TestDpiChangeRefreshesEverything() {
+    FrameGeometryCache cache;
+    FakeBackend backend;
+    backend.Get(cache);
+
+    backend.metrics = {144, 12, 12, 6};
+    backend.placement.windowRect = {150, 75, 2070, 1275};
+    cache.Invalidate(FrameCacheEvent::DpiChanged);
+    const FrameGeometry& geometry = backend.Get(cache);
+
+    WD_EXPECT_EQ(backend.metricsQueries, 2);
+    WD_EXPECT_EQ(backend.placementQueries, 2);
+    WD_EXPECT_EQ(geometry.dpi, 144u);
+    WD_EXPECT_EQ(geometry.borderWidth, 18);
+    WD_EXPECT_EQ(geometry.windowWidth, 1920);
+    WD_EXPECT_EQ(geometry.windowHeight, 1200);
+}
+
+void TestInvalidateAll() {
+    FrameGeometryCache cache;
+    FakeBackend backend;
+    backend.Get(cache);
+
+    cache.InvalidateAll();
+    backend.Get(cache);
+    backend.Get(cache);
+
+    WD_EXPECT_EQ(backend.metricsQueries, 2);
+    WD_EXPECT_EQ(backend.placementQueries, 2);
+    WD_EXPECT_EQ(cache.generation(), 2u);
+}
+
+}  // namespace
+
+int main() {
+    TestComposesGeometry();
+    TestLookupsBetweenEventsAreCached();
+    TestPlacementEventsKeepMetrics();
+    TestSettingChangeKeepsPlacement();
+    TestDpiChangeRefreshesEverything();
+    TestInvalidateAll();
+    return test::TestExitCode();
+}
@@ -0,0 +1,251 @@
+// Window Decoration Core - Monitor topology test
+// Fixture monitor layouts (a single laptop panel, mixed DPI with negative
+// coordinates and a portrait monitor, a 4x2 wall with a mirrored primary,
+// and six staggered monitors with gaps):
+//
+//   - known lookups on each fixture, including gaps and off-screen points
+//   - FindAt / FindNearest / FindForRect agree with a linear scan for random
+//     points and rects
+//   - Update() reports only real changes and handles hotplug
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "test_util.h"
+#include "window_decoration_core/monitor_topology.h"
+
+using namespace window_decoration;
+
+namespace {
+
+struct Fixture {
+    const char* name;
+    std::vector<MonitorInfo> monitors;
+};
+
+MonitorInfo Monitor(uint64_t id, int left, int top, int width, int height, uint32_t dpi,
+                    int taskbar = 0, uint32_t flags = 0) {
+    MonitorInfo monitor = {};
+    monitor.id = id;
+    monitor.bounds = { left, top, left + width, top + height };
+    monitor.workArea = { left, top, left + width, top + height - taskbar };
+    monitor.dpi = dpi;
+    monitor.flags = flags;
+    return monitor;
+}
+
+Fixture Single() {
+    return { "single", { Monitor(1, 0, 0, 1920, 1080, 120, 48, MONITOR_PRIMARY) } };
+}
+
+// 4K at 200% as primary, a 1080p monitor to the right and lower, an old 5:4
+// monitor to the left (negative x) and a portrait one on the far right,
+// raised above the primary (negative y)
+Fixture MixedDpi() {
+    return { "mixed-dpi", {
+        Monitor(10, 0, 0, 3840, 2160, 192, 96, MONITOR_PRIMARY),
+        Monitor(11, 3840, 540, 1920, 1080, 96, 40),
+        Monitor(12, -1280, 0, 1280, 1024, 96),
+        Monitor(13, 5760, -400, 1080, 1920, 120),
+    } };
+}
+
+// 4x2 wall of 1440p monitors around the origin, plus a projector that
+// mirrors the primary (same bounds, later in the list)
+Fixture Wall() {
+    std::vector<MonitorInfo> wall;
+    for (int row = 0; row < 2; row++) {
+        for (int column = 0; column < 4; column++) {
+            bool primary = row == 1 && column == 2;
+            wall.push_back(Monitor(20 + row * 4 + column, -5120 + column * 2560, -1440 + row * 1440, 2560, 1440,
+                                   primary ? 144 : 96, primary ? 60 : 0, primary ? MONITOR_PRIMARY : 0));
+        }
+    }
+    wall.push_back(Monitor(30, 0, 0, 2560, 1440, 96));
+    return { "wall", wall };
+}
+
+// Six monitors of different sizes with gaps and vertical offsets
+Fixture Staggered() {
+    return { "staggered", {
+        Monitor(40, -4000, 200, 1600, 900, 96),
+        Monitor(41, -2300, -300, 1920, 1200, 120),
+        Monitor(42, 0, 0, 2560, 1600, 168, 56, MONITOR_PRIMARY),
+        Monitor(43, 2600, 300, 1366, 768, 96, 30),
+        Monitor(44, 4000, -1000, 1200, 1920, 96),
+        Monitor(45, 5200, 0, 3440, 1440, 120),
+    } };
+}
+
+// Reference lookups: linear scans with the documented tie-breaks
+int ScanAt(const std::vector<MonitorInfo>& monitors, int x, int y) {
+    for (size_t i = 0; i < monitors.size(); i++) {
+        if (PointInRect(x, y, monitors[i].bounds)) {
+            return static_cast<int>(i);
+        }
+    }
+    return MonitorTopology::kNone;
+}
+
+int64_t ScanDistance(int x, int y, const Rect& rect) {
+    int64_t dx = x < rect.left ? rect.left - x : x >= rect.right ? x - rect.right + 1 : 0;
+    int64_t dy = y < rect.top ? rect.top - y : y >= rect.bottom ? y - rect.bottom + 1 : 0;
+    return dx * dx + dy * dy;
+}
+
+int ScanNearest(const std::vector<MonitorInfo>& monitors, int x, int y) {
+    int best = MonitorTopology::kNone;
+    int64_t bestDistance = INT64_MAX;
+    for (size_t i = 0; i < monitors.size(); i++) {
+        int64_t distance = ScanDistance(x, y, monitors[i].bounds);
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+int ScanForRect(const std::vector<MonitorInfo>& monitors, const Rect& rect) {
+    int best = MonitorTopology::kNone;
+    int64_t bestArea = 0;
+    for (size_t i = 0; i < monitors.size(); i++) {
+        const Rect& bounds = monitors[i].bounds;
+        int64_t width = static_cast<int64_t>(std::min(rect.right, bounds.right)) - std::max(rect.left, bounds.left);
+        int64_t height = static_cast<int64_t>(std::min(rect.bottom, bounds.bottom)) - std::max(rect.top, bounds.top);
+        int64_t area = width > 0 && height > 0 ? width * height : 0;
+        if (area > bestArea) {
+            bestArea = area;
+            best = static_cast<int>(i);
+        }
+    }
+    return best != MonitorTopology::kNone
+        ? best
+        : ScanNearest(monitors, rect.left + (rect.right - rect.left) / 2, rect.top + (rect.bottom - rect.top) / 2);
+}
+
+// Deterministic xorshift generator
+struct Random {
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+
+    int Range(int min, int max) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return min + static_cast<int>(static_cast<uint32_t>(state >> 32) % static_cast<uint32_t>(max - min));
+    }
+};
+
+void TestKnownLookups() {
+    Fixture mixed = MixedDpi();
+    MonitorTopology topology;
+    WD_EXPECT(topology.Update(mixed.monitors.data(), mixed.monitors.size()));
+    WD_EXPECT_EQ(topology.size(), 4u);
+    WD_EXPECT_EQ(topology.primary(), 0);
+    WD_EXPECT_EQ(topology.FindById(12), 2);
+    WD_EXPECT_EQ(topology.FindById(99), MonitorTopology::kNone);
+
+    WD_EXPECT_EQ(topology.FindAt(-1, 0), 2);
+    WD_EXPECT_EQ(topology.FindAt(0, 0), 0);
+    WD_EXPECT_EQ(topology.FindAt(3840, 540), 1);
+    WD_EXPECT_EQ(topology.FindAt(6000, -300), 3);
+
+    // Gaps: below the 5:4 monitor, above the 1080p one
+    WD_EXPECT_EQ(topology.FindAt(-600, 1100), MonitorTopology::kNone);
+    WD_EXPECT_EQ(topology.FindNearest(-600, 1100), 2);
+    WD_EXPECT_EQ(topology.FindNearest(-100, 1500), 0);
+    WD_EXPECT_EQ(topology.FindAt(4500, 100), MonitorTopology::kNone);
+    WD_EXPECT_EQ(topology.FindNearest(4500, 100), 1);
+    WD_EXPECT_EQ(topology.FindNearest(-100000, -100000), 2);
+
+    // Mostly on the 4K monitor, and one off-screen to the right
+    WD_EXPECT_EQ(topology.FindForRect({ 3000, 600, 4200, 1400 }), 0);
+    WD_EXPECT_EQ(topology.FindForRect({ 20000, 0, 20100, 100 }), 3);
+
+    // The mirrored primary resolves to the first monitor in the list
+    Fixture wall = Wall();
+    MonitorTopology wallTopology;
+    wallTopology.Update(wall.monitors.data(), wall.monitors.size());
+    WD_EXPECT_EQ(wallTopology.FindAt(100, 100), 6);
+    WD_EXPECT_EQ(wallTopology.FindForRect({ 0, 0, 2560, 1440 }), 6);
+    WD_EXPECT_EQ(wallTopology.primary(), 6);
+    WD_EXPECT_EQ(wallTopology.FindAt(-5120, -1440), 0);
+}
+
+void TestMatchesScan(const Fixture& fixture) {
+    const std::vector<MonitorInfo>& monitors = fixture.monitors;
+    MonitorTopology topology;
+    topology.Update(monitors.data(), monitors.size());
+
+    Rect box = monitors[0].bounds;
+    for (const MonitorInfo& monitor : monitors) {
+        box.left = std::min(box.left, monitor.bounds.left);
+        box.top = std::min(box.top, monitor.bounds.top);
+        box.right = std::max(box.right, monitor.bounds.right);
+        box.bottom = std::max(box.bottom, monitor.bounds.bottom);
+    }
+
+    Random random;
+    int mismatches = 0;
+    for (int i = 0; i < 50000; i++) {
+        int x = random.Range(box.left - 500, box.right + 500);
+        int y = random.Range(box.top - 500, box.bottom + 500);
+        mismatches += topology.FindAt(x, y) != ScanAt(monitors, x, y) ? 1 : 0;
+        mismatches += topology.FindNearest(x, y) != ScanNearest(monitors, x, y) ? 1 : 0;
+
+        Rect rect = { x, y, x + random.Range(1, 3000), y + random.Range(1, 2000) };
+        mismatches += topology.FindForRect(rect) != ScanForRect(monitors, rect) ? 1 : 0;
+    }
+    if (mismatches != 0) {
+        std::fprintf(stderr, "%s: %d lookups differ from a linear scan\n", fixture.name, mismatches);
+    }
+    WD_EXPECT_EQ(mismatches, 0);
+}
+
+// No change, a settings change (work area, DPI) and hotplug
+void TestUpdates() {
+    std::vector<MonitorInfo> monitors = Staggered().monitors;
+    MonitorTopology topology;
+    WD_EXPECT(topology.Update(monitors.data(), monitors.size()));
+    uint64_t generation = topology.generation();
+    WD_EXPECT(!topology.Update(monitors.data(), monitors.size()));
+    WD_EXPECT_EQ(topology.generation(), generation);
+
+    monitors[2].workArea.bottom -= 20;
+    monitors[4].dpi = 144;
+    WD_EXPECT(topology.Update(monitors.data(), monitors.size()));
+    WD_EXPECT(topology.generation() != generation);
+    WD_EXPECT_EQ(topology.monitor(2).workArea.bottom, monitors[2].workArea.bottom);
+    WD_EXPECT_EQ(topology.monitor(4).dpi, 144u);
+
+    // Unplug the primary: the first monitor becomes the fallback primary
+    monitors.erase(monitors.begin() + 2);
+    WD_EXPECT(topology.Update(monitors.data(), monitors.size()));
+    WD_EXPECT_EQ(topology.primary(), 0);
+    WD_EXPECT_EQ(topology.FindAt(100, 100), MonitorTopology::kNone);
+    WD_EXPECT_EQ(topology.FindNearest(100, 100), ScanNearest(monitors, 100, 100));
+
+    // Plug a monitor into the gap
+    monitors.push_back(Monitor(46, 0, 0, 1920, 1080, 96));
+    WD_EXPECT(topology.Update(monitors.data(), monitors.size()));
+    WD_EXPECT_EQ(topology.FindAt(100, 100), static_cast<int>(monitors.size() - 1));
+
+    // Everything unplugged
+    WD_EXPECT(topology.Update(nullptr, 0));
+    WD_EXPECT_EQ(topology.primary(), MonitorTopology::kNone);
+    WD_EXPECT_EQ(topology.FindNearest(0, 0), MonitorTopology::kNone);
+    WD_EXPECT_EQ(topology.FindForRect({ 0, 0, 10, 10 }), MonitorTopology::kNone);
+}
+
+}  // namespace
+
+int main() {
+    TestKnownLookups();
+    TestMatchesScan(Single());
+    TestMatchesScan(MixedDpi());
+    TestMatchesScan(Wall());
+    TestMatchesScan(Staggered());
+    TestUpdates();
+    return test::TestExitCode();
+}
@@ -0,0 +1,176 @@
+// Window Decoration Core - Resize pacer test
+// Checks ResizePacer's contract: only the first request of a frame asks
+// for a frame to be scheduled, a take gives out the newest size once,
+// superseded and reset sizes are counted as skipped, and the latency
+// counters follow the newest input. Then replays the benchmark's simulated
+// 1000 Hz resize drag at 60 Hz against a fast and a slow relayout: the
+// drag must end on the last size, apply at most once per frame, account
+// for every request and stay within two frames plus a relayout.
+
+#include "window_decoration_core/resize_pacer.h"
+
+#include <random>
+
+#include "test_util.h"
+
+using namespace window_decoration;
+
+namespace {
+
+const uint64_t kMs = 1000000;
+const uint64_t kFrameInterval = 16666667;
+
+void TestRequestAndTake() {
+    ResizePacer pacer;
+    int32_t width = -1;
+    int32_t height = -1;
+    WD_EXPECT(!pacer.pending());
+    WD_EXPECT(!pacer.Take(0, &width, &height));
+    WD_EXPECT(width == -1 && height == -1);
+
+    // The first request schedules a frame, later ones replace its size
+    WD_EXPECT(pacer.Request(800, 600, 10));
+    WD_EXPECT(pacer.pending());
+    WD_EXPECT(!pacer.Request(810, 605, 20));
+    WD_EXPECT(!pacer.Request(820, 610, 30));
+
+    WD_EXPECT(pacer.Take(50, &width, &height));
+    WD_EXPECT(width == 820 && height == 610);
+    WD_EXPECT(!pacer.pending());
+    WD_EXPECT(!pacer.Take(60, &width, &height));
+
+    const ResizePacingStats& stats = pacer.stats();
+    WD_EXPECT_EQ(stats.requests, 3u);
+    WD_EXPECT_EQ(stats.applied, 1u);
+    WD_EXPECT_EQ(stats.skipped, 2u);
+    WD_EXPECT_EQ(stats.lastLatencyNs, 20u);
+
+    // After a take the next request schedules again
+    WD_EXPECT(pacer.Request(900, 700, 100));
+    WD_EXPECT(pacer.Take(200, &width, &height));
+    WD_EXPECT(width == 900 && height == 700);
+    WD_EXPECT_EQ(stats.lastLatencyNs, 100u);
+    WD_EXPECT_EQ(stats.maxLatencyNs, 100u);
+    WD_EXPECT_EQ(stats.totalLatencyNs, 120u);
+
+    // A frame clock behind the input time reads as no latency
+    WD_EXPECT(pacer.Request(1, 1, 1000));
+    WD_EXPECT(pacer.Take(500, &width, &height));
+    WD_EXPECT_EQ(stats.lastLatencyNs, 0u);
+    WD_EXPECT_EQ(stats.maxLatencyNs, 100u);
+}
+
+void TestReset() {
+    ResizePacer pacer;
+    pacer.Reset();
+    WD_EXPECT_EQ(pacer.stats().skipped, 0u);
+
+    pacer.Request(800, 600, 0);
+    pacer.Reset();
+    WD_EXPECT(!pacer.pending());
+    WD_EXPECT_EQ(pacer.stats().skipped, 1u);
+    int32_t width;
+    int32_t height;
+    WD_EXPECT(!pacer.Take(10, &width, &height));
+
+    // Reset twice counts once; the next request schedules a frame
+    pacer.Reset();
+    WD_EXPECT_EQ(pacer.stats().skipped, 1u);
+    WD_EXPECT(pacer.Request(640, 480, 20));
+    WD_EXPECT_EQ(pacer.stats().requests, 2u);
+    WD_EXPECT_EQ(pacer.stats().applied + pacer.stats().skipped + (pacer.pending() ? 1u : 0u),
+                 pacer.stats().requests);
+}
+
+// Random interleavings: every request is applied, skipped or still
+// pending, and each take returns the latest request since the last one
+void TestAccounting() {
+    std::mt19937 random(1);
+    ResizePacer pacer;
+    int32_t latest = 0;
+    bool pending = false;
+    uint64_t now = 0;
+    int mismatches = 0;
+    for (int step = 0; step < 200000; step++) {
+        now += random() % 1000;
+        switch (random() % 4) {
+            case 0:
+            case 1:
+                latest = static_cast<int32_t>(step);
+                mismatches += pacer.Request(latest, -latest, now) == pending ? 1 : 0;
+                pending = true;
+                break;
+            case 2: {
+                int32_t width = 0;
+                int32_t height = 0;
+                bool taken = pacer.Take(now, &width, &height);
+                mismatches += taken != pending || (taken && (width != latest || height != -latest)) ? 1 : 0;
+                pending = false;
+                break;
+            }
+            default:
+                if (random() % 8 == 0) {
+                    pacer.Reset();
+                    pending = false;
+                }
+                break;
+        }
+        const ResizePacingStats& stats = pacer.stats();
+        mismatches += pacer.pending() != pending ? 1 : 0;
+        mismatches += stats.applied + stats.skipped + (pending ? 1 : 0) != stats.requests ? 1 : 0;
+    }
+    WD_EXPECT_EQ(mismatches, 0);
+    WD_EXPECT(pacer.stats().totalLatencyNs >= pacer.stats().maxLatencyNs);
+}
+
+// The benchmark's drag: a new size every millisecond for one second, a
+// frame tick every 16.7 ms that takes the newest size if the previous
+// relayout is done
+void TestSimulatedDrag(uint64_t relayoutNs) {
+    const int kInputs = 1000;
+    ResizePacer pacer;
+    uint64_t busyUntil = 0;
+    uint64_t frames = 0;
+    int32_t lastWidth = 0;
+    int32_t lastHeight = 0;
+    int next = 1;
+
+    for (uint64_t frame = kFrameInterval; next <= kInputs || pacer.pending(); frame += kFrameInterval) {
+        for (; next <= kInputs && static_cast<uint64_t>(next) * kMs <= frame; next++) {
+            pacer.Request(800 + next / 2, 600 + next / 3, static_cast<uint64_t>(next) * kMs);
+        }
+        frames++;
+        if (busyUntil > frame) {
+            continue;
+        }
+        int32_t width;
+        int32_t height;
+        if (pacer.Take(frame, &width, &height)) {
+            // Sizes never go back to an older input
+            WD_EXPECT(width >= lastWidth && height >= lastHeight);
+            busyUntil = frame + relayoutNs;
+            lastWidth = width;
+            lastHeight = height;
+        }
+    }
+
+    const ResizePacingStats& stats = pacer.stats();
+    WD_EXPECT_EQ(lastWidth, 800 + kInputs / 2);
+    WD_EXPECT_EQ(lastHeight, 600 + kInputs / 3);
+    WD_EXPECT_EQ(stats.requests, static_cast<uint64_t>(kInputs));
+    WD_EXPECT_EQ(stats.applied + stats.skipped, stats.requests);
+    WD_EXPECT(stats.applied <= frames);
+    WD_EXPECT(stats.applied > 0);
+    WD_EXPECT(stats.maxLatencyNs <= 2 * kFrameInterval + relayoutNs);
+}
+
+}  // namespace
+
+int main() {
+    TestRequestAndTake();
+    TestReset();
+    TestAccounting();
+    TestSimulatedDrag(2 * kMs);
+    TestSimulatedDrag(25 * kMs);
+    return test::TestExitCode();
+}
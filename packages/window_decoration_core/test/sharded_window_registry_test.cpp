@@ -0,0 +1,241 @@
+// Window Decoration Core - Sharded window registry test
+// Checks the first/last window reporting and shard ownership, that a
+// retired shard is gone for a thread that later reuses its id, then churns
+// windows across 16 UI threads concurrently: each thread must only ever see
+// its own windows with their own state, and every surviving window must
+// still be reachable at the end.
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "test_util.h"
+#include "window_decoration_core/sharded_window_registry.h"
+
+using namespace window_decoration;
+
+namespace {
+
+struct HotState {
+    uintptr_t owner;
+    uint64_t messages;
+};
+
+struct ColdState {
+    uintptr_t handle;
+};
+
+struct ThreadState {
+    bool hookInstalled;
+};
+
+typedef void* Handle;
+typedef ShardedWindowRegistry<Handle, HotState, ColdState, ThreadState> Registry;
+
+const int kThreads = 16;
+const int kStepsPerThread = 50000;
+
+// Handles of thread t are disjoint from every other thread's
+Handle MakeHandle(int thread, int index) {
+    return reinterpret_cast<Handle>((static_cast<uintptr_t>(thread + 1) << 24) + 2 * static_cast<uintptr_t>(index) + 2);
+}
+
+void TestFirstAndLastWindowOnThread() {
+    Registry registry;
+
+    Registry::Registration first = registry.Register(1, MakeHandle(0, 1));
+    WD_EXPECT(first.firstOnThread);
+    WD_EXPECT(first.slot != Registry::kNoSlot);
+    WD_EXPECT_EQ(first.shard->owner, 1u);
+    WD_EXPECT(!first.shard->thread.hookInstalled);
+
+    Registry::Registration second = registry.Register(1, MakeHandle(0, 2));
+    WD_EXPECT(!second.firstOnThread);
+    WD_EXPECT_EQ(second.shard, first.shard);
+
+    // Registering again returns the existing slot
+    Registry::Registration again = registry.Register(1, MakeHandle(0, 1));
+    WD_EXPECT(!again.firstOnThread);
+    WD_EXPECT_EQ(again.slot, first.slot);
+
+    WD_EXPECT(!registry.Unregister(1, MakeHandle(0, 1)));
+    WD_EXPECT(!registry.Unregister(1, MakeHandle(0, 1)));
+    WD_EXPECT(registry.Unregister(1, MakeHandle(0, 2)));
+
+    // The thread's next window is its first again
+    WD_EXPECT(registry.Register(1, MakeHandle(0, 3)).firstOnThread);
+    WD_EXPECT_EQ(registry.shardCount(), 1u);
+}
+
+void TestNullKeyIsNotRegistered() {
+    Registry registry;
+    Registry::Registration registration = registry.Register(1, nullptr);
+    WD_EXPECT_EQ(registration.slot, Registry::kNoSlot);
+    WD_EXPECT(!registration.firstOnThread);
+}
+
+void TestThreadCacheIsPerRegistry() {
+    // The calling thread's cached shard must not leak between registries
+    Registry a;
+    Registry b;
+    Registry::Shard* shardA = a.CurrentShard(1);
+    Registry::Shard* shardB = b.CurrentShard(1);
+    WD_EXPECT(shardA != shardB);
+    WD_EXPECT_EQ(a.CurrentShard(1), shardA);
+
+    a.Register(1, MakeHandle(0, 1));
+    WD_EXPECT_EQ(shardA->windows.size(), 1u);
+    WD_EXPECT(shardB->windows.empty());
+}
+
+// A thread retires its shard with its last window; the same thread, and a
+// new thread handed the same OS id, then start from a fresh shard
+void TestRetireAndReuseThreadId() {
+    Registry registry;
+    Registry::Registration registration = registry.Register(7, MakeHandle(0, 1));
+    registration.shard->thread.hookInstalled = true;
+    registry.Register(7, MakeHandle(0, 2));
+
+    // Not while windows are left, nor for a thread without a shard
+    WD_EXPECT(!registry.Retire(7));
+    WD_EXPECT(!registry.Retire(8));
+    WD_EXPECT_EQ(registry.shardCount(), 1u);
+
+    registry.Unregister(7, MakeHandle(0, 1));
+    WD_EXPECT(registry.Unregister(7, MakeHandle(0, 2)));
+    WD_EXPECT(registry.Retire(7));
+    WD_EXPECT_EQ(registry.shardCount(), 0u);
+    WD_EXPECT(!registry.Retire(7));
+
+    // The calling thread's cached shard went with it
+    Registry::Registration again = registry.Register(7, MakeHandle(0, 1));
+    WD_EXPECT(again.firstOnThread);
+    WD_EXPECT_EQ(again.shard->owner, 7u);
+    WD_EXPECT(!again.shard->thread.hookInstalled);
+    again.shard->thread.hookInstalled = true;
+    WD_EXPECT(registry.Unregister(7, MakeHandle(0, 1)));
+    WD_EXPECT(registry.Retire(7));
+
+    // A new thread with the reused id
+    bool fresh = false;
+    std::thread reused([&]() {
+        Registry::Registration registration = registry.Register(7, MakeHandle(1, 1));
+        fresh = registration.firstOnThread && !registration.shard->thread.hookInstalled &&
+                registration.shard->windows.size() == 1;
+    });
+    reused.join();
+    WD_EXPECT(fresh);
+    WD_EXPECT_EQ(registry.shardCount(), 1u);
+
+    // Without retiring, a reused id finds the old shard and its state
+    Registry::Shard* old = registry.CurrentShard(9);
+    old->thread.hookInstalled = true;
+    Registry::Shard* inherited = nullptr;
+    std::thread stale([&]() { inherited = registry.CurrentShard(9); });
+    stale.join();
+    WD_EXPECT_EQ(inherited, old);
+}
+
+// One UI thread: mostly message lookups, with windows created and destroyed.
+// Returns the number of violations.
+uint64_t Churn(Registry* registry, int thread) {
+    Registry::ThreadId self = static_cast<Registry::ThreadId>(thread + 1);
+    uint64_t random = 0x9E3779B97F4A7C15ull + static_cast<uint64_t>(thread) * 0x2545F4914F6CDD1Dull;
+    auto next = [&random](int bound) {
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        return static_cast<int>((random >> 32) % static_cast<uint64_t>(bound));
+    };
+
+    std::vector<Handle> live;
+    uint64_t errors = 0;
+
+    for (int step = 0; step < kStepsPerThread; step++) {
+        int action = next(16);
+        if (live.empty() || action == 0) {
+            Handle handle = MakeHandle(thread, next(1 << 16));
+            if (registry->CurrentShard(self)->windows.Find(handle) != Registry::kNoSlot) {
+                continue;
+            }
+            Registry::Registration registration = registry->Register(self, handle);
+            if (registration.firstOnThread != live.empty() || registration.shard->owner != self) {
+                errors++;
+            }
+            if (registration.firstOnThread) {
+                registration.shard->thread.hookInstalled = true;
+            }
+            registration.shard->windows.hot(registration.slot).owner = static_cast<uintptr_t>(self);
+            registration.shard->windows.cold(registration.slot).handle = reinterpret_cast<uintptr_t>(handle);
+            live.push_back(handle);
+        } else if (action == 1) {
+            size_t index = static_cast<size_t>(next(static_cast<int>(live.size())));
+            bool lastOnThread = registry->Unregister(self, live[index]);
+            live[index] = live.back();
+            live.pop_back();
+            if (lastOnThread != live.empty()) {
+                errors++;
+            }
+            // The last window takes the hook with it, and sometimes the shard
+            if (lastOnThread) {
+                registry->CurrentShard(self)->thread.hookInstalled = false;
+                if (next(2) == 0 && !registry->Retire(self)) {
+                    errors++;
+                }
+            }
+        } else {
+            // A message for one of this thread's windows
+            Handle handle = live[static_cast<size_t>(next(static_cast<int>(live.size())))];
+            Registry::Shard* shard = registry->CurrentShard(self);
+            uint32_t slot = shard->windows.Find(handle);
+            if (slot == Registry::kNoSlot ||
+                shard->windows.hot(slot).owner != static_cast<uintptr_t>(self) ||
+                shard->windows.cold(slot).handle != reinterpret_cast<uintptr_t>(handle) ||
+                !shard->thread.hookInstalled) {
+                errors++;
+            } else {
+                shard->windows.hot(slot).messages++;
+            }
+        }
+    }
+
+    Registry::Shard* shard = registry->CurrentShard(self);
+    for (Handle handle : live) {
+        uint32_t slot = shard->windows.Find(handle);
+        if (slot == Registry::kNoSlot || shard->windows.cold(slot).handle != reinterpret_cast<uintptr_t>(handle)) {
+            errors++;
+        }
+    }
+    if (shard->windows.size() != live.size() || shard->owner != self) {
+        errors++;
+    }
+    return errors;
+}
+
+void TestConcurrentChurn() {
+    Registry registry;
+    std::vector<uint64_t> errors(kThreads, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; t++) {
+        threads.emplace_back([&, t]() { errors[t] = Churn(&registry, t); });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (int t = 0; t < kThreads; t++) {
+        WD_EXPECT_EQ(errors[t], 0u);
+    }
+    WD_EXPECT_EQ(registry.shardCount(), static_cast<size_t>(kThreads));
+}
+
+}  // namespace
+
+int main() {
+    TestFirstAndLastWindowOnThread();
+    TestNullKeyIsNotRegistered();
+    TestThreadCacheIsPerRegistry();
+    TestRetireAndReuseThreadId();
+    TestConcurrentChurn();
+    return test::TestExitCode();
+}
@@ -0,0 +1,406 @@
+// Window Decoration Core - Shared window registry test (Linux)
+// Checks slot ownership and layout validation on a memfd mapping, then has
+// a forked writer process republish its windows a fixed number of times
+// while this process reads them. Every snapshot read must be internally
+// consistent, and the writer's slots must be reclaimable after it exits
+// without releasing them. Crash recovery: a process killed while
+// initializing the mapping must not keep others from opening it, the slots
+// of exited processes are swept, and concurrent sweepers release each slot
+// exactly once.
+
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#include "test_util.h"
+#include "window_decoration_core/shared_window_registry.h"
+
+using namespace window_decoration;
+
+namespace {
+
+const uint32_t kSlots = 16;
+const int kWriterWindows = 4;
+const uint32_t kWriterGenerations = 200000;
+
+// Payload of `window` at generation g. Every field depends on g so a
+// reader can tell if it sees parts of two different publishes.
+SharedWindowInfo MakeInfo(uint64_t window, uint32_t g) {
+    SharedWindowInfo info = {};
+    info.window = window;
+    info.frameMode = static_cast<int32_t>(g % 3);
+    info.bounds = { static_cast<int>(g), static_cast<int>(g) + 1, static_cast<int>(g) + 800, static_cast<int>(g) + 600 };
+    info.dpi = 96 + g % 4 * 24;
+    info.captionHeight = static_cast<int32_t>(g);
+    info.regionCount = 1 + g % MAX_SHARED_CAPTION_REGIONS;
+    for (uint32_t i = 0; i < info.regionCount; i++) {
+        info.regions[i].bounds = { static_cast<int>(g + i), 0, static_cast<int>(g + i) + 40, 32 };
+        info.regions[i].hit = static_cast<int32_t>(HitCode::Client);
+    }
+    return info;
+}
+
+bool IsConsistent(const SharedWindowInfo& info) {
+    uint32_t g = static_cast<uint32_t>(info.captionHeight);
+    SharedWindowInfo expected = MakeInfo(info.window, g);
+    expected.processId = info.processId;
+    return std::memcmp(&expected, &info, sizeof(info)) == 0;
+}
+
+// A zero-filled shared mapping backed by a memfd
+struct SharedMapping {
+    explicit SharedMapping(size_t bytes) : fd(memfd_create("window_decoration_registry_test", 0)), size(bytes) {
+        memory = fd >= 0 && ftruncate(fd, static_cast<off_t>(size)) == 0 ? Map() : nullptr;
+    }
+    ~SharedMapping() {
+        if (memory != nullptr) {
+            munmap(memory, size);
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+
+    // A second mapping of the same memory, as another process would see it
+    void* Map() const {
+        void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        return mapped == MAP_FAILED ? nullptr : mapped;
+    }
+
+    int fd;
+    size_t size;
+    void* memory;
+};
+
+void TestOpenValidatesLayout() {
+    size_t size = SharedWindowRegistry::RequiredBytes(kSlots);
+    SharedMapping mapping(size);
+    WD_EXPECT(mapping.memory != nullptr);
+
+    SharedWindowRegistry registry;
+    WD_EXPECT(!registry.Open(mapping.memory, size - 1, kSlots));
+    WD_EXPECT(!registry.Open(mapping.memory, size, 0));
+    WD_EXPECT(!registry.Open(nullptr, size, kSlots));
+    WD_EXPECT(!registry.isOpen());
+
+    WD_EXPECT(registry.Open(mapping.memory, size, kSlots));
+    WD_EXPECT_EQ(registry.slotCount(), kSlots);
+
+    // A later process takes the slot count from the header
+    void* second = mapping.Map();
+    SharedWindowRegistry attached;
+    WD_EXPECT(attached.Open(second, size, 1));
+    WD_EXPECT_EQ(attached.slotCount(), kSlots);
+    munmap(second, size);
+
+    // An incompatible major version is rejected (state, magic, then the
+    // major version at byte 8)
+    uint16_t major = SHARED_REGISTRY_MAJOR_VERSION + 1;
+    std::memcpy(static_cast<unsigned char*>(mapping.memory) + 8, &major, sizeof(major));
+    SharedWindowRegistry newer;
+    WD_EXPECT(!newer.Open(mapping.memory, size, kSlots));
+}
+
+void TestSlotOwnership() {
+    size_t size = SharedWindowRegistry::RequiredBytes(kSlots);
+    SharedMapping mapping(size);
+    SharedWindowRegistry registry;
+    WD_EXPECT(registry.Open(mapping.memory, size, kSlots));
+
+    WD_EXPECT_EQ(registry.Claim(0, 0x10), -1);
+    WD_EXPECT_EQ(registry.Claim(1, 0), -1);
+
+    int slot = registry.Claim(1, 0x10);
+    WD_EXPECT(slot >= 0);
+
+    // Claimed but not yet published
+    SharedWindowInfo info;
+    WD_EXPECT(!registry.Read(slot, &info));
+
+    // Only the owner may publish or release
+    WD_EXPECT(!registry.Publish(slot, 2, MakeInfo(0x10, 1)));
+    WD_EXPECT(registry.Publish(slot, 1, MakeInfo(0x10, 1)));
+    WD_EXPECT(registry.Read(slot, &info));
+    WD_EXPECT_EQ(info.processId, 1u);
+    WD_EXPECT(IsConsistent(info));
+    registry.Release(slot, 2);
+    WD_EXPECT(registry.Read(slot, &info));
+
+    // Region counts past the limit are clamped
+    SharedWindowInfo many = MakeInfo(0x10, 1);
+    many.regionCount = MAX_SHARED_CAPTION_REGIONS + 5;
+    WD_EXPECT(registry.Publish(slot, 1, many));
+    WD_EXPECT(registry.Read(slot, &info));
+    WD_EXPECT_EQ(info.regionCount, MAX_SHARED_CAPTION_REGIONS);
+
+    registry.Release(slot, 1);
+    WD_EXPECT(!registry.Read(slot, &info));
+    WD_EXPECT_EQ(registry.Claim(3, 0x30), slot);
+}
+
+void TestFullRegistry() {
+    size_t size = SharedWindowRegistry::RequiredBytes(kSlots);
+    SharedMapping mapping(size);
+    SharedWindowRegistry registry;
+    WD_EXPECT(registry.Open(mapping.memory, size, kSlots));
+
+    for (uint32_t i = 0; i < kSlots; i++) {
+        int slot = registry.Claim(1, 0x100 + i);
+        WD_EXPECT(slot >= 0);
+        registry.Publish(slot, 1, MakeInfo(0x100 + i, i + 1));
+    }
+    WD_EXPECT_EQ(registry.Claim(2, 0x200), -1);
+
+    SharedWindowInfo windows[kSlots];
+    WD_EXPECT_EQ(registry.ReadAll(windows, kSlots), kSlots);
+    WD_EXPECT_EQ(registry.ReadAll(windows, 3), 3u);
+    WD_EXPECT_EQ(registry.ReleaseProcess(1), kSlots);
+    WD_EXPECT_EQ(registry.ReadAll(windows, kSlots), 0u);
+}
+
+// Writer process: attach through its own mapping, publish, and exit
+// without releasing its slots, like a crashed process
+void RunWriter(const SharedMapping& mapping) {
+    SharedWindowRegistry registry;
+    void* memory = mapping.Map();
+    if (memory == nullptr || !registry.Open(memory, mapping.size, kSlots)) {
+        _exit(2);
+    }
+
+    uint32_t processId = static_cast<uint32_t>(getpid());
+    int slots[kWriterWindows];
+    for (int i = 0; i < kWriterWindows; i++) {
+        slots[i] = registry.Claim(processId, 0x1000 + i);
+        if (slots[i] < 0) {
+            _exit(3);
+        }
+    }
+    for (uint32_t g = 1; g <= kWriterGenerations; g++) {
+        for (int i = 0; i < kWriterWindows; i++) {
+            registry.Publish(slots[i], processId, MakeInfo(0x1000 + i, g));
+        }
+    }
+    _exit(0);
+}
+
+void TestCrossProcessReads() {
+    size_t size = SharedWindowRegistry::RequiredBytes(kSlots);
+    SharedMapping mapping(size);
+    SharedWindowRegistry registry;
+    WD_EXPECT(registry.Open(mapping.memory, size, kSlots));
+
+    uint32_t self = static_cast<uint32_t>(getpid());
+    int ownSlot = registry.Claim(self, 0x42);
+    registry.Publish(ownSlot, self, MakeInfo(0x42, 7));
+
+    pid_t writer = fork();
+    if (writer == 0) {
+        RunWriter(mapping);
+    }
+    WD_EXPECT(writer > 0);
+    if (writer <= 0) {
+        return;
+    }
+
+    uint64_t reads = 0;
+    uint64_t torn = 0;
+    SharedWindowInfo windows[kSlots];
+    int status = 0;
+    while (waitpid(writer, &status, WNOHANG) == 0) {
+        uint32_t count = registry.ReadAll(windows, kSlots);
+        for (uint32_t i = 0; i < count; i++) {
+            torn += IsConsistent(windows[i]) ? 0 : 1;
+        }
+        reads += count;
+    }
+    WD_EXPECT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    WD_EXPECT(reads > 0);
+    WD_EXPECT_EQ(torn, 0u);
+
+    // Every writer window ends at its last generation
+    WD_EXPECT_EQ(registry.ReadAll(windows, kSlots), static_cast<uint32_t>(1 + kWriterWindows));
+    for (uint32_t i = 0; i < 1 + kWriterWindows; i++) {
+        if (windows[i].window != 0x42) {
+            WD_EXPECT_EQ(windows[i].captionHeight, static_cast<int32_t>(kWriterGenerations));
+            WD_EXPECT_EQ(windows[i].processId, static_cast<uint32_t>(writer));
+        }
+    }
+
+    // The writer exited without cleaning up; reclaim its slots
+    WD_EXPECT_EQ(registry.ReleaseProcess(static_cast<uint32_t>(writer)), static_cast<uint32_t>(kWriterWindows));
+    WD_EXPECT_EQ(registry.ReadAll(windows, kSlots), 1u);
+    WD_EXPECT_EQ(windows[0].window, 0x42u);
+}
+
+// A process killed right after it claimed the header for initialization
+// (state word at byte 0 set to initializing, magic half written). The next
+// process must take over instead of failing forever.
+void TestInitTakeover() {
+    size_t size = SharedWindowRegistry::RequiredBytes(kSlots);
+    SharedMapping mapping(size);
+    std::atomic<uint32_t>* state = static_cast<std::atomic<uint32_t>*>(mapping.memory);
+
+    pid_t initializer = fork();
+    if (initializer == 0) {
+        void* memory = mapping.Map();
+        if (memory == nullptr) {
+            _exit(2);
+        }
+        uint16_t partialMagic = 0x4457;
+        std::memcpy(static_cast<unsigned char*>(memory) + 4, &partialMagic, sizeof(partialMagic));
+        static_cast<std::atomic<uint32_t>*>(memory)->store(1);
+        for (;;) {
+            pause();
+        }
+    }
+    WD_EXPECT(initializer > 0);
+    if (initializer <= 0) {
+        return;
+    }
+    while (state->load() == 0) {
+        usleep(100);
+    }
+    kill(initializer, SIGKILL);
+    int status = 0;
+    waitpid(initializer, &status, 0);
+    WD_EXPECT(WIFSIGNALED(status));
+
+    SharedWindowRegistry registry;
+    WD_EXPECT(registry.Open(mapping.memory, size, kSlots));
+    WD_EXPECT_EQ(registry.slotCount(), kSlots);
+    int slot = registry.Claim(1, 0x10);
+    WD_EXPECT(slot >= 0);
+    WD_EXPECT(registry.Publish(slot, 1, MakeInfo(0x10, 3)));
+
+    // Others attach to the recovered header as usual
+    void* second = mapping.Map();
+    SharedWindowRegistry attached;
+    WD_EXPECT(attached.Open(second, size, 1));
+    SharedWindowInfo info;
+    WD_EXPECT(attached.Read(slot, &info));
+    WD_EXPECT(IsConsistent(info));
+    munmap(second, size);
+
+    // A state word that is no state at all is still rejected, not waited on
+    SharedMapping garbage(size);
+    static_cast<std::atomic<uint32_t>*>(garbage.memory)->store(7);
+    SharedWindowRegistry rejected;
+    WD_EXPECT(!rejected.Open(garbage.memory, size, kSlots));
+}
+
+bool IsProcessRunning(uint32_t processId) {
+    return kill(static_cast<pid_t>(processId), 0) == 0 || errno == EPERM;
+}
+
+// Processes that claim and publish windows, then exit without releasing
+// them. Returns false if one of them failed.
+bool RunDeadOwners(const SharedMapping& mapping, int processes, int windowsEach) {
+    bool ok = true;
+    for (int p = 0; p < processes; p++) {
+        pid_t child = fork();
+        if (child == 0) {
+            SharedWindowRegistry registry;
+            void* memory = mapping.Map();
+            if (memory == nullptr || !registry.Open(memory, mapping.size, kSlots)) {
+                _exit(2);
+            }
+            uint32_t processId = static_cast<uint32_t>(getpid());
+            for (int i = 0; i < windowsEach; i++) {
+                int slot = registry.Claim(processId, 0x2000 + i);
+                if (slot < 0 || !registry.Publish(slot, processId, MakeInfo(0x2000 + i, 1))) {
+                    _exit(3);
+                }
+            }
+            _exit(0);
+        }
+        int status = 0;
+        ok &= child > 0 && waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+    return ok;
+}
+
+void TestSweepDeadOwners() {
+    size_t size = SharedWindowRegistry::RequiredBytes(kSlots);
+    SharedMapping mapping(size);
+    SharedWindowRegistry registry;
+    WD_EXPECT(registry.Open(mapping.memory, size, kSlots));
+
+    uint32_t self = static_cast<uint32_t>(getpid());
+    int ownSlot = registry.Claim(self, 0x42);
+    WD_EXPECT(registry.Publish(ownSlot, self, MakeInfo(0x42, 7)));
+
+    // Three exited processes with five windows each fill the registry
+    WD_EXPECT(RunDeadOwners(mapping, 3, 5));
+    SharedWindowInfo windows[kSlots];
+    WD_EXPECT_EQ(registry.ReadAll(windows, kSlots), kSlots);
+    WD_EXPECT_EQ(registry.Claim(self, 0x43), -1);
+
+    WD_EXPECT_EQ(registry.ReleaseDeadProcesses(IsProcessRunning), 15u);
+    WD_EXPECT_EQ(registry.ReleaseDeadProcesses(IsProcessRunning), 0u);
+    WD_EXPECT_EQ(registry.ReleaseDeadProcesses(nullptr), 0u);
+    WD_EXPECT_EQ(registry.ReadAll(windows, kSlots), 1u);
+    WD_EXPECT_EQ(windows[0].window, 0x42u);
+    WD_EXPECT(registry.Claim(self, 0x43) >= 0);
+}
+
+// Several processes sweep the same dead owner at once; each of its slots
+// is released by exactly one of them and ends up free and unpublished
+void TestConcurrentSweeps() {
+    size_t size = SharedWindowRegistry::RequiredBytes(kSlots);
+    SharedMapping mapping(size);
+    SharedWindowRegistry registry;
+    WD_EXPECT(registry.Open(mapping.memory, size, kSlots));
+
+    const uint32_t kDeadOwner = 0x7FFFFFF0;
+    for (int round = 0; round < 50; round++) {
+        for (uint32_t i = 0; i < kSlots; i++) {
+            int slot = registry.Claim(kDeadOwner, 0x3000 + i);
+            WD_EXPECT(slot >= 0);
+            registry.Publish(slot, kDeadOwner, MakeInfo(0x3000 + i, round + 1));
+        }
+
+        const int kSweepers = 4;
+        pid_t sweepers[kSweepers];
+        for (int s = 0; s < kSweepers; s++) {
+            sweepers[s] = fork();
+            if (sweepers[s] == 0) {
+                SharedWindowRegistry own;
+                void* memory = mapping.Map();
+                if (memory == nullptr || !own.Open(memory, size, kSlots)) {
+                    _exit(100);
+                }
+                _exit(static_cast<int>(own.ReleaseProcess(kDeadOwner)));
+            }
+        }
+        int released = 0;
+        for (pid_t sweeper : sweepers) {
+            int status = 0;
+            waitpid(sweeper, &status, 0);
+            released += WIFEXITED(status) ? WEXITSTATUS(status) : 100;
+        }
+        WD_EXPECT_EQ(released, static_cast<int>(kSlots));
+
+        SharedWindowInfo windows[kSlots];
+        WD_EXPECT_EQ(registry.ReadAll(windows, kSlots), 0u);
+        WD_EXPECT_EQ(registry.ReleaseProcess(kDeadOwner), 0u);
+    }
+}
+
+}  // namespace
+
+int main() {
+    TestOpenValidatesLayout();
+    TestSlotOwnership();
+    TestFullRegistry();
+    TestCrossProcessReads();
+    TestInitTakeover();
+    TestSweepDeadOwners();
+    TestConcurrentSweeps();
+    return test::TestExitCode();
+}
@@ -0,0 +1,44 @@
+// Window Decoration Core - Test helpers
+// Minimal check macros so the tests have no external dependencies. A test
+// program returns TestExitCode() from main(), which CTest reads as the result.
+
+#ifndef WINDOW_DECORATION_CORE_TEST_UTIL_H_
+#define WINDOW_DECORATION_CORE_TEST_UTIL_H_
+
+#include <cstdio>
+
+namespace window_decoration {
+namespace test {
+
+// Number of failed checks in this process
+inline int g_failures = 0;
+
+inline void Fail(const char* file, int line, const char* expression) {
+    std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+    g_failures++;
+}
+
+// Print a summary and return the process exit code (1 when any check failed)
+inline int TestExitCode() {
+    if (g_failures > 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("all checks passed\n");
+    return 0;
+}
+
+}  // namespace test
+}  // namespace window_decoration
+
+// Record a failure and keep going, so one run reports every broken check
+#define WD_EXPECT(condition)                                                   \
+    do {                                                                       \
+        if (!(condition)) {                                                    \
+            ::window_decoration::test::Fail(__FILE__, __LINE__, #condition);   \
+        }                                                                      \
+    } while (0)
+
+#define WD_EXPECT_EQ(actual, expected) WD_EXPECT((actual) == (expected))
+
+#endif  // WINDOW_DECORATION_CORE_TEST_UTIL_H_
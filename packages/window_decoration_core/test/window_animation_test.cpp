@@ -0,0 +1,245 @@
+// Window Decoration Core - Window animation test
+// Runs WindowAnimation against a simulated frame clock, the way the
+// backends step it from theirs:
+//
+//   - slide: a 250 ms ease-out move on a 60 Hz display
+//   - stalled slide: the same with six frames lost to a busy UI thread
+//   - fade: a 200 ms linear fade in on a 144 Hz display
+//
+// Every animation must end exactly on its target, on time, with at most one
+// geometry call per frame; a move must never change the size, progress must
+// never go backwards and the dropped frames must match the simulated stall.
+// The curves, parameter checks and replacing a running animation are
+// checked too.
+
+#include <cmath>
+
+#include "test_util.h"
+#include "window_decoration_core/window_animation.h"
+
+using namespace window_decoration;
+
+namespace {
+
+const int64_t kMs = 1000000;
+const int64_t k60Hz = 16666667;
+const int64_t k144Hz = 6944444;
+
+struct SimResult {
+    uint64_t frames;
+    uint64_t droppedFrames;
+    uint64_t geometryCalls;
+    uint64_t opacityCalls;
+    int64_t finishedNs;  // frame time of the last frame
+};
+
+WindowAnimationParams MakeParams(const Rect& bounds, double opacity, int64_t durationNs, AnimationCurve curve,
+                                 uint32_t properties) {
+    WindowAnimationParams params;
+    params.bounds = bounds;
+    params.opacity = opacity;
+    params.durationNs = durationNs;
+    params.curve = static_cast<int32_t>(curve);
+    params.properties = properties;
+    return params;
+}
+
+bool SameRect(const Rect& a, const Rect& b) {
+    return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+}
+
+// Step an animation started at time 0 on every refresh, except the
+// refreshes in [stallFirst, stallLast] (1-based)
+SimResult Simulate(WindowAnimation& animation, const WindowAnimationParams& params, int64_t intervalNs,
+                   int stallFirst, int stallLast) {
+    SimResult result = {};
+    Rect previous = {};
+    double previousOpacity = -1.0;
+    bool first = true;
+
+    WindowAnimationFrame frame = {};
+    for (int refresh = 1; animation.running(); refresh++) {
+        if (refresh >= stallFirst && refresh <= stallLast) {
+            continue;
+        }
+
+        int64_t now = static_cast<int64_t>(refresh) * intervalNs;
+        WD_EXPECT(animation.Step(now, intervalNs, &frame));
+        result.geometryCalls += (frame.changed & ANIMATE_BOUNDS) ? 1 : 0;
+        result.opacityCalls += (frame.changed & ANIMATE_OPACITY) ? 1 : 0;
+        result.finishedNs = now;
+
+        if ((params.properties & ANIMATE_BOUNDS) == 0) {
+            WD_EXPECT((frame.changed & ANIMATE_BOUNDS) == 0);
+        }
+        if ((params.properties & ANIMATE_OPACITY) == 0) {
+            WD_EXPECT((frame.changed & ANIMATE_OPACITY) == 0);
+        }
+
+        // Moving right and down, fading in: progress never goes back
+        if (!first) {
+            WD_EXPECT(frame.bounds.left >= previous.left && frame.bounds.top >= previous.top);
+            WD_EXPECT(frame.opacity >= previousOpacity);
+        }
+        previous = frame.bounds;
+        previousOpacity = frame.opacity;
+        first = false;
+    }
+
+    // Ends on the target, no later than the first refresh past the duration
+    WD_EXPECT(frame.finished);
+    if (params.properties & ANIMATE_BOUNDS) {
+        WD_EXPECT(SameRect(frame.bounds, params.bounds));
+    }
+    if (params.properties & ANIMATE_OPACITY) {
+        WD_EXPECT(frame.opacity == params.opacity);
+    }
+    WD_EXPECT(result.finishedNs < params.durationNs + intervalNs);
+
+    result.frames = animation.stats().frames;
+    result.droppedFrames = animation.stats().droppedFrames;
+    return result;
+}
+
+const Rect kFrom = { -200, 100, 600, 700 };
+const Rect kSlideTo = { 400, 300, 1200, 900 };
+
+void TestSlides() {
+    WindowAnimationParams slide = MakeParams(kSlideTo, 1.0, 250 * kMs, AnimationCurve::EaseOut, ANIMATE_BOUNDS);
+
+    WindowAnimation smoothAnimation;
+    WD_EXPECT(smoothAnimation.Start(slide, kFrom, 1.0));
+    SimResult smooth = Simulate(smoothAnimation, slide, k60Hz, 0, -1);
+    WD_EXPECT_EQ(smooth.droppedFrames, 0u);
+    WD_EXPECT(smooth.geometryCalls > 0 && smooth.geometryCalls <= smooth.frames);
+    WD_EXPECT_EQ(smooth.opacityCalls, 0u);
+    WD_EXPECT_EQ(smoothAnimation.stats().completed, 1u);
+
+    // Refreshes 5 to 10 are lost: the animation jumps ahead and still ends
+    // on time
+    WindowAnimation stalledAnimation;
+    stalledAnimation.Start(slide, kFrom, 1.0);
+    SimResult stalled = Simulate(stalledAnimation, slide, k60Hz, 5, 10);
+    WD_EXPECT_EQ(stalled.droppedFrames, 6u);
+    WD_EXPECT_EQ(stalled.frames + 6, smooth.frames);
+    WD_EXPECT_EQ(stalled.finishedNs, smooth.finishedNs);
+
+    // A pure move keeps the size on every frame
+    WindowAnimation move;
+    move.Start(slide, kFrom, 1.0);
+    WindowAnimationFrame frame;
+    int resized = 0;
+    for (int64_t now = 3 * kMs; move.running(); now += 3 * kMs) {
+        move.Step(now, 0, &frame);
+        resized += frame.bounds.right - frame.bounds.left != 800 || frame.bounds.bottom - frame.bounds.top != 600
+                       ? 1
+                       : 0;
+    }
+    WD_EXPECT_EQ(resized, 0);
+    WD_EXPECT_EQ(move.stats().droppedFrames, 0u);
+}
+
+void TestFade() {
+    WindowAnimationParams fade = MakeParams({}, 1.0, 200 * kMs, AnimationCurve::Linear, ANIMATE_OPACITY);
+    WindowAnimation animation;
+    WD_EXPECT(animation.Start(fade, kFrom, 0.0));
+    SimResult faded = Simulate(animation, fade, k144Hz, 0, -1);
+    WD_EXPECT_EQ(faded.geometryCalls, 0u);
+    WD_EXPECT_EQ(faded.opacityCalls, faded.frames);
+}
+
+// Endpoints, monotonicity and symmetry of the curves
+void TestCurves() {
+    const AnimationCurve curves[] = {
+        AnimationCurve::Linear, AnimationCurve::EaseIn, AnimationCurve::EaseOut, AnimationCurve::EaseInOut,
+    };
+    for (AnimationCurve curve : curves) {
+        WD_EXPECT(EvaluateCurve(curve, 0.0) == 0.0 && EvaluateCurve(curve, 1.0) == 1.0);
+        WD_EXPECT(EvaluateCurve(curve, -1.0) == 0.0 && EvaluateCurve(curve, 2.0) == 1.0);
+        double previous = 0.0;
+        int backwards = 0;
+        for (int i = 1; i <= 1000; i++) {
+            double value = EvaluateCurve(curve, i / 1000.0);
+            backwards += value < previous ? 1 : 0;
+            previous = value;
+        }
+        WD_EXPECT_EQ(backwards, 0);
+    }
+    WD_EXPECT(std::fabs(EvaluateCurve(AnimationCurve::EaseInOut, 0.5) - 0.5) < 1e-12);
+    WD_EXPECT(EvaluateCurve(AnimationCurve::EaseIn, 0.5) < 0.5);
+    WD_EXPECT(EvaluateCurve(AnimationCurve::EaseOut, 0.5) > 0.5);
+}
+
+// Parameter checks, replacement, cancellation and zero durations
+void TestLifecycle() {
+    const Rect from = { 0, 0, 800, 600 };
+    const Rect to = { 100, 100, 900, 700 };
+
+    WindowAnimation animation;
+    WindowAnimationFrame frame;
+    WD_EXPECT(!animation.Step(0, k60Hz, &frame));
+    WD_EXPECT(!animation.Cancel());
+
+    // Rejected without touching the running animation
+    WD_EXPECT(animation.Start(MakeParams(to, 1.0, 100 * kMs, AnimationCurve::Linear, ANIMATE_BOUNDS), from, 1.0));
+    WD_EXPECT(!animation.Start(MakeParams(to, 1.0, 100 * kMs, AnimationCurve::Linear, 0), from, 1.0));
+    WD_EXPECT(!animation.Start(MakeParams(to, 1.0, 100 * kMs, AnimationCurve::Linear, 1 << 5), from, 1.0));
+    WD_EXPECT(!animation.Start(MakeParams(to, 1.0, 100 * kMs, static_cast<AnimationCurve>(9), ANIMATE_BOUNDS),
+                               from, 1.0));
+    WD_EXPECT(!animation.Start(MakeParams(to, 1.0, -1, AnimationCurve::Linear, ANIMATE_BOUNDS), from, 1.0));
+    WD_EXPECT(!animation.Start(MakeParams({ 10, 10, 10, 50 }, 1.0, 100 * kMs, AnimationCurve::Linear, ANIMATE_BOUNDS),
+                               from, 1.0));
+    WD_EXPECT(animation.running());
+    WD_EXPECT_EQ(animation.stats().started, 1u);
+    WD_EXPECT_EQ(animation.stats().cancelled, 0u);
+
+    // A newer animation replaces the running one from where it got to
+    animation.Step(k60Hz, k60Hz, &frame);
+    Rect reached = frame.bounds;
+    WD_EXPECT(animation.Start(MakeParams(from, 0.5, 100 * kMs, AnimationCurve::Linear, ANIMATE_OPACITY), reached, 1.0));
+    WD_EXPECT_EQ(animation.stats().cancelled, 1u);
+    animation.Step(2 * k60Hz, k60Hz, &frame);
+    WD_EXPECT(SameRect(frame.bounds, reached));
+    WD_EXPECT(frame.opacity < 1.0);
+    WD_EXPECT_EQ(frame.changed, ANIMATE_OPACITY);
+
+    WD_EXPECT(animation.Cancel());
+    WD_EXPECT(!animation.Cancel());
+    WD_EXPECT(!animation.running());
+    WD_EXPECT_EQ(animation.stats().cancelled, 2u);
+    WD_EXPECT_EQ(animation.stats().completed, 0u);
+
+    // Zero duration: the first frame is the target
+    WD_EXPECT(animation.Start(MakeParams(to, 0.25, 0, AnimationCurve::EaseInOut, ANIMATE_BOUNDS | ANIMATE_OPACITY),
+                              from, 1.0));
+    WD_EXPECT(animation.Step(10 * k60Hz, k60Hz, &frame));
+    WD_EXPECT(frame.finished);
+    WD_EXPECT(SameRect(frame.bounds, to));
+    WD_EXPECT(frame.opacity == 0.25);
+    WD_EXPECT_EQ(frame.changed, ANIMATE_BOUNDS | ANIMATE_OPACITY);
+    WD_EXPECT(!animation.running());
+    WD_EXPECT_EQ(animation.stats().completed, 1u);
+    WD_EXPECT_EQ(animation.stats().started, 3u);
+
+    // Finish jumps to the target without stepping a frame
+    WD_EXPECT(!animation.Finish(&frame));
+    WD_EXPECT(animation.Start(MakeParams(from, 1.0, 100 * kMs, AnimationCurve::EaseIn, ANIMATE_BOUNDS), to, 0.25));
+    WD_EXPECT(animation.Finish(&frame));
+    WD_EXPECT(frame.finished);
+    WD_EXPECT(SameRect(frame.bounds, from));
+    WD_EXPECT(frame.opacity == 0.25);
+    WD_EXPECT_EQ(frame.changed, ANIMATE_BOUNDS);
+    WD_EXPECT(!animation.running());
+    WD_EXPECT_EQ(animation.stats().completed, 2u);
+    WD_EXPECT_EQ(animation.stats().frames, 3u);
+}
+
+}  // namespace
+
+int main() {
+    TestSlides();
+    TestFade();
+    TestCurves();
+    TestLifecycle();
+    return test::TestExitCode();
+}
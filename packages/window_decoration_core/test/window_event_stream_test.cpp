@@ -0,0 +1,331 @@
+// Window Decoration Core - Window event stream test
+// Checks CoalesceWindowEvents against a reference (keep a coalescable event
+// only if no later one has the same window and type), SpscRing ordering
+// across index wraparound, both single-threaded and with a concurrent
+// producer and consumer, and the stream itself: a full ring drops and
+// counts new events, everything accepted is delivered in order once the
+// consumer catches up, and a burst within one frame is coalesced to its
+// latest move.
+
+#include "window_decoration_core/window_event_stream.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace window_decoration;
+
+namespace {
+
+const uint64_t kWindow = 0x7000;
+
+WindowEvent MakeEvent(WindowEventType type, int32_t a, int32_t b) {
+    WindowEvent event = {};
+    event.window = kWindow;
+    event.timestampNs = WindowEventClock();
+    event.type = type;
+    event.values[0] = a;
+    event.values[1] = b;
+    return event;
+}
+
+// Reference coalescing: quadratic, but obviously right
+std::vector<WindowEvent> ReferenceCoalesce(const std::vector<WindowEvent>& events) {
+    std::vector<WindowEvent> kept;
+    for (size_t i = 0; i < events.size(); i++) {
+        bool superseded = false;
+        if (IsCoalescable(events[i].type)) {
+            for (size_t j = i + 1; j < events.size() && !superseded; j++) {
+                superseded = events[j].window == events[i].window && events[j].type == events[i].type;
+            }
+        }
+        if (!superseded) {
+            kept.push_back(events[i]);
+        }
+    }
+    return kept;
+}
+
+void TestCoalescing() {
+    // The latest move and resize per window survive, show state changes
+    // and close requests all stay, in order
+    WindowEvent events[] = {
+        MakeEvent(WindowEventType::Moved, 1, 1),
+        MakeEvent(WindowEventType::Maximized, 0, 0),
+        MakeEvent(WindowEventType::Moved, 2, 2),
+        MakeEvent(WindowEventType::Resized, 10, 10),
+        MakeEvent(WindowEventType::Restored, 0, 0),
+        MakeEvent(WindowEventType::Resized, 20, 20),
+        MakeEvent(WindowEventType::CloseRequested, 0, 0),
+        MakeEvent(WindowEventType::Moved, 3, 3),
+    };
+    events[7].window = kWindow + 1;
+    size_t kept = CoalesceWindowEvents(events, 8);
+    const WindowEventType expected[] = { WindowEventType::Maximized, WindowEventType::Moved,
+                                         WindowEventType::Restored, WindowEventType::Resized,
+                                         WindowEventType::CloseRequested, WindowEventType::Moved };
+    WD_EXPECT_EQ(kept, 6u);
+    for (size_t i = 0; i < kept && i < 6; i++) {
+        WD_EXPECT(events[i].type == expected[i]);
+    }
+    WD_EXPECT_EQ(events[1].values[0], 2);
+    WD_EXPECT_EQ(events[3].values[0], 20);
+    WD_EXPECT_EQ(events[5].window, kWindow + 1);
+
+    WD_EXPECT_EQ(CoalesceWindowEvents(events, 0), 0u);
+
+    // Random batches over up to 4 windows and every type; at most 20
+    // distinct coalescable keys, which the coalescer tracks exactly
+    std::mt19937 random(1);
+    int mismatches = 0;
+    for (int round = 0; round < 5000; round++) {
+        std::vector<WindowEvent> batch(random() % 64);
+        for (size_t i = 0; i < batch.size(); i++) {
+            batch[i] = MakeEvent(static_cast<WindowEventType>(1 + random() % 9), static_cast<int32_t>(i), 0);
+            batch[i].window = kWindow + random() % 4;
+        }
+        std::vector<WindowEvent> reference = ReferenceCoalesce(batch);
+        size_t count = CoalesceWindowEvents(batch.data(), batch.size());
+        if (count != reference.size()) {
+            mismatches++;
+            continue;
+        }
+        for (size_t i = 0; i < count; i++) {
+            mismatches += batch[i].window != reference[i].window || batch[i].type != reference[i].type ||
+                          batch[i].values[0] != reference[i].values[0] ? 1 : 0;
+        }
+    }
+    WD_EXPECT_EQ(mismatches, 0);
+}
+
+// Push and pop in uneven steps so the indices wrap the 8-slot buffer many
+// times, including pushes that fill the ring exactly
+void TestRingWraparound() {
+    SpscRing<uint32_t, 8> ring;
+    WD_EXPECT(ring.empty());
+    uint32_t out[8];
+    WD_EXPECT_EQ(ring.PopAll(out, 8), 0u);
+
+    // Full: the ninth push is refused until something is popped
+    for (uint32_t i = 0; i < 8; i++) {
+        WD_EXPECT(ring.TryPush(i));
+    }
+    WD_EXPECT(!ring.TryPush(8));
+    WD_EXPECT_EQ(ring.PopAll(out, 3), 3u);
+    WD_EXPECT(out[0] == 0 && out[1] == 1 && out[2] == 2);
+    WD_EXPECT(ring.TryPush(8));
+    WD_EXPECT(ring.TryPush(9));
+    WD_EXPECT(ring.TryPush(10));
+    WD_EXPECT(!ring.TryPush(11));
+
+    // A pop only reloads the producer's index once it has used up what it
+    // saw last time, so this takes two
+    WD_EXPECT_EQ(ring.PopAll(out, 8), 5u);
+    WD_EXPECT_EQ(ring.PopAll(out + 5, 3), 3u);
+    int mismatches = 0;
+    for (uint32_t i = 0; i < 8; i++) {
+        mismatches += out[i] != i + 3 ? 1 : 0;
+    }
+    WD_EXPECT(ring.empty());
+
+    std::mt19937 random(2);
+    uint32_t nextPush = 100;
+    uint32_t nextPop = 100;
+    for (int step = 0; step < 100000; step++) {
+        uint32_t pushes = random() % 10;
+        for (uint32_t i = 0; i < pushes; i++) {
+            bool full = nextPush - nextPop == 8;
+            bool pushed = ring.TryPush(nextPush);
+            mismatches += pushed == full ? 1 : 0;
+            nextPush += pushed ? 1 : 0;
+        }
+        size_t popped = ring.PopAll(out, random() % 9);
+        for (size_t i = 0; i < popped; i++) {
+            mismatches += out[i] != nextPop++ ? 1 : 0;
+        }
+        mismatches += ring.empty() != (nextPush == nextPop) ? 1 : 0;
+    }
+    WD_EXPECT_EQ(mismatches, 0);
+}
+
+// A producer and a consumer thread move a sequence through a small ring;
+// the consumer must see every value exactly once, in order
+void TestRingConcurrent() {
+    static SpscRing<uint64_t, 64> ring;
+    const uint64_t kCount = 2000000;
+    uint64_t mismatches = 0;
+    std::thread consumer([&] {
+        uint64_t out[16];
+        uint64_t expected = 0;
+        while (expected < kCount) {
+            size_t popped = ring.PopAll(out, 16);
+            for (size_t i = 0; i < popped; i++) {
+                mismatches += out[i] != expected++ ? 1 : 0;
+            }
+            if (popped == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    for (uint64_t i = 0; i < kCount; i++) {
+        while (!ring.TryPush(i)) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    WD_EXPECT_EQ(mismatches, 0u);
+    WD_EXPECT(ring.empty());
+}
+
+// Collects delivered events; can hold the delivery thread inside the
+// callback to let the ring fill up
+struct Receiver {
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<WindowEvent> events;
+    int batches = 0;
+    bool entered = false;
+    bool hold = false;
+
+    void Deliver(const WindowEvent* batch, size_t count) {
+        std::unique_lock<std::mutex> lock(mutex);
+        events.insert(events.end(), batch, batch + count);
+        batches++;
+        entered = true;
+        changed.notify_all();
+        changed.wait(lock, [this] { return !hold; });
+    }
+};
+
+// Wait until the stream has handed everything pushed to the callback
+void Drain(WindowEventStream& stream) {
+    for (;;) {
+        WindowEventStats stats = stream.stats();
+        if (stats.delivered + stats.coalesced == stats.pushed) return;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// With the consumer stuck in the callback, the ring takes exactly
+// kCapacity more events and then drops; what was accepted is delivered in
+// order once the consumer resumes
+void TestStreamOverflow() {
+    Receiver receiver;
+    receiver.hold = true;
+    WindowEventStream stream([&](const WindowEvent* events, size_t count) { receiver.Deliver(events, count); },
+                             std::chrono::nanoseconds(0));
+
+    WD_EXPECT(stream.Push(MakeEvent(WindowEventType::CloseRequested, 0, 0)));
+    {
+        std::unique_lock<std::mutex> lock(receiver.mutex);
+        receiver.changed.wait(lock, [&] { return receiver.entered; });
+    }
+
+    int32_t accepted = 0;
+    for (int32_t i = 1; i <= static_cast<int32_t>(WindowEventStream::kCapacity); i++) {
+        accepted += stream.Push(MakeEvent(WindowEventType::CloseRequested, i, 0)) ? 1 : 0;
+    }
+    WD_EXPECT_EQ(accepted, static_cast<int32_t>(WindowEventStream::kCapacity));
+    WD_EXPECT(!stream.Push(MakeEvent(WindowEventType::CloseRequested, -1, 0)));
+    WD_EXPECT(!stream.Push(MakeEvent(WindowEventType::Moved, -1, 0)));
+    WindowEventStats stats = stream.stats();
+    WD_EXPECT_EQ(stats.dropped, 2u);
+    WD_EXPECT_EQ(stats.pushed, WindowEventStream::kCapacity + 1);
+
+    {
+        std::lock_guard<std::mutex> lock(receiver.mutex);
+        receiver.hold = false;
+    }
+    receiver.changed.notify_all();
+    Drain(stream);
+
+    // Room again after draining, and the later event arrives too
+    WD_EXPECT(stream.Push(MakeEvent(WindowEventType::CloseRequested, accepted + 1, 0)));
+    Drain(stream);
+
+    std::lock_guard<std::mutex> lock(receiver.mutex);
+    WD_EXPECT_EQ(receiver.events.size(), WindowEventStream::kCapacity + 2);
+    int mismatches = 0;
+    for (size_t i = 0; i < receiver.events.size(); i++) {
+        mismatches += receiver.events[i].values[0] != static_cast<int32_t>(i) ? 1 : 0;
+    }
+    WD_EXPECT_EQ(mismatches, 0);
+    stats = stream.stats();
+    WD_EXPECT_EQ(stats.delivered, WindowEventStream::kCapacity + 2);
+    WD_EXPECT_EQ(stats.coalesced, 0u);
+    WD_EXPECT_EQ(stats.dropped, 2u);
+}
+
+// The first event after a quiet period goes out right away; a burst of
+// moves within the next frame arrives as its latest move only, with the
+// close request kept
+void TestStreamCoalescesWithinFrame() {
+    Receiver receiver;
+    WindowEventStream stream([&](const WindowEvent* events, size_t count) { receiver.Deliver(events, count); },
+                             std::chrono::milliseconds(200));
+
+    WD_EXPECT(stream.Push(MakeEvent(WindowEventType::Moved, 0, 0)));
+    {
+        std::unique_lock<std::mutex> lock(receiver.mutex);
+        receiver.changed.wait(lock, [&] { return receiver.entered; });
+    }
+    for (int32_t i = 1; i <= 100; i++) {
+        WD_EXPECT(stream.Push(MakeEvent(WindowEventType::Moved, i, -i)));
+        if (i == 50) {
+            WD_EXPECT(stream.Push(MakeEvent(WindowEventType::CloseRequested, 1, 0)));
+        }
+    }
+    Drain(stream);
+
+    WindowEventStats stats = stream.stats();
+    WD_EXPECT_EQ(stats.pushed, 102u);
+    WD_EXPECT_EQ(stats.delivered, 3u);
+    WD_EXPECT_EQ(stats.coalesced, 99u);
+
+    std::lock_guard<std::mutex> lock(receiver.mutex);
+    WD_EXPECT_EQ(receiver.batches, 2);
+    WD_EXPECT_EQ(receiver.events.size(), 3u);
+    if (receiver.events.size() == 3) {
+        WD_EXPECT(receiver.events[1].type == WindowEventType::CloseRequested);
+        WD_EXPECT(receiver.events[2].type == WindowEventType::Moved);
+        WD_EXPECT_EQ(receiver.events[2].values[0], 100);
+        WD_EXPECT_EQ(receiver.events[2].values[1], -100);
+    }
+}
+
+// Destroying a stream with events still paced for a later frame returns
+// promptly without delivering them
+void TestStopWithQueuedEvents() {
+    Receiver receiver;
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    {
+        WindowEventStream stream([&](const WindowEvent* events, size_t count) { receiver.Deliver(events, count); },
+                                 std::chrono::seconds(30));
+        stream.Push(MakeEvent(WindowEventType::Moved, 1, 1));
+        {
+            std::unique_lock<std::mutex> lock(receiver.mutex);
+            receiver.changed.wait(lock, [&] { return receiver.entered; });
+        }
+        stream.Push(MakeEvent(WindowEventType::Moved, 2, 2));
+    }
+    WD_EXPECT(Clock::now() - start < std::chrono::seconds(10));
+    WD_EXPECT_EQ(receiver.events.size(), 1u);
+}
+
+}  // namespace
+
+int main() {
+    TestCoalescing();
+    TestRingWraparound();
+    TestRingConcurrent();
+    TestStreamOverflow();
+    TestStreamCoalescesWithinFrame();
+    TestStopWithQueuedEvents();
+    return test::TestExitCode();
+}
@@ -0,0 +1,238 @@
+// Window Decoration Core - Window layout store test
+// Checks the layout file format and restore rules:
+//
+//   - a store of random layouts survives Encode/Load unchanged and encodes
+//     to the same bytes again; Put() of an unchanged layout is not a change
+//   - truncated, corrupted and other-major-version images are rejected,
+//     a newer minor version (longer records) loads
+//   - ids must be 1 - MAX_WINDOW_LAYOUT_ID_BYTES bytes
+//   - ResolveWindowLayout keeps the bounds while the monitor is unchanged
+//     and falls back into a work area when it was unplugged, moved or
+//     rescaled
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "test_util.h"
+#include "window_decoration_core/window_layout_store.h"
+
+using namespace window_decoration;
+
+namespace {
+
+MonitorInfo Monitor(uint64_t id, int left, int top, int width, int height, uint32_t dpi, int taskbar = 0,
+                    uint32_t flags = 0) {
+    MonitorInfo monitor = {};
+    monitor.id = id;
+    monitor.bounds = { left, top, left + width, top + height };
+    monitor.workArea = { left, top, left + width, top + height - taskbar };
+    monitor.dpi = dpi;
+    monitor.flags = flags;
+    return monitor;
+}
+
+bool SameRect(const Rect& a, const Rect& b) {
+    return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+}
+
+bool SameLayout(const WindowLayout& a, const WindowLayout& b) {
+    return SameRect(a.bounds, b.bounds) && a.monitor == b.monitor && a.flags == b.flags && a.frameMode == b.frameMode;
+}
+
+bool Inside(const Rect& rect, const Rect& area) {
+    return rect.left >= area.left && rect.top >= area.top && rect.right <= area.right && rect.bottom <= area.bottom;
+}
+
+std::string WindowId(uint32_t i) {
+    return "window-" + std::to_string(i * 7919u % 1000u) + "-" + std::to_string(i);
+}
+
+// Deterministic layouts with every field set
+WindowLayout MakeLayout(uint32_t i) {
+    WindowLayout layout;
+    int left = static_cast<int>(i * 97 % 6000) - 2000;
+    int top = static_cast<int>(i * 53 % 2500) - 500;
+    layout.bounds = { left, top, left + 200 + static_cast<int>(i * 31 % 1800), top + 150 + static_cast<int>(i * 17 % 1250) };
+    layout.monitor = 0x9E3779B97F4A7C15ull * (i + 1);
+    layout.flags = i % 4;
+    layout.frameMode = static_cast<int32_t>(i % 3);
+    return layout;
+}
+
+std::vector<uint8_t> EncodeStore(const WindowLayoutStore& store) {
+    std::vector<uint8_t> image(store.EncodedSize());
+    if (store.Encode(image.data(), image.size()) != image.size()) {
+        image.clear();
+    }
+    return image;
+}
+
+void TestRoundTrip() {
+    WindowLayoutStore store;
+    for (uint32_t i = 0; i < 64; i++) {
+        WD_EXPECT(store.Put(WindowId(i).c_str(), MakeLayout(i)));
+    }
+    WD_EXPECT(store.dirty());
+    WD_EXPECT_EQ(store.size(), 64u);
+
+    std::vector<uint8_t> image = EncodeStore(store);
+    WD_EXPECT(!image.empty());
+    WD_EXPECT_EQ(store.Encode(image.data(), image.size() - 1), 0u);
+
+    WindowLayoutStore loaded;
+    WD_EXPECT(loaded.Load(image.data(), image.size()));
+    WD_EXPECT_EQ(loaded.size(), 64u);
+    WD_EXPECT(!loaded.dirty());
+    for (uint32_t i = 0; i < 64; i++) {
+        WindowLayout layout;
+        WD_EXPECT(loaded.Find(WindowId(i).c_str(), &layout) && SameLayout(layout, MakeLayout(i)));
+    }
+    WindowLayout missing;
+    WD_EXPECT(!loaded.Find("window-none", &missing));
+    WD_EXPECT(!loaded.Find("", &missing));
+    WD_EXPECT(EncodeStore(loaded) == image);
+
+    // Unchanged layouts are not changes; a removal is
+    WD_EXPECT(loaded.Put(WindowId(3).c_str(), MakeLayout(3)));
+    WD_EXPECT(!loaded.dirty());
+    WD_EXPECT(loaded.Remove(WindowId(3).c_str()));
+    WD_EXPECT(loaded.dirty());
+    WD_EXPECT(!loaded.Remove(WindowId(3).c_str()));
+    WD_EXPECT(!loaded.Find(WindowId(3).c_str(), &missing));
+    loaded.MarkClean();
+    WD_EXPECT(!loaded.dirty());
+
+    // No file yet
+    WD_EXPECT(loaded.Load(nullptr, 0));
+    WD_EXPECT_EQ(loaded.size(), 0u);
+}
+
+void TestBadImages() {
+    WindowLayoutStore store;
+    for (uint32_t i = 0; i < 64; i++) {
+        store.Put(WindowId(i).c_str(), MakeLayout(i));
+    }
+    std::vector<uint8_t> image = EncodeStore(store);
+    WindowLayoutStore loaded;
+
+    // Truncated, corrupted, foreign
+    std::vector<uint8_t> bad(image.begin(), image.end() - 1);
+    WD_EXPECT(!loaded.Load(bad.data(), bad.size()));
+    WD_EXPECT_EQ(loaded.size(), 0u);
+    bad = image;
+    bad[bad.size() / 2] ^= 0x40;
+    WD_EXPECT(!loaded.Load(bad.data(), bad.size()));
+    WD_EXPECT_EQ(loaded.size(), 0u);
+    bad = image;
+    bad[4] = static_cast<uint8_t>(WINDOW_LAYOUT_MAJOR_VERSION + 1);  // majorVersion, low byte
+    WD_EXPECT(!loaded.Load(bad.data(), bad.size()));
+    bad = image;
+    bad[0] ^= 1;  // magic
+    WD_EXPECT(!loaded.Load(bad.data(), bad.size()));
+
+    // A newer minor version with 8 more bytes per record
+    const size_t headerSize = 24;
+    const size_t recordSize = (image.size() - headerSize) / 64;
+    std::vector<uint8_t> newer(image.begin(), image.begin() + headerSize);
+    for (size_t i = 0; i < 64; i++) {
+        auto record = image.begin() + static_cast<std::ptrdiff_t>(headerSize + i * recordSize);
+        newer.insert(newer.end(), record, record + static_cast<std::ptrdiff_t>(recordSize));
+        newer.insert(newer.end(), 8, 0xAB);
+    }
+    uint32_t checksum = 2166136261u;
+    for (size_t i = headerSize; i < newer.size(); i++) {
+        checksum = (checksum ^ newer[i]) * 16777619u;
+    }
+    uint16_t minor = WINDOW_LAYOUT_MINOR_VERSION + 1;
+    uint32_t newerRecordSize = static_cast<uint32_t>(recordSize + 8);
+    std::memcpy(&newer[6], &minor, sizeof(minor));
+    std::memcpy(&newer[12], &newerRecordSize, sizeof(newerRecordSize));
+    std::memcpy(&newer[20], &checksum, sizeof(checksum));
+    WindowLayout layout;
+    WD_EXPECT(loaded.Load(newer.data(), newer.size()));
+    WD_EXPECT_EQ(loaded.size(), 64u);
+    WD_EXPECT(loaded.Find(WindowId(17).c_str(), &layout) && SameLayout(layout, MakeLayout(17)));
+}
+
+void TestIdLimits() {
+    WindowLayoutStore ids;
+    std::string longest(MAX_WINDOW_LAYOUT_ID_BYTES, 'x');
+    std::string tooLong(MAX_WINDOW_LAYOUT_ID_BYTES + 1, 'x');
+    WD_EXPECT(ids.Put(longest.c_str(), MakeLayout(0)));
+    WD_EXPECT(!ids.Put(tooLong.c_str(), MakeLayout(0)));
+    WD_EXPECT(!ids.Put("", MakeLayout(0)));
+    WD_EXPECT(!ids.Put(nullptr, MakeLayout(0)));
+    WD_EXPECT_EQ(ids.size(), 1u);
+}
+
+// Restore on the monitors the layout was saved on, and on changed ones
+void TestRestore() {
+    // A 1440p primary with a 1080p monitor to its right
+    const MonitorInfo primary = Monitor(1, 0, 0, 2560, 1440, 96, 48, MONITOR_PRIMARY);
+    const MonitorInfo right = Monitor(2, 2560, 0, 1920, 1080, 96, 40);
+
+    WindowLayout onRight = {};
+    onRight.bounds = { 3000, 200, 4200, 1000 };
+    onRight.monitor = MonitorFingerprint(right);
+
+    // Same monitors in another run (other handles): kept as it was
+    MonitorTopology nextRun;
+    const MonitorInfo relaunched[] = { Monitor(7, 0, 0, 2560, 1440, 96, 48, MONITOR_PRIMARY),
+                                       Monitor(8, 2560, 0, 1920, 1080, 96, 40) };
+    nextRun.Update(relaunched, 2);
+    Rect bounds = {};
+    WD_EXPECT(ResolveWindowLayout(nextRun, onRight, &bounds) == LayoutRestore::Exact);
+    WD_EXPECT(SameRect(bounds, onRight.bounds));
+
+    // Right monitor unplugged: centered on the primary's work area
+    MonitorTopology unplugged;
+    unplugged.Update(&primary, 1);
+    WD_EXPECT(ResolveWindowLayout(unplugged, onRight, &bounds) == LayoutRestore::Fallback);
+    WD_EXPECT(Inside(bounds, primary.workArea));
+    WD_EXPECT_EQ(bounds.right - bounds.left, 1200);
+    WD_EXPECT_EQ(bounds.bottom - bounds.top, 800);
+    WD_EXPECT_EQ(bounds.left, (2560 - 1200) / 2);
+
+    // Right monitor now 1280x720: still partly on it, pulled into it
+    MonitorTopology smaller;
+    const MonitorInfo resized[] = { primary, Monitor(2, 2560, 0, 1280, 720, 96, 40) };
+    smaller.Update(resized, 2);
+    WD_EXPECT(ResolveWindowLayout(smaller, onRight, &bounds) == LayoutRestore::Fallback);
+    WD_EXPECT(Inside(bounds, resized[1].workArea));
+
+    // Same geometry at another scale is another monitor
+    MonitorTopology rescaled;
+    const MonitorInfo scaled[] = { primary, Monitor(2, 2560, 0, 1920, 1080, 144, 40) };
+    rescaled.Update(scaled, 2);
+    WD_EXPECT(ResolveWindowLayout(rescaled, onRight, &bounds) == LayoutRestore::Fallback);
+    WD_EXPECT(Inside(bounds, scaled[1].workArea));
+    WD_EXPECT(SameRect(bounds, onRight.bounds));
+
+    // Larger than the fallback work area: shrunk into it
+    WindowLayout huge = onRight;
+    huge.bounds = { 2600, 0, 2600 + 3000, 2000 };
+    WD_EXPECT(ResolveWindowLayout(unplugged, huge, &bounds) == LayoutRestore::Fallback);
+    WD_EXPECT(SameRect(bounds, primary.workArea));
+
+    // No monitors: bounds are left alone
+    MonitorTopology none;
+    Rect untouched = { 1, 2, 3, 4 };
+    WD_EXPECT(ResolveWindowLayout(none, onRight, &untouched) == LayoutRestore::None);
+    WD_EXPECT(SameRect(untouched, { 1, 2, 3, 4 }));
+
+    // Fingerprints tell the monitors apart and ignore the handle
+    WD_EXPECT(MonitorFingerprint(primary) != MonitorFingerprint(right));
+    WD_EXPECT(MonitorFingerprint(right) == MonitorFingerprint(relaunched[1]));
+    WD_EXPECT(MonitorFingerprint(right) != 0u);
+}
+
+}  // namespace
+
+int main() {
+    TestRoundTrip();
+    TestBadImages();
+    TestIdLimits();
+    TestRestore();
+    return test::TestExitCode();
+}
@@ -0,0 +1,130 @@
+// Window Decoration Core - Window placement test
+// Known answers for centering, clamping and cascading, then the placement
+// invariants on a mixed-DPI layout with negative coordinates: every result
+// keeps the window's top-left in the work area of the right monitor, and
+// the whole window inside it when it fits.
+
+#include <cstdint>
+#include <vector>
+
+#include "test_util.h"
+#include "window_decoration_core/window_placement.h"
+
+using namespace window_decoration;
+
+namespace {
+
+MonitorInfo Monitor(uint64_t id, int left, int top, int width, int height, uint32_t dpi,
+                    int taskbar = 0, uint32_t flags = 0) {
+    MonitorInfo monitor = {};
+    monitor.id = id;
+    monitor.bounds = { left, top, left + width, top + height };
+    monitor.workArea = { left, top, left + width, top + height - taskbar };
+    monitor.dpi = dpi;
+    monitor.flags = flags;
+    return monitor;
+}
+
+bool SameRect(const Rect& a, const Rect& b) {
+    return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+}
+
+bool Inside(const Rect& inner, const Rect& outer) {
+    return inner.left >= outer.left && inner.top >= outer.top && inner.right <= outer.right &&
+           inner.bottom <= outer.bottom;
+}
+
+void TestCenter() {
+    const Rect work = { -1280, 0, 0, 984 };
+    WD_EXPECT(SameRect(CenterInWorkArea(work, 800, 600), { -1040, 192, -240, 792 }));
+
+    // Larger than the work area: aligned to its top-left
+    WD_EXPECT(SameRect(CenterInWorkArea(work, 1600, 600), { -1280, 192, 320, 792 }));
+}
+
+void TestClamp() {
+    const Rect work = { 0, 0, 1920, 1032 };
+    WD_EXPECT(SameRect(ClampToWorkArea(work, { 100, 100, 900, 700 }), { 100, 100, 900, 700 }));
+    WD_EXPECT(SameRect(ClampToWorkArea(work, { 1500, -50, 2300, 550 }), { 1120, 0, 1920, 600 }));
+    WD_EXPECT(SameRect(ClampToWorkArea(work, { -300, 900, 500, 1500 }), { 0, 432, 800, 1032 }));
+
+    // Larger than the work area: shrunk to it
+    WD_EXPECT(SameRect(ClampToWorkArea(work, { 10, 10, 2510, 1510 }), work));
+}
+
+void TestCascade() {
+    const Rect work = { 0, 0, 1920, 1032 };
+    WD_EXPECT(SameRect(CascadeInWorkArea(work, { 100, 100, 900, 700 }, 800, 600, 32), { 132, 132, 932, 732 }));
+
+    // Starts over at the work area's edge on the axis that would leave it
+    WD_EXPECT(SameRect(CascadeInWorkArea(work, { 1100, 100, 1900, 700 }, 800, 600, 32), { 0, 132, 800, 732 }));
+    WD_EXPECT(SameRect(CascadeInWorkArea(work, { 100, 420, 900, 1020 }, 800, 600, 32), { 132, 0, 932, 600 }));
+}
+
+void TestSolvePlacement() {
+    // 200% primary, a 100% monitor to the left (negative x) and a 125%
+    // portrait monitor above-right (negative y)
+    std::vector<MonitorInfo> monitors = {
+        Monitor(1, 0, 0, 3840, 2160, 192, 96, MONITOR_PRIMARY),
+        Monitor(2, -1280, 0, 1280, 1024, 96, 40),
+        Monitor(3, 3840, -400, 1080, 1920, 120),
+    };
+    MonitorTopology topology;
+    topology.Update(monitors.data(), monitors.size());
+
+    // Centered on the monitor holding most of the window
+    Rect result;
+    WD_EXPECT(SolvePlacement(topology, PlacementMode::Center, { -1200, 100, -400, 700 }, {}, false, &result));
+    WD_EXPECT(SameRect(result, { -1040, 192, -240, 792 }));
+
+    // The cascade step is scaled to the anchor monitor's DPI when asked
+    Rect anchor = { 100, 100, 900, 700 };
+    WD_EXPECT(SolvePlacement(topology, PlacementMode::Cascade, anchor, anchor, true, &result));
+    WD_EXPECT_EQ(result.left, 100 + ScaleForDpi(CASCADE_STEP, 192));
+    WD_EXPECT(SolvePlacement(topology, PlacementMode::Cascade, anchor, anchor, false, &result));
+    WD_EXPECT_EQ(result.left, 100 + CASCADE_STEP);
+
+    // Random windows all over the layout
+    uint64_t random = 0x9E3779B97F4A7C15ull;
+    auto range = [&random](int min, int max) {
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        return min + static_cast<int>(static_cast<uint32_t>(random >> 32) % static_cast<uint32_t>(max - min));
+    };
+    int violations = 0;
+    for (int i = 0; i < 20000; i++) {
+        int x = range(-2000, 5500);
+        int y = range(-1000, 2700);
+        Rect window = { x, y, x + range(200, 2400), y + range(150, 1600) };
+        const Rect& work = topology.monitor(topology.FindForRect(window)).workArea;
+        bool fits = window.right - window.left <= work.right - work.left &&
+                    window.bottom - window.top <= work.bottom - work.top;
+
+        SolvePlacement(topology, PlacementMode::Center, window, window, false, &result);
+        violations += !PointInRect(result.left, result.top, work) || (fits && !Inside(result, work)) ? 1 : 0;
+        violations += result.right - result.left != window.right - window.left ? 1 : 0;
+
+        SolvePlacement(topology, PlacementMode::ClampToWorkArea, window, window, false, &result);
+        violations += !Inside(result, work) ? 1 : 0;
+        violations += fits && result.right - result.left != window.right - window.left ? 1 : 0;
+
+        Rect centered = CenterInWorkArea(work, 800, 600);
+        SolvePlacement(topology, PlacementMode::Cascade, window, centered, true, &result);
+        violations += !Inside(result, work) ? 1 : 0;
+    }
+    WD_EXPECT_EQ(violations, 0);
+
+    MonitorTopology empty;
+    WD_EXPECT(!SolvePlacement(empty, PlacementMode::Center, { 0, 0, 10, 10 }, { 0, 0, 10, 10 }, false, &result));
+}
+
+}  // namespace
+
+int main() {
+    TestCenter();
+    TestClamp();
+    TestCascade();
+    TestSolvePlacement();
+    return test::TestExitCode();
+}
@@ -0,0 +1,252 @@
+// Window Decoration Core - Window registry test
+// Checks WindowRegistry against std::unordered_map under random churn,
+// with keys clustered on the last buckets so probe runs wrap around the
+// table end and backward-shift deletion has to move entries across it.
+// Also checks that freed hot/cold slots are reused with fresh state and
+// that state references survive growth.
+
+#include "window_decoration_core/window_registry.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace window_decoration;
+
+namespace {
+
+struct HotState {
+    uint64_t key;
+    int touches;
+};
+
+// Counts live instances so Remove() can be seen destroying the state
+struct ColdState {
+    static int live;
+
+    std::string name;
+
+    ColdState() { live++; }
+    ~ColdState() { live--; }
+    ColdState(const ColdState&) = delete;
+    ColdState& operator=(const ColdState&) = delete;
+};
+
+int ColdState::live = 0;
+
+typedef WindowRegistry<uintptr_t, HotState, ColdState> Registry;
+
+// Home bucket of `key` in a table of 2^bits buckets (the registry's
+// Fibonacci hash)
+size_t HomeBucket(uintptr_t key, int bits) {
+    return static_cast<size_t>((static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+}
+
+// Every model entry is found with its own state, and the sizes agree
+int CountMismatches(Registry& registry, const std::unordered_map<uintptr_t, uint32_t>& model) {
+    int mismatches = registry.size() != model.size() ? 1 : 0;
+    for (const auto& entry : model) {
+        uint32_t slot = registry.Find(entry.first);
+        if (slot != entry.second) {
+            mismatches++;
+            continue;
+        }
+        mismatches += registry.hot(slot).key != entry.first ? 1 : 0;
+        mismatches += registry.cold(slot).name != std::to_string(entry.first) ? 1 : 0;
+    }
+
+    size_t visited = 0;
+    registry.ForEach([&](uintptr_t key, uint32_t slot) {
+        auto it = model.find(key);
+        mismatches += it == model.end() || it->second != slot ? 1 : 0;
+        visited++;
+    });
+    mismatches += visited != model.size() ? 1 : 0;
+    return mismatches;
+}
+
+void Register(Registry& registry, std::unordered_map<uintptr_t, uint32_t>& model, uintptr_t key) {
+    uint32_t slot = registry.Insert(key);
+    registry.hot(slot).key = key;
+    registry.cold(slot).name = std::to_string(key);
+    model[key] = slot;
+}
+
+void TestBasics() {
+    Registry registry;
+    WD_EXPECT(registry.empty());
+    WD_EXPECT_EQ(registry.Find(1), Registry::kNoSlot);
+    WD_EXPECT(registry.FindHot(1) == nullptr);
+
+    // The null handle is the empty marker
+    WD_EXPECT_EQ(registry.Insert(0), Registry::kNoSlot);
+    WD_EXPECT(!registry.Remove(0));
+    WD_EXPECT_EQ(registry.Find(0), Registry::kNoSlot);
+
+    uint32_t slot = registry.Insert(42);
+    WD_EXPECT(slot != Registry::kNoSlot);
+    WD_EXPECT_EQ(registry.Insert(42), slot);
+    WD_EXPECT_EQ(registry.size(), 1u);
+    WD_EXPECT(registry.FindHot(42) == &registry.hot(slot));
+    WD_EXPECT(registry.Remove(42));
+    WD_EXPECT(!registry.Remove(42));
+    WD_EXPECT(registry.empty());
+}
+
+// Keys whose home buckets are the last two of the minimum 16-bucket table,
+// so every probe run wraps to bucket 0. Eight of them keep the table at
+// 16 buckets (load factor 1/2).
+void TestWrapAroundClusters() {
+    std::vector<uintptr_t> clustered;
+    for (uintptr_t key = 1; clustered.size() < 8; key++) {
+        if (HomeBucket(key, 4) >= 14) {
+            clustered.push_back(key);
+        }
+    }
+
+    std::mt19937 random(1);
+    for (int round = 0; round < 200; round++) {
+        Registry registry;
+        std::unordered_map<uintptr_t, uint32_t> model;
+        std::vector<uintptr_t> order = clustered;
+        std::shuffle(order.begin(), order.end(), random);
+        for (uintptr_t key : order) {
+            Register(registry, model, key);
+        }
+        WD_EXPECT_EQ(CountMismatches(registry, model), 0);
+
+        // Remove in a random order, checking every remaining key after each
+        // backward shift, and re-insert some on the way
+        std::shuffle(order.begin(), order.end(), random);
+        for (size_t i = 0; i < order.size(); i++) {
+            WD_EXPECT(registry.Remove(order[i]));
+            model.erase(order[i]);
+            WD_EXPECT_EQ(registry.Find(order[i]), Registry::kNoSlot);
+            WD_EXPECT_EQ(CountMismatches(registry, model), 0);
+            if (random() % 3 == 0) {
+                uintptr_t back = order[random() % (i + 1)];
+                if (model.count(back) == 0) {
+                    Register(registry, model, back);
+                    WD_EXPECT_EQ(CountMismatches(registry, model), 0);
+                    WD_EXPECT(registry.Remove(back));
+                    model.erase(back);
+                }
+            }
+        }
+        WD_EXPECT(registry.empty());
+    }
+}
+
+// Random inserts and removes over a small key space (many collisions and
+// repeated keys), with aligned pointer-like and sequential handles
+void TestRandomChurn() {
+    std::mt19937 random(2);
+    const uintptr_t strides[] = { 1, 8, 4096 };
+    for (uintptr_t stride : strides) {
+        Registry registry;
+        std::unordered_map<uintptr_t, uint32_t> model;
+        std::uniform_int_distribution<uintptr_t> pick(1, 600);
+        for (int step = 0; step < 100000; step++) {
+            uintptr_t key = 0x10000 + pick(random) * stride;
+            bool insert = random() % 2 == 0;
+            if (insert) {
+                if (model.count(key) == 0) {
+                    Register(registry, model, key);
+                } else {
+                    WD_EXPECT_EQ(registry.Insert(key), model[key]);
+                }
+            } else {
+                WD_EXPECT_EQ(registry.Remove(key), model.erase(key) == 1);
+            }
+            if (step % 10000 == 0) {
+                WD_EXPECT_EQ(CountMismatches(registry, model), 0);
+            }
+        }
+        WD_EXPECT_EQ(CountMismatches(registry, model), 0);
+    }
+}
+
+void TestSlotReuse() {
+    int liveBefore = ColdState::live;
+    {
+        Registry registry;
+        std::vector<uint32_t> slots;
+        for (uintptr_t key = 1; key <= 20; key++) {
+            uint32_t slot = registry.Insert(key);
+            registry.hot(slot).key = key;
+            registry.hot(slot).touches = 7;
+            registry.cold(slot).name = "window";
+            slots.push_back(slot);
+        }
+
+        // 20 windows fill three 8-slot chunks of both arrays
+        WD_EXPECT_EQ(ColdState::live - liveBefore, 24);
+
+        // Freed slots are handed out again, reset to value-initialized state
+        WD_EXPECT(registry.Remove(5));
+        WD_EXPECT(registry.Remove(17));
+        WD_EXPECT_EQ(ColdState::live - liveBefore, 24);
+        uint32_t reused = registry.Insert(100);
+        WD_EXPECT(reused == slots[4] || reused == slots[16]);
+        WD_EXPECT_EQ(registry.hot(reused).key, 0u);
+        WD_EXPECT_EQ(registry.hot(reused).touches, 0);
+        WD_EXPECT(registry.cold(reused).name.empty());
+        uint32_t reusedAgain = registry.Insert(101);
+        WD_EXPECT(reusedAgain != reused && (reusedAgain == slots[4] || reusedAgain == slots[16]));
+
+        // No new chunks while freed slots remain, one once they run out
+        WD_EXPECT_EQ(ColdState::live - liveBefore, 24);
+        for (uintptr_t key = 200; key < 205; key++) {
+            registry.Insert(key);
+        }
+        WD_EXPECT_EQ(ColdState::live - liveBefore, 32);
+
+        // State references stay valid while the table grows around them
+        HotState* first = registry.FindHot(1);
+        ColdState* firstCold = &registry.cold(registry.Find(1));
+        for (uintptr_t key = 1000; key < 3000; key++) {
+            registry.Insert(key);
+        }
+        WD_EXPECT(registry.FindHot(1) == first);
+        WD_EXPECT(&registry.cold(registry.Find(1)) == firstCold);
+        WD_EXPECT_EQ(first->touches, 7);
+        WD_EXPECT_EQ(firstCold->name, "window");
+    }
+    WD_EXPECT_EQ(ColdState::live, liveBefore);
+}
+
+// Pointer keys, as the backends use them
+void TestPointerKeys() {
+    WindowRegistry<int*, int, int> registry;
+    std::vector<int> windows(100);
+    for (size_t i = 0; i < windows.size(); i++) {
+        registry.hot(registry.Insert(&windows[i])) = static_cast<int>(i);
+    }
+    for (size_t i = 0; i < windows.size(); i += 2) {
+        WD_EXPECT(registry.Remove(&windows[i]));
+    }
+    int mismatches = 0;
+    for (size_t i = 0; i < windows.size(); i++) {
+        int* hot = registry.FindHot(&windows[i]);
+        mismatches += i % 2 == 0 ? (hot != nullptr ? 1 : 0)
+                                 : (hot == nullptr || *hot != static_cast<int>(i) ? 1 : 0);
+    }
+    WD_EXPECT_EQ(mismatches, 0);
+    WD_EXPECT_EQ(registry.size(), windows.size() / 2);
+    WD_EXPECT(registry.FindHot(nullptr) == nullptr);
+}
+
+}  // namespace
+
+int main() {
+    TestBasics();
+    TestWrapAroundClusters();
+    TestRandomChurn();
+    TestSlotReuse();
+    TestPointerKeys();
+    return test::TestExitCode();
+}
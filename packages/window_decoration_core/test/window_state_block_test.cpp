@@ -0,0 +1,215 @@
+// Window Decoration Core - Window state block test
+// Checks the publisher, the block pool (unpublish on release, reuse, chunk
+// growth) and that a block stuck mid-write reads as unavailable. Then runs
+// a bounded torn-read stress: reader threads read a block while a writer
+// publishes a fixed number of states. Every snapshot must be internally
+// consistent (all fields derived from one generation), and generations
+// never go backwards.
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "test_util.h"
+#include "window_decoration_core/window_state_block.h"
+
+using namespace window_decoration;
+
+namespace {
+
+const uint64_t kWindow = 0x5A5A0042;
+
+// State at generation g. Every field depends on g so a reader can tell if
+// it sees parts of two different publishes.
+WindowStateInfo MakeState(uint32_t g) {
+    WindowStateInfo info = {};
+    int v = static_cast<int>(g);
+    info.bounds = { v, v + 1, v + 800, v + 600 };
+    info.monitor = { v & ~1023, 0, (v & ~1023) + 1920, 1080 };
+    info.workArea = { v & ~1023, 32, (v & ~1023) + 1920, 1080 };
+    info.dpi = 96 + g % 4 * 24;
+    info.frameMode = static_cast<int32_t>(g % 3);
+    info.flags = WINDOW_STATE_VALID | WINDOW_STATE_VISIBLE | (g & 1 ? WINDOW_STATE_FOCUSED : 0);
+    info.reserved = g;
+    return info;
+}
+
+bool IsConsistent(uint64_t window, const WindowStateInfo& info) {
+    WindowStateInfo expected = MakeState(info.reserved);
+    return window == kWindow && std::memcmp(&expected, &info, sizeof(info)) == 0;
+}
+
+void TestPublisher() {
+    WindowStateBlockPool pool;
+    WindowStateBlock* block = pool.Acquire(kWindow);
+    uint64_t window = 0;
+    WindowStateInfo info;
+
+    // Acquired blocks describe the window with no state yet
+    WD_EXPECT(ReadWindowState(*block, &window, &info));
+    WD_EXPECT_EQ(window, kWindow);
+    WD_EXPECT_EQ(info.flags, 0u);
+
+    WindowStatePublisher publisher(block, kWindow);
+    WD_EXPECT(publisher.block() == block);
+    publisher.state() = MakeState(7);
+    publisher.Publish();
+    WD_EXPECT(ReadWindowState(*block, &window, &info));
+    WD_EXPECT(IsConsistent(window, info));
+    WD_EXPECT_EQ(info.reserved, 7u);
+
+    // SetFlags changes only the masked bits and reports whether any changed
+    WD_EXPECT(publisher.SetFlags(WINDOW_STATE_MAXIMIZED | WINDOW_STATE_FOCUSED, WINDOW_STATE_MAXIMIZED));
+    WD_EXPECT_EQ(publisher.state().flags, WINDOW_STATE_VALID | WINDOW_STATE_VISIBLE | WINDOW_STATE_MAXIMIZED);
+    WD_EXPECT(!publisher.SetFlags(WINDOW_STATE_MAXIMIZED, WINDOW_STATE_MAXIMIZED));
+    WD_EXPECT(!publisher.SetFlags(WINDOW_STATE_MINIMIZED, 0));
+
+    // Nothing reaches the block until Publish()
+    WD_EXPECT(ReadWindowState(*block, &window, &info));
+    WD_EXPECT_EQ(info.flags & WINDOW_STATE_MAXIMIZED, 0u);
+    publisher.Publish();
+    WD_EXPECT(ReadWindowState(*block, &window, &info));
+    WD_EXPECT_EQ(info.flags & WINDOW_STATE_MAXIMIZED, WINDOW_STATE_MAXIMIZED);
+
+    // Each publish advances the sequence by two and leaves it even
+    uint32_t sequence = block->sequence.load();
+    publisher.Publish();
+    WD_EXPECT_EQ(block->sequence.load(), sequence + 2);
+    WD_EXPECT_EQ(block->sequence.load() & 1, 0u);
+    pool.Release(block);
+}
+
+void TestPool() {
+    WindowStateBlockPool pool;
+    WD_EXPECT_EQ(pool.allocated(), 0u);
+    WindowStateBlock* block = pool.Acquire(kWindow);
+    WD_EXPECT_EQ(pool.allocated(), 16u);
+
+    WindowStatePublisher publisher(block, kWindow);
+    publisher.state() = MakeState(3);
+    publisher.Publish();
+
+    // A released block reads as gone, without the old window's state
+    pool.Release(block);
+    uint64_t window = 1;
+    WindowStateInfo info;
+    WD_EXPECT(!ReadWindowState(*block, &window, &info));
+    WD_EXPECT_EQ(window, 0u);
+    WD_EXPECT_EQ(info.reserved, 0u);
+    WD_EXPECT_EQ(info.flags, 0u);
+
+    // The next window reuses it, with no state of its own yet
+    WindowStateBlock* reused = pool.Acquire(kWindow + 1);
+    WD_EXPECT(reused == block);
+    WD_EXPECT(ReadWindowState(*reused, &window, &info));
+    WD_EXPECT_EQ(window, kWindow + 1);
+    WD_EXPECT_EQ(info.flags, 0u);
+
+    // A 17th live block takes a second chunk; blocks are distinct and stay
+    // put
+    std::vector<WindowStateBlock*> blocks = { reused };
+    for (uint64_t i = 2; i <= 17; i++) {
+        blocks.push_back(pool.Acquire(kWindow + i));
+    }
+    WD_EXPECT_EQ(pool.allocated(), 32u);
+    int mismatches = 0;
+    for (size_t i = 0; i < blocks.size(); i++) {
+        for (size_t j = i + 1; j < blocks.size(); j++) {
+            mismatches += blocks[i] == blocks[j] ? 1 : 0;
+        }
+        mismatches += !ReadWindowState(*blocks[i], &window, &info) || window != kWindow + 1 + i ? 1 : 0;
+    }
+    WD_EXPECT_EQ(mismatches, 0);
+    for (WindowStateBlock* live : blocks) {
+        pool.Release(live);
+    }
+    WD_EXPECT_EQ(pool.allocated(), 32u);
+    pool.Release(nullptr);
+}
+
+// A writer that never finishes (odd sequence) makes reads give up instead
+// of spinning forever
+void TestStuckWriter() {
+    WindowStateBlockPool pool;
+    WindowStateBlock* block = pool.Acquire(kWindow);
+    uint64_t window;
+    WindowStateInfo info;
+    WD_EXPECT(ReadWindowState(*block, &window, &info));
+
+    uint32_t sequence = block->sequence.load();
+    block->sequence.store(sequence + 1);
+    WD_EXPECT(!ReadWindowState(*block, &window, &info));
+    block->sequence.store(sequence);
+    WD_EXPECT(ReadWindowState(*block, &window, &info));
+    pool.Release(block);
+}
+
+void TestTornReadStress() {
+    WindowStateBlockPool pool;
+    WindowStateBlock* block = pool.Acquire(kWindow);
+    WindowStatePublisher publisher(block, kWindow);
+    publisher.state() = MakeState(1);
+    publisher.Publish();
+
+    const uint32_t kPublishes = 200000;
+    const int kReaders = 4;
+    std::atomic<bool> done(false);
+    std::atomic<uint64_t> torn(0);
+    std::atomic<uint64_t> backwards(0);
+    std::atomic<uint64_t> reads(0);
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < kReaders; r++) {
+        readers.emplace_back([&] {
+            uint32_t last = 0;
+            uint64_t localReads = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                uint64_t window;
+                WindowStateInfo info;
+                if (!ReadWindowState(*block, &window, &info)) {
+                    continue;
+                }
+                localReads++;
+                if (!IsConsistent(window, info)) {
+                    torn.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                if (info.reserved < last) {
+                    backwards.fetch_add(1, std::memory_order_relaxed);
+                }
+                last = info.reserved;
+            }
+            reads.fetch_add(localReads, std::memory_order_relaxed);
+        });
+    }
+
+    for (uint32_t g = 2; g <= kPublishes; g++) {
+        publisher.state() = MakeState(g);
+        publisher.Publish();
+    }
+    done.store(true, std::memory_order_release);
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    WD_EXPECT_EQ(torn.load(), 0u);
+    WD_EXPECT_EQ(backwards.load(), 0u);
+    WD_EXPECT(reads.load() > 0);
+
+    uint64_t window;
+    WindowStateInfo info;
+    WD_EXPECT(ReadWindowState(*block, &window, &info));
+    WD_EXPECT_EQ(info.reserved, kPublishes);
+    pool.Release(block);
+}
+
+}  // namespace
+
+int main() {
+    TestPublisher();
+    TestPool();
+    TestStuckWriter();
+    TestTornReadStress();
+    return test::TestExitCode();
+}
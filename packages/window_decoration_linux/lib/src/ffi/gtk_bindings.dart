@@ -1,10 +1,17 @@
 // ignore_for_file: constant_identifier_names, non_constant_identifier_names, prefer_expression_function_bodies
 
 import 'dart:ffi';
+import 'dart:io';
+
+import 'package:window_decoration_linux/src/ffi/plugin_bindings.dart';
 
 /// GTK3 and X11 bindings for window manipulation
 class GtkBindings {
-  // Load GTK3 and X11 libraries
+  // The plugin's GtkFunctionTable: one symbol lookup for every GTK and GDK
+  // function below. Null if the plugin library isn't available, in which
+  // case GTK and GDK are opened and each function is looked up on first use
+  static final Pointer<GtkFunctionTableStruct>? _functions = PluginBindings.getGtkFunctionTable();
+
   static final DynamicLibrary _gtk = DynamicLibrary.open('libgtk-3.so.0');
   static final DynamicLibrary _gdk = DynamicLibrary.open('libgdk-3.so.0');
   static final DynamicLibrary _x11 = DynamicLibrary.open('libX11.so.6');
@@ -15,8 +22,9 @@ class GtkBindings {
 
   /// gtk_window_move - Move window to position
   /// void gtk_window_move(GtkWindow *window, gint x, gint y)
-  static final _gtk_window_move = _gtk
-      .lookupFunction<
+  static final _gtk_window_move =
+      _functions?.ref.windowMove.asFunction<void Function(Pointer<Void>, int, int)>() ??
+      _gtk.lookupFunction<
         Void Function(Pointer<Void>, Int32, Int32),
         void Function(Pointer<Void>, int, int)
       >('gtk_window_move');
@@ -27,8 +35,9 @@ class GtkBindings {
 
   /// gtk_window_resize - Resize window
   /// void gtk_window_resize(GtkWindow *window, gint width, gint height)
-  static final _gtk_window_resize = _gtk
-      .lookupFunction<
+  static final _gtk_window_resize =
+      _functions?.ref.windowResize.asFunction<void Function(Pointer<Void>, int, int)>() ??
+      _gtk.lookupFunction<
         Void Function(Pointer<Void>, Int32, Int32),
         void Function(Pointer<Void>, int, int)
       >('gtk_window_resize');
@@ -39,8 +48,9 @@ class GtkBindings {
 
   /// gtk_window_get_position - Get window position
   /// void gtk_window_get_position(GtkWindow *window, gint *root_x, gint *root_y)
-  static final _gtk_window_get_position = _gtk
-      .lookupFunction<
+  static final _gtk_window_get_position =
+      _functions?.ref.windowGetPosition.asFunction<void Function(Pointer<Void>, Pointer<Int32>, Pointer<Int32>)>() ??
+      _gtk.lookupFunction<
         Void Function(Pointer<Void>, Pointer<Int32>, Pointer<Int32>),
         void Function(Pointer<Void>, Pointer<Int32>, Pointer<Int32>)
       >('gtk_window_get_position');
@@ -55,8 +65,9 @@ class GtkBindings {
 
   /// gtk_window_get_size - Get window size
   /// void gtk_window_get_size(GtkWindow *window, gint *width, gint *height)
-  static final _gtk_window_get_size = _gtk
-      .lookupFunction<
+  static final _gtk_window_get_size =
+      _functions?.ref.windowGetSize.asFunction<void Function(Pointer<Void>, Pointer<Int32>, Pointer<Int32>)>() ??
+      _gtk.lookupFunction<
         Void Function(Pointer<Void>, Pointer<Int32>, Pointer<Int32>),
         void Function(Pointer<Void>, Pointer<Int32>, Pointer<Int32>)
       >('gtk_window_get_size');
@@ -71,8 +82,9 @@ class GtkBindings {
 
   /// gtk_window_set_opacity - Set window opacity
   /// void gtk_window_set_opacity(GtkWindow *window, gdouble opacity)
-  static final _gtk_window_set_opacity = _gtk
-      .lookupFunction<
+  static final _gtk_window_set_opacity =
+      _functions?.ref.windowSetOpacity.asFunction<void Function(Pointer<Void>, double)>() ??
+      _gtk.lookupFunction<
         Void Function(Pointer<Void>, Double),
         void Function(Pointer<Void>, double)
       >('gtk_window_set_opacity');
@@ -83,8 +95,9 @@ class GtkBindings {
 
   /// gtk_window_set_keep_above - Set always on top
   /// void gtk_window_set_keep_above(GtkWindow *window, gboolean setting)
-  static final _gtk_window_set_keep_above = _gtk
-      .lookupFunction<
+  static final _gtk_window_set_keep_above =
+      _functions?.ref.windowSetKeepAbove.asFunction<void Function(Pointer<Void>, int)>() ??
+      _gtk.lookupFunction<
         Void Function(Pointer<Void>, Int32),
         void Function(Pointer<Void>, int)
       >('gtk_window_set_keep_above');
@@ -98,8 +111,9 @@ class GtkBindings {
 
   /// gtk_window_set_skip_taskbar_hint - Skip taskbar
   /// void gtk_window_set_skip_taskbar_hint(GtkWindow *window, gboolean setting)
-  static final _gtk_window_set_skip_taskbar_hint = _gtk
-      .lookupFunction<
+  static final _gtk_window_set_skip_taskbar_hint =
+      _functions?.ref.windowSetSkipTaskbarHint.asFunction<void Function(Pointer<Void>, int)>() ??
+      _gtk.lookupFunction<
         Void Function(Pointer<Void>, Int32),
         void Function(Pointer<Void>, int)
       >('gtk_window_set_skip_taskbar_hint');
@@ -113,8 +127,9 @@ class GtkBindings {
 
   /// gtk_window_fullscreen - Enter fullscreen
   /// void gtk_window_fullscreen(GtkWindow *window)
-  static final _gtk_window_fullscreen = _gtk
-      .lookupFunction<
+  static final _gtk_window_fullscreen =
+      _functions?.ref.windowFullscreen.asFunction<void Function(Pointer<Void>)>() ??
+      _gtk.lookupFunction<
         Void Function(Pointer<Void>),
         void Function(Pointer<Void>)
       >('gtk_window_fullscreen');
@@ -125,8 +140,9 @@ class GtkBindings {
 
   /// gtk_window_unfullscreen - Exit fullscreen
   /// void gtk_window_unfullscreen(GtkWindow *window)
-  static final _gtk_window_unfullscreen = _gtk
-      .lookupFunction<
+  static final _gtk_window_unfullscreen =
+      _functions?.ref.windowUnfullscreen.asFunction<void Function(Pointer<Void>)>() ??
+      _gtk.lookupFunction<
         Void Function(Pointer<Void>),
         void Function(Pointer<Void>)
       >('gtk_window_unfullscreen');
@@ -137,8 +153,9 @@ class GtkBindings {
 
   /// gtk_window_set_decorated - Show/hide window decorations
   /// void gtk_window_set_decorated(GtkWindow *window, gboolean setting)
-  static final _gtk_window_set_decorated = _gtk
-      .lookupFunction<
+  static final _gtk_window_set_decorated =
+      _functions?.ref.windowSetDecorated.asFunction<void Function(Pointer<Void>, int)>() ??
+      _gtk.lookupFunction<
         Void Function(Pointer<Void>, Int32),
         void Function(Pointer<Void>, int)
       >('gtk_window_set_decorated');
@@ -152,8 +169,9 @@ class GtkBindings {
 
   /// gtk_widget_show - Show widget (window)
   /// void gtk_widget_show(GtkWidget *widget)
-  static final _gtk_widget_show = _gtk
-      .lookupFunction<
+  static final _gtk_widget_show =
+      _functions?.ref.widgetShow.asFunction<void Function(Pointer<Void>)>() ??
+      _gtk.lookupFunction<
         Void Function(Pointer<Void>),
         void Function(Pointer<Void>)
       >('gtk_widget_show');
@@ -164,8 +182,9 @@ class GtkBindings {
 
   /// gtk_widget_hide - Hide widget (window)
   /// void gtk_widget_hide(GtkWidget *widget)
-  static final _gtk_widget_hide = _gtk
-      .lookupFunction<
+  static final _gtk_widget_hide =
+      _functions?.ref.widgetHide.asFunction<void Function(Pointer<Void>)>() ??
+      _gtk.lookupFunction<
         Void Function(Pointer<Void>),
         void Function(Pointer<Void>)
       >('gtk_widget_hide');
@@ -180,8 +199,9 @@ class GtkBindings {
 
   /// gdk_window_set_opacity - Set window opacity (alternative)
   /// void gdk_window_set_opacity(GdkWindow *window, gdouble opacity)
-  static final _gdk_window_set_opacity = _gdk
-      .lookupFunction<
+  static final _gdk_window_set_opacity =
+      _functions?.ref.gdkWindowSetOpacity.asFunction<void Function(Pointer<Void>, double)>() ??
+      _gdk.lookupFunction<
         Void Function(Pointer<Void>, Double),
         void Function(Pointer<Void>, double)
       >('gdk_window_set_opacity');
@@ -192,10 +212,12 @@ class GtkBindings {
 
   /// gdk_screen_get_default - Get default screen
   /// GdkScreen* gdk_screen_get_default(void)
-  static final _gdk_screen_get_default = _gdk
-      .lookupFunction<Pointer<Void> Function(), Pointer<Void> Function()>(
-        'gdk_screen_get_default',
-      );
+  static final _gdk_screen_get_default =
+      _functions?.ref.screenGetDefault.asFunction<Pointer<Void> Function()>() ??
+      _gdk.lookupFunction<
+        Pointer<Void> Function(),
+        Pointer<Void> Function()
+      >('gdk_screen_get_default');
 
   static Pointer<Void> screenGetDefault() {
     return _gdk_screen_get_default();
@@ -203,8 +225,9 @@ class GtkBindings {
 
   /// gdk_screen_get_width - Get screen width
   /// gint gdk_screen_get_width(GdkScreen *screen)
-  static final _gdk_screen_get_width = _gdk
-      .lookupFunction<
+  static final _gdk_screen_get_width =
+      _functions?.ref.screenGetWidth.asFunction<int Function(Pointer<Void>)>() ??
+      _gdk.lookupFunction<
         Int32 Function(Pointer<Void>),
         int Function(Pointer<Void>)
       >('gdk_screen_get_width');
@@ -215,8 +238,9 @@ class GtkBindings {
 
   /// gdk_screen_get_height - Get screen height
   /// gint gdk_screen_get_height(GdkScreen *screen)
-  static final _gdk_screen_get_height = _gdk
-      .lookupFunction<
+  static final _gdk_screen_get_height =
+      _functions?.ref.screenGetHeight.asFunction<int Function(Pointer<Void>)>() ??
+      _gdk.lookupFunction<
         Int32 Function(Pointer<Void>),
         int Function(Pointer<Void>)
       >('gdk_screen_get_height');
@@ -258,12 +282,36 @@ class GtkBindings {
 }
 
 /// Helper for checking Wayland vs X11
+///
+/// Answered from the plugin's capability probe, which asks GDK for the
+/// display the app actually opened (an X11 app runs under XWayland in a
+/// Wayland session). Without the plugin library, the session's
+/// environment is the best guess.
 class DisplayServerHelper {
   static bool isWayland() {
-    // Check if running under Wayland
-    // This is a simplified check - in production you'd check $XDG_SESSION_TYPE
-    return false; // TODO(enhancement): Implement proper detection
+    final capabilities = PluginBindings.getPlatformCapabilities();
+    if (capabilities != null) {
+      return (capabilities.ref.flags & PluginBindings.CAPABILITY_WAYLAND) != 0;
+    }
+    return Platform.environment['WAYLAND_DISPLAY'] != null &&
+        !(Platform.environment['GDK_BACKEND'] ?? '').startsWith('x11');
   }
 
-  static bool isX11() => !isWayland();
+  static bool isX11() {
+    final capabilities = PluginBindings.getPlatformCapabilities();
+    if (capabilities != null) {
+      return (capabilities.ref.flags & PluginBindings.CAPABILITY_X11) != 0;
+    }
+    return !isWayland();
+  }
+
+  /// Whether the X11 window manager supports a _NET_WM hint
+  /// (PluginBindings.NET_WM_*); true when it can't be told
+  static bool supportsNetWmHint(int hint) {
+    final capabilities = PluginBindings.getPlatformCapabilities();
+    if (capabilities == null || (capabilities.ref.flags & PluginBindings.CAPABILITY_X11) == 0) {
+      return true;
+    }
+    return (capabilities.ref.netWmAtoms & hint) != 0;
+  }
 }
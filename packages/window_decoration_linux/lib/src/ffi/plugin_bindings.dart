@@ -0,0 +1,903 @@
+// ignore_for_file: constant_identifier_names
+
+import 'dart:ffi';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:ffi/ffi.dart';
+import 'package:window_decoration_platform_interface/window_decoration_platform_interface.dart';
+
+/// Bindings to the plugin's own native library
+/// (libwindow_decoration_linux_plugin.so)
+class PluginBindings {
+  static DynamicLibrary? _pluginLib;
+
+  /// Try to load the plugin library from where Flutter bundles it
+  /// Returns false if it isn't available
+  static bool tryLoadPlugin() {
+    if (_pluginLib != null) return true;
+
+    // Flutter bundles plugin libraries in lib/ next to the executable,
+    // which is on the runner's rpath
+    try {
+      _pluginLib = DynamicLibrary.open('libwindow_decoration_linux_plugin.so');
+      return true;
+    } catch (_) {
+      // Try the executable directory explicitly
+    }
+
+    try {
+      final exeDir = File(Platform.resolvedExecutable).parent.path;
+      final pluginPath = '$exeDir/lib/libwindow_decoration_linux_plugin.so';
+      if (File(pluginPath).existsSync()) {
+        _pluginLib = DynamicLibrary.open(pluginPath);
+        return true;
+      }
+    } catch (_) {
+      // Failed to load
+    }
+
+    return false;
+  }
+
+  /// Apply an encoded WindowDecorationConfig to a GtkWindow in one call
+  /// Returns false if the blob was rejected
+  static bool applyDecorationConfig(Pointer<Void> window, Uint8List config) {
+    if (!tryLoadPlugin()) {
+      throw StateError('Native plugin not loaded.');
+    }
+
+    final applyFunc = _pluginLib!.lookupFunction<
+        Bool Function(Pointer<Void> window, Pointer<Uint8> blob, Size length),
+        bool Function(Pointer<Void> window, Pointer<Uint8> blob, int length)>(
+      'ApplyDecorationConfig',
+    );
+
+    final blob = calloc<Uint8>(config.length);
+    try {
+      blob.asTypedList(config.length).setAll(0, config);
+      return applyFunc(window, blob, config.length);
+    } finally {
+      calloc.free(blob);
+    }
+  }
+
+  /// Placement modes of PlaceWindow (window_decoration_core PlacementMode)
+  static const int PLACEMENT_CENTER = 0;
+  static const int PLACEMENT_CLAMP_TO_WORK_AREA = 1;
+  static const int PLACEMENT_CASCADE = 2;
+
+  /// Place a GtkWindow from the plugin's cached monitor topology: center it
+  /// in its monitor's work area, move it into the work area, or cascade it
+  /// from [anchor]
+  /// Returns false if the plugin library isn't available or the window
+  /// couldn't be placed
+  static bool placeWindow(Pointer<Void> window, int mode, {Pointer<Void>? anchor}) {
+    if (!tryLoadPlugin()) {
+      return false;
+    }
+
+    final placeFunc = _pluginLib!.lookupFunction<
+        Bool Function(Pointer<Void> window, Int32 mode, Pointer<Void> anchor),
+        bool Function(Pointer<Void> window, int mode, Pointer<Void> anchor)>('PlaceWindow');
+
+    return placeFunc(window, mode, anchor ?? nullptr);
+  }
+
+  /// Frame modes of SetFrameMode (window_decoration_core FrameMode)
+  static const int FRAME_MODE_NORMAL = 0;
+  static const int FRAME_MODE_HIDDEN = 1;
+  static const int FRAME_MODE_CUSTOM_FRAME = 2;
+
+  /// Handle the frame of an undecorated GtkWindow natively, without going
+  /// through Dart. [FRAME_MODE_HIDDEN] adds resize cursors near the edges
+  /// and `gtk_window_begin_resize_drag` on a primary press;
+  /// [FRAME_MODE_CUSTOM_FRAME] also drags the window from the caption
+  /// (`gtk_window_begin_move_drag`) and maximizes it on double-click.
+  /// [FRAME_MODE_NORMAL] leaves the frame to the window manager again.
+  /// Returns false if the plugin library isn't available
+  static bool setFrameMode(Pointer<Void> window, int mode) {
+    if (!tryLoadPlugin()) {
+      return false;
+    }
+
+    final setFunc = _pluginLib!.lookupFunction<
+        Bool Function(Pointer<Void> window, Int32 mode),
+        bool Function(Pointer<Void> window, int mode)>(
+      'SetFrameMode',
+    );
+    return setFunc(window, mode);
+  }
+
+  /// Set the caption height in logical pixels (0 for the default)
+  static void setCaptionHeight(Pointer<Void> window, int height) {
+    if (!tryLoadPlugin()) {
+      throw StateError('Native plugin not loaded.');
+    }
+
+    final setHeightFunc = _pluginLib!.lookupFunction<
+        Void Function(Pointer<Void> window, Int32 height),
+        void Function(Pointer<Void> window, int height)>('SetCaptionHeight');
+
+    setHeightFunc(window, height);
+  }
+
+  /// Set caption button zones (logical client pixels); presses there
+  /// reach Flutter instead of dragging the window
+  static void setCaptionButtonZones(
+    Pointer<Void> window, {
+    required int minLeft,
+    required int minTop,
+    required int minRight,
+    required int minBottom,
+    required int maxLeft,
+    required int maxTop,
+    required int maxRight,
+    required int maxBottom,
+    required int closeLeft,
+    required int closeTop,
+    required int closeRight,
+    required int closeBottom,
+  }) {
+    if (!tryLoadPlugin()) {
+      throw StateError('Native plugin not loaded.');
+    }
+
+    final setZonesFunc = _pluginLib!.lookupFunction<
+        Void Function(
+          Pointer<Void> window,
+          Int32 minLeft, Int32 minTop, Int32 minRight, Int32 minBottom,
+          Int32 maxLeft, Int32 maxTop, Int32 maxRight, Int32 maxBottom,
+          Int32 closeLeft, Int32 closeTop, Int32 closeRight, Int32 closeBottom,
+        ),
+        void Function(
+          Pointer<Void> window,
+          int minLeft, int minTop, int minRight, int minBottom,
+          int maxLeft, int maxTop, int maxRight, int maxBottom,
+          int closeLeft, int closeTop, int closeRight, int closeBottom,
+        )>('SetCaptionButtonZones');
+
+    setZonesFunc(
+      window,
+      minLeft, minTop, minRight, minBottom,
+      maxLeft, maxTop, maxRight, maxBottom,
+      closeLeft, closeTop, closeRight, closeBottom,
+    );
+  }
+
+  /// Clear caption button zones
+  static void clearCaptionButtonZones(Pointer<Void> window) {
+    if (!tryLoadPlugin()) {
+      throw StateError('Native plugin not loaded.');
+    }
+
+    final clearFunc = _pluginLib!.lookupFunction<
+        Void Function(Pointer<Void> window),
+        void Function(Pointer<Void> window)>('ClearCaptionButtonZones');
+
+    clearFunc(window);
+  }
+
+  /// Add or replace a named caption region (logical client pixels)
+  /// [hit]: 1 = client, 2 = caption, 3 = minimize, 4 = maximize, 5 = close
+  /// Returns false if the region was rejected (empty rect, bad hit, too many regions)
+  static bool setCaptionRegion(
+    Pointer<Void> window,
+    String name, {
+    required int hit,
+    required int left,
+    required int top,
+    required int right,
+    required int bottom,
+    int cornerRadius = 0,
+  }) {
+    if (!tryLoadPlugin()) {
+      throw StateError('Native plugin not loaded.');
+    }
+
+    final setRegionFunc = _pluginLib!.lookupFunction<
+        Bool Function(
+          Pointer<Void> window, Pointer<Utf8> name, Int32 hit,
+          Int32 left, Int32 top, Int32 right, Int32 bottom, Int32 cornerRadius,
+        ),
+        bool Function(
+          Pointer<Void> window, Pointer<Utf8> name, int hit,
+          int left, int top, int right, int bottom, int cornerRadius,
+        )>('SetCaptionRegion');
+
+    final nativeName = name.toNativeUtf8();
+    try {
+      return setRegionFunc(
+        window, nativeName, hit,
+        left, top, right, bottom, cornerRadius,
+      );
+    } finally {
+      calloc.free(nativeName);
+    }
+  }
+
+  /// Remove a named caption region
+  static bool removeCaptionRegion(Pointer<Void> window, String name) {
+    if (!tryLoadPlugin()) {
+      throw StateError('Native plugin not loaded.');
+    }
+
+    final removeFunc = _pluginLib!.lookupFunction<
+        Bool Function(Pointer<Void> window, Pointer<Utf8> name),
+        bool Function(Pointer<Void> window, Pointer<Utf8> name)>('RemoveCaptionRegion');
+
+    final nativeName = name.toNativeUtf8();
+    try {
+      return removeFunc(window, nativeName);
+    } finally {
+      calloc.free(nativeName);
+    }
+  }
+
+  /// Remove all named caption regions
+  static void clearCaptionRegions(Pointer<Void> window) {
+    if (!tryLoadPlugin()) {
+      throw StateError('Native plugin not loaded.');
+    }
+
+    final clearFunc = _pluginLib!.lookupFunction<
+        Void Function(Pointer<Void> window),
+        void Function(Pointer<Void> window)>('ClearCaptionRegions');
+
+    clearFunc(window);
+  }
+
+  // Looked up once: polled, and must not allocate
+  static WindowStateInfoStruct Function(Pointer<Void> window)? _queryWindowState;
+
+  /// Get bounds, monitor, scale, decorations and show state of a GtkWindow
+  /// in one leaf call, with nothing allocated on either side
+  /// Returns null if the plugin library isn't available
+  static WindowStateInfo? queryWindowState(Pointer<Void> window) {
+    if (!tryLoadPlugin()) {
+      return null;
+    }
+
+    final queryFunc = _queryWindowState ??= _pluginLib!.lookupFunction<
+        WindowStateInfoStruct Function(Pointer<Void> window),
+        WindowStateInfoStruct Function(Pointer<Void> window)>(
+      'QueryWindowState',
+      isLeaf: true,
+    );
+
+    final info = queryFunc(window);
+    if ((info.flags & _WINDOW_STATE_VALID) == 0) {
+      return null;
+    }
+    return _toWindowStateInfo(info);
+  }
+
+  /// Get the GtkWindow's native state block, kept current by the plugin
+  /// from the window's configure, window-state, focus and scale signals.
+  /// Read it with [readWindowStateBlock]. Its bounds are the client area's
+  /// (without window manager decorations). The block stays valid for the
+  /// life of the process.
+  /// Returns null if the plugin library isn't available
+  static Pointer<WindowStateBlockStruct>? openWindowStateBlock(Pointer<Void> window) {
+    if (!tryLoadPlugin()) {
+      return null;
+    }
+
+    final openFunc = _pluginLib!.lookupFunction<
+        Pointer<WindowStateBlockStruct> Function(Pointer<Void> window),
+        Pointer<WindowStateBlockStruct> Function(Pointer<Void> window)>('OpenWindowStateBlock');
+
+    final block = openFunc(window);
+    return block == nullptr ? null : block;
+  }
+
+  /// Read a consistent snapshot of a state block without any FFI call or X
+  /// server round trip (seqlock, see window_state_block.h)
+  /// Returns null if the block no longer describes window (it was
+  /// destroyed) or stayed mid-update for every attempt
+  static WindowStateInfo? readWindowStateBlock(
+    Pointer<WindowStateBlockStruct> block,
+    Pointer<Void> window,
+  ) {
+    final ref = block.ref;
+    for (var attempt = 0; attempt < _STATE_BLOCK_READ_ATTEMPTS; attempt++) {
+      final start = ref.sequence;
+      if ((start & 1) != 0) {
+        continue;
+      }
+      // Nested struct fields are views into the block: copy every field
+      // out before checking the sequence again
+      final handle = ref.window;
+      final flags = ref.info.flags;
+      final info = _toWindowStateInfo(ref.info);
+      if (ref.sequence == start) {
+        return handle == window.address && (flags & _WINDOW_STATE_VALID) != 0 ? info : null;
+      }
+    }
+    return null;
+  }
+
+  static const int _STATE_BLOCK_READ_ATTEMPTS = 64;
+
+  /// Start posting the GtkWindow's events to a native port: batches of
+  /// 32-byte WindowEvent records as Uint8List messages, coalesced per
+  /// frame (see window_event_stream.h). Decode them with
+  /// [WindowEvent.decodeAll]. Restarts the stream if it is running.
+  /// Returns false if the plugin library isn't available
+  static bool startWindowEvents(Pointer<Void> window, int port) {
+    if (!tryLoadPlugin()) {
+      return false;
+    }
+
+    final startFunc = _pluginLib!.lookupFunction<
+        Bool Function(Pointer<Void> window, Pointer<Void> postCObject, Int64 port),
+        bool Function(Pointer<Void> window, Pointer<Void> postCObject, int port)>('StartWindowEvents');
+
+    return startFunc(window, NativeApi.postCObject.cast<Void>(), port);
+  }
+
+  /// Stop posting the GtkWindow's events. Events still queued are dropped.
+  static void stopWindowEvents(Pointer<Void> window) {
+    if (!tryLoadPlugin()) {
+      return;
+    }
+
+    final stopFunc = _pluginLib!.lookupFunction<
+        Void Function(Pointer<Void> window),
+        void Function(Pointer<Void> window)>('StopWindowEvents');
+
+    stopFunc(window);
+  }
+
+  /// Pace the GtkWindow's resizes to its frame clock: during a resize drag
+  /// only the newest size is handed to GTK, at most once per frame.
+  /// Returns false if the plugin library isn't available or the window
+  /// isn't realized
+  static bool setResizePacing(Pointer<Void> window, bool enabled) {
+    if (!tryLoadPlugin()) {
+      return false;
+    }
+
+    final setFunc = _pluginLib!.lookupFunction<
+        Bool Function(Pointer<Void> window, Bool enabled),
+        bool Function(Pointer<Void> window, bool enabled)>('SetResizePacing');
+
+    return setFunc(window, enabled);
+  }
+
+  /// Get the GtkWindow's resize pacing counters
+  /// Returns null if pacing is not enabled for the window
+  static ResizePacingStats? getResizePacingStats(Pointer<Void> window) {
+    if (!tryLoadPlugin()) {
+      return null;
+    }
+
+    final getStatsFunc = _pluginLib!.lookupFunction<
+        Bool Function(Pointer<Void> window, Pointer<ResizePacingStatsStruct> stats),
+        bool Function(Pointer<Void> window, Pointer<ResizePacingStatsStruct> stats)>('GetResizePacingStats');
+
+    final stats = calloc<ResizePacingStatsStruct>();
+    try {
+      if (!getStatsFunc(window, stats)) {
+        return null;
+      }
+      final applied = stats.ref.applied;
+      return (
+        requests: stats.ref.requests,
+        applied: applied,
+        skipped: stats.ref.skipped,
+        lastLatency: Duration(microseconds: stats.ref.lastLatencyNs ~/ 1000),
+        maxLatency: Duration(microseconds: stats.ref.maxLatencyNs ~/ 1000),
+        meanLatency: Duration(microseconds: applied == 0 ? 0 : stats.ref.totalLatencyNs ~/ applied ~/ 1000),
+      );
+    } finally {
+      calloc.free(stats);
+    }
+  }
+
+  /// Animate the GtkWindow to [bounds] and/or [opacity] over [duration],
+  /// stepped natively on its frame clock (see window_animation.h). When the
+  /// animation ends, 1 (target reached) or 0 (replaced, cancelled or window
+  /// destroyed) is posted to native port [port].
+  /// Returns false if the plugin library isn't available or neither
+  /// [bounds] nor [opacity] is given
+  static bool animateWindow(
+    Pointer<Void> window, {
+    WindowBounds? bounds,
+    double? opacity,
+    required Duration duration,
+    required int curve,
+    required int port,
+  }) {
+    if (!tryLoadPlugin()) {
+      return false;
+    }
+
+    final animateFunc = _pluginLib!.lookupFunction<
+        Bool Function(
+            Pointer<Void> window, Pointer<WindowAnimationParamsStruct> params, Pointer<Void> postCObject, Int64 port),
+        bool Function(Pointer<Void> window, Pointer<WindowAnimationParamsStruct> params, Pointer<Void> postCObject,
+            int port)>('AnimateWindow');
+
+    final params = calloc<WindowAnimationParamsStruct>();
+    try {
+      if (bounds != null) {
+        params.ref.bounds.left = bounds.x.toInt();
+        params.ref.bounds.top = bounds.y.toInt();
+        params.ref.bounds.right = (bounds.x + bounds.width).toInt();
+        params.ref.bounds.bottom = (bounds.y + bounds.height).toInt();
+        params.ref.properties |= _ANIMATE_BOUNDS;
+      }
+      if (opacity != null) {
+        params.ref.opacity = opacity.clamp(0.0, 1.0);
+        params.ref.properties |= _ANIMATE_OPACITY;
+      }
+      params.ref.durationNs = duration.inMicroseconds * 1000;
+      params.ref.curve = curve;
+      return animateFunc(window, params, NativeApi.postCObject.cast<Void>(), port);
+    } finally {
+      calloc.free(params);
+    }
+  }
+
+  /// Stop the GtkWindow's animation where it is
+  /// Returns false if no animation was running
+  static bool cancelWindowAnimation(Pointer<Void> window) {
+    if (!tryLoadPlugin()) {
+      return false;
+    }
+
+    final cancelFunc = _pluginLib!.lookupFunction<
+        Bool Function(Pointer<Void> window),
+        bool Function(Pointer<Void> window)>('CancelWindowAnimation');
+
+    return cancelFunc(window);
+  }
+
+  /// Get the GtkWindow's animation counters
+  /// Returns null if the window was never animated
+  static WindowAnimationStats? getWindowAnimationStats(Pointer<Void> window) {
+    if (!tryLoadPlugin()) {
+      return null;
+    }
+
+    final getStatsFunc = _pluginLib!.lookupFunction<
+        Bool Function(Pointer<Void> window, Pointer<WindowAnimationStatsStruct> stats),
+        bool Function(Pointer<Void> window, Pointer<WindowAnimationStatsStruct> stats)>('GetWindowAnimationStats');
+
+    final stats = calloc<WindowAnimationStatsStruct>();
+    try {
+      if (!getStatsFunc(window, stats)) {
+        return null;
+      }
+      return (
+        started: stats.ref.started,
+        completed: stats.ref.completed,
+        cancelled: stats.ref.cancelled,
+        frames: stats.ref.frames,
+        droppedFrames: stats.ref.droppedFrames,
+      );
+    } finally {
+      calloc.free(stats);
+    }
+  }
+
+  // WindowAnimationParams.properties (window_decoration_core)
+  static const int _ANIMATE_BOUNDS = 1 << 0;
+  static const int _ANIMATE_OPACITY = 1 << 1;
+
+  /// Open the window layout store at [path] (see window_layout_store.h),
+  /// saving pending changes of an open one first. A missing file is an
+  /// empty store.
+  /// Returns false if the plugin library isn't available, or the file
+  /// can't be read or isn't a layout file (the store then starts empty)
+  static bool openWindowLayoutStore(String path) {
+    if (!tryLoadPlugin()) {
+      return false;
+    }
+
+    final openFunc = _pluginLib!.lookupFunction<
+        Bool Function(Pointer<Utf8> path),
+        bool Function(Pointer<Utf8> path)>('OpenWindowLayoutStore');
+
+    final nativePath = path.toNativeUtf8();
+    try {
+      return openFunc(nativePath);
+    } finally {
+      calloc.free(nativePath);
+    }
+  }
+
+  /// Place the GtkWindow from the layout saved under [id] and keep that
+  /// layout up to date from now on
+  /// Returns 1 if it was placed as it was left, 2 if it was moved onto
+  /// another monitor, 0 if nothing was saved under [id]
+  static int restoreWindowLayout(Pointer<Void> window, String id) {
+    if (!tryLoadPlugin()) {
+      return 0;
+    }
+
+    final restoreFunc = _pluginLib!.lookupFunction<
+        Int32 Function(Pointer<Void> window, Pointer<Utf8> id, Pointer<WindowLayoutStruct> layout),
+        int Function(Pointer<Void> window, Pointer<Utf8> id, Pointer<WindowLayoutStruct> layout)>(
+        'RestoreWindowLayout');
+
+    final nativeId = id.toNativeUtf8();
+    try {
+      return restoreFunc(window, nativeId, nullptr);
+    } finally {
+      calloc.free(nativeId);
+    }
+  }
+
+  /// Write pending layout changes now instead of after the save delay
+  /// Returns false if writing failed
+  static bool flushWindowLayouts() {
+    if (!tryLoadPlugin()) {
+      return false;
+    }
+
+    final flushFunc = _pluginLib!.lookupFunction<
+        Bool Function(),
+        bool Function()>('FlushWindowLayouts');
+
+    return flushFunc();
+  }
+
+  /// InitialDecoration.flags (window_decoration_core)
+  static const int INITIAL_DECORATION_HAS_BOUNDS = 1 << 0;
+  static const int INITIAL_DECORATION_CENTERED = 1 << 1;
+  static const int INITIAL_DECORATION_HAS_BACKGROUND = 1 << 2;
+  static const int INITIAL_DECORATION_ALWAYS_ON_TOP = 1 << 3;
+
+  /// The decoration the runner applied to [window] with
+  /// ApplyInitialDecoration before it was shown, null if none
+  static InitialDecorationInfo? getInitialDecoration(Pointer<Void> window) {
+    if (!tryLoadPlugin()) {
+      return null;
+    }
+
+    final getFunc = _pluginLib!.lookupFunction<
+        Bool Function(Pointer<Void> window, Pointer<InitialDecorationStruct> decoration),
+        bool Function(Pointer<Void> window, Pointer<InitialDecorationStruct> decoration)>('GetInitialDecoration');
+
+    final decoration = calloc<InitialDecorationStruct>();
+    try {
+      if (!getFunc(window, decoration)) {
+        return null;
+      }
+      return (
+        flags: decoration.ref.flags,
+        frameMode: decoration.ref.frameMode,
+        captionHeight: decoration.ref.captionHeight,
+        backgroundColor: decoration.ref.backgroundColor,
+        left: decoration.ref.bounds.left,
+        top: decoration.ref.bounds.top,
+        right: decoration.ref.bounds.right,
+        bottom: decoration.ref.bounds.bottom,
+      );
+    } finally {
+      calloc.free(decoration);
+    }
+  }
+
+  /// PlatformCapabilities.flags (window_decoration_core)
+  static const int CAPABILITY_WINDOW_DPI = 1 << 0;
+  static const int CAPABILITY_MONITOR_DPI = 1 << 2;
+  static const int CAPABILITY_COMPOSITOR = 1 << 4;
+  static const int CAPABILITY_X11 = 1 << 5;
+  static const int CAPABILITY_WAYLAND = 1 << 6;
+
+  /// PlatformCapabilities.netWmAtoms (window_decoration_core)
+  static const int NET_WM_STATE = 1 << 0;
+  static const int NET_WM_STATE_ABOVE = 1 << 1;
+  static const int NET_WM_STATE_SKIP_TASKBAR = 1 << 2;
+  static const int NET_WM_STATE_FULLSCREEN = 1 << 3;
+  static const int NET_WM_STATE_MAXIMIZED_VERT = 1 << 4;
+  static const int NET_WM_STATE_MAXIMIZED_HORZ = 1 << 5;
+  static const int NET_WM_STATE_HIDDEN = 1 << 6;
+  static const int NET_WM_MOVERESIZE = 1 << 7;
+  static const int NET_WM_WINDOW_OPACITY = 1 << 8;
+  static const int NET_WM_FRAME_EXTENTS = 1 << 9;
+  static const int NET_WM_WORKAREA = 1 << 10;
+  static const int NET_WM_ACTIVE_WINDOW = 1 << 11;
+
+  static Pointer<PlatformCapabilitiesStruct>? _capabilities;
+
+  /// The plugin's capability probe: display server, compositor, the
+  /// window manager's _NET_WM hints and versions, probed once per process.
+  /// Looked up once; the struct lives as long as the process
+  /// Returns null if the plugin library isn't available
+  static Pointer<PlatformCapabilitiesStruct>? getPlatformCapabilities() {
+    if (_capabilities != null) {
+      return _capabilities;
+    }
+    if (!tryLoadPlugin()) {
+      return null;
+    }
+
+    final getFunc = _pluginLib!.lookupFunction<
+        Pointer<PlatformCapabilitiesStruct> Function(),
+        Pointer<PlatformCapabilitiesStruct> Function()>('GetPlatformCapabilities');
+
+    return _capabilities = getFunc();
+  }
+
+  /// The GTK and GDK functions GtkBindings calls, from the capability probe
+  /// Returns null if the plugin library isn't available or its table is
+  /// older than this binding
+  static Pointer<GtkFunctionTableStruct>? getGtkFunctionTable() {
+    final capabilities = getPlatformCapabilities();
+    if (capabilities == null || capabilities.ref.functionsSize < sizeOf<GtkFunctionTableStruct>()) {
+      return null;
+    }
+    return capabilities.ref.functions.cast<GtkFunctionTableStruct>();
+  }
+
+  static WindowStateInfo _toWindowStateInfo(WindowStateInfoStruct info) {
+    return WindowStateInfo(
+      bounds: _toBounds(info.bounds),
+      monitor: _toBounds(info.monitor),
+      workArea: _toBounds(info.workArea),
+      dpi: info.dpi,
+      frameMode: info.frameMode,
+      isVisible: (info.flags & _WINDOW_STATE_VISIBLE) != 0,
+      isFocused: (info.flags & _WINDOW_STATE_FOCUSED) != 0,
+      isMaximized: (info.flags & _WINDOW_STATE_MAXIMIZED) != 0,
+      isMinimized: (info.flags & _WINDOW_STATE_MINIMIZED) != 0,
+      isFullScreen: (info.flags & _WINDOW_STATE_FULLSCREEN) != 0,
+    );
+  }
+
+  static WindowBounds _toBounds(RectStruct rect) {
+    return WindowBounds(
+      x: rect.left.toDouble(),
+      y: rect.top.toDouble(),
+      width: (rect.right - rect.left).toDouble(),
+      height: (rect.bottom - rect.top).toDouble(),
+    );
+  }
+
+  // WindowStateInfo.flags (window_decoration_core)
+  static const int _WINDOW_STATE_VALID = 1 << 0;
+  static const int _WINDOW_STATE_VISIBLE = 1 << 1;
+  static const int _WINDOW_STATE_FOCUSED = 1 << 2;
+  static const int _WINDOW_STATE_MAXIMIZED = 1 << 3;
+  static const int _WINDOW_STATE_MINIMIZED = 1 << 4;
+  static const int _WINDOW_STATE_FULLSCREEN = 1 << 5;
+}
+
+/// Resize pacing counters (see [PluginBindings.getResizePacingStats])
+typedef ResizePacingStats = ({
+  int requests,
+  int applied,
+  int skipped,
+  Duration lastLatency,
+  Duration maxLatency,
+  Duration meanLatency,
+});
+
+/// Window animation counters (see [PluginBindings.getWindowAnimationStats])
+typedef WindowAnimationStats = ({
+  int started,
+  int completed,
+  int cancelled,
+  int frames,
+  int droppedFrames,
+});
+
+/// The runner's initial decoration (see [PluginBindings.getInitialDecoration])
+typedef InitialDecorationInfo = ({
+  int flags,
+  int frameMode,
+  int captionHeight,
+  int backgroundColor,
+  int left,
+  int top,
+  int right,
+  int bottom,
+});
+
+/// Rect structure (window_decoration_core)
+final class RectStruct extends Struct {
+  @Int32()
+  external int left;
+
+  @Int32()
+  external int top;
+
+  @Int32()
+  external int right;
+
+  @Int32()
+  external int bottom;
+}
+
+/// WindowStateBlock structure (window_decoration_core), read in place
+final class WindowStateBlockStruct extends Struct {
+  @Uint32()
+  external int sequence;
+
+  @Uint32()
+  external int reserved;
+
+  @Uint64()
+  external int window;
+
+  external WindowStateInfoStruct info;
+}
+
+/// WindowStateInfo structure (window_decoration_core), returned by value
+final class WindowStateInfoStruct extends Struct {
+  external RectStruct bounds;
+
+  external RectStruct monitor;
+
+  external RectStruct workArea;
+
+  @Uint32()
+  external int dpi;
+
+  @Int32()
+  external int frameMode;
+
+  @Uint32()
+  external int flags;
+
+  @Uint32()
+  external int reserved;
+}
+
+/// ResizePacingStats structure (window_decoration_core)
+final class ResizePacingStatsStruct extends Struct {
+  @Uint64()
+  external int requests;
+
+  @Uint64()
+  external int applied;
+
+  @Uint64()
+  external int skipped;
+
+  @Uint64()
+  external int lastLatencyNs;
+
+  @Uint64()
+  external int maxLatencyNs;
+
+  @Uint64()
+  external int totalLatencyNs;
+}
+
+/// WindowAnimationParams structure (window_decoration_core)
+final class WindowAnimationParamsStruct extends Struct {
+  external RectStruct bounds;
+
+  @Double()
+  external double opacity;
+
+  @Int64()
+  external int durationNs;
+
+  @Int32()
+  external int curve;
+
+  @Uint32()
+  external int properties;
+}
+
+/// WindowAnimationStats structure (window_decoration_core)
+final class WindowAnimationStatsStruct extends Struct {
+  @Uint64()
+  external int started;
+
+  @Uint64()
+  external int completed;
+
+  @Uint64()
+  external int cancelled;
+
+  @Uint64()
+  external int frames;
+
+  @Uint64()
+  external int droppedFrames;
+}
+
+/// InitialDecoration structure (window_decoration_core)
+final class InitialDecorationStruct extends Struct {
+  @Uint32()
+  external int flags;
+
+  @Int32()
+  external int frameMode;
+
+  @Uint32()
+  external int captionHeight;
+
+  @Uint32()
+  external int backgroundColor;
+
+  external RectStruct bounds;
+}
+
+/// WindowLayout structure (window_decoration_core)
+final class WindowLayoutStruct extends Struct {
+  external RectStruct bounds;
+
+  @Uint64()
+  external int monitor;
+
+  @Uint32()
+  external int flags;
+
+  @Int32()
+  external int frameMode;
+}
+
+/// PlatformCapabilities structure (window_decoration_core)
+final class PlatformCapabilitiesStruct extends Struct {
+  @Uint32()
+  external int flags;
+
+  @Uint32()
+  external int netWmAtoms;
+
+  @Uint32()
+  external int osMajor;
+
+  @Uint32()
+  external int osMinor;
+
+  @Uint32()
+  external int osBuild;
+
+  @Uint32()
+  external int toolkitMajor;
+
+  @Uint32()
+  external int toolkitMinor;
+
+  @Uint32()
+  external int toolkitMicro;
+
+  external Pointer<Void> functions;
+
+  @Uint64()
+  external int functionsSize;
+}
+
+/// GtkFunctionTable structure (plugin), read in place
+final class GtkFunctionTableStruct extends Struct {
+  external Pointer<NativeFunction<Void Function(Pointer<Void>, Int32, Int32)>> windowMove;
+
+  external Pointer<NativeFunction<Void Function(Pointer<Void>, Int32, Int32)>> windowResize;
+
+  external Pointer<NativeFunction<Void Function(Pointer<Void>, Pointer<Int32>, Pointer<Int32>)>> windowGetPosition;
+
+  external Pointer<NativeFunction<Void Function(Pointer<Void>, Pointer<Int32>, Pointer<Int32>)>> windowGetSize;
+
+  external Pointer<NativeFunction<Void Function(Pointer<Void>, Double)>> windowSetOpacity;
+
+  external Pointer<NativeFunction<Void Function(Pointer<Void>, Int32)>> windowSetKeepAbove;
+
+  external Pointer<NativeFunction<Void Function(Pointer<Void>, Int32)>> windowSetSkipTaskbarHint;
+
+  external Pointer<NativeFunction<Void Function(Pointer<Void>)>> windowFullscreen;
+
+  external Pointer<NativeFunction<Void Function(Pointer<Void>)>> windowUnfullscreen;
+
+  external Pointer<NativeFunction<Void Function(Pointer<Void>, Int32)>> windowSetDecorated;
+
+  external Pointer<NativeFunction<Void Function(Pointer<Void>)>> widgetShow;
+
+  external Pointer<NativeFunction<Void Function(Pointer<Void>)>> widgetHide;
+
+  external Pointer<NativeFunction<Void Function(Pointer<Void>, Double)>> gdkWindowSetOpacity;
+
+  external Pointer<NativeFunction<Pointer<Void> Function()>> screenGetDefault;
+
+  external Pointer<NativeFunction<Int32 Function(Pointer<Void>)>> screenGetWidth;
+
+  external Pointer<NativeFunction<Int32 Function(Pointer<Void>)>> screenGetHeight;
+}
@@ -1,8 +1,12 @@
+import 'dart:async';
 import 'dart:ffi';
+import 'dart:isolate';
+import 'dart:typed_data';
 
 import 'package:ffi/ffi.dart';
 import 'package:flutter/material.dart';
 import 'package:window_decoration_linux/src/ffi/gtk_bindings.dart';
+import 'package:window_decoration_linux/src/ffi/plugin_bindings.dart';
 import 'package:window_decoration_platform_interface/window_decoration_platform_interface.dart';
 
 /// Linux implementation of the window_decoration plugin
@@ -13,6 +17,18 @@ class WindowDecorationLinux extends WindowDecorationPlatform {
   /// Whether the platform has been initialized
   bool _isInitialized = false;
 
+  /// Native state block of the window, opened on first read
+  Pointer<WindowStateBlockStruct>? _stateBlock;
+
+  /// Window events, produced natively only while listened to
+  late final StreamController<WindowEvent> _windowEvents = StreamController.broadcast(
+    onListen: _startWindowEvents,
+    onCancel: _stopWindowEvents,
+  );
+
+  /// Port the native side posts event batches to while listened to
+  ReceivePort? _eventPort;
+
   /// Registers this class as the default instance of [WindowDecorationPlatform]
   static void registerWith() {
     WindowDecorationPlatform.instance = WindowDecorationLinux();
@@ -33,6 +49,45 @@ class WindowDecorationLinux extends WindowDecorationPlatform {
     }
   }
 
+  /// Current window state, read from the native state block without an
+  /// FFI call or X server round trip once it is open. Falls back to one
+  /// QueryWindowState leaf call if the block can't be opened or read.
+  WindowStateInfo? _readWindowState() {
+    final block = _stateBlock ??= PluginBindings.openWindowStateBlock(_gtkWindow);
+    if (block != null) {
+      final state = PluginBindings.readWindowStateBlock(block, _gtkWindow);
+      if (state != null) {
+        return state;
+      }
+    }
+    return PluginBindings.queryWindowState(_gtkWindow);
+  }
+
+  void _startWindowEvents() {
+    final port = ReceivePort('window_decoration events');
+    port.listen((message) {
+      if (message is Uint8List) {
+        WindowEvent.decodeAll(message).forEach(_windowEvents.add);
+      }
+    });
+    if (!PluginBindings.startWindowEvents(_gtkWindow, port.sendPort.nativePort)) {
+      port.close();
+      _windowEvents.addError(StateError('Native plugin not loaded.'));
+      return;
+    }
+    _eventPort = port;
+  }
+
+  void _stopWindowEvents() {
+    final port = _eventPort;
+    if (port == null) {
+      return;
+    }
+    PluginBindings.stopWindowEvents(_gtkWindow);
+    port.close();
+    _eventPort = null;
+  }
+
   // ==========================================================================
   // Position & Size
   // ==========================================================================
@@ -41,6 +96,11 @@ class WindowDecorationLinux extends WindowDecorationPlatform {
   Future<void> center() async {
     _checkInitialized();
 
+    // Work area of the window's monitor, from the native monitor cache
+    if (PluginBindings.placeWindow(_gtkWindow, PluginBindings.PLACEMENT_CENTER)) {
+      return;
+    }
+
     // Get current window size
     final width = calloc<Int32>();
     final height = calloc<Int32>();
@@ -66,10 +126,106 @@ class WindowDecorationLinux extends WindowDecorationPlatform {
     }
   }
 
+  /// Bounds are stepped on the window's GdkFrameClock with one
+  /// `gdk_window_move_resize` per frame; opacity goes through
+  /// `gtk_widget_set_opacity`. A window that isn't shown jumps to the
+  /// target.
+  @override
+  Future<bool> animateWindow({
+    WindowBounds? bounds,
+    double? opacity,
+    required Duration duration,
+    WindowAnimationCurve curve = WindowAnimationCurve.easeInOut,
+  }) async {
+    _checkInitialized();
+
+    final port = ReceivePort('window_decoration animation');
+    final started = PluginBindings.animateWindow(
+      _gtkWindow,
+      bounds: bounds,
+      opacity: opacity,
+      duration: duration,
+      curve: curve.value,
+      port: port.sendPort.nativePort,
+    );
+    if (!started) {
+      port.close();
+      return false;
+    }
+
+    // Closes the port after the one message
+    final result = await port.first;
+    return result == 1;
+  }
+
+  @override
+  Future<void> cancelWindowAnimation() async {
+    _checkInitialized();
+    PluginBindings.cancelWindowAnimation(_gtkWindow);
+  }
+
+  @override
+  Future<bool> openWindowLayoutStore(String path) async {
+    return PluginBindings.openWindowLayoutStore(path);
+  }
+
+  /// The GtkWindow is moved and resized, and maximized or made fullscreen
+  /// again, natively; a window that isn't shown yet opens that way.
+  /// Layouts are saved from its configure and window-state events.
+  @override
+  Future<WindowLayoutRestore> restoreWindowLayout(String id) async {
+    _checkInitialized();
+    return WindowLayoutRestore.fromValue(PluginBindings.restoreWindowLayout(_gtkWindow, id));
+  }
+
+  @override
+  Future<bool> flushWindowLayouts() async {
+    return PluginBindings.flushWindowLayouts();
+  }
+
+  @override
+  Future<InitialDecoration?> getInitialDecoration() async {
+    _checkInitialized();
+    final info = PluginBindings.getInitialDecoration(_gtkWindow);
+    if (info == null) {
+      return null;
+    }
+    return InitialDecoration(
+      frameMode: info.frameMode,
+      captionHeight: info.captionHeight,
+      centered: (info.flags & PluginBindings.INITIAL_DECORATION_CENTERED) != 0,
+      alwaysOnTop: (info.flags & PluginBindings.INITIAL_DECORATION_ALWAYS_ON_TOP) != 0,
+      backgroundColor: (info.flags & PluginBindings.INITIAL_DECORATION_HAS_BACKGROUND) != 0
+          ? Color(info.backgroundColor)
+          : null,
+      bounds: (info.flags & PluginBindings.INITIAL_DECORATION_HAS_BOUNDS) != 0
+          ? WindowBounds(
+              x: info.left.toDouble(),
+              y: info.top.toDouble(),
+              width: (info.right - info.left).toDouble(),
+              height: (info.bottom - info.top).toDouble(),
+            )
+          : null,
+    );
+  }
+
   @override
   Future<WindowBounds> getBounds() async {
     _checkInitialized();
 
+    // The state block reports the client area, which is the whole window
+    // once the window manager's frame is off (any frame mode but normal)
+    final state = _readWindowState();
+    if (state != null && state.frameMode != PluginBindings.FRAME_MODE_NORMAL) {
+      return state.bounds;
+    }
+
+    // One allocation-free native call when the plugin library is available
+    final queried = PluginBindings.queryWindowState(_gtkWindow);
+    if (queried != null) {
+      return queried.bounds;
+    }
+
     final x = calloc<Int32>();
     final y = calloc<Int32>();
     final width = calloc<Int32>();
@@ -94,6 +250,31 @@ class WindowDecorationLinux extends WindowDecorationPlatform {
     }
   }
 
+  /// Bounds (of the client area), monitor, scale, decorations and show
+  /// state, read from the native state block with no FFI call or X server
+  /// round trip, cheap enough to poll every frame
+  @override
+  Future<WindowStateInfo> getWindowState() async {
+    _checkInitialized();
+
+    final state = _readWindowState();
+    if (state == null) {
+      throw StateError('Native plugin not loaded.');
+    }
+    return state;
+  }
+
+  /// Moves, resizes, maximize/minimize/restore, scale, focus and theme
+  /// changes and close requests, from the GtkWindow's signals. The plugin
+  /// queues them in a lock-free ring and posts one coalesced batch per
+  /// frame to a native port; nothing is connected while there are no
+  /// listeners. Close requests are reported, not blocked.
+  @override
+  Stream<WindowEvent> get windowEvents {
+    _checkInitialized();
+    return _windowEvents.stream;
+  }
+
   @override
   Future<void> setBounds(WindowBounds bounds) async {
     _checkInitialized();
@@ -142,6 +323,10 @@ class WindowDecorationLinux extends WindowDecorationPlatform {
       debugPrint(
         'Warning: setAlwaysOnTop may not work on Wayland due to compositor restrictions',
       );
+    } else if (!DisplayServerHelper.supportsNetWmHint(PluginBindings.NET_WM_STATE_ABOVE)) {
+      debugPrint(
+        'Warning: the window manager does not support _NET_WM_STATE_ABOVE; setAlwaysOnTop has no effect',
+      );
     }
 
     GtkBindings.windowSetKeepAbove(_gtkWindow, keepAbove: alwaysOnTop);
@@ -169,22 +354,37 @@ class WindowDecorationLinux extends WindowDecorationPlatform {
   Future<void> setTitleBarStyle(TitleBarStyle style, {int captionHeight = 32}) async {
     _checkInitialized();
 
+    final bool decorated;
+    var frameMode = PluginBindings.FRAME_MODE_HIDDEN;
     switch (style) {
       case TitleBarStyle.normal:
-        GtkBindings.windowSetDecorated(_gtkWindow, decorated: true);
+        decorated = true;
       case TitleBarStyle.hidden:
-        GtkBindings.windowSetDecorated(_gtkWindow, decorated: false);
+        decorated = false;
       case TitleBarStyle.transparent:
         // GTK doesn't have direct transparent title bar support
         // This would require custom CSS and compositing
-        GtkBindings.windowSetDecorated(_gtkWindow, decorated: true);
+        decorated = true;
       case TitleBarStyle.unified:
         // Not applicable to Linux GTK windows
-        GtkBindings.windowSetDecorated(_gtkWindow, decorated: true);
+        decorated = true;
       case TitleBarStyle.customFrame:
-        // On Linux, customFrame behaves like hidden (client-side decorations)
-        // The captionHeight parameter is not used on Linux
-        GtkBindings.windowSetDecorated(_gtkWindow, decorated: false);
+        // Client-side decorations: the app draws the title bar, the plugin
+        // library drags the window from the top captionHeight pixels
+        decorated = false;
+        frameMode = PluginBindings.FRAME_MODE_CUSTOM_FRAME;
+    }
+
+    GtkBindings.windowSetDecorated(_gtkWindow, decorated: decorated);
+
+    // Without the native frame the window manager offers no resize
+    // borders or caption; the plugin library handles them natively
+    final hasNativeFrame = PluginBindings.setFrameMode(
+      _gtkWindow,
+      decorated ? PluginBindings.FRAME_MODE_NORMAL : frameMode,
+    );
+    if (hasNativeFrame && frameMode == PluginBindings.FRAME_MODE_CUSTOM_FRAME) {
+      PluginBindings.setCaptionHeight(_gtkWindow, captionHeight);
     }
   }
 
@@ -201,6 +401,117 @@ class WindowDecorationLinux extends WindowDecorationPlatform {
     }
   }
 
+  /// Applies the whole config with one native call
+  /// (`ApplyDecorationConfig`): a single FFI crossing, decorations only
+  /// changed if they differ, and one frame for everything. Falls back to the
+  /// individual setters if the plugin library isn't available.
+  @override
+  Future<void> applyConfig(WindowDecorationConfig config) async {
+    _checkInitialized();
+
+    if (!PluginBindings.tryLoadPlugin()) {
+      return super.applyConfig(config);
+    }
+
+    if (!PluginBindings.applyDecorationConfig(_gtkWindow, config.encode())) {
+      throw StateError('The native plugin rejected the window decoration config.');
+    }
+  }
+
+  // ==========================================================================
+  // Custom Frame APIs (for TitleBarStyle.customFrame)
+  // ==========================================================================
+
+  /// Set the caption height (the draggable area at the top of the window).
+  ///
+  /// Presses in the caption start a window move right away, with the
+  /// press's own timestamp, and a double-click toggles maximize. Neither
+  /// goes through Dart. The value is in logical pixels and is scaled with
+  /// the window.
+  ///
+  /// Default is 32 pixels if not specified.
+  Future<void> setCaptionHeight(int height) async {
+    _checkInitialized();
+    PluginBindings.setCaptionHeight(_gtkWindow, height);
+  }
+
+  /// Set the caption button zones, so presses on your caption buttons
+  /// reach them instead of dragging the window.
+  ///
+  /// All coordinates are in client area logical pixels, like on Windows.
+  /// Set them again after the window's scale factor changes.
+  Future<void> setCaptionButtonZones({
+    required Rect minimize,
+    required Rect maximize,
+    required Rect close,
+  }) async {
+    _checkInitialized();
+
+    PluginBindings.setCaptionButtonZones(
+      _gtkWindow,
+      minLeft: minimize.left.toInt(),
+      minTop: minimize.top.toInt(),
+      minRight: minimize.right.toInt(),
+      minBottom: minimize.bottom.toInt(),
+      maxLeft: maximize.left.toInt(),
+      maxTop: maximize.top.toInt(),
+      maxRight: maximize.right.toInt(),
+      maxBottom: maximize.bottom.toInt(),
+      closeLeft: close.left.toInt(),
+      closeTop: close.top.toInt(),
+      closeRight: close.right.toInt(),
+      closeBottom: close.bottom.toInt(),
+    );
+  }
+
+  /// Clear the caption button zones; the whole caption drags the window.
+  Future<void> clearCaptionButtonZones() async {
+    _checkInitialized();
+    PluginBindings.clearCaptionButtonZones(_gtkWindow);
+  }
+
+  /// Register a named interactive region inside the caption area (tabs,
+  /// search boxes, menus, avatars) so pressing it doesn't drag the window.
+  ///
+  /// Same semantics as on Windows: calling this again with the same [name]
+  /// replaces the region, and regions registered later are on top. Regions
+  /// with [CaptionRegionHit.caption] drag the window; every other hit
+  /// leaves the press to Flutter. [rect] is in client area logical pixels.
+  ///
+  /// Returns false if the region was rejected (empty rect or too many
+  /// regions).
+  Future<bool> setCaptionRegion(
+    String name,
+    Rect rect, {
+    CaptionRegionHit hit = CaptionRegionHit.client,
+    double cornerRadius = 0,
+  }) async {
+    _checkInitialized();
+
+    return PluginBindings.setCaptionRegion(
+      _gtkWindow,
+      name,
+      hit: hit.value,
+      left: rect.left.toInt(),
+      top: rect.top.toInt(),
+      right: rect.right.toInt(),
+      bottom: rect.bottom.toInt(),
+      cornerRadius: cornerRadius.toInt(),
+    );
+  }
+
+  /// Remove a caption region registered with [setCaptionRegion].
+  Future<bool> removeCaptionRegion(String name) async {
+    _checkInitialized();
+    return PluginBindings.removeCaptionRegion(_gtkWindow, name);
+  }
+
+  /// Remove all caption regions registered with [setCaptionRegion].
+  Future<void> clearCaptionRegions() async {
+    _checkInitialized();
+    PluginBindings.clearCaptionRegions(_gtkWindow);
+  }
+
   // ==========================================================================
   // Linux-Specific Features
   // ==========================================================================
@@ -211,6 +522,53 @@ class WindowDecorationLinux extends WindowDecorationPlatform {
   /// Check if running on X11
   Future<bool> isX11() async => DisplayServerHelper.isX11();
 
+  /// Move the window (and shrink it if it doesn't fit) into the work area
+  /// of the monitor holding most of it.
+  ///
+  /// Returns false if the native plugin isn't available.
+  Future<bool> clampToWorkArea() async {
+    _checkInitialized();
+    return PluginBindings.placeWindow(_gtkWindow, PluginBindings.PLACEMENT_CLAMP_TO_WORK_AREA);
+  }
+
+  /// Place the window below and right of [anchorWindow] (a GtkWindow
+  /// pointer), starting over at the work area's top-left where it would
+  /// leave the anchor's work area.
+  ///
+  /// Returns false if the native plugin isn't available.
+  Future<bool> cascadeFrom(Pointer<Void> anchorWindow) async {
+    _checkInitialized();
+    return PluginBindings.placeWindow(_gtkWindow, PluginBindings.PLACEMENT_CASCADE, anchor: anchorWindow);
+  }
+
+  /// Pace interactive resizes to the display refresh.
+  ///
+  /// While enabled, the sizes the window manager reports during a resize
+  /// drag are held natively until the window's next frame clock update and
+  /// only the newest one reaches GTK and Flutter, so a slow layout no longer
+  /// builds up a backlog of stale sizes. Call after the window is realized.
+  /// Returns false if pacing couldn't be enabled.
+  Future<bool> setResizePacing(bool enabled) async {
+    _checkInitialized();
+    return PluginBindings.setResizePacing(_gtkWindow, enabled);
+  }
+
+  /// Get the resize pacing counters: sizes reported, applied (at most one
+  /// per frame) and skipped, and the latency from the newest size to the
+  /// frame that applied it. Returns null if pacing is not enabled.
+  ResizePacingStats? getResizePacingStats() {
+    _checkInitialized();
+    return PluginBindings.getResizePacingStats(_gtkWindow);
+  }
+
+  /// Get the animation counters of [animateWindow]: animations started,
+  /// completed and cancelled, frames stepped and frames dropped. Returns
+  /// null if the window was never animated.
+  WindowAnimationStats? getWindowAnimationStats() {
+    _checkInitialized();
+    return PluginBindings.getWindowAnimationStats(_gtkWindow);
+  }
+
   /// Set window type hint (for X11)
   /// Note: This is primarily useful on X11, may not work on Wayland
   Future<void> setWindowTypeHint(String typeHint) async {
@@ -1,3 +1,4 @@
 // Linux implementation of the window_decoration plugin
 
+export 'src/ffi/plugin_bindings.dart' show ResizePacingStats, WindowAnimationStats;
 export 'src/window_decoration_linux.dart';
@@ -0,0 +1,205 @@
+// Window Decoration Linux - Caption drag benchmark
+// Latency from a real button press on a custom frame caption to the window
+// moving, with the press handled by the native frame (SetFrameMode
+// CustomFrame) instead of a Flutter gesture. Input is injected with XTest,
+// so the press carries a server timestamp exactly like a user's click.
+// Needs an X display; run it under Xvfb:
+//
+//   xvfb-run -a ./caption_drag_benchmark
+//
+// Without a window manager GDK emulates the move with its own pointer grab.
+// With one, the press is handed to it (_NET_WM_MOVERESIZE) and the
+// double-click check runs too:
+//
+//   xvfb-run -a sh -c 'openbox & sleep 1; ./caption_drag_benchmark'
+//
+// Every drag must move the window by exactly the pointer delta. Presses on
+// caption buttons and client regions must reach the window and leave it in
+// place. Any mismatch exits with status 1.
+
+#include <gdk/gdkx.h>
+#include <gtk/gtk.h>
+#include <X11/extensions/XTest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/hit_test.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+extern "C" bool SetFrameMode(void* handle, int mode);
+extern "C" void SetCaptionHeight(void* handle, int height);
+extern "C" void SetCaptionButtonZones(void* handle,
+    int minLeft, int minTop, int minRight, int minBottom,
+    int maxLeft, int maxTop, int maxRight, int maxBottom,
+    int closeLeft, int closeTop, int closeRight, int closeBottom);
+extern "C" bool SetCaptionRegion(void* handle, const char* name, int hit,
+    int left, int top, int right, int bottom, int cornerRadius);
+
+typedef std::chrono::steady_clock Clock;
+
+struct Point {
+    int x;
+    int y;
+};
+
+// Let the X server and GTK catch up: sync, then run events until none
+// arrive for a few milliseconds
+static void Settle(Display* display) {
+    Clock::time_point quietSince = Clock::now();
+    while (Clock::now() - quietSince < std::chrono::milliseconds(20)) {
+        XSync(display, False);
+        if (gtk_events_pending()) {
+            while (gtk_events_pending()) {
+                gtk_main_iteration_do(FALSE);
+            }
+            quietSince = Clock::now();
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+static Point GetOrigin(GdkWindow* window) {
+    Point origin = { 0, 0 };
+    gdk_window_get_origin(window, &origin.x, &origin.y);
+    return origin;
+}
+
+// Click at `offset` from the window origin without moving; returns whether
+// the window stayed in place
+static bool ClickInPlace(Display* display, GdkWindow* window, Point offset) {
+    Point origin = GetOrigin(window);
+    XTestFakeMotionEvent(display, -1, origin.x + offset.x, origin.y + offset.y, CurrentTime);
+    XTestFakeButtonEvent(display, 1, True, CurrentTime);
+    XTestFakeButtonEvent(display, 1, False, CurrentTime);
+    Settle(display);
+
+    Point after = GetOrigin(window);
+    return after.x == origin.x && after.y == origin.y;
+}
+
+static gboolean CountPress(GtkWidget*, GdkEvent*, gpointer data) {
+    (*static_cast<int*>(data))++;
+    return FALSE;
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    if (!gtk_init_check(&argc, &argv) || !GDK_IS_X11_DISPLAY(gdk_display_get_default())) {
+        std::printf("No X display; run under xvfb-run\n");
+        return 1;
+    }
+
+    Display* display = gdk_x11_display_get_xdisplay(gdk_display_get_default());
+    int eventBase, errorBase, major, minor;
+    if (!XTestQueryExtension(display, &eventBase, &errorBase, &major, &minor)) {
+        std::printf("The X server has no XTest extension\n");
+        return 1;
+    }
+
+    // 640x480 custom frame window: 40 px caption, a close button zone at
+    // the right end and a "tab" client region
+    GtkWindow* window = GTK_WINDOW(gtk_window_new(GTK_WINDOW_TOPLEVEL));
+    GtkWidget* widget = GTK_WIDGET(window);
+    gtk_widget_add_events(widget, GDK_BUTTON_PRESS_MASK);
+    gtk_window_set_decorated(window, FALSE);
+    gtk_window_set_default_size(window, 640, 480);
+    gtk_window_move(window, 100, 100);
+    gtk_widget_show(widget);
+    Settle(display);
+
+    SetFrameMode(window, static_cast<int>(FrameMode::CustomFrame));
+    SetCaptionHeight(window, 40);
+    SetCaptionButtonZones(window, 520, 0, 560, 40, 560, 0, 600, 40, 600, 0, 640, 40);
+    SetCaptionRegion(window, "tab", static_cast<int>(HitCode::Client), 100, 0, 200, 40, 0);
+
+    int presses = 0;
+    g_signal_connect(widget, "button-press-event", G_CALLBACK(CountPress), &presses);
+
+    GdkWindow* gdkWindow = gtk_widget_get_window(widget);
+    const Point caption = { 300, 20 };
+    const int iterations = 50;
+    const std::chrono::seconds timeout(2);
+    uint64_t errors = 0;
+    double totalNs = 0;
+    int measured = 0;
+
+    for (int i = 0; i < iterations; i++) {
+        int delta = i & 1 ? -40 : 40;
+        Point origin = GetOrigin(gdkWindow);
+        Point start = { origin.x + caption.x, origin.y + caption.y };
+        XTestFakeMotionEvent(display, -1, start.x, start.y, CurrentTime);
+        Settle(display);
+
+        // Press and move right away, then wait for the window to follow. The
+        // first motion passes the drag threshold and starts the move; the
+        // window follows the second.
+        Clock::time_point pressed = Clock::now();
+        XTestFakeButtonEvent(display, 1, True, CurrentTime);
+        XTestFakeMotionEvent(display, -1, start.x + delta / 2, start.y + delta / 2, CurrentTime);
+        XTestFakeMotionEvent(display, -1, start.x + delta, start.y + delta, CurrentTime);
+        XFlush(display);
+
+        bool moved = false;
+        while (!moved && Clock::now() - pressed < timeout) {
+            while (gtk_events_pending()) {
+                gtk_main_iteration_do(FALSE);
+            }
+            Point now = GetOrigin(gdkWindow);
+            moved = now.x != origin.x || now.y != origin.y;
+        }
+        if (moved) {
+            totalNs += static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - pressed).count());
+            measured++;
+        }
+
+        XTestFakeButtonEvent(display, 1, False, CurrentTime);
+        Settle(display);
+
+        Point after = GetOrigin(gdkWindow);
+        errors += after.x != origin.x + delta || after.y != origin.y + delta ? 1 : 0;
+    }
+
+    // Caption presses never reach the window
+    errors += presses != 0 ? 1 : 0;
+
+    double latencyNs = measured > 0 ? totalNs / measured : 0;
+    bool ok = Report("caption press to window move", latencyNs, maxNs);
+    errors += static_cast<uint64_t>(iterations - measured);
+
+    // Caption button zones and client regions keep their presses
+    errors += ClickInPlace(display, gdkWindow, { 620, 20 }) ? 0 : 1;
+    errors += ClickInPlace(display, gdkWindow, { 150, 20 }) ? 0 : 1;
+    errors += presses != 2 ? 1 : 0;
+
+    // Double-click maximize needs a window manager to honor the request
+    GdkAtom maximizeHint = gdk_atom_intern_static_string("_NET_WM_STATE_MAXIMIZED_VERT");
+    if (gdk_x11_screen_supports_net_wm_hint(gtk_widget_get_screen(widget), maximizeHint)) {
+        for (int expected = 1; expected >= 0; expected--) {
+            Point origin = GetOrigin(gdkWindow);
+            XTestFakeMotionEvent(display, -1, origin.x + caption.x, origin.y + caption.y, CurrentTime);
+            for (int click = 0; click < 2; click++) {
+                XTestFakeButtonEvent(display, 1, True, CurrentTime);
+                XTestFakeButtonEvent(display, 1, False, CurrentTime);
+            }
+            Settle(display);
+            errors += static_cast<int>(gtk_window_is_maximized(window) ? 1 : 0) != expected ? 1 : 0;
+        }
+    } else {
+        std::printf("%-40s %10s\n", "Double-click maximize", "skipped");
+    }
+
+    gtk_widget_destroy(widget);
+
+    if (errors != 0) {
+        std::printf("Caption drag mismatches: %llu\n", static_cast<unsigned long long>(errors));
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,143 @@
+// Window Decoration Linux - Config apply benchmark
+// Latency of applying a WindowDecorationConfig to a real GtkWindow, with
+// the property-by-property sequence DecoratedWindow used to run (one GTK
+// call per property, decorations always set) versus one
+// ApplyDecorationConfig call. Each apply is followed by a round trip to the
+// X server so window manager work is included. Needs a display; run it
+// under Xvfb:
+//
+//   xvfb-run -a ./config_apply_benchmark
+//
+// After every batched apply the window must match the config; a mismatch
+// exits with status 1.
+
+#include <gtk/gtk.h>
+
+#include <cmath>
+#include <cstdint>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/decoration_config.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+extern "C" bool ApplyDecorationConfig(void* handle, const uint8_t* blob, size_t length);
+
+// Wait for the X server, then run whatever it sent back
+static void Flush(GtkWidget* widget) {
+    gdk_display_sync(gtk_widget_get_display(widget));
+    while (gtk_events_pending()) {
+        gtk_main_iteration_do(FALSE);
+    }
+}
+
+// The per-property sequence: every setter of the config, unconditionally
+static void ApplySequentially(GtkWindow* window, const DecorationConfig& config) {
+    GtkWidget* widget = GTK_WIDGET(window);
+    if (config.has(DECORATION_CONFIG_CENTERED)) {
+        int width = 0;
+        int height = 0;
+        gtk_window_get_size(window, &width, &height);
+        GdkRectangle area;
+        gdk_monitor_get_workarea(gdk_display_get_monitor(gtk_widget_get_display(widget), 0), &area);
+        gtk_window_move(window, (area.width - width) / 2, (area.height - height) / 2);
+    }
+    if (config.has(DECORATION_CONFIG_ALWAYS_ON_TOP)) {
+        gtk_window_set_keep_above(window, TRUE);
+    }
+    if (config.has(DECORATION_CONFIG_SKIP_TASKBAR)) {
+        gtk_window_set_skip_taskbar_hint(window, TRUE);
+    }
+    if (config.has(DECORATION_CONFIG_HAS_OPACITY)) {
+        gtk_widget_set_opacity(widget, config.opacity);
+    }
+    gtk_window_set_decorated(window, config.decorated());
+    if (config.has(DECORATION_CONFIG_VISIBLE)) {
+        gtk_widget_show(widget);
+    } else {
+        gtk_widget_hide(widget);
+    }
+}
+
+static bool Matches(GtkWindow* window, const DecorationConfig& config) {
+    GtkWidget* widget = GTK_WIDGET(window);
+    return static_cast<bool>(gtk_window_get_decorated(window)) == config.decorated() &&
+           static_cast<bool>(gtk_widget_get_visible(widget)) == config.has(DECORATION_CONFIG_VISIBLE) &&
+           (!config.has(DECORATION_CONFIG_HAS_OPACITY) ||
+            std::fabs(gtk_widget_get_opacity(widget) - config.opacity) < 0.01);
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    if (!gtk_init_check(&argc, &argv)) {
+        std::printf("No display; run under xvfb-run\n");
+        return 1;
+    }
+
+    GtkWindow* window = GTK_WINDOW(gtk_window_new(GTK_WINDOW_TOPLEVEL));
+    gtk_window_set_default_size(window, 800, 600);
+    gtk_widget_show(GTK_WIDGET(window));
+    Flush(GTK_WIDGET(window));
+
+    // A typical custom-frame config, and a plain one to switch to
+    DecorationConfig custom = {};
+    custom.flags = DECORATION_CONFIG_CENTERED | DECORATION_CONFIG_SKIP_TASKBAR | DECORATION_CONFIG_VISIBLE |
+                   DECORATION_CONFIG_HAS_BACKGROUND | DECORATION_CONFIG_HAS_OPACITY;
+    custom.backgroundColor = 0xFF202020;
+    custom.opacity = 0.95f;
+    custom.captionHeight = 32;
+    custom.titleBarStyle = TitleBarStyle::CustomFrame;
+
+    DecorationConfig plain = {};
+    plain.flags = DECORATION_CONFIG_VISIBLE | DECORATION_CONFIG_HAS_OPACITY;
+    plain.opacity = 1.0f;
+    plain.titleBarStyle = TitleBarStyle::Normal;
+
+    uint8_t customBlob[MAX_DECORATION_CONFIG_BYTES];
+    uint8_t plainBlob[MAX_DECORATION_CONFIG_BYTES];
+    size_t customLength = EncodeDecorationConfig(custom, customBlob, sizeof(customBlob));
+    size_t plainLength = EncodeDecorationConfig(plain, plainBlob, sizeof(plainBlob));
+
+    const uint64_t iterations = 2000;
+    GtkWidget* widget = GTK_WIDGET(window);
+    bool ok = true;
+    uint64_t mismatches = 0;
+
+    // The same config again (the common case: the window already matches)
+    double sequentialSameNs = MeasureNsPerOp(iterations, [&](uint64_t) {
+        ApplySequentially(window, custom);
+        Flush(widget);
+    });
+    Report("per property, unchanged config", sequentialSameNs, 0);
+
+    double batchedSameNs = MeasureNsPerOp(iterations, [&](uint64_t) {
+        ApplyDecorationConfig(window, customBlob, customLength);
+        Flush(widget);
+        mismatches += Matches(window, custom) ? 0 : 1;
+    });
+    ok &= Report("ApplyDecorationConfig, unchanged config", batchedSameNs, maxNs);
+
+    // Switching between the two configs on every apply
+    double sequentialSwitchNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+        ApplySequentially(window, i & 1 ? plain : custom);
+        Flush(widget);
+    });
+    Report("per property, switching configs", sequentialSwitchNs, 0);
+
+    double batchedSwitchNs = MeasureNsPerOp(iterations, [&](uint64_t i) {
+        bool usePlain = (i & 1) != 0;
+        ApplyDecorationConfig(window, usePlain ? plainBlob : customBlob, usePlain ? plainLength : customLength);
+        Flush(widget);
+        mismatches += Matches(window, usePlain ? plain : custom) ? 0 : 1;
+    });
+    Report("ApplyDecorationConfig, switching configs", batchedSwitchNs, 0);
+
+    gtk_widget_destroy(widget);
+
+    if (mismatches != 0) {
+        std::printf("Window did not match the config %llu times\n", static_cast<unsigned long long>(mismatches));
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
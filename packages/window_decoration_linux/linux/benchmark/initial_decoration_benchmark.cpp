@@ -0,0 +1,203 @@
+// Window Decoration Linux - Initial decoration benchmark
+// Time from gtk_widget_show() to the first frame that has the app's
+// decoration (no window manager frame, its size, centered), two ways:
+//
+//   - post-frame: the window is shown with the default frame and the
+//     config is applied once the first frame was drawn, the way
+//     DecoratedWindow does from a post-frame callback
+//   - pre-show: the runner calls ApplyInitialDecoration before showing
+//     the window
+//
+// A frame is one draw of the window. Needs a display; run it under Xvfb:
+//
+//   xvfb-run -a ./initial_decoration_benchmark
+//
+// The pre-show path must get the very first frame right; frames drawn
+// before the decoration was right are reported for both paths. Any
+// mismatch exits with status 1.
+
+#include <gtk/gtk.h>
+
+#include <cstdint>
+#include <cstdio>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/decoration_config.h"
+#include "window_decoration_linux/window_decoration_linux_plugin.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+extern "C" bool ApplyDecorationConfig(void* handle, const uint8_t* blob, size_t length);
+extern "C" bool GetInitialDecoration(void* handle, InitialDecoration* decoration);
+
+static const int kWidth = 800;
+static const int kHeight = 600;
+static const int kCaptionHeight = 32;
+static const uint32_t kBackground = 0xFF202020;
+
+// One shown window, from gtk_widget_show() to its first correct frame
+struct FrameLog {
+    Rect target;
+    gint64 shownUs;
+    gint64 correctUs;  // 0 until a frame had the decoration
+    int wrongFrames;   // frames drawn before that
+    bool postFrame;    // apply the config after the first frame
+    bool applied;
+};
+
+static bool HasDecoration(GtkWindow* window, const Rect& target) {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    gtk_window_get_position(window, &x, &y);
+    gtk_window_get_size(window, &width, &height);
+    return !gtk_window_get_decorated(window) && x == target.left && y == target.top &&
+           width == target.right - target.left && height == target.bottom - target.top;
+}
+
+// What DecoratedWindow's post-frame callback does: one ApplyDecorationConfig
+static gboolean ApplyAfterFirstFrame(gpointer data) {
+    GtkWindow* window = GTK_WINDOW(data);
+    DecorationConfig config = {};
+    config.flags = DECORATION_CONFIG_CENTERED | DECORATION_CONFIG_VISIBLE | DECORATION_CONFIG_HAS_BACKGROUND;
+    config.backgroundColor = kBackground;
+    config.opacity = 1.0f;
+    config.captionHeight = kCaptionHeight;
+    config.titleBarStyle = TitleBarStyle::CustomFrame;
+    uint8_t blob[MAX_DECORATION_CONFIG_BYTES];
+    size_t length = EncodeDecorationConfig(config, blob, sizeof(blob));
+    ApplyDecorationConfig(window, blob, length);
+    return G_SOURCE_REMOVE;
+}
+
+// Connected after the window's own draw handler
+static gboolean OnDraw(GtkWidget* widget, cairo_t*, gpointer data) {
+    FrameLog* log = static_cast<FrameLog*>(data);
+    if (log->correctUs != 0) {
+        return FALSE;
+    }
+    if (HasDecoration(GTK_WINDOW(widget), log->target)) {
+        log->correctUs = g_get_monotonic_time();
+        return FALSE;
+    }
+    log->wrongFrames++;
+    if (log->postFrame && !log->applied) {
+        log->applied = true;
+        g_idle_add(ApplyAfterFirstFrame, widget);
+    }
+    return FALSE;
+}
+
+// Show a new window decorated one way or the other and run the main loop
+// until it drew a correct frame (or 2 s passed). Returns false on timeout.
+static bool ShowDecorated(bool preShow, const Rect& target, FrameLog* log) {
+    GtkWindow* window = GTK_WINDOW(gtk_window_new(GTK_WINDOW_TOPLEVEL));
+    gtk_window_set_default_size(window, kWidth, kHeight);
+    *log = FrameLog();
+    log->target = target;
+    log->postFrame = !preShow;
+    g_signal_connect_after(window, "draw", G_CALLBACK(OnDraw), log);
+
+    if (preShow) {
+        InitialDecoration decoration = {};
+        decoration.flags = INITIAL_DECORATION_HAS_BOUNDS | INITIAL_DECORATION_CENTERED |
+                           INITIAL_DECORATION_HAS_BACKGROUND;
+        decoration.frameMode = static_cast<int32_t>(FrameMode::CustomFrame);
+        decoration.captionHeight = kCaptionHeight;
+        decoration.backgroundColor = kBackground;
+        decoration.bounds = { 0, 0, kWidth, kHeight };
+        ApplyInitialDecoration(window, &decoration);
+    }
+
+    log->shownUs = g_get_monotonic_time();
+    gtk_widget_show(GTK_WIDGET(window));
+    gint64 deadline = log->shownUs + 2000 * 1000;
+    while (log->correctUs == 0 && g_get_monotonic_time() < deadline) {
+        gtk_main_iteration_do(FALSE);
+        g_usleep(100);
+    }
+    gtk_widget_destroy(GTK_WIDGET(window));
+    while (gtk_events_pending()) {
+        gtk_main_iteration_do(FALSE);
+    }
+    return log->correctUs != 0;
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    if (!gtk_init_check(&argc, &argv)) {
+        std::printf("No display; run under xvfb-run\n");
+        return 1;
+    }
+
+    GdkDisplay* display = gdk_display_get_default();
+    GdkMonitor* monitor = gdk_display_get_primary_monitor(display);
+    if (monitor == nullptr) {
+        monitor = gdk_display_get_monitor(display, 0);
+    }
+    GdkRectangle area;
+    gdk_monitor_get_workarea(monitor, &area);
+    const int left = area.x + (area.width - kWidth) / 2;
+    const int top = area.y + (area.height - kHeight) / 2;
+    const Rect target = { left, top, left + kWidth, top + kHeight };
+
+    uint64_t errors = 0;
+
+    // Invalid decorations are refused and leave nothing behind
+    {
+        GtkWindow* window = GTK_WINDOW(gtk_window_new(GTK_WINDOW_TOPLEVEL));
+        InitialDecoration invalid = {};
+        invalid.frameMode = 7;
+        errors += ApplyInitialDecoration(window, &invalid) || ApplyInitialDecoration(nullptr, &invalid) ? 1 : 0;
+        invalid.frameMode = static_cast<int32_t>(FrameMode::Hidden);
+        invalid.flags = INITIAL_DECORATION_HAS_BOUNDS;
+        errors += ApplyInitialDecoration(window, &invalid) ? 1 : 0;
+        errors += GetInitialDecoration(window, nullptr) ? 1 : 0;
+
+        InitialDecoration hidden = {};
+        hidden.frameMode = static_cast<int32_t>(FrameMode::Hidden);
+        InitialDecoration applied = {};
+        errors += ApplyInitialDecoration(window, &hidden) ? 0 : 1;
+        errors += GetInitialDecoration(window, &applied) && applied.frameMode == hidden.frameMode ? 0 : 1;
+        errors += gtk_window_get_decorated(window) ? 1 : 0;
+        gtk_widget_destroy(GTK_WIDGET(window));
+    }
+
+    const int kRuns = 10;
+    bool ok = true;
+    for (int preShow = 0; preShow <= 1; preShow++) {
+        gint64 totalUs = 0;
+        int wrongFrames = 0;
+        for (int run = 0; run < kRuns; run++) {
+            FrameLog log;
+            if (!ShowDecorated(preShow != 0, target, &log)) {
+                errors++;
+                continue;
+            }
+            totalUs += log.correctUs - log.shownUs;
+            wrongFrames += log.wrongFrames;
+        }
+        // The pre-show path must never draw the default frame
+        if (preShow && wrongFrames != 0) {
+            errors++;
+        }
+
+        double ns = static_cast<double>(totalUs) * 1000.0 / kRuns;
+        if (preShow) {
+            ok &= Report("Pre-show: show to correct first frame", ns, maxNs);
+        } else {
+            // The path being replaced; reported, not held to the budget
+            Report("Post-frame: show to correct frame", ns, 0);
+        }
+        std::printf("%-40s %.1f wrong frames per window\n", preShow ? "Pre-show" : "Post-frame",
+                    static_cast<double>(wrongFrames) / kRuns);
+    }
+
+    if (errors != 0) {
+        std::printf("Initial decoration mismatches: %llu\n", static_cast<unsigned long long>(errors));
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,164 @@
+// Window Decoration Linux - Platform capabilities benchmark
+// Startup cost of finding out what the display supports and getting at the
+// GTK calls the Dart bindings make, two ways:
+//
+//   - per symbol: open GTK, GDK and X11 and look up every function, the
+//     way GtkBindings did (dlopen/dlsym stand in for DynamicLibrary)
+//   - probe: the first GetPlatformCapabilities() call, which probes the
+//     display once and hands out the plugin's function table
+//
+// Then the cost of every later call. Needs a display; run it under Xvfb:
+//
+//   xvfb-run -a ./platform_capabilities_benchmark
+//
+// Checks the table against the symbols, the flags and _NET_WM hints
+// against GDK, the versions against GTK and uname, and that threads
+// asking at once get the same probe. Any mismatch exits with status 1.
+
+#include <dlfcn.h>
+#include <gdk/gdkx.h>
+#include <gtk/gtk.h>
+#include <sys/utsname.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/platform_capabilities.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+extern "C" const PlatformCapabilities* GetPlatformCapabilities();
+
+// The functions in the plugin's GtkFunctionTable, in table order
+static const char* const kTableSymbols[] = {
+    "gtk_window_move",
+    "gtk_window_resize",
+    "gtk_window_get_position",
+    "gtk_window_get_size",
+    "gtk_window_set_opacity",
+    "gtk_window_set_keep_above",
+    "gtk_window_set_skip_taskbar_hint",
+    "gtk_window_fullscreen",
+    "gtk_window_unfullscreen",
+    "gtk_window_set_decorated",
+    "gtk_widget_show",
+    "gtk_widget_hide",
+    "gdk_window_set_opacity",
+    "gdk_screen_get_default",
+    "gdk_screen_get_width",
+    "gdk_screen_get_height",
+};
+static const size_t kTableSize = sizeof(kTableSymbols) / sizeof(kTableSymbols[0]);
+
+// What GtkBindings paid before its first call: three libraries opened and
+// one lookup per function (plus the X11 display functions)
+static bool ResolvePerSymbol(void** resolved) {
+    void* gtk = dlopen("libgtk-3.so.0", RTLD_NOW);
+    void* gdk = dlopen("libgdk-3.so.0", RTLD_NOW);
+    void* x11 = dlopen("libX11.so.6", RTLD_NOW);
+    bool ok = gtk != nullptr && gdk != nullptr && x11 != nullptr;
+    if (ok) {
+        for (size_t i = 0; i < kTableSize; i++) {
+            resolved[i] = dlsym(std::strncmp(kTableSymbols[i], "gtk_", 4) == 0 ? gtk : gdk, kTableSymbols[i]);
+            ok &= resolved[i] != nullptr;
+        }
+        ok &= dlsym(x11, "XOpenDisplay") != nullptr && dlsym(x11, "XCloseDisplay") != nullptr;
+    }
+    if (x11) dlclose(x11);
+    if (gdk) dlclose(gdk);
+    if (gtk) dlclose(gtk);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    if (!gtk_init_check(&argc, &argv)) {
+        std::printf("No display; run under xvfb-run\n");
+        return 1;
+    }
+    uint64_t errors = 0;
+
+    // The first call probes; time it once, like an app's startup would
+    auto probeStart = std::chrono::steady_clock::now();
+    const PlatformCapabilities* capabilities = GetPlatformCapabilities();
+    auto probeEnd = std::chrono::steady_clock::now();
+    double probeNs = std::chrono::duration<double, std::nano>(probeEnd - probeStart).count();
+
+    void* resolved[kTableSize] = {};
+    errors += ResolvePerSymbol(resolved) ? 0 : 1;
+    double perSymbolNs = MeasureNsPerOp(200, [&](uint64_t) { DoNotOptimize(ResolvePerSymbol(resolved)); });
+
+    bool ok = Report("First GetPlatformCapabilities (probe + table)", probeNs, maxNs);
+    Report("Open GTK/GDK/X11 + per-symbol lookups", perSymbolNs, 0);
+    double getNs = MeasureNsPerOp(10000000, [&](uint64_t) { DoNotOptimize(GetPlatformCapabilities()->flags); });
+    Report("GetPlatformCapabilities (probed)", getNs, 0);
+
+    // The table is the functions Dart would have looked up
+    errors += capabilities->functionsSize == kTableSize * sizeof(void*) ? 0 : 1;
+    const void* const* table = static_cast<const void* const*>(capabilities->functions);
+    for (size_t i = 0; i < kTableSize && capabilities->functionsSize >= (i + 1) * sizeof(void*); i++) {
+        if (table[i] != resolved[i]) {
+            std::printf("Table entry %s doesn't match dlsym\n", kTableSymbols[i]);
+            errors++;
+        }
+    }
+
+    // Flags and hints as GDK reports them
+    GdkDisplay* display = gdk_display_get_default();
+    GdkScreen* screen = gdk_display_get_default_screen(display);
+    bool x11 = GDK_IS_X11_DISPLAY(display);
+    errors += ((capabilities->flags & CAPABILITY_X11) != 0) == x11 ? 0 : 1;
+    errors += (capabilities->flags & CAPABILITY_WAYLAND) == 0 ? 0 : 1;
+    errors += ((capabilities->flags & CAPABILITY_COMPOSITOR) != 0) == (gdk_screen_is_composited(screen) != FALSE) ? 0 : 1;
+    uint32_t hints = 0;
+    for (size_t i = 0; x11 && i < NET_WM_ATOM_COUNT; i++) {
+        if (gdk_x11_screen_supports_net_wm_hint(screen, gdk_atom_intern_static_string(NET_WM_ATOM_NAMES[i]))) {
+            hints |= 1u << i;
+        }
+    }
+    errors += capabilities->netWmAtoms == hints ? 0 : 1;
+
+    // Versions
+    errors += capabilities->toolkitMajor == gtk_get_major_version() &&
+              capabilities->toolkitMinor == gtk_get_minor_version() &&
+              capabilities->toolkitMicro == gtk_get_micro_version() ? 0 : 1;
+    struct utsname system;
+    uint32_t major = 0;
+    uint32_t minor = 0;
+    uint32_t build = 0;
+    errors += uname(&system) == 0 && ParseOsVersion(system.release, &major, &minor, &build) &&
+              capabilities->osMajor == major && capabilities->osMinor == minor &&
+              capabilities->osBuild == build ? 0 : 1;
+
+    // Everyone gets the one probe
+    std::atomic<int> mismatches(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&]() {
+            if (GetPlatformCapabilities() != capabilities) {
+                mismatches.fetch_add(1);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    errors += mismatches.load() == 0 ? 0 : 1;
+
+    std::printf("flags 0x%x, _NET_WM hints 0x%x, GTK %u.%u.%u, kernel %u.%u.%u\n", capabilities->flags,
+                capabilities->netWmAtoms, capabilities->toolkitMajor, capabilities->toolkitMinor,
+                capabilities->toolkitMicro, capabilities->osMajor, capabilities->osMinor, capabilities->osBuild);
+
+    if (errors != 0) {
+        std::printf("Platform capabilities mismatches: %llu\n", static_cast<unsigned long long>(errors));
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
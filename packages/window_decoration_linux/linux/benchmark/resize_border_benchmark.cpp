@@ -0,0 +1,185 @@
+// Window Decoration Linux - Resize border benchmark
+// Cost of a pointer event through the native resize border handler
+// (filter, hit test, cursor update) on a real undecorated GtkWindow, against
+// the same event with the borders left to the window manager. Events are
+// synthesized with gdk_event_put() and dispatched by the GTK main loop, the
+// way X events are. Needs a display; run it under Xvfb, also with
+// GDK_SCALE=2 to check the DPI scaling of the borders:
+//
+//   xvfb-run -a ./resize_border_benchmark
+//   GDK_SCALE=2 xvfb-run -a ./resize_border_benchmark
+//
+// The cursor shown at probe points all around the frame must follow the
+// hidden frame rules of window_decoration_core (HitTestHiddenFrame), a
+// primary press on a border must not reach the window, and a press inside
+// must. Any mismatch exits with status 1.
+
+#include <gtk/gtk.h>
+
+#include <cstdint>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/cursor_cache.h"
+#include "window_decoration_core/hit_test.h"
+#include "window_decoration_core/hover_memo.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+extern "C" bool SetFrameMode(void* handle, int mode);
+extern "C" bool GetHoverStats(void* handle, HoverStats* stats);
+
+// Run everything GTK has queued
+static void Flush() {
+    while (gtk_events_pending()) {
+        gtk_main_iteration_do(FALSE);
+    }
+}
+
+// Queue a pointer event at (x, y), logical window coordinates
+static void PutPointerEvent(GdkWindow* window, GdkEventType type, double x, double y) {
+    GdkEvent* event = gdk_event_new(type);
+    GdkDevice* pointer = gdk_seat_get_pointer(gdk_display_get_default_seat(gdk_window_get_display(window)));
+    gdk_event_set_device(event, pointer);
+
+    if (type == GDK_MOTION_NOTIFY) {
+        event->motion.window = static_cast<GdkWindow*>(g_object_ref(window));
+        event->motion.time = GDK_CURRENT_TIME;
+        event->motion.x = x;
+        event->motion.y = y;
+        event->motion.x_root = x;
+        event->motion.y_root = y;
+    } else {
+        event->button.window = static_cast<GdkWindow*>(g_object_ref(window));
+        event->button.time = GDK_CURRENT_TIME;
+        event->button.button = GDK_BUTTON_PRIMARY;
+        event->button.x = x;
+        event->button.y = y;
+        event->button.x_root = x;
+        event->button.y_root = y;
+    }
+
+    gdk_event_put(event);
+    gdk_event_free(event);
+}
+
+static gboolean CountPress(GtkWidget*, GdkEvent*, gpointer data) {
+    (*static_cast<int*>(data))++;
+    return FALSE;
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    if (!gtk_init_check(&argc, &argv)) {
+        std::printf("No display; run under xvfb-run\n");
+        return 1;
+    }
+
+    const int width = 800;
+    const int height = 600;
+    GtkWindow* window = GTK_WINDOW(gtk_window_new(GTK_WINDOW_TOPLEVEL));
+    GtkWidget* widget = GTK_WIDGET(window);
+    gtk_window_set_decorated(window, FALSE);
+    gtk_window_set_default_size(window, width, height);
+    gtk_widget_show(widget);
+    gdk_display_sync(gtk_widget_get_display(widget));
+    Flush();
+
+    GdkWindow* gdkWindow = gtk_widget_get_window(widget);
+    int scale = gdk_window_get_scale_factor(gdkWindow);
+    int windowWidth = gdk_window_get_width(gdkWindow);
+    int windowHeight = gdk_window_get_height(gdkWindow);
+
+    int presses = 0;
+    g_signal_connect(widget, "button-press-event", G_CALLBACK(CountPress), &presses);
+
+    // Moves along a row just inside the left edge, so most of them stay in
+    // one resize cell
+    const uint64_t iterations = 200000;
+    auto move = [&](uint64_t i) {
+        PutPointerEvent(gdkWindow, GDK_MOTION_NOTIFY, 2.0, 40.0 + static_cast<double>(i % 400));
+        Flush();
+    };
+
+    double normalNs = MeasureNsPerOp(iterations, move);
+    Report("pointer move, window manager borders", normalNs, 0);
+
+    SetFrameMode(window, static_cast<int>(FrameMode::Hidden));
+    double nativeNs = MeasureNsPerOp(iterations, move);
+    bool ok = Report("pointer move, native borders", nativeNs, maxNs);
+
+    // Probe points on every edge, corner and corner extension, in device
+    // pixels, checked against the core rules at the window's scale
+    FrameGeometry geometry = {};
+    geometry.windowWidth = windowWidth * scale;
+    geometry.windowHeight = windowHeight * scale;
+    geometry.dpi = 96 * static_cast<unsigned int>(scale);
+    geometry.borderWidth = ScaleForDpi(RESIZE_BORDER_WIDTH, geometry.dpi);
+    geometry.borderHeight = geometry.borderWidth;
+
+    int borderLogical = geometry.borderWidth / scale;
+    int xs[] = { 0, borderLogical - 1, borderLogical, 2 * borderLogical - 1, 2 * borderLogical,
+                 windowWidth / 2, windowWidth - 2 * borderLogical, windowWidth - borderLogical, windowWidth - 1 };
+    int ys[] = { 0, borderLogical - 1, borderLogical, 2 * borderLogical - 1, 2 * borderLogical,
+                 windowHeight / 2, windowHeight - 2 * borderLogical, windowHeight - borderLogical, windowHeight - 1 };
+
+    // One cursor per shape: the first seen is remembered, later ones must
+    // be the same cached cursor
+    GdkCursor* shapeCursors[5] = {};
+    uint64_t errors = 0;
+    for (int y : ys) {
+        for (int x : xs) {
+            PutPointerEvent(gdkWindow, GDK_MOTION_NOTIFY, x + 0.5, y + 0.5);
+            Flush();
+
+            GdkCursor* cursor = gdk_window_get_cursor(gdkWindow);
+            HitCode expected = HitTestHiddenFrame(x * scale, y * scale, geometry);
+            CursorShape shape;
+            if (!CursorShapeForHit(expected, &shape)) {
+                errors += cursor != nullptr ? 1 : 0;
+                continue;
+            }
+
+            GdkCursor*& shapeCursor = shapeCursors[static_cast<int>(shape)];
+            if (shapeCursor == nullptr) {
+                shapeCursor = cursor;
+            }
+            errors += cursor == nullptr || cursor != shapeCursor ? 1 : 0;
+        }
+    }
+
+    // Different shapes must not share a cursor
+    for (int i = 1; i < 5; i++) {
+        for (int j = i + 1; j < 5; j++) {
+            errors += shapeCursors[i] != nullptr && shapeCursors[i] == shapeCursors[j] ? 1 : 0;
+        }
+    }
+
+    // A press on a border starts the resize instead of reaching the window;
+    // one inside is delivered
+    PutPointerEvent(gdkWindow, GDK_BUTTON_PRESS, windowWidth - 1.5, windowHeight / 2.0);
+    Flush();
+    errors += presses != 0 ? 1 : 0;
+    PutPointerEvent(gdkWindow, GDK_BUTTON_PRESS, windowWidth / 2.0, windowHeight / 2.0);
+    Flush();
+    errors += presses != 1 ? 1 : 0;
+
+    HoverStats stats = {};
+    GetHoverStats(window, &stats);
+    std::printf("%-40s %10d\n", "Scale", scale);
+    std::printf("%-40s %10llu\n", "Hover memo hits", static_cast<unsigned long long>(stats.memoHits));
+    std::printf("%-40s %10llu\n", "Hit test evaluations", static_cast<unsigned long long>(stats.evaluations));
+    std::printf("%-40s %10llu\n", "Cursor changes", static_cast<unsigned long long>(stats.cursorChanges));
+
+    // Back to window manager borders: the cursor must be restored
+    SetFrameMode(window, static_cast<int>(FrameMode::Normal));
+    errors += gdk_window_get_cursor(gdkWindow) != nullptr ? 1 : 0;
+
+    gtk_widget_destroy(widget);
+
+    if (errors != 0) {
+        std::printf("Resize border mismatches: %llu\n", static_cast<unsigned long long>(errors));
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,197 @@
+// Window Decoration Linux - Window animation benchmark
+// Animates a real GtkWindow with AnimateWindow, stepped by the window's
+// GdkFrameClock the way an app would, and reports the frames stepped and
+// dropped for each animation. Completion notifications go to a stand-in
+// for NativeApi.postCObject that records them. Needs a display; run it
+// under Xvfb:
+//
+//   xvfb-run -a ./window_animation_benchmark
+//
+// Every animation must end on its target geometry and opacity and post 1;
+// replaced, cancelled and destroyed ones must post 0 exactly once; a
+// hidden window must jump to its target. The stepping itself against a
+// simulated clock is covered by the core window_animation_benchmark. Any
+// mismatch exits with status 1.
+
+#include <gtk/gtk.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/dart_port.h"
+#include "window_decoration_core/window_animation.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+extern "C" bool AnimateWindow(void* handle, const WindowAnimationParams* params, void* postCObject, int64_t port);
+extern "C" bool CancelWindowAnimation(void* handle);
+extern "C" bool GetWindowAnimationStats(void* handle, WindowAnimationStats* stats);
+
+static const int64_t kMs = 1000000;
+
+struct Posted {
+    int64_t port;
+    int64_t value;
+};
+
+static std::vector<Posted> g_posted;
+
+// Stands in for Dart_PostCObject
+static bool RecordPost(int64_t port, DartCObject* message) {
+    if (message->type != DART_COBJECT_INT64) {
+        return false;
+    }
+    g_posted.push_back({ port, message->value.asInt64 });
+    return true;
+}
+
+// Values posted to a port, in order
+static std::vector<int64_t> PostedTo(int64_t port) {
+    std::vector<int64_t> values;
+    for (const Posted& posted : g_posted) {
+        if (posted.port == port) {
+            values.push_back(posted.value);
+        }
+    }
+    return values;
+}
+
+// Wait for the X server, then run whatever it sent back
+static void Flush(GtkWidget* widget) {
+    gdk_display_sync(gtk_widget_get_display(widget));
+    while (gtk_events_pending()) {
+        gtk_main_iteration_do(FALSE);
+    }
+}
+
+// Run the main loop until port got its notification or timeoutMs passed
+static bool WaitForPost(int64_t port, int64_t timeoutMs) {
+    gint64 deadline = g_get_monotonic_time() + timeoutMs * 1000;
+    while (PostedTo(port).empty() && g_get_monotonic_time() < deadline) {
+        gtk_main_iteration_do(FALSE);
+        g_usleep(1000);
+    }
+    return !PostedTo(port).empty();
+}
+
+static WindowAnimationParams MakeParams(const Rect& bounds, double opacity, int64_t durationNs, AnimationCurve curve,
+                                        uint32_t properties) {
+    WindowAnimationParams params;
+    params.bounds = bounds;
+    params.opacity = opacity;
+    params.durationNs = durationNs;
+    params.curve = static_cast<int32_t>(curve);
+    params.properties = properties;
+    return params;
+}
+
+static bool HasBounds(GtkWindow* window, const Rect& bounds) {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    gtk_window_get_position(window, &x, &y);
+    gtk_window_get_size(window, &width, &height);
+    return x == bounds.left && y == bounds.top && width == bounds.right - bounds.left &&
+           height == bounds.bottom - bounds.top;
+}
+
+static void PrintStats(const char* name, const WindowAnimationStats& before, const WindowAnimationStats& after) {
+    std::printf("%-40s %4llu frames, %3llu dropped\n", name,
+                static_cast<unsigned long long>(after.frames - before.frames),
+                static_cast<unsigned long long>(after.droppedFrames - before.droppedFrames));
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    if (!gtk_init_check(&argc, &argv)) {
+        std::printf("No display; run under xvfb-run\n");
+        return 1;
+    }
+
+    GtkWindow* window = GTK_WINDOW(gtk_window_new(GTK_WINDOW_TOPLEVEL));
+    GtkWidget* widget = GTK_WIDGET(window);
+    gtk_window_set_decorated(window, FALSE);
+    gtk_window_set_default_size(window, 640, 480);
+    gtk_window_move(window, 100, 100);
+    gtk_widget_show(widget);
+    Flush(widget);
+
+    void* post = reinterpret_cast<void*>(&RecordPost);
+    uint64_t errors = 0;
+    WindowAnimationStats before = {};
+    WindowAnimationStats stats = {};
+
+    // Slide and grow
+    const Rect grown = { 300, 200, 1100, 800 };
+    WindowAnimationParams slide = MakeParams(grown, 1.0, 250 * kMs, AnimationCurve::EaseInOut, ANIMATE_BOUNDS);
+    errors += AnimateWindow(window, &slide, post, 1) ? 0 : 1;
+    errors += WaitForPost(1, 2000) ? 0 : 1;
+    Flush(widget);
+    errors += PostedTo(1) == std::vector<int64_t>{ 1 } ? 0 : 1;
+    errors += HasBounds(window, grown) ? 0 : 1;
+    errors += GetWindowAnimationStats(window, &stats) && stats.completed == 1 && stats.frames > 1 ? 0 : 1;
+    PrintStats("Slide and grow (250 ms)", before, stats);
+    before = stats;
+
+    // Fade out halfway
+    WindowAnimationParams fade = MakeParams({}, 0.5, 150 * kMs, AnimationCurve::Linear, ANIMATE_OPACITY);
+    errors += AnimateWindow(window, &fade, post, 2) ? 0 : 1;
+    errors += WaitForPost(2, 2000) ? 0 : 1;
+    Flush(widget);
+    errors += PostedTo(2) == std::vector<int64_t>{ 1 } ? 0 : 1;
+    errors += std::fabs(gtk_widget_get_opacity(widget) - 0.5) < 0.01 ? 0 : 1;
+    errors += HasBounds(window, grown) ? 0 : 1;
+    GetWindowAnimationStats(window, &stats);
+    PrintStats("Fade (150 ms)", before, stats);
+    before = stats;
+
+    // Replaced, then cancelled: each posts 0 once and the window stays put
+    const Rect back = { 100, 100, 740, 580 };
+    WindowAnimationParams slow = MakeParams(back, 1.0, 2000 * kMs, AnimationCurve::Linear, ANIMATE_BOUNDS);
+    errors += AnimateWindow(window, &slow, post, 3) ? 0 : 1;
+    errors += AnimateWindow(window, &slow, post, 4) ? 0 : 1;
+    errors += PostedTo(3) == std::vector<int64_t>{ 0 } ? 0 : 1;
+    WaitForPost(4, 100);
+    errors += CancelWindowAnimation(window) && !CancelWindowAnimation(window) ? 0 : 1;
+    errors += PostedTo(4) == std::vector<int64_t>{ 0 } ? 0 : 1;
+    Flush(widget);
+    errors += HasBounds(window, grown) || HasBounds(window, back) ? 1 : 0;
+    GetWindowAnimationStats(window, &stats);
+    errors += stats.cancelled == 2 ? 0 : 1;
+
+    // Invalid params leave nothing running
+    WindowAnimationParams invalid = MakeParams(back, 1.0, 100 * kMs, AnimationCurve::Linear, 0);
+    errors += AnimateWindow(window, &invalid, post, 5) || AnimateWindow(nullptr, &slide, post, 5) ? 1 : 0;
+    errors += PostedTo(5).empty() ? 0 : 1;
+
+    // A hidden window jumps to the target right away
+    gtk_widget_hide(widget);
+    Flush(widget);
+    errors += AnimateWindow(window, &slide, post, 6) ? 0 : 1;
+    errors += PostedTo(6) == std::vector<int64_t>{ 1 } ? 0 : 1;
+    gtk_widget_show(widget);
+    Flush(widget);
+    errors += HasBounds(window, grown) ? 0 : 1;
+
+    // Cost of starting (and cancelling) an animation
+    double startNs = MeasureNsPerOp(100000, [&](uint64_t) {
+        AnimateWindow(window, &slow, nullptr, 0);
+        CancelWindowAnimation(window);
+    });
+    bool ok = Report("AnimateWindow + CancelWindowAnimation", startNs, maxNs);
+
+    // Destroying the window ends a running animation
+    errors += AnimateWindow(window, &slow, post, 7) ? 0 : 1;
+    gtk_widget_destroy(widget);
+    errors += PostedTo(7) == std::vector<int64_t>{ 0 } ? 0 : 1;
+
+    if (errors != 0) {
+        std::printf("Window animation mismatches: %llu\n", static_cast<unsigned long long>(errors));
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
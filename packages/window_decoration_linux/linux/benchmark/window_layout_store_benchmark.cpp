@@ -0,0 +1,219 @@
+// Window Decoration Linux - Window layout store benchmark
+// Saves a real GtkWindow's layout with the exported layout store calls,
+// reopens the file the way a new process would and restores a fresh
+// window from it before it is shown. Needs a display; run it under Xvfb:
+//
+//   xvfb-run -a ./window_layout_store_benchmark
+//
+// Checks:
+//   - a moved and resized window is saved once the debounce delay passed,
+//     not on every configure event, and FlushWindowLayouts() saves at once
+//   - a window restored on the same monitor opens exactly where it was
+//   - monitor mismatch: a layout saved on a monitor that is gone opens
+//     centered on the primary monitor's work area if it would be off
+//     screen, and is pulled into the work area if it is partly on it
+//   - a corrupt file is reported and restores nothing
+//
+// Then the cost of OpenWindowLayoutStore (map and load) plus one
+// RestoreWindowLayout, the work done before the first frame. Any mismatch
+// exits with status 1.
+
+#include <gtk/gtk.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/window_layout_store.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+extern "C" bool OpenWindowLayoutStore(const char* path);
+extern "C" int RestoreWindowLayout(void* handle, const char* id, WindowLayout* layout);
+extern "C" bool FlushWindowLayouts();
+
+// Wait for the X server, then run whatever it sent back
+static void Flush(GtkWidget* widget) {
+    gdk_display_sync(gtk_widget_get_display(widget));
+    while (gtk_events_pending()) {
+        gtk_main_iteration_do(FALSE);
+    }
+}
+
+// Run the main loop for ms milliseconds
+static void RunFor(int64_t ms) {
+    gint64 deadline = g_get_monotonic_time() + ms * 1000;
+    while (g_get_monotonic_time() < deadline) {
+        gtk_main_iteration_do(FALSE);
+        g_usleep(1000);
+    }
+}
+
+static GtkWindow* NewWindow() {
+    GtkWindow* window = GTK_WINDOW(gtk_window_new(GTK_WINDOW_TOPLEVEL));
+    gtk_window_set_decorated(window, FALSE);
+    gtk_window_set_default_size(window, 400, 300);
+    return window;
+}
+
+static Rect WindowRect(GtkWindow* window) {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    gtk_window_get_position(window, &x, &y);
+    gtk_window_get_size(window, &width, &height);
+    return { x, y, x + width, y + height };
+}
+
+static bool SameRect(const Rect& a, const Rect& b) {
+    return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+}
+
+static bool Inside(const Rect& rect, const Rect& area) {
+    return rect.left >= area.left && rect.top >= area.top && rect.right <= area.right && rect.bottom <= area.bottom;
+}
+
+// The layout saved under id in the file at path, as another process
+// would read it
+static bool ReadSavedLayout(const std::string& path, const char* id, WindowLayout* layout) {
+    gchar* contents = nullptr;
+    gsize length = 0;
+    if (!g_file_get_contents(path.c_str(), &contents, &length, nullptr)) {
+        return false;
+    }
+    WindowLayoutStore store;
+    bool found = store.Load(contents, length) && store.Find(id, layout);
+    g_free(contents);
+    return found;
+}
+
+// Write a file holding one layout saved on a monitor that doesn't exist
+static bool WriteForeignLayout(const std::string& path, const char* id, const Rect& bounds) {
+    WindowLayout layout = {};
+    layout.bounds = bounds;
+    layout.monitor = 0x5EED;
+    WindowLayoutStore store;
+    store.Put(id, layout);
+    std::vector<uint8_t> image(store.EncodedSize());
+    store.Encode(image.data(), image.size());
+    return g_file_set_contents(path.c_str(), reinterpret_cast<const gchar*>(image.data()),
+                               static_cast<gssize>(image.size()), nullptr);
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    if (!gtk_init_check(&argc, &argv)) {
+        std::printf("No display; run under xvfb-run\n");
+        return 1;
+    }
+
+    GdkDisplay* display = gdk_display_get_default();
+    GdkMonitor* monitor = gdk_display_get_primary_monitor(display);
+    if (monitor == nullptr) {
+        monitor = gdk_display_get_monitor(display, 0);
+    }
+    GdkRectangle area;
+    gdk_monitor_get_workarea(monitor, &area);
+    const Rect workArea = { area.x, area.y, area.x + area.width, area.y + area.height };
+
+    gchar* pathName = g_strdup_printf("%s/window_layouts_%d.bin", g_get_tmp_dir(), static_cast<int>(getpid()));
+    const std::string path = pathName;
+    g_free(pathName);
+    unlink(path.c_str());
+
+    uint64_t errors = 0;
+    WindowLayout saved = {};
+
+    // No file yet: nothing to restore, but the window is tracked
+    errors += OpenWindowLayoutStore(path.c_str()) ? 0 : 1;
+    GtkWindow* first = NewWindow();
+    errors += RestoreWindowLayout(first, "main", nullptr) == 0 ? 0 : 1;
+    gtk_widget_show(GTK_WIDGET(first));
+    Flush(GTK_WIDGET(first));
+
+    // Move and resize: saved after the delay, not right away
+    const Rect moved = { workArea.left + 40, workArea.top + 30, workArea.left + 40 + 320, workArea.top + 30 + 240 };
+    gtk_window_move(first, moved.left, moved.top);
+    gtk_window_resize(first, moved.right - moved.left, moved.bottom - moved.top);
+    Flush(GTK_WIDGET(first));
+    errors += ReadSavedLayout(path, "main", &saved) ? 1 : 0;
+    RunFor(800);
+    errors += ReadSavedLayout(path, "main", &saved) && SameRect(saved.bounds, moved) ? 0 : 1;
+
+    // Flushed at once
+    const Rect nudged = { moved.left + 10, moved.top, moved.right + 10, moved.bottom };
+    gtk_window_move(first, nudged.left, nudged.top);
+    Flush(GTK_WIDGET(first));
+    errors += FlushWindowLayouts() ? 0 : 1;
+    errors += ReadSavedLayout(path, "main", &saved) && SameRect(saved.bounds, nudged) ? 0 : 1;
+    gtk_widget_destroy(GTK_WIDGET(first));
+
+    // Next run, same monitor: opens where it was left
+    errors += OpenWindowLayoutStore(path.c_str()) ? 0 : 1;
+    GtkWindow* second = NewWindow();
+    WindowLayout restored = {};
+    errors += RestoreWindowLayout(second, "main", &restored) == 1 ? 0 : 1;
+    errors += SameRect(restored.bounds, nudged) ? 0 : 1;
+    gtk_widget_show(GTK_WIDGET(second));
+    Flush(GTK_WIDGET(second));
+    errors += SameRect(WindowRect(second), nudged) ? 0 : 1;
+    gtk_widget_destroy(GTK_WIDGET(second));
+
+    // Saved on a monitor that is gone, far off screen: centered on the
+    // primary monitor
+    const int width = 300;
+    const int height = 200;
+    errors += WriteForeignLayout(path, "main", { 20000, 20000, 20000 + width, 20000 + height }) ? 0 : 1;
+    errors += OpenWindowLayoutStore(path.c_str()) ? 0 : 1;
+    GtkWindow* offScreen = NewWindow();
+    errors += RestoreWindowLayout(offScreen, "main", &restored) == 2 ? 0 : 1;
+    gtk_widget_show(GTK_WIDGET(offScreen));
+    Flush(GTK_WIDGET(offScreen));
+    Rect placed = WindowRect(offScreen);
+    errors += Inside(placed, workArea) && placed.right - placed.left == width ? 0 : 1;
+    errors += placed.left == workArea.left + (workArea.right - workArea.left - width) / 2 ? 0 : 1;
+    gtk_widget_destroy(GTK_WIDGET(offScreen));
+
+    // Saved on a monitor that is gone, hanging off the right edge: pulled
+    // into the work area
+    const Rect overhang = { workArea.right - 100, workArea.top + 50, workArea.right - 100 + width,
+                            workArea.top + 50 + height };
+    errors += WriteForeignLayout(path, "main", overhang) ? 0 : 1;
+    errors += OpenWindowLayoutStore(path.c_str()) ? 0 : 1;
+    GtkWindow* partial = NewWindow();
+    errors += RestoreWindowLayout(partial, "main", &restored) == 2 ? 0 : 1;
+    gtk_widget_show(GTK_WIDGET(partial));
+    Flush(GTK_WIDGET(partial));
+    placed = WindowRect(partial);
+    errors += Inside(placed, workArea) && placed.right == workArea.right && placed.top == overhang.top ? 0 : 1;
+    gtk_widget_destroy(GTK_WIDGET(partial));
+
+    // Corrupt file: reported, nothing restored
+    errors += g_file_set_contents(path.c_str(), "not a layout file", -1, nullptr) ? 0 : 1;
+    errors += OpenWindowLayoutStore(path.c_str()) ? 1 : 0;
+    GtkWindow* unknown = NewWindow();
+    errors += RestoreWindowLayout(unknown, "main", nullptr) == 0 ? 0 : 1;
+    gtk_widget_destroy(GTK_WIDGET(unknown));
+
+    // Startup cost: map and load the file, then restore a hidden window
+    errors += WriteForeignLayout(path, "main", moved) ? 0 : 1;
+    GtkWindow* hidden = NewWindow();
+    double restoreNs = MeasureNsPerOp(2000, [&](uint64_t) {
+        OpenWindowLayoutStore(path.c_str());
+        DoNotOptimize(RestoreWindowLayout(hidden, "main", nullptr));
+    });
+    bool ok = Report("OpenWindowLayoutStore + RestoreWindowLayout", restoreNs, maxNs);
+    gtk_widget_destroy(GTK_WIDGET(hidden));
+
+    unlink(path.c_str());
+    if (errors != 0) {
+        std::printf("Window layout store mismatches: %llu\n", static_cast<unsigned long long>(errors));
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+// Window Decoration Linux - Window state block benchmark
+// Cost of reading a real GtkWindow's state through its WindowStateBlock
+// (OpenWindowStateBlock), the way Dart reads it on every frame, against the
+// QueryWindowState leaf call that asks GTK each time. Needs a display; run
+// it under Xvfb:
+//
+//   xvfb-run -a ./window_state_block_benchmark
+//
+// The block must follow moves, resizes, hide/show and frame mode changes
+// from the window's own signals, and read as gone once the window is
+// destroyed. Any mismatch exits with status 1.
+
+#include <gtk/gtk.h>
+
+#include <cstdint>
+
+#include "benchmark_util.h"
+#include "window_decoration_core/window_state_block.h"
+
+using namespace window_decoration;
+using namespace window_decoration::benchmark;
+
+extern "C" WindowStateInfo QueryWindowState(void* handle);
+extern "C" WindowStateBlock* OpenWindowStateBlock(void* handle);
+extern "C" bool SetFrameMode(void* handle, int mode);
+
+// Wait for the X server, then run whatever it sent back
+static void Flush(GtkWidget* widget) {
+    gdk_display_sync(gtk_widget_get_display(widget));
+    while (gtk_events_pending()) {
+        gtk_main_iteration_do(FALSE);
+    }
+}
+
+static bool ReadBlock(const WindowStateBlock* block, WindowStateInfo* info) {
+    uint64_t window = 0;
+    return ReadWindowState(*block, &window, info);
+}
+
+// The block's bounds must be the window's client area, as GDK reports it
+static bool MatchesWindow(const WindowStateBlock* block, GtkWidget* widget) {
+    WindowStateInfo info;
+    if (!ReadBlock(block, &info)) {
+        return false;
+    }
+
+    GdkWindow* gdkWindow = gtk_widget_get_window(widget);
+    int x = 0;
+    int y = 0;
+    gdk_window_get_origin(gdkWindow, &x, &y);
+    return info.bounds.left == x && info.bounds.top == y &&
+           info.bounds.right - info.bounds.left == gdk_window_get_width(gdkWindow) &&
+           info.bounds.bottom - info.bounds.top == gdk_window_get_height(gdkWindow);
+}
+
+int main(int argc, char** argv) {
+    double maxNs = ParseMaxNs(argc, argv);
+    if (!gtk_init_check(&argc, &argv)) {
+        std::printf("No display; run under xvfb-run\n");
+        return 1;
+    }
+
+    GtkWindow* window = GTK_WINDOW(gtk_window_new(GTK_WINDOW_TOPLEVEL));
+    GtkWidget* widget = GTK_WIDGET(window);
+    gtk_window_set_decorated(window, FALSE);
+    gtk_window_set_default_size(window, 800, 600);
+    gtk_window_move(window, 100, 100);
+    gtk_widget_show(widget);
+    Flush(widget);
+
+    const WindowStateBlock* block = OpenWindowStateBlock(window);
+    uint64_t errors = 0;
+    errors += block == nullptr || OpenWindowStateBlock(window) != block ? 1 : 0;
+    errors += MatchesWindow(block, widget) ? 0 : 1;
+
+    const uint64_t iterations = 1000000;
+    double queryNs = MeasureNsPerOp(iterations, [&](uint64_t) {
+        WindowStateInfo info = QueryWindowState(window);
+        DoNotOptimize(info.bounds.left);
+    });
+    Report("QueryWindowState", queryNs, 0);
+
+    double readNs = MeasureNsPerOp(iterations, [&](uint64_t) {
+        WindowStateInfo info;
+        ReadBlock(block, &info);
+        DoNotOptimize(info.bounds.left);
+    });
+    bool ok = Report("state block read", readNs, maxNs);
+
+    // Moves and resizes arrive as configure events
+    for (int i = 1; i <= 20; i++) {
+        gtk_window_move(window, 100 + i * 10, 100 + i * 5);
+        gtk_window_resize(window, 800 + i * 4, 600 - i * 4);
+        Flush(widget);
+        errors += MatchesWindow(block, widget) ? 0 : 1;
+    }
+
+    // Hide/show arrive as window state events
+    WindowStateInfo info;
+    gtk_widget_hide(widget);
+    Flush(widget);
+    errors += ReadBlock(block, &info) && (info.flags & WINDOW_STATE_VISIBLE) == 0 ? 0 : 1;
+    gtk_widget_show(widget);
+    Flush(widget);
+    errors += ReadBlock(block, &info) && (info.flags & WINDOW_STATE_VISIBLE) != 0 ? 0 : 1;
+
+    // Frame mode changes are published by SetFrameMode itself
+    SetFrameMode(window, static_cast<int>(FrameMode::CustomFrame));
+    errors += ReadBlock(block, &info) && info.frameMode == static_cast<int32_t>(FrameMode::CustomFrame) ? 0 : 1;
+
+    // A destroyed (finalized) window's block stays readable and reads as
+    // gone
+    gtk_widget_destroy(widget);
+    errors += ReadBlock(block, &info) ? 1 : 0;
+
+    if (errors != 0) {
+        std::printf("Window state block mismatches: %llu\n", static_cast<unsigned long long>(errors));
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,28 @@
+// Window Decoration Linux Plugin - runner API
+// Entry points an app's runner calls from C++ before Dart runs. Link the
+// runner against the plugin target:
+//
+//   target_link_libraries(${BINARY_NAME} PRIVATE window_decoration_linux_plugin)
+//
+// and decorate the window right after creating it, before the window or
+// the Flutter view is realized:
+//
+//   window_decoration::InitialDecoration decoration = {};
+//   decoration.frameMode = static_cast<int32_t>(window_decoration::FrameMode::CustomFrame);
+//   decoration.captionHeight = 32;
+//   decoration.flags = window_decoration::INITIAL_DECORATION_HAS_BOUNDS |
+//                      window_decoration::INITIAL_DECORATION_CENTERED;
+//   decoration.bounds = { 0, 0, 1280, 720 };
+//   ApplyInitialDecoration(window, &decoration);
+
+#ifndef WINDOW_DECORATION_LINUX_PLUGIN_H_
+#define WINDOW_DECORATION_LINUX_PLUGIN_H_
+
+#include "window_decoration_core/initial_decoration.h"
+
+// Apply an initial decoration (see initial_decoration.h) to a GtkWindow
+// that isn't shown yet; bounds are in logical pixels. Returns false for a
+// null window or an invalid decoration.
+extern "C" bool ApplyInitialDecoration(void* window, const window_decoration::InitialDecoration* decoration);
+
+#endif  // WINDOW_DECORATION_LINUX_PLUGIN_H_
@@ -0,0 +1,233 @@
+// Window Decoration Linux - Caption drag test
+// Drags a custom frame window by its native caption with real input
+// injected through XTest, so presses carry server timestamps exactly like a
+// user's clicks. Registered with CTest and run under Xvfb.
+//
+// Without a window manager GDK emulates the move with its own pointer
+// grab. With one, the press is handed to it (_NET_WM_MOVERESIZE) and the
+// double-click maximize check runs too:
+//
+//   xvfb-run -a sh -c 'openbox & sleep 1; ./caption_drag_test'
+//
+// Every drag must move the window by exactly the pointer delta and no
+// caption press may reach the window. Caption clicks and moves within the
+// drag threshold must leave it in place. Presses on caption buttons and
+// client regions must reach the window and leave it in place.
+//
+// CTest runs it once at scale 1 and once with GDK_SCALE=2. Either way the
+// window scale is then switched (1 to 2, 2 to 1) with the button zones and
+// regions already set, and the checks are repeated: the zones and regions
+// are given in logical pixels and have to follow the new scale.
+
+#include <gdk/gdkx.h>
+#include <gtk/gtk.h>
+#include <X11/extensions/XTest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "test_util.h"
+#include "window_decoration_core/hit_test.h"
+
+using namespace window_decoration;
+
+extern "C" bool SetFrameMode(void* handle, int mode);
+extern "C" void SetCaptionHeight(void* handle, int height);
+extern "C" void SetCaptionButtonZones(void* handle,
+    int minLeft, int minTop, int minRight, int minBottom,
+    int maxLeft, int maxTop, int maxRight, int maxBottom,
+    int closeLeft, int closeTop, int closeRight, int closeBottom);
+extern "C" bool SetCaptionRegion(void* handle, const char* name, int hit,
+    int left, int top, int right, int bottom, int cornerRadius);
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct Point {
+    int x;
+    int y;
+};
+
+// Let the X server and GTK catch up: sync, then run events until none
+// arrive for a few milliseconds
+void Settle(Display* display) {
+    Clock::time_point quietSince = Clock::now();
+    while (Clock::now() - quietSince < std::chrono::milliseconds(20)) {
+        XSync(display, False);
+        if (gtk_events_pending()) {
+            while (gtk_events_pending()) {
+                gtk_main_iteration_do(FALSE);
+            }
+            quietSince = Clock::now();
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+// Window origin in logical pixels
+Point GetOrigin(GdkWindow* window) {
+    Point origin = { 0, 0 };
+    gdk_window_get_origin(window, &origin.x, &origin.y);
+    return origin;
+}
+
+// Move the pointer to `offset` (logical pixels) from the window origin.
+// XTest takes root coordinates in device pixels.
+void MovePointer(Display* display, GdkWindow* window, Point origin, Point offset) {
+    int scale = gdk_window_get_scale_factor(window);
+    XTestFakeMotionEvent(display, -1, (origin.x + offset.x) * scale, (origin.y + offset.y) * scale, CurrentTime);
+}
+
+// Press at `offset` from the window origin, move by (delta, delta) in two
+// steps and release (logical pixels). Returns how far the window moved.
+Point Drag(Display* display, GdkWindow* window, Point offset, int delta) {
+    Point origin = GetOrigin(window);
+    MovePointer(display, window, origin, offset);
+    Settle(display);
+
+    XTestFakeButtonEvent(display, 1, True, CurrentTime);
+    MovePointer(display, window, origin, { offset.x + delta / 2, offset.y + delta / 2 });
+    Settle(display);
+    MovePointer(display, window, origin, { offset.x + delta, offset.y + delta });
+    Settle(display);
+    XTestFakeButtonEvent(display, 1, False, CurrentTime);
+    Settle(display);
+
+    Point after = GetOrigin(window);
+    return { after.x - origin.x, after.y - origin.y };
+}
+
+// Click at `offset` from the window origin without moving; returns whether
+// the window stayed in place
+bool ClickInPlace(Display* display, GdkWindow* window, Point offset) {
+    Point origin = GetOrigin(window);
+    MovePointer(display, window, origin, offset);
+    XTestFakeButtonEvent(display, 1, True, CurrentTime);
+    XTestFakeButtonEvent(display, 1, False, CurrentTime);
+    Settle(display);
+
+    Point after = GetOrigin(window);
+    return after.x == origin.x && after.y == origin.y;
+}
+
+// Caption drags move the window by the pointer delta, back and forth
+void CheckCaptionDrags(Display* display, GdkWindow* window, Point caption) {
+    for (int i = 0; i < 6; i++) {
+        int delta = i & 1 ? -40 : 40;
+        Point moved = Drag(display, window, caption, delta);
+        WD_EXPECT_EQ(moved.x, delta);
+        WD_EXPECT_EQ(moved.y, delta);
+    }
+}
+
+gboolean CountPress(GtkWidget*, GdkEvent*, gpointer data) {
+    (*static_cast<int*>(data))++;
+    return FALSE;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (!gtk_init_check(&argc, &argv) || !GDK_IS_X11_DISPLAY(gdk_display_get_default())) {
+        std::fprintf(stderr, "No X display; run under xvfb-run\n");
+        return 1;
+    }
+
+    Display* display = gdk_x11_display_get_xdisplay(gdk_display_get_default());
+    int eventBase, errorBase, major, minor;
+    if (!XTestQueryExtension(display, &eventBase, &errorBase, &major, &minor)) {
+        std::fprintf(stderr, "The X server has no XTest extension\n");
+        return 1;
+    }
+
+    // 400x300 custom frame window (it still fits Xvfb's screen at scale
+    // 2): 40 px caption, caption button zones at the right end and a "tab"
+    // client region
+    GtkWindow* window = GTK_WINDOW(gtk_window_new(GTK_WINDOW_TOPLEVEL));
+    GtkWidget* widget = GTK_WIDGET(window);
+    gtk_widget_add_events(widget, GDK_BUTTON_PRESS_MASK);
+    gtk_window_set_decorated(window, FALSE);
+    gtk_window_set_default_size(window, 400, 300);
+    gtk_window_move(window, 100, 100);
+    gtk_widget_show(widget);
+    Settle(display);
+
+    WD_EXPECT(SetFrameMode(window, static_cast<int>(FrameMode::CustomFrame)));
+    SetCaptionHeight(window, 40);
+    SetCaptionButtonZones(window, 280, 0, 320, 40, 320, 0, 360, 40, 360, 0, 400, 40);
+    WD_EXPECT(SetCaptionRegion(window, "tab", static_cast<int>(HitCode::Client), 60, 0, 140, 40, 0));
+
+    int presses = 0;
+    g_signal_connect(widget, "button-press-event", G_CALLBACK(CountPress), &presses);
+
+    GdkWindow* gdkWindow = gtk_widget_get_window(widget);
+    const Point caption = { 200, 20 };
+    CheckCaptionDrags(display, gdkWindow, caption);
+
+    // Clicks and moves within the drag threshold don't start a move
+    gint threshold = 8;
+    g_object_get(gtk_widget_get_settings(widget), "gtk-dnd-drag-threshold", &threshold, nullptr);
+    WD_EXPECT(ClickInPlace(display, gdkWindow, caption));
+    Point moved = Drag(display, gdkWindow, caption, threshold);
+    WD_EXPECT_EQ(moved.x, 0);
+    WD_EXPECT_EQ(moved.y, 0);
+
+    // Caption presses never reach the window
+    WD_EXPECT_EQ(presses, 0);
+
+    // Caption button zones and client regions keep their presses
+    WD_EXPECT(ClickInPlace(display, gdkWindow, { 380, 20 }));
+    WD_EXPECT(ClickInPlace(display, gdkWindow, { 100, 20 }));
+    WD_EXPECT_EQ(presses, 2);
+
+    // So do presses below the caption, which don't drag either
+    moved = Drag(display, gdkWindow, { 200, 200 }, 40);
+    WD_EXPECT_EQ(moved.x, 0);
+    WD_EXPECT_EQ(moved.y, 0);
+    WD_EXPECT_EQ(presses, 3);
+
+    // Switch the scale with the zones and region in place. They must cover
+    // the same logical rects as before, near both ends of each rect (clear
+    // of the resize border).
+    int scale = gdk_window_get_scale_factor(gdkWindow);
+    gdk_x11_display_set_window_scale(gdk_display_get_default(), scale == 1 ? 2 : 1);
+    Settle(display);
+    WD_EXPECT(gdk_window_get_scale_factor(gdkWindow) != scale);
+    WD_EXPECT(ClickInPlace(display, gdkWindow, { 362, 10 }));
+    WD_EXPECT(ClickInPlace(display, gdkWindow, { 390, 38 }));
+    WD_EXPECT(ClickInPlace(display, gdkWindow, { 62, 20 }));
+    WD_EXPECT(ClickInPlace(display, gdkWindow, { 138, 20 }));
+    WD_EXPECT_EQ(presses, 7);
+
+    // Just outside them, presses drag again and never reach the window
+    moved = Drag(display, gdkWindow, { 270, 20 }, 40);
+    WD_EXPECT_EQ(moved.x, 40);
+    WD_EXPECT_EQ(moved.y, 40);
+    moved = Drag(display, gdkWindow, { 150, 20 }, -40);
+    WD_EXPECT_EQ(moved.x, -40);
+    WD_EXPECT_EQ(moved.y, -40);
+    CheckCaptionDrags(display, gdkWindow, caption);
+    WD_EXPECT_EQ(presses, 7);
+
+    // Double-click maximize needs a window manager to honor the request
+    GdkAtom maximizeHint = gdk_atom_intern_static_string("_NET_WM_STATE_MAXIMIZED_VERT");
+    if (gdk_x11_screen_supports_net_wm_hint(gtk_widget_get_screen(widget), maximizeHint)) {
+        for (int expected = 1; expected >= 0; expected--) {
+            Point origin = GetOrigin(gdkWindow);
+            XTestFakeMotionEvent(display, -1, origin.x + caption.x, origin.y + caption.y, CurrentTime);
+            for (int click = 0; click < 2; click++) {
+                XTestFakeButtonEvent(display, 1, True, CurrentTime);
+                XTestFakeButtonEvent(display, 1, False, CurrentTime);
+            }
+            Settle(display);
+            WD_EXPECT_EQ(gtk_window_is_maximized(window) ? 1 : 0, expected);
+        }
+    } else {
+        std::printf("double-click maximize skipped (no window manager)\n");
+    }
+
+    gtk_widget_destroy(widget);
+    return test::TestExitCode();
+}
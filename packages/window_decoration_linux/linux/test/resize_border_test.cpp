@@ -0,0 +1,173 @@
+// Window Decoration Linux - Resize border test
+// Drives the native resize border handler of a real undecorated GtkWindow
+// with pointer events synthesized through gdk_event_put(). Registered with
+// CTest and run under Xvfb, once at scale 1 and once with GDK_SCALE=2 to
+// check the DPI scaling of the borders.
+//
+// The cursor shown at probe points all around the frame must follow the
+// hidden frame rules of window_decoration_core (HitTestHiddenFrame), a
+// primary press on a border must not reach the window while a press inside
+// must, and leaving hidden frame mode must restore the cursor.
+
+#include <gtk/gtk.h>
+
+#include <cstdint>
+
+#include "test_util.h"
+#include "window_decoration_core/cursor_cache.h"
+#include "window_decoration_core/hit_test.h"
+#include "window_decoration_core/hover_memo.h"
+
+using namespace window_decoration;
+
+extern "C" bool SetFrameMode(void* handle, int mode);
+extern "C" bool GetHoverStats(void* handle, HoverStats* stats);
+
+namespace {
+
+// Run everything GTK has queued
+void Flush() {
+    while (gtk_events_pending()) {
+        gtk_main_iteration_do(FALSE);
+    }
+}
+
+// Queue a pointer event at (x, y), logical window coordinates
+void PutPointerEvent(GdkWindow* window, GdkEventType type, double x, double y) {
+    GdkEvent* event = gdk_event_new(type);
+    GdkDevice* pointer = gdk_seat_get_pointer(gdk_display_get_default_seat(gdk_window_get_display(window)));
+    gdk_event_set_device(event, pointer);
+
+    if (type == GDK_MOTION_NOTIFY) {
+        event->motion.window = static_cast<GdkWindow*>(g_object_ref(window));
+        event->motion.time = GDK_CURRENT_TIME;
+        event->motion.x = x;
+        event->motion.y = y;
+        event->motion.x_root = x;
+        event->motion.y_root = y;
+    } else {
+        event->button.window = static_cast<GdkWindow*>(g_object_ref(window));
+        event->button.time = GDK_CURRENT_TIME;
+        event->button.button = GDK_BUTTON_PRIMARY;
+        event->button.x = x;
+        event->button.y = y;
+        event->button.x_root = x;
+        event->button.y_root = y;
+    }
+
+    gdk_event_put(event);
+    gdk_event_free(event);
+}
+
+gboolean CountPress(GtkWidget*, GdkEvent*, gpointer data) {
+    (*static_cast<int*>(data))++;
+    return FALSE;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (!gtk_init_check(&argc, &argv)) {
+        std::fprintf(stderr, "No display; run under xvfb-run\n");
+        return 1;
+    }
+
+    GtkWindow* window = GTK_WINDOW(gtk_window_new(GTK_WINDOW_TOPLEVEL));
+    GtkWidget* widget = GTK_WIDGET(window);
+    gtk_window_set_decorated(window, FALSE);
+    gtk_window_set_default_size(window, 800, 600);
+    gtk_widget_show(widget);
+    gdk_display_sync(gtk_widget_get_display(widget));
+    Flush();
+
+    GdkWindow* gdkWindow = gtk_widget_get_window(widget);
+    int scale = gdk_window_get_scale_factor(gdkWindow);
+    int windowWidth = gdk_window_get_width(gdkWindow);
+    int windowHeight = gdk_window_get_height(gdkWindow);
+
+    int presses = 0;
+    g_signal_connect(widget, "button-press-event", G_CALLBACK(CountPress), &presses);
+
+    // Window manager borders: the plugin leaves the cursor alone
+    PutPointerEvent(gdkWindow, GDK_MOTION_NOTIFY, 1.5, windowHeight / 2.0);
+    Flush();
+    WD_EXPECT(gdk_window_get_cursor(gdkWindow) == nullptr);
+
+    WD_EXPECT(SetFrameMode(window, static_cast<int>(FrameMode::Hidden)));
+
+    // Probe points on every edge, corner and corner extension, in device
+    // pixels, checked against the core rules at the window's scale
+    FrameGeometry geometry = {};
+    geometry.windowWidth = windowWidth * scale;
+    geometry.windowHeight = windowHeight * scale;
+    geometry.dpi = 96 * static_cast<unsigned int>(scale);
+    geometry.borderWidth = ScaleForDpi(RESIZE_BORDER_WIDTH, geometry.dpi);
+    geometry.borderHeight = geometry.borderWidth;
+
+    int borderLogical = geometry.borderWidth / scale;
+    int xs[] = { 0, borderLogical - 1, borderLogical, 2 * borderLogical - 1, 2 * borderLogical,
+                 windowWidth / 2, windowWidth - 2 * borderLogical, windowWidth - borderLogical, windowWidth - 1 };
+    int ys[] = { 0, borderLogical - 1, borderLogical, 2 * borderLogical - 1, 2 * borderLogical,
+                 windowHeight / 2, windowHeight - 2 * borderLogical, windowHeight - borderLogical, windowHeight - 1 };
+
+    // One cursor per shape: the first seen is remembered, later ones must
+    // be the same cached cursor
+    GdkCursor* shapeCursors[5] = {};
+    for (int y : ys) {
+        for (int x : xs) {
+            PutPointerEvent(gdkWindow, GDK_MOTION_NOTIFY, x + 0.5, y + 0.5);
+            Flush();
+
+            GdkCursor* cursor = gdk_window_get_cursor(gdkWindow);
+            HitCode expected = HitTestHiddenFrame(x * scale, y * scale, geometry);
+            CursorShape shape;
+            if (!CursorShapeForHit(expected, &shape)) {
+                WD_EXPECT(cursor == nullptr);
+                continue;
+            }
+
+            GdkCursor*& shapeCursor = shapeCursors[static_cast<int>(shape)];
+            if (shapeCursor == nullptr) {
+                shapeCursor = cursor;
+            }
+            WD_EXPECT(cursor != nullptr);
+            WD_EXPECT(cursor == shapeCursor);
+        }
+    }
+
+    // Different shapes must not share a cursor
+    for (int i = 1; i < 5; i++) {
+        WD_EXPECT(shapeCursors[i] != nullptr);
+        for (int j = i + 1; j < 5; j++) {
+            WD_EXPECT(shapeCursors[i] != shapeCursors[j]);
+        }
+    }
+
+    // Moves within one resize cell are answered by the hover memo
+    HoverStats before = {};
+    WD_EXPECT(GetHoverStats(window, &before));
+    for (int i = 0; i < 100; i++) {
+        PutPointerEvent(gdkWindow, GDK_MOTION_NOTIFY, 1.5, 40.0 + i);
+        Flush();
+    }
+    HoverStats after = {};
+    WD_EXPECT(GetHoverStats(window, &after));
+    WD_EXPECT(after.memoHits > before.memoHits);
+    WD_EXPECT(after.evaluations - before.evaluations < 100u);
+
+    // A press on a border starts the resize instead of reaching the window;
+    // one inside is delivered
+    PutPointerEvent(gdkWindow, GDK_BUTTON_PRESS, windowWidth - 1.5, windowHeight / 2.0);
+    Flush();
+    WD_EXPECT_EQ(presses, 0);
+    PutPointerEvent(gdkWindow, GDK_BUTTON_PRESS, windowWidth / 2.0, windowHeight / 2.0);
+    Flush();
+    WD_EXPECT_EQ(presses, 1);
+
+    // Back to window manager borders: the cursor must be restored
+    WD_EXPECT(SetFrameMode(window, static_cast<int>(FrameMode::Normal)));
+    WD_EXPECT(gdk_window_get_cursor(gdkWindow) == nullptr);
+
+    gtk_widget_destroy(widget);
+    return test::TestExitCode();
+}
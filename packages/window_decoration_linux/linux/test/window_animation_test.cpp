@@ -0,0 +1,175 @@
+// Window Decoration Linux - Window animation test
+// Animates a real GtkWindow with AnimateWindow, stepped by the window's
+// GdkFrameClock the way an app would. Completion notifications go to a
+// stand-in for NativeApi.postCObject that records them. Registered with
+// CTest and run under Xvfb; stepping against a simulated clock is covered
+// by the core window_animation_test.
+//
+// Every animation must end on its target geometry and opacity and post 1;
+// replaced, cancelled and destroyed ones must post 0 exactly once; a
+// hidden window must jump to its target.
+
+#include <gtk/gtk.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "test_util.h"
+#include "window_decoration_core/dart_port.h"
+#include "window_decoration_core/window_animation.h"
+
+using namespace window_decoration;
+
+extern "C" bool AnimateWindow(void* handle, const WindowAnimationParams* params, void* postCObject, int64_t port);
+extern "C" bool CancelWindowAnimation(void* handle);
+extern "C" bool GetWindowAnimationStats(void* handle, WindowAnimationStats* stats);
+
+namespace {
+
+const int64_t kMs = 1000000;
+
+struct Posted {
+    int64_t port;
+    int64_t value;
+};
+
+std::vector<Posted> g_posted;
+
+// Stands in for Dart_PostCObject
+bool RecordPost(int64_t port, DartCObject* message) {
+    if (message->type != DART_COBJECT_INT64) {
+        return false;
+    }
+    g_posted.push_back({ port, message->value.asInt64 });
+    return true;
+}
+
+// Values posted to a port, in order
+std::vector<int64_t> PostedTo(int64_t port) {
+    std::vector<int64_t> values;
+    for (const Posted& posted : g_posted) {
+        if (posted.port == port) {
+            values.push_back(posted.value);
+        }
+    }
+    return values;
+}
+
+// Wait for the X server, then run whatever it sent back
+void Flush(GtkWidget* widget) {
+    gdk_display_sync(gtk_widget_get_display(widget));
+    while (gtk_events_pending()) {
+        gtk_main_iteration_do(FALSE);
+    }
+}
+
+// Run the main loop until port got its notification or timeoutMs passed
+bool WaitForPost(int64_t port, int64_t timeoutMs) {
+    gint64 deadline = g_get_monotonic_time() + timeoutMs * 1000;
+    while (PostedTo(port).empty() && g_get_monotonic_time() < deadline) {
+        gtk_main_iteration_do(FALSE);
+        g_usleep(1000);
+    }
+    return !PostedTo(port).empty();
+}
+
+WindowAnimationParams MakeParams(const Rect& bounds, double opacity, int64_t durationNs, AnimationCurve curve,
+                                 uint32_t properties) {
+    WindowAnimationParams params;
+    params.bounds = bounds;
+    params.opacity = opacity;
+    params.durationNs = durationNs;
+    params.curve = static_cast<int32_t>(curve);
+    params.properties = properties;
+    return params;
+}
+
+bool HasBounds(GtkWindow* window, const Rect& bounds) {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    gtk_window_get_position(window, &x, &y);
+    gtk_window_get_size(window, &width, &height);
+    return x == bounds.left && y == bounds.top && width == bounds.right - bounds.left &&
+           height == bounds.bottom - bounds.top;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (!gtk_init_check(&argc, &argv)) {
+        std::fprintf(stderr, "No display; run under xvfb-run\n");
+        return 1;
+    }
+
+    GtkWindow* window = GTK_WINDOW(gtk_window_new(GTK_WINDOW_TOPLEVEL));
+    GtkWidget* widget = GTK_WIDGET(window);
+    gtk_window_set_decorated(window, FALSE);
+    gtk_window_set_default_size(window, 640, 480);
+    gtk_window_move(window, 100, 100);
+    gtk_widget_show(widget);
+    Flush(widget);
+
+    void* post = reinterpret_cast<void*>(&RecordPost);
+    WindowAnimationStats stats = {};
+
+    // Slide and grow
+    const Rect grown = { 300, 200, 1100, 800 };
+    WindowAnimationParams slide = MakeParams(grown, 1.0, 250 * kMs, AnimationCurve::EaseInOut, ANIMATE_BOUNDS);
+    WD_EXPECT(AnimateWindow(window, &slide, post, 1));
+    WD_EXPECT(WaitForPost(1, 2000));
+    Flush(widget);
+    WD_EXPECT(PostedTo(1) == std::vector<int64_t>{ 1 });
+    WD_EXPECT(HasBounds(window, grown));
+    WD_EXPECT(GetWindowAnimationStats(window, &stats));
+    WD_EXPECT_EQ(stats.completed, 1u);
+    WD_EXPECT(stats.frames > 1);
+
+    // Fade out halfway
+    WindowAnimationParams fade = MakeParams({}, 0.5, 150 * kMs, AnimationCurve::Linear, ANIMATE_OPACITY);
+    WD_EXPECT(AnimateWindow(window, &fade, post, 2));
+    WD_EXPECT(WaitForPost(2, 2000));
+    Flush(widget);
+    WD_EXPECT(PostedTo(2) == std::vector<int64_t>{ 1 });
+    WD_EXPECT(std::fabs(gtk_widget_get_opacity(widget) - 0.5) < 0.01);
+    WD_EXPECT(HasBounds(window, grown));
+
+    // Replaced, then cancelled: each posts 0 once and the window stays put
+    const Rect back = { 100, 100, 740, 580 };
+    WindowAnimationParams slow = MakeParams(back, 1.0, 2000 * kMs, AnimationCurve::Linear, ANIMATE_BOUNDS);
+    WD_EXPECT(AnimateWindow(window, &slow, post, 3));
+    WD_EXPECT(AnimateWindow(window, &slow, post, 4));
+    WD_EXPECT(PostedTo(3) == std::vector<int64_t>{ 0 });
+    WaitForPost(4, 100);
+    WD_EXPECT(CancelWindowAnimation(window));
+    WD_EXPECT(!CancelWindowAnimation(window));
+    WD_EXPECT(PostedTo(4) == std::vector<int64_t>{ 0 });
+    Flush(widget);
+    WD_EXPECT(!HasBounds(window, grown) && !HasBounds(window, back));
+    GetWindowAnimationStats(window, &stats);
+    WD_EXPECT_EQ(stats.cancelled, 2u);
+
+    // Invalid params leave nothing running
+    WindowAnimationParams invalid = MakeParams(back, 1.0, 100 * kMs, AnimationCurve::Linear, 0);
+    WD_EXPECT(!AnimateWindow(window, &invalid, post, 5));
+    WD_EXPECT(!AnimateWindow(nullptr, &slide, post, 5));
+    WD_EXPECT(PostedTo(5).empty());
+
+    // A hidden window jumps to the target right away
+    gtk_widget_hide(widget);
+    Flush(widget);
+    WD_EXPECT(AnimateWindow(window, &slide, post, 6));
+    WD_EXPECT(PostedTo(6) == std::vector<int64_t>{ 1 });
+    gtk_widget_show(widget);
+    Flush(widget);
+    WD_EXPECT(HasBounds(window, grown));
+
+    // Destroying the window ends a running animation
+    WD_EXPECT(AnimateWindow(window, &slow, post, 7));
+    gtk_widget_destroy(widget);
+    WD_EXPECT(PostedTo(7) == std::vector<int64_t>{ 0 });
+
+    return test::TestExitCode();
+}
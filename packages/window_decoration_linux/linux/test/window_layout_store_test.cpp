@@ -0,0 +1,203 @@
+// Window Decoration Linux - Window layout store test
+// Saves a real GtkWindow's layout with the exported layout store calls,
+// reopens the file the way a new process would and restores a fresh
+// window from it before it is shown. Registered with CTest and run under
+// Xvfb.
+//
+// Checks:
+//   - a moved and resized window is saved once the debounce delay passed,
+//     not on every configure event, and FlushWindowLayouts() saves at once
+//   - a window restored on the same monitor opens exactly where it was
+//   - monitor mismatch: a layout saved on a monitor that is gone opens
+//     centered on the primary monitor's work area if it would be off
+//     screen, and is pulled into the work area if it is partly on it
+//   - a corrupt file is reported and restores nothing
+
+#include <gtk/gtk.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "test_util.h"
+#include "window_decoration_core/window_layout_store.h"
+
+using namespace window_decoration;
+
+extern "C" bool OpenWindowLayoutStore(const char* path);
+extern "C" int RestoreWindowLayout(void* handle, const char* id, WindowLayout* layout);
+extern "C" bool FlushWindowLayouts();
+
+namespace {
+
+// Wait for the X server, then run whatever it sent back
+void Flush(GtkWidget* widget) {
+    gdk_display_sync(gtk_widget_get_display(widget));
+    while (gtk_events_pending()) {
+        gtk_main_iteration_do(FALSE);
+    }
+}
+
+// Run the main loop for ms milliseconds
+void RunFor(int64_t ms) {
+    gint64 deadline = g_get_monotonic_time() + ms * 1000;
+    while (g_get_monotonic_time() < deadline) {
+        gtk_main_iteration_do(FALSE);
+        g_usleep(1000);
+    }
+}
+
+GtkWindow* NewWindow() {
+    GtkWindow* window = GTK_WINDOW(gtk_window_new(GTK_WINDOW_TOPLEVEL));
+    gtk_window_set_decorated(window, FALSE);
+    gtk_window_set_default_size(window, 400, 300);
+    return window;
+}
+
+Rect WindowRect(GtkWindow* window) {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    gtk_window_get_position(window, &x, &y);
+    gtk_window_get_size(window, &width, &height);
+    return { x, y, x + width, y + height };
+}
+
+bool SameRect(const Rect& a, const Rect& b) {
+    return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+}
+
+bool Inside(const Rect& rect, const Rect& area) {
+    return rect.left >= area.left && rect.top >= area.top && rect.right <= area.right && rect.bottom <= area.bottom;
+}
+
+// The layout saved under id in the file at path, as another process
+// would read it
+bool ReadSavedLayout(const std::string& path, const char* id, WindowLayout* layout) {
+    gchar* contents = nullptr;
+    gsize length = 0;
+    if (!g_file_get_contents(path.c_str(), &contents, &length, nullptr)) {
+        return false;
+    }
+    WindowLayoutStore store;
+    bool found = store.Load(contents, length) && store.Find(id, layout);
+    g_free(contents);
+    return found;
+}
+
+// Write a file holding one layout saved on a monitor that doesn't exist
+bool WriteForeignLayout(const std::string& path, const char* id, const Rect& bounds) {
+    WindowLayout layout = {};
+    layout.bounds = bounds;
+    layout.monitor = 0x5EED;
+    WindowLayoutStore store;
+    store.Put(id, layout);
+    std::vector<uint8_t> image(store.EncodedSize());
+    store.Encode(image.data(), image.size());
+    return g_file_set_contents(path.c_str(), reinterpret_cast<const gchar*>(image.data()),
+                               static_cast<gssize>(image.size()), nullptr);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (!gtk_init_check(&argc, &argv)) {
+        std::fprintf(stderr, "No display; run under xvfb-run\n");
+        return 1;
+    }
+
+    GdkDisplay* display = gdk_display_get_default();
+    GdkMonitor* monitor = gdk_display_get_primary_monitor(display);
+    if (monitor == nullptr) {
+        monitor = gdk_display_get_monitor(display, 0);
+    }
+    GdkRectangle area;
+    gdk_monitor_get_workarea(monitor, &area);
+    const Rect workArea = { area.x, area.y, area.x + area.width, area.y + area.height };
+
+    gchar* pathName = g_strdup_printf("%s/window_layouts_test_%d.bin", g_get_tmp_dir(), static_cast<int>(getpid()));
+    const std::string path = pathName;
+    g_free(pathName);
+    unlink(path.c_str());
+
+    WindowLayout saved = {};
+
+    // No file yet: nothing to restore, but the window is tracked
+    WD_EXPECT(OpenWindowLayoutStore(path.c_str()));
+    GtkWindow* first = NewWindow();
+    WD_EXPECT_EQ(RestoreWindowLayout(first, "main", nullptr), 0);
+    gtk_widget_show(GTK_WIDGET(first));
+    Flush(GTK_WIDGET(first));
+
+    // Move and resize: saved after the delay, not right away
+    const Rect moved = { workArea.left + 40, workArea.top + 30, workArea.left + 40 + 320, workArea.top + 30 + 240 };
+    gtk_window_move(first, moved.left, moved.top);
+    gtk_window_resize(first, moved.right - moved.left, moved.bottom - moved.top);
+    Flush(GTK_WIDGET(first));
+    WD_EXPECT(!ReadSavedLayout(path, "main", &saved));
+    RunFor(800);
+    WD_EXPECT(ReadSavedLayout(path, "main", &saved) && SameRect(saved.bounds, moved));
+
+    // Flushed at once
+    const Rect nudged = { moved.left + 10, moved.top, moved.right + 10, moved.bottom };
+    gtk_window_move(first, nudged.left, nudged.top);
+    Flush(GTK_WIDGET(first));
+    WD_EXPECT(FlushWindowLayouts());
+    WD_EXPECT(ReadSavedLayout(path, "main", &saved) && SameRect(saved.bounds, nudged));
+    gtk_widget_destroy(GTK_WIDGET(first));
+
+    // Next run, same monitor: opens where it was left
+    WD_EXPECT(OpenWindowLayoutStore(path.c_str()));
+    GtkWindow* second = NewWindow();
+    WindowLayout restored = {};
+    WD_EXPECT_EQ(RestoreWindowLayout(second, "main", &restored), 1);
+    WD_EXPECT(SameRect(restored.bounds, nudged));
+    gtk_widget_show(GTK_WIDGET(second));
+    Flush(GTK_WIDGET(second));
+    WD_EXPECT(SameRect(WindowRect(second), nudged));
+    gtk_widget_destroy(GTK_WIDGET(second));
+
+    // Saved on a monitor that is gone, far off screen: centered on the
+    // primary monitor
+    const int width = 300;
+    const int height = 200;
+    WD_EXPECT(WriteForeignLayout(path, "main", { 20000, 20000, 20000 + width, 20000 + height }));
+    WD_EXPECT(OpenWindowLayoutStore(path.c_str()));
+    GtkWindow* offScreen = NewWindow();
+    WD_EXPECT_EQ(RestoreWindowLayout(offScreen, "main", &restored), 2);
+    gtk_widget_show(GTK_WIDGET(offScreen));
+    Flush(GTK_WIDGET(offScreen));
+    Rect placed = WindowRect(offScreen);
+    WD_EXPECT(Inside(placed, workArea));
+    WD_EXPECT_EQ(placed.right - placed.left, width);
+    WD_EXPECT_EQ(placed.left, workArea.left + (workArea.right - workArea.left - width) / 2);
+    gtk_widget_destroy(GTK_WIDGET(offScreen));
+
+    // Saved on a monitor that is gone, hanging off the right edge: pulled
+    // into the work area
+    const Rect overhang = { workArea.right - 100, workArea.top + 50, workArea.right - 100 + width,
+                            workArea.top + 50 + height };
+    WD_EXPECT(WriteForeignLayout(path, "main", overhang));
+    WD_EXPECT(OpenWindowLayoutStore(path.c_str()));
+    GtkWindow* partial = NewWindow();
+    WD_EXPECT_EQ(RestoreWindowLayout(partial, "main", &restored), 2);
+    gtk_widget_show(GTK_WIDGET(partial));
+    Flush(GTK_WIDGET(partial));
+    placed = WindowRect(partial);
+    WD_EXPECT(Inside(placed, workArea));
+    WD_EXPECT_EQ(placed.right, workArea.right);
+    WD_EXPECT_EQ(placed.top, overhang.top);
+    gtk_widget_destroy(GTK_WIDGET(partial));
+
+    // Corrupt file: reported, nothing restored
+    WD_EXPECT(g_file_set_contents(path.c_str(), "not a layout file", -1, nullptr));
+    WD_EXPECT(!OpenWindowLayoutStore(path.c_str()));
+    GtkWindow* unknown = NewWindow();
+    WD_EXPECT_EQ(RestoreWindowLayout(unknown, "main", nullptr), 0);
+    gtk_widget_destroy(GTK_WIDGET(unknown));
+
+    unlink(path.c_str());
+    return test::TestExitCode();
+}
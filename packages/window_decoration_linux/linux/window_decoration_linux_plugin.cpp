@@ -0,0 +1,2257 @@
+// Window Decoration Linux Plugin
+// Native C++ companion to the GTK3 FFI bindings, for operations that would
+// otherwise take many FFI crossings from Dart
+// Applies a whole WindowDecorationConfig in one call and one frame, answers
+// window state queries without allocations, and handles the frame of
+// undecorated windows natively (resize borders, caption drag and
+// double-click) from a GDK event handler, without a round trip to Dart
+// Also streams coalesced window events to a Dart native port, paces
+// resize drags and steps bounds and opacity animations from the window's
+// frame clock, and restores windows from a memory-mapped layout file
+// before they are shown
+// Runners can decorate their window before it is first shown
+// (ApplyInitialDecoration), so the first frame already has the app's frame
+// Probes the display server, compositor and window manager hints once and
+// hands Dart the GTK calls it makes in one table (GetPlatformCapabilities)
+
+#include <gtk/gtk.h>
+#ifdef GDK_WINDOWING_X11
+#include <gdk/gdkx.h>
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "window_decoration_core/caption_regions.h"
+#include "window_decoration_core/caption_snapshot.h"
+#include "window_decoration_core/cursor_cache.h"
+#include "window_decoration_core/dart_port.h"
+#include "window_decoration_core/decoration_config.h"
+#include "window_decoration_core/frame_geometry_cache.h"
+#include "window_decoration_core/hit_test.h"
+#include "window_decoration_core/hit_test_policy.h"
+#include "window_decoration_core/hover_memo.h"
+#include "window_decoration_core/initial_decoration.h"
+#include "window_decoration_core/message_filter.h"
+#include "window_decoration_core/monitor_topology.h"
+#include "window_decoration_core/platform_capabilities.h"
+#include "window_decoration_core/resize_pacer.h"
+#include "window_decoration_core/window_animation.h"
+#include "window_decoration_core/window_event_stream.h"
+#include "window_decoration_core/window_layout_store.h"
+#include "window_decoration_core/window_placement.h"
+#include "window_decoration_core/window_registry.h"
+#include "window_decoration_core/window_state_block.h"
+#include "window_decoration_core/window_state_info.h"
+
+using window_decoration::CAPABILITY_COMPOSITOR;
+using window_decoration::CAPABILITY_MONITOR_DPI;
+using window_decoration::CAPABILITY_WAYLAND;
+using window_decoration::CAPABILITY_WINDOW_DPI;
+using window_decoration::CAPABILITY_X11;
+using window_decoration::CapabilityProbe;
+using window_decoration::CaptionPublisher;
+using window_decoration::CaptionRegion;
+using window_decoration::CaptionSnapshot;
+using window_decoration::CursorCache;
+using window_decoration::CursorShape;
+using window_decoration::DECORATION_CONFIG_ALWAYS_ON_TOP;
+using window_decoration::DECORATION_CONFIG_CENTERED;
+using window_decoration::DECORATION_CONFIG_HAS_BACKGROUND;
+using window_decoration::DECORATION_CONFIG_HAS_OPACITY;
+using window_decoration::DECORATION_CONFIG_SKIP_TASKBAR;
+using window_decoration::DECORATION_CONFIG_VISIBLE;
+using window_decoration::ANIMATE_BOUNDS;
+using window_decoration::ANIMATE_OPACITY;
+using window_decoration::DartPostCObjectFn;
+using window_decoration::DEFAULT_CAPTION_HEIGHT;
+using window_decoration::DecodeDecorationConfig;
+using window_decoration::DecorationConfig;
+using window_decoration::FrameCacheEvent;
+using window_decoration::FrameGeometry;
+using window_decoration::FrameGeometryCache;
+using window_decoration::FrameMetrics;
+using window_decoration::FrameMode;
+using window_decoration::FramePlacement;
+using window_decoration::HitCode;
+using window_decoration::HitTestFn;
+using window_decoration::HoverMemo;
+using window_decoration::HoverStats;
+using window_decoration::INITIAL_DECORATION_ALWAYS_ON_TOP;
+using window_decoration::INITIAL_DECORATION_CENTERED;
+using window_decoration::INITIAL_DECORATION_HAS_BACKGROUND;
+using window_decoration::INITIAL_DECORATION_HAS_BOUNDS;
+using window_decoration::InitialDecoration;
+using window_decoration::IsValidInitialDecoration;
+using window_decoration::LayoutRestore;
+using window_decoration::MAX_WINDOW_LAYOUT_ID_BYTES;
+using window_decoration::MessageAction;
+using window_decoration::MessageFilter;
+using window_decoration::MONITOR_PRIMARY;
+using window_decoration::MonitorFingerprint;
+using window_decoration::MonitorInfo;
+using window_decoration::MonitorTopology;
+using window_decoration::NET_WM_ATOM_COUNT;
+using window_decoration::NET_WM_ATOM_NAMES;
+using window_decoration::ParseOsVersion;
+using window_decoration::PlacementMode;
+using window_decoration::PlatformCapabilities;
+using window_decoration::RESIZE_BORDER_WIDTH;
+using window_decoration::Rect;
+using window_decoration::ResizePacer;
+using window_decoration::ResizePacingStats;
+using window_decoration::ResizeCellFn;
+using window_decoration::ResolveWindowLayout;
+using window_decoration::TitleBarStyle;
+using window_decoration::WINDOW_LAYOUT_FULLSCREEN;
+using window_decoration::WINDOW_LAYOUT_MAXIMIZED;
+using window_decoration::WINDOW_STATE_FOCUSED;
+using window_decoration::WINDOW_STATE_FULLSCREEN;
+using window_decoration::WINDOW_STATE_MAXIMIZED;
+using window_decoration::WINDOW_STATE_MINIMIZED;
+using window_decoration::WINDOW_STATE_VALID;
+using window_decoration::WINDOW_STATE_VISIBLE;
+using window_decoration::WindowAnimation;
+using window_decoration::WindowAnimationFrame;
+using window_decoration::WindowAnimationParams;
+using window_decoration::WindowAnimationStats;
+using window_decoration::WindowEvent;
+using window_decoration::WindowEventStream;
+using window_decoration::WindowEventType;
+using window_decoration::WindowLayout;
+using window_decoration::WindowLayoutStore;
+using window_decoration::WindowRegistry;
+using window_decoration::WindowStateBlock;
+using window_decoration::WindowStateBlockPool;
+using window_decoration::WindowStateInfo;
+using window_decoration::WindowStatePublisher;
+
+#define WINDOW_DECORATION_EXPORT extern "C" __attribute__((visibility("default")))
+
+// GObject data key of the window's background CSS provider
+static const char* BACKGROUND_PROVIDER_KEY = "window-decoration-background";
+
+// Paint the window background with an ARGB color through a CSS provider
+// owned by the window (reused by later calls)
+static void ApplyBackgroundColor(GtkWidget* widget, uint32_t argb) {
+    GtkCssProvider* provider = static_cast<GtkCssProvider*>(
+        g_object_get_data(G_OBJECT(widget), BACKGROUND_PROVIDER_KEY));
+    if (provider == nullptr) {
+        provider = gtk_css_provider_new();
+        gtk_style_context_add_provider(gtk_widget_get_style_context(widget),
+                                       GTK_STYLE_PROVIDER(provider),
+                                       GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
+        g_object_set_data_full(G_OBJECT(widget), BACKGROUND_PROVIDER_KEY, provider, g_object_unref);
+    }
+
+    // Alpha as fixed point: printf("%f") would follow the locale's decimal
+    // separator, which CSS doesn't accept
+    unsigned alpha = (argb >> 24) * 1000 / 255;
+    char css[96];
+    std::snprintf(css, sizeof(css), "window { background-color: rgba(%u, %u, %u, %u.%03u); }",
+                  (argb >> 16) & 0xFF, (argb >> 8) & 0xFF, argb & 0xFF, alpha / 1000, alpha % 1000);
+    gtk_css_provider_load_from_data(provider, css, -1, nullptr);
+}
+
+static Rect ToRect(const GdkRectangle& area) {
+    return { area.x, area.y, area.x + area.width, area.y + area.height };
+}
+
+// ============================================================================
+// Monitor Topology
+// ============================================================================
+
+// GObject data key marking monitors whose change signals are connected
+static const char* MONITOR_WATCHED_KEY = "window-decoration-monitor-watched";
+
+// Monitors of the display (logical pixels), refilled only after GDK
+// reports a monitor added or removed, or a monitor's geometry, work area or
+// scale changing. GDK3 doesn't signal every work-area-only change (panels
+// resizing on X11); those are picked up with the next monitor change.
+// Everything here runs on the GTK main thread.
+static MonitorTopology g_monitors;
+static GdkDisplay* g_monitors_display = nullptr;
+static bool g_monitors_stale = true;
+
+static void OnMonitorAddedOrRemoved(GdkDisplay*, GdkMonitor*, gpointer) {
+    g_monitors_stale = true;
+}
+
+static void OnMonitorChanged(GdkMonitor*, GParamSpec*, gpointer) {
+    g_monitors_stale = true;
+}
+
+static void OnMonitorsChanged(GdkScreen*, gpointer) {
+    g_monitors_stale = true;
+}
+
+static MonitorInfo QueryMonitorInfo(GdkMonitor* monitor) {
+    MonitorInfo info = {};
+    info.id = reinterpret_cast<uintptr_t>(monitor);
+    GdkRectangle area;
+    gdk_monitor_get_geometry(monitor, &area);
+    info.bounds = ToRect(area);
+    gdk_monitor_get_workarea(monitor, &area);
+    info.workArea = ToRect(area);
+    info.dpi = 96 * static_cast<uint32_t>(gdk_monitor_get_scale_factor(monitor));
+    info.flags = gdk_monitor_is_primary(monitor) ? MONITOR_PRIMARY : 0;
+    return info;
+}
+
+// The monitors of a widget's display, refilled first if they changed
+static const MonitorTopology& GetMonitorTopology(GtkWidget* widget) {
+    GdkDisplay* display = gtk_widget_get_display(widget);
+    if (display != g_monitors_display) {
+        g_monitors_display = display;
+        g_monitors_stale = true;
+        g_signal_connect(display, "monitor-added", G_CALLBACK(OnMonitorAddedOrRemoved), nullptr);
+        g_signal_connect(display, "monitor-removed", G_CALLBACK(OnMonitorAddedOrRemoved), nullptr);
+        g_signal_connect(gdk_display_get_default_screen(display), "monitors-changed",
+                         G_CALLBACK(OnMonitorsChanged), nullptr);
+    }
+    if (!g_monitors_stale) {
+        return g_monitors;
+    }
+
+    g_monitors_stale = false;
+    int count = gdk_display_get_n_monitors(display);
+    std::vector<MonitorInfo> monitors;
+    monitors.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; i++) {
+        GdkMonitor* monitor = gdk_display_get_monitor(display, i);
+        GObject* object = G_OBJECT(monitor);
+        if (g_object_get_data(object, MONITOR_WATCHED_KEY) == nullptr) {
+            g_object_set_data(object, MONITOR_WATCHED_KEY, &g_monitors);
+            g_signal_connect(monitor, "notify::geometry", G_CALLBACK(OnMonitorChanged), nullptr);
+            g_signal_connect(monitor, "notify::workarea", G_CALLBACK(OnMonitorChanged), nullptr);
+            g_signal_connect(monitor, "notify::scale-factor", G_CALLBACK(OnMonitorChanged), nullptr);
+        }
+        monitors.push_back(QueryMonitorInfo(monitor));
+    }
+    g_monitors.Update(monitors.data(), monitors.size());
+    return g_monitors;
+}
+
+// Monitor a window is on: the one holding most of it, or the primary while
+// it isn't realized yet. kNone without monitors.
+static int FindWindowMonitor(const MonitorTopology& monitors, GtkWidget* widget, const Rect& bounds) {
+    return gtk_widget_get_window(widget) != nullptr ? monitors.FindForRect(bounds) : monitors.primary();
+}
+
+// Window position (of the window manager's frame) and size
+static Rect GetGtkWindowRect(GtkWindow* window) {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    gtk_window_get_position(window, &x, &y);
+    gtk_window_get_size(window, &width, &height);
+    return { x, y, x + width, y + height };
+}
+
+// Move (and for ClampToWorkArea possibly shrink) a window with the
+// placement solver. Cascade needs an anchor window.
+static bool PlaceGtkWindow(GtkWindow* window, PlacementMode mode, GtkWindow* anchor) {
+    GtkWidget* widget = GTK_WIDGET(window);
+    Rect bounds = GetGtkWindowRect(window);
+    Rect anchorBounds = anchor != nullptr ? GetGtkWindowRect(anchor) : bounds;
+    const MonitorTopology& monitors = GetMonitorTopology(widget);
+
+    Rect placed;
+    if (mode == PlacementMode::Center && gtk_widget_get_window(widget) == nullptr) {
+        // Not on any monitor yet: center on the primary one
+        if (monitors.primary() == MonitorTopology::kNone) {
+            return false;
+        }
+        placed = window_decoration::CenterInWorkArea(monitors.monitor(monitors.primary()).workArea,
+                                                     bounds.right - bounds.left, bounds.bottom - bounds.top);
+    } else if (!window_decoration::SolvePlacement(monitors, mode, bounds, anchorBounds, false, &placed)) {
+        return false;
+    }
+
+    gtk_window_move(window, placed.left, placed.top);
+    if (placed.right - placed.left != bounds.right - bounds.left ||
+        placed.bottom - placed.top != bounds.bottom - bounds.top) {
+        gtk_window_resize(window, placed.right - placed.left, placed.bottom - placed.top);
+    }
+    return true;
+}
+
+// ============================================================================
+// Native Frame
+// ============================================================================
+
+// A primary press on the caption that has not started a move yet
+struct PendingMove {
+    bool active;
+    guint button;
+    gint rootX;
+    gint rootY;
+    guint32 time;
+};
+
+// Per-window state read on every pointer event
+struct WindowState {
+    FrameMode frameMode;
+
+    // Hit testers specialized for frameMode
+    HitTestFn hitTest;
+    ResizeCellFn resolveResizeCell;
+
+    // Caption height, caption button zones and named regions (in device
+    // pixels), published as immutable snapshots like on Windows
+    CaptionPublisher captions;
+
+    // Scale, size and maximized state in device pixels, refreshed only on
+    // configure, window state and scale changes
+    FrameGeometryCache geometry;
+
+    // Last resolved resize hit for pointer moves, and the cursor shown for it
+    HoverMemo hover;
+    GdkCursor* hoverCursor;
+
+    // Caption press waiting for the pointer to pass the drag threshold
+    // before the move starts (root position in logical pixels)
+    PendingMove pendingMove;
+};
+
+// A named caption region as the app set it, in logical pixels
+struct LogicalCaptionRegion {
+    std::string name;
+    CaptionRegion region;
+};
+
+// Per-window state only needed when the cursor moves to another GDK window,
+// the frame mode or scale changes, or the app edits the caption
+struct WindowColdState {
+    // GDK window showing the resize cursor (referenced) and the cursor it
+    // had before, put back when the pointer leaves the border
+    GdkWindow* cursorWindow;
+    GdkCursor* savedCursor;
+
+    gulong destroyHandler;
+    gulong scaleHandler;
+
+    // Caption button zones (minimize, maximize, close) and named regions in
+    // logical pixels, in stacking order. The published snapshot holds them
+    // in device pixels and is rebuilt from these when the scale changes.
+    Rect logicalButtons[3];
+    std::vector<LogicalCaptionRegion> logicalRegions;
+};
+
+// Windows with a native frame, keyed by GtkWindow. GTK runs on one
+// thread, so unlike the Windows backend there is a single table.
+typedef WindowRegistry<GtkWidget*, WindowState, WindowColdState> WindowTable;
+static WindowTable g_windows;
+
+// Resize cursors, per display and scale
+static CursorCache<GdkCursor*> g_cursors;
+
+// Pointer events the border logic looks at (GdkEventType ids)
+static MessageFilter MakeEventFilter() {
+    MessageFilter filter;
+    filter.Set(GDK_MOTION_NOTIFY, MessageAction::HoverMove);
+    filter.Set(GDK_ENTER_NOTIFY, MessageAction::HoverMove);
+    filter.Set(GDK_LEAVE_NOTIFY, MessageAction::HoverMove);
+    filter.Set(GDK_BUTTON_PRESS, MessageAction::ButtonDown);
+    filter.Set(GDK_2BUTTON_PRESS, MessageAction::ButtonDoubleClick);
+    filter.Set(GDK_BUTTON_RELEASE, MessageAction::ButtonUp);
+    return filter;
+}
+
+static const MessageFilter g_event_filter = MakeEventFilter();
+
+// Whether HandleEvent() has replaced GTK's event handler
+static bool g_event_handler_installed = false;
+
+// GDK has no frame metrics for undecorated windows: the border is
+// RESIZE_BORDER_WIDTH logical pixels, in device pixels at the window's scale
+static FrameMetrics QueryFrameMetrics(GdkWindow* toplevel) {
+    FrameMetrics metrics;
+    metrics.dpi = 96 * static_cast<unsigned int>(gdk_window_get_scale_factor(toplevel));
+    metrics.frameX = window_decoration::ScaleForDpi(RESIZE_BORDER_WIDTH, metrics.dpi);
+    metrics.frameY = metrics.frameX;
+    metrics.padding = 0;
+    return metrics;
+}
+
+// Size and maximized state of a toplevel. Hit tests run in window
+// coordinates, so the window rect starts at 0, 0. All of it is cached
+// client-side by GDK; nothing here waits for the X server.
+static FramePlacement QueryFramePlacement(GdkWindow* toplevel) {
+    int scale = gdk_window_get_scale_factor(toplevel);
+
+    FramePlacement placement;
+    placement.windowRect = { 0, 0, gdk_window_get_width(toplevel) * scale, gdk_window_get_height(toplevel) * scale };
+    placement.clientLeft = 0;
+    placement.clientTop = 0;
+    placement.isMaximized =
+        (gdk_window_get_state(toplevel) & (GDK_WINDOW_STATE_MAXIMIZED | GDK_WINDOW_STATE_FULLSCREEN)) != 0;
+    return placement;
+}
+
+// Get the cached frame geometry, querying GDK only if it is stale
+static const FrameGeometry& GetFrameGeometry(GdkWindow* toplevel, WindowState& state) {
+    return state.geometry.Get(
+        [toplevel]() { return QueryFrameMetrics(toplevel); },
+        [toplevel]() { return QueryFramePlacement(toplevel); }
+    );
+}
+
+// Position of a pointer event relative to its toplevel, in device pixels.
+// Events of child windows (the Flutter view) are translated through the
+// window offsets GDK keeps client-side.
+static bool GetEventPosition(const GdkEvent* event, GdkWindow* window, GdkWindow* toplevel,
+                             int scale, int* x, int* y) {
+    gdouble eventX = 0;
+    gdouble eventY = 0;
+    if (!gdk_event_get_coords(event, &eventX, &eventY)) {
+        return false;
+    }
+
+    while (window != toplevel) {
+        gdk_window_coords_to_parent(window, eventX, eventY, &eventX, &eventY);
+        window = gdk_window_get_effective_parent(window);
+        if (window == nullptr) {
+            return false;
+        }
+    }
+
+    *x = static_cast<int>(std::floor(eventX * scale));
+    *y = static_cast<int>(std::floor(eventY * scale));
+    return true;
+}
+
+// Themed cursor name for a shape
+static const char* CursorName(CursorShape shape) {
+    switch (shape) {
+        case CursorShape::ResizeHorizontal:
+            return "ew-resize";
+        case CursorShape::ResizeVertical:
+            return "ns-resize";
+        case CursorShape::ResizeNwse:
+            return "nwse-resize";
+        case CursorShape::ResizeNesw:
+            return "nesw-resize";
+        default:
+            return "default";
+    }
+}
+
+// Get the resize cursor for a hit (nullptr outside the resize borders)
+// from the process-wide cache. Themed cursors depend on the display and
+// scale, so both are part of the key; cached cursors are kept for the
+// lifetime of the process.
+static GdkCursor* GetCursorForHit(GdkDisplay* display, int scale, HitCode hit) {
+    CursorShape shape;
+    if (!window_decoration::CursorShapeForHit(hit, &shape)) {
+        return nullptr;
+    }
+    return g_cursors.Get(shape, reinterpret_cast<uintptr_t>(display), static_cast<uint32_t>(scale),
+        [display](CursorShape loadShape) { return gdk_cursor_new_from_name(display, CursorName(loadShape)); });
+}
+
+// Give the cursor window back the cursor it had before the pointer entered
+// the border
+static void RestoreCursor(WindowState& state, WindowColdState& cold) {
+    if (cold.cursorWindow == nullptr) {
+        return;
+    }
+
+    gdk_window_set_cursor(cold.cursorWindow, cold.savedCursor);
+    state.hover.RecordCursorChange();
+
+    if (cold.savedCursor != nullptr) {
+        g_object_unref(cold.savedCursor);
+    }
+    g_object_unref(cold.cursorWindow);
+    cold.cursorWindow = nullptr;
+    cold.savedCursor = nullptr;
+}
+
+// Show a resize cursor on the GDK window under the pointer unless it is
+// already showing. That window's own cursor is saved the first time.
+static void SetHoverCursor(WindowState& state, WindowColdState& cold, GdkWindow* window, GdkCursor* cursor) {
+    if (cold.cursorWindow != window) {
+        RestoreCursor(state, cold);
+        cold.cursorWindow = static_cast<GdkWindow*>(g_object_ref(window));
+        cold.savedCursor = gdk_window_get_cursor(window);
+        if (cold.savedCursor != nullptr) {
+            g_object_ref(cold.savedCursor);
+        }
+    }
+
+    if (gdk_window_get_cursor(window) != cursor) {
+        gdk_window_set_cursor(window, cursor);
+        state.hover.RecordCursorChange();
+    }
+}
+
+// Show the resize cursor while over a border, touching the cursor only
+// when the hit changes or the application replaced it
+static void UpdateHoverCursor(WindowState& state, WindowColdState& cold, GdkWindow* window,
+                              int scale, HitCode hit) {
+    bool transition = state.hover.Transition(hit);
+
+    if (hit != HitCode::Nowhere) {
+        if (transition) {
+            state.hoverCursor = GetCursorForHit(gdk_window_get_display(window), scale, hit);
+        }
+        if (state.hoverCursor != nullptr) {
+            SetHoverCursor(state, cold, window, state.hoverCursor);
+        }
+    } else if (transition) {
+        RestoreCursor(state, cold);
+        state.hoverCursor = nullptr;
+    }
+}
+
+// Window manager edge for a resize hit
+static GdkWindowEdge ToWindowEdge(HitCode hit) {
+    switch (hit) {
+        case HitCode::Left:
+            return GDK_WINDOW_EDGE_WEST;
+        case HitCode::Right:
+            return GDK_WINDOW_EDGE_EAST;
+        case HitCode::Top:
+            return GDK_WINDOW_EDGE_NORTH;
+        case HitCode::Bottom:
+            return GDK_WINDOW_EDGE_SOUTH;
+        case HitCode::TopLeft:
+            return GDK_WINDOW_EDGE_NORTH_WEST;
+        case HitCode::TopRight:
+            return GDK_WINDOW_EDGE_NORTH_EAST;
+        case HitCode::BottomLeft:
+            return GDK_WINDOW_EDGE_SOUTH_WEST;
+        default:
+            return GDK_WINDOW_EDGE_SOUTH_EAST;
+    }
+}
+
+// Pointer travel (logical pixels, either axis) before a caption press
+// becomes a move, from the same setting GTK's own drags use
+static gint GetDragThreshold(GtkWidget* widget) {
+    gint threshold = 8;
+    g_object_get(gtk_widget_get_settings(widget), "gtk-dnd-drag-threshold", &threshold, nullptr);
+    return threshold;
+}
+
+// Start the move of a pending caption press once a motion event while the
+// button is held has travelled past the drag threshold. The move starts
+// with the press's own position and timestamp, so the window manager
+// treats it like a press on a native frame. Returns true if the event
+// started the move.
+static bool UpdatePendingMove(GtkWidget* widget, WindowState& state, GdkEvent* event) {
+    PendingMove& pending = state.pendingMove;
+    if (gdk_event_get_event_type(event) != GDK_MOTION_NOTIFY) {
+        return false;
+    }
+
+    GdkModifierType modifiers = static_cast<GdkModifierType>(0);
+    if (!gdk_event_get_state(event, &modifiers) || (modifiers & GDK_BUTTON1_MASK) == 0) {
+        // Released outside any window of the process
+        pending.active = false;
+        return false;
+    }
+
+    gdouble rootX = 0;
+    gdouble rootY = 0;
+    gdk_event_get_root_coords(event, &rootX, &rootY);
+    gint threshold = GetDragThreshold(widget);
+    if (std::abs(static_cast<gint>(rootX) - pending.rootX) <= threshold &&
+        std::abs(static_cast<gint>(rootY) - pending.rootY) <= threshold) {
+        return false;
+    }
+
+    pending.active = false;
+    gtk_window_begin_move_drag(GTK_WINDOW(widget), static_cast<gint>(pending.button),
+                               pending.rootX, pending.rootY, pending.time);
+    return true;
+}
+
+// Frame handling for a pointer event of a managed window or one of its
+// child windows. Returns true if the event was consumed: a primary press
+// on a border starts a window manager resize right away; one on the
+// caption is held back and only starts a move once the pointer passes
+// the drag threshold, so a click or double-click there stays a click. A
+// double-click on the caption toggles maximize.
+static bool HandleFrameEvent(GtkWidget* widget, GdkWindow* toplevel, WindowState& state,
+                             WindowColdState& cold, MessageAction action, GdkEvent* event) {
+    if (state.pendingMove.active) {
+        if (action == MessageAction::ButtonUp) {
+            // The press never reached the app, so neither does its release
+            state.pendingMove.active = false;
+            return true;
+        }
+        if (action == MessageAction::HoverMove && UpdatePendingMove(widget, state, event)) {
+            return true;
+        }
+    }
+    if (action == MessageAction::ButtonUp) {
+        return false;
+    }
+
+    const FrameGeometry& geometry = GetFrameGeometry(toplevel, state);
+    int scale = static_cast<int>(geometry.dpi / 96);
+
+    GdkWindow* window = gdk_event_get_window(event);
+    int x = 0;
+    int y = 0;
+    if (!GetEventPosition(event, window, toplevel, scale, &x, &y)) {
+        return false;
+    }
+
+    if (action == MessageAction::HoverMove) {
+        // Mouse moves that stay inside the last resolved cell are answered
+        // from the window's hover memo
+        ResizeCellFn resolveResizeCell = state.resolveResizeCell;
+        HitCode hit = state.hover.Resolve(x, y, state.geometry.generation(),
+            [&geometry, resolveResizeCell](int px, int py, Rect* cell) {
+                return resolveResizeCell(px, py, geometry, cell);
+            });
+        UpdateHoverCursor(state, cold, window, scale, hit);
+        return false;
+    }
+
+    guint button = 0;
+    if (!gdk_event_get_button(event, &button) || button != GDK_BUTTON_PRIMARY) {
+        return false;
+    }
+
+    // Presses are rare enough to always run the full hit test of the mode
+    HitCode hit;
+    {
+        CaptionPublisher::ReadGuard snapshot = state.captions.Read();
+        hit = state.hitTest(x, y, geometry, snapshot->caption, &snapshot->regions, &snapshot->mask);
+    }
+
+    GtkWindow* gtkWindow = GTK_WINDOW(widget);
+    if (action == MessageAction::ButtonDoubleClick) {
+        state.pendingMove.active = false;
+        if (hit != HitCode::Caption) {
+            return false;
+        }
+        if (gtk_window_is_maximized(gtkWindow)) {
+            gtk_window_unmaximize(gtkWindow);
+        } else {
+            gtk_window_maximize(gtkWindow);
+        }
+        return true;
+    }
+
+    if (hit != HitCode::Caption && !window_decoration::IsResizeHit(hit)) {
+        return false;
+    }
+
+    gdouble rootX = 0;
+    gdouble rootY = 0;
+    gdk_event_get_root_coords(event, &rootX, &rootY);
+    guint32 time = gdk_event_get_time(event);
+    if (hit == HitCode::Caption) {
+        state.pendingMove = { true, button, static_cast<gint>(rootX), static_cast<gint>(rootY), time };
+    } else {
+        gtk_window_begin_resize_drag(gtkWindow, ToWindowEdge(hit), static_cast<gint>(button),
+                                     static_cast<gint>(rootX), static_cast<gint>(rootY), time);
+    }
+    return true;
+}
+
+// GDK event handler in front of gtk_main_do_event() once a window has
+// a native frame. Sees every event of the process, so irrelevant
+// ones are filtered out by type before any window lookup.
+static void HandleEvent(GdkEvent* event, gpointer) {
+    GdkEventType type = gdk_event_get_event_type(event);
+    MessageAction action = g_event_filter.Classify(static_cast<uint32_t>(type));
+    bool geometryChanged = type == GDK_CONFIGURE || type == GDK_WINDOW_STATE;
+    GdkWindow* window = gdk_event_get_window(event);
+
+    if ((action != MessageAction::Ignore || geometryChanged) && window != nullptr) {
+        // Managed through the toplevel, whose user data is its GtkWindow
+        GdkWindow* toplevel = gdk_window_get_effective_toplevel(window);
+        gpointer widget = nullptr;
+        gdk_window_get_user_data(toplevel, &widget);
+
+        uint32_t slot = g_windows.Find(static_cast<GtkWidget*>(widget));
+        if (slot != WindowTable::kNoSlot) {
+            WindowState& state = g_windows.hot(slot);
+            if (geometryChanged) {
+                if (window == toplevel) {
+                    state.geometry.Invalidate(FrameCacheEvent::Size);
+                }
+            } else if (HandleFrameEvent(static_cast<GtkWidget*>(widget), toplevel, state,
+                                        g_windows.cold(slot), action, event)) {
+                return;
+            }
+        }
+    }
+
+    gtk_main_do_event(event);
+}
+
+// Stop handling a window's frame. The event handler stays installed; with
+// no managed windows it costs one table load per event.
+static void UnmanageWindow(GtkWidget* widget, uint32_t slot) {
+    WindowColdState& cold = g_windows.cold(slot);
+    RestoreCursor(g_windows.hot(slot), cold);
+    g_signal_handler_disconnect(widget, cold.destroyHandler);
+    g_signal_handler_disconnect(widget, cold.scaleHandler);
+    g_windows.Remove(widget);
+}
+
+static void OnWindowDestroy(GtkWidget* widget, gpointer) {
+    uint32_t slot = g_windows.Find(widget);
+    if (slot != WindowTable::kNoSlot) {
+        UnmanageWindow(widget, slot);
+    }
+}
+
+// Convert a rect in logical pixels to the device pixels the hit test runs
+// in, at the given scale
+static Rect ToDeviceRect(const Rect& rect, int scale) {
+    return { rect.left * scale, rect.top * scale, rect.right * scale, rect.bottom * scale };
+}
+
+static CaptionRegion ToDeviceRegion(const CaptionRegion& region, int scale) {
+    CaptionRegion device = region;
+    device.bounds = ToDeviceRect(region.bounds, scale);
+    device.cornerRadius = region.cornerRadius * scale;
+    return device;
+}
+
+// Republish the caption button zones and named regions at the window's
+// current scale. Regions are replaced in place, so they keep their
+// stacking order.
+static void PublishCaptionRects(GtkWidget* widget, WindowState& state, const WindowColdState& cold) {
+    int scale = gtk_widget_get_scale_factor(widget);
+    state.captions.Update([&](CaptionSnapshot& snapshot) {
+        snapshot.caption.minimizeButton = ToDeviceRect(cold.logicalButtons[0], scale);
+        snapshot.caption.maximizeButton = ToDeviceRect(cold.logicalButtons[1], scale);
+        snapshot.caption.closeButton = ToDeviceRect(cold.logicalButtons[2], scale);
+        for (const LogicalCaptionRegion& entry : cold.logicalRegions) {
+            snapshot.regions.Set(entry.name, ToDeviceRegion(entry.region, scale));
+        }
+        return true;
+    });
+}
+
+static void OnScaleFactorChanged(GtkWidget* widget, GParamSpec*, gpointer) {
+    uint32_t slot = g_windows.Find(widget);
+    if (slot != WindowTable::kNoSlot) {
+        g_windows.hot(slot).geometry.Invalidate(FrameCacheEvent::DpiChanged);
+        PublishCaptionRects(widget, g_windows.hot(slot), g_windows.cold(slot));
+    }
+}
+
+// Republish the frame mode of a window's state block (defined with the
+// state block below)
+static void PublishFrameMode(GtkWidget* widget);
+
+// Switch a window's frame mode. Normal hands the frame back to the window
+// manager; the other modes handle it natively with the rules of the mode
+// (see hit_test_policy.h): Hidden has resize borders only, CustomFrame also
+// a draggable caption.
+static void SetWindowFrameMode(GtkWidget* widget, FrameMode mode) {
+    uint32_t slot = g_windows.Find(widget);
+    if (mode == FrameMode::Normal) {
+        if (slot != WindowTable::kNoSlot) {
+            UnmanageWindow(widget, slot);
+        }
+        PublishFrameMode(widget);
+        return;
+    }
+
+    if (slot == WindowTable::kNoSlot) {
+        slot = g_windows.Insert(widget);
+        WindowColdState& cold = g_windows.cold(slot);
+        cold.destroyHandler = g_signal_connect(widget, "destroy", G_CALLBACK(OnWindowDestroy), nullptr);
+        cold.scaleHandler = g_signal_connect(widget, "notify::scale-factor", G_CALLBACK(OnScaleFactorChanged), nullptr);
+
+        if (!g_event_handler_installed) {
+            gdk_event_handler_set(HandleEvent, nullptr, nullptr);
+            g_event_handler_installed = true;
+        }
+    }
+
+    WindowState& state = g_windows.hot(slot);
+    RestoreCursor(state, g_windows.cold(slot));
+    state.frameMode = mode;
+    state.hitTest = window_decoration::SelectHitTest(mode);
+    state.resolveResizeCell = window_decoration::SelectResizeCell(mode);
+    state.geometry.InvalidateAll();
+    state.hover.Reset();
+    state.hoverCursor = nullptr;
+    state.pendingMove.active = false;
+    PublishFrameMode(widget);
+}
+
+// Publish a new caption height (logical pixels, 0 or less for the default)
+static void PublishCaptionHeight(WindowState& state, int height) {
+    state.captions.Update([height](CaptionSnapshot& snapshot) {
+        snapshot.caption.captionHeight = height > 0 ? height : DEFAULT_CAPTION_HEIGHT;
+        return true;
+    });
+}
+
+// ============================================================================
+// Window State Block
+// ============================================================================
+
+// GObject data key of the window's state block writer
+static const char* STATE_BLOCK_KEY = "window-decoration-state-block";
+
+// Blocks of all windows; never freed, see window_state_block.h
+static WindowStateBlockPool g_state_blocks;
+
+// Owned by the window (object data), so it goes away with it
+struct StateBlockWriter {
+    StateBlockWriter(WindowStateBlock* block, uint64_t window)
+        : publisher(block, window), monitor(0), monitorsGeneration(0) {}
+
+    WindowStatePublisher publisher;
+
+    // Monitor of the last published bounds and the topology generation it
+    // was read from; the monitor and work area are only copied again when
+    // the window moves to another monitor or the monitors change
+    uint64_t monitor;
+    uint64_t monitorsGeneration;
+};
+
+static void ReleaseStateBlockWriter(gpointer data) {
+    StateBlockWriter* writer = static_cast<StateBlockWriter*>(data);
+    g_state_blocks.Release(writer->publisher.block());
+    delete writer;
+}
+
+// Frame mode as reported to callers: undecorated windows without native
+// resize borders report Hidden too
+static FrameMode GetWindowFrameMode(GtkWindow* window) {
+    const WindowState* state = g_windows.FindHot(GTK_WIDGET(window));
+    return state != nullptr ? state->frameMode
+         : gtk_window_get_decorated(window) ? FrameMode::Normal : FrameMode::Hidden;
+}
+
+// Query everything from GTK (logical pixels)
+static WindowStateInfo QueryGtkWindowState(GtkWindow* window) {
+    WindowStateInfo info = {};
+    GtkWidget* widget = GTK_WIDGET(window);
+
+    info.bounds = GetGtkWindowRect(window);
+
+    const MonitorTopology& monitors = GetMonitorTopology(widget);
+    int monitor = FindWindowMonitor(monitors, widget, info.bounds);
+    if (monitor != MonitorTopology::kNone) {
+        info.monitor = monitors.monitor(monitor).bounds;
+        info.workArea = monitors.monitor(monitor).workArea;
+    }
+    info.dpi = 96 * static_cast<uint32_t>(gtk_widget_get_scale_factor(widget));
+
+    info.frameMode = static_cast<int32_t>(GetWindowFrameMode(window));
+
+    info.flags = WINDOW_STATE_VALID;
+    if (gtk_widget_get_visible(widget)) info.flags |= WINDOW_STATE_VISIBLE;
+    if (gtk_window_is_active(window)) info.flags |= WINDOW_STATE_FOCUSED;
+    if (gtk_window_is_maximized(window)) info.flags |= WINDOW_STATE_MAXIMIZED;
+
+    GdkWindow* gdkWindow = gtk_widget_get_window(widget);
+    if (gdkWindow != nullptr) {
+        GdkWindowState state = gdk_window_get_state(gdkWindow);
+        if (state & GDK_WINDOW_STATE_ICONIFIED) info.flags |= WINDOW_STATE_MINIMIZED;
+        if (state & GDK_WINDOW_STATE_FULLSCREEN) info.flags |= WINDOW_STATE_FULLSCREEN;
+    }
+    return info;
+}
+
+// Refresh the monitor and work area if the window moved to another
+// monitor or the monitors changed. Returns true if they were copied again.
+static bool UpdateStateMonitor(StateBlockWriter& writer, GtkWidget* widget) {
+    const MonitorTopology& monitors = GetMonitorTopology(widget);
+    int index = monitors.FindForRect(writer.publisher.state().bounds);
+    if (index == MonitorTopology::kNone) {
+        return false;
+    }
+
+    const MonitorInfo& monitor = monitors.monitor(index);
+    if (monitor.id == writer.monitor && monitors.generation() == writer.monitorsGeneration) {
+        return false;
+    }
+    writer.monitor = monitor.id;
+    writer.monitorsGeneration = monitors.generation();
+    writer.publisher.state().monitor = monitor.bounds;
+    writer.publisher.state().workArea = monitor.workArea;
+    return true;
+}
+
+// Position and size, from the event instead of a query
+static gboolean OnStateConfigure(GtkWidget* widget, GdkEventConfigure* event, gpointer data) {
+    StateBlockWriter& writer = *static_cast<StateBlockWriter*>(data);
+    Rect bounds = { event->x, event->y, event->x + event->width, event->y + event->height };
+    Rect& published = writer.publisher.state().bounds;
+    if (bounds.left != published.left || bounds.top != published.top ||
+        bounds.right != published.right || bounds.bottom != published.bottom) {
+        published = bounds;
+        UpdateStateMonitor(writer, widget);
+        writer.publisher.Publish();
+    }
+    return FALSE;
+}
+
+// Maximized, minimized, fullscreen, and mapped (visible) changes
+static gboolean OnStateWindowState(GtkWidget* widget, GdkEventWindowState* event, gpointer data) {
+    StateBlockWriter& writer = *static_cast<StateBlockWriter*>(data);
+    GdkWindowState state = event->new_window_state;
+    uint32_t flags = 0;
+    if (gtk_widget_get_visible(widget)) flags |= WINDOW_STATE_VISIBLE;
+    if (state & GDK_WINDOW_STATE_MAXIMIZED) flags |= WINDOW_STATE_MAXIMIZED;
+    if (state & GDK_WINDOW_STATE_ICONIFIED) flags |= WINDOW_STATE_MINIMIZED;
+    if (state & GDK_WINDOW_STATE_FULLSCREEN) flags |= WINDOW_STATE_FULLSCREEN;
+
+    const uint32_t mask = WINDOW_STATE_VISIBLE | WINDOW_STATE_MAXIMIZED | WINDOW_STATE_MINIMIZED |
+                          WINDOW_STATE_FULLSCREEN;
+    if (writer.publisher.SetFlags(mask, flags)) {
+        writer.publisher.Publish();
+    }
+    return FALSE;
+}
+
+static void OnStateActive(GtkWidget* widget, GParamSpec*, gpointer data) {
+    StateBlockWriter& writer = *static_cast<StateBlockWriter*>(data);
+    bool active = gtk_window_is_active(GTK_WINDOW(widget));
+    if (writer.publisher.SetFlags(WINDOW_STATE_FOCUSED, active ? WINDOW_STATE_FOCUSED : 0)) {
+        writer.publisher.Publish();
+    }
+}
+
+static void OnStateScaleFactor(GtkWidget* widget, GParamSpec*, gpointer data) {
+    StateBlockWriter& writer = *static_cast<StateBlockWriter*>(data);
+    writer.publisher.state().dpi = 96 * static_cast<uint32_t>(gtk_widget_get_scale_factor(widget));
+    writer.publisher.Publish();
+}
+
+// The window's state block writer, created (and published from a full
+// query) on first use
+static StateBlockWriter* OpenStateBlock(GtkWindow* window) {
+    GObject* object = G_OBJECT(window);
+    StateBlockWriter* writer = static_cast<StateBlockWriter*>(g_object_get_data(object, STATE_BLOCK_KEY));
+    if (writer != nullptr) {
+        return writer;
+    }
+
+    uint64_t handle = reinterpret_cast<uintptr_t>(window);
+    writer = new StateBlockWriter(g_state_blocks.Acquire(handle), handle);
+    g_object_set_data_full(object, STATE_BLOCK_KEY, writer, ReleaseStateBlockWriter);
+
+    GtkWidget* widget = GTK_WIDGET(window);
+    g_signal_connect(widget, "configure-event", G_CALLBACK(OnStateConfigure), writer);
+    g_signal_connect(widget, "window-state-event", G_CALLBACK(OnStateWindowState), writer);
+    g_signal_connect(widget, "notify::is-active", G_CALLBACK(OnStateActive), writer);
+    g_signal_connect(widget, "notify::scale-factor", G_CALLBACK(OnStateScaleFactor), writer);
+
+    // Configure events carry the client area's origin, so start from it
+    // too (gtk_window_get_position() includes the window manager's frame)
+    WindowStateInfo& state = writer->publisher.state();
+    state = QueryGtkWindowState(window);
+    GdkWindow* gdkWindow = gtk_widget_get_window(widget);
+    if (gdkWindow != nullptr) {
+        int x = 0;
+        int y = 0;
+        gdk_window_get_origin(gdkWindow, &x, &y);
+        state.bounds = { x, y, x + state.bounds.right - state.bounds.left, y + state.bounds.bottom - state.bounds.top };
+    }
+    UpdateStateMonitor(*writer, widget);
+    writer->publisher.Publish();
+    return writer;
+}
+
+static void PublishFrameMode(GtkWidget* widget) {
+    StateBlockWriter* writer = static_cast<StateBlockWriter*>(g_object_get_data(G_OBJECT(widget), STATE_BLOCK_KEY));
+    if (writer == nullptr) {
+        return;
+    }
+
+    int32_t frameMode = static_cast<int32_t>(GetWindowFrameMode(GTK_WINDOW(widget)));
+    if (writer->publisher.state().frameMode != frameMode) {
+        writer->publisher.state().frameMode = frameMode;
+        writer->publisher.Publish();
+    }
+}
+
+// ============================================================================
+// Window Events
+// ============================================================================
+
+// GObject data key of the window's event source
+static const char* EVENT_SOURCE_KEY = "window-decoration-event-source";
+
+// Turns a window's signals into WindowEvents. Owned by the window (object
+// data); the stream's delivery thread posts them to a Dart native port.
+struct WindowEventSource {
+    WindowEventSource(GtkWidget* widget, DartPostCObjectFn post, int64_t port)
+        : stream([post, port](const WindowEvent* events, size_t count) {
+              window_decoration::PostWindowEvents(post, port, events, count);
+          }),
+          window(reinterpret_cast<uintptr_t>(widget)),
+          bounds(),
+          settings(gtk_settings_get_default()) {}
+
+    WindowEventStream stream;
+    uint64_t window;
+
+    // Last reported client area, to tell moves from resizes
+    Rect bounds;
+
+    // Process-wide; outlives the window, so its handlers are disconnected
+    // with the source
+    GtkSettings* settings;
+};
+
+static void PushWindowEvent(WindowEventSource& source, WindowEventType type, int32_t a = 0, int32_t b = 0) {
+    WindowEvent event = {};
+    event.window = source.window;
+    event.timestampNs = window_decoration::WindowEventClock();
+    event.type = type;
+    event.values[0] = a;
+    event.values[1] = b;
+    source.stream.Push(event);
+}
+
+static void ReleaseWindowEventSource(gpointer data) {
+    WindowEventSource* source = static_cast<WindowEventSource*>(data);
+    if (source->settings != nullptr) {
+        g_signal_handlers_disconnect_by_data(source->settings, source);
+    }
+    delete source;
+}
+
+static gboolean OnEventConfigure(GtkWidget*, GdkEventConfigure* event, gpointer data) {
+    WindowEventSource& source = *static_cast<WindowEventSource*>(data);
+    Rect& bounds = source.bounds;
+    if (event->x != bounds.left || event->y != bounds.top) {
+        PushWindowEvent(source, WindowEventType::Moved, event->x, event->y);
+    }
+    if (event->width != bounds.right - bounds.left || event->height != bounds.bottom - bounds.top) {
+        PushWindowEvent(source, WindowEventType::Resized, event->width, event->height);
+    }
+    bounds = { event->x, event->y, event->x + event->width, event->y + event->height };
+    return FALSE;
+}
+
+static gboolean OnEventWindowState(GtkWidget*, GdkEventWindowState* event, gpointer data) {
+    WindowEventSource& source = *static_cast<WindowEventSource*>(data);
+    const int showStates = GDK_WINDOW_STATE_MAXIMIZED | GDK_WINDOW_STATE_ICONIFIED;
+    if ((event->changed_mask & showStates) == 0) {
+        return FALSE;
+    }
+
+    GdkWindowState state = event->new_window_state;
+    if (state & GDK_WINDOW_STATE_ICONIFIED) {
+        PushWindowEvent(source, WindowEventType::Minimized);
+    } else if (state & GDK_WINDOW_STATE_MAXIMIZED) {
+        PushWindowEvent(source, WindowEventType::Maximized);
+    } else {
+        PushWindowEvent(source, WindowEventType::Restored);
+    }
+    return FALSE;
+}
+
+static void OnEventScaleFactor(GtkWidget* widget, GParamSpec*, gpointer data) {
+    PushWindowEvent(*static_cast<WindowEventSource*>(data), WindowEventType::DpiChanged,
+                    96 * gtk_widget_get_scale_factor(widget));
+}
+
+static void OnEventActive(GtkWidget* widget, GParamSpec*, gpointer data) {
+    PushWindowEvent(*static_cast<WindowEventSource*>(data), WindowEventType::FocusChanged,
+                    gtk_window_is_active(GTK_WINDOW(widget)) ? 1 : 0);
+}
+
+// Reported only; returning FALSE lets the window close as before
+static gboolean OnEventDelete(GtkWidget*, GdkEvent*, gpointer data) {
+    PushWindowEvent(*static_cast<WindowEventSource*>(data), WindowEventType::CloseRequested);
+    return FALSE;
+}
+
+// Dark if the app prefers the dark variant or the theme is a dark one
+// ("Adwaita-dark", "Yaru:dark")
+static bool IsDarkTheme(GtkSettings* settings) {
+    gboolean preferDark = FALSE;
+    gchar* name = nullptr;
+    g_object_get(settings, "gtk-application-prefer-dark-theme", &preferDark, "gtk-theme-name", &name, nullptr);
+    bool dark = preferDark || (name != nullptr && (g_str_has_suffix(name, "-dark") || g_str_has_suffix(name, ":dark")));
+    g_free(name);
+    return dark;
+}
+
+static void OnEventTheme(GtkSettings* settings, GParamSpec*, gpointer data) {
+    PushWindowEvent(*static_cast<WindowEventSource*>(data), WindowEventType::ThemeChanged,
+                    IsDarkTheme(settings) ? 1 : 0);
+}
+
+static void StopWindowEventSource(GtkWindow* window) {
+    GObject* object = G_OBJECT(window);
+    gpointer source = g_object_get_data(object, EVENT_SOURCE_KEY);
+    if (source != nullptr) {
+        g_signal_handlers_disconnect_by_data(window, source);
+        g_object_set_data(object, EVENT_SOURCE_KEY, nullptr);
+    }
+}
+
+// Start a window's event source, replacing an earlier one (and its port)
+static void StartWindowEventSource(GtkWindow* window, DartPostCObjectFn post, int64_t port) {
+    StopWindowEventSource(window);
+
+    GtkWidget* widget = GTK_WIDGET(window);
+    GObject* object = G_OBJECT(window);
+
+    WindowEventSource* source = new WindowEventSource(widget, post, port);
+    GdkWindow* gdkWindow = gtk_widget_get_window(widget);
+    if (gdkWindow != nullptr) {
+        int x = 0;
+        int y = 0;
+        gdk_window_get_origin(gdkWindow, &x, &y);
+        source->bounds = { x, y, x + gdk_window_get_width(gdkWindow), y + gdk_window_get_height(gdkWindow) };
+    }
+    g_object_set_data_full(object, EVENT_SOURCE_KEY, source, ReleaseWindowEventSource);
+
+    g_signal_connect(widget, "configure-event", G_CALLBACK(OnEventConfigure), source);
+    g_signal_connect(widget, "window-state-event", G_CALLBACK(OnEventWindowState), source);
+    g_signal_connect(widget, "notify::scale-factor", G_CALLBACK(OnEventScaleFactor), source);
+    g_signal_connect(widget, "notify::is-active", G_CALLBACK(OnEventActive), source);
+    g_signal_connect(widget, "delete-event", G_CALLBACK(OnEventDelete), source);
+    if (source->settings != nullptr) {
+        g_signal_connect(source->settings, "notify::gtk-theme-name", G_CALLBACK(OnEventTheme), source);
+        g_signal_connect(source->settings, "notify::gtk-application-prefer-dark-theme",
+                         G_CALLBACK(OnEventTheme), source);
+    }
+}
+
+// ============================================================================
+// Resize Pacing
+// ============================================================================
+
+// GObject data key of the window's resize pacing
+static const char* RESIZE_PACING_KEY = "window-decoration-resize-pacing";
+
+// Holds back a window's size changes until its next frame clock update, so
+// GTK (and the Flutter view inside) lays out at most one size per frame
+// during a resize drag. Owned by the window (object data).
+struct ResizePacing {
+    ResizePacer pacer;
+    GtkWidget* widget;
+
+    // Referenced, so the update handler can always be disconnected
+    GdkFrameClock* clock;
+
+    // Newest held configure event, replayed on the update phase
+    GdkEvent* held;
+
+    // Size of the last configure event GTK has seen
+    int width;
+    int height;
+
+    // Set while a held event is replayed, so it passes through
+    bool replaying;
+};
+
+static uint64_t MonotonicNs() {
+    return static_cast<uint64_t>(g_get_monotonic_time()) * 1000;
+}
+
+// Hand the held configure event to GTK
+static void ReplayHeldConfigure(ResizePacing& pacing) {
+    GdkEvent* event = pacing.held;
+    pacing.held = nullptr;
+    pacing.replaying = true;
+    gtk_widget_event(pacing.widget, event);
+    pacing.replaying = false;
+    gdk_event_free(event);
+}
+
+static void ReleaseResizePacing(gpointer data) {
+    ResizePacing* pacing = static_cast<ResizePacing*>(data);
+    g_signal_handlers_disconnect_by_data(pacing->clock, pacing);
+    g_object_unref(pacing->clock);
+    if (pacing->held != nullptr) {
+        gdk_event_free(pacing->held);
+    }
+    delete pacing;
+}
+
+// Connected to the window's configure-event. Runs before GTK's own handler
+// (configure-event runs its class handler last) and stops the emission for
+// a size change, keeping only the newest one. Moves pass through unless a
+// size is held, so they can't overtake it.
+static gboolean OnPacedConfigure(GtkWidget*, GdkEventConfigure* event, gpointer data) {
+    ResizePacing& pacing = *static_cast<ResizePacing*>(data);
+    if (pacing.replaying) {
+        return FALSE;
+    }
+    if (!pacing.pacer.pending() && event->width == pacing.width && event->height == pacing.height) {
+        return FALSE;
+    }
+
+    if (pacing.held != nullptr) {
+        gdk_event_free(pacing.held);
+    }
+    pacing.held = gdk_event_copy(reinterpret_cast<GdkEvent*>(event));
+    if (pacing.pacer.Request(event->width, event->height, MonotonicNs())) {
+        gdk_frame_clock_request_phase(pacing.clock, GDK_FRAME_CLOCK_PHASE_UPDATE);
+    }
+    return TRUE;
+}
+
+// Frame clock update phase: apply the newest size before this frame's
+// layout phase
+static void OnPacingUpdate(GdkFrameClock*, gpointer data) {
+    ResizePacing& pacing = *static_cast<ResizePacing*>(data);
+    int32_t width = 0;
+    int32_t height = 0;
+    if (!pacing.pacer.Take(MonotonicNs(), &width, &height)) {
+        return;
+    }
+    pacing.width = width;
+    pacing.height = height;
+    ReplayHeldConfigure(pacing);
+}
+
+// Stop pacing a window's resizes, handing a held size to GTK right away
+static void DisableResizePacing(GtkWindow* window) {
+    GObject* object = G_OBJECT(window);
+    ResizePacing* pacing = static_cast<ResizePacing*>(g_object_get_data(object, RESIZE_PACING_KEY));
+    if (pacing == nullptr) {
+        return;
+    }
+    g_signal_handlers_disconnect_by_data(window, pacing);
+    if (pacing->held != nullptr) {
+        pacing->pacer.Take(MonotonicNs(), &pacing->width, &pacing->height);
+        ReplayHeldConfigure(*pacing);
+    }
+    g_object_set_data(object, RESIZE_PACING_KEY, nullptr);
+}
+
+// Needs the window's frame clock, so the window must be realized
+static bool EnableResizePacing(GtkWindow* window) {
+    GtkWidget* widget = GTK_WIDGET(window);
+    GObject* object = G_OBJECT(window);
+    if (g_object_get_data(object, RESIZE_PACING_KEY) != nullptr) {
+        return true;
+    }
+    GdkWindow* gdkWindow = gtk_widget_get_window(widget);
+    GdkFrameClock* clock = gtk_widget_get_frame_clock(widget);
+    if (gdkWindow == nullptr || clock == nullptr) {
+        return false;
+    }
+
+    ResizePacing* pacing = new ResizePacing();
+    pacing->widget = widget;
+    pacing->clock = static_cast<GdkFrameClock*>(g_object_ref(clock));
+    pacing->held = nullptr;
+    pacing->width = gdk_window_get_width(gdkWindow);
+    pacing->height = gdk_window_get_height(gdkWindow);
+    pacing->replaying = false;
+    g_object_set_data_full(object, RESIZE_PACING_KEY, pacing, ReleaseResizePacing);
+
+    g_signal_connect(widget, "configure-event", G_CALLBACK(OnPacedConfigure), pacing);
+    g_signal_connect(clock, "update", G_CALLBACK(OnPacingUpdate), pacing);
+    return true;
+}
+
+// ============================================================================
+// Window Animation
+// ============================================================================
+
+// GObject data key of the window's animator
+static const char* WINDOW_ANIMATOR_KEY = "window-decoration-animator";
+
+// Steps a window's bounds and opacity animation on its frame clock's update
+// phase, before the frame is laid out and painted. Owned by the window
+// (object data).
+struct WindowAnimator {
+    WindowAnimation animation;
+    GtkWidget* widget;
+
+    // Referenced while an animation runs, nullptr otherwise
+    GdkFrameClock* clock;
+
+    // Port told how the running animation ended (1 target reached, 0
+    // stopped early), 0 for none
+    DartPostCObjectFn post;
+    int64_t port;
+
+    // Client-side decoration margins: the GdkWindow is this much larger
+    // than the size GTK reports, which is the size animated
+    int marginWidth;
+    int marginHeight;
+};
+
+static void PostAnimationResult(WindowAnimator& animator, bool completed) {
+    if (animator.port != 0) {
+        window_decoration::PostInt64(animator.post, animator.port, completed ? 1 : 0);
+        animator.port = 0;
+    }
+}
+
+// Stop stepping on the frame clock
+static void DetachAnimationClock(WindowAnimator& animator) {
+    if (animator.clock == nullptr) {
+        return;
+    }
+    g_signal_handlers_disconnect_by_data(animator.clock, &animator);
+    gdk_frame_clock_end_updating(animator.clock);
+    g_object_unref(animator.clock);
+    animator.clock = nullptr;
+}
+
+static void ReleaseWindowAnimator(gpointer data) {
+    WindowAnimator* animator = static_cast<WindowAnimator*>(data);
+    DetachAnimationClock(*animator);
+    PostAnimationResult(*animator, false);
+    delete animator;
+}
+
+// Apply a frame with a single geometry request: gdk_window_move_resize
+// when both position and size change, else just the one that does. The
+// last frame also hands the size to gtk_window_resize, so GtkWindow's own
+// geometry request ends on the target instead of snapping back to an
+// older size later.
+static void ApplyAnimationFrame(WindowAnimator& animator, const WindowAnimationFrame& frame) {
+    GtkWindow* window = GTK_WINDOW(animator.widget);
+    GdkWindow* gdkWindow = gtk_widget_get_window(animator.widget);
+    if ((frame.changed & ANIMATE_BOUNDS) && gdkWindow != nullptr) {
+        Rect current = GetGtkWindowRect(window);
+        int width = frame.bounds.right - frame.bounds.left;
+        int height = frame.bounds.bottom - frame.bounds.top;
+        bool moved = frame.bounds.left != current.left || frame.bounds.top != current.top;
+        bool resized = width != current.right - current.left || height != current.bottom - current.top;
+        if (moved && resized) {
+            gdk_window_move_resize(gdkWindow, frame.bounds.left, frame.bounds.top, width + animator.marginWidth,
+                                   height + animator.marginHeight);
+        } else if (moved) {
+            gdk_window_move(gdkWindow, frame.bounds.left, frame.bounds.top);
+        } else if (resized) {
+            gdk_window_resize(gdkWindow, width + animator.marginWidth, height + animator.marginHeight);
+        }
+    }
+    if (frame.finished && gdkWindow != nullptr) {
+        gtk_window_resize(window, frame.bounds.right - frame.bounds.left, frame.bounds.bottom - frame.bounds.top);
+    }
+    if (frame.changed & ANIMATE_OPACITY) {
+        gtk_widget_set_opacity(animator.widget, frame.opacity);
+    }
+}
+
+// Frame clock update phase: step the animation to this frame's time
+static void OnAnimationUpdate(GdkFrameClock* clock, gpointer data) {
+    WindowAnimator& animator = *static_cast<WindowAnimator*>(data);
+    gint64 frameTime = gdk_frame_clock_get_frame_time(clock);
+    gint64 refreshInterval = 0;
+    gdk_frame_clock_get_refresh_info(clock, frameTime, &refreshInterval, nullptr);
+
+    WindowAnimationFrame frame;
+    if (!animator.animation.Step(frameTime * 1000, refreshInterval * 1000, &frame)) {
+        DetachAnimationClock(animator);
+        return;
+    }
+    ApplyAnimationFrame(animator, frame);
+    if (frame.finished) {
+        DetachAnimationClock(animator);
+        PostAnimationResult(animator, true);
+    }
+}
+
+static WindowAnimator* GetWindowAnimator(GtkWindow* window) {
+    return static_cast<WindowAnimator*>(g_object_get_data(G_OBJECT(window), WINDOW_ANIMATOR_KEY));
+}
+
+// Stop a window's animation where it is. Returns false if none was running.
+static bool CancelAnimation(GtkWindow* window) {
+    WindowAnimator* animator = GetWindowAnimator(window);
+    if (animator == nullptr || !animator->animation.Cancel()) {
+        return false;
+    }
+    DetachAnimationClock(*animator);
+    PostAnimationResult(*animator, false);
+    return true;
+}
+
+// Animate from the window's current bounds and opacity, replacing a
+// running animation. A window that isn't mapped has no frame clock
+// ticking, so it jumps to the target right away.
+static bool StartAnimation(GtkWindow* window, const WindowAnimationParams& params, DartPostCObjectFn post,
+                           int64_t port) {
+    GtkWidget* widget = GTK_WIDGET(window);
+    GObject* object = G_OBJECT(window);
+    WindowAnimator* animator = GetWindowAnimator(window);
+    if (animator == nullptr) {
+        animator = new WindowAnimator();
+        animator->widget = widget;
+        animator->clock = nullptr;
+        animator->post = nullptr;
+        animator->port = 0;
+        g_object_set_data_full(object, WINDOW_ANIMATOR_KEY, animator, ReleaseWindowAnimator);
+    }
+
+    Rect bounds = GetGtkWindowRect(window);
+    if (!animator->animation.Start(params, bounds, gtk_widget_get_opacity(widget))) {
+        return false;
+    }
+    PostAnimationResult(*animator, false);
+    animator->post = post;
+    animator->port = post != nullptr ? port : 0;
+
+    GdkWindow* gdkWindow = gtk_widget_get_window(widget);
+    GdkFrameClock* clock = gtk_widget_get_frame_clock(widget);
+    if (gdkWindow == nullptr || clock == nullptr || !gtk_widget_get_mapped(widget)) {
+        DetachAnimationClock(*animator);
+        WindowAnimationFrame frame;
+        animator->animation.Finish(&frame);
+        if (frame.changed & ANIMATE_BOUNDS) {
+            gtk_window_move(window, frame.bounds.left, frame.bounds.top);
+            gtk_window_resize(window, frame.bounds.right - frame.bounds.left, frame.bounds.bottom - frame.bounds.top);
+        }
+        if (frame.changed & ANIMATE_OPACITY) {
+            gtk_widget_set_opacity(widget, frame.opacity);
+        }
+        PostAnimationResult(*animator, true);
+        return true;
+    }
+
+    animator->marginWidth = gdk_window_get_width(gdkWindow) - (bounds.right - bounds.left);
+    animator->marginHeight = gdk_window_get_height(gdkWindow) - (bounds.bottom - bounds.top);
+    if (animator->clock == nullptr) {
+        animator->clock = static_cast<GdkFrameClock*>(g_object_ref(clock));
+        g_signal_connect(clock, "update", G_CALLBACK(OnAnimationUpdate), animator);
+        gdk_frame_clock_begin_updating(clock);
+    }
+    return true;
+}
+
+// ============================================================================
+// Window Layouts
+// ============================================================================
+
+// GObject data key of the window's layout tracker
+static const char* LAYOUT_TRACKER_KEY = "window-decoration-layout";
+
+// Saved layouts of the app's windows, read once from g_layouts_path when
+// the store is opened and written back LAYOUT_SAVE_DELAY_MS after the last
+// change. Everything here runs on the GTK main thread.
+static const guint LAYOUT_SAVE_DELAY_MS = 500;
+static WindowLayoutStore g_layouts;
+static std::string g_layouts_path;
+static guint g_layouts_save_source = 0;
+
+// Keeps a window's saved layout up to date as it moves, resizes and
+// changes state. Owned by the window (object data).
+struct LayoutTracker {
+    GtkWindow* window;
+    char id[MAX_WINDOW_LAYOUT_ID_BYTES + 1];
+    WindowLayout layout;
+};
+
+// Map the layout file and load the store from it. A missing file is an
+// empty store.
+static bool LoadLayoutFile(const std::string& path) {
+    g_layouts.Clear();
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return errno == ENOENT;
+    }
+
+    bool loaded = false;
+    struct stat info;
+    if (fstat(fd, &info) == 0) {
+        size_t size = static_cast<size_t>(info.st_size);
+        if (size == 0) {
+            loaded = g_layouts.Load(nullptr, 0);
+        } else {
+            void* image = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (image != MAP_FAILED) {
+                loaded = g_layouts.Load(image, size);
+                munmap(image, size);
+            }
+        }
+    }
+    close(fd);
+    return loaded;
+}
+
+// Write the store to a temporary file next to the layout file, flush it to
+// disk and rename it over the old one, so a crash at any point leaves
+// either the old or the new file
+static bool SaveLayoutFile() {
+    if (g_layouts_path.empty()) {
+        return false;
+    }
+
+    std::vector<uint8_t> image(g_layouts.EncodedSize());
+    g_layouts.Encode(image.data(), image.size());
+    std::string temporary = g_layouts_path + ".tmp";
+    int fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    size_t written = 0;
+    while (written < image.size()) {
+        ssize_t result = write(fd, image.data() + written, image.size() - written);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            break;
+        }
+        written += static_cast<size_t>(result);
+    }
+    bool saved = written == image.size() && fsync(fd) == 0;
+    saved = close(fd) == 0 && saved;
+    if (!saved || rename(temporary.c_str(), g_layouts_path.c_str()) != 0) {
+        unlink(temporary.c_str());
+        return false;
+    }
+
+    // Make the rename itself durable
+    gchar* directory = g_path_get_dirname(g_layouts_path.c_str());
+    int directoryFd = open(directory, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (directoryFd >= 0) {
+        fsync(directoryFd);
+        close(directoryFd);
+    }
+    g_free(directory);
+
+    g_layouts.MarkClean();
+    return true;
+}
+
+static gboolean OnLayoutSaveTimeout(gpointer) {
+    g_layouts_save_source = 0;
+    SaveLayoutFile();
+    return G_SOURCE_REMOVE;
+}
+
+// Save LAYOUT_SAVE_DELAY_MS after the last change, so a drag writes the
+// file once when it ends instead of on every configure event
+static void ScheduleLayoutSave() {
+    if (g_layouts_path.empty()) {
+        return;
+    }
+    if (g_layouts_save_source != 0) {
+        g_source_remove(g_layouts_save_source);
+    }
+    g_layouts_save_source = g_timeout_add(LAYOUT_SAVE_DELAY_MS, OnLayoutSaveTimeout, nullptr);
+}
+
+// Save pending changes now. Returns false if writing failed.
+static bool FlushLayouts() {
+    if (g_layouts_save_source != 0) {
+        g_source_remove(g_layouts_save_source);
+        g_layouts_save_source = 0;
+    }
+    return !g_layouts.dirty() || SaveLayoutFile();
+}
+
+// Fingerprint of the monitor holding most of bounds, 0 without monitors
+static uint64_t FingerprintMonitorOf(GtkWidget* widget, const Rect& bounds) {
+    const MonitorTopology& monitors = GetMonitorTopology(widget);
+    int index = FindWindowMonitor(monitors, widget, bounds);
+    return index != MonitorTopology::kNone ? MonitorFingerprint(monitors.monitor(index)) : 0;
+}
+
+// Put the window's current layout into the store. Only restored geometry
+// is saved: while maximized, fullscreen or minimized the bounds from
+// before are kept.
+static void RecordWindowLayout(LayoutTracker& tracker) {
+    GtkWidget* widget = GTK_WIDGET(tracker.window);
+    GdkWindow* gdkWindow = gtk_widget_get_window(widget);
+    if (gdkWindow == nullptr) {
+        return;
+    }
+
+    GdkWindowState state = gdk_window_get_state(gdkWindow);
+    uint32_t flags = 0;
+    if (state & GDK_WINDOW_STATE_MAXIMIZED) flags |= WINDOW_LAYOUT_MAXIMIZED;
+    if (state & GDK_WINDOW_STATE_FULLSCREEN) flags |= WINDOW_LAYOUT_FULLSCREEN;
+    if ((state & (GDK_WINDOW_STATE_MAXIMIZED | GDK_WINDOW_STATE_FULLSCREEN | GDK_WINDOW_STATE_ICONIFIED)) == 0) {
+        tracker.layout.bounds = GetGtkWindowRect(tracker.window);
+        tracker.layout.monitor = FingerprintMonitorOf(widget, tracker.layout.bounds);
+    }
+    tracker.layout.flags = flags;
+    tracker.layout.frameMode = static_cast<int32_t>(GetWindowFrameMode(tracker.window));
+
+    g_layouts.Put(tracker.id, tracker.layout);
+    if (g_layouts.dirty()) {
+        ScheduleLayoutSave();
+    }
+}
+
+// Connected after GTK's own handlers, so the window's position and size
+// are already updated
+static gboolean OnLayoutConfigure(GtkWidget*, GdkEventConfigure*, gpointer data) {
+    RecordWindowLayout(*static_cast<LayoutTracker*>(data));
+    return FALSE;
+}
+
+static gboolean OnLayoutWindowState(GtkWidget*, GdkEventWindowState*, gpointer data) {
+    RecordWindowLayout(*static_cast<LayoutTracker*>(data));
+    return FALSE;
+}
+
+// A closing window is a likely last change before the app exits, so the
+// store is saved right away
+static void ReleaseLayoutTracker(gpointer data) {
+    delete static_cast<LayoutTracker*>(data);
+    if (g_layouts.dirty()) {
+        FlushLayouts();
+    }
+}
+
+// Place a window from the layout saved under id and track its layout
+// under id from now on. Before the window is shown, it opens in place,
+// maximized or fullscreen as it was left.
+static LayoutRestore RestoreLayout(GtkWindow* window, const char* id, WindowLayout* restored) {
+    size_t length = std::strlen(id);
+    if (length == 0 || length > MAX_WINDOW_LAYOUT_ID_BYTES) {
+        return LayoutRestore::None;
+    }
+
+    GtkWidget* widget = GTK_WIDGET(window);
+    GObject* object = G_OBJECT(window);
+    LayoutTracker* tracker = static_cast<LayoutTracker*>(g_object_get_data(object, LAYOUT_TRACKER_KEY));
+    if (tracker == nullptr) {
+        tracker = new LayoutTracker();
+        tracker->window = window;
+        g_object_set_data_full(object, LAYOUT_TRACKER_KEY, tracker, ReleaseLayoutTracker);
+        g_signal_connect_after(widget, "configure-event", G_CALLBACK(OnLayoutConfigure), tracker);
+        g_signal_connect_after(widget, "window-state-event", G_CALLBACK(OnLayoutWindowState), tracker);
+    }
+    std::memset(tracker->id, 0, sizeof(tracker->id));
+    std::memcpy(tracker->id, id, length);
+
+    WindowLayout layout;
+    Rect bounds;
+    if (!g_layouts.Find(id, &layout)) {
+        return LayoutRestore::None;
+    }
+    LayoutRestore result = ResolveWindowLayout(GetMonitorTopology(widget), layout, &bounds);
+    if (result == LayoutRestore::None) {
+        return result;
+    }
+
+    gtk_window_move(window, bounds.left, bounds.top);
+    gtk_window_resize(window, bounds.right - bounds.left, bounds.bottom - bounds.top);
+    if (layout.flags & WINDOW_LAYOUT_MAXIMIZED) {
+        gtk_window_maximize(window);
+    }
+    if (layout.flags & WINDOW_LAYOUT_FULLSCREEN) {
+        gtk_window_fullscreen(window);
+    }
+
+    // Maximized and fullscreen windows keep these restored bounds until
+    // they are restored themselves
+    layout.bounds = bounds;
+    layout.monitor = FingerprintMonitorOf(widget, bounds);
+    tracker->layout = layout;
+    if (restored != nullptr) {
+        *restored = layout;
+    }
+    return result;
+}
+
+// ============================================================================
+// Initial Decoration
+// ============================================================================
+
+// GObject data key of the decoration a runner applied before showing the
+// window (a copy owned by the window)
+static const char* INITIAL_DECORATION_KEY = "window-decoration-initial";
+
+static void ReleaseInitialDecoration(gpointer data) {
+    delete static_cast<InitialDecoration*>(data);
+}
+
+// Set a runner's decoration on a window that isn't shown yet. Decorations
+// and size are set before the window is realized, so the window manager
+// maps it with its final frame and the Flutter view lays out once, at its
+// final size.
+static void ApplyGtkInitialDecoration(GtkWindow* window, const InitialDecoration& decoration) {
+    GtkWidget* widget = GTK_WIDGET(window);
+    FrameMode mode = static_cast<FrameMode>(decoration.frameMode);
+    gboolean decorated = mode == FrameMode::Normal ? TRUE : FALSE;
+    if (gtk_window_get_decorated(window) != decorated) {
+        gtk_window_set_decorated(window, decorated);
+    }
+    SetWindowFrameMode(widget, mode);
+    if (mode == FrameMode::CustomFrame) {
+        PublishCaptionHeight(*g_windows.FindHot(widget), static_cast<int>(decoration.captionHeight));
+    }
+
+    if (decoration.flags & INITIAL_DECORATION_HAS_BACKGROUND) {
+        ApplyBackgroundColor(widget, decoration.backgroundColor);
+    }
+    if (decoration.flags & INITIAL_DECORATION_ALWAYS_ON_TOP) {
+        gtk_window_set_keep_above(window, TRUE);
+    }
+
+    if (decoration.flags & INITIAL_DECORATION_HAS_BOUNDS) {
+        const Rect& bounds = decoration.bounds;
+        int width = bounds.right - bounds.left;
+        int height = bounds.bottom - bounds.top;
+        // The default size is the one an unrealized window is realized with
+        gtk_window_set_default_size(window, width, height);
+        gtk_window_resize(window, width, height);
+        if (!(decoration.flags & INITIAL_DECORATION_CENTERED)) {
+            gtk_window_move(window, bounds.left, bounds.top);
+        }
+    }
+    // After the decorations and size, so the frame size is final
+    if (decoration.flags & INITIAL_DECORATION_CENTERED) {
+        PlaceGtkWindow(window, PlacementMode::Center, nullptr);
+    }
+
+    g_object_set_data_full(G_OBJECT(window), INITIAL_DECORATION_KEY, new InitialDecoration(decoration),
+                           ReleaseInitialDecoration);
+}
+
+// ============================================================================
+// Platform Capabilities
+// ============================================================================
+
+// The GTK and GDK calls the Dart bindings make, so Dart resolves one symbol
+// (GetPlatformCapabilities) instead of opening GTK and GDK and looking up
+// each of these. Mirrored by GtkFunctionTableStruct in Dart; entries are
+// only ever appended.
+struct GtkFunctionTable {
+    void (*windowMove)(GtkWindow*, gint, gint);
+    void (*windowResize)(GtkWindow*, gint, gint);
+    void (*windowGetPosition)(GtkWindow*, gint*, gint*);
+    void (*windowGetSize)(GtkWindow*, gint*, gint*);
+    void (*windowSetOpacity)(GtkWindow*, gdouble);
+    void (*windowSetKeepAbove)(GtkWindow*, gboolean);
+    void (*windowSetSkipTaskbarHint)(GtkWindow*, gboolean);
+    void (*windowFullscreen)(GtkWindow*);
+    void (*windowUnfullscreen)(GtkWindow*);
+    void (*windowSetDecorated)(GtkWindow*, gboolean);
+    void (*widgetShow)(GtkWidget*);
+    void (*widgetHide)(GtkWidget*);
+    void (*gdkWindowSetOpacity)(GdkWindow*, gdouble);
+    GdkScreen* (*screenGetDefault)();
+    gint (*screenGetWidth)(GdkScreen*);
+    gint (*screenGetHeight)(GdkScreen*);
+};
+
+// Dart still calls the deprecated opacity and screen size functions
+G_GNUC_BEGIN_IGNORE_DEPRECATIONS
+static const GtkFunctionTable g_gtk_functions = {
+    gtk_window_move,
+    gtk_window_resize,
+    gtk_window_get_position,
+    gtk_window_get_size,
+    gtk_window_set_opacity,
+    gtk_window_set_keep_above,
+    gtk_window_set_skip_taskbar_hint,
+    gtk_window_fullscreen,
+    gtk_window_unfullscreen,
+    gtk_window_set_decorated,
+    gtk_widget_show,
+    gtk_widget_hide,
+    gdk_window_set_opacity,
+    gdk_screen_get_default,
+    gdk_screen_get_width,
+    gdk_screen_get_height,
+};
+G_GNUC_END_IGNORE_DEPRECATIONS
+
+static CapabilityProbe g_capabilities;
+
+// Read the display server, compositor, window manager hints and versions.
+// Runs once per process; GDK must be initialized, so the first call has to
+// come from the GTK main thread after gtk_init.
+static void ProbeCapabilities(PlatformCapabilities* capabilities) {
+    struct utsname system;
+    if (uname(&system) == 0) {
+        ParseOsVersion(system.release, &capabilities->osMajor, &capabilities->osMinor, &capabilities->osBuild);
+    }
+    capabilities->toolkitMajor = gtk_get_major_version();
+    capabilities->toolkitMinor = gtk_get_minor_version();
+    capabilities->toolkitMicro = gtk_get_micro_version();
+
+    // Every GTK 3 window has a scale factor; monitors have their own from
+    // 3.22 (GdkMonitor)
+    capabilities->flags |= CAPABILITY_WINDOW_DPI;
+    if (gtk_check_version(3, 22, 0) == nullptr) {
+        capabilities->flags |= CAPABILITY_MONITOR_DPI;
+    }
+
+    capabilities->functions = &g_gtk_functions;
+    capabilities->functionsSize = sizeof(g_gtk_functions);
+
+    GdkDisplay* display = gdk_display_get_default();
+    if (display == nullptr) {
+        return;
+    }
+    GdkScreen* screen = gdk_display_get_default_screen(display);
+    if (gdk_screen_is_composited(screen)) {
+        capabilities->flags |= CAPABILITY_COMPOSITOR;
+    }
+
+    // By type name, so the plugin doesn't need the Wayland headers
+    if (g_str_has_prefix(G_OBJECT_TYPE_NAME(display), "GdkWayland")) {
+        capabilities->flags |= CAPABILITY_WAYLAND;
+    }
+#ifdef GDK_WINDOWING_X11
+    if (GDK_IS_X11_DISPLAY(display)) {
+        capabilities->flags |= CAPABILITY_X11;
+        // Answered from the window manager's _NET_SUPPORTED, which GDK
+        // reads once and refreshes when the window manager changes
+        for (size_t i = 0; i < NET_WM_ATOM_COUNT; i++) {
+            if (gdk_x11_screen_supports_net_wm_hint(screen, gdk_atom_intern_static_string(NET_WM_ATOM_NAMES[i]))) {
+                capabilities->netWmAtoms |= 1u << i;
+            }
+        }
+    }
+#endif
+}
+
+static const PlatformCapabilities& Capabilities() {
+    return g_capabilities.Get(ProbeCapabilities);
+}
+
+// ============================================================================
+// Exported Functions
+// ============================================================================
+
+// Apply an encoded WindowDecorationConfig (see decoration_config.h) to a
+// GtkWindow in one pass. Properties the config leaves at their defaults are
+// not touched, decorations are only changed if they differ (each change
+// makes the window manager reframe the window), and while the window is
+// mapped repaints are held back until everything is set, so the whole
+// config shows up in a single frame. Effects are not supported by GTK3 and
+// are ignored. Returns false if the blob can't be decoded.
+WINDOW_DECORATION_EXPORT bool ApplyDecorationConfig(void* handle, const uint8_t* blob, size_t length) {
+    DecorationConfig config;
+    if (handle == nullptr || !DecodeDecorationConfig(blob, length, &config)) {
+        return false;
+    }
+
+    GtkWindow* window = GTK_WINDOW(handle);
+    GtkWidget* widget = GTK_WIDGET(window);
+
+    GdkWindow* gdkWindow = gtk_widget_get_window(widget);
+    bool frozen = gdkWindow != nullptr && gtk_widget_get_mapped(widget);
+    if (frozen) {
+        gdk_window_freeze_updates(gdkWindow);
+    }
+
+    gboolean decorated = config.decorated() ? TRUE : FALSE;
+    if (gtk_window_get_decorated(window) != decorated) {
+        gtk_window_set_decorated(window, decorated);
+    }
+    if (decorated) {
+        SetWindowFrameMode(widget, FrameMode::Normal);
+    } else if (config.titleBarStyle == TitleBarStyle::CustomFrame) {
+        SetWindowFrameMode(widget, FrameMode::CustomFrame);
+        PublishCaptionHeight(*g_windows.FindHot(widget), config.captionHeight);
+    } else {
+        SetWindowFrameMode(widget, FrameMode::Hidden);
+    }
+
+    if (config.has(DECORATION_CONFIG_ALWAYS_ON_TOP)) {
+        gtk_window_set_keep_above(window, TRUE);
+    }
+    if (config.has(DECORATION_CONFIG_SKIP_TASKBAR) && !gtk_window_get_skip_taskbar_hint(window)) {
+        gtk_window_set_skip_taskbar_hint(window, TRUE);
+    }
+    if (config.has(DECORATION_CONFIG_HAS_BACKGROUND)) {
+        ApplyBackgroundColor(widget, config.backgroundColor);
+    }
+    if (config.has(DECORATION_CONFIG_HAS_OPACITY)) {
+        gtk_widget_set_opacity(widget, config.opacity);
+    }
+
+    // After the decorations, so the frame size is final
+    if (config.has(DECORATION_CONFIG_CENTERED)) {
+        PlaceGtkWindow(window, PlacementMode::Center, nullptr);
+    }
+
+    bool visible = config.has(DECORATION_CONFIG_VISIBLE);
+    if (visible != static_cast<bool>(gtk_widget_get_visible(widget))) {
+        if (visible) {
+            gtk_widget_show(widget);
+        } else {
+            gtk_widget_hide(widget);
+        }
+    }
+
+    if (frozen) {
+        gdk_window_thaw_updates(gdkWindow);
+    }
+    return true;
+}
+
+// Apply a runner's initial decoration (see initial_decoration.h) to a
+// GtkWindow before it is first shown: frame mode and caption height,
+// background color, bounds (logical pixels) or centering, and
+// always-on-top. Runners call it right after creating the window, before
+// the window or the Flutter view is realized, so the first frame is
+// already right and applyConfig() has nothing left to change. Returns
+// false for a null handle or an invalid decoration.
+WINDOW_DECORATION_EXPORT bool ApplyInitialDecoration(void* handle, const InitialDecoration* decoration) {
+    if (handle == nullptr || decoration == nullptr || !IsValidInitialDecoration(*decoration)) {
+        return false;
+    }
+    ApplyGtkInitialDecoration(GTK_WINDOW(handle), *decoration);
+    return true;
+}
+
+// Copy the decoration a runner applied with ApplyInitialDecoration to
+// decoration (if not null). Returns false if none was applied.
+WINDOW_DECORATION_EXPORT bool GetInitialDecoration(void* handle, InitialDecoration* decoration) {
+    if (handle == nullptr) {
+        return false;
+    }
+    const InitialDecoration* applied = static_cast<const InitialDecoration*>(
+        g_object_get_data(G_OBJECT(handle), INITIAL_DECORATION_KEY));
+    if (applied == nullptr) {
+        return false;
+    }
+    if (decoration != nullptr) {
+        *decoration = *applied;
+    }
+    return true;
+}
+
+// What the display server, compositor and window manager support (see
+// platform_capabilities.h), probed on the first call; make it from the GTK
+// main thread. functions points to the GtkFunctionTable. The result lives
+// for the process.
+WINDOW_DECORATION_EXPORT const PlatformCapabilities* GetPlatformCapabilities() {
+    return &Capabilities();
+}
+
+// Place a window from the cached monitor topology (see window_placement.h):
+// 0 centers it in its monitor's work area (the primary monitor's before it
+// is realized), 1 moves it, and shrinks it if needed, into the work area,
+// 2 cascades it from anchor on the anchor's monitor. Returns false for a
+// null handle, an unknown mode, Cascade without an anchor, or no monitors.
+WINDOW_DECORATION_EXPORT bool PlaceWindow(void* handle, int mode, void* anchor) {
+    if (handle == nullptr || mode < static_cast<int>(PlacementMode::Center) ||
+        mode > static_cast<int>(PlacementMode::Cascade)) {
+        return false;
+    }
+    PlacementMode placement = static_cast<PlacementMode>(mode);
+    if (placement == PlacementMode::Cascade && anchor == nullptr) {
+        return false;
+    }
+    return PlaceGtkWindow(GTK_WINDOW(handle), placement, anchor != nullptr ? GTK_WINDOW(anchor) : nullptr);
+}
+
+// Snapshot of a window's bounds, monitor, scale, decorations and show
+// state, returned by value (logical pixels, like the GTK setters). Allocates
+// nothing, so it can be bound as a leaf call and polled.
+WINDOW_DECORATION_EXPORT WindowStateInfo QueryWindowState(void* handle) {
+    if (handle == nullptr) {
+        return WindowStateInfo();
+    }
+    return QueryGtkWindowState(GTK_WINDOW(handle));
+}
+
+// Get the window's state block, creating it on first use. The block is
+// republished from the window's configure, window-state, focus and scale
+// signals, so reading it (see window_state_block.h) costs no GTK call and
+// no X server round trip. Its bounds are the client area's, as configure
+// events report them: for a window with window manager decorations they
+// exclude the frame that QueryWindowState includes. The pointer stays
+// readable for the life of the process; once the window is destroyed the
+// block's window reads as 0.
+// Returns nullptr for a null handle.
+WINDOW_DECORATION_EXPORT WindowStateBlock* OpenWindowStateBlock(void* handle) {
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    return OpenStateBlock(GTK_WINDOW(handle))->publisher.block();
+}
+
+// Post the window's moves, resizes, maximize/minimize/restore, DPI, focus
+// and theme changes and close requests to a Dart native port, as Uint8List
+// batches of WindowEvent records (see window_event_stream.h). postCObject
+// is Dart's NativeApi.postCObject. Redundant events are coalesced to at
+// most one per type per frame. Replaces an earlier port of the window.
+// Returns false for a null handle or function.
+WINDOW_DECORATION_EXPORT bool StartWindowEvents(void* handle, void* postCObject, int64_t port) {
+    if (handle == nullptr || postCObject == nullptr) {
+        return false;
+    }
+    StartWindowEventSource(GTK_WINDOW(handle), reinterpret_cast<DartPostCObjectFn>(postCObject), port);
+    return true;
+}
+
+// Stop posting the window's events. Events not yet posted are dropped.
+WINDOW_DECORATION_EXPORT void StopWindowEvents(void* handle) {
+    if (handle == nullptr) return;
+    StopWindowEventSource(GTK_WINDOW(handle));
+}
+
+// Pace the window's resizes to its frame clock (or stop doing so). While
+// enabled, a size change reported by the window manager is held until the
+// next frame clock update and only the newest one is handed to GTK, so a
+// resize drag lays out at most once per display refresh however often the
+// window manager reports sizes. Disabling applies a held size right away.
+// Returns false for a null handle or an unrealized window.
+WINDOW_DECORATION_EXPORT bool SetResizePacing(void* handle, bool enabled) {
+    if (handle == nullptr) {
+        return false;
+    }
+    if (!enabled) {
+        DisableResizePacing(GTK_WINDOW(handle));
+        return true;
+    }
+    return EnableResizePacing(GTK_WINDOW(handle));
+}
+
+// Get the window's resize pacing counters: sizes requested, applied and
+// skipped, and the latency from the newest size to the frame applying it.
+// Returns false if pacing is not enabled for the window.
+WINDOW_DECORATION_EXPORT bool GetResizePacingStats(void* handle, ResizePacingStats* stats) {
+    if (handle == nullptr || stats == nullptr) {
+        return false;
+    }
+    ResizePacing* pacing = static_cast<ResizePacing*>(g_object_get_data(G_OBJECT(handle), RESIZE_PACING_KEY));
+    if (pacing == nullptr) {
+        return false;
+    }
+    *stats = pacing->pacer.stats();
+    return true;
+}
+
+// Animate a window's bounds and/or opacity (see window_animation.h) from
+// its current ones, stepped natively on every frame clock update, so Dart
+// makes no call per frame. Bounds are logical pixels, like the GTK
+// setters. A running animation is replaced. When the animation ends, 1
+// (target reached) or 0 (replaced, cancelled or window destroyed) is
+// posted to port through postCObject (NativeApi.postCObject); pass null
+// for no notification. A window that isn't mapped jumps to the target.
+// Returns false for a null handle or invalid params.
+WINDOW_DECORATION_EXPORT bool AnimateWindow(void* handle, const WindowAnimationParams* params, void* postCObject,
+                                            int64_t port) {
+    if (handle == nullptr || params == nullptr) {
+        return false;
+    }
+    return StartAnimation(GTK_WINDOW(handle), *params, reinterpret_cast<DartPostCObjectFn>(postCObject), port);
+}
+
+// Stop a window's animation where it is. Returns false if none was running.
+WINDOW_DECORATION_EXPORT bool CancelWindowAnimation(void* handle) {
+    if (handle == nullptr) {
+        return false;
+    }
+    return CancelAnimation(GTK_WINDOW(handle));
+}
+
+// Get the animation counters of a window. Returns false if it was never
+// animated.
+WINDOW_DECORATION_EXPORT bool GetWindowAnimationStats(void* handle, WindowAnimationStats* stats) {
+    if (handle == nullptr || stats == nullptr) {
+        return false;
+    }
+    WindowAnimator* animator = GetWindowAnimator(GTK_WINDOW(handle));
+    if (animator == nullptr) {
+        return false;
+    }
+    *stats = animator->animation.stats();
+    return true;
+}
+
+// Open the window layout store at path (see window_layout_store.h),
+// replacing an open one after saving its pending changes. The file is
+// memory-mapped and read once; a missing file is an empty store. Returns
+// false for a null path, or a file that can't be read or isn't a layout
+// file; the store then starts empty and the file is replaced on the next
+// save.
+WINDOW_DECORATION_EXPORT bool OpenWindowLayoutStore(const char* path) {
+    if (path == nullptr) {
+        return false;
+    }
+    FlushLayouts();
+    g_layouts_path = path;
+    return LoadLayoutFile(g_layouts_path);
+}
+
+// Place a window from the layout saved under id (UTF-8, at most
+// MAX_WINDOW_LAYOUT_ID_BYTES bytes) and keep the saved layout up to date
+// as the window moves, resizes, maximizes or goes fullscreen; changes are
+// written LAYOUT_SAVE_DELAY_MS after the last one, and when the window is
+// destroyed. Call it before the window is shown, so it opens in place.
+// The layout applied, with bounds resolved for the current monitors, is
+// copied to layout if not null; its frame mode is left to the caller.
+// Returns 1 if the window was placed as it was left, 2 if its monitor was
+// gone or changed and it was moved onto another one, 0 if nothing was
+// saved under id or the id is invalid.
+WINDOW_DECORATION_EXPORT int RestoreWindowLayout(void* handle, const char* id, WindowLayout* layout) {
+    if (handle == nullptr || id == nullptr) {
+        return static_cast<int>(LayoutRestore::None);
+    }
+    return static_cast<int>(RestoreLayout(GTK_WINDOW(handle), id, layout));
+}
+
+// Write pending layout changes now instead of after the delay, e.g. before
+// the app exits. Returns false if writing failed.
+WINDOW_DECORATION_EXPORT bool FlushWindowLayouts() {
+    return FlushLayouts();
+}
+
+// Handle the frame of a window natively or leave it to the window manager
+// (0, Normal). Hidden (1) adds resize borders: pointer events near the
+// edges get the resize cursor, and a primary press there starts
+// gtk_window_begin_resize_drag() without reaching Flutter. CustomFrame (2)
+// also makes the caption (see SetCaptionHeight) drag the window with
+// gtk_window_begin_move_drag(), once the pointer passes the drag
+// threshold, and maximize on double-click. The caller
+// removes the native frame (gtk_window_set_decorated) itself.
+// Returns false for an unknown mode.
+WINDOW_DECORATION_EXPORT bool SetFrameMode(void* handle, int mode) {
+    if (handle == nullptr || mode < static_cast<int>(FrameMode::Normal) ||
+        mode > static_cast<int>(FrameMode::CustomFrame)) {
+        return false;
+    }
+    SetWindowFrameMode(GTK_WIDGET(handle), static_cast<FrameMode>(mode));
+    return true;
+}
+
+// Get the frame mode set with SetFrameMode (0 = Normal)
+WINDOW_DECORATION_EXPORT int GetFrameMode(void* handle) {
+    const WindowState* state = g_windows.FindHot(static_cast<GtkWidget*>(handle));
+    return static_cast<int>(state != nullptr ? state->frameMode : FrameMode::Normal);
+}
+
+// Copy the hover memo counters of a window with a native frame.
+// Returns false if the window has none.
+WINDOW_DECORATION_EXPORT bool GetHoverStats(void* handle, HoverStats* stats) {
+    const WindowState* state = g_windows.FindHot(static_cast<GtkWidget*>(handle));
+    if (state == nullptr || stats == nullptr) {
+        return false;
+    }
+    *stats = state->hover.stats();
+    return true;
+}
+
+// Set the caption height (logical pixels, scaled with the window; 0 or
+// less for the default). Presses in the caption drag the window unless a
+// caption button zone or a region with another hit covers them.
+WINDOW_DECORATION_EXPORT void SetCaptionHeight(void* handle, int height) {
+    WindowState* state = g_windows.FindHot(static_cast<GtkWidget*>(handle));
+    if (state == nullptr) return;
+
+    PublishCaptionHeight(*state, height);
+}
+
+// Set caption button zones (logical client pixels, scaled with the
+// window). Presses there reach Flutter instead of dragging the window.
+WINDOW_DECORATION_EXPORT void SetCaptionButtonZones(
+    void* handle,
+    int minLeft, int minTop, int minRight, int minBottom,
+    int maxLeft, int maxTop, int maxRight, int maxBottom,
+    int closeLeft, int closeTop, int closeRight, int closeBottom
+) {
+    GtkWidget* widget = static_cast<GtkWidget*>(handle);
+    uint32_t slot = g_windows.Find(widget);
+    if (slot == WindowTable::kNoSlot) return;
+
+    Rect* buttons = g_windows.cold(slot).logicalButtons;
+    buttons[0] = { minLeft, minTop, minRight, minBottom };
+    buttons[1] = { maxLeft, maxTop, maxRight, maxBottom };
+    buttons[2] = { closeLeft, closeTop, closeRight, closeBottom };
+    int scale = gtk_widget_get_scale_factor(widget);
+    g_windows.hot(slot).captions.Update([&](CaptionSnapshot& snapshot) {
+        snapshot.caption.minimizeButton = ToDeviceRect(buttons[0], scale);
+        snapshot.caption.maximizeButton = ToDeviceRect(buttons[1], scale);
+        snapshot.caption.closeButton = ToDeviceRect(buttons[2], scale);
+        snapshot.caption.hasCaptionButtons = true;
+        return true;
+    });
+}
+
+// Clear caption button zones
+WINDOW_DECORATION_EXPORT void ClearCaptionButtonZones(void* handle) {
+    WindowState* state = g_windows.FindHot(static_cast<GtkWidget*>(handle));
+    if (state == nullptr) return;
+
+    state->captions.Update([](CaptionSnapshot& snapshot) {
+        snapshot.caption.hasCaptionButtons = false;
+        return true;
+    });
+}
+
+// Add or replace a named caption region (logical client pixels, scaled
+// with the window).
+// hit: 1 = client, 2 = caption, 3 = minimize, 4 = maximize, 5 = close;
+// everything but caption keeps presses for Flutter
+WINDOW_DECORATION_EXPORT bool SetCaptionRegion(
+    void* handle, const char* name, int hit,
+    int left, int top, int right, int bottom, int cornerRadius
+) {
+    GtkWidget* widget = static_cast<GtkWidget*>(handle);
+    uint32_t slot = g_windows.Find(widget);
+    if (slot == WindowTable::kNoSlot || name == nullptr) return false;
+    if (hit < static_cast<int>(HitCode::Client) || hit > static_cast<int>(HitCode::Close)) return false;
+
+    CaptionRegion region;
+    region.bounds = { left, top, right, bottom };
+    region.hit = static_cast<HitCode>(hit);
+    region.cornerRadius = cornerRadius;
+    CaptionRegion device = ToDeviceRegion(region, gtk_widget_get_scale_factor(widget));
+    bool set = g_windows.hot(slot).captions.Update([&](CaptionSnapshot& snapshot) {
+        return snapshot.regions.Set(name, device);
+    });
+    if (!set) return false;
+
+    // Same order as the index: a replaced region keeps its place
+    std::vector<LogicalCaptionRegion>& regions = g_windows.cold(slot).logicalRegions;
+    for (LogicalCaptionRegion& entry : regions) {
+        if (entry.name == name) {
+            entry.region = region;
+            return true;
+        }
+    }
+    regions.push_back({ name, region });
+    return true;
+}
+
+// Remove a named caption region
+WINDOW_DECORATION_EXPORT bool RemoveCaptionRegion(void* handle, const char* name) {
+    uint32_t slot = g_windows.Find(static_cast<GtkWidget*>(handle));
+    if (slot == WindowTable::kNoSlot || name == nullptr) return false;
+
+    bool removed = g_windows.hot(slot).captions.Update([name](CaptionSnapshot& snapshot) {
+        return snapshot.regions.Remove(name);
+    });
+    std::vector<LogicalCaptionRegion>& regions = g_windows.cold(slot).logicalRegions;
+    for (size_t i = 0; i < regions.size(); i++) {
+        if (regions[i].name == name) {
+            regions.erase(regions.begin() + static_cast<std::ptrdiff_t>(i));
+            break;
+        }
+    }
+    return removed;
+}
+
+// Remove all named caption regions
+WINDOW_DECORATION_EXPORT void ClearCaptionRegions(void* handle) {
+    uint32_t slot = g_windows.Find(static_cast<GtkWidget*>(handle));
+    if (slot == WindowTable::kNoSlot) return;
+
+    g_windows.hot(slot).captions.Update([](CaptionSnapshot& snapshot) {
+        snapshot.regions.Clear();
+        return true;
+    });
+    g_windows.cold(slot).logicalRegions.clear();
+}
@@ -0,0 +1,97 @@
+import 'dart:typed_data';
+
+import 'package:flutter/foundation.dart';
+
+/// A 1-bit "interactive vs. draggable" mask of the caption area.
+///
+/// Describes title bar shapes that rectangles can't, such as pill-shaped
+/// tabs, rounded buttons or overlapping widgets. The mask is in logical
+/// pixels with its origin at the top-left of the client area. Pixels inside
+/// the mask are draggable unless covered by an interactive span.
+///
+/// Rows are stored run-length encoded, so a typical title bar takes a few
+/// KB. For each row, [runs] holds the number of runs followed by the run
+/// lengths, alternating draggable / interactive and starting with draggable.
+@immutable
+class CaptionMask {
+  const CaptionMask({
+    required this.width,
+    required this.height,
+    required this.runs,
+  });
+
+  /// Build a mask from the interactive spans of each row.
+  ///
+  /// `rows[y]` lists the interactive `(start, end)` spans of row `y` in
+  /// logical pixels, end exclusive.
+  ///
+  /// Example:
+  /// ```dart
+  /// // A 28 px high tab strip with one 120 px wide tab at x = 80
+  /// final mask = CaptionMask.fromSpans(
+  ///   width: 1280,
+  ///   rows: List.generate(40, (y) => y >= 6 && y < 34 ? [(80, 200)] : []),
+  /// );
+  /// ```
+  factory CaptionMask.fromSpans({
+    required int width,
+    required List<List<(int, int)>> rows,
+  }) {
+    return CaptionMask(
+      width: width,
+      height: rows.length,
+      runs: encodeRows(width, rows),
+    );
+  }
+
+  /// Width of the mask in logical pixels
+  final int width;
+
+  /// Height of the mask in logical pixels (number of rows)
+  final int height;
+
+  /// Run-length encoded rows
+  final Uint16List runs;
+
+  /// Encode the interactive spans of consecutive rows.
+  ///
+  /// Use this with `updateCaptionMaskRows()` to replace only the rows that
+  /// changed. Spans may overlap and be given in any order.
+  static Uint16List encodeRows(int width, List<List<(int, int)>> rows) {
+    final out = <int>[];
+    for (final row in rows) {
+      final spans = [
+        for (final (start, end) in row)
+          if (end > start && end > 0 && start < width)
+            (start.clamp(0, width), end.clamp(0, width)),
+      ]..sort((a, b) => a.$1.compareTo(b.$1));
+
+      final countIndex = out.length;
+      out.add(0);
+
+      var x = 0;
+      var runs = 0;
+      for (final (start, end) in spans) {
+        if (end <= x) continue;
+        final spanStart = start > x ? start : x;
+        // Draggable run up to the span, then the interactive span. Touching
+        // spans are merged into the previous interactive run.
+        if (spanStart > x || runs == 0) {
+          out
+            ..add(spanStart - x)
+            ..add(end - spanStart);
+          runs += 2;
+        } else {
+          out[out.length - 1] += end - spanStart;
+        }
+        x = end;
+      }
+      out[countIndex] = runs;
+    }
+    return Uint16List.fromList(out);
+  }
+
+  @override
+  String toString() =>
+      'CaptionMask(width: $width, height: $height, ${runs.length} values)';
+}
@@ -0,0 +1,25 @@
+/// What a caption region reports to the window manager when hit.
+///
+/// Used with custom title bars to mark interactive widgets (tabs, search
+/// boxes, menus, avatars) so they don't start a window drag.
+enum CaptionRegionHit {
+  /// Regular client area: the app handles the input, no drag
+  client(1),
+
+  /// Draggable caption area
+  caption(2),
+
+  /// Native minimize button
+  minimize(3),
+
+  /// Native maximize button (enables snap layouts on Windows 11)
+  maximize(4),
+
+  /// Native close button
+  close(5);
+
+  const CaptionRegionHit(this.value);
+
+  /// The native value for this hit result
+  final int value;
+}
@@ -0,0 +1,88 @@
+import 'package:flutter/material.dart';
+
+import 'package:window_decoration_platform_interface/src/models/title_bar_style.dart';
+import 'package:window_decoration_platform_interface/src/models/window_bounds.dart';
+import 'package:window_decoration_platform_interface/src/models/window_decoration_config.dart';
+
+/// What the app's runner applied to a window before it was first shown
+/// (`ApplyInitialDecoration`, see `initial_decoration.h` in
+/// window_decoration_core)
+@immutable
+class InitialDecoration {
+  const InitialDecoration({
+    required this.frameMode,
+    required this.captionHeight,
+    required this.centered,
+    required this.alwaysOnTop,
+    this.backgroundColor,
+    this.bounds,
+  });
+
+  /// Native frame mode: 0 = normal, 1 = hidden, 2 = custom frame
+  final int frameMode;
+
+  /// Caption height in logical pixels (custom frame only)
+  final int captionHeight;
+
+  /// Whether the window was centered in its monitor's work area
+  final bool centered;
+
+  /// Whether the window was made always-on-top
+  final bool alwaysOnTop;
+
+  /// Background color, if the runner set one
+  final Color? backgroundColor;
+
+  /// Window rect in the backend's screen coordinates, if the runner set one;
+  /// only its size was used when [centered]
+  final WindowBounds? bounds;
+
+  /// The frame mode [config] asks for, or null for title bar styles that
+  /// are more than a frame mode (transparent and unified title bars)
+  static int? frameModeOf(WindowDecorationConfig config) =>
+      switch (config.titleBarStyle) {
+        TitleBarStyle.normal => config.frameless ? 1 : 0,
+        TitleBarStyle.hidden => 1,
+        TitleBarStyle.customFrame => 2,
+        TitleBarStyle.transparent || TitleBarStyle.unified => null,
+      };
+
+  /// Whether the runner gave the window the frame (and, for a custom
+  /// frame, the caption height) [config] asks for
+  bool hasFrameOf(WindowDecorationConfig config) =>
+      frameModeOf(config) == frameMode &&
+      (frameMode != 2 || captionHeight == config.captionHeight);
+
+  /// Whether the runner set the background color [config] asks for
+  bool hasBackgroundOf(WindowDecorationConfig config) =>
+      backgroundColor != null &&
+      config.backgroundColor?.toARGB32() == backgroundColor!.toARGB32();
+
+  @override
+  String toString() =>
+      'InitialDecoration(frameMode: $frameMode, captionHeight: $captionHeight, '
+      'centered: $centered, alwaysOnTop: $alwaysOnTop, '
+      'backgroundColor: $backgroundColor, bounds: $bounds)';
+
+  @override
+  bool operator ==(Object other) =>
+      identical(this, other) ||
+      other is InitialDecoration &&
+          runtimeType == other.runtimeType &&
+          frameMode == other.frameMode &&
+          captionHeight == other.captionHeight &&
+          centered == other.centered &&
+          alwaysOnTop == other.alwaysOnTop &&
+          backgroundColor == other.backgroundColor &&
+          bounds == other.bounds;
+
+  @override
+  int get hashCode => Object.hash(
+    frameMode,
+    captionHeight,
+    centered,
+    alwaysOnTop,
+    backgroundColor,
+    bounds,
+  );
+}
@@ -0,0 +1,22 @@
+/// Easing of a window animation (see
+/// [WindowDecorationPlatform.animateWindow])
+///
+/// Values match AnimationCurve in window_decoration_core.
+enum WindowAnimationCurve {
+  /// Constant speed
+  linear(0),
+
+  /// Starts slow (cubic)
+  easeIn(1),
+
+  /// Ends slow (cubic)
+  easeOut(2),
+
+  /// Slow at both ends (cubic)
+  easeInOut(3);
+
+  const WindowAnimationCurve(this.value);
+
+  /// Native value
+  final int value;
+}
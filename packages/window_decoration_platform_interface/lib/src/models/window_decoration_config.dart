@@ -1,3 +1,5 @@
+import 'dart:typed_data';
+
 import 'package:flutter/material.dart';
 
 import 'package:window_decoration_platform_interface/src/models/title_bar_style.dart';
@@ -49,12 +51,64 @@ class WindowDecorationConfig {
   /// Default is 32 pixels.
   final int captionHeight;
 
-  /// Visual effects to apply to the window
+  /// Visual effects to apply to the window, at most [maxEncodedEffects]
   final List<WindowEffect> effects;
 
   /// Default configuration with standard window appearance
   static const WindowDecorationConfig defaultConfig = WindowDecorationConfig();
 
+  /// Version of the [encode] layout
+  static const int encodingVersion = 1;
+
+  /// Bytes before the effect list in the [encode] layout
+  static const int _encodedFixedBytes = 16;
+
+  /// Most [effects] the [encode] layout holds (`MAX_DECORATION_EFFECTS` in
+  /// window_decoration_core)
+  static const int maxEncodedEffects = 16;
+
+  /// Encodes this config into the compact binary layout native backends
+  /// apply in one call (`decoration_config.h` in window_decoration_core):
+  /// version, fixed size, flags, ARGB background color, opacity, caption
+  /// height, title bar style and effect count, followed by one byte per
+  /// effect. Multi-byte fields are little-endian.
+  ///
+  /// Throws an [ArgumentError] if there are more than [maxEncodedEffects]
+  /// [effects].
+  Uint8List encode() {
+    if (effects.length > maxEncodedEffects) {
+      throw ArgumentError.value(
+        effects.length,
+        'effects.length',
+        'At most $maxEncodedEffects effects can be encoded',
+      );
+    }
+
+    var flags = 0;
+    if (centered) flags |= 1 << 0;
+    if (alwaysOnTop) flags |= 1 << 1;
+    if (skipTaskbar) flags |= 1 << 2;
+    if (frameless) flags |= 1 << 3;
+    if (visible) flags |= 1 << 4;
+    if (backgroundColor != null) flags |= 1 << 5;
+    if (opacity != null) flags |= 1 << 6;
+
+    final bytes = Uint8List(_encodedFixedBytes + effects.length);
+    final data = ByteData.sublistView(bytes)
+      ..setUint8(0, encodingVersion)
+      ..setUint8(1, _encodedFixedBytes)
+      ..setUint16(2, flags, Endian.little)
+      ..setUint32(4, backgroundColor?.toARGB32() ?? 0, Endian.little)
+      ..setFloat32(8, (opacity ?? 1.0).clamp(0.0, 1.0), Endian.little)
+      ..setUint16(12, captionHeight.clamp(0, 0xFFFF), Endian.little)
+      ..setUint8(14, titleBarStyle.index)
+      ..setUint8(15, effects.length);
+    for (var i = 0; i < effects.length; i++) {
+      data.setUint8(_encodedFixedBytes + i, effects[i].index);
+    }
+    return bytes;
+  }
+
   WindowDecorationConfig copyWith({
     bool? centered,
     bool? alwaysOnTop,
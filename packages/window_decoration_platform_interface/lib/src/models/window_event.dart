@@ -0,0 +1,135 @@
+import 'dart:typed_data';
+
+import 'package:flutter/foundation.dart';
+
+/// Kind of a [WindowEvent]
+///
+/// Values match WindowEventType in window_decoration_core.
+enum WindowEventType {
+  /// The window moved; see [WindowEvent.x] and [WindowEvent.y]
+  moved(1),
+
+  /// The window was resized; see [WindowEvent.width] and [WindowEvent.height]
+  resized(2),
+
+  /// The window was maximized
+  maximized(3),
+
+  /// The window was minimized
+  minimized(4),
+
+  /// The window came back from maximized or minimized
+  restored(5),
+
+  /// The window's scale changed; see [WindowEvent.dpi]
+  dpiChanged(6),
+
+  /// The window gained or lost focus; see [WindowEvent.isFocused]
+  focusChanged(7),
+
+  /// The system or app theme changed; see [WindowEvent.isDark]
+  themeChanged(8),
+
+  /// The user asked to close the window
+  closeRequested(9);
+
+  const WindowEventType(this.value);
+
+  /// Native value
+  final int value;
+
+  static WindowEventType? fromValue(int value) {
+    for (final type in values) {
+      if (type.value == value) return type;
+    }
+    return null;
+  }
+}
+
+/// A window event pushed by the native side
+///
+/// Redundant events are coalesced before delivery: of several moves,
+/// resizes, DPI, focus or theme changes within one frame only the latest
+/// arrives.
+@immutable
+class WindowEvent {
+  const WindowEvent({
+    required this.type,
+    required this.timestamp,
+    int value0 = 0,
+    int value1 = 0,
+  }) : _value0 = value0,
+       _value1 = value1;
+
+  /// Size of one native record (WindowEvent in window_decoration_core)
+  static const int recordSize = 32;
+
+  /// Decode a batch of native records, as posted to a native port
+  ///
+  /// Layout of each 32-byte record (native byte order):
+  /// uint64 window, uint64 timestampNs, uint32 type, int32 values\[2\],
+  /// uint32 reserved. Records of unknown types are skipped.
+  static List<WindowEvent> decodeAll(Uint8List bytes) {
+    final data = ByteData.sublistView(bytes);
+    final events = <WindowEvent>[];
+    for (var offset = 0; offset + recordSize <= bytes.length; offset += recordSize) {
+      final type = WindowEventType.fromValue(data.getUint32(offset + 16, Endian.host));
+      if (type == null) continue;
+      events.add(
+        WindowEvent(
+          type: type,
+          timestamp: Duration(microseconds: data.getUint64(offset + 8, Endian.host) ~/ 1000),
+          value0: data.getInt32(offset + 20, Endian.host),
+          value1: data.getInt32(offset + 24, Endian.host),
+        ),
+      );
+    }
+    return events;
+  }
+
+  /// What happened
+  final WindowEventType type;
+
+  /// When it happened, on the monotonic clock [Stopwatch] also uses
+  final Duration timestamp;
+
+  final int _value0;
+  final int _value1;
+
+  /// New x position in screen coordinates ([WindowEventType.moved])
+  int get x => _value0;
+
+  /// New y position in screen coordinates ([WindowEventType.moved])
+  int get y => _value1;
+
+  /// New width ([WindowEventType.resized])
+  int get width => _value0;
+
+  /// New height ([WindowEventType.resized])
+  int get height => _value1;
+
+  /// New dots per inch, 96 = 100% scale ([WindowEventType.dpiChanged])
+  int get dpi => _value0;
+
+  /// Whether the window now has focus ([WindowEventType.focusChanged])
+  bool get isFocused => _value0 != 0;
+
+  /// Whether the theme is now dark ([WindowEventType.themeChanged])
+  bool get isDark => _value0 != 0;
+
+  @override
+  String toString() => 'WindowEvent(${type.name}, $_value0, $_value1, at $timestamp)';
+
+  @override
+  bool operator ==(Object other) =>
+      identical(this, other) ||
+      other is WindowEvent &&
+          runtimeType == other.runtimeType &&
+          type == other.type &&
+          timestamp == other.timestamp &&
+          _value0 == other._value0 &&
+          _value1 == other._value1;
+
+  @override
+  int get hashCode => Object.hash(type, timestamp, _value0, _value1);
+}
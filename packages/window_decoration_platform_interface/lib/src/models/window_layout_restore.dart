@@ -0,0 +1,27 @@
+/// How [WindowDecorationPlatform.restoreWindowLayout] placed the window
+///
+/// Values match LayoutRestore in window_decoration_core.
+enum WindowLayoutRestore {
+  /// Nothing was saved under the id; the window was left where it is
+  none(0),
+
+  /// Its monitor is still there: placed exactly as it was left
+  exact(1),
+
+  /// Its monitor was unplugged or changed: moved into the work area of
+  /// another one
+  fallback(2);
+
+  const WindowLayoutRestore(this.value);
+
+  /// Native value
+  final int value;
+
+  /// The restore result for a native value, [none] for unknown values
+  static WindowLayoutRestore fromValue(int value) {
+    for (final restore in values) {
+      if (restore.value == value) return restore;
+    }
+    return none;
+  }
+}
@@ -0,0 +1,86 @@
+import 'package:flutter/foundation.dart';
+
+import 'package:window_decoration_platform_interface/src/models/window_bounds.dart';
+
+/// Snapshot of a window's geometry and show state, read in one native call
+@immutable
+class WindowStateInfo {
+  const WindowStateInfo({
+    required this.bounds,
+    required this.monitor,
+    required this.workArea,
+    required this.dpi,
+    required this.frameMode,
+    required this.isVisible,
+    required this.isFocused,
+    required this.isMaximized,
+    required this.isMinimized,
+    required this.isFullScreen,
+  });
+
+  /// Window position and size in screen coordinates
+  final WindowBounds bounds;
+
+  /// Bounds of the monitor the window is on
+  final WindowBounds monitor;
+
+  /// Bounds of that monitor minus taskbars, docks and panels
+  final WindowBounds workArea;
+
+  /// Dots per inch of the window's monitor (96 = 100% scale)
+  final int dpi;
+
+  /// Native frame mode: 0 = normal, 1 = hidden, 2 = custom frame
+  final int frameMode;
+
+  /// Whether the window is shown
+  final bool isVisible;
+
+  /// Whether the window has keyboard focus
+  final bool isFocused;
+
+  /// Whether the window is maximized
+  final bool isMaximized;
+
+  /// Whether the window is minimized
+  final bool isMinimized;
+
+  /// Whether the window covers its whole monitor
+  final bool isFullScreen;
+
+  @override
+  String toString() =>
+      'WindowStateInfo(bounds: $bounds, dpi: $dpi, frameMode: $frameMode, '
+      'visible: $isVisible, focused: $isFocused, maximized: $isMaximized, '
+      'minimized: $isMinimized, fullScreen: $isFullScreen)';
+
+  @override
+  bool operator ==(Object other) =>
+      identical(this, other) ||
+      other is WindowStateInfo &&
+          runtimeType == other.runtimeType &&
+          bounds == other.bounds &&
+          monitor == other.monitor &&
+          workArea == other.workArea &&
+          dpi == other.dpi &&
+          frameMode == other.frameMode &&
+          isVisible == other.isVisible &&
+          isFocused == other.isFocused &&
+          isMaximized == other.isMaximized &&
+          isMinimized == other.isMinimized &&
+          isFullScreen == other.isFullScreen;
+
+  @override
+  int get hashCode => Object.hash(
+    bounds,
+    monitor,
+    workArea,
+    dpi,
+    frameMode,
+    isVisible,
+    isFocused,
+    isMaximized,
+    isMinimized,
+    isFullScreen,
+  );
+}
@@ -2,8 +2,14 @@ import 'package:flutter/foundation.dart' show kIsWeb;
 import 'package:flutter/material.dart';
 import 'package:plugin_platform_interface/plugin_platform_interface.dart';
 
+import 'package:window_decoration_platform_interface/src/models/initial_decoration.dart';
 import 'package:window_decoration_platform_interface/src/models/title_bar_style.dart';
+import 'package:window_decoration_platform_interface/src/models/window_animation_curve.dart';
 import 'package:window_decoration_platform_interface/src/models/window_bounds.dart';
+import 'package:window_decoration_platform_interface/src/models/window_decoration_config.dart';
+import 'package:window_decoration_platform_interface/src/models/window_event.dart';
+import 'package:window_decoration_platform_interface/src/models/window_layout_restore.dart';
+import 'package:window_decoration_platform_interface/src/models/window_state_info.dart';
 import 'package:window_decoration_platform_interface/src/platform_stub.dart'
     if (dart.library.io) 'package:window_decoration_platform_interface/src/platform_io.dart';
 import 'package:window_decoration_platform_interface/src/ffi_stub.dart'
@@ -84,6 +90,85 @@ abstract class WindowDecorationPlatform extends PlatformInterface {
   /// Sets the window bounds (position and size).
   Future<void> setBounds(WindowBounds bounds);
 
+  /// Gets bounds, monitor, DPI, frame mode and show state in one call.
+  ///
+  /// Backends implement this with a single native query that allocates
+  /// nothing, so it is cheap enough to poll.
+  Future<WindowStateInfo> getWindowState() {
+    throw UnimplementedError('getWindowState() is not implemented on this platform.');
+  }
+
+  /// Moves, resizes, maximize/minimize/restore, DPI, focus and theme
+  /// changes and close requests of the window, pushed by the native side.
+  ///
+  /// Backends deliver them in per-frame batches over a native port and
+  /// coalesce redundant events, so listeners don't need to poll
+  /// [getWindowState]. The native side only produces events while the
+  /// stream has listeners.
+  Stream<WindowEvent> get windowEvents {
+    throw UnimplementedError('windowEvents is not implemented on this platform.');
+  }
+
+  /// Animates the window to [bounds] and/or [opacity] over [duration].
+  ///
+  /// Backends step the animation natively on every display frame, with one
+  /// geometry change per frame, so Dart makes no call while it runs. A
+  /// running animation is replaced. Completes with true once the target is
+  /// reached, or false if the animation was replaced, cancelled or the
+  /// window went away, or if neither [bounds] nor [opacity] is given.
+  Future<bool> animateWindow({
+    WindowBounds? bounds,
+    double? opacity,
+    required Duration duration,
+    WindowAnimationCurve curve = WindowAnimationCurve.easeInOut,
+  }) {
+    throw UnimplementedError('animateWindow() is not implemented on this platform.');
+  }
+
+  /// Stops a running [animateWindow] animation where it is.
+  Future<void> cancelWindowAnimation() {
+    throw UnimplementedError('cancelWindowAnimation() is not implemented on this platform.');
+  }
+
+  /// Opens the layout file at [path], where [restoreWindowLayout] finds
+  /// saved window layouts and tracked windows save theirs.
+  ///
+  /// Backends map the file and read it once; a missing file is an empty
+  /// store. Returns false if the file can't be read or isn't a layout file,
+  /// in which case the store starts empty and the file is replaced on the
+  /// next save.
+  Future<bool> openWindowLayoutStore(String path) {
+    throw UnimplementedError('openWindowLayoutStore() is not implemented on this platform.');
+  }
+
+  /// Places the window where the layout saved under [id] left it
+  /// (restored bounds, maximized and fullscreen state) and saves its
+  /// layout under [id] from now on.
+  ///
+  /// Call it before the window is first shown, so it opens in place. If
+  /// the monitor the layout was saved on is gone or changed, the window is
+  /// moved into the work area of another one. Changes are saved shortly
+  /// after the last one and when the window closes.
+  Future<WindowLayoutRestore> restoreWindowLayout(String id) {
+    throw UnimplementedError('restoreWindowLayout() is not implemented on this platform.');
+  }
+
+  /// Saves pending window layout changes now, e.g. before the app exits.
+  ///
+  /// Returns false if writing the layout file failed.
+  Future<bool> flushWindowLayouts() {
+    throw UnimplementedError('flushWindowLayouts() is not implemented on this platform.');
+  }
+
+  /// What the app's runner applied to the window natively before it was
+  /// first shown (`ApplyInitialDecoration`): frame mode, caption height,
+  /// background, bounds and always-on-top state. Null if the runner
+  /// applied nothing.
+  ///
+  /// Platforms without a runner hook report null, so callers can ask on
+  /// every platform.
+  Future<InitialDecoration?> getInitialDecoration() => Future.value(null);
+
   /// Sets the background color of the window.
   ///
   /// Note: On some platforms, this may only affect the window frame,
@@ -119,4 +204,45 @@ abstract class WindowDecorationPlatform extends PlatformInterface {
   /// When [visible] is true, the window will be shown.
   /// When [visible] is false, the window will be hidden.
   Future<void> setVisible({required bool visible});
+
+  /// Applies a whole [WindowDecorationConfig].
+  ///
+  /// The default implementation calls the individual setters one by one.
+  /// The interface has no setter for [WindowDecorationConfig.effects], so
+  /// it ignores them. Backends with a native library override it to apply
+  /// the encoded config ([WindowDecorationConfig.encode]) in a single call
+  /// and a single frame change.
+  Future<void> applyConfig(WindowDecorationConfig config) async {
+    // Apply window positioning
+    if (config.centered) {
+      await center();
+    }
+
+    // Apply window behavior
+    if (config.alwaysOnTop) {
+      await setAlwaysOnTop(alwaysOnTop: true);
+    }
+
+    if (config.skipTaskbar) {
+      await setSkipTaskbar(skip: true);
+    }
+
+    // Apply appearance
+    if (config.backgroundColor != null) {
+      await setBackgroundColor(config.backgroundColor!);
+    }
+
+    if (config.opacity != null) {
+      await setOpacity(config.opacity!);
+    }
+
+    // Apply title bar style
+    await setTitleBarStyle(
+      config.titleBarStyle,
+      captionHeight: config.captionHeight,
+    );
+
+    // Apply visibility
+    await setVisible(visible: config.visible);
+  }
 }
@@ -1,7 +1,14 @@
 export 'src/ffi_stub.dart' if (dart.library.io) 'src/ffi_io.dart';
+export 'src/models/caption_mask.dart';
+export 'src/models/caption_region_hit.dart';
+export 'src/models/initial_decoration.dart';
 export 'src/models/resize_edge.dart';
 export 'src/models/title_bar_style.dart';
+export 'src/models/window_animation_curve.dart';
 export 'src/models/window_bounds.dart';
 export 'src/models/window_decoration_config.dart';
 export 'src/models/window_effect.dart';
+export 'src/models/window_event.dart';
+export 'src/models/window_layout_restore.dart';
+export 'src/models/window_state_info.dart';
 export 'src/window_decoration_platform.dart';
@@ -2,6 +2,10 @@
 
 import 'dart:ffi';
 import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:ffi/ffi.dart';
+import 'package:window_decoration_platform_interface/window_decoration_platform_interface.dart';
 
 /// Win32 API bindings for window manipulation
 class Win32Bindings {
@@ -439,6 +443,146 @@ class Win32Bindings {
     clearFunc(hwnd);
   }
 
+  /// Add or replace a named caption region for hit testing
+  /// Coordinates are client area pixels, like [setCaptionButtonZones]
+  /// [hit]: 1 = client, 2 = caption, 3 = minimize, 4 = maximize, 5 = close
+  /// Returns false if the region was rejected (empty rect, bad hit, too many regions)
+  static bool setCaptionRegion(
+    int hwnd,
+    String name, {
+    required int hit,
+    required int left,
+    required int top,
+    required int right,
+    required int bottom,
+    int cornerRadius = 0,
+  }) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        throw StateError('Native plugin not loaded.');
+      }
+    }
+
+    final setRegionFunc = _pluginLib!.lookupFunction<
+        Bool Function(
+          IntPtr hwnd, Pointer<Utf8> name, Int32 hit,
+          Int32 left, Int32 top, Int32 right, Int32 bottom, Int32 cornerRadius,
+        ),
+        bool Function(
+          int hwnd, Pointer<Utf8> name, int hit,
+          int left, int top, int right, int bottom, int cornerRadius,
+        )>('SetCaptionRegion');
+
+    final nativeName = name.toNativeUtf8();
+    try {
+      return setRegionFunc(
+        hwnd, nativeName, hit,
+        left, top, right, bottom, cornerRadius,
+      );
+    } finally {
+      calloc.free(nativeName);
+    }
+  }
+
+  /// Remove a named caption region
+  static bool removeCaptionRegion(int hwnd, String name) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        throw StateError('Native plugin not loaded.');
+      }
+    }
+
+    final removeFunc = _pluginLib!.lookupFunction<
+        Bool Function(IntPtr hwnd, Pointer<Utf8> name),
+        bool Function(int hwnd, Pointer<Utf8> name)>('RemoveCaptionRegion');
+
+    final nativeName = name.toNativeUtf8();
+    try {
+      return removeFunc(hwnd, nativeName);
+    } finally {
+      calloc.free(nativeName);
+    }
+  }
+
+  /// Remove all named caption regions
+  static void clearCaptionRegions(int hwnd) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        throw StateError('Native plugin not loaded.');
+      }
+    }
+
+    final clearFunc = _pluginLib!.lookupFunction<
+        Void Function(IntPtr hwnd),
+        void Function(int hwnd)>('ClearCaptionRegions');
+
+    clearFunc(hwnd);
+  }
+
+  /// Set the caption mask from run-length encoded rows
+  /// [width] and [height] are in logical pixels
+  /// Returns false if the mask was rejected (bad size or malformed runs)
+  static bool setCaptionMask(int hwnd, int width, int height, Uint16List runs) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        throw StateError('Native plugin not loaded.');
+      }
+    }
+
+    final setMaskFunc = _pluginLib!.lookupFunction<
+        Bool Function(IntPtr hwnd, Int32 width, Int32 height, Pointer<Uint16> runs, Int32 length),
+        bool Function(int hwnd, int width, int height, Pointer<Uint16> runs, int length)>('SetCaptionMask');
+
+    final nativeRuns = _copyRuns(runs);
+    try {
+      return setMaskFunc(hwnd, width, height, nativeRuns, runs.length);
+    } finally {
+      calloc.free(nativeRuns);
+    }
+  }
+
+  /// Replace rows [firstRow, firstRow + rowCount) of the caption mask
+  /// Returns false if there is no mask or the rows were rejected
+  static bool updateCaptionMaskRows(int hwnd, int firstRow, int rowCount, Uint16List runs) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        throw StateError('Native plugin not loaded.');
+      }
+    }
+
+    final updateRowsFunc = _pluginLib!.lookupFunction<
+        Bool Function(IntPtr hwnd, Int32 firstRow, Int32 rowCount, Pointer<Uint16> runs, Int32 length),
+        bool Function(int hwnd, int firstRow, int rowCount, Pointer<Uint16> runs, int length)>('UpdateCaptionMaskRows');
+
+    final nativeRuns = _copyRuns(runs);
+    try {
+      return updateRowsFunc(hwnd, firstRow, rowCount, nativeRuns, runs.length);
+    } finally {
+      calloc.free(nativeRuns);
+    }
+  }
+
+  /// Remove the caption mask
+  static void clearCaptionMask(int hwnd) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        throw StateError('Native plugin not loaded.');
+      }
+    }
+
+    final clearFunc = _pluginLib!.lookupFunction<
+        Void Function(IntPtr hwnd),
+        void Function(int hwnd)>('ClearCaptionMask');
+
+    clearFunc(hwnd);
+  }
+
+  static Pointer<Uint16> _copyRuns(Uint16List runs) {
+    final nativeRuns = calloc<Uint16>(runs.isEmpty ? 1 : runs.length);
+    nativeRuns.asTypedList(runs.length).setAll(0, runs);
+    return nativeRuns;
+  }
+
   /// Set the caption height (the draggable area at the top of the window)
   /// [height] is in logical pixels (will be scaled for DPI)
   static void setCaptionHeight(int hwnd, int height) {
@@ -484,21 +628,560 @@ class Win32Bindings {
     return isEnabledFunc(hwnd);
   }
 
+  /// PlatformCapabilities.flags (window_decoration_core)
+  static const int CAPABILITY_WINDOW_DPI = 1 << 0;
+  static const int CAPABILITY_DPI_SYSTEM_METRICS = 1 << 1;
+  static const int CAPABILITY_MONITOR_DPI = 1 << 2;
+  static const int CAPABILITY_WINDOWS_11 = 1 << 3;
+  static const int CAPABILITY_COMPOSITOR = 1 << 4;
+
+  static Pointer<PlatformCapabilitiesStruct>? _capabilities;
+
+  /// The plugin's capability probe: optional DPI APIs, OS version and DWM
+  /// composition, probed once per process. Looked up once; the struct
+  /// lives as long as the process
+  /// Returns null if the plugin library isn't available
+  static Pointer<PlatformCapabilitiesStruct>? getPlatformCapabilities() {
+    if (_capabilities != null) {
+      return _capabilities;
+    }
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        return null;
+      }
+    }
+
+    final getFunc = _pluginLib!.lookupFunction<
+        Pointer<PlatformCapabilitiesStruct> Function(),
+        Pointer<PlatformCapabilitiesStruct> Function()>('GetPlatformCapabilities');
+
+    return _capabilities = getFunc();
+  }
+
   /// Check if running on Windows 11
   static bool isWindows11() {
+    final capabilities = getPlatformCapabilities();
+    return capabilities != null && (capabilities.ref.flags & CAPABILITY_WINDOWS_11) != 0;
+  }
+
+  /// Get the frame geometry cache counters for a window
+  /// Returns null if the window is not managed by the plugin
+  static FrameCacheStats? getFrameCacheStats(int hwnd) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        return null;
+      }
+    }
+
+    final getStatsFunc = _pluginLib!.lookupFunction<
+        Bool Function(IntPtr hwnd, Pointer<FrameCacheStatsStruct> stats),
+        bool Function(int hwnd, Pointer<FrameCacheStatsStruct> stats)>('GetFrameCacheStats');
+
+    final stats = calloc<FrameCacheStatsStruct>();
+    try {
+      if (!getStatsFunc(hwnd, stats)) {
+        return null;
+      }
+      return (
+        lookups: stats.ref.lookups,
+        metricsRefreshes: stats.ref.metricsRefreshes,
+        placementRefreshes: stats.ref.placementRefreshes,
+      );
+    } finally {
+      calloc.free(stats);
+    }
+  }
+
+  /// Get the mouse-move memo counters for a window
+  /// Returns null if the window is not managed by the plugin
+  static HoverStats? getHoverStats(int hwnd) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        return null;
+      }
+    }
+
+    final getStatsFunc = _pluginLib!.lookupFunction<
+        Bool Function(IntPtr hwnd, Pointer<HoverStatsStruct> stats),
+        bool Function(int hwnd, Pointer<HoverStatsStruct> stats)>('GetHoverStats');
+
+    final stats = calloc<HoverStatsStruct>();
+    try {
+      if (!getStatsFunc(hwnd, stats)) {
+        return null;
+      }
+      return (
+        memoHits: stats.ref.memoHits,
+        evaluations: stats.ref.evaluations,
+        cursorChanges: stats.ref.cursorChanges,
+      );
+    } finally {
+      calloc.free(stats);
+    }
+  }
+
+  /// Animate a window to [bounds] and/or [opacity] over [duration], stepped
+  /// natively once per DWM composition pass (see window_animation.h). When
+  /// the animation ends, 1 (target reached) or 0 (replaced, cancelled or
+  /// window destroyed) is posted to native port [port].
+  /// Returns false if the window is invalid or neither [bounds] nor
+  /// [opacity] is given
+  static bool animateWindow(
+    int hwnd, {
+    WindowBounds? bounds,
+    double? opacity,
+    required Duration duration,
+    required int curve,
+    required int port,
+  }) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        throw StateError('Native plugin not loaded.');
+      }
+    }
+
+    final animateFunc = _pluginLib!.lookupFunction<
+        Bool Function(IntPtr hwnd, Pointer<WindowAnimationParamsStruct> params, Pointer<Void> postCObject, Int64 port),
+        bool Function(int hwnd, Pointer<WindowAnimationParamsStruct> params, Pointer<Void> postCObject,
+            int port)>('AnimateWindow');
+
+    final params = calloc<WindowAnimationParamsStruct>();
+    try {
+      if (bounds != null) {
+        params.ref.bounds.left = bounds.x.toInt();
+        params.ref.bounds.top = bounds.y.toInt();
+        params.ref.bounds.right = (bounds.x + bounds.width).toInt();
+        params.ref.bounds.bottom = (bounds.y + bounds.height).toInt();
+        params.ref.properties |= _ANIMATE_BOUNDS;
+      }
+      if (opacity != null) {
+        params.ref.opacity = opacity.clamp(0.0, 1.0);
+        params.ref.properties |= _ANIMATE_OPACITY;
+      }
+      params.ref.durationNs = duration.inMicroseconds * 1000;
+      params.ref.curve = curve;
+      return animateFunc(hwnd, params, NativeApi.postCObject.cast<Void>(), port);
+    } finally {
+      calloc.free(params);
+    }
+  }
+
+  /// Stop a window's animation where it is
+  /// Returns false if no animation was running
+  static bool cancelWindowAnimation(int hwnd) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        throw StateError('Native plugin not loaded.');
+      }
+    }
+
+    final cancelFunc = _pluginLib!.lookupFunction<
+        Bool Function(IntPtr hwnd),
+        bool Function(int hwnd)>('CancelWindowAnimation');
+
+    return cancelFunc(hwnd);
+  }
+
+  /// Get the animation counters for a window
+  /// Returns null if the window was never animated
+  static WindowAnimationStats? getWindowAnimationStats(int hwnd) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        return null;
+      }
+    }
+
+    final getStatsFunc = _pluginLib!.lookupFunction<
+        Bool Function(IntPtr hwnd, Pointer<WindowAnimationStatsStruct> stats),
+        bool Function(int hwnd, Pointer<WindowAnimationStatsStruct> stats)>('GetWindowAnimationStats');
+
+    final stats = calloc<WindowAnimationStatsStruct>();
+    try {
+      if (!getStatsFunc(hwnd, stats)) {
+        return null;
+      }
+      return (
+        started: stats.ref.started,
+        completed: stats.ref.completed,
+        cancelled: stats.ref.cancelled,
+        frames: stats.ref.frames,
+        droppedFrames: stats.ref.droppedFrames,
+      );
+    } finally {
+      calloc.free(stats);
+    }
+  }
+
+  // WindowAnimationParams.properties (window_decoration_core)
+  static const int _ANIMATE_BOUNDS = 1 << 0;
+  static const int _ANIMATE_OPACITY = 1 << 1;
+
+  /// Get the process-wide cursor cache counters
+  static CursorCacheStats? getCursorCacheStats() {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        return null;
+      }
+    }
+
+    final getStatsFunc = _pluginLib!.lookupFunction<
+        Bool Function(Pointer<CursorCacheStatsStruct> stats),
+        bool Function(Pointer<CursorCacheStatsStruct> stats)>('GetCursorCacheStats');
+
+    final stats = calloc<CursorCacheStatsStruct>();
+    try {
+      if (!getStatsFunc(stats)) {
+        return null;
+      }
+      return (
+        hits: stats.ref.hits,
+        loads: stats.ref.loads,
+      );
+    } finally {
+      calloc.free(stats);
+    }
+  }
+
+  /// Choose how windows enabled from now on are intercepted for resize
+  /// border handling: 0 = one message hook per UI thread, 1 = a subclass on
+  /// the window's Flutter view only
+  static bool setMessageInterceptionMode(int mode) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        throw StateError('Native plugin not loaded.');
+      }
+    }
+
+    final setFunc = _pluginLib!.lookupFunction<
+        Bool Function(Int32 mode),
+        bool Function(int mode)>('SetMessageInterceptionMode');
+
+    return setFunc(mode);
+  }
+
+  /// Open the shared window registry [name], creating it if no cooperating
+  /// process has yet. Windows of this process are published there from now
+  /// on. Returns false if the registry could not be opened.
+  static bool openSharedWindowRegistry(String name) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        throw StateError('Native plugin not loaded.');
+      }
+    }
+
+    final openFunc = _pluginLib!.lookupFunction<
+        Bool Function(Pointer<Utf16> name),
+        bool Function(Pointer<Utf16> name)>('OpenSharedWindowRegistry');
+
+    final nativeName = name.toNativeUtf16();
+    try {
+      return openFunc(nativeName);
+    } finally {
+      calloc.free(nativeName);
+    }
+  }
+
+  /// Read the windows every process has published to the shared registry
+  /// Returns null if the registry has not been opened
+  static List<SharedWindow>? readSharedWindows({int capacity = 256}) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        return null;
+      }
+    }
+
+    final readFunc = _pluginLib!.lookupFunction<
+        Int32 Function(Pointer<SharedWindowInfoStruct> windows, Int32 capacity),
+        int Function(Pointer<SharedWindowInfoStruct> windows, int capacity)>('ReadSharedWindows');
+
+    final windows = calloc<SharedWindowInfoStruct>(capacity);
+    try {
+      final count = readFunc(windows, capacity);
+      if (count < 0) {
+        return null;
+      }
+      return [
+        for (var i = 0; i < count; i++) _toSharedWindow(windows[i]),
+      ];
+    } finally {
+      calloc.free(windows);
+    }
+  }
+
+  static SharedWindow _toSharedWindow(SharedWindowInfoStruct info) {
+    return (
+      window: info.window,
+      processId: info.processId,
+      frameMode: info.frameMode,
+      left: info.left,
+      top: info.top,
+      right: info.right,
+      bottom: info.bottom,
+      dpi: info.dpi,
+      captionHeight: info.captionHeight,
+      captionRegions: [
+        for (var i = 0; i < info.regionCount; i++)
+          (
+            left: info.regions[i].left,
+            top: info.regions[i].top,
+            right: info.regions[i].right,
+            bottom: info.regions[i].bottom,
+            hit: info.regions[i].hit,
+          ),
+      ],
+    );
+  }
+
+  /// Placement modes of PlaceWindow (window_decoration_core PlacementMode)
+  static const int PLACEMENT_CENTER = 0;
+  static const int PLACEMENT_CLAMP_TO_WORK_AREA = 1;
+  static const int PLACEMENT_CASCADE = 2;
+
+  /// Place a window from the plugin's cached monitor topology: center it in
+  /// its monitor's work area, move it into the work area, or cascade it
+  /// from [anchor]
+  /// Returns false if the window couldn't be placed
+  static bool placeWindow(int hwnd, int mode, {int anchor = 0}) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        throw StateError('Native plugin not loaded.');
+      }
+    }
+
+    final placeFunc = _pluginLib!.lookupFunction<
+        Bool Function(IntPtr hwnd, Int32 mode, IntPtr anchor),
+        bool Function(int hwnd, int mode, int anchor)>('PlaceWindow');
+
+    return placeFunc(hwnd, mode, anchor);
+  }
+
+  /// WindowLayout.flags (window_decoration_core)
+  static const int WINDOW_LAYOUT_MAXIMIZED = 1 << 0;
+  static const int WINDOW_LAYOUT_FULLSCREEN = 1 << 1;
+
+  /// Open the window layout store at [path], saving the pending changes of
+  /// an open one first. A missing file is an empty store.
+  /// Returns false if the file can't be read or isn't a layout file
+  static bool openWindowLayoutStore(String path) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        throw StateError('Native plugin not loaded.');
+      }
+    }
+
+    final openFunc = _pluginLib!.lookupFunction<
+        Bool Function(Pointer<Utf16> path),
+        bool Function(Pointer<Utf16> path)>('OpenWindowLayoutStore');
+
+    final nativePath = path.toNativeUtf16();
+    try {
+      return openFunc(nativePath);
+    } finally {
+      calloc.free(nativePath);
+    }
+  }
+
+  /// Place a window from the layout saved under [id] and keep saving its
+  /// layout from now on. [restore] is 1 if it was placed as it was left, 2
+  /// if it was moved onto another monitor, 0 if nothing was saved under
+  /// [id]; [flags] are the layout's WINDOW_LAYOUT_* flags.
+  static ({int restore, int flags}) restoreWindowLayout(int hwnd, String id) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        throw StateError('Native plugin not loaded.');
+      }
+    }
+
+    final restoreFunc = _pluginLib!.lookupFunction<
+        Int32 Function(IntPtr hwnd, Pointer<Utf8> id, Pointer<WindowLayoutStruct> layout),
+        int Function(int hwnd, Pointer<Utf8> id, Pointer<WindowLayoutStruct> layout)>('RestoreWindowLayout');
+
+    final nativeId = id.toNativeUtf8();
+    final layout = calloc<WindowLayoutStruct>();
+    try {
+      final restore = restoreFunc(hwnd, nativeId, layout);
+      return (restore: restore, flags: restore != 0 ? layout.ref.flags : 0);
+    } finally {
+      calloc.free(nativeId);
+      calloc.free(layout);
+    }
+  }
+
+  /// Write pending layout changes now instead of after the save delay
+  /// Returns false if writing failed
+  static bool flushWindowLayouts() {
     if (_pluginLib == null) {
       if (!tryAutoInitializePlugin()) {
         return false;
       }
     }
 
-    final isWin11Func = _pluginLib!.lookupFunction<
+    final flushFunc = _pluginLib!.lookupFunction<
         Bool Function(),
-        bool Function()>('IsWindows11');
+        bool Function()>('FlushWindowLayouts');
 
-    return isWin11Func();
+    return flushFunc();
   }
 
+  /// InitialDecoration.flags (window_decoration_core)
+  static const int INITIAL_DECORATION_HAS_BOUNDS = 1 << 0;
+  static const int INITIAL_DECORATION_CENTERED = 1 << 1;
+  static const int INITIAL_DECORATION_HAS_BACKGROUND = 1 << 2;
+  static const int INITIAL_DECORATION_ALWAYS_ON_TOP = 1 << 3;
+
+  /// The decoration the runner applied to a window with
+  /// ApplyInitialDecoration before it was shown, null if none
+  static InitialDecorationInfo? getInitialDecoration(int hwnd) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        return null;
+      }
+    }
+
+    final getFunc = _pluginLib!.lookupFunction<
+        Bool Function(IntPtr hwnd, Pointer<InitialDecorationStruct> decoration),
+        bool Function(int hwnd, Pointer<InitialDecorationStruct> decoration)>('GetInitialDecoration');
+
+    final decoration = calloc<InitialDecorationStruct>();
+    try {
+      if (!getFunc(hwnd, decoration)) {
+        return null;
+      }
+      return (
+        flags: decoration.ref.flags,
+        frameMode: decoration.ref.frameMode,
+        captionHeight: decoration.ref.captionHeight,
+        backgroundColor: decoration.ref.backgroundColor,
+        left: decoration.ref.bounds.left,
+        top: decoration.ref.bounds.top,
+        right: decoration.ref.bounds.right,
+        bottom: decoration.ref.bounds.bottom,
+      );
+    } finally {
+      calloc.free(decoration);
+    }
+  }
+
+  // Looked up once: these are called often and must not allocate
+  static WindowStateInfoStruct Function(int hwnd)? _queryWindowState;
+  static int Function(int hwnd, int attribute, int value)? _setDwmAttributeUint32;
+
+  /// Get bounds, monitor, DPI, frame mode and show state of a window in one
+  /// leaf call, with nothing allocated on either side
+  /// Returns null if the plugin is not loaded or the window is gone
+  static WindowStateInfo? queryWindowState(int hwnd) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        return null;
+      }
+    }
+
+    final queryFunc = _queryWindowState ??= _pluginLib!.lookupFunction<
+        WindowStateInfoStruct Function(IntPtr hwnd),
+        WindowStateInfoStruct Function(int hwnd)>('QueryWindowState', isLeaf: true);
+
+    final info = queryFunc(hwnd);
+    if ((info.flags & WINDOW_STATE_VALID) == 0) {
+      return null;
+    }
+    return _toWindowStateInfo(info);
+  }
+
+  /// Get the window's native state block, kept current by the plugin from
+  /// the window's own messages. Read it with [readWindowStateBlock].
+  /// The block stays valid for the life of the process.
+  /// Returns null if the plugin is not loaded or the window is gone
+  static Pointer<WindowStateBlockStruct>? openWindowStateBlock(int hwnd) {
+    if (_pluginLib == null) {
+      if (!tryAutoInitializePlugin()) {
+        return null;
+      }
+    }
+
+    final openFunc = _pluginLib!.lookupFunction<
+        Pointer<WindowStateBlockStruct> Function(IntPtr hwnd),
+        Pointer<WindowStateBlockStruct> Function(int hwnd)>('OpenWindowStateBlock');
+
+    final block = openFunc(hwnd);
+    return block == nullptr ? null : block;
+  }
+
+  /// Read a consistent snapshot of a state block without any FFI call
+  /// (seqlock, see window_state_block.h)
+  /// Returns null if the block no longer describes hwnd (the window was
+  /// destroyed) or stayed mid-update for every attempt
+  static WindowStateInfo? readWindowStateBlock(Pointer<WindowStateBlockStruct> block, int hwnd) {
+    final ref = block.ref;
+    for (var attempt = 0; attempt < _STATE_BLOCK_READ_ATTEMPTS; attempt++) {
+      final start = ref.sequence;
+      if ((start & 1) != 0) {
+        continue;
+      }
+      // Nested struct fields are views into the block: copy every field
+      // out before checking the sequence again
+      final window = ref.window;
+      final flags = ref.info.flags;
+      final info = _toWindowStateInfo(ref.info);
+      if (ref.sequence == start) {
+        return window == hwnd && (flags & WINDOW_STATE_VALID) != 0 ? info : null;
+      }
+    }
+    return null;
+  }
+
+  static const int _STATE_BLOCK_READ_ATTEMPTS = 64;
+
+  static WindowStateInfo _toWindowStateInfo(WindowStateInfoStruct info) {
+    return WindowStateInfo(
+      bounds: _toBounds(info.bounds),
+      monitor: _toBounds(info.monitor),
+      workArea: _toBounds(info.workArea),
+      dpi: info.dpi,
+      frameMode: info.frameMode,
+      isVisible: (info.flags & WINDOW_STATE_VISIBLE) != 0,
+      isFocused: (info.flags & WINDOW_STATE_FOCUSED) != 0,
+      isMaximized: (info.flags & WINDOW_STATE_MAXIMIZED) != 0,
+      isMinimized: (info.flags & WINDOW_STATE_MINIMIZED) != 0,
+      isFullScreen: (info.flags & WINDOW_STATE_FULLSCREEN) != 0,
+    );
+  }
+
+  static WindowBounds _toBounds(RECT rect) {
+    return WindowBounds(
+      x: rect.left.toDouble(),
+      y: rect.top.toDouble(),
+      width: (rect.right - rect.left).toDouble(),
+      height: (rect.bottom - rect.top).toDouble(),
+    );
+  }
+
+  /// Set a 32-bit DWM window attribute by value
+  /// Goes through the plugin (no buffer to allocate) when it is loaded
+  static int setDwmAttributeUint32(int hwnd, int attribute, int value) {
+    if (_pluginLib != null || tryAutoInitializePlugin()) {
+      final setFunc = _setDwmAttributeUint32 ??= _pluginLib!.lookupFunction<
+          Int32 Function(IntPtr hwnd, Uint32 attribute, Uint32 value),
+          int Function(int hwnd, int attribute, int value)>('SetDwmAttributeUint32', isLeaf: true);
+      return setFunc(hwnd, attribute, value);
+    }
+
+    final buffer = calloc<Uint32>();
+    try {
+      buffer.value = value;
+      return dwmSetWindowAttribute(hwnd, attribute, buffer.cast(), sizeOf<Uint32>());
+    } finally {
+      calloc.free(buffer);
+    }
+  }
+
+  /// WindowStateInfo.flags (window_decoration_core)
+  static const int WINDOW_STATE_VALID = 1 << 0;
+  static const int WINDOW_STATE_VISIBLE = 1 << 1;
+  static const int WINDOW_STATE_FOCUSED = 1 << 2;
+  static const int WINDOW_STATE_MAXIMIZED = 1 << 3;
+  static const int WINDOW_STATE_MINIMIZED = 1 << 4;
+  static const int WINDOW_STATE_FULLSCREEN = 1 << 5;
+
   /// Start window resize from a specific edge
   /// edge: 0=left, 1=right, 2=top, 3=bottom, 4=topLeft, 5=topRight, 6=bottomLeft, 7=bottomRight
   static void startResize(int hwnd, int edge) {
@@ -546,10 +1229,300 @@ class Win32Bindings {
   }
 }
 
+/// Frame geometry cache counters (see [Win32Bindings.getFrameCacheStats])
+typedef FrameCacheStats = ({
+  int lookups,
+  int metricsRefreshes,
+  int placementRefreshes,
+});
+
+/// Mouse-move memo counters (see [Win32Bindings.getHoverStats])
+typedef HoverStats = ({
+  int memoHits,
+  int evaluations,
+  int cursorChanges,
+});
+
+/// Window animation counters (see [Win32Bindings.getWindowAnimationStats])
+typedef WindowAnimationStats = ({
+  int started,
+  int completed,
+  int cancelled,
+  int frames,
+  int droppedFrames,
+});
+
+/// The runner's initial decoration (see [Win32Bindings.getInitialDecoration]);
+/// bounds are in physical screen pixels
+typedef InitialDecorationInfo = ({
+  int flags,
+  int frameMode,
+  int captionHeight,
+  int backgroundColor,
+  int left,
+  int top,
+  int right,
+  int bottom,
+});
+
+/// Cursor cache counters (see [Win32Bindings.getCursorCacheStats])
+typedef CursorCacheStats = ({
+  int hits,
+  int loads,
+});
+
+/// A caption region of a window in the shared registry (client coordinates)
+typedef SharedCaptionRegion = ({
+  int left,
+  int top,
+  int right,
+  int bottom,
+  int hit,
+});
+
+/// A window published to the shared registry by this or another process
+/// (see [Win32Bindings.readSharedWindows]). Bounds are in screen
+/// coordinates.
+typedef SharedWindow = ({
+  int window,
+  int processId,
+  int frameMode,
+  int left,
+  int top,
+  int right,
+  int bottom,
+  int dpi,
+  int captionHeight,
+  List<SharedCaptionRegion> captionRegions,
+});
+
 // ==========================================================================
 // Windows Structures
 // ==========================================================================
 
+/// WindowStateBlock structure (window_decoration_core), read in place
+final class WindowStateBlockStruct extends Struct {
+  @Uint32()
+  external int sequence;
+
+  @Uint32()
+  external int reserved;
+
+  @Uint64()
+  external int window;
+
+  external WindowStateInfoStruct info;
+}
+
+/// WindowStateInfo structure (window_decoration_core), returned by value
+final class WindowStateInfoStruct extends Struct {
+  external RECT bounds;
+
+  external RECT monitor;
+
+  external RECT workArea;
+
+  @Uint32()
+  external int dpi;
+
+  @Int32()
+  external int frameMode;
+
+  @Uint32()
+  external int flags;
+
+  @Uint32()
+  external int reserved;
+}
+
+/// CursorCacheStats structure (window_decoration_core)
+final class CursorCacheStatsStruct extends Struct {
+  @Uint64()
+  external int hits;
+
+  @Uint64()
+  external int loads;
+}
+
+/// SharedCaptionRegion structure (window_decoration_core)
+final class SharedCaptionRegionStruct extends Struct {
+  @Int32()
+  external int left;
+
+  @Int32()
+  external int top;
+
+  @Int32()
+  external int right;
+
+  @Int32()
+  external int bottom;
+
+  @Int32()
+  external int hit;
+}
+
+/// SharedWindowInfo structure (window_decoration_core)
+final class SharedWindowInfoStruct extends Struct {
+  @Uint64()
+  external int window;
+
+  @Uint32()
+  external int processId;
+
+  @Int32()
+  external int frameMode;
+
+  @Int32()
+  external int left;
+
+  @Int32()
+  external int top;
+
+  @Int32()
+  external int right;
+
+  @Int32()
+  external int bottom;
+
+  @Uint32()
+  external int dpi;
+
+  @Int32()
+  external int captionHeight;
+
+  @Uint32()
+  external int regionCount;
+
+  @Uint32()
+  external int reserved;
+
+  @Array(16)
+  external Array<SharedCaptionRegionStruct> regions;
+}
+
+/// HoverStats structure (window_decoration_core)
+final class HoverStatsStruct extends Struct {
+  @Uint64()
+  external int memoHits;
+
+  @Uint64()
+  external int evaluations;
+
+  @Uint64()
+  external int cursorChanges;
+}
+
+/// WindowAnimationParams structure (window_decoration_core)
+final class WindowAnimationParamsStruct extends Struct {
+  external RECT bounds;
+
+  @Double()
+  external double opacity;
+
+  @Int64()
+  external int durationNs;
+
+  @Int32()
+  external int curve;
+
+  @Uint32()
+  external int properties;
+}
+
+/// WindowAnimationStats structure (window_decoration_core)
+final class WindowAnimationStatsStruct extends Struct {
+  @Uint64()
+  external int started;
+
+  @Uint64()
+  external int completed;
+
+  @Uint64()
+  external int cancelled;
+
+  @Uint64()
+  external int frames;
+
+  @Uint64()
+  external int droppedFrames;
+}
+
+/// PlatformCapabilities structure (window_decoration_core)
+final class PlatformCapabilitiesStruct extends Struct {
+  @Uint32()
+  external int flags;
+
+  @Uint32()
+  external int netWmAtoms;
+
+  @Uint32()
+  external int osMajor;
+
+  @Uint32()
+  external int osMinor;
+
+  @Uint32()
+  external int osBuild;
+
+  @Uint32()
+  external int toolkitMajor;
+
+  @Uint32()
+  external int toolkitMinor;
+
+  @Uint32()
+  external int toolkitMicro;
+
+  external Pointer<Void> functions;
+
+  @Uint64()
+  external int functionsSize;
+}
+
+/// InitialDecoration structure (window_decoration_core)
+final class InitialDecorationStruct extends Struct {
+  @Uint32()
+  external int flags;
+
+  @Int32()
+  external int frameMode;
+
+  @Uint32()
+  external int captionHeight;
+
+  @Uint32()
+  external int backgroundColor;
+
+  external RECT bounds;
+}
+
+/// WindowLayout structure (window_decoration_core)
+final class WindowLayoutStruct extends Struct {
+  external RECT bounds;
+
+  @Uint64()
+  external int monitor;
+
+  @Uint32()
+  external int flags;
+
+  @Int32()
+  external int frameMode;
+}
+
+/// FrameCacheStats structure (window_decoration_core)
+final class FrameCacheStatsStruct extends Struct {
+  @Uint64()
+  external int lookups;
+
+  @Uint64()
+  external int metricsRefreshes;
+
+  @Uint64()
+  external int placementRefreshes;
+}
+
 /// RECT structure
 final class RECT extends Struct {
   @Int32()
@@ -1,4 +1,6 @@
 import 'dart:ffi';
+import 'dart:isolate';
+import 'dart:typed_data';
 
 import 'package:ffi/ffi.dart';
 import 'package:flutter/material.dart';
@@ -15,6 +17,9 @@ class WindowDecorationWindows extends WindowDecorationPlatform {
   /// Whether the platform has been initialized
   bool _isInitialized = false;
 
+  /// Native state block of the window, opened on first read
+  Pointer<WindowStateBlockStruct>? _stateBlock;
+
   /// Registers this class as the default instance of [WindowDecorationPlatform]
   static void registerWith() {
     WindowDecorationPlatform.instance = WindowDecorationWindows();
@@ -35,6 +40,20 @@ class WindowDecorationWindows extends WindowDecorationPlatform {
     }
   }
 
+  /// Current window state, read from the native state block without an
+  /// FFI call once it is open. Falls back to one QueryWindowState leaf
+  /// call if the block can't be opened or read.
+  WindowStateInfo? _readWindowState() {
+    final block = _stateBlock ??= Win32Bindings.openWindowStateBlock(_hwnd);
+    if (block != null) {
+      final state = Win32Bindings.readWindowStateBlock(block, _hwnd);
+      if (state != null) {
+        return state;
+      }
+    }
+    return Win32Bindings.queryWindowState(_hwnd);
+  }
+
   // ==========================================================================
   // Position & Size
   // ==========================================================================
@@ -43,6 +62,23 @@ class WindowDecorationWindows extends WindowDecorationPlatform {
   Future<void> center() async {
     _checkInitialized();
 
+    // Center in the work area of the window's monitor, without allocating
+    final state = _readWindowState();
+    if (state != null) {
+      final x = state.workArea.x + (state.workArea.width - state.bounds.width) ~/ 2;
+      final y = state.workArea.y + (state.workArea.height - state.bounds.height) ~/ 2;
+      Win32Bindings.setWindowPos(
+        _hwnd,
+        0,
+        x.toInt(),
+        y.toInt(),
+        0,
+        0,
+        Win32Bindings.SWP_NOSIZE | Win32Bindings.SWP_NOZORDER,
+      );
+      return;
+    }
+
     // Get current window rect
     final rect = calloc<RECT>();
     try {
@@ -78,10 +114,34 @@ class WindowDecorationWindows extends WindowDecorationPlatform {
     }
   }
 
+  /// Move the window (and shrink it if it doesn't fit) into the work area
+  /// of the monitor holding most of it.
+  ///
+  /// Returns false if the window couldn't be placed.
+  Future<bool> clampToWorkArea() async {
+    _checkInitialized();
+    return Win32Bindings.placeWindow(_hwnd, Win32Bindings.PLACEMENT_CLAMP_TO_WORK_AREA);
+  }
+
+  /// Place the window below and right of [anchorHwnd], by 32 pixels at the
+  /// monitor's DPI, starting over at the work area's top-left where it
+  /// would leave the anchor's work area.
+  ///
+  /// Returns false if the window couldn't be placed.
+  Future<bool> cascadeFrom(int anchorHwnd) async {
+    _checkInitialized();
+    return Win32Bindings.placeWindow(_hwnd, Win32Bindings.PLACEMENT_CASCADE, anchor: anchorHwnd);
+  }
+
   @override
   Future<WindowBounds> getBounds() async {
     _checkInitialized();
 
+    final state = _readWindowState();
+    if (state != null) {
+      return state.bounds;
+    }
+
     final rect = calloc<RECT>();
     try {
       Win32Bindings.getWindowRect(_hwnd, rect);
@@ -97,6 +157,19 @@ class WindowDecorationWindows extends WindowDecorationPlatform {
     }
   }
 
+  /// Bounds, monitor, DPI, frame mode and show state, read from the
+  /// native state block with no FFI call, cheap enough to poll every frame
+  @override
+  Future<WindowStateInfo> getWindowState() async {
+    _checkInitialized();
+
+    final state = _readWindowState();
+    if (state == null) {
+      throw StateError('Native plugin not loaded or the window is gone.');
+    }
+    return state;
+  }
+
   @override
   Future<void> setBounds(WindowBounds bounds) async {
     _checkInitialized();
@@ -112,6 +185,95 @@ class WindowDecorationWindows extends WindowDecorationPlatform {
     );
   }
 
+  /// Bounds are stepped on the window's thread once per DWM composition
+  /// pass with one `SetWindowPos` per frame; opacity goes through
+  /// `SetLayeredWindowAttributes`, like [setOpacity]. A hidden window jumps
+  /// to the target.
+  @override
+  Future<bool> animateWindow({
+    WindowBounds? bounds,
+    double? opacity,
+    required Duration duration,
+    WindowAnimationCurve curve = WindowAnimationCurve.easeInOut,
+  }) async {
+    _checkInitialized();
+
+    final port = ReceivePort('window_decoration animation');
+    final started = Win32Bindings.animateWindow(
+      _hwnd,
+      bounds: bounds,
+      opacity: opacity,
+      duration: duration,
+      curve: curve.value,
+      port: port.sendPort.nativePort,
+    );
+    if (!started) {
+      port.close();
+      return false;
+    }
+
+    // Closes the port after the one message
+    final result = await port.first;
+    return result == 1;
+  }
+
+  @override
+  Future<void> cancelWindowAnimation() async {
+    _checkInitialized();
+    Win32Bindings.cancelWindowAnimation(_hwnd);
+  }
+
+  @override
+  Future<bool> openWindowLayoutStore(String path) async {
+    return Win32Bindings.openWindowLayoutStore(path);
+  }
+
+  /// The window is placed natively with `SetWindowPos`; a window left
+  /// maximized is maximized as soon as it is shown. Fullscreen is kept by
+  /// this class, so it is applied here through [setFullScreen]. Layouts are
+  /// saved from `WM_WINDOWPOSCHANGED`.
+  @override
+  Future<WindowLayoutRestore> restoreWindowLayout(String id) async {
+    _checkInitialized();
+
+    final result = Win32Bindings.restoreWindowLayout(_hwnd, id);
+    if ((result.flags & Win32Bindings.WINDOW_LAYOUT_FULLSCREEN) != 0) {
+      await setFullScreen(fullScreen: true);
+    }
+    return WindowLayoutRestore.fromValue(result.restore);
+  }
+
+  @override
+  Future<bool> flushWindowLayouts() async {
+    return Win32Bindings.flushWindowLayouts();
+  }
+
+  @override
+  Future<InitialDecoration?> getInitialDecoration() async {
+    _checkInitialized();
+    final info = Win32Bindings.getInitialDecoration(_hwnd);
+    if (info == null) {
+      return null;
+    }
+    return InitialDecoration(
+      frameMode: info.frameMode,
+      captionHeight: info.captionHeight,
+      centered: (info.flags & Win32Bindings.INITIAL_DECORATION_CENTERED) != 0,
+      alwaysOnTop: (info.flags & Win32Bindings.INITIAL_DECORATION_ALWAYS_ON_TOP) != 0,
+      backgroundColor: (info.flags & Win32Bindings.INITIAL_DECORATION_HAS_BACKGROUND) != 0
+          ? Color(info.backgroundColor)
+          : null,
+      bounds: (info.flags & Win32Bindings.INITIAL_DECORATION_HAS_BOUNDS) != 0
+          ? WindowBounds(
+              x: info.left.toDouble(),
+              y: info.top.toDouble(),
+              width: (info.right - info.left).toDouble(),
+              height: (info.bottom - info.top).toDouble(),
+            )
+          : null,
+    );
+  }
+
   // ==========================================================================
   // Appearance
   // ==========================================================================
@@ -123,23 +285,15 @@ class WindowDecorationWindows extends WindowDecorationPlatform {
     // Windows doesn't have a direct API to set window background color
     // This would typically be handled by the Flutter rendering layer
     // For now, we'll use DWM to set caption/border color
-    final colorValue = calloc<Uint32>();
-    try {
-      // Convert Flutter color to COLORREF (0x00BBGGRR)
-      final b = (color.b * 255.0).round().clamp(0, 255);
-      final g = (color.g * 255.0).round().clamp(0, 255);
-      final r = (color.r * 255.0).round().clamp(0, 255);
-      colorValue.value = (b << 16) | (g << 8) | r;
-
-      Win32Bindings.dwmSetWindowAttribute(
-        _hwnd,
-        Win32Bindings.DWMWA_CAPTION_COLOR,
-        colorValue.cast(),
-        sizeOf<Uint32>(),
-      );
-    } finally {
-      calloc.free(colorValue);
-    }
+    // Convert Flutter color to COLORREF (0x00BBGGRR)
+    final b = (color.b * 255.0).round().clamp(0, 255);
+    final g = (color.g * 255.0).round().clamp(0, 255);
+    final r = (color.r * 255.0).round().clamp(0, 255);
+    Win32Bindings.setDwmAttributeUint32(
+      _hwnd,
+      Win32Bindings.DWMWA_CAPTION_COLOR,
+      (b << 16) | (g << 8) | r,
+    );
   }
 
   @override
@@ -238,6 +392,23 @@ class WindowDecorationWindows extends WindowDecorationPlatform {
       Win32Bindings.getWindowPlacement(_hwnd, placement);
 
       if (fullScreen) {
+        // Cover the window's monitor, as cached by the plugin
+        final state = _readWindowState();
+        if (state != null) {
+          Win32Bindings.setWindowPos(
+            _hwnd,
+            0,
+            state.monitor.x.toInt(),
+            state.monitor.y.toInt(),
+            state.monitor.width.toInt(),
+            state.monitor.height.toInt(),
+            Win32Bindings.SWP_NOZORDER | Win32Bindings.SWP_FRAMECHANGED,
+          );
+          placement.ref.showCmd = Win32Bindings.SW_MAXIMIZE;
+          Win32Bindings.setWindowPlacement(_hwnd, placement);
+          return;
+        }
+
         // Get monitor info
         final monitor = Win32Bindings.monitorFromWindow(
           _hwnd,
@@ -407,61 +578,33 @@ class WindowDecorationWindows extends WindowDecorationPlatform {
     }
 
     // Set transparent/dark caption color (Windows 11)
-    final captionColor = calloc<Uint32>();
-    try {
-      // COLORREF format: 0x00BBGGRR (black with some transparency)
-      captionColor.value = 0x00000000;
-      Win32Bindings.dwmSetWindowAttribute(
-        _hwnd,
-        Win32Bindings.DWMWA_CAPTION_COLOR,
-        captionColor.cast(),
-        sizeOf<Uint32>(),
-      );
-    } finally {
-      calloc.free(captionColor);
-    }
+    // COLORREF format: 0x00BBGGRR (black with some transparency)
+    Win32Bindings.setDwmAttributeUint32(
+      _hwnd,
+      Win32Bindings.DWMWA_CAPTION_COLOR,
+      0x00000000,
+    );
 
     // Set text color to white for visibility
-    final textColor = calloc<Uint32>();
-    try {
-      textColor.value = 0x00FFFFFF; // White
-      Win32Bindings.dwmSetWindowAttribute(
-        _hwnd,
-        Win32Bindings.DWMWA_TEXT_COLOR,
-        textColor.cast(),
-        sizeOf<Uint32>(),
-      );
-    } finally {
-      calloc.free(textColor);
-    }
+    Win32Bindings.setDwmAttributeUint32(
+      _hwnd,
+      Win32Bindings.DWMWA_TEXT_COLOR,
+      0x00FFFFFF,
+    );
 
     // Enable dark mode
-    final darkMode = calloc<Uint32>();
-    try {
-      darkMode.value = 1;
-      Win32Bindings.dwmSetWindowAttribute(
-        _hwnd,
-        Win32Bindings.DWMWA_USE_IMMERSIVE_DARK_MODE,
-        darkMode.cast(),
-        sizeOf<Uint32>(),
-      );
-    } finally {
-      calloc.free(darkMode);
-    }
+    Win32Bindings.setDwmAttributeUint32(
+      _hwnd,
+      Win32Bindings.DWMWA_USE_IMMERSIVE_DARK_MODE,
+      1,
+    );
 
     // Apply Mica backdrop effect (Windows 11 22H2+)
-    final backdrop = calloc<Uint32>();
-    try {
-      backdrop.value = Win32Bindings.DWMSBT_MAINWINDOW;
-      Win32Bindings.dwmSetWindowAttribute(
-        _hwnd,
-        Win32Bindings.DWMWA_SYSTEMBACKDROP_TYPE,
-        backdrop.cast(),
-        sizeOf<Uint32>(),
-      );
-    } finally {
-      calloc.free(backdrop);
-    }
+    Win32Bindings.setDwmAttributeUint32(
+      _hwnd,
+      Win32Bindings.DWMWA_SYSTEMBACKDROP_TYPE,
+      Win32Bindings.DWMSBT_MAINWINDOW,
+    );
   }
 
   void _createUnifiedTitleBar() {
@@ -480,75 +623,40 @@ class WindowDecorationWindows extends WindowDecorationPlatform {
     }
 
     // Apply Mica backdrop for unified appearance (Windows 11)
-    final backdrop = calloc<Uint32>();
-    try {
-      backdrop.value = Win32Bindings.DWMSBT_MAINWINDOW;
-      Win32Bindings.dwmSetWindowAttribute(
-        _hwnd,
-        Win32Bindings.DWMWA_SYSTEMBACKDROP_TYPE,
-        backdrop.cast(),
-        sizeOf<Uint32>(),
-      );
-    } finally {
-      calloc.free(backdrop);
-    }
+    Win32Bindings.setDwmAttributeUint32(
+      _hwnd,
+      Win32Bindings.DWMWA_SYSTEMBACKDROP_TYPE,
+      Win32Bindings.DWMSBT_MAINWINDOW,
+    );
 
     // Enable rounded corners
-    final corners = calloc<Uint32>();
-    try {
-      corners.value = Win32Bindings.DWMWCP_ROUND;
-      Win32Bindings.dwmSetWindowAttribute(
-        _hwnd,
-        Win32Bindings.DWMWA_WINDOW_CORNER_PREFERENCE,
-        corners.cast(),
-        sizeOf<Uint32>(),
-      );
-    } finally {
-      calloc.free(corners);
-    }
+    Win32Bindings.setDwmAttributeUint32(
+      _hwnd,
+      Win32Bindings.DWMWA_WINDOW_CORNER_PREFERENCE,
+      Win32Bindings.DWMWCP_ROUND,
+    );
 
     // Use dark mode
-    final darkMode = calloc<Uint32>();
-    try {
-      darkMode.value = 1;
-      Win32Bindings.dwmSetWindowAttribute(
-        _hwnd,
-        Win32Bindings.DWMWA_USE_IMMERSIVE_DARK_MODE,
-        darkMode.cast(),
-        sizeOf<Uint32>(),
-      );
-    } finally {
-      calloc.free(darkMode);
-    }
+    Win32Bindings.setDwmAttributeUint32(
+      _hwnd,
+      Win32Bindings.DWMWA_USE_IMMERSIVE_DARK_MODE,
+      1,
+    );
 
     // Make caption color match the unified theme
-    final captionColor = calloc<Uint32>();
-    try {
-      // Dark gray for unified appearance
-      captionColor.value = 0x00202020;
-      Win32Bindings.dwmSetWindowAttribute(
-        _hwnd,
-        Win32Bindings.DWMWA_CAPTION_COLOR,
-        captionColor.cast(),
-        sizeOf<Uint32>(),
-      );
-    } finally {
-      calloc.free(captionColor);
-    }
+    // Dark gray for unified appearance
+    Win32Bindings.setDwmAttributeUint32(
+      _hwnd,
+      Win32Bindings.DWMWA_CAPTION_COLOR,
+      0x00202020,
+    );
 
     // Set border color to match
-    final borderColor = calloc<Uint32>();
-    try {
-      borderColor.value = 0x00404040;
-      Win32Bindings.dwmSetWindowAttribute(
-        _hwnd,
-        Win32Bindings.DWMWA_BORDER_COLOR,
-        borderColor.cast(),
-        sizeOf<Uint32>(),
-      );
-    } finally {
-      calloc.free(borderColor);
-    }
+    Win32Bindings.setDwmAttributeUint32(
+      _hwnd,
+      Win32Bindings.DWMWA_BORDER_COLOR,
+      0x00404040,
+    );
   }
 
   void _createCustomFrame(int captionHeight) {
@@ -582,18 +690,11 @@ class WindowDecorationWindows extends WindowDecorationPlatform {
     Win32Bindings.enableCustomFrameMode(_hwnd, captionHeight);
 
     // Enable rounded corners (Windows 11)
-    final corners = calloc<Uint32>();
-    try {
-      corners.value = Win32Bindings.DWMWCP_ROUND;
-      Win32Bindings.dwmSetWindowAttribute(
-        _hwnd,
-        Win32Bindings.DWMWA_WINDOW_CORNER_PREFERENCE,
-        corners.cast(),
-        sizeOf<Uint32>(),
-      );
-    } finally {
-      calloc.free(corners);
-    }
+    Win32Bindings.setDwmAttributeUint32(
+      _hwnd,
+      Win32Bindings.DWMWA_WINDOW_CORNER_PREFERENCE,
+      Win32Bindings.DWMWCP_ROUND,
+    );
   }
 
   // ==========================================================================
@@ -604,77 +705,48 @@ class WindowDecorationWindows extends WindowDecorationPlatform {
   Future<void> setSystemBackdrop(DWMSystemBackdropType backdrop) async {
     _checkInitialized();
 
-    final value = calloc<Uint32>();
-    try {
-      value.value = backdrop.value;
-      Win32Bindings.dwmSetWindowAttribute(
-        _hwnd,
-        Win32Bindings.DWMWA_SYSTEMBACKDROP_TYPE,
-        value.cast(),
-        sizeOf<Uint32>(),
-      );
-    } finally {
-      calloc.free(value);
-    }
+    Win32Bindings.setDwmAttributeUint32(
+      _hwnd,
+      Win32Bindings.DWMWA_SYSTEMBACKDROP_TYPE,
+      backdrop.value,
+    );
   }
 
   /// Set window corner preference (Windows 11 only)
   Future<void> setCornerPreference(WindowCornerPreference preference) async {
     _checkInitialized();
 
-    final value = calloc<Uint32>();
-    try {
-      value.value = preference.value;
-      Win32Bindings.dwmSetWindowAttribute(
-        _hwnd,
-        Win32Bindings.DWMWA_WINDOW_CORNER_PREFERENCE,
-        value.cast(),
-        sizeOf<Uint32>(),
-      );
-    } finally {
-      calloc.free(value);
-    }
+    Win32Bindings.setDwmAttributeUint32(
+      _hwnd,
+      Win32Bindings.DWMWA_WINDOW_CORNER_PREFERENCE,
+      preference.value,
+    );
   }
 
   /// Set border color (Windows 11 only)
   Future<void> setBorderColor(Color color) async {
     _checkInitialized();
 
-    final colorValue = calloc<Uint32>();
-    try {
-      // Convert Flutter color to COLORREF (0x00BBGGRR)
-      final b = (color.b * 255.0).round().clamp(0, 255);
-      final g = (color.g * 255.0).round().clamp(0, 255);
-      final r = (color.r * 255.0).round().clamp(0, 255);
-      colorValue.value = (b << 16) | (g << 8) | r;
-
-      Win32Bindings.dwmSetWindowAttribute(
-        _hwnd,
-        Win32Bindings.DWMWA_BORDER_COLOR,
-        colorValue.cast(),
-        sizeOf<Uint32>(),
-      );
-    } finally {
-      calloc.free(colorValue);
-    }
+    // Convert Flutter color to COLORREF (0x00BBGGRR)
+    final b = (color.b * 255.0).round().clamp(0, 255);
+    final g = (color.g * 255.0).round().clamp(0, 255);
+    final r = (color.r * 255.0).round().clamp(0, 255);
+    Win32Bindings.setDwmAttributeUint32(
+      _hwnd,
+      Win32Bindings.DWMWA_BORDER_COLOR,
+      (b << 16) | (g << 8) | r,
+    );
   }
 
   /// Enable dark mode (Windows 10 1809+)
   Future<void> setDarkMode({required bool enabled}) async {
     _checkInitialized();
 
-    final value = calloc<Uint32>();
-    try {
-      value.value = enabled ? 1 : 0;
-      Win32Bindings.dwmSetWindowAttribute(
-        _hwnd,
-        Win32Bindings.DWMWA_USE_IMMERSIVE_DARK_MODE,
-        value.cast(),
-        sizeOf<Uint32>(),
-      );
-    } finally {
-      calloc.free(value);
-    }
+    Win32Bindings.setDwmAttributeUint32(
+      _hwnd,
+      Win32Bindings.DWMWA_USE_IMMERSIVE_DARK_MODE,
+      enabled ? 1 : 0,
+    );
   }
 
   /// Check if window is always on top
@@ -755,6 +827,108 @@ class WindowDecorationWindows extends WindowDecorationPlatform {
     Win32Bindings.clearCaptionButtonZones(_hwnd);
   }
 
+  /// Register a named interactive region inside the caption area.
+  ///
+  /// Use this for title bar content other than the three caption buttons
+  /// (tabs, search boxes, menus, avatars) so clicking it doesn't start a
+  /// window drag. Any number of regions can be registered; calling this
+  /// again with the same [name] replaces that region. Regions registered
+  /// later are on top where they overlap.
+  ///
+  /// [rect] uses the same client area pixels as [setCaptionButtonZones].
+  /// A non-zero [cornerRadius] makes the region a rounded rectangle, e.g.
+  /// for pill-shaped tabs.
+  ///
+  /// Returns false if the region was rejected (empty rect or too many
+  /// regions).
+  ///
+  /// Example:
+  /// ```dart
+  /// windowDecoration.setCaptionRegion(
+  ///   'search',
+  ///   Rect.fromLTWH(400, 6, 320, 28),
+  ///   cornerRadius: 14,
+  /// );
+  /// ```
+  Future<bool> setCaptionRegion(
+    String name,
+    Rect rect, {
+    CaptionRegionHit hit = CaptionRegionHit.client,
+    double cornerRadius = 0,
+  }) async {
+    _checkInitialized();
+
+    return Win32Bindings.setCaptionRegion(
+      _hwnd,
+      name,
+      hit: hit.value,
+      left: rect.left.toInt(),
+      top: rect.top.toInt(),
+      right: rect.right.toInt(),
+      bottom: rect.bottom.toInt(),
+      cornerRadius: cornerRadius.toInt(),
+    );
+  }
+
+  /// Remove a caption region registered with [setCaptionRegion].
+  Future<bool> removeCaptionRegion(String name) async {
+    _checkInitialized();
+    return Win32Bindings.removeCaptionRegion(_hwnd, name);
+  }
+
+  /// Remove all caption regions registered with [setCaptionRegion].
+  Future<void> clearCaptionRegions() async {
+    _checkInitialized();
+    Win32Bindings.clearCaptionRegions(_hwnd);
+  }
+
+  /// Upload an interactive/draggable mask of the caption area.
+  ///
+  /// Use this when the title bar has shapes rectangles can't describe
+  /// (pill-shaped tabs, rounded buttons, overlapping widgets). Inside the
+  /// mask, interactive pixels behave like client area and the rest drags the
+  /// window. Caption buttons and regions registered with [setCaptionRegion]
+  /// take precedence over the mask.
+  ///
+  /// Returns false if the mask was rejected (bad size or malformed runs).
+  ///
+  /// Example:
+  /// ```dart
+  /// windowDecoration.setCaptionMask(CaptionMask.fromSpans(
+  ///   width: 1280,
+  ///   rows: List.generate(40, (y) => y >= 6 && y < 34 ? [(80, 200)] : []),
+  /// ));
+  /// ```
+  Future<bool> setCaptionMask(CaptionMask mask) async {
+    _checkInitialized();
+    return Win32Bindings.setCaptionMask(
+      _hwnd,
+      mask.width,
+      mask.height,
+      mask.runs,
+    );
+  }
+
+  /// Replace only the rows of the caption mask that changed.
+  ///
+  /// [runs] holds [rowCount] rows starting at [firstRow], encoded with
+  /// [CaptionMask.encodeRows]. Returns false if no mask is set or the rows
+  /// were rejected.
+  Future<bool> updateCaptionMaskRows(
+    int firstRow,
+    int rowCount,
+    Uint16List runs,
+  ) async {
+    _checkInitialized();
+    return Win32Bindings.updateCaptionMaskRows(_hwnd, firstRow, rowCount, runs);
+  }
+
+  /// Remove the mask set with [setCaptionMask].
+  Future<void> clearCaptionMask() async {
+    _checkInitialized();
+    Win32Bindings.clearCaptionMask(_hwnd);
+  }
+
   /// Set the caption height (the draggable area at the top of the window).
   ///
   /// This defines how tall the draggable caption area is. The value is in
@@ -783,6 +957,82 @@ class WindowDecorationWindows extends WindowDecorationPlatform {
     return Win32Bindings.getFrameMode(_hwnd);
   }
 
+  /// Get the native frame geometry cache counters for this window.
+  ///
+  /// Hit testing reads DPI, frame thickness, window rect and maximized state
+  /// from a per-window cache that is refreshed only on DPI, size, position
+  /// and settings changes. Lookups minus refreshes is the number of hit
+  /// tests served without any OS call. Returns null if the window has no
+  /// custom frame.
+  FrameCacheStats? getFrameCacheStats() {
+    _checkInitialized();
+    return Win32Bindings.getFrameCacheStats(_hwnd);
+  }
+
+  /// Get the native mouse-move memo counters for this window.
+  ///
+  /// Mouse moves that stay inside the last resolved resize border cell are
+  /// answered from a memo ([HoverStats.memoHits]) instead of a full hit test
+  /// ([HoverStats.evaluations]); the cursor is only changed on transitions
+  /// ([HoverStats.cursorChanges]). Returns null if the window has no custom
+  /// frame.
+  HoverStats? getHoverStats() {
+    _checkInitialized();
+    return Win32Bindings.getHoverStats(_hwnd);
+  }
+
+  /// Get the animation counters of [animateWindow]: animations started,
+  /// completed and cancelled, frames stepped and composition passes
+  /// dropped. Returns null if the window was never animated.
+  WindowAnimationStats? getWindowAnimationStats() {
+    _checkInitialized();
+    return Win32Bindings.getWindowAnimationStats(_hwnd);
+  }
+
+  /// Get the native cursor cache counters (shared by all windows).
+  ///
+  /// Resize and arrow cursors are loaded once per process
+  /// ([CursorCacheStats.loads]) and served from the cache afterwards
+  /// ([CursorCacheStats.hits]).
+  CursorCacheStats? getCursorCacheStats() {
+    return Win32Bindings.getCursorCacheStats();
+  }
+
+  /// Intercept only the managed window and its Flutter view instead of every
+  /// message of the UI thread.
+  ///
+  /// By default a message hook per UI thread finds resize border input for
+  /// custom-frame windows; it sees timers, paints and input for unrelated
+  /// windows too (which it rejects after one table lookup). With [enable]
+  /// the plugin subclasses the window's Flutter view instead, so other
+  /// windows are never touched. Applies to windows whose custom frame is
+  /// enabled after the call.
+  bool useScopedMessageInterception(bool enable) {
+    return Win32Bindings.setMessageInterceptionMode(enable ? 1 : 0);
+  }
+
+  // ==========================================================================
+  // Shared Window Registry (multi-process apps)
+  // ==========================================================================
+
+  /// Join the shared window registry [name].
+  ///
+  /// Cooperating processes that open the same name see each other's window
+  /// bounds, frame modes and caption regions through shared memory, without
+  /// IPC round trips. This process's custom-frame windows are published
+  /// there from now on and updated as they move, resize or change caption
+  /// regions. Returns false if the registry could not be opened.
+  bool openSharedWindowRegistry(String name) {
+    return Win32Bindings.openSharedWindowRegistry(name);
+  }
+
+  /// Get the windows published to the shared registry by every process,
+  /// including this one. Returns null if [openSharedWindowRegistry] has not
+  /// been called.
+  List<SharedWindow>? getSharedWindows() {
+    return Win32Bindings.readSharedWindows();
+  }
+
   // ==========================================================================
   // Resize and Drag APIs (for frameless windows)
   // ==========================================================================
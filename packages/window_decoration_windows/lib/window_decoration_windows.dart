@@ -1,4 +1,5 @@
 // Windows implementation of the window_decoration plugin
 
 export 'src/effects/dwm_effects.dart';
+export 'src/ffi/win32_bindings.dart' show CursorCacheStats, FrameCacheStats, HoverStats, SharedCaptionRegion, SharedWindow, WindowAnimationStats;
 export 'src/window_decoration_windows.dart';
@@ -0,0 +1,31 @@
+// Window Decoration Windows Plugin - runner API
+// Entry points an app's runner calls from C++ before Dart runs. Link the
+// runner against the plugin target:
+//
+//   target_link_libraries(${BINARY_NAME} PRIVATE window_decoration_windows_plugin)
+//
+// and decorate the window in FlutterWindow::OnCreate, before the Flutter
+// view controller is created at the client size:
+//
+//   window_decoration::InitialDecoration decoration = {};
+//   decoration.frameMode = static_cast<int32_t>(window_decoration::FrameMode::CustomFrame);
+//   decoration.captionHeight = 32;
+//   decoration.flags = window_decoration::INITIAL_DECORATION_HAS_BOUNDS |
+//                      window_decoration::INITIAL_DECORATION_CENTERED;
+//   decoration.bounds = { 0, 0, 1280, 720 };
+//   ApplyInitialDecoration(GetHandle(), &decoration);
+
+#ifndef WINDOW_DECORATION_WINDOWS_PLUGIN_H_
+#define WINDOW_DECORATION_WINDOWS_PLUGIN_H_
+
+#include <windows.h>
+
+#include "window_decoration_core/initial_decoration.h"
+
+// Apply an initial decoration (see initial_decoration.h) to a window that
+// isn't shown yet; bounds are in physical pixels. Returns false for an
+// invalid window or decoration.
+extern "C" __declspec(dllimport) bool ApplyInitialDecoration(HWND hwnd,
+                                                             const window_decoration::InitialDecoration* decoration);
+
+#endif  // WINDOW_DECORATION_WINDOWS_PLUGIN_H_
@@ -2,86 +2,281 @@
 // Native C++ implementation for frameless window support
 // Handles WM_NCCALCSIZE to remove the title bar while keeping window decorations
 // Handles WM_NCHITTEST for resize borders, custom caption, and snap layout support
+// Animates window bounds and opacity natively, paced by DWM composition
+// Restores windows from a memory-mapped layout file before they are shown
+// Lets runners decorate their window before it is first shown
+// Probes optional APIs, the OS version and DWM composition once per process
 
 #include <windows.h>
 #include <windowsx.h>  // For GET_X_LPARAM, GET_Y_LPARAM
 #include <dwmapi.h>
 #include <commctrl.h>
-#include <unordered_map>
 #include <VersionHelpers.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "window_decoration_core/caption_mask.h"
+#include "window_decoration_core/caption_regions.h"
+#include "window_decoration_core/caption_snapshot.h"
+#include "window_decoration_core/cursor_cache.h"
+#include "window_decoration_core/dart_port.h"
+#include "window_decoration_core/frame_geometry_cache.h"
+#include "window_decoration_core/hit_test.h"
+#include "window_decoration_core/hit_test_policy.h"
+#include "window_decoration_core/hover_memo.h"
+#include "window_decoration_core/initial_decoration.h"
+#include "window_decoration_core/message_filter.h"
+#include "window_decoration_core/monitor_topology.h"
+#include "window_decoration_core/platform_capabilities.h"
+#include "window_decoration_core/sharded_window_registry.h"
+#include "window_decoration_core/shared_window_registry.h"
+#include "window_decoration_core/window_animation.h"
+#include "window_decoration_core/window_layout_store.h"
+#include "window_decoration_core/window_placement.h"
+#include "window_decoration_core/window_state_block.h"
+#include "window_decoration_core/window_state_info.h"
+
 #pragma comment(lib, "dwmapi.lib")
 #pragma comment(lib, "comctl32.lib")
 
-// Frame mode determines how the window frame is handled
-enum class FrameMode {
-    Normal,      // Standard Windows frame with title bar
-    Hidden,      // Legacy hidden mode (borderless popup)
-    CustomFrame  // Windows 11 style: no title bar but keeps decorations
-};
+using window_decoration::ANIMATE_BOUNDS;
+using window_decoration::ANIMATE_OPACITY;
+using window_decoration::CAPABILITY_COMPOSITOR;
+using window_decoration::CAPABILITY_DPI_SYSTEM_METRICS;
+using window_decoration::CAPABILITY_MONITOR_DPI;
+using window_decoration::CAPABILITY_WINDOW_DPI;
+using window_decoration::CAPABILITY_WINDOWS_11;
+using window_decoration::CapabilityProbe;
+using window_decoration::CaptionPublisher;
+using window_decoration::CaptionRegion;
+using window_decoration::CaptionSnapshot;
+using window_decoration::CursorCache;
+using window_decoration::CursorCacheStats;
+using window_decoration::CursorShape;
+using window_decoration::DartPostCObjectFn;
+using window_decoration::DEFAULT_CAPTION_HEIGHT;
+using window_decoration::FrameCacheEvent;
+using window_decoration::FrameCacheStats;
+using window_decoration::FrameGeometry;
+using window_decoration::FrameGeometryCache;
+using window_decoration::FrameMetrics;
+using window_decoration::FrameMode;
+using window_decoration::FramePlacement;
+using window_decoration::HitCode;
+using window_decoration::HitTestFn;
+using window_decoration::HoverMemo;
+using window_decoration::HoverStats;
+using window_decoration::INITIAL_DECORATION_ALWAYS_ON_TOP;
+using window_decoration::INITIAL_DECORATION_CENTERED;
+using window_decoration::INITIAL_DECORATION_HAS_BACKGROUND;
+using window_decoration::INITIAL_DECORATION_HAS_BOUNDS;
+using window_decoration::InitialDecoration;
+using window_decoration::IsValidInitialDecoration;
+using window_decoration::InterceptionMode;
+using window_decoration::LayoutRestore;
+using window_decoration::MAX_WINDOW_LAYOUT_ID_BYTES;
+using window_decoration::MessageAction;
+using window_decoration::MessageFilter;
+using window_decoration::MONITOR_PRIMARY;
+using window_decoration::MonitorFingerprint;
+using window_decoration::MonitorInfo;
+using window_decoration::MonitorTopology;
+using window_decoration::PlacementMode;
+using window_decoration::PlatformCapabilities;
+using window_decoration::Rect;
+using window_decoration::RESIZE_BORDER_WIDTH;
+using window_decoration::ResizeCellFn;
+using window_decoration::ResolveWindowLayout;
+using window_decoration::ShardedWindowRegistry;
+using window_decoration::SharedWindowInfo;
+using window_decoration::SharedWindowRegistry;
+using window_decoration::SolvePlacement;
+using window_decoration::WINDOW_LAYOUT_FULLSCREEN;
+using window_decoration::WINDOW_LAYOUT_MAXIMIZED;
+using window_decoration::WINDOW_STATE_FOCUSED;
+using window_decoration::WINDOW_STATE_FULLSCREEN;
+using window_decoration::WINDOW_STATE_MAXIMIZED;
+using window_decoration::WINDOW_STATE_MINIMIZED;
+using window_decoration::WINDOW_STATE_VALID;
+using window_decoration::WINDOW_STATE_VISIBLE;
+using window_decoration::WindowAnimation;
+using window_decoration::WindowAnimationFrame;
+using window_decoration::WindowAnimationParams;
+using window_decoration::WindowAnimationStats;
+using window_decoration::WindowLayout;
+using window_decoration::WindowLayoutStore;
+using window_decoration::WindowStateBlock;
+using window_decoration::WindowStateBlockPool;
+using window_decoration::WindowStateInfo;
+using window_decoration::WindowStatePublisher;
+
+// Per-window state read on every message
+struct WindowState {
+    FrameMode frameMode;
 
-// Caption button type for hit testing
-enum class CaptionButton {
-    None = 0,
-    Minimize = 1,
-    Maximize = 2,
-    Close = 3
-};
+    // Hit testers specialized for frameMode (see SetFrameMode)
+    HitTestFn hitTest;
+    ResizeCellFn resolveResizeCell;
+
+    // Caption height, caption button zones, named regions and caption mask,
+    // published as immutable snapshots so hit tests never see a half-applied
+    // layout update
+    CaptionPublisher captions;
+
+    // DPI, frame metrics and placement, refreshed only on window events
+    FrameGeometryCache geometry;
+
+    // Last resolved resize hit for mouse moves, and the cursor shown for it
+    HoverMemo hover;
+    HCURSOR hoverCursor;
 
-// Rectangle for caption button zones
-struct ButtonRect {
-    int left;
-    int top;
-    int right;
-    int bottom;
+    // How mouse messages reach the resize border logic
+    InterceptionMode interception;
 };
 
-// Per-window state
-struct WindowState {
+// Per-window state only needed to forward or restore the window procedure
+struct WindowColdState {
     WNDPROC originalWndProc;
-    FrameMode frameMode;
 
-    // Custom caption area (relative to client area, in pixels)
-    int captionHeight;
+    // Slot in the shared window registry plus one, 0 while unclaimed
+    int sharedSlot;
 
-    // Caption button zones (in client coordinates)
-    ButtonRect minimizeButton;
-    ButtonRect maximizeButton;
-    ButtonRect closeButton;
+    // Subclassed content (Flutter view) window in Subclass interception
+    HWND view;
+};
 
-    // Whether caption buttons are defined
-    bool hasCaptionButtons;
+// State owned by each UI thread that has managed windows
+struct ThreadHookState {
+    // WH_GETMESSAGE hook, installed while any window of the thread uses
+    // ThreadHook interception
+    HHOOK getMsgHook;
+    int hookWindows;
 };
 
-// Global state for multi-window support
-static std::unordered_map<HWND, WindowState> g_window_states;
-static HHOOK g_getmsg_hook = nullptr;
-static int g_hook_ref_count = 0;
-static bool g_was_on_resize_border = false;
+// Global state for multi-window support. Each UI thread owns a shard of
+// flat open-addressing tables keyed by HWND (GWLP_USERDATA can't be used as
+// an index since the Flutter runner owns it), so windows of engines running
+// on different threads never contend. A shard is only touched on its own
+// thread; exports forward calls made elsewhere (see RunOnWindowThread).
+typedef ShardedWindowRegistry<HWND, WindowState, WindowColdState, ThreadHookState> WindowTable;
+static WindowTable g_windows;
+
+// Shard of the calling UI thread
+static WindowTable::Shard* CurrentShard() {
+    return g_windows.CurrentShard(GetCurrentThreadId());
+}
 
-// Resize border width in pixels
-static const int RESIZE_BORDER_WIDTH = 8;
+// State of a window owned by the calling thread, or nullptr
+static WindowState* FindWindowState(HWND hwnd) {
+    return CurrentShard()->windows.FindHot(hwnd);
+}
+
+// Optional registry shared with other processes (see
+// OpenSharedWindowRegistry). Mapped once and kept for the process lifetime.
+static const uint32_t SHARED_REGISTRY_SLOTS = 256;
+static SharedWindowRegistry g_shared_windows;
+static std::atomic<bool> g_shared_windows_open(false);
+static std::mutex g_shared_windows_mutex;
+
+// Resize and arrow cursors, loaded once per process
+static CursorCache<HCURSOR> g_cursors;
+
+// Messages the resize border logic handles; everything else is passed on
+// after one table load
+static MessageFilter MakeMessageFilter() {
+    MessageFilter filter;
+    filter.Set(WM_MOUSEMOVE, MessageAction::HoverMove);
+    filter.Set(WM_NCMOUSEMOVE, MessageAction::HoverMove);
+    filter.Set(WM_LBUTTONDOWN, MessageAction::ButtonDown);
+    return filter;
+}
+static const MessageFilter g_message_filter = MakeMessageFilter();
+
+// Interception used for windows enabled from now on
+static std::atomic<InterceptionMode> g_interception_mode(InterceptionMode::ThreadHook);
+static const UINT_PTR VIEW_SUBCLASS_ID = 1;
+
+// State blocks read by Dart without FFI calls (see OpenWindowStateBlock),
+// kept current by a subclass on the top-level window. Never freed.
+static WindowStateBlockPool g_state_blocks;
+static const UINT_PTR STATE_SUBCLASS_ID = 2;
+
+// Optional APIs, resolved once by the capability probe; null where this
+// Windows version lacks them. Exported through GetPlatformCapabilities, so
+// entries are only ever appended.
+struct Win32FunctionTable {
+    UINT (WINAPI *getDpiForWindow)(HWND);                              // Windows 10 1607+
+    int (WINAPI *getSystemMetricsForDpi)(int, UINT);                   // Windows 10 1607+
+    HRESULT (WINAPI *getDpiForMonitor)(HMONITOR, int, UINT*, UINT*);  // Windows 8.1+, shcore.dll
+};
 
-// Default caption height if not specified
-static const int DEFAULT_CAPTION_HEIGHT = 32;
+static Win32FunctionTable g_functions;
+static CapabilityProbe g_capabilities;
+
+// Resolve the optional APIs and read the OS version and compositor state.
+// Runs once per process, on whichever thread asks first.
+static void ProbeCapabilities(PlatformCapabilities* capabilities) {
+    HMODULE user32 = GetModuleHandleW(L"user32.dll");
+    if (user32) {
+        g_functions.getDpiForWindow = reinterpret_cast<UINT (WINAPI *)(HWND)>(
+            GetProcAddress(user32, "GetDpiForWindow"));
+        g_functions.getSystemMetricsForDpi = reinterpret_cast<int (WINAPI *)(int, UINT)>(
+            GetProcAddress(user32, "GetSystemMetricsForDpi"));
+    }
+    HMODULE shcore = LoadLibraryW(L"shcore.dll");
+    if (shcore) {
+        g_functions.getDpiForMonitor = reinterpret_cast<HRESULT (WINAPI *)(HMONITOR, int, UINT*, UINT*)>(
+            GetProcAddress(shcore, "GetDpiForMonitor"));
+    }
 
-// Get DPI for window
-static UINT GetDpiForWindowSafe(HWND hwnd) {
-    // Try GetDpiForWindow (Windows 10 1607+)
-    typedef UINT (WINAPI *GetDpiForWindowFunc)(HWND);
-    static GetDpiForWindowFunc pGetDpiForWindow = nullptr;
-    static bool loaded = false;
+    if (g_functions.getDpiForWindow) capabilities->flags |= CAPABILITY_WINDOW_DPI;
+    if (g_functions.getSystemMetricsForDpi) capabilities->flags |= CAPABILITY_DPI_SYSTEM_METRICS;
+    if (g_functions.getDpiForMonitor) capabilities->flags |= CAPABILITY_MONITOR_DPI;
+
+    // RtlGetVersion reports the real version; GetVersionEx is capped by
+    // the host's manifest
+    typedef LONG (WINAPI *RtlGetVersionFunc)(OSVERSIONINFOEXW*);
+    HMODULE ntdll = GetModuleHandleW(L"ntdll.dll");
+    RtlGetVersionFunc rtlGetVersion =
+        ntdll ? reinterpret_cast<RtlGetVersionFunc>(GetProcAddress(ntdll, "RtlGetVersion")) : nullptr;
+    OSVERSIONINFOEXW version = {};
+    version.dwOSVersionInfoSize = sizeof(version);
+    if (rtlGetVersion && rtlGetVersion(&version) == 0) {
+        capabilities->osMajor = version.dwMajorVersion;
+        capabilities->osMinor = version.dwMinorVersion;
+        capabilities->osBuild = version.dwBuildNumber;
+    }
+    // Windows 11 starts at build 22000
+    if (capabilities->osMajor > 10 || (capabilities->osMajor == 10 && capabilities->osBuild >= 22000)) {
+        capabilities->flags |= CAPABILITY_WINDOWS_11;
+    }
 
-    if (!loaded) {
-        HMODULE user32 = GetModuleHandleW(L"user32.dll");
-        if (user32) {
-            pGetDpiForWindow = (GetDpiForWindowFunc)GetProcAddress(user32, "GetDpiForWindow");
-        }
-        loaded = true;
+    BOOL composited = FALSE;
+    if (DwmIsCompositionEnabled(&composited) == S_OK && composited) {
+        capabilities->flags |= CAPABILITY_COMPOSITOR;
     }
 
-    if (pGetDpiForWindow) {
-        return pGetDpiForWindow(hwnd);
+    capabilities->functions = &g_functions;
+    capabilities->functionsSize = sizeof(g_functions);
+}
+
+static const PlatformCapabilities& Capabilities() {
+    return g_capabilities.Get(ProbeCapabilities);
+}
+
+// Get DPI for window
+static UINT GetDpiForWindowSafe(HWND hwnd) {
+    if (Capabilities().flags & CAPABILITY_WINDOW_DPI) {
+        return g_functions.getDpiForWindow(hwnd);
     }
 
     // Fallback: use DC
@@ -93,21 +288,8 @@ static UINT GetDpiForWindowSafe(HWND hwnd) {
 
 // Get system metrics for specific DPI
 static int GetSystemMetricsForDpiSafe(int nIndex, UINT dpi) {
-    // Try GetSystemMetricsForDpi (Windows 10 1607+)
-    typedef int (WINAPI *GetSystemMetricsForDpiFunc)(int, UINT);
-    static GetSystemMetricsForDpiFunc pGetSystemMetricsForDpi = nullptr;
-    static bool loaded = false;
-
-    if (!loaded) {
-        HMODULE user32 = GetModuleHandleW(L"user32.dll");
-        if (user32) {
-            pGetSystemMetricsForDpi = (GetSystemMetricsForDpiFunc)GetProcAddress(user32, "GetSystemMetricsForDpi");
-        }
-        loaded = true;
-    }
-
-    if (pGetSystemMetricsForDpi) {
-        return pGetSystemMetricsForDpi(nIndex, dpi);
+    if (Capabilities().flags & CAPABILITY_DPI_SYSTEM_METRICS) {
+        return g_functions.getSystemMetricsForDpi(nIndex, dpi);
     }
 
     // Fallback: use regular GetSystemMetrics and scale
@@ -115,287 +297,553 @@ static int GetSystemMetricsForDpiSafe(int nIndex, UINT dpi) {
     return MulDiv(value, dpi, 96);
 }
 
-// Check if running on Windows 11
-static bool IsWindows11OrGreater() {
-    OSVERSIONINFOEXW osvi = { sizeof(osvi), 0 };
-    DWORDLONG conditionMask = 0;
-
-    VER_SET_CONDITION(conditionMask, VER_MAJORVERSION, VER_GREATER_EQUAL);
-    VER_SET_CONDITION(conditionMask, VER_MINORVERSION, VER_GREATER_EQUAL);
-    VER_SET_CONDITION(conditionMask, VER_BUILDNUMBER, VER_GREATER_EQUAL);
-
-    osvi.dwMajorVersion = 10;
-    osvi.dwMinorVersion = 0;
-    osvi.dwBuildNumber = 22000;  // Windows 11 starts at build 22000
-
-    return VerifyVersionInfoW(&osvi, VER_MAJORVERSION | VER_MINORVERSION | VER_BUILDNUMBER, conditionMask) != FALSE;
+// Map a neutral hit code onto the Win32 WM_NCHITTEST value
+static LRESULT ToWin32HitTest(HitCode hit) {
+    static const LRESULT kWin32HitTests[] = {
+        HTNOWHERE,      // Nowhere
+        HTCLIENT,       // Client
+        HTCAPTION,      // Caption
+        HTMINBUTTON,    // MinButton
+        HTMAXBUTTON,    // MaxButton (Windows 11 snap layout support)
+        HTCLOSE,        // Close
+        HTLEFT,         // Left
+        HTRIGHT,        // Right
+        HTTOP,          // Top
+        HTBOTTOM,       // Bottom
+        HTTOPLEFT,      // TopLeft
+        HTTOPRIGHT,     // TopRight
+        HTBOTTOMLEFT,   // BottomLeft
+        HTBOTTOMRIGHT,  // BottomRight
+    };
+    return kWin32HitTests[static_cast<int>(hit)];
 }
 
-// Get the resize frame thickness (DPI-aware)
-static int GetResizeFrameThickness(HWND hwnd) {
-    UINT dpi = GetDpiForWindowSafe(hwnd);
-    int frame = GetSystemMetricsForDpiSafe(SM_CXFRAME, dpi);
-    int padding = GetSystemMetricsForDpiSafe(SM_CXPADDEDBORDER, dpi);
-    return frame + padding;
+// Map a WM_NCHITTEST value back to a neutral hit code. Only the resize
+// borders are needed (for cursors); anything else maps to Nowhere.
+static HitCode FromWin32HitTest(LRESULT hitTest) {
+    switch (hitTest) {
+        case HTLEFT: return HitCode::Left;
+        case HTRIGHT: return HitCode::Right;
+        case HTTOP: return HitCode::Top;
+        case HTBOTTOM: return HitCode::Bottom;
+        case HTTOPLEFT: return HitCode::TopLeft;
+        case HTTOPRIGHT: return HitCode::TopRight;
+        case HTBOTTOMLEFT: return HitCode::BottomLeft;
+        case HTBOTTOMRIGHT: return HitCode::BottomRight;
+        default: return HitCode::Nowhere;
+    }
 }
 
-// Check if point is inside a rectangle
-static bool PointInRect(int x, int y, const ButtonRect& rect) {
-    return x >= rect.left && x < rect.right && y >= rect.top && y < rect.bottom;
+// Monitor layout shared by all windows and threads. It is refilled from
+// EnumDisplayMonitors only after a display, DPI or work area change reached
+// the watcher window (the first managed window to ask for a monitor);
+// while there is no watcher every lookup refills it.
+static MonitorTopology g_monitors;
+static std::mutex g_monitors_mutex;
+static std::atomic<bool> g_monitors_stale(true);
+static std::atomic<HWND> g_monitor_watcher(nullptr);
+static const UINT_PTR MONITOR_SUBCLASS_ID = 3;
+
+static Rect ToCoreRect(const RECT& rect) {
+    return { rect.left, rect.top, rect.right, rect.bottom };
 }
 
-// Handle hit testing for the custom frame mode (Windows 11 File Explorer style)
-static LRESULT HandleCustomFrameHitTest(HWND hWnd, LPARAM lParam, const WindowState& state) {
-    POINT mousePos = { GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam) };
-
-    RECT windowRect;
-    GetWindowRect(hWnd, &windowRect);
-
-    UINT dpi = GetDpiForWindowSafe(hWnd);
-    int frameX = GetSystemMetricsForDpiSafe(SM_CXFRAME, dpi);
-    int frameY = GetSystemMetricsForDpiSafe(SM_CYFRAME, dpi);
-    int padding = GetSystemMetricsForDpiSafe(SM_CXPADDEDBORDER, dpi);
-
-    int borderWidth = frameX + padding;
-    int borderHeight = frameY + padding;
-
-    // Calculate position relative to window
-    int x = mousePos.x - windowRect.left;
-    int y = mousePos.y - windowRect.top;
-    int windowWidth = windowRect.right - windowRect.left;
-    int windowHeight = windowRect.bottom - windowRect.top;
+// Get the effective DPI of a monitor
+static UINT GetDpiForMonitorSafe(HMONITOR monitor) {
+    UINT dpiX = 96;
+    UINT dpiY = 96;
+    if ((Capabilities().flags & CAPABILITY_MONITOR_DPI) &&
+        g_functions.getDpiForMonitor(monitor, 0 /* MDT_EFFECTIVE_DPI */, &dpiX, &dpiY) == S_OK) {
+        return dpiX;
+    }
+    return 96;
+}
 
-    // Check if maximized - no resize borders when maximized
-    bool isMaximized = IsZoomed(hWnd);
+// Describe one monitor the way the topology stores it
+static bool GetMonitor(HMONITOR handle, MonitorInfo* monitor) {
+    MONITORINFO monitorInfo = {};
+    monitorInfo.cbSize = sizeof(monitorInfo);
+    if (!GetMonitorInfo(handle, &monitorInfo)) {
+        return false;
+    }
+    monitor->id = reinterpret_cast<uintptr_t>(handle);
+    monitor->bounds = ToCoreRect(monitorInfo.rcMonitor);
+    monitor->workArea = ToCoreRect(monitorInfo.rcWork);
+    monitor->dpi = GetDpiForMonitorSafe(handle);
+    monitor->flags = (monitorInfo.dwFlags & MONITORINFOF_PRIMARY) ? MONITOR_PRIMARY : 0;
+    return true;
+}
 
-    if (!isMaximized) {
-        // Check resize borders first
-        bool isLeft = x < borderWidth;
-        bool isRight = x >= windowWidth - borderWidth;
-        bool isTop = y < borderHeight;
-        bool isBottom = y >= windowHeight - borderHeight;
+static BOOL CALLBACK CollectMonitor(HMONITOR monitor, HDC, RECT*, LPARAM lParam) {
+    MonitorInfo info;
+    if (GetMonitor(monitor, &info)) {
+        reinterpret_cast<std::vector<MonitorInfo>*>(lParam)->push_back(info);
+    }
+    return TRUE;
+}
 
-        // Corners have priority
-        if (isTop && isLeft) return HTTOPLEFT;
-        if (isTop && isRight) return HTTOPRIGHT;
-        if (isBottom && isLeft) return HTBOTTOMLEFT;
-        if (isBottom && isRight) return HTBOTTOMRIGHT;
+// The monitor topology, refilled first if it may be stale. The caller holds
+// g_monitors_mutex. The stale flag is cleared before enumerating, so a
+// change arriving meanwhile refills it again on the next lookup.
+static const MonitorTopology& CurrentMonitors() {
+    if (g_monitors_stale.exchange(false) || g_monitor_watcher.load() == nullptr) {
+        std::vector<MonitorInfo> monitors;
+        EnumDisplayMonitors(nullptr, nullptr, CollectMonitor, reinterpret_cast<LPARAM>(&monitors));
+        g_monitors.Update(monitors.data(), monitors.size());
+    }
+    return g_monitors;
+}
 
-        // Edges
-        if (isLeft) return HTLEFT;
-        if (isRight) return HTRIGHT;
-        if (isBottom) return HTBOTTOM;
+// Subclass procedure on the watcher window. WM_DISPLAYCHANGE and
+// WM_SETTINGCHANGE (work area) are sent to every top-level window, so one
+// watcher sees them for all monitors. When it is destroyed the next lookup
+// from a managed window picks a new one.
+static LRESULT CALLBACK MonitorSubclassProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam,
+                                            UINT_PTR, DWORD_PTR) {
+    switch (uMsg) {
+        case WM_DISPLAYCHANGE:
+        case WM_SETTINGCHANGE:
+        case WM_DPICHANGED:
+            g_monitors_stale.store(true);
+            break;
+        case WM_NCDESTROY:
+            RemoveWindowSubclass(hWnd, MonitorSubclassProc, MONITOR_SUBCLASS_ID);
+            g_monitor_watcher.store(nullptr);
+            g_monitors_stale.store(true);
+            break;
+    }
+    return DefSubclassProc(hWnd, uMsg, wParam, lParam);
+}
 
-        // Top edge - this is special because it overlaps with caption area
-        // Only report HTTOP at the very edge (a few pixels)
-        if (y < borderHeight / 2) return HTTOP;
+// Make hwnd the watcher unless there is one. Runs on hwnd's thread.
+static void WatchMonitorTopology(HWND hwnd) {
+    HWND expected = nullptr;
+    if (g_monitor_watcher.load() != nullptr || !g_monitor_watcher.compare_exchange_strong(expected, hwnd)) {
+        return;
+    }
+    if (!SetWindowSubclass(hwnd, MonitorSubclassProc, MONITOR_SUBCLASS_ID, 0)) {
+        g_monitor_watcher.store(nullptr);
+        return;
     }
+    // Changes before the subclass was in place went unseen
+    g_monitors_stale.store(true);
+}
 
-    // Convert to client coordinates for caption area detection
-    POINT clientPos = mousePos;
-    ScreenToClient(hWnd, &clientPos);
+// Monitor with the largest part of a screen rect, else the nearest one
+// (MonitorFromRect with MONITOR_DEFAULTTONEAREST). Returns false without
+// monitors.
+static bool FindMonitorForRect(const RECT& rect, MonitorInfo* monitor) {
+    std::lock_guard<std::mutex> lock(g_monitors_mutex);
+    const MonitorTopology& topology = CurrentMonitors();
+    int index = topology.FindForRect(ToCoreRect(rect));
+    if (index == MonitorTopology::kNone) {
+        return false;
+    }
+    *monitor = topology.monitor(index);
+    return true;
+}
 
-    // Check caption button areas first
-    if (state.hasCaptionButtons) {
-        // Close button
-        if (PointInRect(clientPos.x, clientPos.y, state.closeButton)) {
-            return HTCLOSE;
-        }
+// The rect a window's monitor is looked up by: a minimized window belongs
+// to the monitor of its restored rect
+static RECT WindowMonitorRect(HWND hwnd) {
+    RECT rect;
+    if (IsIconic(hwnd)) {
+        WINDOWPLACEMENT placement = {};
+        placement.length = sizeof(placement);
+        GetWindowPlacement(hwnd, &placement);
+        rect = placement.rcNormalPosition;
+    } else {
+        GetWindowRect(hwnd, &rect);
+    }
+    return rect;
+}
 
-        // Maximize button - return HTMAXBUTTON for Windows 11 snap layout support
-        if (PointInRect(clientPos.x, clientPos.y, state.maximizeButton)) {
-            return HTMAXBUTTON;
-        }
+// Monitor of a window (MonitorFromWindow with MONITOR_DEFAULTTONEAREST)
+static bool FindWindowMonitor(HWND hwnd, MonitorInfo* monitor) {
+    return FindMonitorForRect(WindowMonitorRect(hwnd), monitor);
+}
 
-        // Minimize button
-        if (PointInRect(clientPos.x, clientPos.y, state.minimizeButton)) {
-            return HTMINBUTTON;
+// Monitor of a window for calls from any thread that must neither wait nor
+// allocate: from the topology while it is current and nobody is refilling
+// it, else straight from MonitorFromRect
+static bool PeekWindowMonitor(HWND hwnd, MonitorInfo* monitor) {
+    RECT rect = WindowMonitorRect(hwnd);
+    if (g_monitor_watcher.load() != nullptr && !g_monitors_stale.load()) {
+        std::unique_lock<std::mutex> lock(g_monitors_mutex, std::try_to_lock);
+        if (lock.owns_lock()) {
+            int index = g_monitors.FindForRect(ToCoreRect(rect));
+            if (index != MonitorTopology::kNone) {
+                *monitor = g_monitors.monitor(index);
+                return true;
+            }
         }
     }
+    return GetMonitor(MonitorFromRect(&rect, MONITOR_DEFAULTTONEAREST), monitor);
+}
 
-    // Check if in caption area (custom title bar region)
-    int captionHeight = state.captionHeight > 0 ? state.captionHeight : DEFAULT_CAPTION_HEIGHT;
+// Query the DPI dependent frame metrics of a window
+static FrameMetrics QueryFrameMetrics(HWND hWnd) {
+    FrameMetrics metrics;
+    metrics.dpi = GetDpiForWindowSafe(hWnd);
+    metrics.frameX = GetSystemMetricsForDpiSafe(SM_CXFRAME, metrics.dpi);
+    metrics.frameY = GetSystemMetricsForDpiSafe(SM_CYFRAME, metrics.dpi);
+    metrics.padding = GetSystemMetricsForDpiSafe(SM_CXPADDEDBORDER, metrics.dpi);
+    return metrics;
+}
 
-    // Scale caption height for DPI
-    captionHeight = MulDiv(captionHeight, dpi, 96);
+// Query the window rect, client origin and maximized state of a window
+static FramePlacement QueryFramePlacement(HWND hWnd) {
+    RECT windowRect;
+    GetWindowRect(hWnd, &windowRect);
 
-    // Account for the top border when not maximized
-    int topOffset = isMaximized ? 0 : borderHeight;
+    // Client origin relative to the window origin
+    POINT clientOrigin = { windowRect.left, windowRect.top };
+    ScreenToClient(hWnd, &clientOrigin);
 
-    if (clientPos.y < captionHeight) {
-        return HTCAPTION;
-    }
+    FramePlacement placement;
+    placement.windowRect = { windowRect.left, windowRect.top, windowRect.right, windowRect.bottom };
+    placement.clientLeft = -clientOrigin.x;
+    placement.clientTop = -clientOrigin.y;
+    placement.isMaximized = IsZoomed(hWnd) != FALSE;
+    return placement;
+}
 
-    return HTCLIENT;
+// Get the cached frame geometry, querying the OS only if it is stale
+static const FrameGeometry& GetFrameGeometry(HWND hWnd, WindowState& state) {
+    return state.geometry.Get(
+        [hWnd]() { return QueryFrameMetrics(hWnd); },
+        [hWnd]() { return QueryFramePlacement(hWnd); }
+    );
 }
 
-// Handle hit testing for legacy hidden mode (borderless)
-static LRESULT HandleHiddenFrameHitTest(HWND hWnd, LPARAM lParam) {
-    POINT mousePos = { GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam) };
+// Window property mirroring a managed window's frame mode (plus one), so
+// other threads can read it without a forwarded call
+static const wchar_t FRAME_MODE_PROP[] = L"WindowDecorationFrameMode";
+
+// Switch the frame mode and pick the hit testers specialized for it, so the
+// message handlers never branch on the mode to hit test
+static void SetFrameMode(HWND hwnd, WindowState& state, FrameMode mode) {
+    state.frameMode = mode;
+    state.hitTest = window_decoration::SelectHitTest(mode);
+    state.resolveResizeCell = window_decoration::SelectResizeCell(mode);
+    SetPropW(hwnd, FRAME_MODE_PROP, reinterpret_cast<HANDLE>(static_cast<intptr_t>(mode) + 1));
+}
 
-    RECT windowRect;
-    GetWindowRect(hWnd, &windowRect);
+// Frame mode of any window, from any thread (Normal for unmanaged ones)
+static FrameMode PeekFrameMode(HWND hwnd) {
+    intptr_t value = reinterpret_cast<intptr_t>(GetPropW(hwnd, FRAME_MODE_PROP));
+    return value > 0 ? static_cast<FrameMode>(value - 1) : FrameMode::Normal;
+}
 
-    // Check if window is maximized - no resize borders when maximized
-    if (IsZoomed(hWnd)) {
-        return HTCLIENT;
-    }
+// Publish a new caption height (logical pixels, 0 or less for the default)
+static void PublishCaptionHeight(WindowState& state, int height) {
+    state.captions.Update([height](CaptionSnapshot& snapshot) {
+        snapshot.caption.captionHeight = height > 0 ? height : DEFAULT_CAPTION_HEIGHT;
+        return true;
+    });
+}
 
-    int borderWidth = GetResizeFrameThickness(hWnd);
-    if (borderWidth < RESIZE_BORDER_WIDTH) {
-        borderWidth = RESIZE_BORDER_WIDTH;
+// Whether a process owning shared registry slots is still running.
+// Processes this one may not open (elevated, another session) count as
+// running; only ids that no longer exist or have exited are swept.
+static bool IsProcessRunning(uint32_t processId) {
+    HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, processId);
+    if (process == nullptr) {
+        return GetLastError() != ERROR_INVALID_PARAMETER;
     }
+    DWORD exitCode = 0;
+    bool running = !GetExitCodeProcess(process, &exitCode) || exitCode == STILL_ACTIVE;
+    CloseHandle(process);
+    return running;
+}
 
-    int x = mousePos.x - windowRect.left;
-    int y = mousePos.y - windowRect.top;
-    int windowWidth = windowRect.right - windowRect.left;
-    int windowHeight = windowRect.bottom - windowRect.top;
+// Publish a window's bounds, frame mode and caption regions to the shared
+// registry, claiming a slot for it on first use. Only the window's thread
+// writes its slot.
+static void PublishSharedWindow(HWND hWnd, WindowState& state, WindowColdState& cold) {
+    if (!g_shared_windows_open.load(std::memory_order_acquire)) return;
+
+    uint32_t processId = GetCurrentProcessId();
+    if (cold.sharedSlot == 0) {
+        int slot = g_shared_windows.Claim(processId, reinterpret_cast<uintptr_t>(hWnd));
+        if (slot < 0 && g_shared_windows.ReleaseDeadProcesses(IsProcessRunning) > 0) {
+            // Full of windows of processes that crashed; try again
+            slot = g_shared_windows.Claim(processId, reinterpret_cast<uintptr_t>(hWnd));
+        }
+        if (slot < 0) return;
+        cold.sharedSlot = slot + 1;
+    }
 
-    int cornerSize = borderWidth * 2;
+    const FrameGeometry& geometry = GetFrameGeometry(hWnd, state);
+    SharedWindowInfo info = {};
+    info.window = reinterpret_cast<uintptr_t>(hWnd);
+    info.frameMode = static_cast<int32_t>(state.frameMode);
+    info.bounds = state.geometry.placement().windowRect;
+    info.dpi = geometry.dpi;
+
+    CaptionPublisher::ReadGuard snapshot = state.captions.Read();
+    info.captionHeight = snapshot->caption.captionHeight;
+    size_t regionCount = snapshot->regions.size();
+    if (regionCount > window_decoration::MAX_SHARED_CAPTION_REGIONS) {
+        regionCount = window_decoration::MAX_SHARED_CAPTION_REGIONS;
+    }
+    for (size_t i = 0; i < regionCount; i++) {
+        info.regions[i].bounds = snapshot->regions.region(i).bounds;
+        info.regions[i].hit = static_cast<int32_t>(snapshot->regions.region(i).hit);
+    }
+    info.regionCount = static_cast<uint32_t>(regionCount);
 
-    bool isLeft = x < borderWidth;
-    bool isRight = x >= windowWidth - borderWidth;
-    bool isTop = y < borderWidth;
-    bool isBottom = y >= windowHeight - borderWidth;
+    g_shared_windows.Publish(cold.sharedSlot - 1, processId, info);
+}
 
-    bool isNearLeft = x < cornerSize;
-    bool isNearRight = x >= windowWidth - cornerSize;
-    bool isNearTop = y < cornerSize;
-    bool isNearBottom = y >= windowHeight - cornerSize;
+// Republish a window of the calling thread after an export changed it
+static void PublishSharedWindow(HWND hwnd) {
+    if (!g_shared_windows_open.load(std::memory_order_acquire)) return;
 
-    // Corners
-    if (isTop && isNearLeft) return HTTOPLEFT;
-    if (isLeft && isNearTop) return HTTOPLEFT;
-    if (isTop && isNearRight) return HTTOPRIGHT;
-    if (isRight && isNearTop) return HTTOPRIGHT;
-    if (isBottom && isNearLeft) return HTBOTTOMLEFT;
-    if (isLeft && isNearBottom) return HTBOTTOMLEFT;
-    if (isBottom && isNearRight) return HTBOTTOMRIGHT;
-    if (isRight && isNearBottom) return HTBOTTOMRIGHT;
+    WindowTable::Shard* shard = CurrentShard();
+    uint32_t slot = shard->windows.Find(hwnd);
+    if (slot != WindowTable::kNoSlot) {
+        PublishSharedWindow(hwnd, shard->windows.hot(slot), shard->windows.cold(slot));
+    }
+}
 
-    // Edges
-    if (isLeft) return HTLEFT;
-    if (isRight) return HTRIGHT;
-    if (isTop) return HTTOP;
-    if (isBottom) return HTBOTTOM;
+// Handle WM_NCHITTEST with the hit tester of the current frame mode
+static LRESULT HandleFrameHitTest(HWND hWnd, LPARAM lParam, WindowState& state) {
+    const FrameGeometry& geometry = GetFrameGeometry(hWnd, state);
+    const window_decoration::Rect& windowRect = state.geometry.placement().windowRect;
 
-    return HTCLIENT;
+    int x = GET_X_LPARAM(lParam) - windowRect.left;
+    int y = GET_Y_LPARAM(lParam) - windowRect.top;
+    CaptionPublisher::ReadGuard snapshot = state.captions.Read();
+    return ToWin32HitTest(state.hitTest(x, y, geometry, snapshot->caption, &snapshot->regions, &snapshot->mask));
 }
 
-// Get the appropriate cursor for a hit test result
-static HCURSOR GetCursorForHitTest(LRESULT hitTest) {
-    switch (hitTest) {
-        case HTLEFT:
-        case HTRIGHT:
+// Load the system cursor for a shape. System cursors are shared handles,
+// so cached ones never need to be destroyed.
+static HCURSOR LoadSystemCursor(CursorShape shape) {
+    switch (shape) {
+        case CursorShape::ResizeHorizontal:
             return LoadCursor(nullptr, IDC_SIZEWE);
-        case HTTOP:
-        case HTBOTTOM:
+        case CursorShape::ResizeVertical:
             return LoadCursor(nullptr, IDC_SIZENS);
-        case HTTOPLEFT:
-        case HTBOTTOMRIGHT:
+        case CursorShape::ResizeNwse:
             return LoadCursor(nullptr, IDC_SIZENWSE);
-        case HTTOPRIGHT:
-        case HTBOTTOMLEFT:
+        case CursorShape::ResizeNesw:
             return LoadCursor(nullptr, IDC_SIZENESW);
         default:
-            return nullptr;
+            return LoadCursor(nullptr, IDC_ARROW);
     }
 }
 
-// Check if point is in resize border area (in screen coordinates)
-static LRESULT HitTestResizeBorder(HWND hwnd, int screenX, int screenY) {
-    auto it = g_window_states.find(hwnd);
-    if (it == g_window_states.end()) return HTNOWHERE;
+// Get a cursor from the process-wide cache. System cursors don't depend on
+// the display or DPI, so every shape has a single entry.
+static HCURSOR GetCachedCursor(CursorShape shape) {
+    return g_cursors.Get(shape, 0, 0, LoadSystemCursor);
+}
 
-    const WindowState& state = it->second;
+// Get the resize cursor for a hit (nullptr outside the resize borders)
+static HCURSOR GetCursorForHit(HitCode hit) {
+    CursorShape shape;
+    return window_decoration::CursorShapeForHit(hit, &shape) ? GetCachedCursor(shape) : nullptr;
+}
 
-    if (state.frameMode == FrameMode::CustomFrame) {
-        LPARAM lParam = MAKELPARAM(screenX, screenY);
-        LRESULT hit = HandleCustomFrameHitTest(hwnd, lParam, state);
-        if (hit != HTCLIENT && hit != HTCAPTION && hit != HTCLOSE &&
-            hit != HTMAXBUTTON && hit != HTMINBUTTON) {
-            return hit;
+// Check if point is in resize border area (in screen coordinates).
+// Returns Nowhere when not on a resize border. Mouse moves that stay inside
+// the last resolved cell are answered from the window's hover memo.
+static HitCode HitTestResizeBorder(HWND hwnd, WindowState& state, int screenX, int screenY) {
+    const FrameGeometry& geometry = GetFrameGeometry(hwnd, state);
+    const window_decoration::Rect& windowRect = state.geometry.placement().windowRect;
+
+    int x = screenX - windowRect.left;
+    int y = screenY - windowRect.top;
+    ResizeCellFn resolveResizeCell = state.resolveResizeCell;
+    return state.hover.Resolve(x, y, state.geometry.generation(),
+        [&geometry, resolveResizeCell](int px, int py, window_decoration::Rect* cell) {
+            return resolveResizeCell(px, py, geometry, cell);
+        });
+}
+
+// Show a cursor unless it is already showing (WM_SETCURSOR arrives for
+// every mouse move over the window)
+static void SetHoverCursor(WindowState& state, HCURSOR cursor) {
+    if (GetCursor() != cursor) {
+        SetCursor(cursor);
+        state.hover.RecordCursorChange();
+    }
+}
+
+// Show the resize cursor while over a border, touching the cursor only
+// when the hit changes or the target window reset it in WM_SETCURSOR
+static void UpdateHoverCursor(WindowState& state, HitCode hit) {
+    bool transition = state.hover.Transition(hit);
+
+    if (hit != HitCode::Nowhere) {
+        if (transition) {
+            state.hoverCursor = GetCursorForHit(hit);
         }
-        return HTNOWHERE;
-    } else if (state.frameMode == FrameMode::Hidden) {
-        LPARAM lParam = MAKELPARAM(screenX, screenY);
-        LRESULT hit = HandleHiddenFrameHitTest(hwnd, lParam);
-        if (hit != HTCLIENT) {
-            return hit;
+        if (state.hoverCursor != nullptr) {
+            SetHoverCursor(state, state.hoverCursor);
         }
+    } else if (transition) {
+        SetCursor(GetCachedCursor(CursorShape::Arrow));
+        state.hover.RecordCursorChange();
+        state.hoverCursor = nullptr;
     }
-
-    return HTNOWHERE;
 }
 
-// Find the managed window for a given HWND
-static HWND FindManagedWindow(HWND hwnd) {
-    auto it = g_window_states.find(hwnd);
-    if (it != g_window_states.end() && it->second.frameMode != FrameMode::Normal) {
-        return hwnd;
+// Find the managed window for a given HWND (the window itself or its
+// parent) and return its state, or nullptr if neither is managed through
+// the thread hook. Only the
+// calling thread's windows are considered: the hook runs on the thread
+// that owns the message's window.
+static WindowState* FindManagedWindow(HWND hwnd, HWND* managedWindow) {
+    WindowTable::Shard* shard = CurrentShard();
+    WindowState* state = shard->windows.FindHot(hwnd);
+    if (state != nullptr && state->frameMode != FrameMode::Normal &&
+        state->interception == InterceptionMode::ThreadHook) {
+        *managedWindow = hwnd;
+        return state;
     }
 
     HWND parent = GetParent(hwnd);
     if (parent != nullptr) {
-        auto parentIt = g_window_states.find(parent);
-        if (parentIt != g_window_states.end() && parentIt->second.frameMode != FrameMode::Normal) {
-            return parent;
+        state = shard->windows.FindHot(parent);
+        if (state != nullptr && state->frameMode != FrameMode::Normal &&
+            state->interception == InterceptionMode::ThreadHook) {
+            *managedWindow = parent;
+            return state;
         }
     }
 
     return nullptr;
 }
 
-// GetMessage hook to intercept messages before dispatch
+// Resize border handling for a mouse message to a managed window or its
+// content view, at screen position pt. Returns true if the message was
+// consumed: a press on a resize border is turned into a system resize.
+static bool HandleBorderMessage(HWND managedWindow, WindowState& state, MessageAction action, POINT pt) {
+    HitCode hit = HitTestResizeBorder(managedWindow, state, pt.x, pt.y);
+
+    if (action == MessageAction::HoverMove) {
+        UpdateHoverCursor(state, hit);
+        return false;
+    }
+
+    if (hit == HitCode::Nowhere) {
+        return false;
+    }
+    ReleaseCapture();
+    PostMessage(managedWindow, WM_NCLBUTTONDOWN, ToWin32HitTest(hit), MAKELPARAM(pt.x, pt.y));
+    return true;
+}
+
+// Cursor position of the message being processed
+static POINT GetMessagePoint() {
+    DWORD position = GetMessagePos();
+    POINT pt = { GET_X_LPARAM(position), GET_Y_LPARAM(position) };
+    return pt;
+}
+
+// GetMessage hook to intercept messages before dispatch (ThreadHook
+// interception). Sees every message of the thread, so irrelevant ones are
+// filtered out before any window lookup.
 LRESULT CALLBACK GetMsgProc(int nCode, WPARAM wParam, LPARAM lParam) {
     if (nCode >= 0) {
         MSG* msg = reinterpret_cast<MSG*>(lParam);
+        MessageAction action = g_message_filter.Classify(msg->message);
 
-        HWND managedWindow = FindManagedWindow(msg->hwnd);
-
-        if (managedWindow != nullptr) {
-            if (msg->message == WM_MOUSEMOVE || msg->message == WM_NCMOUSEMOVE) {
-                POINT pt;
-                GetCursorPos(&pt);
-                LRESULT hitTest = HitTestResizeBorder(managedWindow, pt.x, pt.y);
-
-                if (hitTest != HTNOWHERE) {
-                    HCURSOR cursor = GetCursorForHitTest(hitTest);
-                    if (cursor) {
-                        SetCursor(cursor);
-                    }
-                    g_was_on_resize_border = true;
-                } else if (g_was_on_resize_border) {
-                    SetCursor(LoadCursor(nullptr, IDC_ARROW));
-                    g_was_on_resize_border = false;
-                }
-            }
-
-            if (msg->message == WM_LBUTTONDOWN) {
-                POINT pt;
-                GetCursorPos(&pt);
-                LRESULT hitTest = HitTestResizeBorder(managedWindow, pt.x, pt.y);
+        if (action != MessageAction::Ignore) {
+            HWND managedWindow = nullptr;
+            WindowState* state = FindManagedWindow(msg->hwnd, &managedWindow);
 
-                if (hitTest != HTNOWHERE) {
-                    msg->message = WM_NULL;
-                    ReleaseCapture();
-                    PostMessage(managedWindow, WM_NCLBUTTONDOWN, hitTest, MAKELPARAM(pt.x, pt.y));
-                }
+            // msg->pt is the cursor position when the message was posted
+            if (state != nullptr && HandleBorderMessage(managedWindow, *state, action, msg->pt)) {
+                msg->message = WM_NULL;
             }
         }
     }
 
-    return CallNextHookEx(g_getmsg_hook, nCode, wParam, lParam);
+    return CallNextHookEx(CurrentShard()->thread.getMsgHook, nCode, wParam, lParam);
 }
 
+// Subclass procedure on a managed window's content view (Subclass
+// interception). Only this window's messages arrive here; refData is the
+// managed top-level window.
+static LRESULT CALLBACK ViewSubclassProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam,
+                                         UINT_PTR, DWORD_PTR refData) {
+    if (uMsg == WM_NCDESTROY) {
+        RemoveWindowSubclass(hWnd, ViewSubclassProc, VIEW_SUBCLASS_ID);
+        return DefSubclassProc(hWnd, uMsg, wParam, lParam);
+    }
+    MessageAction action = g_message_filter.Classify(uMsg);
+    if (action != MessageAction::Ignore) {
+        HWND managedWindow = reinterpret_cast<HWND>(refData);
+        WindowState* state = FindWindowState(managedWindow);
+        if (state != nullptr && state->frameMode != FrameMode::Normal &&
+            HandleBorderMessage(managedWindow, *state, action, GetMessagePoint())) {
+            return 0;
+        }
+    }
+    return DefSubclassProc(hWnd, uMsg, wParam, lParam);
+}
+
+static void ReleaseManagedWindow(HWND hwnd, WindowTable::Shard* shard, uint32_t slot);
+
 // Replacement window procedure
 LRESULT CALLBACK CustomFrameWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-    auto it = g_window_states.find(hWnd);
-    if (it == g_window_states.end()) {
+    WindowTable::Shard* shard = CurrentShard();
+    uint32_t slot = shard->windows.Find(hWnd);
+    if (slot == WindowTable::kNoSlot) {
         return DefWindowProc(hWnd, uMsg, wParam, lParam);
     }
 
-    WindowState& state = it->second;
+    WindowState& state = shard->windows.hot(slot);
+    WindowColdState& cold = shard->windows.cold(slot);
+
+    // The window is gone: forget it before Windows can hand its HWND to a
+    // new window, then let the original procedure see the message
+    if (uMsg == WM_NCDESTROY) {
+        WNDPROC originalWndProc = cold.originalWndProc;
+        ReleaseManagedWindow(hWnd, shard, slot);
+        if (originalWndProc) {
+            return CallWindowProc(originalWndProc, hWnd, uMsg, wParam, lParam);
+        }
+        return DefWindowProc(hWnd, uMsg, wParam, lParam);
+    }
+
+    // Refresh cached geometry only when the window or system state changes
+    switch (uMsg) {
+        case WM_DPICHANGED:
+            state.geometry.Invalidate(FrameCacheEvent::DpiChanged);
+            break;
+        case WM_SETTINGCHANGE:
+            state.geometry.Invalidate(FrameCacheEvent::SettingChange);
+            break;
+        case WM_WINDOWPOSCHANGING:
+            state.geometry.Invalidate(FrameCacheEvent::WindowPosChanging);
+            break;
+        case WM_WINDOWPOSCHANGED:
+            state.geometry.Invalidate(FrameCacheEvent::WindowPosChanged);
+            break;
+        case WM_SIZE:
+            state.geometry.Invalidate(FrameCacheEvent::Size);
+            break;
+    }
+
+    // Other processes see moves, resizes and DPI changes through the shared
+    // registry
+    if (uMsg == WM_WINDOWPOSCHANGED || uMsg == WM_DPICHANGED) {
+        PublishSharedWindow(hWnd, state, cold);
+    }
+
+    // Subclass interception: mouse messages to the window itself (the view
+    // has its own subclass)
+    if (state.interception == InterceptionMode::Subclass && state.frameMode != FrameMode::Normal) {
+        MessageAction action = g_message_filter.Classify(uMsg);
+        if (action != MessageAction::Ignore && HandleBorderMessage(hWnd, state, action, GetMessagePoint())) {
+            return 0;
+        }
+    }
 
     if (state.frameMode == FrameMode::CustomFrame) {
         // WM_NCCALCSIZE - This is the key to Windows 11 File Explorer style
@@ -403,10 +851,11 @@ LRESULT CALLBACK CustomFrameWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM
         if (uMsg == WM_NCCALCSIZE && wParam == TRUE) {
             NCCALCSIZE_PARAMS* params = reinterpret_cast<NCCALCSIZE_PARAMS*>(lParam);
 
-            UINT dpi = GetDpiForWindowSafe(hWnd);
-            int frameX = GetSystemMetricsForDpiSafe(SM_CXFRAME, dpi);
-            int frameY = GetSystemMetricsForDpiSafe(SM_CYFRAME, dpi);
-            int padding = GetSystemMetricsForDpiSafe(SM_CXPADDEDBORDER, dpi);
+            GetFrameGeometry(hWnd, state);
+            const FrameMetrics& metrics = state.geometry.metrics();
+            int frameX = metrics.frameX;
+            int frameY = metrics.frameY;
+            int padding = metrics.padding;
 
             // Adjust the client rectangle
             // Keep left, right, and bottom borders for resize
@@ -415,13 +864,13 @@ LRESULT CALLBACK CustomFrameWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM
             params->rgrc[0].right -= frameX + padding;
             params->rgrc[0].bottom -= frameY + padding;
 
-            if (IsZoomed(hWnd)) {
+            if (state.geometry.placement().isMaximized) {
                 // When maximized, add top padding to prevent content going under taskbar
                 params->rgrc[0].top += frameY + padding;
             } else {
                 // When not maximized, we need a tiny top margin for the window border
                 // On Windows 11, this is typically 1 pixel
-                if (IsWindows11OrGreater()) {
+                if ((Capabilities().flags & CAPABILITY_WINDOWS_11) != 0) {
                     // Windows 11 has a visible 1px top border that we want to keep
                     // Don't add anything to top - let DWM draw the border
                 }
@@ -438,24 +887,23 @@ LRESULT CALLBACK CustomFrameWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM
                 return dwmResult;
             }
 
-            return HandleCustomFrameHitTest(hWnd, lParam, state);
+            return HandleFrameHitTest(hWnd, lParam, state);
         }
 
         // WM_NCACTIVATE - Prevent default non-client rendering
         if (uMsg == WM_NCACTIVATE) {
             // Return TRUE and set lParam to -1 to prevent non-client area redraw
-            if (state.originalWndProc) {
-                return CallWindowProc(state.originalWndProc, hWnd, uMsg, wParam, -1);
+            if (cold.originalWndProc) {
+                return CallWindowProc(cold.originalWndProc, hWnd, uMsg, wParam, -1);
             }
             return TRUE;
         }
 
         // WM_SETCURSOR - Show appropriate cursor
         if (uMsg == WM_SETCURSOR) {
-            WORD hitTest = LOWORD(lParam);
-            HCURSOR cursor = GetCursorForHitTest(hitTest);
+            HCURSOR cursor = GetCursorForHit(FromWin32HitTest(LOWORD(lParam)));
             if (cursor != nullptr) {
-                SetCursor(cursor);
+                SetHoverCursor(state, cursor);
                 return TRUE;
             }
         }
@@ -476,23 +924,23 @@ LRESULT CALLBACK CustomFrameWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM
         if (uMsg == WM_GETMINMAXINFO) {
             // First, let the original WndProc (Flutter) set its min/max constraints
             LRESULT result = 0;
-            if (state.originalWndProc) {
-                result = CallWindowProc(state.originalWndProc, hWnd, uMsg, wParam, lParam);
+            if (cold.originalWndProc) {
+                result = CallWindowProc(cold.originalWndProc, hWnd, uMsg, wParam, lParam);
             }
 
             MINMAXINFO* mmi = reinterpret_cast<MINMAXINFO*>(lParam);
 
-            // Get the monitor this window is on
-            HMONITOR monitor = MonitorFromWindow(hWnd, MONITOR_DEFAULTTONEAREST);
-            MONITORINFO mi = { sizeof(mi) };
-            if (GetMonitorInfo(monitor, &mi)) {
+            // Get the monitor this window is on from the cached topology
+            WatchMonitorTopology(hWnd);
+            MonitorInfo monitor;
+            if (FindWindowMonitor(hWnd, &monitor)) {
                 // Only adjust the maximized position and size
                 // This ensures the window doesn't go under the taskbar when maximized
                 // The min/max tracking size constraints from Flutter are preserved
-                mmi->ptMaxPosition.x = mi.rcWork.left - mi.rcMonitor.left;
-                mmi->ptMaxPosition.y = mi.rcWork.top - mi.rcMonitor.top;
-                mmi->ptMaxSize.x = mi.rcWork.right - mi.rcWork.left;
-                mmi->ptMaxSize.y = mi.rcWork.bottom - mi.rcWork.top;
+                mmi->ptMaxPosition.x = monitor.workArea.left - monitor.bounds.left;
+                mmi->ptMaxPosition.y = monitor.workArea.top - monitor.bounds.top;
+                mmi->ptMaxSize.x = monitor.workArea.right - monitor.workArea.left;
+                mmi->ptMaxSize.y = monitor.workArea.bottom - monitor.workArea.top;
             }
 
             return result;
@@ -505,24 +953,23 @@ LRESULT CALLBACK CustomFrameWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM
                 return dwmResult;
             }
 
-            LRESULT hitTest = HandleHiddenFrameHitTest(hWnd, lParam);
+            LRESULT hitTest = HandleFrameHitTest(hWnd, lParam, state);
             if (hitTest != HTCLIENT) {
                 return hitTest;
             }
         }
 
         if (uMsg == WM_SETCURSOR) {
-            WORD hitTest = LOWORD(lParam);
-            HCURSOR cursor = GetCursorForHitTest(hitTest);
+            HCURSOR cursor = GetCursorForHit(FromWin32HitTest(LOWORD(lParam)));
             if (cursor != nullptr) {
-                SetCursor(cursor);
+                SetHoverCursor(state, cursor);
                 return TRUE;
             }
         }
 
         if (uMsg == WM_NCACTIVATE) {
-            if (state.originalWndProc) {
-                return CallWindowProc(state.originalWndProc, hWnd, uMsg, wParam, -1);
+            if (cold.originalWndProc) {
+                return CallWindowProc(cold.originalWndProc, hWnd, uMsg, wParam, -1);
             }
             return TRUE;
         }
@@ -531,11 +978,10 @@ LRESULT CALLBACK CustomFrameWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM
             NCCALCSIZE_PARAMS* params = reinterpret_cast<NCCALCSIZE_PARAMS*>(lParam);
             RECT originalRect = params->rgrc[0];
 
-            if (IsZoomed(hWnd)) {
-                UINT dpi = GetDpiForWindowSafe(hWnd);
-                int frameThickness = GetSystemMetricsForDpiSafe(SM_CXFRAME, dpi);
-                int borderPadding = GetSystemMetricsForDpiSafe(SM_CXPADDEDBORDER, dpi);
-                int totalPadding = frameThickness + borderPadding;
+            GetFrameGeometry(hWnd, state);
+            if (state.geometry.placement().isMaximized) {
+                const FrameMetrics& metrics = state.geometry.metrics();
+                int totalPadding = metrics.frameX + metrics.padding;
 
                 params->rgrc[0].top = originalRect.top + totalPadding;
                 params->rgrc[0].left = originalRect.left + totalPadding;
@@ -550,49 +996,858 @@ LRESULT CALLBACK CustomFrameWndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM
         }
     }
 
-    if (state.originalWndProc) {
-        return CallWindowProc(state.originalWndProc, hWnd, uMsg, wParam, lParam);
+    if (cold.originalWndProc) {
+        return CallWindowProc(cold.originalWndProc, hWnd, uMsg, wParam, lParam);
     }
     return DefWindowProc(hWnd, uMsg, wParam, lParam);
 }
 
 // ==========================================================================
-// Exported Functions (called from Dart via FFI)
+// Cross-thread calls
 // ==========================================================================
 
-// Enable custom frame mode (Windows 11 File Explorer style)
-extern "C" __declspec(dllexport) void EnableCustomFrameMode(HWND hwnd, int captionHeight) {
-    auto it = g_window_states.find(hwnd);
+// A call forwarded to a window's UI thread
+struct WindowThreadCall {
+    void (*run)(void* context);
+    void* context;
+    bool done;
+};
+
+// Calls in flight. The hook only runs calls listed here, so a forged
+// message can't make it jump through an arbitrary pointer.
+static std::mutex g_window_thread_calls_mutex;
+static std::vector<WindowThreadCall*> g_window_thread_calls;
+
+static UINT WindowThreadCallMessage() {
+    static const UINT message = RegisterWindowMessage(L"WindowDecorationWindowThreadCall");
+    return message;
+}
+
+static bool IsPendingWindowThreadCall(const WindowThreadCall* call) {
+    std::lock_guard<std::mutex> lock(g_window_thread_calls_mutex);
+    return std::find(g_window_thread_calls.begin(), g_window_thread_calls.end(), call) !=
+           g_window_thread_calls.end();
+}
+
+// WH_CALLWNDPROC hook: runs a forwarded call on the window's thread. It
+// stays installed, so every other sent message only costs the id compare.
+static LRESULT CALLBACK WindowThreadCallProc(int nCode, WPARAM wParam, LPARAM lParam) {
+    if (nCode == HC_ACTION) {
+        const CWPSTRUCT* message = reinterpret_cast<const CWPSTRUCT*>(lParam);
+        if (message->message == WindowThreadCallMessage()) {
+            WindowThreadCall* call = reinterpret_cast<WindowThreadCall*>(message->lParam);
+            // Hooks of several callers may see the same message; run it once
+            if (IsPendingWindowThreadCall(call) && !call->done) {
+                call->done = true;
+                call->run(call->context);
+            }
+        }
+    }
+    return CallNextHookEx(nullptr, nCode, wParam, lParam);
+}
+
+// The WH_CALLWNDPROC hook of a UI thread that calls were forwarded to
+struct WindowThreadHook {
+    DWORD thread;
+    HHOOK hook;
+};
+
+// One hook per UI thread, installed by the first call forwarded to it and
+// kept until the thread's last window goes, so later calls cost one
+// SendMessage. Few threads ever own windows.
+static std::mutex g_window_thread_hooks_mutex;
+static std::vector<WindowThreadHook> g_window_thread_hooks;
+
+// Make sure thread has the forwarding hook. With reinstall the hook is
+// replaced: it went with its thread when the thread id was reused.
+static bool EnsureWindowThreadHook(DWORD thread, bool reinstall) {
+    std::lock_guard<std::mutex> lock(g_window_thread_hooks_mutex);
+    for (WindowThreadHook& entry : g_window_thread_hooks) {
+        if (entry.thread != thread) continue;
+        if (entry.hook != nullptr && !reinstall) return true;
+        if (entry.hook != nullptr) {
+            UnhookWindowsHookEx(entry.hook);
+        }
+        entry.hook = SetWindowsHookEx(WH_CALLWNDPROC, WindowThreadCallProc, nullptr, thread);
+        return entry.hook != nullptr;
+    }
+    HHOOK hook = SetWindowsHookEx(WH_CALLWNDPROC, WindowThreadCallProc, nullptr, thread);
+    if (hook == nullptr) return false;
+    g_window_thread_hooks.push_back({ thread, hook });
+    return true;
+}
+
+// Remove thread's forwarding hook once it has no windows left. A call
+// forwarded meanwhile reinstalls it on its second attempt.
+static void DropWindowThreadHook(DWORD thread) {
+    std::lock_guard<std::mutex> lock(g_window_thread_hooks_mutex);
+    for (auto it = g_window_thread_hooks.begin(); it != g_window_thread_hooks.end(); ++it) {
+        if (it->thread != thread) continue;
+        if (it->hook != nullptr) {
+            UnhookWindowsHookEx(it->hook);
+        }
+        g_window_thread_hooks.erase(it);
+        return;
+    }
+}
+
+// Run run(context) on the thread that owns hwnd. Window state lives in the
+// owning thread's shard, so calls made on any other thread are forwarded
+// synchronously with a registered message, run by that thread's
+// forwarding hook.
+static void CallOnWindowThread(HWND hwnd, void (*run)(void*), void* context) {
+    DWORD owner = GetWindowThreadProcessId(hwnd, nullptr);
+    if (owner == 0 || owner == GetCurrentThreadId()) {
+        run(context);
+        return;
+    }
+
+    WindowThreadCall call = { run, context, false };
+    {
+        std::lock_guard<std::mutex> lock(g_window_thread_calls_mutex);
+        g_window_thread_calls.push_back(&call);
+    }
+
+    // A second attempt reinstalls a hook that didn't run the call
+    for (int attempt = 0; attempt < 2 && !call.done; attempt++) {
+        if (!EnsureWindowThreadHook(owner, attempt > 0)) break;
+        SendMessage(hwnd, WindowThreadCallMessage(), 0, reinterpret_cast<LPARAM>(&call));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(g_window_thread_calls_mutex);
+        g_window_thread_calls.erase(
+            std::find(g_window_thread_calls.begin(), g_window_thread_calls.end(), &call));
+    }
+}
+
+// Run fn() on the thread that owns hwnd and return its result (a
+// value-initialized result if the call could not be forwarded)
+template <typename Fn>
+static auto RunOnWindowThread(HWND hwnd, Fn fn) -> decltype(fn()) {
+    typedef decltype(fn()) Result;
+    if constexpr (std::is_void<Result>::value) {
+        CallOnWindowThread(hwnd, [](void* context) { (*static_cast<Fn*>(context))(); }, &fn);
+    } else {
+        Result result = Result();
+        auto call = [&fn, &result]() { result = fn(); };
+        CallOnWindowThread(hwnd, [](void* context) { (*static_cast<decltype(call)*>(context))(); }, &call);
+        return result;
+    }
+}
+
+// Start intercepting a newly managed window with the current interception
+// mode: subclass its content view, or join the calling thread's hook
+static void StartInterception(HWND hwnd, WindowTable::Shard* shard, WindowState& state, WindowColdState& cold) {
+    state.interception = g_interception_mode.load(std::memory_order_relaxed);
+    if (state.interception == InterceptionMode::Subclass) {
+        cold.view = GetWindow(hwnd, GW_CHILD);
+        if (cold.view != nullptr &&
+            SetWindowSubclass(cold.view, ViewSubclassProc, VIEW_SUBCLASS_ID, reinterpret_cast<DWORD_PTR>(hwnd))) {
+            return;
+        }
+        // No content view yet: fall back to the thread hook
+        cold.view = nullptr;
+        state.interception = InterceptionMode::ThreadHook;
+    }
+
+    if (shard->thread.hookWindows++ == 0 && shard->thread.getMsgHook == nullptr) {
+        shard->thread.getMsgHook = SetWindowsHookEx(WH_GETMESSAGE, GetMsgProc, nullptr, GetCurrentThreadId());
+    }
+}
+
+// Undo StartInterception; the thread's hook goes with its last hooked window
+static void StopInterception(WindowTable::Shard* shard, WindowState& state, WindowColdState& cold) {
+    if (state.interception == InterceptionMode::Subclass) {
+        if (cold.view != nullptr) {
+            RemoveWindowSubclass(cold.view, ViewSubclassProc, VIEW_SUBCLASS_ID);
+            cold.view = nullptr;
+        }
+        return;
+    }
+
+    if (--shard->thread.hookWindows == 0 && shard->thread.getMsgHook != nullptr) {
+        UnhookWindowsHookEx(shard->thread.getMsgHook);
+        shard->thread.getMsgHook = nullptr;
+    }
+}
+
+// Stop managing a window: leave the shared registry, drop the frame mode
+// property, stop intercepting and remove its hot and cold state. The
+// shard's last window takes the thread's hooks and the shard with it, so a
+// thread that later gets the same id starts clean; shard is invalid then.
+// Runs on the window's thread, when it is restored or destroyed; the
+// caller restores the window procedure if the window lives on.
+static void ReleaseManagedWindow(HWND hwnd, WindowTable::Shard* shard, uint32_t slot) {
+    WindowColdState& cold = shard->windows.cold(slot);
+    if (cold.sharedSlot != 0) {
+        g_shared_windows.Release(cold.sharedSlot - 1, GetCurrentProcessId());
+        cold.sharedSlot = 0;
+    }
+    RemovePropW(hwnd, FRAME_MODE_PROP);
+
+    StopInterception(shard, shard->windows.hot(slot), cold);
+    if (g_windows.Unregister(GetCurrentThreadId(), hwnd)) {
+        if (shard->thread.getMsgHook != nullptr) {
+            UnhookWindowsHookEx(shard->thread.getMsgHook);
+        }
+        g_windows.Retire(GetCurrentThreadId());
+        DropWindowThreadHook(GetCurrentThreadId());
+    }
+}
+
+// Bounds, monitor, DPI and show state of a window (everything but the
+// frame mode, which lives on the window's thread). From other threads pass
+// fromAnyThread to look the monitor up without waiting or allocating.
+static WindowStateInfo QueryWindowStateInfo(HWND hwnd, bool fromAnyThread = false) {
+    WindowStateInfo info = {};
+
+    RECT rect;
+    GetWindowRect(hwnd, &rect);
+    info.bounds = { rect.left, rect.top, rect.right, rect.bottom };
+
+    MonitorInfo monitor = {};
+    if (fromAnyThread) {
+        PeekWindowMonitor(hwnd, &monitor);
+    } else {
+        FindWindowMonitor(hwnd, &monitor);
+    }
+    info.monitor = monitor.bounds;
+    info.workArea = monitor.workArea;
+    info.dpi = GetDpiForWindowSafe(hwnd);
+
+    info.flags = WINDOW_STATE_VALID;
+    if (IsWindowVisible(hwnd)) info.flags |= WINDOW_STATE_VISIBLE;
+    if (GetForegroundWindow() == hwnd) info.flags |= WINDOW_STATE_FOCUSED;
+    if (IsZoomed(hwnd)) info.flags |= WINDOW_STATE_MAXIMIZED;
+    if (IsIconic(hwnd)) info.flags |= WINDOW_STATE_MINIMIZED;
+
+    // Fullscreen: the client area covers the whole monitor
+    RECT client;
+    GetClientRect(hwnd, &client);
+    POINT clientOrigin = { 0, 0 };
+    ClientToScreen(hwnd, &clientOrigin);
+    if (!IsIconic(hwnd) &&
+        clientOrigin.x <= monitor.bounds.left && clientOrigin.y <= monitor.bounds.top &&
+        clientOrigin.x + client.right >= monitor.bounds.right &&
+        clientOrigin.y + client.bottom >= monitor.bounds.bottom) {
+        info.flags |= WINDOW_STATE_FULLSCREEN;
+    }
+    return info;
+}
+
+// Query the window's state and publish it to its state block. Runs on the
+// window's thread, so the frame mode is read directly.
+static void PublishWindowStateBlock(HWND hwnd, WindowStatePublisher& publisher) {
+    WindowStateInfo& info = publisher.state();
+    info = QueryWindowStateInfo(hwnd);
+    WindowState* state = FindWindowState(hwnd);
+    info.frameMode = static_cast<int32_t>(state != nullptr ? state->frameMode : FrameMode::Normal);
+    publisher.Publish();
+}
+
+// Subclass procedure on a top-level window with a state block. refData is
+// the block's publisher. Every move, resize, show state change and frame
+// mode change (the exports end those with SetWindowPos(SWP_FRAMECHANGED))
+// arrives as WM_WINDOWPOSCHANGED; the state is republished after the
+// window has handled it.
+static LRESULT CALLBACK StateSubclassProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam,
+                                          UINT_PTR, DWORD_PTR refData) {
+    WindowStatePublisher* publisher = reinterpret_cast<WindowStatePublisher*>(refData);
+    if (uMsg == WM_NCDESTROY) {
+        RemoveWindowSubclass(hWnd, StateSubclassProc, STATE_SUBCLASS_ID);
+        g_state_blocks.Release(publisher->block());
+        delete publisher;
+        return DefSubclassProc(hWnd, uMsg, wParam, lParam);
+    }
+
+    LRESULT result = DefSubclassProc(hWnd, uMsg, wParam, lParam);
+    switch (uMsg) {
+        case WM_DPICHANGED:
+        case WM_DISPLAYCHANGE:
+        case WM_SETTINGCHANGE:  // work area changes
+            // This window may not be the monitor watcher
+            g_monitors_stale.store(true);
+            PublishWindowStateBlock(hWnd, *publisher);
+            break;
+        case WM_WINDOWPOSCHANGED:
+        case WM_ACTIVATE:
+            PublishWindowStateBlock(hWnd, *publisher);
+            break;
+    }
+    return result;
+}
+
+// ==========================================================================
+// Window Animation
+// ==========================================================================
+
+// A window's bounds and opacity animation. Owned by the window's animation
+// subclass (refData) and used on the window's thread, except for
+// tickPending, which the pacing thread sets.
+struct WindowAnimator {
+    HWND hwnd;
+    WindowAnimation animation;
+
+    // Display refresh period when the animation started (0 if unknown)
+    int64_t refreshIntervalNs;
+
+    // Port told how the running animation ended (1 target reached, 0
+    // stopped early), 0 for none
+    DartPostCObjectFn post;
+    int64_t port;
+
+    // A tick is posted and not handled yet, so a busy window never has
+    // more than one queued
+    std::atomic<bool> tickPending;
+};
+
+static const UINT_PTR ANIMATION_SUBCLASS_ID = 4;
+
+// Animators with a running animation. One pacing thread, started on first
+// use, waits for each DWM composition pass (DwmFlush) while this is not
+// empty and posts every window a tick, so all animations step once per
+// displayed frame and the thread sleeps while nothing animates.
+static std::mutex g_animators_mutex;
+static std::condition_variable g_animators_changed;
+static std::vector<WindowAnimator*> g_animators;
+static bool g_animation_thread_started = false;
+
+static UINT AnimationTickMessage() {
+    static const UINT message = RegisterWindowMessage(L"WindowDecorationAnimationTick");
+    return message;
+}
+
+static void AnimationThreadMain() {
+    std::unique_lock<std::mutex> lock(g_animators_mutex);
+    while (true) {
+        g_animators_changed.wait(lock, []() { return !g_animators.empty(); });
+        lock.unlock();
+        // Without composition there is no pass to wait for; tick at 60 Hz
+        if (FAILED(DwmFlush())) {
+            Sleep(16);
+        }
+        lock.lock();
+        for (WindowAnimator* animator : g_animators) {
+            if (!animator->tickPending.exchange(true)) {
+                PostMessage(animator->hwnd, AnimationTickMessage(), 0, 0);
+            }
+        }
+    }
+}
+
+static void StartAnimationTicks(WindowAnimator* animator) {
+    std::lock_guard<std::mutex> lock(g_animators_mutex);
+    if (std::find(g_animators.begin(), g_animators.end(), animator) == g_animators.end()) {
+        g_animators.push_back(animator);
+    }
+    if (!g_animation_thread_started) {
+        std::thread(AnimationThreadMain).detach();
+        g_animation_thread_started = true;
+    }
+    g_animators_changed.notify_one();
+}
+
+static void StopAnimationTicks(WindowAnimator* animator) {
+    std::lock_guard<std::mutex> lock(g_animators_mutex);
+    g_animators.erase(std::remove(g_animators.begin(), g_animators.end(), animator), g_animators.end());
+}
+
+// Convert QueryPerformanceCounter ticks to nanoseconds without overflowing
+static int64_t QpcToNs(int64_t ticks) {
+    static const int64_t frequency = []() {
+        LARGE_INTEGER value;
+        QueryPerformanceFrequency(&value);
+        return static_cast<int64_t>(value.QuadPart);
+    }();
+    return ticks / frequency * 1000000000 + ticks % frequency * 1000000000 / frequency;
+}
+
+static int64_t QueryRefreshIntervalNs() {
+    DWM_TIMING_INFO timing = {};
+    timing.cbSize = sizeof(timing);
+    if (DwmGetCompositionTimingInfo(nullptr, &timing) != S_OK) {
+        return 0;
+    }
+    return QpcToNs(static_cast<int64_t>(timing.qpcRefreshPeriod));
+}
+
+static void PostAnimationResult(WindowAnimator& animator, bool completed) {
+    if (animator.port != 0) {
+        window_decoration::PostInt64(animator.post, animator.port, completed ? 1 : 0);
+        animator.port = 0;
+    }
+}
+
+// Bounds to animate from: the window rect, or the restored rect of a
+// minimized window
+static RECT GetAnimatedRect(HWND hwnd) {
+    RECT rect;
+    if (IsIconic(hwnd)) {
+        WINDOWPLACEMENT placement = {};
+        placement.length = sizeof(placement);
+        GetWindowPlacement(hwnd, &placement);
+        rect = placement.rcNormalPosition;
+    } else {
+        GetWindowRect(hwnd, &rect);
+    }
+    return rect;
+}
+
+// Opacity set with SetLayeredWindowAttributes, 1.0 if none
+static double GetLayeredOpacity(HWND hwnd) {
+    BYTE alpha = 255;
+    DWORD flags = 0;
+    if ((GetWindowLongPtr(hwnd, GWL_EXSTYLE) & WS_EX_LAYERED) == 0 ||
+        !GetLayeredWindowAttributes(hwnd, nullptr, &alpha, &flags) || (flags & LWA_ALPHA) == 0) {
+        return 1.0;
+    }
+    return alpha / 255.0;
+}
+
+// Apply a frame with a single SetWindowPos (SWP_NOMOVE or SWP_NOSIZE when
+// only one of them changes) and, for opacity, one
+// SetLayeredWindowAttributes. A minimized window gets the bounds as its
+// restored rect instead.
+static void ApplyAnimationFrame(HWND hwnd, const WindowAnimationFrame& frame) {
+    if (frame.changed & ANIMATE_BOUNDS) {
+        RECT target = { frame.bounds.left, frame.bounds.top, frame.bounds.right, frame.bounds.bottom };
+        if (IsIconic(hwnd)) {
+            WINDOWPLACEMENT placement = {};
+            placement.length = sizeof(placement);
+            GetWindowPlacement(hwnd, &placement);
+            placement.rcNormalPosition = target;
+            SetWindowPlacement(hwnd, &placement);
+        } else {
+            RECT current;
+            GetWindowRect(hwnd, &current);
+            UINT flags = SWP_NOZORDER | SWP_NOACTIVATE;
+            if (target.left == current.left && target.top == current.top) flags |= SWP_NOMOVE;
+            if (target.right - target.left == current.right - current.left &&
+                target.bottom - target.top == current.bottom - current.top) {
+                flags |= SWP_NOSIZE;
+            }
+            if ((flags & (SWP_NOMOVE | SWP_NOSIZE)) != (SWP_NOMOVE | SWP_NOSIZE)) {
+                SetWindowPos(hwnd, nullptr, target.left, target.top, target.right - target.left,
+                             target.bottom - target.top, flags);
+            }
+        }
+    }
+    if (frame.changed & ANIMATE_OPACITY) {
+        LONG_PTR exStyle = GetWindowLongPtr(hwnd, GWL_EXSTYLE);
+        if ((exStyle & WS_EX_LAYERED) == 0) {
+            SetWindowLongPtr(hwnd, GWL_EXSTYLE, exStyle | WS_EX_LAYERED);
+        }
+        SetLayeredWindowAttributes(hwnd, 0, static_cast<BYTE>(std::lround(frame.opacity * 255)), LWA_ALPHA);
+    }
+}
+
+// Step a window's animation to the current time. Runs on the tick.
+static void StepAnimation(WindowAnimator& animator) {
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+
+    WindowAnimationFrame frame;
+    if (!animator.animation.Step(QpcToNs(now.QuadPart), animator.refreshIntervalNs, &frame)) {
+        StopAnimationTicks(&animator);
+        return;
+    }
+    ApplyAnimationFrame(animator.hwnd, frame);
+    if (frame.finished) {
+        StopAnimationTicks(&animator);
+        PostAnimationResult(animator, true);
+    }
+}
+
+// Subclass procedure on an animated top-level window. refData is its
+// animator, kept after the animation ends for its counters.
+static LRESULT CALLBACK AnimationSubclassProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam,
+                                              UINT_PTR, DWORD_PTR refData) {
+    WindowAnimator* animator = reinterpret_cast<WindowAnimator*>(refData);
+    if (uMsg == AnimationTickMessage()) {
+        animator->tickPending.store(false);
+        StepAnimation(*animator);
+        return 0;
+    }
+    if (uMsg == WM_NCDESTROY) {
+        RemoveWindowSubclass(hWnd, AnimationSubclassProc, ANIMATION_SUBCLASS_ID);
+        StopAnimationTicks(animator);
+        PostAnimationResult(*animator, false);
+        delete animator;
+    }
+    return DefSubclassProc(hWnd, uMsg, wParam, lParam);
+}
+
+// The window's animator, nullptr if it was never animated. Runs on the
+// window's thread.
+static WindowAnimator* FindWindowAnimator(HWND hwnd) {
+    DWORD_PTR refData = 0;
+    if (!GetWindowSubclass(hwnd, AnimationSubclassProc, ANIMATION_SUBCLASS_ID, &refData)) {
+        return nullptr;
+    }
+    return reinterpret_cast<WindowAnimator*>(refData);
+}
+
+// Stop a window's animation where it is. Returns false if none was running.
+// Runs on the window's thread.
+static bool CancelAnimation(HWND hwnd) {
+    WindowAnimator* animator = FindWindowAnimator(hwnd);
+    if (animator == nullptr || !animator->animation.Cancel()) {
+        return false;
+    }
+    StopAnimationTicks(animator);
+    PostAnimationResult(*animator, false);
+    return true;
+}
+
+// Animate from the window's current bounds and opacity, replacing a
+// running animation. A hidden window isn't composed, so it jumps to the
+// target right away. Runs on the window's thread.
+static bool StartAnimation(HWND hwnd, const WindowAnimationParams& params, DartPostCObjectFn post, int64_t port) {
+    WindowAnimator* animator = FindWindowAnimator(hwnd);
+    if (animator == nullptr) {
+        animator = new WindowAnimator();
+        animator->hwnd = hwnd;
+        animator->refreshIntervalNs = 0;
+        animator->post = nullptr;
+        animator->port = 0;
+        animator->tickPending.store(false);
+        if (!SetWindowSubclass(hwnd, AnimationSubclassProc, ANIMATION_SUBCLASS_ID,
+                               reinterpret_cast<DWORD_PTR>(animator))) {
+            delete animator;
+            return false;
+        }
+    }
+
+    if (!animator->animation.Start(params, ToCoreRect(GetAnimatedRect(hwnd)), GetLayeredOpacity(hwnd))) {
+        return false;
+    }
+    PostAnimationResult(*animator, false);
+    animator->post = post;
+    animator->port = post != nullptr ? port : 0;
+
+    if (!IsWindowVisible(hwnd)) {
+        StopAnimationTicks(animator);
+        WindowAnimationFrame frame;
+        animator->animation.Finish(&frame);
+        ApplyAnimationFrame(hwnd, frame);
+        PostAnimationResult(*animator, true);
+        return true;
+    }
+
+    animator->refreshIntervalNs = QueryRefreshIntervalNs();
+    StartAnimationTicks(animator);
+    return true;
+}
 
-    if (it == g_window_states.end()) {
-        WindowState state = {};
-        state.frameMode = FrameMode::CustomFrame;
-        state.captionHeight = captionHeight > 0 ? captionHeight : DEFAULT_CAPTION_HEIGHT;
-        state.hasCaptionButtons = false;
+// ==========================================================================
+// Window Layouts
+// ==========================================================================
 
-        state.originalWndProc = reinterpret_cast<WNDPROC>(
-            SetWindowLongPtr(hwnd, GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(CustomFrameWndProc))
-        );
+// Saved layouts of the app's windows, read once from g_layouts_path when
+// the store is opened and shared by all UI threads under
+// g_layouts_mutex. Each tracked window restarts its own timer on every
+// change; the store is written when a timer fires LAYOUT_SAVE_DELAY_MS
+// after the window's last change.
+static WindowLayoutStore g_layouts;
+static std::wstring g_layouts_path;
+static std::mutex g_layouts_mutex;
+static const UINT_PTR LAYOUT_SUBCLASS_ID = 5;
+static const UINT_PTR LAYOUT_SAVE_TIMER_ID = 0x57444C53;  // "WDLS"
+static const UINT LAYOUT_SAVE_DELAY_MS = 500;
+
+// A window's id and last restored layout. Owned by the window's layout
+// subclass (refData) and used on the window's thread.
+struct LayoutTracker {
+    char id[MAX_WINDOW_LAYOUT_ID_BYTES + 1];
+    WindowLayout layout;
+    bool maximizeOnShow;  // restored maximized while hidden
+};
 
-        g_window_states[hwnd] = state;
+// Map the layout file and load the store from it. A missing file is an
+// empty store. The caller holds g_layouts_mutex.
+static bool LoadLayoutFile(const std::wstring& path) {
+    g_layouts.Clear();
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        DWORD error = GetLastError();
+        return error == ERROR_FILE_NOT_FOUND || error == ERROR_PATH_NOT_FOUND;
+    }
 
-        if (g_getmsg_hook == nullptr) {
-            DWORD threadId = GetWindowThreadProcessId(hwnd, nullptr);
-            g_getmsg_hook = SetWindowsHookEx(WH_GETMESSAGE, GetMsgProc, nullptr, threadId);
+    bool loaded = false;
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size)) {
+        if (size.QuadPart == 0) {
+            loaded = g_layouts.Load(nullptr, 0);
+        } else {
+            HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping != nullptr) {
+                const void* image = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (image != nullptr) {
+                    loaded = g_layouts.Load(image, static_cast<size_t>(size.QuadPart));
+                    UnmapViewOfFile(image);
+                }
+                CloseHandle(mapping);
+            }
         }
-        g_hook_ref_count++;
+    }
+    CloseHandle(file);
+    return loaded;
+}
+
+// Write the store to a temporary file next to the layout file, flush it to
+// disk and move it over the old one, so a crash at any point leaves either
+// the old or the new file. The caller holds g_layouts_mutex.
+static bool SaveLayoutFile() {
+    if (g_layouts_path.empty()) {
+        return false;
+    }
+
+    std::vector<uint8_t> image(g_layouts.EncodedSize());
+    g_layouts.Encode(image.data(), image.size());
+    std::wstring temporary = g_layouts_path + L".tmp";
+    HANDLE file = CreateFileW(temporary.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    DWORD written = 0;
+    bool saved = WriteFile(file, image.data(), static_cast<DWORD>(image.size()), &written, nullptr) &&
+                 written == image.size() && FlushFileBuffers(file);
+    CloseHandle(file);
+    if (!saved ||
+        !MoveFileExW(temporary.c_str(), g_layouts_path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        DeleteFileW(temporary.c_str());
+        return false;
+    }
+
+    g_layouts.MarkClean();
+    return true;
+}
+
+// Save pending changes now. Returns false if writing failed.
+static bool FlushLayouts() {
+    std::lock_guard<std::mutex> lock(g_layouts_mutex);
+    return !g_layouts.dirty() || SaveLayoutFile();
+}
+
+// Fingerprint of the monitor holding most of a window rect, 0 without
+// monitors
+static uint64_t FingerprintMonitorOf(const Rect& bounds) {
+    RECT rect = { bounds.left, bounds.top, bounds.right, bounds.bottom };
+    MonitorInfo monitor;
+    return FindMonitorForRect(rect, &monitor) ? MonitorFingerprint(monitor) : 0;
+}
+
+// Put the window's current layout into the store and restart its save
+// timer if that changed anything. Only restored geometry is saved: while
+// maximized, fullscreen or minimized the bounds from before are kept, and
+// nothing is recorded while the window is hidden (it is still being set
+// up, e.g. by RestoreLayout).
+static void RecordWindowLayout(HWND hwnd, LayoutTracker& tracker) {
+    if (!IsWindowVisible(hwnd)) {
+        return;
+    }
+    WindowStateInfo info = QueryWindowStateInfo(hwnd);
+    const uint32_t notRestored = WINDOW_STATE_MAXIMIZED | WINDOW_STATE_MINIMIZED | WINDOW_STATE_FULLSCREEN;
+    if ((info.flags & notRestored) == 0) {
+        tracker.layout.bounds = info.bounds;
+        tracker.layout.monitor = FingerprintMonitorOf(info.bounds);
+    }
+    tracker.layout.flags = 0;
+    if (info.flags & WINDOW_STATE_MAXIMIZED) tracker.layout.flags |= WINDOW_LAYOUT_MAXIMIZED;
+    if (info.flags & WINDOW_STATE_FULLSCREEN) tracker.layout.flags |= WINDOW_LAYOUT_FULLSCREEN;
+    WindowState* state = FindWindowState(hwnd);
+    tracker.layout.frameMode = static_cast<int32_t>(state != nullptr ? state->frameMode : FrameMode::Normal);
+
+    bool changed;
+    {
+        std::lock_guard<std::mutex> lock(g_layouts_mutex);
+        g_layouts.Put(tracker.id, tracker.layout);
+        changed = g_layouts.dirty() && !g_layouts_path.empty();
+    }
+    if (changed) {
+        SetTimer(hwnd, LAYOUT_SAVE_TIMER_ID, LAYOUT_SAVE_DELAY_MS, nullptr);
+    }
+}
+
+// Subclass procedure on a window with a tracked layout. refData is its
+// tracker. A closing window is a likely last change before the app exits,
+// so the store is saved right away.
+static LRESULT CALLBACK LayoutSubclassProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam,
+                                           UINT_PTR, DWORD_PTR refData) {
+    LayoutTracker* tracker = reinterpret_cast<LayoutTracker*>(refData);
+    switch (uMsg) {
+        case WM_TIMER:
+            if (wParam == LAYOUT_SAVE_TIMER_ID) {
+                KillTimer(hWnd, LAYOUT_SAVE_TIMER_ID);
+                FlushLayouts();
+                return 0;
+            }
+            break;
+        case WM_NCDESTROY:
+            KillTimer(hWnd, LAYOUT_SAVE_TIMER_ID);
+            RemoveWindowSubclass(hWnd, LayoutSubclassProc, LAYOUT_SUBCLASS_ID);
+            delete tracker;
+            FlushLayouts();
+            return DefSubclassProc(hWnd, uMsg, wParam, lParam);
+    }
+
+    LRESULT result = DefSubclassProc(hWnd, uMsg, wParam, lParam);
+    if (uMsg == WM_WINDOWPOSCHANGED) {
+        RecordWindowLayout(hWnd, *tracker);
+    } else if (uMsg == WM_SHOWWINDOW && wParam && tracker->maximizeOnShow) {
+        // Runners show with SW_SHOWNORMAL, which would undo a maximize made
+        // while hidden; maximize once that is done
+        tracker->maximizeOnShow = false;
+        PostMessage(hWnd, WM_SYSCOMMAND, SC_MAXIMIZE, 0);
+    }
+    return result;
+}
+
+// Place a window from the layout saved under id and track its layout
+// under id from now on. A window left maximized is maximized again, right
+// away if it is visible or else as soon as it is shown. Fullscreen is
+// reported, not applied. Runs on the window's thread.
+static LayoutRestore RestoreLayout(HWND hwnd, const char* id, WindowLayout* restored) {
+    size_t length = std::strlen(id);
+    if (length == 0 || length > MAX_WINDOW_LAYOUT_ID_BYTES) {
+        return LayoutRestore::None;
+    }
+
+    LayoutTracker* tracker = nullptr;
+    DWORD_PTR refData = 0;
+    if (GetWindowSubclass(hwnd, LayoutSubclassProc, LAYOUT_SUBCLASS_ID, &refData)) {
+        tracker = reinterpret_cast<LayoutTracker*>(refData);
     } else {
-        it->second.frameMode = FrameMode::CustomFrame;
-        it->second.captionHeight = captionHeight > 0 ? captionHeight : DEFAULT_CAPTION_HEIGHT;
+        tracker = new LayoutTracker();
+        if (!SetWindowSubclass(hwnd, LayoutSubclassProc, LAYOUT_SUBCLASS_ID, reinterpret_cast<DWORD_PTR>(tracker))) {
+            delete tracker;
+            return LayoutRestore::None;
+        }
+    }
+    std::memset(tracker->id, 0, sizeof(tracker->id));
+    std::memcpy(tracker->id, id, length);
+
+    WindowLayout layout;
+    {
+        std::lock_guard<std::mutex> lock(g_layouts_mutex);
+        if (!g_layouts.Find(id, &layout)) {
+            return LayoutRestore::None;
+        }
+    }
+
+    WatchMonitorTopology(hwnd);
+    Rect bounds;
+    LayoutRestore result;
+    {
+        std::lock_guard<std::mutex> lock(g_monitors_mutex);
+        result = ResolveWindowLayout(CurrentMonitors(), layout, &bounds);
+    }
+    if (result == LayoutRestore::None) {
+        return result;
+    }
+
+    // Maximized and fullscreen windows keep these restored bounds until
+    // they are restored themselves
+    layout.bounds = bounds;
+    layout.monitor = FingerprintMonitorOf(bounds);
+    tracker->layout = layout;
+    tracker->maximizeOnShow = false;
+
+    if (IsZoomed(hwnd) || IsIconic(hwnd)) {
+        ShowWindow(hwnd, SW_RESTORE);
+    }
+    SetWindowPos(hwnd, nullptr, bounds.left, bounds.top, bounds.right - bounds.left, bounds.bottom - bounds.top,
+                 SWP_NOZORDER | SWP_NOACTIVATE);
+    if (layout.flags & WINDOW_LAYOUT_MAXIMIZED) {
+        if (IsWindowVisible(hwnd)) {
+            ShowWindow(hwnd, SW_MAXIMIZE);
+        } else {
+            tracker->maximizeOnShow = true;
+        }
+    }
+    if (restored != nullptr) {
+        *restored = layout;
+    }
+    return result;
+}
+
+// ==========================================================================
+// Initial Decoration
+// ==========================================================================
+
+static const UINT_PTR INITIAL_DECORATION_SUBCLASS_ID = 6;
+
+// DWMWA_CAPTION_COLOR, Windows 11 SDK
+static const DWORD CAPTION_COLOR_ATTRIBUTE = 35;
+
+// Subclass procedure that only owns the decoration a runner applied
+// (refData, a copy) for GetInitialDecoration, and frees it with the window
+static LRESULT CALLBACK InitialDecorationSubclassProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam,
+                                                      UINT_PTR, DWORD_PTR refData) {
+    if (uMsg == WM_NCDESTROY) {
+        RemoveWindowSubclass(hWnd, InitialDecorationSubclassProc, INITIAL_DECORATION_SUBCLASS_ID);
+        delete reinterpret_cast<InitialDecoration*>(refData);
+    }
+    return DefSubclassProc(hWnd, uMsg, wParam, lParam);
+}
+
+// Keep a copy of the decoration applied to a window, replacing an earlier
+// one. Runs on the window's thread.
+static void RememberInitialDecoration(HWND hwnd, const InitialDecoration& decoration) {
+    DWORD_PTR refData = 0;
+    if (GetWindowSubclass(hwnd, InitialDecorationSubclassProc, INITIAL_DECORATION_SUBCLASS_ID, &refData)) {
+        *reinterpret_cast<InitialDecoration*>(refData) = decoration;
+        return;
+    }
+    InitialDecoration* copy = new InitialDecoration(decoration);
+    if (!SetWindowSubclass(hwnd, InitialDecorationSubclassProc, INITIAL_DECORATION_SUBCLASS_ID,
+                           reinterpret_cast<DWORD_PTR>(copy))) {
+        delete copy;
     }
+}
+
+// ==========================================================================
+// Exported Functions (called from Dart via FFI)
+// ==========================================================================
+
+// Enable custom frame mode (Windows 11 File Explorer style)
+extern "C" __declspec(dllexport) void EnableCustomFrameMode(HWND hwnd, int captionHeight) {
+    RunOnWindowThread(hwnd, [&]() {
+        WindowTable::Shard* shard = CurrentShard();
+        uint32_t slot = shard->windows.Find(hwnd);
+
+        if (slot == WindowTable::kNoSlot) {
+            WindowTable::Registration registration = g_windows.Register(GetCurrentThreadId(), hwnd);
+            WindowState& state = shard->windows.hot(registration.slot);
+            SetFrameMode(hwnd, state, FrameMode::CustomFrame);
+            PublishCaptionHeight(state, captionHeight);
+
+            WindowColdState& cold = shard->windows.cold(registration.slot);
+            cold.originalWndProc = reinterpret_cast<WNDPROC>(
+                SetWindowLongPtr(hwnd, GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(CustomFrameWndProc))
+            );
+
+            StartInterception(hwnd, shard, state, cold);
+        } else {
+            WindowState& state = shard->windows.hot(slot);
+            SetFrameMode(hwnd, state, FrameMode::CustomFrame);
+            state.geometry.InvalidateAll();
+            state.hover.Reset();
+            PublishCaptionHeight(state, captionHeight);
+        }
 
-    // Extend frame into client area with -1 margins for proper DWM rendering
-    MARGINS margins = {-1, -1, -1, -1};
-    DwmExtendFrameIntoClientArea(hwnd, &margins);
+        // Extend frame into client area with -1 margins for proper DWM rendering
+        MARGINS margins = {-1, -1, -1, -1};
+        DwmExtendFrameIntoClientArea(hwnd, &margins);
 
-    // Force frame change
-    SetWindowPos(hwnd, nullptr, 0, 0, 0, 0,
-                 SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER | SWP_FRAMECHANGED);
+        // Force frame change
+        SetWindowPos(hwnd, nullptr, 0, 0, 0, 0,
+                     SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER | SWP_FRAMECHANGED);
+    });
 }
 
 // Set caption button zones for hit testing
@@ -602,126 +1857,225 @@ extern "C" __declspec(dllexport) void SetCaptionButtonZones(
     int maxLeft, int maxTop, int maxRight, int maxBottom,
     int closeLeft, int closeTop, int closeRight, int closeBottom
 ) {
-    auto it = g_window_states.find(hwnd);
-    if (it == g_window_states.end()) return;
-
-    WindowState& state = it->second;
-
-    state.minimizeButton = { minLeft, minTop, minRight, minBottom };
-    state.maximizeButton = { maxLeft, maxTop, maxRight, maxBottom };
-    state.closeButton = { closeLeft, closeTop, closeRight, closeBottom };
-    state.hasCaptionButtons = true;
+    RunOnWindowThread(hwnd, [&]() {
+        WindowState* state = FindWindowState(hwnd);
+        if (state == nullptr) return;
+
+        state->captions.Update([&](CaptionSnapshot& snapshot) {
+            snapshot.caption.minimizeButton = { minLeft, minTop, minRight, minBottom };
+            snapshot.caption.maximizeButton = { maxLeft, maxTop, maxRight, maxBottom };
+            snapshot.caption.closeButton = { closeLeft, closeTop, closeRight, closeBottom };
+            snapshot.caption.hasCaptionButtons = true;
+            return true;
+        });
+    });
 }
 
 // Clear caption button zones
 extern "C" __declspec(dllexport) void ClearCaptionButtonZones(HWND hwnd) {
-    auto it = g_window_states.find(hwnd);
-    if (it == g_window_states.end()) return;
+    RunOnWindowThread(hwnd, [&]() {
+        WindowState* state = FindWindowState(hwnd);
+        if (state == nullptr) return;
+
+        state->captions.Update([](CaptionSnapshot& snapshot) {
+            snapshot.caption.hasCaptionButtons = false;
+            return true;
+        });
+    });
+}
 
-    it->second.hasCaptionButtons = false;
+// Add or replace a named caption region (in client coordinates).
+// hit: 1 = client, 2 = caption, 3 = minimize, 4 = maximize, 5 = close
+extern "C" __declspec(dllexport) bool SetCaptionRegion(
+    HWND hwnd, const char* name, int hit,
+    int left, int top, int right, int bottom, int cornerRadius
+) {
+    return RunOnWindowThread(hwnd, [&]() {
+        WindowState* state = FindWindowState(hwnd);
+        if (state == nullptr || name == nullptr) return false;
+        if (hit < static_cast<int>(HitCode::Client) || hit > static_cast<int>(HitCode::Close)) return false;
+
+        CaptionRegion region;
+        region.bounds = { left, top, right, bottom };
+        region.hit = static_cast<HitCode>(hit);
+        region.cornerRadius = cornerRadius;
+        bool changed = state->captions.Update([&](CaptionSnapshot& snapshot) {
+            return snapshot.regions.Set(name, region);
+        });
+        if (changed) PublishSharedWindow(hwnd);
+        return changed;
+    });
+}
+
+// Remove a named caption region
+extern "C" __declspec(dllexport) bool RemoveCaptionRegion(HWND hwnd, const char* name) {
+    return RunOnWindowThread(hwnd, [&]() {
+        WindowState* state = FindWindowState(hwnd);
+        if (state == nullptr || name == nullptr) return false;
+
+        bool changed = state->captions.Update([name](CaptionSnapshot& snapshot) {
+            return snapshot.regions.Remove(name);
+        });
+        if (changed) PublishSharedWindow(hwnd);
+        return changed;
+    });
+}
+
+// Remove all named caption regions
+extern "C" __declspec(dllexport) void ClearCaptionRegions(HWND hwnd) {
+    RunOnWindowThread(hwnd, [&]() {
+        WindowState* state = FindWindowState(hwnd);
+        if (state == nullptr) return;
+
+        state->captions.Update([](CaptionSnapshot& snapshot) {
+            snapshot.regions.Clear();
+            return true;
+        });
+        PublishSharedWindow(hwnd);
+    });
+}
+
+// Set the caption mask from run-length encoded rows (see caption_mask.h).
+// width and height are in logical pixels; length is the number of uint16 values.
+extern "C" __declspec(dllexport) bool SetCaptionMask(
+    HWND hwnd, int width, int height, const uint16_t* runs, int length
+) {
+    return RunOnWindowThread(hwnd, [&]() {
+        WindowState* state = FindWindowState(hwnd);
+        if (state == nullptr || length < 0) return false;
+
+        return state->captions.Update([&](CaptionSnapshot& snapshot) {
+            return snapshot.mask.Set(width, height, runs, static_cast<size_t>(length));
+        });
+    });
+}
+
+// Replace rows [firstRow, firstRow + rowCount) of the caption mask
+extern "C" __declspec(dllexport) bool UpdateCaptionMaskRows(
+    HWND hwnd, int firstRow, int rowCount, const uint16_t* runs, int length
+) {
+    return RunOnWindowThread(hwnd, [&]() {
+        WindowState* state = FindWindowState(hwnd);
+        if (state == nullptr || length < 0) return false;
+
+        return state->captions.Update([&](CaptionSnapshot& snapshot) {
+            return snapshot.mask.UpdateRows(firstRow, rowCount, runs, static_cast<size_t>(length));
+        });
+    });
+}
+
+// Remove the caption mask
+extern "C" __declspec(dllexport) void ClearCaptionMask(HWND hwnd) {
+    RunOnWindowThread(hwnd, [&]() {
+        WindowState* state = FindWindowState(hwnd);
+        if (state == nullptr) return;
+
+        state->captions.Update([](CaptionSnapshot& snapshot) {
+            snapshot.mask.Clear();
+            return true;
+        });
+    });
 }
 
 // Set caption height
 extern "C" __declspec(dllexport) void SetCaptionHeight(HWND hwnd, int height) {
-    auto it = g_window_states.find(hwnd);
-    if (it == g_window_states.end()) return;
+    RunOnWindowThread(hwnd, [&]() {
+        WindowState* state = FindWindowState(hwnd);
+        if (state == nullptr) return;
 
-    it->second.captionHeight = height > 0 ? height : DEFAULT_CAPTION_HEIGHT;
+        PublishCaptionHeight(*state, height);
+        PublishSharedWindow(hwnd);
+    });
 }
 
 // Legacy: Enable or disable custom frame (hidden mode)
 extern "C" __declspec(dllexport) void EnableCustomFrame(HWND hwnd, bool enable) {
-    auto it = g_window_states.find(hwnd);
-
-    if (enable) {
-        if (it == g_window_states.end()) {
-            WindowState state = {};
-            state.frameMode = FrameMode::Hidden;
-            state.captionHeight = 0;
-            state.hasCaptionButtons = false;
-
-            state.originalWndProc = reinterpret_cast<WNDPROC>(
-                SetWindowLongPtr(hwnd, GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(CustomFrameWndProc))
-            );
-
-            g_window_states[hwnd] = state;
+    RunOnWindowThread(hwnd, [&]() {
+        WindowTable::Shard* shard = CurrentShard();
+        uint32_t slot = shard->windows.Find(hwnd);
+
+        if (enable) {
+            if (slot == WindowTable::kNoSlot) {
+                // Hidden mode keeps the empty initial caption snapshot (no
+                // caption, no buttons)
+                WindowTable::Registration registration = g_windows.Register(GetCurrentThreadId(), hwnd);
+                WindowState& state = shard->windows.hot(registration.slot);
+                SetFrameMode(hwnd, state, FrameMode::Hidden);
+
+                WindowColdState& cold = shard->windows.cold(registration.slot);
+                cold.originalWndProc = reinterpret_cast<WNDPROC>(
+                    SetWindowLongPtr(hwnd, GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(CustomFrameWndProc))
+                );
+
+                StartInterception(hwnd, shard, state, cold);
+
+                MARGINS margins = {0, 0, 1, 0};
+                DwmExtendFrameIntoClientArea(hwnd, &margins);
+            } else {
+                WindowState& state = shard->windows.hot(slot);
+                SetFrameMode(hwnd, state, FrameMode::Hidden);
+                state.geometry.InvalidateAll();
+                state.hover.Reset();
 
-            if (g_getmsg_hook == nullptr) {
-                DWORD threadId = GetWindowThreadProcessId(hwnd, nullptr);
-                g_getmsg_hook = SetWindowsHookEx(WH_GETMESSAGE, GetMsgProc, nullptr, threadId);
+                MARGINS margins = {0, 0, 1, 0};
+                DwmExtendFrameIntoClientArea(hwnd, &margins);
             }
-            g_hook_ref_count++;
-
-            MARGINS margins = {0, 0, 1, 0};
-            DwmExtendFrameIntoClientArea(hwnd, &margins);
         } else {
-            it->second.frameMode = FrameMode::Hidden;
+            if (slot != WindowTable::kNoSlot) {
+                WindowState& state = shard->windows.hot(slot);
+                SetFrameMode(hwnd, state, FrameMode::Normal);
+                state.hover.Reset();
 
-            MARGINS margins = {0, 0, 1, 0};
-            DwmExtendFrameIntoClientArea(hwnd, &margins);
-        }
-    } else {
-        if (it != g_window_states.end()) {
-            it->second.frameMode = FrameMode::Normal;
-
-            MARGINS margins = {0, 0, 0, 0};
-            DwmExtendFrameIntoClientArea(hwnd, &margins);
+                MARGINS margins = {0, 0, 0, 0};
+                DwmExtendFrameIntoClientArea(hwnd, &margins);
+            }
         }
-    }
 
-    SetWindowPos(hwnd, nullptr, 0, 0, 0, 0,
-                 SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER | SWP_FRAMECHANGED);
+        SetWindowPos(hwnd, nullptr, 0, 0, 0, 0,
+                     SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER | SWP_FRAMECHANGED);
+    });
 }
 
 // Disable custom frame and restore normal window
 extern "C" __declspec(dllexport) void DisableCustomFrame(HWND hwnd) {
-    auto it = g_window_states.find(hwnd);
-    if (it != g_window_states.end()) {
-        it->second.frameMode = FrameMode::Normal;
+    RunOnWindowThread(hwnd, [&]() {
+        WindowState* state = FindWindowState(hwnd);
+        if (state != nullptr) {
+            SetFrameMode(hwnd, *state, FrameMode::Normal);
+            state->hover.Reset();
 
-        MARGINS margins = {0, 0, 0, 0};
-        DwmExtendFrameIntoClientArea(hwnd, &margins);
-    }
+            MARGINS margins = {0, 0, 0, 0};
+            DwmExtendFrameIntoClientArea(hwnd, &margins);
+        }
 
-    SetWindowPos(hwnd, nullptr, 0, 0, 0, 0,
-                 SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER | SWP_FRAMECHANGED);
+        SetWindowPos(hwnd, nullptr, 0, 0, 0, 0,
+                     SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER | SWP_FRAMECHANGED);
+    });
 }
 
 // Check current frame mode
 extern "C" __declspec(dllexport) int GetFrameMode(HWND hwnd) {
-    auto it = g_window_states.find(hwnd);
-    if (it != g_window_states.end()) {
-        return static_cast<int>(it->second.frameMode);
-    }
-    return static_cast<int>(FrameMode::Normal);
+    return static_cast<int>(PeekFrameMode(hwnd));
 }
 
 // Check if custom frame is currently enabled (legacy)
 extern "C" __declspec(dllexport) bool IsCustomFrameEnabled(HWND hwnd) {
-    auto it = g_window_states.find(hwnd);
-    if (it != g_window_states.end()) {
-        return it->second.frameMode != FrameMode::Normal;
-    }
-    return false;
+    return PeekFrameMode(hwnd) != FrameMode::Normal;
 }
 
 // Restore the original window procedure
 extern "C" __declspec(dllexport) void RestoreWindowProc(HWND hwnd) {
-    auto it = g_window_states.find(hwnd);
-    if (it != g_window_states.end()) {
-        if (it->second.originalWndProc != nullptr) {
-            SetWindowLongPtr(hwnd, GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(it->second.originalWndProc));
-        }
-
-        g_window_states.erase(it);
-
-        g_hook_ref_count--;
-        if (g_hook_ref_count <= 0 && g_getmsg_hook != nullptr) {
-            UnhookWindowsHookEx(g_getmsg_hook);
-            g_getmsg_hook = nullptr;
-            g_hook_ref_count = 0;
+    RunOnWindowThread(hwnd, [&]() {
+        WindowTable::Shard* shard = CurrentShard();
+        uint32_t slot = shard->windows.Find(hwnd);
+        if (slot != WindowTable::kNoSlot) {
+            WindowColdState& cold = shard->windows.cold(slot);
+            if (cold.originalWndProc != nullptr) {
+                SetWindowLongPtr(hwnd, GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(cold.originalWndProc));
+            }
+            ReleaseManagedWindow(hwnd, shard, slot);
         }
-    }
+    });
 }
 
 // Start window resize operation
@@ -758,5 +2112,357 @@ extern "C" __declspec(dllexport) int GetResizeBorderWidth() {
 
 // Check if Windows 11
 extern "C" __declspec(dllexport) bool IsWindows11() {
-    return IsWindows11OrGreater();
+    return (Capabilities().flags & CAPABILITY_WINDOWS_11) != 0;
+}
+
+// What this Windows version supports (see platform_capabilities.h),
+// probed on the first call from any thread. functions points to the
+// Win32FunctionTable of optional APIs. The result lives for the process.
+extern "C" __declspec(dllexport) const PlatformCapabilities* GetPlatformCapabilities() {
+    return &Capabilities();
+}
+
+// Place a window from the cached monitor topology (see window_placement.h):
+// 0 centers it in its monitor's work area, 1 moves it, and shrinks it if
+// needed, into the work area, 2 cascades it from anchor on the anchor's
+// monitor by 32 pixels at the monitor's DPI. Returns false for an invalid
+// window, an unknown mode, Cascade without a valid anchor, or no monitors.
+extern "C" __declspec(dllexport) bool PlaceWindow(HWND hwnd, int mode, HWND anchor) {
+    if (!IsWindow(hwnd) || mode < static_cast<int>(PlacementMode::Center) ||
+        mode > static_cast<int>(PlacementMode::Cascade)) {
+        return false;
+    }
+    PlacementMode placement = static_cast<PlacementMode>(mode);
+    if (placement == PlacementMode::Cascade && !IsWindow(anchor)) {
+        return false;
+    }
+
+    return RunOnWindowThread(hwnd, [&]() {
+        WatchMonitorTopology(hwnd);
+
+        RECT window;
+        GetWindowRect(hwnd, &window);
+        RECT anchorRect = window;
+        if (anchor != nullptr) {
+            GetWindowRect(anchor, &anchorRect);
+        }
+
+        Rect placed;
+        {
+            std::lock_guard<std::mutex> lock(g_monitors_mutex);
+            if (!SolvePlacement(CurrentMonitors(), placement, ToCoreRect(window), ToCoreRect(anchorRect), true,
+                                &placed)) {
+                return false;
+            }
+        }
+
+        SetWindowPos(hwnd, nullptr, placed.left, placed.top, placed.right - placed.left, placed.bottom - placed.top,
+                     SWP_NOZORDER | SWP_NOACTIVATE);
+        return true;
+    });
+}
+
+// Apply a runner's initial decoration (see initial_decoration.h) to a
+// window before it is first shown: frame mode and caption height, caption
+// color, bounds (physical pixels, like GetWindowRect) or centering, and
+// always-on-top. Runners call it from OnCreate, before the Flutter view is
+// created at the client size, so the frame change, the resize and the
+// view's first layout happen while the window is still hidden.
+// Returns false for an invalid window or decoration.
+extern "C" __declspec(dllexport) bool ApplyInitialDecoration(HWND hwnd, const InitialDecoration* decoration) {
+    if (!IsWindow(hwnd) || decoration == nullptr || !IsValidInitialDecoration(*decoration)) {
+        return false;
+    }
+
+    return RunOnWindowThread(hwnd, [&]() {
+        switch (static_cast<FrameMode>(decoration->frameMode)) {
+            case FrameMode::CustomFrame:
+                EnableCustomFrameMode(hwnd, static_cast<int>(decoration->captionHeight));
+                break;
+            case FrameMode::Hidden:
+                EnableCustomFrame(hwnd, true);
+                break;
+            case FrameMode::Normal:
+                if (FindWindowState(hwnd) != nullptr) {
+                    DisableCustomFrame(hwnd);
+                }
+                break;
+        }
+
+        if (decoration->flags & INITIAL_DECORATION_HAS_BACKGROUND) {
+            // ARGB to COLORREF (0x00BBGGRR)
+            uint32_t argb = decoration->backgroundColor;
+            COLORREF color = RGB((argb >> 16) & 0xFF, (argb >> 8) & 0xFF, argb & 0xFF);
+            DwmSetWindowAttribute(hwnd, CAPTION_COLOR_ATTRIBUTE, &color, sizeof(color));
+        }
+
+        if (decoration->flags & INITIAL_DECORATION_HAS_BOUNDS) {
+            const Rect& bounds = decoration->bounds;
+            SetWindowPos(hwnd, nullptr, bounds.left, bounds.top, bounds.right - bounds.left,
+                         bounds.bottom - bounds.top, SWP_NOZORDER | SWP_NOACTIVATE);
+        }
+        // After the frame and size, so the window rect is final
+        if (decoration->flags & INITIAL_DECORATION_CENTERED) {
+            PlaceWindow(hwnd, static_cast<int>(PlacementMode::Center), nullptr);
+        }
+
+        if (decoration->flags & INITIAL_DECORATION_ALWAYS_ON_TOP) {
+            SetWindowPos(hwnd, HWND_TOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
+        }
+
+        RememberInitialDecoration(hwnd, *decoration);
+        return true;
+    });
+}
+
+// Copy the decoration a runner applied with ApplyInitialDecoration to
+// decoration (if not null). Returns false if none was applied.
+extern "C" __declspec(dllexport) bool GetInitialDecoration(HWND hwnd, InitialDecoration* decoration) {
+    if (!IsWindow(hwnd)) {
+        return false;
+    }
+    return RunOnWindowThread(hwnd, [&]() {
+        DWORD_PTR refData = 0;
+        if (!GetWindowSubclass(hwnd, InitialDecorationSubclassProc, INITIAL_DECORATION_SUBCLASS_ID, &refData)) {
+            return false;
+        }
+        if (decoration != nullptr) {
+            *decoration = *reinterpret_cast<const InitialDecoration*>(refData);
+        }
+        return true;
+    });
+}
+
+// Snapshot of a window's bounds, monitor, DPI, frame mode and show state,
+// returned by value. Allocates nothing, forwards nothing to the window's
+// thread and never waits on a lock, so it can be bound as a leaf call and
+// polled: the monitor comes from the topology only while it is current
+// (see PeekWindowMonitor) and the frame mode from a window property.
+extern "C" __declspec(dllexport) WindowStateInfo QueryWindowState(HWND hwnd) {
+    if (!IsWindow(hwnd)) {
+        return WindowStateInfo();
+    }
+
+    WindowStateInfo info = QueryWindowStateInfo(hwnd, true);
+    info.frameMode = static_cast<int32_t>(PeekFrameMode(hwnd));
+    return info;
+}
+
+// Get the window's state block, creating it on first use. The block is
+// republished from the window's own messages (WM_WINDOWPOSCHANGED,
+// WM_DPICHANGED, WM_ACTIVATE, ...), so reading it (see
+// window_state_block.h) costs no call at all. The pointer stays readable
+// for the life of the process; once the window is destroyed the block's
+// window reads as 0. A RestoreWindowProc call bypasses the block's
+// subclass if the block was opened after the custom frame was enabled, so
+// open it before enabling the frame or again after restoring.
+// Returns nullptr for an invalid window.
+extern "C" __declspec(dllexport) WindowStateBlock* OpenWindowStateBlock(HWND hwnd) {
+    if (!IsWindow(hwnd)) {
+        return nullptr;
+    }
+
+    return RunOnWindowThread(hwnd, [&]() -> WindowStateBlock* {
+        DWORD_PTR refData = 0;
+        if (GetWindowSubclass(hwnd, StateSubclassProc, STATE_SUBCLASS_ID, &refData)) {
+            return reinterpret_cast<WindowStatePublisher*>(refData)->block();
+        }
+
+        WatchMonitorTopology(hwnd);
+        uint64_t handle = reinterpret_cast<uintptr_t>(hwnd);
+        WindowStatePublisher* publisher = new WindowStatePublisher(g_state_blocks.Acquire(handle), handle);
+        if (!SetWindowSubclass(hwnd, StateSubclassProc, STATE_SUBCLASS_ID, reinterpret_cast<DWORD_PTR>(publisher))) {
+            g_state_blocks.Release(publisher->block());
+            delete publisher;
+            return nullptr;
+        }
+
+        PublishWindowStateBlock(hwnd, *publisher);
+        return publisher->block();
+    });
+}
+
+// Set a 32-bit DWM window attribute (colors, corner preference, backdrop,
+// dark mode) from a value instead of a caller-allocated buffer
+extern "C" __declspec(dllexport) HRESULT SetDwmAttributeUint32(HWND hwnd, DWORD attribute, uint32_t value) {
+    return DwmSetWindowAttribute(hwnd, attribute, &value, sizeof(value));
+}
+
+// Get the frame geometry cache counters of a window.
+// Lookups that did not trigger a refresh were served without OS calls.
+extern "C" __declspec(dllexport) bool GetFrameCacheStats(HWND hwnd, FrameCacheStats* stats) {
+    return RunOnWindowThread(hwnd, [&]() {
+        WindowState* state = FindWindowState(hwnd);
+        if (state == nullptr || stats == nullptr) return false;
+
+        *stats = state->geometry.stats();
+        return true;
+    });
+}
+
+// Get the mouse-move memo counters of a window (memo hits vs. full
+// evaluations, and cursor changes actually issued)
+extern "C" __declspec(dllexport) bool GetHoverStats(HWND hwnd, HoverStats* stats) {
+    return RunOnWindowThread(hwnd, [&]() {
+        WindowState* state = FindWindowState(hwnd);
+        if (state == nullptr || stats == nullptr) return false;
+
+        *stats = state->hover.stats();
+        return true;
+    });
+}
+
+// Animate a window's bounds (screen coordinates, as GetWindowRect) and/or
+// opacity (see window_animation.h), stepped on the window's thread once per
+// DWM composition pass. A running animation is replaced. postCObject is
+// NativeApi.postCObject; port, if not 0, gets 1 once the target is reached
+// or 0 if the animation is cancelled, replaced or its window destroyed.
+// Returns false for an invalid window or invalid params.
+extern "C" __declspec(dllexport) bool AnimateWindow(HWND hwnd, const WindowAnimationParams* params, void* postCObject,
+                                                    int64_t port) {
+    if (!IsWindow(hwnd) || params == nullptr) {
+        return false;
+    }
+    return RunOnWindowThread(hwnd, [&]() {
+        return StartAnimation(hwnd, *params, reinterpret_cast<DartPostCObjectFn>(postCObject), port);
+    });
+}
+
+// Stop a window's animation where it is. Returns false if none was running.
+extern "C" __declspec(dllexport) bool CancelWindowAnimation(HWND hwnd) {
+    if (!IsWindow(hwnd)) {
+        return false;
+    }
+    return RunOnWindowThread(hwnd, [&]() { return CancelAnimation(hwnd); });
+}
+
+// Get the animation counters of a window. Returns false if it was never
+// animated.
+extern "C" __declspec(dllexport) bool GetWindowAnimationStats(HWND hwnd, WindowAnimationStats* stats) {
+    if (!IsWindow(hwnd) || stats == nullptr) {
+        return false;
+    }
+    return RunOnWindowThread(hwnd, [&]() {
+        WindowAnimator* animator = FindWindowAnimator(hwnd);
+        if (animator == nullptr) return false;
+
+        *stats = animator->animation.stats();
+        return true;
+    });
+}
+
+// Open the window layout store at path (see window_layout_store.h),
+// replacing an open one after saving its pending changes. The file is
+// memory-mapped and read once; a missing file is an empty store. Returns
+// false for a null path, or a file that can't be read or isn't a layout
+// file; the store then starts empty and the file is replaced on the next
+// save.
+extern "C" __declspec(dllexport) bool OpenWindowLayoutStore(const wchar_t* path) {
+    if (path == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(g_layouts_mutex);
+    if (g_layouts.dirty()) {
+        SaveLayoutFile();
+    }
+    g_layouts_path = path;
+    return LoadLayoutFile(g_layouts_path);
+}
+
+// Place a window from the layout saved under id (UTF-8, at most
+// MAX_WINDOW_LAYOUT_ID_BYTES bytes) and keep the saved layout up to date
+// as the window moves, resizes or maximizes; changes are written
+// LAYOUT_SAVE_DELAY_MS after the last one, and when the window is
+// destroyed. Call it before the window is shown, so it opens in place; a
+// window left maximized is maximized when it is shown. The layout applied,
+// with bounds resolved for the current monitors, is copied to layout if
+// not null; its frame mode is left to the caller.
+// Returns 1 if the window was placed as it was left, 2 if its monitor was
+// gone or changed and it was moved onto another one, 0 if nothing was
+// saved under id or the id is invalid.
+extern "C" __declspec(dllexport) int RestoreWindowLayout(HWND hwnd, const char* id, WindowLayout* layout) {
+    if (!IsWindow(hwnd) || id == nullptr) {
+        return static_cast<int>(LayoutRestore::None);
+    }
+    return RunOnWindowThread(hwnd, [&]() { return static_cast<int>(RestoreLayout(hwnd, id, layout)); });
+}
+
+// Write pending layout changes now instead of after the delay, e.g. before
+// the app exits. Returns false if writing failed.
+extern "C" __declspec(dllexport) bool FlushWindowLayouts() {
+    return FlushLayouts();
+}
+
+// Choose how windows enabled from now on receive resize border handling:
+// 0 = a GetMessage hook per UI thread (default), 1 = a subclass on the
+// window's Flutter view only. Returns false for an unknown mode.
+extern "C" __declspec(dllexport) bool SetMessageInterceptionMode(int mode) {
+    if (mode != static_cast<int>(InterceptionMode::ThreadHook) &&
+        mode != static_cast<int>(InterceptionMode::Subclass)) {
+        return false;
+    }
+    g_interception_mode.store(static_cast<InterceptionMode>(mode), std::memory_order_relaxed);
+    return true;
+}
+
+// Get the process-wide cursor cache counters (cursors served from the cache
+// vs. loaded from the system)
+extern "C" __declspec(dllexport) bool GetCursorCacheStats(CursorCacheStats* stats) {
+    if (stats == nullptr) return false;
+
+    *stats = g_cursors.stats();
+    return true;
+}
+
+// Open the registry named `name` that cooperating processes share to see
+// each other's windows, creating it if this is the first process. This
+// process's windows are published there from now on. Returns false if the
+// mapping can't be created or holds an incompatible layout.
+extern "C" __declspec(dllexport) bool OpenSharedWindowRegistry(const wchar_t* name) {
+    if (name == nullptr) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(g_shared_windows_mutex);
+        if (!g_shared_windows_open.load(std::memory_order_relaxed)) {
+            std::wstring objectName = L"Local\\WindowDecorationRegistry_";
+            objectName += name;
+
+            size_t size = SharedWindowRegistry::RequiredBytes(SHARED_REGISTRY_SLOTS);
+            HANDLE mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                                0, static_cast<DWORD>(size), objectName.c_str());
+            if (mapping == nullptr) return false;
+
+            void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+            if (view == nullptr || !g_shared_windows.Open(view, size, SHARED_REGISTRY_SLOTS)) {
+                if (view != nullptr) UnmapViewOfFile(view);
+                CloseHandle(mapping);
+                return false;
+            }
+
+            // Reclaim the slots of processes that exited without releasing
+            // them; nothing else does once they are gone
+            g_shared_windows.ReleaseDeadProcesses(IsProcessRunning);
+
+            // The mapping stays open for the lifetime of the process
+            g_shared_windows_open.store(true, std::memory_order_release);
+        }
+    }
+
+    // Publish the calling thread's windows right away; windows on other UI
+    // threads follow on their next move or frame change
+    WindowTable::Shard* shard = CurrentShard();
+    shard->windows.ForEach([shard](HWND hwnd, uint32_t slot) {
+        PublishSharedWindow(hwnd, shard->windows.hot(slot), shard->windows.cold(slot));
+    });
+    return true;
+}
+
+// Copy the windows of every process published to the shared registry into
+// windows (up to capacity). Returns the number of windows copied, or -1 if
+// the registry is not open.
+extern "C" __declspec(dllexport) int ReadSharedWindows(SharedWindowInfo* windows, int capacity) {
+    if (!g_shared_windows_open.load(std::memory_order_acquire)) return -1;
+    if (windows == nullptr || capacity <= 0) return 0;
+
+    return static_cast<int>(g_shared_windows.ReadAll(windows, static_cast<uint32_t>(capacity)));
 }